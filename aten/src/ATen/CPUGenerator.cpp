@@ -60,6 +60,7 @@ CPUGenerator::CPUGenerator(uint64_t seed_in)
 void CPUGenerator::set_current_seed(uint64_t seed) {
   next_float_normal_sample_.reset();
   next_double_normal_sample_.reset();
+  philox_offset_per_thread_ = 0;
   engine_ = mt19937(seed);
 }
 
@@ -83,6 +84,44 @@ uint64_t CPUGenerator::seed() {
   return random;
 }
 
+/**
+ * Sets the philox offset to be used by counter-based sampling kernels.
+ *
+ * See Note [Acquire lock when using random generators]
+ */
+void CPUGenerator::set_philox_offset_per_thread(uint64_t offset) {
+  philox_offset_per_thread_ = offset;
+}
+
+/**
+ * Gets the current philox offset of CPUGenerator.
+ */
+uint64_t CPUGenerator::philox_offset_per_thread() {
+  return philox_offset_per_thread_;
+}
+
+/**
+ * Gets the seed and philox offset to be used by a counter-based
+ * (Philox) sampling kernel, mirroring CUDAGenerator::philox_engine_inputs.
+ *
+ * Each kernel using philox has to sensibly increment the offset
+ * for future users of philox. So it gets the "old" value for
+ * itself (before add), and tells subsequent users which offset
+ * they should use, since only the kernel knows how many randoms
+ * it intends to generate per subsequence.
+ *
+ * The increment must be at least the number of 128-bit counter blocks
+ * (i.e. groups of four 32-bit randoms) consumed per subsequence; a larger
+ * increment only skips values, a smaller one would reuse them.
+ *
+ * See Note [Acquire lock when using random generators]
+ */
+std::pair<uint64_t, uint64_t> CPUGenerator::philox_engine_inputs(uint64_t increment) {
+  uint64_t offset = this->philox_offset_per_thread_;
+  this->philox_offset_per_thread_ += increment;
+  return std::make_pair(this->current_seed(), offset);
+}
+
 /**
  * Gets the DeviceType of CPUGenerator.
  * Used for type checking during run time.
@@ -176,6 +215,7 @@ std::shared_ptr<CPUGenerator> CPUGenerator::clone() const {
 CPUGenerator* CPUGenerator::clone_impl() const {
   auto gen = new CPUGenerator();
   gen->set_engine(engine_);
+  gen->set_philox_offset_per_thread(philox_offset_per_thread_);
   gen->set_next_float_normal_sample(next_float_normal_sample_);
   gen->set_next_double_normal_sample(next_double_normal_sample_);
   return gen;
@@ -17,6 +17,9 @@ struct CAFFE2_API CPUGenerator : public Generator {
   void set_current_seed(uint64_t seed) override;
   uint64_t current_seed() const override;
   uint64_t seed() override;
+  void set_philox_offset_per_thread(uint64_t offset);
+  uint64_t philox_offset_per_thread();
+  std::pair<uint64_t, uint64_t> philox_engine_inputs(uint64_t increment);
   static DeviceType device_type();
   uint32_t random();
   uint64_t random64();
@@ -30,6 +33,7 @@ struct CAFFE2_API CPUGenerator : public Generator {
 private:
   CPUGenerator* clone_impl() const override;
   at::mt19937 engine_;
+  uint64_t philox_offset_per_thread_ = 0;
   c10::optional<float> next_float_normal_sample_;
   c10::optional<double> next_double_normal_sample_;
 };
@@ -4,6 +4,31 @@
 
 namespace at {
 
+// Arguments handed to a CUDA kernel that consumes philox randomness.
+// In the default mode seed/offset are reserved on the host under the
+// generator mutex before launch. In device-resident mode (see
+// CUDAGenerator::set_philox_state_on_device) offset_ptr points at a device
+// counter and each launched kernel reserves its own counter range with a
+// device-side atomicAdd (see at::cuda::philox::unpack), so sampling kernels
+// on concurrent streams no longer serialize on the host mutex.
+struct PhiloxCudaState {
+  PhiloxCudaState() = default;
+  PhiloxCudaState(uint64_t seed_in, uint64_t offset_in)
+    : seed(seed_in), offset(offset_in) {}
+  PhiloxCudaState(uint64_t seed_in,
+                  unsigned long long* offset_ptr_in,
+                  uint64_t increment_in)
+    : seed(seed_in), offset_ptr(offset_ptr_in), increment(increment_in) {}
+
+  uint64_t seed = 0;
+  // Host-reserved offset; valid when offset_ptr is null.
+  uint64_t offset = 0;
+  // Device-resident counter; when non-null, each block of the launched
+  // kernel reserves [base, base + increment) by atomically advancing it.
+  unsigned long long* offset_ptr = nullptr;
+  uint64_t increment = 0;
+};
+
 struct CAFFE2_API CUDAGenerator : public Generator {
   // Constructors
   CUDAGenerator(DeviceIndex device_index = -1);
@@ -17,12 +42,16 @@ struct CAFFE2_API CUDAGenerator : public Generator {
   void set_philox_offset_per_thread(uint64_t offset);
   uint64_t philox_offset_per_thread();
   std::pair<uint64_t, uint64_t> philox_engine_inputs(uint64_t increment);
+  PhiloxCudaState philox_cuda_state(uint64_t increment);
+  void set_philox_state_on_device(bool enabled);
+  bool philox_state_on_device() const;
   static DeviceType device_type();
 
 private:
   CUDAGenerator* clone_impl() const override;
   uint64_t seed_ = default_rng_seed_val;
   uint64_t philox_offset_per_thread_ = 0;
+  unsigned long long* philox_offset_device_ptr_ = nullptr;
 };
 
 namespace cuda {
@@ -2,6 +2,7 @@
 
 #include <ATen/Context.h>
 
+#include <c10/core/CPUCachingAllocator.h>
 #include <c10/core/TensorOptions.h>
 
 #include <mutex>
@@ -113,6 +114,14 @@ void Context::setQEngine(at::QEngine e) {
   TORCH_CHECK(false, "quantized engine ", toString(e), " is not supported");
 }
 
+bool Context::CPUCachingAllocatorEnabled() const {
+  return c10::IsCPUCachingAllocatorEnabled();
+}
+
+void Context::setCPUCachingAllocatorEnabled(bool e) {
+  c10::EnableCPUCachingAllocator(e);
+}
+
 const std::vector<at::QEngine>& Context::supportedQEngines() const {
   static auto supported_qengines = []() {
     std::vector<at::QEngine> engines = {};
@@ -109,6 +109,10 @@ class CAFFE2_API Context {
   at::QEngine qEngine() const;
   void setQEngine(at::QEngine e);
   const std::vector<at::QEngine>& supportedQEngines() const;
+  // Routes CPU tensor allocations through a caching size-class allocator
+  // (see c10/core/CPUCachingAllocator.h). Off by default.
+  bool CPUCachingAllocatorEnabled() const;
+  void setCPUCachingAllocatorEnabled(bool e);
 
  private:
   void initCUDAIfNeeded(DeviceType p) {
@@ -12,6 +12,12 @@
     return __VA_ARGS__();                          \
   }
 
+#define AT_PRIVATE_CASE_TYPE_USING_HINT(enum_type, type, HINT, ...) \
+  case enum_type: {                                                 \
+    using HINT = type;                                              \
+    return __VA_ARGS__();                                           \
+  }
+
 #define AT_QINT_PRIVATE_CASE_TYPE(enum_type, type, underlying_enum, underlying_type, ...) \
   case enum_type: {                                                     \
     const auto& UNDERLYING_TYPE C10_UNUSED = underlying_enum;           \
@@ -185,6 +191,23 @@ inline void deprecated_AT_DISPATCH_ALL_TYPES_AND_HALF_AND_COMPLEX() {}
     }                                                                        \
   }()
 
+// Dispatches on an index tensor's dtype, binding the element type as
+// `index_t` rather than `scalar_t` so it can be nested inside the value
+// dispatch of a kernel.  Sparse tensors accept int32 as well as int64
+// indices (see SparseTensorImpl); kernels that support both use this.
+#define AT_DISPATCH_INDEX_TYPES(TYPE, NAME, ...)                                        \
+  [&] {                                                                                 \
+    const auto& the_index_type = TYPE;                                                  \
+    /* don't use TYPE again in case it is an expensive or side-effect op */             \
+    at::ScalarType _it = ::detail::scalar_type(the_index_type);                         \
+    switch (_it) {                                                                      \
+      AT_PRIVATE_CASE_TYPE_USING_HINT(at::ScalarType::Int, int32_t, index_t, __VA_ARGS__) \
+      AT_PRIVATE_CASE_TYPE_USING_HINT(at::ScalarType::Long, int64_t, index_t, __VA_ARGS__) \
+      default:                                                                          \
+        AT_ERROR(#NAME, " not implemented for '", toString(_it), "'");                  \
+    }                                                                                   \
+  }()
+
 #define AT_DISPATCH_ALL_TYPES(TYPE, NAME, ...)                               \
   [&] {                                                                      \
     const auto& the_type = TYPE;                                             \
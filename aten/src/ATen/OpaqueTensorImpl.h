@@ -24,7 +24,7 @@ struct CAFFE2_API OpaqueTensorImpl : public TensorImpl {
   :   TensorImpl(type_set, data_type, device),
       opaque_handle_(std::move(opaque_handle))
   {
-    sizes_ = sizes.vec();
+    sizes_and_strides_.set_sizes(sizes);
     refresh_numel();
   }
 
@@ -87,7 +87,7 @@ struct CAFFE2_API OpaqueTensorImpl : public TensorImpl {
       const c10::VariableVersion& version_counter,
       bool allow_tensor_metadata_change) const override {
     auto impl = c10::make_intrusive<OpaqueTensorImpl<OpaqueHandle>>(
-      type_set(), dtype(), device(), opaque_handle_, sizes_);
+      type_set(), dtype(), device(), opaque_handle_, sizes_and_strides_.sizes_arrayref());
     copy_tensor_metadata(
       /*src_impl=*/this,
       /*dest_impl=*/impl.get(),
@@ -12,6 +12,29 @@ namespace internal {
 constexpr int64_t GRAIN_SIZE = 32768;
 } // namespace internal
 
+// Work categories for problem-size-aware parallelism thresholds. A single
+// GRAIN_SIZE cannot fit both regimes: thread wake-up cost dwarfs the work for
+// small memory-bound ops (over-parallelization), while FLOP-heavy loops
+// amortize it much earlier (under-parallelization). Kernels classify the work
+// they hand to parallel_for and use grain_size(kind) instead of the fixed
+// constant; deployments can retune the thresholds at runtime for their
+// latency/throughput point via set_grain_size().
+enum class ParallelWorkKind : uint8_t {
+  // Dominated by arithmetic per element (transcendentals, accumulations).
+  COMPUTE_BOUND = 0,
+  // Dominated by bytes moved per element (copies, simple elementwise).
+  MEMORY_BOUND = 1,
+  NUM_KINDS
+};
+
+// Returns the current minimum number of elements per chunk for the given
+// work category. Defaults to GRAIN_SIZE for COMPUTE_BOUND and 4x GRAIN_SIZE
+// for MEMORY_BOUND.
+CAFFE2_API int64_t grain_size(ParallelWorkKind kind);
+
+// Overrides the threshold for one category; must be positive. Thread-safe.
+CAFFE2_API void set_grain_size(ParallelWorkKind kind, int64_t grain_size);
+
 inline int64_t divup(int64_t x, int64_t y) {
   return (x + y - 1) / y;
 }
@@ -115,6 +138,9 @@ CAFFE2_API int get_num_interop_threads();
 // Launches inter-op parallel task
 CAFFE2_API void launch(std::function<void()> func);
 
+// Returns true if the current thread is one of the inter-op pool's workers
+CAFFE2_API bool in_interop_thread_pool();
+
 // Launches intra-op parallel task
 CAFFE2_API void intraop_launch(std::function<void()> func);
 
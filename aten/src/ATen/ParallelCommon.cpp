@@ -4,6 +4,7 @@
 #include <ATen/PTThreadPool.h>
 #include <ATen/Version.h>
 
+#include <atomic>
 #include <sstream>
 #include <thread>
 
@@ -40,8 +41,33 @@ size_t get_env_num_threads(const char* var_name, size_t def_value = 0) {
   return def_value;
 }
 
+std::atomic<int64_t>& grain_size_for(ParallelWorkKind kind) {
+  // Memory-bound loops need roughly 4x more elements than compute-bound
+  // ones before the per-thread wake-up cost is amortized; both starting
+  // points can be retuned at runtime.
+  static std::atomic<int64_t> grain_sizes[
+      static_cast<size_t>(ParallelWorkKind::NUM_KINDS)] = {
+    {internal::GRAIN_SIZE},     // COMPUTE_BOUND
+    {4 * internal::GRAIN_SIZE}  // MEMORY_BOUND
+  };
+  auto idx = static_cast<size_t>(kind);
+  TORCH_CHECK(
+      idx < static_cast<size_t>(ParallelWorkKind::NUM_KINDS),
+      "Invalid ParallelWorkKind: ", idx);
+  return grain_sizes[idx];
+}
+
 } // namespace
 
+int64_t grain_size(ParallelWorkKind kind) {
+  return grain_size_for(kind).load(std::memory_order_relaxed);
+}
+
+void set_grain_size(ParallelWorkKind kind, int64_t grain_size) {
+  TORCH_CHECK(grain_size > 0, "Expected positive grain size, got ", grain_size);
+  grain_size_for(kind).store(grain_size, std::memory_order_relaxed);
+}
+
 std::string get_parallel_info() {
   std::ostringstream ss;
 
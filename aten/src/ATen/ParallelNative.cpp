@@ -10,6 +10,8 @@
 #endif // C10_MOBILE
 
 #include <atomic>
+#include <cstdlib>
+#include <cstring>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -116,6 +118,24 @@ struct ParallelRegionGuard {
 
 namespace internal {
 
+namespace {
+std::atomic<bool> work_stealing_enabled_{false};
+
+bool _work_stealing_env_enabled() {
+  auto envar = std::getenv("ATEN_PARALLEL_WORK_STEALING");
+  return envar && strcmp(envar, "1") == 0;
+}
+} // namespace
+
+bool _work_stealing_enabled() {
+  static bool env_enabled = _work_stealing_env_enabled();
+  return env_enabled || work_stealing_enabled_.load(std::memory_order_relaxed);
+}
+
+void _set_work_stealing_enabled(bool enabled) {
+  work_stealing_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
 void _parallel_run(
   const int64_t begin,
   const int64_t end,
@@ -127,12 +147,8 @@ void _parallel_run(
 
   std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
   std::exception_ptr eptr;
-  std::vector<std::shared_ptr<c10::ivalue::Future>> futures(num_tasks);
-  for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
-    futures[task_id] = std::make_shared<c10::ivalue::Future>(c10::NoneType::get());
-  }
-  auto task = [f, &eptr, &err_flag, &futures, begin, end, chunk_size]
-      (int /* unused */, size_t task_id) {
+
+  auto run_task = [f, &eptr, &err_flag, begin, end, chunk_size](size_t task_id) {
     int64_t local_start = begin + task_id * chunk_size;
     if (local_start < end) {
       int64_t local_end = std::min(end, (int64_t)(chunk_size + local_start));
@@ -145,6 +161,48 @@ void _parallel_run(
         }
       }
     }
+  };
+
+#ifndef C10_MOBILE
+  if (_work_stealing_enabled() && num_tasks > 1) {
+    // Work-stealing mode: the range is oversubscribed into small chunks
+    // (see calc_num_tasks_and_chunk_size) and workers claim the next
+    // outstanding chunk as they finish their current one, so a chunk that
+    // runs long does not leave the rest of the pool idle.
+    auto next_task = std::make_shared<std::atomic<size_t>>(0);
+    size_t num_workers = std::min((size_t)get_num_threads(), num_tasks);
+    std::vector<std::shared_ptr<c10::ivalue::Future>> futures(num_workers - 1);
+    for (size_t i = 0; i < num_workers - 1; ++i) {
+      futures[i] = std::make_shared<c10::ivalue::Future>(c10::NoneType::get());
+      _get_intraop_pool().run([&run_task, next_task, num_tasks, i, &futures]() {
+        size_t task_id;
+        while ((task_id = next_task->fetch_add(1)) < num_tasks) {
+          run_task(task_id);
+        }
+        futures[i]->markCompleted();
+      });
+    }
+    // The master thread steals chunks like any other worker.
+    size_t task_id;
+    while ((task_id = next_task->fetch_add(1)) < num_tasks) {
+      run_task(task_id);
+    }
+    for (auto& future : futures) {
+      future->wait();
+    }
+    if (eptr) {
+      std::rethrow_exception(eptr);
+    }
+    return;
+  }
+#endif // C10_MOBILE
+
+  std::vector<std::shared_ptr<c10::ivalue::Future>> futures(num_tasks);
+  for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+    futures[task_id] = std::make_shared<c10::ivalue::Future>(c10::NoneType::get());
+  }
+  auto task = [&run_task, &futures](int /* unused */, size_t task_id) {
+    run_task(task_id);
     futures[task_id]->markCompleted();
   };
   _run_with_pool(task, num_tasks);
@@ -194,7 +252,12 @@ void set_num_threads(int nthreads) {
     }
   }
 #else
-  TORCH_CHECK(false, "set_num_threads is not supported for mobile.");
+  TORCH_CHECK(nthreads > 0, "Expected positive number of threads");
+  // One global concurrency setting: resizing the shared mobile pool also
+  // resizes what NNPACK and QNNPACK run on, since they use the same pool.
+  caffe2::ThreadPool* pool = caffe2::mobile_threadpool();
+  TORCH_CHECK(pool, "Thread pool is not available");
+  pool->setNumThreads(nthreads);
 #endif // C10_MOBILE
 }
 
@@ -9,13 +9,29 @@
 namespace at {
 namespace internal {
 
+// When work stealing is enabled the range is cut into this many chunks per
+// thread (instead of one); idle threads keep claiming outstanding chunks, so
+// skewed workloads (e.g. EmbeddingBag with variable bag lengths) balance
+// automatically at the cost of a slightly higher scheduling overhead.
+constexpr size_t WORK_STEALING_CHUNKS_PER_THREAD = 4;
+
+// Whether the work-stealing intra-op scheduler is enabled. Off by default;
+// opt in with _set_work_stealing_enabled() or ATEN_PARALLEL_WORK_STEALING=1.
+CAFFE2_API bool _work_stealing_enabled();
+CAFFE2_API void _set_work_stealing_enabled(bool enabled);
+
 inline std::tuple<size_t, size_t> calc_num_tasks_and_chunk_size(
     int64_t begin, int64_t end, int64_t grain_size) {
   if ((end - begin) < grain_size) {
     return std::make_tuple(1, std::max((int64_t)0, end - begin));
   }
-  // Choose number of tasks based on grain size and number of threads.
-  size_t chunk_size = divup((end - begin), get_num_threads());
+  // Choose number of tasks based on grain size and number of threads. With
+  // work stealing, oversubscribe so that stragglers can be balanced out.
+  size_t num_chunks = get_num_threads();
+  if (_work_stealing_enabled()) {
+    num_chunks *= WORK_STEALING_CHUNKS_PER_THREAD;
+  }
+  size_t chunk_size = divup((end - begin), num_chunks);
   // Make sure each task is at least grain_size size.
   chunk_size = std::max((size_t)grain_size, chunk_size);
   size_t num_tasks = divup((end - begin), chunk_size);
@@ -39,7 +39,7 @@ std::shared_ptr<TaskThreadPoolBase> create_c10_threadpool(
   TORCH_CHECK(device_id == 0);
   // Create new thread pool
   TORCH_CHECK(create_new);
-  return std::make_shared<PTThreadPool>(pool_size);
+  return std::make_shared<PTWorkStealingThreadPool>(pool_size);
 }
 
 } // namespace
@@ -84,5 +84,13 @@ void launch(std::function<void()> func) {
 #endif
 }
 
+bool in_interop_thread_pool() {
+#if AT_EXPERIMENTAL_SINGLE_THREAD_POOL
+  return in_parallel_region();
+#else
+  return get_pool().inThreadPool();
+#endif
+}
+
 } // namespace at
 #endif
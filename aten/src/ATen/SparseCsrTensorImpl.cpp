@@ -0,0 +1,89 @@
+#include <ATen/ATen.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/InitialTensorOptions.h>
+
+namespace at {
+
+// An empty CSR tensor is a [0, 0] matrix with nnz == 0: a single-element
+// row-pointer tensor holding 0, and empty column-index and value tensors.
+SparseCsrTensorImpl::SparseCsrTensorImpl(at::TensorTypeSet type_set, const caffe2::TypeMeta& data_type)
+    : TensorImpl(type_set, data_type, kCPU)
+    , crow_indices_(at::zeros({1}, at::initialTensorOptions().dtype(ScalarType::Long)))
+    , col_indices_(at::empty({0}, at::initialTensorOptions().dtype(ScalarType::Long)))
+    , values_(at::empty({0}, at::initialTensorOptions().dtype(data_type))) {
+  AT_ASSERT(type_set.has(TensorTypeId::SparseCsrCPUTensorId));
+  sizes_and_strides_.set_sizes(IntArrayRef{0, 0});
+  refresh_numel();
+}
+
+IntArrayRef SparseCsrTensorImpl::strides() const {
+  AT_ERROR("sparse CSR tensors do not have strides");
+}
+bool SparseCsrTensorImpl::is_contiguous(at::MemoryFormat memory_format) const {
+  AT_ERROR("sparse CSR tensors do not have is_contiguous");
+}
+int64_t SparseCsrTensorImpl::stride(int64_t d) const {
+  AT_ERROR("sparse CSR tensors do not have strides");
+}
+void SparseCsrTensorImpl::resize_dim(int64_t ndim) {
+  AT_ERROR("sparse CSR tensors do not have resize_dim");
+}
+void SparseCsrTensorImpl::set_size(int64_t dim, int64_t new_size) {
+  AT_ERROR("sparse CSR tensors do not have set_size");
+}
+void SparseCsrTensorImpl::set_stride(int64_t dim, int64_t new_stride) {
+  AT_ERROR("sparse CSR tensors do not have set_stride");
+}
+void SparseCsrTensorImpl::set_storage_offset(int64_t storage_offset) {
+  AT_ERROR("sparse CSR tensors do not have set_storage_offset");
+}
+
+TensorImpl* SparseCsrTensorImpl::maybe_zero_dim(bool condition_when_zero_dim) {
+  TORCH_CHECK(!condition_when_zero_dim,
+           "Attempted to maybe_zero_dim on a SparseCsrTensorImpl, but sparse CSR"
+           " tensors are always 2-dimensional");
+  return this;
+}
+bool SparseCsrTensorImpl::has_storage() const {
+  return false;
+}
+const Storage& SparseCsrTensorImpl::storage() const {
+  AT_ERROR("sparse CSR tensors do not have storage");
+}
+int64_t SparseCsrTensorImpl::storage_offset() const {
+  AT_ERROR("sparse CSR tensors do not have storage");
+}
+
+void SparseCsrTensorImpl::set_member_tensors_unsafe(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size) {
+  TORCH_CHECK(allow_tensor_metadata_change(), "set_member_tensors_unsafe ", err_msg_tensor_metadata_change_not_allowed);
+  AT_ASSERT(!crow_indices.is_variable() && !col_indices.is_variable() && !values.is_variable());  // They should be plain tensors!
+
+  TORCH_CHECK(size.size() == 2, "CSR tensors must be 2-dimensional, but got size ", size);
+  TORCH_CHECK(crow_indices.layout() == kStrided && col_indices.layout() == kStrided && values.layout() == kStrided,
+      "expected crow_indices, col_indices and values to be dense tensors");
+  TORCH_CHECK(crow_indices.device().is_cpu() && col_indices.device().is_cpu() && values.device().is_cpu(),
+      "sparse CSR tensors are only supported on CPU");
+  TORCH_CHECK(crow_indices.scalar_type() == kLong, "crow_indices must be an int64 tensor");
+  TORCH_CHECK(col_indices.scalar_type() == kLong, "col_indices must be an int64 tensor");
+  TORCH_CHECK(values.scalar_type() == typeMetaToScalarType(dtype()), "dtype of values (", values.scalar_type(), ") must match dtype of sparse CSR tensor (", typeMetaToScalarType(dtype()), ")");
+
+  TORCH_CHECK(crow_indices.dim() == 1, "crow_indices must be a 1-dimensional tensor, but got: ", crow_indices.sizes());
+  TORCH_CHECK(col_indices.dim() == 1, "col_indices must be a 1-dimensional tensor, but got: ", col_indices.sizes());
+  TORCH_CHECK(values.dim() == 1, "values must be a 1-dimensional tensor, but got: ", values.sizes());
+  TORCH_CHECK(crow_indices.size(0) == size[0] + 1,
+      "crow_indices must have nrows + 1 = ", size[0] + 1, " elements, but got ", crow_indices.size(0));
+  TORCH_CHECK(col_indices.size(0) == values.size(0),
+      "col_indices and values must have the same nnz, but got nnz from col_indices: ", col_indices.size(0), ", nnz from values: ", values.size(0));
+
+  crow_indices_ = crow_indices;
+  col_indices_ = col_indices;
+  values_ = values;
+  sizes_and_strides_.set_sizes(size);
+  refresh_numel();
+}
+
+} // namespace at
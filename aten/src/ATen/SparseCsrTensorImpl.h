@@ -0,0 +1,118 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <c10/core/TensorImpl.h>
+#include <c10/util/Exception.h>
+
+namespace at {
+struct CAFFE2_API SparseCsrTensorImpl : public TensorImpl {
+  // Stored in CSR format: row pointers + column indices + values.
+  //
+  // INVARIANTS:
+  // shape: dimensionality 2, (nrows, ncols)
+  // crow_indices_: 1-d int64 tensor of length nrows + 1; nondecreasing,
+  //                first element 0, last element nnz
+  // col_indices_:  1-d int64 tensor of length nnz; entries in [0, ncols)
+  // values_:       1-d tensor of length nnz, same dtype as the tensor
+  //
+  // Unlike COO, the row structure is explicit in crow_indices_, so the
+  // nonzeros of row r live in the contiguous range
+  // [crow_indices_[r], crow_indices_[r + 1]) of col_indices_/values_;
+  // row slicing and row-parallel matmul need no sorting or conversion.
+
+  Tensor crow_indices_;
+  Tensor col_indices_;
+  Tensor values_;
+
+ public:
+  explicit SparseCsrTensorImpl(at::TensorTypeSet, const caffe2::TypeMeta&);
+
+  int64_t nnz() const { return values_.size(0); }
+  Tensor crow_indices() const { return crow_indices_; }
+  Tensor col_indices() const { return col_indices_; }
+  Tensor values() const { return values_; }
+
+  IntArrayRef strides() const override;
+  bool is_contiguous(at::MemoryFormat memory_format=at::MemoryFormat::Contiguous) const override;
+  int64_t stride(int64_t d) const override;
+  void resize_dim(int64_t ndim) override;
+  void set_size(int64_t dim, int64_t new_size) override;
+  void set_stride(int64_t dim, int64_t new_stride) override;
+  void set_storage_offset(int64_t storage_offset) override;
+
+  TensorImpl* maybe_zero_dim(bool condition_when_zero_dim) override;
+  bool has_storage() const override;
+  const Storage& storage() const override;
+  int64_t storage_offset() const override;
+
+  // Takes the member tensors and the shape and directly puts them into the
+  // CSR tensor, no copy.
+  // NOTE: this function is unsafe because it only checks the mutual
+  // consistency of the member tensors (dtypes, lengths); it does NOT check
+  // that crow_indices is a valid, nondecreasing row-pointer sequence or that
+  // col_indices entries are within [0, ncols), so it should ONLY be used
+  // where the caller has validated (or produced) the CSR invariants.
+  void set_member_tensors_unsafe(
+      const Tensor& crow_indices,
+      const Tensor& col_indices,
+      const Tensor& values,
+      IntArrayRef size);
+
+  /**
+   * Return a TensorImpl that is a shallow-copy of this TensorImpl.
+   *
+   * For usage of `version_counter` and `allow_tensor_metadata_change`,
+   * see NOTE [ TensorImpl Shallow-Copying ].
+   */
+  c10::intrusive_ptr<TensorImpl> shallow_copy_and_detach(
+      const c10::VariableVersion& version_counter,
+      bool allow_tensor_metadata_change) const override {
+    auto impl = c10::make_intrusive<SparseCsrTensorImpl>(type_set(), dtype());
+    copy_tensor_metadata(
+      /*src_impl=*/this,
+      /*dest_impl=*/impl.get(),
+      /*version_counter=*/version_counter,
+      /*allow_tensor_metadata_change=*/allow_tensor_metadata_change);
+    impl->refresh_numel();
+    return impl;
+  }
+
+  /**
+   * Shallow-copies data from another TensorImpl into this TensorImpl.
+   *
+   * For why this function doesn't check this TensorImpl's `allow_tensor_metadata_change_`,
+   * see NOTE [ TensorImpl Shallow-Copying ].
+   */
+  void shallow_copy_from(const c10::intrusive_ptr<TensorImpl>& impl) override {
+    AT_ASSERT(has_compatible_shallow_copy_type(impl->type_set()));
+    auto csr_impl = static_cast<const SparseCsrTensorImpl*>(impl.get());
+    copy_tensor_metadata(
+      /*src_impl=*/csr_impl,
+      /*dest_impl=*/this,
+      /*version_counter=*/version_counter(),
+      /*allow_tensor_metadata_change=*/allow_tensor_metadata_change());
+    refresh_numel();
+  }
+
+ private:
+  /**
+   * Copy the tensor metadata fields (e.g. sizes / strides / storage pointer / storage_offset)
+   * from one TensorImpl to another TensorImpl.
+   *
+   * For usage of `version_counter` and `allow_tensor_metadata_change`, see NOTE [ TensorImpl Shallow-Copying ].
+   */
+  static void copy_tensor_metadata(
+      const SparseCsrTensorImpl* src_csr_impl,
+      SparseCsrTensorImpl* dest_csr_impl,
+      const c10::VariableVersion& version_counter,
+      bool allow_tensor_metadata_change) {
+    TensorImpl::copy_tensor_metadata(src_csr_impl, dest_csr_impl, version_counter, allow_tensor_metadata_change);
+
+    // CSR-specific fields
+    dest_csr_impl->crow_indices_ = src_csr_impl->crow_indices();
+    dest_csr_impl->col_indices_ = src_csr_impl->col_indices();
+    dest_csr_impl->values_ = src_csr_impl->values();
+  }
+};
+
+} // namespace at
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/SparseCsrTensorImpl.h>
+
+namespace at { namespace sparse {
+
+// This is an internal utility function for getting at the
+// SparseCsrTensorImpl, so that we can write CSR-specific accessors for its
+// special fields.  You should only use this for writing low level
+// setters/getters for SparseCsrTensorImpl fields; otherwise, you should use
+// the low level setters/getters that were implemented using this.
+//
+// This may be called repeatedly, so make sure it's pretty cheap.
+inline SparseCsrTensorImpl* get_sparse_csr_impl(const Tensor& self) {
+  AT_ASSERTM(!self.is_variable(), "_internal_get_SparseCsrTensorImpl: should not be a variable");  // TODO: remove this when Variable and Tensor are merged
+  AT_ASSERTM(self.is_sparse_csr(), "_internal_get_SparseCsrTensorImpl: not a sparse CSR tensor");
+  return static_cast<SparseCsrTensorImpl*>(self.unsafeGetTensorImpl());
+}
+
+// Takes the member tensors and directly puts them into the CSR tensor, no
+// copy.  The caller is responsible for the CSR invariants (see the NOTE on
+// set_member_tensors_unsafe).
+inline void alias_into_sparse_csr(
+    const Tensor& self,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size) {
+  get_sparse_csr_impl(self)->set_member_tensors_unsafe(
+      crow_indices, col_indices, values, size);
+}
+
+}} // namespace at::sparse
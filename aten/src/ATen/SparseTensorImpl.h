@@ -17,7 +17,9 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   int64_t sparse_dim_ = 0; // number of sparse dimensions
   int64_t dense_dim_ = 0; // number of dense dimensions
 
-  Tensor indices_; // always a LongTensor
+  Tensor indices_; // an int64 tensor by default; int32 is also accepted
+                   // (halves index memory for graphs under 2B nodes), and
+                   // kernels that only handle int64 promote at their entry
   Tensor values_;
 
   // A sparse tensor is 'coalesced' if every index occurs at most once in
@@ -29,6 +31,29 @@ struct CAFFE2_API SparseTensorImpl : public TensorImpl {
   // because many algorithms proceed by merging two sorted lists (of indices).
   bool coalesced_ = false;
 
+  // Cached CSR row pointers for the 2-d sparse-dense matmul engine (see
+  // s_addmm_out_sparse_dense_cpu in native/sparse/SparseTensorMath.cpp).
+  // The cache is keyed on the identity and version of indices_, and is
+  // additionally cleared by every method that replaces or resizes the
+  // indices, so a stale row-pointer table can never be observed.
+  mutable Tensor csr_cache_;
+  mutable const void* csr_source_impl_ = nullptr;
+  mutable uint32_t csr_source_version_ = 0;
+
+  // Cached transpose structure for a coalesced 2-d sparse matrix: the
+  // coalesced transposed indices, the value permutation that produces them,
+  // and the transpose's CSR row pointers (i.e. this matrix's CSC column
+  // pointers).  Keyed like csr_cache_ on the identity and version of
+  // indices_, so a fixed sparsity pattern -- e.g. a static adjacency matrix
+  // driving repeated addmm forward/backward -- pays the transpose sort once
+  // per run.  See sparse_transpose2d_cached in
+  // native/sparse/SparseTensorMath.cpp.
+  mutable Tensor transpose_indices_cache_;
+  mutable Tensor transpose_perm_cache_;
+  mutable Tensor csc_cache_;
+  mutable const void* transpose_source_impl_ = nullptr;
+  mutable uint32_t transpose_source_version_ = 0;
+
 public:
   // Public for now...
   explicit SparseTensorImpl(at::TensorTypeSet, const caffe2::TypeMeta&);
@@ -58,7 +83,7 @@ public:
   // respect to indices and values
   void raw_resize_(int64_t sparse_dim, int64_t dense_dim, IntArrayRef size) {
     TORCH_CHECK(allow_tensor_metadata_change(), "raw_resize_ ", err_msg_tensor_metadata_change_not_allowed);
-    sizes_ = size.vec();
+    sizes_and_strides_.set_sizes(size);
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
     refresh_numel();
@@ -128,16 +153,17 @@ public:
         "shrinking the size of dense dimensions (from ", dense_size_original, " to ", dense_size_new, ") on a non-empty sparse tensor is not supported.\n", alt_options_msg);
     }
 
-    if ((!size.equals(sizes_)) || (sparse_dim != sparse_dim_) || (dense_dim != dense_dim_)) {
+    if ((!size.equals(sizes_and_strides_.sizes_arrayref())) || (sparse_dim != sparse_dim_) || (dense_dim != dense_dim_)) {
       auto nnz = values().size(0);
       std::vector<int64_t> values_size = {nnz};
       auto dense_size = size.slice(sparse_dim);
       values_size.insert(values_size.end(), dense_size.begin(), dense_size.end());
       values_.resize_(values_size);
       indices_.resize_({sparse_dim, nnz});
+      invalidate_structure_caches();
     }
 
-    sizes_ = size.vec();
+    sizes_and_strides_.set_sizes(size);
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
     refresh_numel();
@@ -148,7 +174,7 @@ public:
     TORCH_CHECK(allow_tensor_metadata_change(), "resize_and_clear_ ", err_msg_tensor_metadata_change_not_allowed);
     TORCH_CHECK(sparse_dim + dense_dim == static_cast<int64_t>(size.size()), "number of dimensions must be sparse_dim (", sparse_dim, ") + dense_dim (", dense_dim, "), but got ", size.size());
 
-    sizes_ = size.vec();
+    sizes_and_strides_.set_sizes(size);
     sparse_dim_ = sparse_dim;
     dense_dim_ = dense_dim;
 
@@ -161,6 +187,58 @@ public:
     refresh_numel();
   }
 
+  // Returns the cached CSR row-pointer tensor if it still matches the
+  // current indices, or an undefined tensor otherwise.
+  Tensor csr_cache() const {
+    if (!csr_cache_.defined() ||
+        csr_source_impl_ != indices_.unsafeGetTensorImpl() ||
+        csr_source_version_ !=
+            indices_.unsafeGetTensorImpl()->version_counter().current_version()) {
+      return Tensor();
+    }
+    return csr_cache_;
+  }
+
+  void set_csr_cache(const Tensor& csr) const {
+    csr_cache_ = csr;
+    csr_source_impl_ = indices_.unsafeGetTensorImpl();
+    csr_source_version_ =
+        indices_.unsafeGetTensorImpl()->version_counter().current_version();
+  }
+
+  // Returns true and fills the outputs when the cached transpose structure
+  // still matches the current indices.
+  bool transpose_cache(Tensor* indices, Tensor* perm, Tensor* csc) const {
+    if (!transpose_indices_cache_.defined() ||
+        transpose_source_impl_ != indices_.unsafeGetTensorImpl() ||
+        transpose_source_version_ !=
+            indices_.unsafeGetTensorImpl()->version_counter().current_version()) {
+      return false;
+    }
+    *indices = transpose_indices_cache_;
+    *perm = transpose_perm_cache_;
+    *csc = csc_cache_;
+    return true;
+  }
+
+  void set_transpose_cache(const Tensor& indices, const Tensor& perm, const Tensor& csc) const {
+    transpose_indices_cache_ = indices;
+    transpose_perm_cache_ = perm;
+    csc_cache_ = csc;
+    transpose_source_impl_ = indices_.unsafeGetTensorImpl();
+    transpose_source_version_ =
+        indices_.unsafeGetTensorImpl()->version_counter().current_version();
+  }
+
+  void invalidate_structure_caches() const {
+    csr_cache_ = Tensor();
+    csr_source_impl_ = nullptr;
+    transpose_indices_cache_ = Tensor();
+    transpose_perm_cache_ = Tensor();
+    csc_cache_ = Tensor();
+    transpose_source_impl_ = nullptr;
+  }
+
   void set_coalesced(bool coalesced) {
     TORCH_CHECK(allow_tensor_metadata_change(), "set_coalesced ", err_msg_tensor_metadata_change_not_allowed);
     coalesced_ = coalesced;
@@ -172,6 +250,7 @@ public:
     AT_ASSERT(new_nnz <= nnz());
     indices_ = indices_.narrow(1, 0, new_nnz);
     values_ = values_.narrow(0, 0, new_nnz);
+    invalidate_structure_caches();
   }
 
   // Takes indices and values and directly puts them into the sparse tensor, no copy.
@@ -48,6 +48,16 @@ inline bool is_same_density(const SparseTensor& self, const SparseTensor& src) {
   return self.sparse_dim() == src.sparse_dim() && self.dense_dim() == src.dense_dim();
 }
 
+// Returns `self`'s indices as an int64 tensor.  Sparse tensors may carry
+// int32 indices (see SparseTensorImpl); kernels that have not been taught
+// to handle them call this at their entry so the promotion happens once,
+// at the API boundary, rather than element by element.  When the indices
+// are already int64 this is free (no copy).
+inline LongTensor long_indices(const SparseTensor& self) {
+  LongTensor indices = self._indices();
+  return indices.scalar_type() == kLong ? indices : indices.to(kLong);
+}
+
 // Give us a new values tensor, with the same dimensionality
 // as 'values' but with a new number of non-zero elements.
 // TODO: Expose this for real in ATen, some day?
@@ -72,6 +82,13 @@ inline Tensor new_values_with_size_of(const Tensor& values, int64_t nnz) {
 // if forceClone is true, the result will forced to be a clone of self.
 // if force_clone is true, the result will forced to be a clone of self.
 inline LongTensor flatten_indices(const Tensor& indices, IntArrayRef full_size, bool force_clone = false) {
+  // Flattened keys are bounded by prod(full_size), which can exceed the
+  // int32 range even when every entry of int32 indices is in bounds, so
+  // the keys are always computed in int64.  The .to() already copies, so
+  // force_clone is satisfied.
+  if (indices.scalar_type() != kLong) {
+    return flatten_indices(indices.to(kLong), full_size, /*force_clone=*/false);
+  }
   int64_t sparse_dim = indices.size(0);
   if (sparse_dim == 1) {
     if (force_clone) {
@@ -121,10 +138,13 @@ inline LongTensor flatten_indices(const Tensor& indices, IntArrayRef full_size,
 //   dims_to_flatten = [1]
 //   new_indices = [ 3, 1, 3 ]  # uncoalesced
 inline LongTensor flatten_indices_by_dims(const LongTensor& indices, const IntArrayRef& sizes, const IntArrayRef& dims_to_flatten){
-  LongTensor new_indices = at::zeros({indices.size(1)}, indices.options());
+  // As in flatten_indices, the keys are accumulated in int64 even for
+  // int32 input indices, since the flattened range can overflow int32.
+  LongTensor indices_long = indices.scalar_type() == kLong ? indices : indices.to(kLong);
+  LongTensor new_indices = at::zeros({indices.size(1)}, indices_long.options());
   for (auto d : dims_to_flatten) {
     new_indices.mul_(sizes[d]);
-    new_indices.add_(indices.select(0, d));
+    new_indices.add_(indices_long.select(0, d));
   }
   return new_indices;
 }
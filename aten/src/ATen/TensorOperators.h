@@ -2,9 +2,11 @@
 
 #include <c10/core/Scalar.h>
 #include <ATen/Tensor.h>
+#include <ATen/core/grad_mode.h>
 
 #include <string>
 #include <stdexcept>
+#include <utility>
 
 namespace at {
 
@@ -96,4 +98,107 @@ AT_FORALL_BINARY_OPS(DEFINE_OPERATOR)
 #undef DEFINE_OPERATOR
 #undef AT_FORALL_BINARY_OPS
 
+namespace detail {
+
+// True if `x` is a dying temporary whose buffer may be reused as the
+// output of an elementwise op producing a result with x's shape and
+// dtype: nothing else can observe the impl or its storage, the memory is
+// plain dense, and autograd is not recording (rewriting the op in place
+// would change what the graph sees).
+inline bool can_steal_tensor_as_output(const Tensor& x) {
+  return x.defined()
+      && x.use_count() == 1
+      && x.weak_use_count() == 1
+      && !x.is_sparse()
+      && !x.is_quantized()
+      && x.has_storage()
+      && x.storage().use_count() == 1
+      && x.unsafeGetTensorImpl()->is_non_overlapping_and_dense()
+      && !(GradMode::is_enabled() && x.requires_grad());
+}
+
+// The tensor-tensor form additionally requires the op's result to have
+// exactly x's shape, dtype and device, so the out-of-place and in-place
+// variants compute the same thing.
+inline bool can_steal_tensor_as_output(const Tensor& x, const Tensor& y) {
+  return can_steal_tensor_as_output(x)
+      && y.defined()
+      && !y.is_sparse()
+      && x.scalar_type() == y.scalar_type()
+      && x.device() == y.device()
+      && (y.dim() == 0 || x.sizes().equals(y.sizes()))
+      && !(GradMode::is_enabled() && y.requires_grad());
+}
+
+// The tensor-scalar form: type promotion can widen the result of an
+// integral (or bool) tensor op a floating scalar, so only floating
+// tensors keep their dtype unconditionally.
+inline bool can_steal_tensor_as_output(const Tensor& x, Scalar y) {
+  return can_steal_tensor_as_output(x)
+      && isFloatingType(x.scalar_type())
+      && !y.isComplex();
+}
+
+} // namespace detail
+
+// Rvalue-aware arithmetic overloads: when an operand is a dying
+// temporary that uniquely owns its buffer -- as every intermediate in a
+// chain like (a + b) * c + d is -- run the op in place on it instead of
+// allocating a fresh output.  + and * may also steal the right operand
+// (they commute); -, / and % only ever reuse the left one.  When
+// stealing is not safe the overloads fall through to the const& forms
+// above, so semantics are unchanged.
+#define DEFINE_STEALING_LHS_OPERATOR(op,meth) \
+static inline Tensor operator op(Tensor && x, const Tensor & y) { \
+  if (detail::can_steal_tensor_as_output(x, y)) { \
+    Tensor result = std::move(x); \
+    result.meth(y); \
+    return result; \
+  } \
+  return static_cast<const Tensor &>(x) op y; \
+} \
+static inline Tensor operator op(Tensor && x, Scalar y) { \
+  if (detail::can_steal_tensor_as_output(x, y)) { \
+    Tensor result = std::move(x); \
+    result.meth(y); \
+    return result; \
+  } \
+  return static_cast<const Tensor &>(x) op y; \
+}
+
+#define DEFINE_STEALING_COMMUTATIVE_OPERATOR(op,meth) \
+DEFINE_STEALING_LHS_OPERATOR(op,meth) \
+static inline Tensor operator op(const Tensor & x, Tensor && y) { \
+  if (detail::can_steal_tensor_as_output(y, x)) { \
+    Tensor result = std::move(y); \
+    result.meth(x); \
+    return result; \
+  } \
+  return x op static_cast<const Tensor &>(y); \
+} \
+static inline Tensor operator op(Tensor && x, Tensor && y) { \
+  if (detail::can_steal_tensor_as_output(x, y)) { \
+    Tensor result = std::move(x); \
+    result.meth(y); \
+    return result; \
+  } \
+  return static_cast<const Tensor &>(x) op std::move(y); \
+} \
+static inline Tensor operator op(Scalar x, Tensor && y) { \
+  if (detail::can_steal_tensor_as_output(y, x)) { \
+    Tensor result = std::move(y); \
+    result.meth(x); \
+    return result; \
+  } \
+  return x op static_cast<const Tensor &>(y); \
+}
+
+DEFINE_STEALING_COMMUTATIVE_OPERATOR(+,add_)
+DEFINE_STEALING_COMMUTATIVE_OPERATOR(*,mul_)
+DEFINE_STEALING_LHS_OPERATOR(-,sub_)
+DEFINE_STEALING_LHS_OPERATOR(/,div_)
+DEFINE_STEALING_LHS_OPERATOR(%,remainder_)
+#undef DEFINE_STEALING_COMMUTATIVE_OPERATOR
+#undef DEFINE_STEALING_LHS_OPERATOR
+
 }
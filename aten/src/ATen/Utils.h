@@ -38,30 +38,28 @@ static inline const Storage& checked_storage(
     int pos,
     DeviceType device_type,
     caffe2::TypeMeta dtype) {
-  if (expr.device_type() != device_type) {
-    AT_ERROR(
-        "Expected object of device type ",
-        device_type,
-        " but got device type ",
-        expr.data_ptr().device().type(),
-        " for argument #",
-        pos,
-        " '",
-        name,
-        "'");
-  }
-  if (expr.dtype() != dtype) {
-    AT_ERROR(
-        "Expected object of data type ",
-        dtype,
-        " but got data type ",
-        expr.dtype().id(),
-        " for argument #",
-        pos,
-        " '",
-        name,
-        "'");
-  }
+  TORCH_CHECK(
+      expr.device_type() == device_type,
+      "Expected object of device type ",
+      device_type,
+      " but got device type ",
+      expr.data_ptr().device().type(),
+      " for argument #",
+      pos,
+      " '",
+      name,
+      "'");
+  TORCH_CHECK(
+      expr.dtype() == dtype,
+      "Expected object of data type ",
+      dtype,
+      " but got data type ",
+      expr.dtype().id(),
+      " for argument #",
+      pos,
+      " '",
+      name,
+      "'");
   return expr;
 }
 
@@ -71,21 +69,18 @@ static inline TensorImpl* checked_dense_tensor_unwrap(const Tensor& expr, const
   if(allowNull && !expr.defined()) {
     return nullptr;
   }
-  if (expr.layout() != Layout::Strided) {
-    AT_ERROR("Expected dense tensor but got ", expr.layout(),
-             " for argument #", pos, " '", name, "' in call to ", api);
-  }
-  if (expr.device().type() != device_type) {
-    AT_ERROR("Expected object of device type ", device_type, " but got device type ", expr.device().type(),
-             " for argument #", pos, " '", name, "' in call to ", api);
-  }
-  if (expr.scalar_type() != scalar_type) {
-    AT_ERROR("Expected object of scalar type ", scalar_type, " but got scalar type ", expr.scalar_type(),
-             " for argument #", pos, " '", name, "' in call to ", api);
-  }
-  if (expr.is_variable()) {  // TODO: change this to check `.requires_grad()` and `GradMode::is_enabled()` when Variable and Tensor are merged
-    AT_ERROR("Expected Tensor (not Variable) for argument #", pos, " '", name, "' in call to ", api);
-  }
+  TORCH_CHECK(expr.layout() == Layout::Strided,
+              "Expected dense tensor but got ", expr.layout(),
+              " for argument #", pos, " '", name, "' in call to ", api);
+  TORCH_CHECK(expr.device().type() == device_type,
+              "Expected object of device type ", device_type, " but got device type ", expr.device().type(),
+              " for argument #", pos, " '", name, "' in call to ", api);
+  TORCH_CHECK(expr.scalar_type() == scalar_type,
+              "Expected object of scalar type ", scalar_type, " but got scalar type ", expr.scalar_type(),
+              " for argument #", pos, " '", name, "' in call to ", api);
+  // TODO: change this to check `.requires_grad()` and `GradMode::is_enabled()` when Variable and Tensor are merged
+  TORCH_CHECK(!expr.is_variable(),
+              "Expected Tensor (not Variable) for argument #", pos, " '", name, "' in call to ", api);
   return expr.unsafeGetTensorImpl();
 }
 
@@ -95,18 +90,16 @@ static inline std::vector<TensorImpl*> checked_tensor_list_unwrap(ArrayRef<Tenso
   unwrapped.reserve(tensors.size());
   for (unsigned int i = 0; i < tensors.size(); ++i) {
     const auto& expr = tensors[i];
-    if (tensorTypeIdToBackend(c10::impl::dispatchTypeId(expr.type_set())) != backend) {
-      AT_ERROR("Expected object of backend ", backend, " but got backend ", tensorTypeIdToBackend(c10::impl::dispatchTypeId(expr.type_set())),
-               " for sequence element ", i, " in sequence argument at position #", pos, " '", name, "'");
-    }
-    if (expr.scalar_type() != scalar_type) {
-      AT_ERROR("Expected object of scalar type ", scalar_type, " but got scalar type ", expr.scalar_type(),
-               " for sequence element ", i , " in sequence argument at position #", pos, " '", name, "'");
-    }
-    if (expr.is_variable()) {  // TODO: change this to check `.requires_grad()` and `GradMode::is_enabled()` when Variable and Tensor are merged
-      AT_ERROR("Expected Tensor (not Variable) for sequence element ",
-               i , " in sequence argument at position #", pos, " '", name, "'");
-    }
+    TORCH_CHECK(tensorTypeIdToBackend(c10::impl::dispatchTypeId(expr.type_set())) == backend,
+                "Expected object of backend ", backend, " but got backend ", tensorTypeIdToBackend(c10::impl::dispatchTypeId(expr.type_set())),
+                " for sequence element ", i, " in sequence argument at position #", pos, " '", name, "'");
+    TORCH_CHECK(expr.scalar_type() == scalar_type,
+                "Expected object of scalar type ", scalar_type, " but got scalar type ", expr.scalar_type(),
+                " for sequence element ", i , " in sequence argument at position #", pos, " '", name, "'");
+    // TODO: change this to check `.requires_grad()` and `GradMode::is_enabled()` when Variable and Tensor are merged
+    TORCH_CHECK(!expr.is_variable(),
+                "Expected Tensor (not Variable) for sequence element ",
+                i , " in sequence argument at position #", pos, " '", name, "'");
     unwrapped.emplace_back(expr.unsafeGetTensorImpl());
   }
   return unwrapped;
@@ -124,9 +117,8 @@ std::array<int64_t, N> check_intlist(ArrayRef<int64_t> list, const char * name,
     res.fill(list[0]);
     return res;
   }
-  if (list.size() != N) {
-    AT_ERROR("Expected a list of ", N, " ints but got ", list.size(), " for argument #", pos, " '", name, "'");
-  }
+  TORCH_CHECK(list.size() == N,
+              "Expected a list of ", N, " ints but got ", list.size(), " for argument #", pos, " '", name, "'");
   std::copy_n(list.begin(), N, res.begin());
   return res;
 }
@@ -150,10 +142,9 @@ static inline T * get_generator_or_default(Generator * expr, Generator * default
   if (!expr) {
     expr = defaultValue;
   }
-  if (T::device_type() == expr->device().type()) {
-    return static_cast<T*>(expr);
-  }
-  AT_ERROR("Expected a '", T::device_type(), "' device type for generator but found '", expr->device().type(), "'");
+  TORCH_CHECK(T::device_type() == expr->device().type(),
+              "Expected a '", T::device_type(), "' device type for generator but found '", expr->device().type(), "'");
+  return static_cast<T*>(expr);
 }
 
 /**
@@ -162,10 +153,9 @@ static inline T * get_generator_or_default(Generator * expr, Generator * default
  */
 template <typename T>
 static inline T * check_generator(Generator * expr) {
-  if (T::device_type() == expr->device().type()) {
-    return static_cast<T*>(expr);
-  }
-  AT_ERROR("Expected a '", T::device_type(), "' device type for generator but found '", expr->device().type(), "'");
+  TORCH_CHECK(T::device_type() == expr->device().type(),
+              "Expected a '", T::device_type(), "' device type for generator but found '", expr->device().type(), "'");
+  return static_cast<T*>(expr);
 }
 
 } // at
@@ -0,0 +1,204 @@
+// Micro-kernel harness for the vectorized CPU kernels under
+// aten/src/ATen/native/cpu. Each kernel listed below is run at every CPU
+// capability level it was compiled for (via DispatchStubControl, which can
+// pin a single stub to a variant), over a sweep of tensor sizes. For each
+// (kernel, capability, size) the harness reports ns/element and effective
+// GB/s, and every variant's output is cross-checked against the DEFAULT
+// (scalar) kernel so an AVX2-vs-scalar divergence is caught here instead
+// of at the model level.
+//
+// This is not a ctest target; run it manually (or from a nightly job) when
+// touching the vec256 kernels:
+//   vec256_bench            # full sweep + verification
+//   vec256_bench --verify   # numeric cross-check only, exits nonzero on
+//                           # mismatch
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/DispatchStub.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace at;
+using namespace at::native;
+
+namespace {
+
+using KernelFn =
+    std::function<Tensor(const Tensor& a, const Tensor& b)>;
+
+struct KernelCase {
+  // Name under which DEFINE_DISPATCH registered the stub.
+  const char* stub;
+  // Bytes read + written per element, for the GB/s column.
+  int64_t bytes_per_element;
+  // Relative tolerance for the cross-check. Vectorized transcendentals
+  // (Sleef) may differ from libm in the last ulps; that is expected.
+  double rtol;
+  KernelFn run;
+};
+
+const std::vector<KernelCase>& kernel_cases() {
+  static const std::vector<KernelCase> cases = {
+      {"add_stub", 12, 0.0,
+       [](const Tensor& a, const Tensor& b) { return at::add(a, b); }},
+      {"sub_stub", 12, 0.0,
+       [](const Tensor& a, const Tensor& b) { return at::sub(a, b); }},
+      {"mul_stub", 12, 0.0,
+       [](const Tensor& a, const Tensor& b) { return at::mul(a, b); }},
+      {"div_stub", 12, 1e-6,
+       [](const Tensor& a, const Tensor& b) { return at::div(a, b); }},
+      {"exp_stub", 8, 1e-5,
+       [](const Tensor& a, const Tensor& b) { return at::exp(a); }},
+      {"log_stub", 8, 1e-5,
+       [](const Tensor& a, const Tensor& b) { return at::log(a); }},
+      {"sqrt_stub", 8, 1e-6,
+       [](const Tensor& a, const Tensor& b) { return at::sqrt(a); }},
+      {"rsqrt_stub", 8, 1e-5,
+       [](const Tensor& a, const Tensor& b) { return at::rsqrt(a); }},
+      {"sigmoid_stub", 8, 1e-5,
+       [](const Tensor& a, const Tensor& b) { return at::sigmoid(a); }},
+      {"tanh_stub", 8, 1e-5,
+       [](const Tensor& a, const Tensor& b) { return at::tanh(a); }},
+      {"sum_stub", 4, 1e-5,
+       [](const Tensor& a, const Tensor& b) { return at::sum(a); }},
+      {"max_values_stub", 4, 0.0,
+       [](const Tensor& a, const Tensor& b) {
+         return at::max_values(a, {0});
+       }},
+  };
+  return cases;
+}
+
+const std::vector<int64_t>& size_sweep() {
+  static const std::vector<int64_t> sizes = {
+      1 << 10, 1 << 14, 1 << 18, 1 << 22};
+  return sizes;
+}
+
+// Capability levels this stub has a compiled kernel for, in ascending
+// order. DEFAULT is always first when present.
+std::vector<CPUCapability> available_capabilities(DispatchStubControl& ctl) {
+  std::vector<CPUCapability> result;
+  for (int c = 0; c < static_cast<int>(CPUCapability::NUM_OPTIONS); ++c) {
+    auto capability = static_cast<CPUCapability>(c);
+    if (ctl.has_cpu_kernel(capability)) {
+      result.push_back(capability);
+    }
+  }
+  return result;
+}
+
+int64_t time_ns(const KernelCase& kernel, const Tensor& a, const Tensor& b,
+                int64_t iters) {
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < iters; ++i) {
+    Tensor out = kernel.run(a, b);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+      .count();
+}
+
+// Compares a variant's output against the DEFAULT kernel's. Returns true
+// on agreement and prints a diagnostic otherwise.
+bool check_variant(const KernelCase& kernel, DispatchStubControl& ctl,
+                   CPUCapability capability, const Tensor& a, const Tensor& b,
+                   const Tensor& reference) {
+  ctl.force_cpu_capability(capability);
+  Tensor out = kernel.run(a, b);
+  ctl.reset_cpu_capability();
+  if (kernel.rtol == 0.0 ? out.equal(reference)
+                         : out.allclose(reference, kernel.rtol, kernel.rtol)) {
+    return true;
+  }
+  double max_diff =
+      (out.toType(kDouble) - reference.toType(kDouble)).abs().max()
+          .item<double>();
+  std::printf(
+      "MISMATCH %s: %s disagrees with DEFAULT, max abs diff %.3e\n",
+      kernel.stub, cpu_capability_name(capability), max_diff);
+  return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  bool verify_only = false;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--verify") == 0) {
+      verify_only = true;
+    } else {
+      std::printf("usage: %s [--verify]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  // Single-threaded so the numbers reflect the kernel, not the partitioner.
+  at::set_num_threads(1);
+  at::manual_seed(42);
+  std::printf("cpu capability: %s\n",
+              cpu_capability_name(get_cpu_capability()));
+
+  bool ok = true;
+  for (const KernelCase& kernel : kernel_cases()) {
+    DispatchStubControl& ctl = get_dispatch_stub_control(kernel.stub);
+    auto capabilities = available_capabilities(ctl);
+    if (capabilities.empty() ||
+        capabilities.front() != CPUCapability::DEFAULT) {
+      std::printf("%-16s no DEFAULT kernel, skipped\n", kernel.stub);
+      continue;
+    }
+
+    // Cross-check every variant against DEFAULT at every sweep size; the
+    // small sizes exercise the non-vectorized tail of each kernel.
+    for (int64_t n : size_sweep()) {
+      // Offset away from zero so div/log/rsqrt have well-behaved inputs.
+      Tensor a = at::rand({n}) + 0.5;
+      Tensor b = at::rand({n}) + 0.5;
+      ctl.force_cpu_capability(CPUCapability::DEFAULT);
+      Tensor reference = kernel.run(a, b);
+      ctl.reset_cpu_capability();
+      for (CPUCapability capability : capabilities) {
+        if (capability == CPUCapability::DEFAULT) {
+          continue;
+        }
+        ok = check_variant(kernel, ctl, capability, a, b, reference) && ok;
+      }
+    }
+    if (verify_only) {
+      std::printf("%-16s verified against DEFAULT\n", kernel.stub);
+      continue;
+    }
+
+    for (CPUCapability capability : capabilities) {
+      ctl.force_cpu_capability(capability);
+      for (int64_t n : size_sweep()) {
+        Tensor a = at::rand({n}) + 0.5;
+        Tensor b = at::rand({n}) + 0.5;
+        // Aim for a fixed amount of work per measurement.
+        int64_t iters = std::max<int64_t>(10, (1 << 24) / n);
+        time_ns(kernel, a, b, std::max<int64_t>(1, iters / 10)); // warmup
+        int64_t ns = time_ns(kernel, a, b, iters);
+        double ns_per_element =
+            static_cast<double>(ns) / (iters * n);
+        double gb_per_s = kernel.bytes_per_element / ns_per_element;
+        std::printf(
+            "%-16s %-8s n=%-8lld %8.3f ns/elem %8.2f GB/s\n",
+            kernel.stub, cpu_capability_name(capability),
+            static_cast<long long>(n), ns_per_element, gb_per_s);
+      }
+      ctl.reset_cpu_capability();
+    }
+  }
+
+  if (!ok) {
+    std::printf("FAILED: variant disagreement detected\n");
+    return 1;
+  }
+  return 0;
+}
@@ -30,6 +30,55 @@
 
 namespace at {
 
+/**
+ * A value-type, counter-based generator for parallelized CPU kernels.
+ *
+ * Wraps the Philox4_32_10 engine addressed by (seed, subsequence, offset)
+ * and exposes the same sampling surface as CPUGenerator (random, random64
+ * and the cached-normal accessors), so the distribution structs below can
+ * draw from either. A kernel reserves an offset range from the shared
+ * CPUGenerator once (philox_engine_inputs, under the generator mutex) and
+ * then gives every element or fixed-size chunk its own subsequence; each
+ * sample is a pure function of (seed, subsequence, offset), so the result
+ * is the same for any number of threads and any work partitioning.
+ */
+class PhiloxCPUGenerator {
+ public:
+  PhiloxCPUGenerator(uint64_t seed, uint64_t subsequence, uint64_t offset)
+    : engine_(seed, subsequence, offset) {}
+
+  uint32_t random() {
+    return engine_();
+  }
+
+  uint64_t random64() {
+    uint32_t random1 = engine_();
+    uint32_t random2 = engine_();
+    return (static_cast<uint64_t>(random1) << 32) | random2;
+  }
+
+  c10::optional<float> next_float_normal_sample() {
+    return next_float_normal_sample_;
+  }
+
+  c10::optional<double> next_double_normal_sample() {
+    return next_double_normal_sample_;
+  }
+
+  void set_next_float_normal_sample(c10::optional<float> randn) {
+    next_float_normal_sample_ = randn;
+  }
+
+  void set_next_double_normal_sample(c10::optional<double> randn) {
+    next_double_normal_sample_ = randn;
+  }
+
+ private:
+  Philox4_32_10 engine_;
+  c10::optional<float> next_float_normal_sample_;
+  c10::optional<double> next_double_normal_sample_;
+};
+
 // Using VectorType in Box-muller derived distributions to avoid
 // code duplication
 template <typename T>
@@ -85,7 +134,8 @@ struct uniform_real_distribution {
     b = b_in;
   }
 
-  inline dist_acctype<T> operator()(at::CPUGenerator* generator){
+  template <typename RNG>
+  inline dist_acctype<T> operator()(RNG* generator){
     dist_acctype<T> x;
     if(std::is_same<T, double>::value) {
       x = (generator->random64() & DOUBLE_MASK) * DOUBLE_DIVISOR;
@@ -115,7 +165,8 @@ struct normal_distribution {
     stdv = stdv_in;
   }
 
-  inline dist_acctype<T> operator()(at::CPUGenerator* generator){
+  template <typename RNG>
+  inline dist_acctype<T> operator()(RNG* generator){
     dist_acctype<T> ret;
     // return cached values if available
     if (std::is_same<T, double>::value) {
@@ -166,7 +217,8 @@ struct bernoulli_distribution {
     p = p_in;
   }
 
-  inline int operator()(at::CPUGenerator* generator) { 
+  template <typename RNG>
+  inline int operator()(RNG* generator) { 
     uniform_real_distribution<T> uniform(0.0, 1.0);
     return uniform(generator) < p;
   }
@@ -186,7 +238,8 @@ struct geometric_distribution {
     p = p_in;
   }
 
-  inline int operator()(at::CPUGenerator* generator) {
+  template <typename RNG>
+  inline int operator()(RNG* generator) {
     uniform_real_distribution<T> uniform(0.0, 1.0);
     dist_acctype<T> sample = uniform(generator);
     return static_cast<int>(::log(static_cast<T>(1.0)-sample) / ::log(p)) + 1;
@@ -206,7 +259,8 @@ struct exponential_distribution {
     lambda = lambda_in;
   }
 
-  inline T operator()(at::CPUGenerator* generator) {
+  template <typename RNG>
+  inline T operator()(RNG* generator) {
     uniform_real_distribution<T> uniform(0.0, 1.0);
     dist_acctype<T> sample = uniform(generator);
     return static_cast<T>(-1.0) / lambda * ::log(static_cast<T>(1.0)-sample);
@@ -227,7 +281,8 @@ struct cauchy_distribution {
     sigma = sigma_in;
   }
 
-  inline T operator()(at::CPUGenerator* generator) {
+  template <typename RNG>
+  inline T operator()(RNG* generator) {
     uniform_real_distribution<T> uniform(0.0, 1.0);
     return median + sigma * ::tan(static_cast<T>(M_PI) * (uniform(generator)-static_cast<T>(0.5)));
   }
@@ -251,7 +306,8 @@ struct lognormal_distribution {
     stdv = stdv_in;
   }
 
-  inline T operator()(at::CPUGenerator* generator){
+  template <typename RNG>
+  inline T operator()(RNG* generator){
     normal_distribution<T> normal(mean, stdv);
     return ::exp(normal(generator));
   }
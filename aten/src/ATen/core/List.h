@@ -6,6 +6,8 @@
 #include <c10/util/intrusive_ptr.h>
 #include <c10/util/ArrayRef.h>
 #include <c10/util/Optional.h>
+#include <c10/util/SmallVector.h>
+#include <stdexcept>
 #include <vector>
 
 namespace at {
@@ -19,9 +21,16 @@ using TypePtr = std::shared_ptr<Type>;
 
 namespace detail {
 
+// Elements are stored inline in the ListImpl allocation up to this many
+// entries, so the short lists that dominate JIT op arguments (size and
+// stride lists, usually <= 5 elements like DimVector assumes) cost a
+// single heap allocation instead of one for the impl plus one for the
+// element buffer. Longer lists spill to the heap like std::vector.
+constexpr size_t kListInlineSize = 5;
+
 template<class StorageT>
 struct ListImpl final : public c10::intrusive_ptr_target {
-  using list_type = std::vector<StorageT>;
+  using list_type = SmallVector<StorageT, kListInlineSize>;
 
   explicit ListImpl(list_type list_, TypePtr elementType_)
   : list(std::move(list_))
@@ -31,6 +40,15 @@ struct ListImpl final : public c10::intrusive_ptr_target {
 
   TypePtr elementType;
 
+  // SmallVector::at only asserts; List's contract is to throw like
+  // std::vector::at did when it was the backing store.
+  StorageT& at(size_t pos) {
+    if (pos >= list.size()) {
+      throw std::out_of_range("List index out of range");
+    }
+    return list[pos];
+  }
+
   intrusive_ptr<ListImpl> copy() const {
     return make_intrusive<ListImpl>(list, elementType);
   }
@@ -178,7 +196,7 @@ template<class T> List<T> toTypedList(List<IValue> list);
 template<class T> List<IValue> toGenericList(List<T> list);
 const IValue* ptr_to_first_element(const List<IValue>& list);
 template<class T> List<T> toList(std::vector<T> list);
-template<class T> const std::vector<T>& toVector(const List<T>& list);
+template<class T> std::vector<T> toVector(const List<T>& list);
 }
 template<class T> bool list_is_equal(const List<T>& lhs, const List<T>& rhs);
 
@@ -435,7 +453,7 @@ private:
   template<class T_> friend List<IValue> impl::toGenericList(List<T_>);
   friend const IValue* impl::ptr_to_first_element(const List<IValue>& list);
   template<class T_> friend List<T_> impl::toList(std::vector<T_> list);
-  template<class T_> friend const std::vector<T_>& impl::toVector(const List<T_>& list);
+  template<class T_> friend std::vector<T_> impl::toVector(const List<T_>& list);
 };
 
 namespace impl {
@@ -445,21 +463,22 @@ namespace impl {
 using GenericList = List<IValue>;
 
 inline const IValue* ptr_to_first_element(const GenericList& list) {
-  return &list.impl_->list[0];
+  return list.impl_->list.data();
 }
 
 template<class T>
-const std::vector<T>& toVector(const List<T>& list) {
-  static_assert(std::is_same<T, IValue>::value || std::is_same<T, typename List<T>::StorageT>::value, "toVector only works for lists that store their elements as std::vector<T>. You tried to call it for a list that stores its elements as std::vector<IValue>.");
+std::vector<T> toVector(const List<T>& list) {
+  static_assert(std::is_same<T, IValue>::value || std::is_same<T, typename List<T>::StorageT>::value, "toVector only works for lists that store their elements directly as T. You tried to call it for a list that stores its elements as IValue.");
 
-  return list.impl_->list;
+  return std::vector<T>(list.impl_->list.begin(), list.impl_->list.end());
 }
 
 template<class T>
 List<T> toList(std::vector<T> list) {
-  static_assert(std::is_same<T, IValue>::value || std::is_same<T, typename List<T>::StorageT>::value, "toList only works for lists that store their elements as std::vector<T>. You tried to call it for a list that stores its elements as std::vector<IValue>.");
+  static_assert(std::is_same<T, IValue>::value || std::is_same<T, typename List<T>::StorageT>::value, "toList only works for lists that store their elements directly as T. You tried to call it for a list that stores its elements as IValue.");
   List<T> result;
-  result.impl_->list = std::move(list);
+  result.impl_->list.assign(
+      std::make_move_iterator(list.begin()), std::make_move_iterator(list.end()));
   return result;
 }
 
@@ -63,13 +63,15 @@ impl::GenericList toGenericList(List<T> list) {
 
 template<class T>
 List<T>::List(List&& rhs) noexcept: impl_(std::move(rhs.impl_)) {
-  rhs.impl_ = make_intrusive<detail::ListImpl<StorageT>>(std::vector<StorageT>{}, impl_->elementType);
+  rhs.impl_ = make_intrusive<detail::ListImpl<StorageT>>(
+      typename detail::ListImpl<StorageT>::list_type(), impl_->elementType);
 }
 
 template<class T>
 List<T>& List<T>::operator=(List&& rhs) noexcept {
   impl_ = std::move(rhs.impl_);
-  rhs.impl_ = make_intrusive<detail::ListImpl<StorageT>>(std::vector<StorageT>{}, impl_->elementType);
+  rhs.impl_ = make_intrusive<detail::ListImpl<StorageT>>(
+      typename detail::ListImpl<StorageT>::list_type(), impl_->elementType);
   return *this;
 }
 
@@ -134,28 +136,28 @@ void swap(ListElementReference<T, Iterator, StorageT>&& lhs, ListElementReferenc
 
 template<class T>
 void List<T>::set(size_type pos, const value_type& value) const {
-  impl_->list.at(pos) = detail::list_element_from<T, StorageT>(value);
+  impl_->at(pos) = detail::list_element_from<T, StorageT>(value);
 }
 
 template<class T>
 void List<T>::set(size_type pos, value_type&& value) const {
-  impl_->list.at(pos) = detail::list_element_from<T, StorageT>(std::move(value));
+  impl_->at(pos) = detail::list_element_from<T, StorageT>(std::move(value));
 }
 
 template<class T>
 typename List<T>::value_type List<T>::get(size_type pos) const {
-  return detail::list_element_to<T>(impl_->list.at(pos));
+  return detail::list_element_to<T>(impl_->at(pos));
 }
 
 template<class T>
 typename List<T>::internal_reference_type List<T>::operator[](size_type pos) const {
-  static_cast<void>(impl_->list.at(pos)); // Throw the exception if it is out of range.
+  static_cast<void>(impl_->at(pos)); // Throw the exception if it is out of range.
   return {impl_->list.begin() + pos};
 }
 
 template<class T>
 typename List<T>::value_type List<T>::extract(size_type pos) const {
-  auto& elem = impl_->list.at(pos);
+  auto& elem = impl_->at(pos);
   auto result = detail::list_element_to<T>(std::move(elem));
   if (std::is_same<IValue, StorageT>::value) {
     // Reset the list element to a T() instead of None to keep it correctly typed
@@ -208,7 +210,8 @@ template<class T>
 template<class... Args>
 typename List<T>::iterator List<T>::emplace(iterator pos, Args&&... value) const {
   // TODO Use list_element_from?
-  return iterator { impl_->list.emplace(pos.iterator_, std::forward<Args>(value)...) };
+  // SmallVector has no emplace(pos, ...); construct and insert instead.
+  return iterator { impl_->list.insert(pos.iterator_, StorageT(std::forward<Args>(value)...)) };
 }
 
 template<class T>
@@ -37,9 +37,10 @@ typedef at::detail::Array<float, 2> FLOAT2;
  * Refer to: http://www.thesalmons.org/john/random123/papers/random123sc11.pdf
  * for details regarding the engine.
  *
- * Note that currently this implementation of the philox engine is not used
- * anywhere except for tests in cpu_generator_test.cpp. However, this engine
- * will replace curandStatePhilox4_32_10_t in the future.
+ * This engine backs the counter-based CPU sampling path (see
+ * PhiloxCPUGenerator in DistributionsHelper.h and
+ * CPUGenerator::philox_engine_inputs). It will also replace
+ * curandStatePhilox4_32_10_t in the future.
  * 
  * The philox engine takes a seed value, a subsequeunce
  * for starting the generation and an offset for the subsequence.
@@ -73,48 +73,61 @@ namespace detail {
 
 class KernelTable_ final {
  public:
+  KernelTable_() : kernels_(), size_(0) {}
+
   void set(TensorTypeId key, const KernelFunction& value, const std::string& operator_name) {
-    auto emplaced = map_.emplace(key, value);
-    if (!emplaced.second) {
-      // Element already existed. Overwrite it.
-      emplaced.first->second = value;
+    auto& slot = kernels_[static_cast<uint8_t>(key)];
+    if (slot.has_value()) {
       TORCH_WARN("Registered a kernel for operator ", operator_name," with dispatch key ", toString(key), " that overwrote a previously registered kernel with the same dispatch key for the same operator.");
+    } else {
+      ++size_;
     }
+    slot = value;
   }
 
   void removeIfExists(TensorTypeId key, const std::string& operator_name) {
-    auto num_removed = map_.erase(key);
-    TORCH_INTERNAL_ASSERT(num_removed <= 1); // This is not a multi-map
+    auto& slot = kernels_[static_cast<uint8_t>(key)];
+    if (slot.has_value()) {
+      slot = c10::nullopt;
+      --size_;
+    }
   }
 
   const KernelFunction* lookup(TensorTypeId key) const {
-    auto found = map_.find(key);
-    if (found != map_.end()) {
-      return &found->second;
-    } else {
-      return nullptr;
+    const auto& slot = kernels_[static_cast<uint8_t>(key)];
+    if (C10_LIKELY(slot.has_value())) {
+      return &*slot;
     }
+    return nullptr;
   }
 
   size_t size() const {
-    return map_.size();
+    return size_;
   }
 
   std::string list_all_dispatch_keys() const {
-    if (map_.size() == 0) {
-      return "[]";
-    }
     std::ostringstream str;
-    str << "[" << toString(map_.begin()->first);
-    for (auto iter = ++map_.begin(); iter != map_.end(); ++iter) {
-      str << ", " << toString(iter->first);
+    str << "[";
+    bool first = true;
+    for (size_t i = 0; i < kernels_.size(); ++i) {
+      if (kernels_[i].has_value()) {
+        if (!first) {
+          str << ", ";
+        }
+        str << toString(static_cast<TensorTypeId>(i));
+        first = false;
+      }
     }
     str << "]";
     return str.str();
   }
 
  private:
-   ska::flat_hash_map<TensorTypeId, KernelFunction> map_;
+   // Indexed directly by TensorTypeId, so the per-call lookup is a single
+   // load instead of a hash probe.  The table is small (NumTensorIds
+   // entries), so the per-operator memory cost is modest.
+   std::array<c10::optional<KernelFunction>, static_cast<uint8_t>(TensorTypeId::NumTensorIds)> kernels_;
+   size_t size_;
 };
 } // namespace detail
 
@@ -20,6 +20,16 @@ void GradMode::set_enabled(bool enabled) {
   GradMode_enabled = enabled;
 }
 
+thread_local bool InferenceMode_enabled = false;
+
+bool InferenceMode::is_enabled() {
+  return InferenceMode_enabled;
+}
+
+void InferenceMode::set_enabled(bool enabled) {
+  InferenceMode_enabled = enabled;
+}
+
 #else
 
 bool GradMode::is_enabled() {
@@ -30,6 +40,14 @@ void GradMode::set_enabled(bool enabled) {
   throw std::runtime_error("GradMode is not supported on mobile");
 }
 
+bool InferenceMode::is_enabled() {
+  throw std::runtime_error("InferenceMode is not supported on mobile");
+}
+
+void InferenceMode::set_enabled(bool enabled) {
+  throw std::runtime_error("InferenceMode is not supported on mobile");
+}
+
 #endif
 
 } // namespace at
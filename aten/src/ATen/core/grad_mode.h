@@ -27,4 +27,31 @@ struct CAFFE2_API NoGradGuard : public AutoGradMode {
   NoGradGuard() : AutoGradMode(/*enabled=*/false) {}
 };
 
+struct CAFFE2_API InferenceMode {
+  static bool is_enabled();
+  static void set_enabled(bool enabled);
+};
+
+// A RAII, thread local (!) guard that puts future operations in inference
+// mode. Grad mode is disabled for its duration (as with NoGradGuard), and in
+// addition the per-op autograd bookkeeping that no-grad mode still pays for
+// is skipped: in-place operations do not bump the version counter and views
+// do not get view metadata attached. Tensors mutated under this guard must
+// not alias anything saved for a pending backward pass -- the skipped version
+// bumps are what would otherwise detect such mutations.
+struct CAFFE2_API AutoInferenceMode {
+  AutoInferenceMode()
+      : prev_mode(InferenceMode::is_enabled()),
+        prev_grad_mode(GradMode::is_enabled()) {
+    InferenceMode::set_enabled(true);
+    GradMode::set_enabled(false);
+  }
+  ~AutoInferenceMode() {
+    InferenceMode::set_enabled(prev_mode);
+    GradMode::set_enabled(prev_grad_mode);
+  }
+  bool prev_mode;
+  bool prev_grad_mode;
+};
+
 }
@@ -82,9 +82,11 @@ namespace c10 {
   _(prim, Guard)                     \
   _(prim, BailOut)                   \
   _(prim, FusedConcat)               \
+  _(prim, FusedSum)                  \
   _(prim, ConstantChunk)             \
   _(prim, MMTreeReduce)              \
   _(prim, MMBatchSide)               \
+  _(prim, AddMMBatchSide)            \
   _(prim, min)                       \
   _(prim, max)                       \
   _(prim, abs)                       \
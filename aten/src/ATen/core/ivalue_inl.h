@@ -229,8 +229,8 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
     completed_ = true;
     value_ = std::move(value);
 
-    fireCallbacks();
     finished_cv_.notify_all();
+    fireCallbacks(std::move(lock));
   }
 
   void markCompleted() {
@@ -244,8 +244,8 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
     has_error = true;
     error = std::move(error_);
 
-    fireCallbacks();
     finished_cv_.notify_all();
+    fireCallbacks(std::move(lock));
   }
 
   // Get the result of the current future.
@@ -288,14 +288,20 @@ struct C10_EXPORT ivalue::Future final : c10::intrusive_ptr_target {
   }
 
  private:
-  void fireCallbacks() {
+  // Once completed_ is set to true, no one can add a new callback to the
+  // list, so the list can be detached and the lock released before the
+  // callbacks run. Running them unlocked lets a callback call back into
+  // this future (wait(), value()) or do arbitrarily long work -- the
+  // interpreter relies on this to resume a suspended continuation inline
+  // on the thread that completed the future.
+  void fireCallbacks(std::unique_lock<std::mutex> lock) {
     AT_ASSERT(completed());
-    // There is no need to protect callbacks with the lock.
-    // Once completed_ is set to true, no one can add new callback to the list.
-    for (auto& callback : callbacks) {
+    std::vector<std::function<void(void)>> cbs;
+    cbs.swap(callbacks);
+    lock.unlock();
+    for (auto& callback : cbs) {
       callback();
     }
-    callbacks.clear();
   }
 
   std::mutex mutex_;
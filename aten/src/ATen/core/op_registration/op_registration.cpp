@@ -135,6 +135,11 @@ void RegisterOperators::registerOp_(Options&& options) {
   FunctionSchema schema = std::move(*options.schemaOrName_).right();
   OperatorName op_name = schema.operator_name();
 
+  c10::optional<StaticInitCostGuard> cost_guard;
+  if (static_init_profiling_enabled()) {
+    cost_guard.emplace("c10_op", toString(op_name));
+  }
+
   auto operatorOptions = makeOperatorOptions_(options);
 
   if (0 == options.kernels.size()) {
@@ -7,6 +7,7 @@
 
 #include <ATen/core/dispatch/Dispatcher.h>
 #include <ATen/core/op_registration/infer_schema.h>
+#include <c10/util/StaticInitProfiler.h>
 #if !defined(CAFFE2_IS_XPLAT_BUILD)
 #include <torch/csrc/jit/script/function_schema_parser.h>
 #endif
@@ -93,7 +94,12 @@ public:
       #if defined(CAFFE2_IS_XPLAT_BUILD)
         throw std::logic_error("Tried to register operator " + schemaOrName + ". We don't support registering c10 ops on mobile yet because the function schema parser isn't present in the mobile build.");
       #else
-        schemaOrName_ = torch::jit::parseSchemaOrName(schemaOrName);
+        if (c10::static_init_profiling_enabled()) {
+          c10::StaticInitCostGuard guard("schema_parse", schemaOrName);
+          schemaOrName_ = torch::jit::parseSchemaOrName(schemaOrName);
+        } else {
+          schemaOrName_ = torch::jit::parseSchemaOrName(schemaOrName);
+        }
       #endif
 
       return std::move(*this);
@@ -4,8 +4,12 @@
 
 #include <ATen/cpu/vec256/vec256_base.h>
 #include <ATen/cpu/vec256/vec256_float.h>
+#include <ATen/cpu/vec256/vec256_float_neon.h>
+#include <ATen/cpu/vec256/vec256_bfloat16.h>
+#include <ATen/cpu/vec256/vec256_half.h>
 #include <ATen/cpu/vec256/vec256_double.h>
 #include <ATen/cpu/vec256/vec256_int.h>
+#include <ATen/cpu/vec256/vec256_int_neon.h>
 #include <ATen/cpu/vec256/vec256_qint.h>
 #include <ATen/cpu/vec256/vec256_complex_float.h>
 #include <ATen/cpu/vec256/vec256_complex_double.h>
@@ -46,6 +50,16 @@ std::ostream& operator<<(std::ostream& stream, const Vec256<T>& vec) {
 }
 
 
+// Note [AVX512 capability]
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The AVX512 kernel tier (CPU_CAPABILITY_AVX512) reuses the 256-bit
+// specializations below: AVX512 implies AVX2, so the same intrinsics compile,
+// but the compiler is free to emit EVEX encodings and use the full 32-register
+// file, which is where most of the win on Skylake-SP/Ice Lake comes from
+// without paying the license-based frequency penalty of 512-bit ALU ops on
+// every elementwise kernel. Kernels that profit from genuinely wider vectors
+// can specialize on CPU_CAPABILITY_AVX512 explicitly.
+
 #if defined(__AVX__) && !defined(_MSC_VER)
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ CAST (AVX) ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
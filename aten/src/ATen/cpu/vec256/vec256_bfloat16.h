@@ -0,0 +1,395 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <c10/util/BFloat16.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(__AVX2__) && !defined(_MSC_VER)
+
+// Widens 16 packed bfloat16 values into two float vectors (low half first).
+static inline void cvtbf16_fp32(const __m256i& a, __m256& o1, __m256& o2) {
+  __m128i lo = _mm256_extractf128_si256(a, 0);
+  __m128i hi = _mm256_extractf128_si256(a, 1);
+  o1 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(lo), 16));
+  o2 = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(hi), 16));
+}
+
+// Narrows two float vectors back to 16 packed bfloat16 values, applying the
+// same round-to-nearest-even + canonical-NaN logic as
+// c10::detail::round_to_nearest_even.
+static inline __m256i cvtfp32_bf16(const __m256& a, const __m256& b) {
+  __m256i lo = _mm256_castps_si256(a);
+  __m256i hi = _mm256_castps_si256(b);
+  __m256i nan = _mm256_set1_epi32(0x7fc0);
+  __m256i mask_lo = _mm256_castps_si256(_mm256_cmp_ps(a, a, _CMP_ORD_Q));
+  __m256i mask_hi = _mm256_castps_si256(_mm256_cmp_ps(b, b, _CMP_ORD_Q));
+  __m256i ones = _mm256_set1_epi32(0x1);
+  __m256i vec_bias = _mm256_set1_epi32(0x7fff);
+  // uint32_t lsb = (input >> 16) & 1;
+  auto t_lo = _mm256_and_si256(_mm256_srli_epi32(lo, 16), ones);
+  auto t_hi = _mm256_and_si256(_mm256_srli_epi32(hi, 16), ones);
+  // uint32_t rounding_bias = 0x7fff + lsb;
+  t_lo = _mm256_add_epi32(t_lo, vec_bias);
+  t_hi = _mm256_add_epi32(t_hi, vec_bias);
+  // input += rounding_bias; input >>= 16;
+  t_lo = _mm256_srli_epi32(_mm256_add_epi32(t_lo, lo), 16);
+  t_hi = _mm256_srli_epi32(_mm256_add_epi32(t_hi, hi), 16);
+  // NaN inputs become the canonical bfloat16 NaN.
+  t_lo = _mm256_blendv_epi8(nan, t_lo, mask_lo);
+  t_hi = _mm256_blendv_epi8(nan, t_hi, mask_hi);
+  t_lo = _mm256_packus_epi32(t_lo, t_hi); // t_hi[4-7] t_lo[4-7] t_hi[0-3] t_lo[0-3]
+  return _mm256_permute4x64_epi64(t_lo, 0xd8); // 11 01 10 00
+}
+
+// Packs two fp32 comparison masks into one 16-bit-lane mask.
+static inline __m256i merge_compare_result(const __m256& lo, const __m256& hi) {
+  __m256i t_lo = _mm256_castps_si256(lo);
+  __m256i t_hi = _mm256_castps_si256(hi);
+  t_lo = _mm256_packs_epi32(t_lo, t_hi);
+  return _mm256_permute4x64_epi64(t_lo, 0xd8);
+}
+
+template <> class Vec256<BFloat16> {
+private:
+  __m256i values;
+public:
+  using value_type = uint16_t;
+  static constexpr int size() {
+    return 16;
+  }
+  Vec256() {}
+  Vec256(__m256i v) : values(v) {}
+  Vec256(BFloat16 val) {
+    values = _mm256_set1_epi16(static_cast<short>(val.x));
+  }
+  operator __m256i() const {
+    return values;
+  }
+  template <int64_t mask>
+  static Vec256<BFloat16> blend(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+    __at_align32__ uint16_t tmp_values[size()];
+    a.store(tmp_values);
+    __at_align32__ uint16_t tmp_b[size()];
+    b.store(tmp_b);
+    for (int64_t i = 0; i < size(); i++) {
+      if ((mask >> i) & 0x01) {
+        tmp_values[i] = tmp_b[i];
+      }
+    }
+    return loadu(tmp_values);
+  }
+  static Vec256<BFloat16> blendv(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b,
+                                 const Vec256<BFloat16>& mask) {
+    return _mm256_blendv_epi8(a.values, b.values, mask.values);
+  }
+  static Vec256<BFloat16> arange(BFloat16 base = 0.f, BFloat16 step = 1.f) {
+    __at_align32__ BFloat16 tmp_values[size()];
+    float base_f = base;
+    float step_f = step;
+    for (int64_t i = 0; i < size(); i++) {
+      tmp_values[i] = BFloat16(base_f + i * step_f);
+    }
+    return loadu(tmp_values);
+  }
+  static Vec256<BFloat16> set(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b,
+                              int64_t count = size()) {
+    __at_align32__ uint16_t tmp_values[size()];
+    a.store(tmp_values);
+    __at_align32__ uint16_t tmp_b[size()];
+    b.store(tmp_b);
+    for (int64_t i = 0; i < count; i++) {
+      tmp_values[i] = tmp_b[i];
+    }
+    return loadu(tmp_values);
+  }
+  static Vec256<BFloat16> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size()) {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    }
+    __at_align32__ uint16_t tmp_values[size()] = {};
+    std::memcpy(tmp_values, ptr, count * sizeof(uint16_t));
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmp_values));
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), values);
+    } else if (count > 0) {
+      __at_align32__ uint16_t tmp_values[size()];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(tmp_values), values);
+      std::memcpy(ptr, tmp_values, count * sizeof(uint16_t));
+    }
+  }
+  const BFloat16& operator[](int idx) const = delete;
+  BFloat16& operator[](int idx) = delete;
+
+  // Runs `op` on the two widened fp32 halves and narrows the results.
+  template <typename Op>
+  Vec256<BFloat16> map_fp32(const Op& op) const {
+    __m256 lo, hi;
+    cvtbf16_fp32(values, lo, hi);
+    auto o1 = op(Vec256<float>(lo));
+    auto o2 = op(Vec256<float>(hi));
+    return cvtfp32_bf16(o1, o2);
+  }
+  template <typename Op>
+  Vec256<BFloat16> map2_fp32(const Vec256<BFloat16>& b, const Op& op) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(b.values, b_lo, b_hi);
+    auto o1 = op(Vec256<float>(a_lo), Vec256<float>(b_lo));
+    auto o2 = op(Vec256<float>(a_hi), Vec256<float>(b_hi));
+    return cvtfp32_bf16(o1, o2);
+  }
+
+  Vec256<BFloat16> abs() const {
+    // Clear the sign bit directly on the 16-bit lanes.
+    return _mm256_andnot_si256(_mm256_set1_epi16((short)0x8000), values);
+  }
+  Vec256<BFloat16> angle() const {
+    return _mm256_setzero_si256();
+  }
+  Vec256<BFloat16> real() const {
+    return *this;
+  }
+  Vec256<BFloat16> imag() const {
+    return _mm256_setzero_si256();
+  }
+  Vec256<BFloat16> conj() const {
+    return *this;
+  }
+  Vec256<BFloat16> acos() const {
+    return map_fp32([](const Vec256<float>& x) { return x.acos(); });
+  }
+  Vec256<BFloat16> asin() const {
+    return map_fp32([](const Vec256<float>& x) { return x.asin(); });
+  }
+  Vec256<BFloat16> atan() const {
+    return map_fp32([](const Vec256<float>& x) { return x.atan(); });
+  }
+  Vec256<BFloat16> atan2(const Vec256<BFloat16>& b) const {
+    return map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+      return x.atan2(y);
+    });
+  }
+  Vec256<BFloat16> erf() const {
+    return map_fp32([](const Vec256<float>& x) { return x.erf(); });
+  }
+  Vec256<BFloat16> erfc() const {
+    return map_fp32([](const Vec256<float>& x) { return x.erfc(); });
+  }
+  Vec256<BFloat16> erfinv() const {
+    return map_fp32([](const Vec256<float>& x) { return x.erfinv(); });
+  }
+  Vec256<BFloat16> exp() const {
+    return map_fp32([](const Vec256<float>& x) { return x.exp(); });
+  }
+  Vec256<BFloat16> expm1() const {
+    return map_fp32([](const Vec256<float>& x) { return x.expm1(); });
+  }
+  Vec256<BFloat16> log() const {
+    return map_fp32([](const Vec256<float>& x) { return x.log(); });
+  }
+  Vec256<BFloat16> log2() const {
+    return map_fp32([](const Vec256<float>& x) { return x.log2(); });
+  }
+  Vec256<BFloat16> log10() const {
+    return map_fp32([](const Vec256<float>& x) { return x.log10(); });
+  }
+  Vec256<BFloat16> log1p() const {
+    return map_fp32([](const Vec256<float>& x) { return x.log1p(); });
+  }
+  Vec256<BFloat16> frac() const;
+  Vec256<BFloat16> sin() const {
+    return map_fp32([](const Vec256<float>& x) { return x.sin(); });
+  }
+  Vec256<BFloat16> sinh() const {
+    return map_fp32([](const Vec256<float>& x) { return x.sinh(); });
+  }
+  Vec256<BFloat16> cos() const {
+    return map_fp32([](const Vec256<float>& x) { return x.cos(); });
+  }
+  Vec256<BFloat16> cosh() const {
+    return map_fp32([](const Vec256<float>& x) { return x.cosh(); });
+  }
+  Vec256<BFloat16> ceil() const {
+    return map_fp32([](const Vec256<float>& x) { return x.ceil(); });
+  }
+  Vec256<BFloat16> floor() const {
+    return map_fp32([](const Vec256<float>& x) { return x.floor(); });
+  }
+  Vec256<BFloat16> neg() const {
+    // Flip the sign bit directly on the 16-bit lanes.
+    return _mm256_xor_si256(_mm256_set1_epi16((short)0x8000), values);
+  }
+  Vec256<BFloat16> round() const {
+    return map_fp32([](const Vec256<float>& x) { return x.round(); });
+  }
+  Vec256<BFloat16> tan() const {
+    return map_fp32([](const Vec256<float>& x) { return x.tan(); });
+  }
+  Vec256<BFloat16> tanh() const {
+    return map_fp32([](const Vec256<float>& x) { return x.tanh(); });
+  }
+  Vec256<BFloat16> trunc() const {
+    return map_fp32([](const Vec256<float>& x) { return x.trunc(); });
+  }
+  Vec256<BFloat16> lgamma() const {
+    return map_fp32([](const Vec256<float>& x) { return x.lgamma(); });
+  }
+  Vec256<BFloat16> sqrt() const {
+    return map_fp32([](const Vec256<float>& x) { return x.sqrt(); });
+  }
+  Vec256<BFloat16> reciprocal() const {
+    return map_fp32([](const Vec256<float>& x) { return x.reciprocal(); });
+  }
+  Vec256<BFloat16> rsqrt() const {
+    return map_fp32([](const Vec256<float>& x) { return x.rsqrt(); });
+  }
+  Vec256<BFloat16> pow(const Vec256<BFloat16>& b) const {
+    return map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+      return x.pow(y);
+    });
+  }
+
+  Vec256<BFloat16> operator==(const Vec256<BFloat16>& other) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(other.values, b_lo, b_hi);
+    return merge_compare_result(
+        _mm256_cmp_ps(a_lo, b_lo, _CMP_EQ_OQ), _mm256_cmp_ps(a_hi, b_hi, _CMP_EQ_OQ));
+  }
+  Vec256<BFloat16> operator!=(const Vec256<BFloat16>& other) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(other.values, b_lo, b_hi);
+    return merge_compare_result(
+        _mm256_cmp_ps(a_lo, b_lo, _CMP_NEQ_OQ), _mm256_cmp_ps(a_hi, b_hi, _CMP_NEQ_OQ));
+  }
+  Vec256<BFloat16> operator<(const Vec256<BFloat16>& other) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(other.values, b_lo, b_hi);
+    return merge_compare_result(
+        _mm256_cmp_ps(a_lo, b_lo, _CMP_LT_OQ), _mm256_cmp_ps(a_hi, b_hi, _CMP_LT_OQ));
+  }
+  Vec256<BFloat16> operator<=(const Vec256<BFloat16>& other) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(other.values, b_lo, b_hi);
+    return merge_compare_result(
+        _mm256_cmp_ps(a_lo, b_lo, _CMP_LE_OQ), _mm256_cmp_ps(a_hi, b_hi, _CMP_LE_OQ));
+  }
+  Vec256<BFloat16> operator>(const Vec256<BFloat16>& other) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(other.values, b_lo, b_hi);
+    return merge_compare_result(
+        _mm256_cmp_ps(a_lo, b_lo, _CMP_GT_OQ), _mm256_cmp_ps(a_hi, b_hi, _CMP_GT_OQ));
+  }
+  Vec256<BFloat16> operator>=(const Vec256<BFloat16>& other) const {
+    __m256 a_lo, a_hi, b_lo, b_hi;
+    cvtbf16_fp32(values, a_lo, a_hi);
+    cvtbf16_fp32(other.values, b_lo, b_hi);
+    return merge_compare_result(
+        _mm256_cmp_ps(a_lo, b_lo, _CMP_GE_OQ), _mm256_cmp_ps(a_hi, b_hi, _CMP_GE_OQ));
+  }
+};
+
+template <>
+Vec256<BFloat16> inline operator+(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return a.map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+    return x + y;
+  });
+}
+
+template <>
+Vec256<BFloat16> inline operator-(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return a.map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+    return x - y;
+  });
+}
+
+template <>
+Vec256<BFloat16> inline operator*(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return a.map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+    return x * y;
+  });
+}
+
+template <>
+Vec256<BFloat16> inline operator/(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return a.map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+    return x / y;
+  });
+}
+
+// frac. Implement this here so we can use subtraction
+Vec256<BFloat16> Vec256<BFloat16>::frac() const {
+  return *this - this->trunc();
+}
+
+template <>
+Vec256<BFloat16> inline maximum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return a.map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+    return maximum(x, y);
+  });
+}
+
+template <>
+Vec256<BFloat16> inline minimum(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return a.map2_fp32(b, [](const Vec256<float>& x, const Vec256<float>& y) {
+    return minimum(x, y);
+  });
+}
+
+template <>
+Vec256<BFloat16> inline clamp(const Vec256<BFloat16>& a, const Vec256<BFloat16>& min,
+                              const Vec256<BFloat16>& max) {
+  return minimum(max, maximum(min, a));
+}
+
+template <>
+Vec256<BFloat16> inline clamp_max(const Vec256<BFloat16>& a, const Vec256<BFloat16>& max) {
+  return minimum(max, a);
+}
+
+template <>
+Vec256<BFloat16> inline clamp_min(const Vec256<BFloat16>& a, const Vec256<BFloat16>& min) {
+  return maximum(min, a);
+}
+
+template <>
+Vec256<BFloat16> inline operator&(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm256_and_si256(a, b);
+}
+
+template <>
+Vec256<BFloat16> inline operator|(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm256_or_si256(a, b);
+}
+
+template <>
+Vec256<BFloat16> inline operator^(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b) {
+  return _mm256_xor_si256(a, b);
+}
+
+template <>
+Vec256<BFloat16> inline fmadd(const Vec256<BFloat16>& a, const Vec256<BFloat16>& b,
+                              const Vec256<BFloat16>& c) {
+  __m256 a_lo, a_hi, b_lo, b_hi, c_lo, c_hi;
+  cvtbf16_fp32(__m256i(a), a_lo, a_hi);
+  cvtbf16_fp32(__m256i(b), b_lo, b_hi);
+  cvtbf16_fp32(__m256i(c), c_lo, c_hi);
+  auto o1 = fmadd(Vec256<float>(a_lo), Vec256<float>(b_lo), Vec256<float>(c_lo));
+  auto o2 = fmadd(Vec256<float>(a_hi), Vec256<float>(b_hi), Vec256<float>(c_hi));
+  return cvtfp32_bf16(o1, o2);
+}
+
+#endif // defined(__AVX2__) && !defined(_MSC_VER)
+
+}}}
@@ -0,0 +1,408 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+// NEON registers are 128 bits wide, so the 256-bit Vec256 interface is
+// presented as a pair of quadword registers. Only AArch64 is covered:
+// ARMv7 NEON lacks the division and directed-rounding instructions this
+// file relies on, and those targets keep the scalar vec256_base path.
+//
+// There is no Sleef build for this target in-tree, so the transcendental
+// hooks go through map() -- one scalar libm call per lane -- while all
+// arithmetic, comparisons, min/max and rounding use NEON directly.
+#if defined(__aarch64__) && !defined(_MSC_VER)
+
+template <> class Vec256<float> {
+private:
+  float32x4x2_t values;
+public:
+  using value_type = float;
+  static constexpr int size() {
+    return 8;
+  }
+  Vec256() {}
+  Vec256(float32x4x2_t v) : values(v) {}
+  Vec256(float val) {
+    values.val[0] = vdupq_n_f32(val);
+    values.val[1] = vdupq_n_f32(val);
+  }
+  Vec256(float val1, float val2, float val3, float val4,
+         float val5, float val6, float val7, float val8) {
+    __at_align32__ float tmp_values[size()] = {
+        val1, val2, val3, val4, val5, val6, val7, val8};
+    values.val[0] = vld1q_f32(tmp_values);
+    values.val[1] = vld1q_f32(tmp_values + 4);
+  }
+  Vec256(float32x4_t low, float32x4_t high) {
+    values.val[0] = low;
+    values.val[1] = high;
+  }
+  operator float32x4x2_t() const {
+    return values;
+  }
+  float32x4_t low() const {
+    return values.val[0];
+  }
+  float32x4_t high() const {
+    return values.val[1];
+  }
+  template <int64_t mask>
+  static Vec256<float> blend(const Vec256<float>& a, const Vec256<float>& b) {
+    // Lane i takes b when bit i of the immediate is set, mirroring
+    // _mm256_blend_ps. The mask array folds to constants.
+    __at_align32__ uint32_t mask_values[size()];
+    for (int i = 0; i < size(); i++) {
+      mask_values[i] = (mask & (int64_t(1) << i)) ? 0xFFFFFFFF : 0;
+    }
+    return Vec256<float>(
+        vbslq_f32(vld1q_u32(mask_values), b.low(), a.low()),
+        vbslq_f32(vld1q_u32(mask_values + 4), b.high(), a.high()));
+  }
+  static Vec256<float> blendv(const Vec256<float>& a, const Vec256<float>& b,
+                              const Vec256<float>& mask) {
+    return Vec256<float>(
+        vbslq_f32(vreinterpretq_u32_f32(mask.low()), b.low(), a.low()),
+        vbslq_f32(vreinterpretq_u32_f32(mask.high()), b.high(), a.high()));
+  }
+  static Vec256<float> arange(float base = 0.f, float step = 1.f) {
+    return Vec256<float>(
+      base,            base +     step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step);
+  }
+  static Vec256<float> set(const Vec256<float>& a, const Vec256<float>& b,
+                           int64_t count = size()) {
+    switch (count) {
+      case 0:
+        return a;
+      case 1:
+        return blend<1>(a, b);
+      case 2:
+        return blend<3>(a, b);
+      case 3:
+        return blend<7>(a, b);
+      case 4:
+        return blend<15>(a, b);
+      case 5:
+        return blend<31>(a, b);
+      case 6:
+        return blend<63>(a, b);
+      case 7:
+        return blend<127>(a, b);
+    }
+    return b;
+  }
+  static Vec256<float> loadu(const void* ptr, int64_t count = size()) {
+    if (count == size()) {
+      const float* data = reinterpret_cast<const float*>(ptr);
+      return Vec256<float>(vld1q_f32(data), vld1q_f32(data + 4));
+    }
+    __at_align32__ float tmp_values[size()];
+    std::memcpy(
+        tmp_values, reinterpret_cast<const float*>(ptr), count * sizeof(float));
+    return Vec256<float>(vld1q_f32(tmp_values), vld1q_f32(tmp_values + 4));
+  }
+  void store(void* ptr, int64_t count = size()) const {
+    if (count == size()) {
+      float* data = reinterpret_cast<float*>(ptr);
+      vst1q_f32(data, values.val[0]);
+      vst1q_f32(data + 4, values.val[1]);
+    } else if (count > 0) {
+      float tmp_values[size()];
+      vst1q_f32(tmp_values, values.val[0]);
+      vst1q_f32(tmp_values + 4, values.val[1]);
+      std::memcpy(ptr, tmp_values, count * sizeof(float));
+    }
+  }
+  const float& operator[](int idx) const  = delete;
+  float& operator[](int idx) = delete;
+  Vec256<float> map(float (*f)(float)) const {
+    __at_align32__ float tmp[size()];
+    store(tmp);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = f(tmp[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec256<float> abs() const {
+    return Vec256<float>(vabsq_f32(low()), vabsq_f32(high()));
+  }
+  Vec256<float> angle() const {
+    return Vec256<float>(0.f);
+  }
+  Vec256<float> real() const {
+    return *this;
+  }
+  Vec256<float> imag() const {
+    return Vec256<float>(0.f);
+  }
+  Vec256<float> conj() const {
+    return *this;
+  }
+  Vec256<float> acos() const {
+    return map(std::acos);
+  }
+  Vec256<float> asin() const {
+    return map(std::asin);
+  }
+  Vec256<float> atan() const {
+    return map(std::atan);
+  }
+  Vec256<float> atan2(const Vec256<float> &b) const {
+    __at_align32__ float tmp[size()];
+    __at_align32__ float tmp_b[size()];
+    store(tmp);
+    b.store(tmp_b);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = std::atan2(tmp[i], tmp_b[i]);
+    }
+    return loadu(tmp);
+  }
+  Vec256<float> erf() const {
+    return map(std::erf);
+  }
+  Vec256<float> erfc() const {
+    return map(std::erfc);
+  }
+  Vec256<float> erfinv() const {
+    return map(calc_erfinv);
+  }
+  Vec256<float> exp() const {
+    return map(std::exp);
+  }
+  Vec256<float> expm1() const {
+    return map(std::expm1);
+  }
+  Vec256<float> log() const {
+    return map(std::log);
+  }
+  Vec256<float> log2() const {
+    return map(std::log2);
+  }
+  Vec256<float> log10() const {
+    return map(std::log10);
+  }
+  Vec256<float> log1p() const {
+    return map(std::log1p);
+  }
+  Vec256<float> frac() const;
+  Vec256<float> sin() const {
+    return map(std::sin);
+  }
+  Vec256<float> sinh() const {
+    return map(std::sinh);
+  }
+  Vec256<float> cos() const {
+    return map(std::cos);
+  }
+  Vec256<float> cosh() const {
+    return map(std::cosh);
+  }
+  Vec256<float> ceil() const {
+    return Vec256<float>(vrndpq_f32(low()), vrndpq_f32(high()));
+  }
+  Vec256<float> floor() const {
+    return Vec256<float>(vrndmq_f32(low()), vrndmq_f32(high()));
+  }
+  Vec256<float> neg() const {
+    return Vec256<float>(vnegq_f32(low()), vnegq_f32(high()));
+  }
+  Vec256<float> round() const {
+    // vrndnq rounds to nearest with ties to even, like
+    // _mm256_round_ps(..., _MM_FROUND_TO_NEAREST_INT).
+    return Vec256<float>(vrndnq_f32(low()), vrndnq_f32(high()));
+  }
+  Vec256<float> tan() const {
+    return map(std::tan);
+  }
+  Vec256<float> tanh() const {
+    return map(std::tanh);
+  }
+  Vec256<float> trunc() const {
+    return Vec256<float>(vrndq_f32(low()), vrndq_f32(high()));
+  }
+  Vec256<float> lgamma() const {
+    return map(std::lgamma);
+  }
+  Vec256<float> sqrt() const {
+    return Vec256<float>(vsqrtq_f32(low()), vsqrtq_f32(high()));
+  }
+  Vec256<float> reciprocal() const {
+    const float32x4_t one = vdupq_n_f32(1.f);
+    return Vec256<float>(vdivq_f32(one, low()), vdivq_f32(one, high()));
+  }
+  Vec256<float> rsqrt() const {
+    const float32x4_t one = vdupq_n_f32(1.f);
+    return Vec256<float>(
+        vdivq_f32(one, vsqrtq_f32(low())),
+        vdivq_f32(one, vsqrtq_f32(high())));
+  }
+  Vec256<float> pow(const Vec256<float> &b) const {
+    __at_align32__ float tmp[size()];
+    __at_align32__ float tmp_b[size()];
+    store(tmp);
+    b.store(tmp_b);
+    for (int64_t i = 0; i < size(); i++) {
+      tmp[i] = std::pow(tmp[i], tmp_b[i]);
+    }
+    return loadu(tmp);
+  }
+  // Like the x86 _CMP_**_OQ predicates, comparisons involving NaN yield
+  // all-zero lanes and do not raise.
+  Vec256<float> operator==(const Vec256<float>& other) const {
+    return Vec256<float>(
+        vreinterpretq_f32_u32(vceqq_f32(low(), other.low())),
+        vreinterpretq_f32_u32(vceqq_f32(high(), other.high())));
+  }
+
+  Vec256<float> operator!=(const Vec256<float>& other) const {
+    return Vec256<float>(
+        vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(low(), other.low()))),
+        vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(high(), other.high()))));
+  }
+
+  Vec256<float> operator<(const Vec256<float>& other) const {
+    return Vec256<float>(
+        vreinterpretq_f32_u32(vcltq_f32(low(), other.low())),
+        vreinterpretq_f32_u32(vcltq_f32(high(), other.high())));
+  }
+
+  Vec256<float> operator<=(const Vec256<float>& other) const {
+    return Vec256<float>(
+        vreinterpretq_f32_u32(vcleq_f32(low(), other.low())),
+        vreinterpretq_f32_u32(vcleq_f32(high(), other.high())));
+  }
+
+  Vec256<float> operator>(const Vec256<float>& other) const {
+    return Vec256<float>(
+        vreinterpretq_f32_u32(vcgtq_f32(low(), other.low())),
+        vreinterpretq_f32_u32(vcgtq_f32(high(), other.high())));
+  }
+
+  Vec256<float> operator>=(const Vec256<float>& other) const {
+    return Vec256<float>(
+        vreinterpretq_f32_u32(vcgeq_f32(low(), other.low())),
+        vreinterpretq_f32_u32(vcgeq_f32(high(), other.high())));
+  }
+};
+
+template <>
+Vec256<float> inline operator+(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vaddq_f32(a.low(), b.low()), vaddq_f32(a.high(), b.high()));
+}
+
+template <>
+Vec256<float> inline operator-(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vsubq_f32(a.low(), b.low()), vsubq_f32(a.high(), b.high()));
+}
+
+template <>
+Vec256<float> inline operator*(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vmulq_f32(a.low(), b.low()), vmulq_f32(a.high(), b.high()));
+}
+
+template <>
+Vec256<float> inline operator/(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vdivq_f32(a.low(), b.low()), vdivq_f32(a.high(), b.high()));
+}
+
+// frac. Implement this here so we can use subtraction
+Vec256<float> Vec256<float>::frac() const {
+  return *this - this->trunc();
+}
+
+// Implements the IEEE 754 201X `maximum` operation, which propagates NaN if
+// either input is a NaN. NEON FMAX already has this behavior.
+template <>
+Vec256<float> inline maximum(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vmaxq_f32(a.low(), b.low()), vmaxq_f32(a.high(), b.high()));
+}
+
+// Implements the IEEE 754 201X `minimum` operation, which propagates NaN if
+// either input is a NaN. NEON FMIN already has this behavior.
+template <>
+Vec256<float> inline minimum(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vminq_f32(a.low(), b.low()), vminq_f32(a.high(), b.high()));
+}
+
+template <>
+Vec256<float> inline clamp(const Vec256<float>& a, const Vec256<float>& min, const Vec256<float>& max) {
+  return Vec256<float>(
+      vminq_f32(max.low(), vmaxq_f32(min.low(), a.low())),
+      vminq_f32(max.high(), vmaxq_f32(min.high(), a.high())));
+}
+
+template <>
+Vec256<float> inline clamp_max(const Vec256<float>& a, const Vec256<float>& max) {
+  return Vec256<float>(
+      vminq_f32(max.low(), a.low()), vminq_f32(max.high(), a.high()));
+}
+
+template <>
+Vec256<float> inline clamp_min(const Vec256<float>& a, const Vec256<float>& min) {
+  return Vec256<float>(
+      vmaxq_f32(min.low(), a.low()), vmaxq_f32(min.high(), a.high()));
+}
+
+template <>
+Vec256<float> inline operator&(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vreinterpretq_f32_u32(vandq_u32(
+          vreinterpretq_u32_f32(a.low()), vreinterpretq_u32_f32(b.low()))),
+      vreinterpretq_f32_u32(vandq_u32(
+          vreinterpretq_u32_f32(a.high()), vreinterpretq_u32_f32(b.high()))));
+}
+
+template <>
+Vec256<float> inline operator|(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vreinterpretq_f32_u32(vorrq_u32(
+          vreinterpretq_u32_f32(a.low()), vreinterpretq_u32_f32(b.low()))),
+      vreinterpretq_f32_u32(vorrq_u32(
+          vreinterpretq_u32_f32(a.high()), vreinterpretq_u32_f32(b.high()))));
+}
+
+template <>
+Vec256<float> inline operator^(const Vec256<float>& a, const Vec256<float>& b) {
+  return Vec256<float>(
+      vreinterpretq_f32_u32(veorq_u32(
+          vreinterpretq_u32_f32(a.low()), vreinterpretq_u32_f32(b.low()))),
+      vreinterpretq_f32_u32(veorq_u32(
+          vreinterpretq_u32_f32(a.high()), vreinterpretq_u32_f32(b.high()))));
+}
+
+template <>
+inline void convert(const float* src, float* dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<float>::size()); i += Vec256<float>::size()) {
+    vst1q_f32(dst + i, vld1q_f32(src + i));
+    vst1q_f32(dst + i + 4, vld1q_f32(src + i + 4));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = src[i];
+  }
+}
+
+template <>
+Vec256<float> inline fmadd(const Vec256<float>& a, const Vec256<float>& b, const Vec256<float>& c) {
+  return Vec256<float>(
+      vfmaq_f32(c.low(), a.low(), b.low()),
+      vfmaq_f32(c.high(), a.high(), b.high()));
+}
+
+#endif
+
+}}}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+#include <c10/util/Half.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+#if defined(__AVX2__) && defined(__F16C__) && !defined(_MSC_VER)
+
+// F16C-accelerated fp16<->fp32 conversions. Unlike bfloat16 there is
+// dedicated hardware for this, so bulk conversions (to(kHalf)/to(kFloat)
+// around mixed-precision stages) should not go through the scalar
+// bit-twiddling in c10/util/Half-inl.h. Hardware rounding matches the
+// scalar path: round-to-nearest-even, NaN payloads preserved.
+
+template <>
+inline void convert(const Half* src, float* dst, int64_t n) {
+  int64_t i;
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (i = 0; i <= (n - Vec256<float>::size()); i += Vec256<float>::size()) {
+    auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(a));
+  }
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+inline void convert(const float* src, Half* dst, int64_t n) {
+  int64_t i;
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (i = 0; i <= (n - Vec256<float>::size()); i += Vec256<float>::size()) {
+    auto a = _mm256_loadu_ps(src + i);
+    auto b = _mm256_cvtps_ph(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), b);
+  }
+#ifndef _MSC_VER
+# pragma unroll
+#endif
+  for (; i < n; i++) {
+    dst[i] = static_cast<Half>(src[i]);
+  }
+}
+
+#endif // defined(__AVX2__) && defined(__F16C__) && !defined(_MSC_VER)
+
+}}}
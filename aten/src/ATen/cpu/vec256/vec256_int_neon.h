@@ -0,0 +1,462 @@
+#pragma once
+
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256_base.h>
+
+namespace at {
+namespace vec256 {
+// See Note [Acceptable use of anonymous namespace in header]
+namespace {
+
+// Integer counterparts of vec256_float_neon.h: a 256-bit Vec256 presented
+// as a pair of NEON quadword registers. AArch64 only, like the float
+// specialization; int64_t has no NEON arithmetic worth wrapping and stays
+// on the scalar vec256_base path.
+#if defined(__aarch64__) && !defined(_MSC_VER)
+
+template <>
+struct Vec256<int32_t> {
+private:
+  int32x4x2_t values;
+public:
+  using value_type = int32_t;
+  static constexpr int size() {
+    return 8;
+  }
+  Vec256() {}
+  Vec256(int32x4x2_t v) : values(v) {}
+  Vec256(int32_t v) {
+    values.val[0] = vdupq_n_s32(v);
+    values.val[1] = vdupq_n_s32(v);
+  }
+  Vec256(int32_t val1, int32_t val2, int32_t val3, int32_t val4,
+         int32_t val5, int32_t val6, int32_t val7, int32_t val8) {
+    __at_align32__ int32_t tmp_values[size()] = {
+        val1, val2, val3, val4, val5, val6, val7, val8};
+    values.val[0] = vld1q_s32(tmp_values);
+    values.val[1] = vld1q_s32(tmp_values + 4);
+  }
+  Vec256(int32x4_t low, int32x4_t high) {
+    values.val[0] = low;
+    values.val[1] = high;
+  }
+  operator int32x4x2_t() const {
+    return values;
+  }
+  int32x4_t low() const {
+    return values.val[0];
+  }
+  int32x4_t high() const {
+    return values.val[1];
+  }
+  template <int64_t mask>
+  static Vec256<int32_t> blend(Vec256<int32_t> a, Vec256<int32_t> b) {
+    __at_align32__ uint32_t mask_values[size()];
+    for (int i = 0; i < size(); i++) {
+      mask_values[i] = (mask & (int64_t(1) << i)) ? 0xFFFFFFFF : 0;
+    }
+    return Vec256<int32_t>(
+        vbslq_s32(vld1q_u32(mask_values), b.low(), a.low()),
+        vbslq_s32(vld1q_u32(mask_values + 4), b.high(), a.high()));
+  }
+  static Vec256<int32_t> blendv(const Vec256<int32_t>& a, const Vec256<int32_t>& b,
+                                const Vec256<int32_t>& mask) {
+    return Vec256<int32_t>(
+        vbslq_s32(vreinterpretq_u32_s32(mask.low()), b.low(), a.low()),
+        vbslq_s32(vreinterpretq_u32_s32(mask.high()), b.high(), a.high()));
+  }
+  static Vec256<int32_t> arange(int32_t base = 0, int32_t step = 1) {
+    return Vec256<int32_t>(
+      base,            base +     step, base + 2 * step, base + 3 * step,
+      base + 4 * step, base + 5 * step, base + 6 * step, base + 7 * step);
+  }
+  static Vec256<int32_t>
+  set(Vec256<int32_t> a, Vec256<int32_t> b, int32_t count = size()) {
+    switch (count) {
+      case 0:
+        return a;
+      case 1:
+        return blend<1>(a, b);
+      case 2:
+        return blend<3>(a, b);
+      case 3:
+        return blend<7>(a, b);
+      case 4:
+        return blend<15>(a, b);
+      case 5:
+        return blend<31>(a, b);
+      case 6:
+        return blend<63>(a, b);
+      case 7:
+        return blend<127>(a, b);
+    }
+    return b;
+  }
+  static Vec256<int32_t> loadu(const void* ptr) {
+    const int32_t* data = reinterpret_cast<const int32_t*>(ptr);
+    return Vec256<int32_t>(vld1q_s32(data), vld1q_s32(data + 4));
+  }
+  static Vec256<int32_t> loadu(const void* ptr, int32_t count) {
+    __at_align32__ int32_t tmp_values[size()];
+    std::memcpy(tmp_values, ptr, count * sizeof(int32_t));
+    return loadu(tmp_values);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      int32_t* data = reinterpret_cast<int32_t*>(ptr);
+      vst1q_s32(data, values.val[0]);
+      vst1q_s32(data + 4, values.val[1]);
+    } else if (count > 0) {
+      __at_align32__ int32_t tmp_values[size()];
+      vst1q_s32(tmp_values, values.val[0]);
+      vst1q_s32(tmp_values + 4, values.val[1]);
+      std::memcpy(ptr, tmp_values, count * sizeof(int32_t));
+    }
+  }
+  const int32_t& operator[](int idx) const  = delete;
+  int32_t& operator[](int idx)  = delete;
+  Vec256<int32_t> abs() const {
+    return Vec256<int32_t>(vabsq_s32(low()), vabsq_s32(high()));
+  }
+  Vec256<int32_t> angle() const {
+    return Vec256<int32_t>(0);
+  }
+  Vec256<int32_t> real() const {
+    return *this;
+  }
+  Vec256<int32_t> imag() const {
+    return Vec256<int32_t>(0);
+  }
+  Vec256<int32_t> conj() const {
+    return *this;
+  }
+  Vec256<int32_t> frac() const;
+  Vec256<int32_t> neg() const {
+    return Vec256<int32_t>(vnegq_s32(low()), vnegq_s32(high()));
+  }
+  Vec256<int32_t> operator==(const Vec256<int32_t>& other) const {
+    return Vec256<int32_t>(
+        vreinterpretq_s32_u32(vceqq_s32(low(), other.low())),
+        vreinterpretq_s32_u32(vceqq_s32(high(), other.high())));
+  }
+  Vec256<int32_t> operator!=(const Vec256<int32_t>& other) const {
+    return Vec256<int32_t>(
+        vreinterpretq_s32_u32(vmvnq_u32(vceqq_s32(low(), other.low()))),
+        vreinterpretq_s32_u32(vmvnq_u32(vceqq_s32(high(), other.high()))));
+  }
+  Vec256<int32_t> operator<(const Vec256<int32_t>& other) const {
+    return Vec256<int32_t>(
+        vreinterpretq_s32_u32(vcltq_s32(low(), other.low())),
+        vreinterpretq_s32_u32(vcltq_s32(high(), other.high())));
+  }
+  Vec256<int32_t> operator<=(const Vec256<int32_t>& other) const {
+    return Vec256<int32_t>(
+        vreinterpretq_s32_u32(vcleq_s32(low(), other.low())),
+        vreinterpretq_s32_u32(vcleq_s32(high(), other.high())));
+  }
+  Vec256<int32_t> operator>(const Vec256<int32_t>& other) const {
+    return Vec256<int32_t>(
+        vreinterpretq_s32_u32(vcgtq_s32(low(), other.low())),
+        vreinterpretq_s32_u32(vcgtq_s32(high(), other.high())));
+  }
+  Vec256<int32_t> operator>=(const Vec256<int32_t>& other) const {
+    return Vec256<int32_t>(
+        vreinterpretq_s32_u32(vcgeq_s32(low(), other.low())),
+        vreinterpretq_s32_u32(vcgeq_s32(high(), other.high())));
+  }
+};
+
+template <>
+Vec256<int32_t> inline operator+(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vaddq_s32(a.low(), b.low()), vaddq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline operator-(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vsubq_s32(a.low(), b.low()), vsubq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline operator*(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vmulq_s32(a.low(), b.low()), vmulq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline minimum(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vminq_s32(a.low(), b.low()), vminq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline maximum(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vmaxq_s32(a.low(), b.low()), vmaxq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline clamp(const Vec256<int32_t>& a, const Vec256<int32_t>& min_val, const Vec256<int32_t>& max_val) {
+  return minimum(max_val, maximum(a, min_val));
+}
+
+template <>
+Vec256<int32_t> inline clamp_max(const Vec256<int32_t>& a, const Vec256<int32_t>& max_val) {
+  return minimum(max_val, a);
+}
+
+template <>
+Vec256<int32_t> inline clamp_min(const Vec256<int32_t>& a, const Vec256<int32_t>& min_val) {
+  return maximum(min_val, a);
+}
+
+template <>
+Vec256<int32_t> inline operator&(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vandq_s32(a.low(), b.low()), vandq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline operator|(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      vorrq_s32(a.low(), b.low()), vorrq_s32(a.high(), b.high()));
+}
+
+template <>
+Vec256<int32_t> inline operator^(const Vec256<int32_t>& a, const Vec256<int32_t>& b) {
+  return Vec256<int32_t>(
+      veorq_s32(a.low(), b.low()), veorq_s32(a.high(), b.high()));
+}
+
+template <>
+inline void convert(const int32_t *src, float *dst, int64_t n) {
+  int64_t i;
+#pragma unroll
+  for (i = 0; i <= (n - Vec256<int32_t>::size()); i += Vec256<int32_t>::size()) {
+    vst1q_f32(dst + i, vcvtq_f32_s32(vld1q_s32(src + i)));
+    vst1q_f32(dst + i + 4, vcvtq_f32_s32(vld1q_s32(src + i + 4)));
+  }
+#pragma unroll
+  for (; i < n; i++) {
+    dst[i] = static_cast<float>(src[i]);
+  }
+}
+
+template <>
+struct Vec256<int16_t> {
+private:
+  int16x8x2_t values;
+public:
+  using value_type = int16_t;
+  static constexpr int size() {
+    return 16;
+  }
+  Vec256() {}
+  Vec256(int16x8x2_t v) : values(v) {}
+  Vec256(int16_t v) {
+    values.val[0] = vdupq_n_s16(v);
+    values.val[1] = vdupq_n_s16(v);
+  }
+  Vec256(int16_t val1, int16_t val2, int16_t val3, int16_t val4,
+         int16_t val5, int16_t val6, int16_t val7, int16_t val8,
+         int16_t val9, int16_t val10, int16_t val11, int16_t val12,
+         int16_t val13, int16_t val14, int16_t val15, int16_t val16) {
+    __at_align32__ int16_t tmp_values[size()] = {
+        val1, val2, val3, val4, val5, val6, val7, val8,
+        val9, val10, val11, val12, val13, val14, val15, val16};
+    values.val[0] = vld1q_s16(tmp_values);
+    values.val[1] = vld1q_s16(tmp_values + 8);
+  }
+  Vec256(int16x8_t low, int16x8_t high) {
+    values.val[0] = low;
+    values.val[1] = high;
+  }
+  operator int16x8x2_t() const {
+    return values;
+  }
+  int16x8_t low() const {
+    return values.val[0];
+  }
+  int16x8_t high() const {
+    return values.val[1];
+  }
+  template <int64_t mask>
+  static Vec256<int16_t> blend(Vec256<int16_t> a, Vec256<int16_t> b) {
+    __at_align32__ uint16_t mask_values[size()];
+    for (int i = 0; i < size(); i++) {
+      mask_values[i] = (mask & (int64_t(1) << i)) ? 0xFFFF : 0;
+    }
+    return Vec256<int16_t>(
+        vbslq_s16(vld1q_u16(mask_values), b.low(), a.low()),
+        vbslq_s16(vld1q_u16(mask_values + 8), b.high(), a.high()));
+  }
+  static Vec256<int16_t> blendv(const Vec256<int16_t>& a, const Vec256<int16_t>& b,
+                                const Vec256<int16_t>& mask) {
+    return Vec256<int16_t>(
+        vbslq_s16(vreinterpretq_u16_s16(mask.low()), b.low(), a.low()),
+        vbslq_s16(vreinterpretq_u16_s16(mask.high()), b.high(), a.high()));
+  }
+  static Vec256<int16_t> arange(int16_t base = 0, int16_t step = 1) {
+    __at_align32__ int16_t tmp_values[size()];
+    for (int i = 0; i < size(); i++) {
+      tmp_values[i] = base + i * step;
+    }
+    return loadu(tmp_values);
+  }
+  static Vec256<int16_t>
+  set(Vec256<int16_t> a, Vec256<int16_t> b, int16_t count = size()) {
+    if (count <= 0) {
+      return a;
+    }
+    if (count >= size()) {
+      return b;
+    }
+    __at_align32__ uint16_t mask_values[size()];
+    for (int i = 0; i < size(); i++) {
+      mask_values[i] = i < count ? 0xFFFF : 0;
+    }
+    return Vec256<int16_t>(
+        vbslq_s16(vld1q_u16(mask_values), b.low(), a.low()),
+        vbslq_s16(vld1q_u16(mask_values + 8), b.high(), a.high()));
+  }
+  static Vec256<int16_t> loadu(const void* ptr) {
+    const int16_t* data = reinterpret_cast<const int16_t*>(ptr);
+    return Vec256<int16_t>(vld1q_s16(data), vld1q_s16(data + 8));
+  }
+  static Vec256<int16_t> loadu(const void* ptr, int16_t count) {
+    __at_align32__ int16_t tmp_values[size()];
+    std::memcpy(tmp_values, ptr, count * sizeof(int16_t));
+    return loadu(tmp_values);
+  }
+  void store(void* ptr, int count = size()) const {
+    if (count == size()) {
+      int16_t* data = reinterpret_cast<int16_t*>(ptr);
+      vst1q_s16(data, values.val[0]);
+      vst1q_s16(data + 8, values.val[1]);
+    } else if (count > 0) {
+      __at_align32__ int16_t tmp_values[size()];
+      vst1q_s16(tmp_values, values.val[0]);
+      vst1q_s16(tmp_values + 8, values.val[1]);
+      std::memcpy(ptr, tmp_values, count * sizeof(int16_t));
+    }
+  }
+  const int16_t& operator[](int idx) const  = delete;
+  int16_t& operator[](int idx)  = delete;
+  Vec256<int16_t> abs() const {
+    return Vec256<int16_t>(vabsq_s16(low()), vabsq_s16(high()));
+  }
+  Vec256<int16_t> angle() const {
+    return Vec256<int16_t>(static_cast<int16_t>(0));
+  }
+  Vec256<int16_t> real() const {
+    return *this;
+  }
+  Vec256<int16_t> imag() const {
+    return Vec256<int16_t>(static_cast<int16_t>(0));
+  }
+  Vec256<int16_t> conj() const {
+    return *this;
+  }
+  Vec256<int16_t> frac() const;
+  Vec256<int16_t> neg() const {
+    return Vec256<int16_t>(vnegq_s16(low()), vnegq_s16(high()));
+  }
+  Vec256<int16_t> operator==(const Vec256<int16_t>& other) const {
+    return Vec256<int16_t>(
+        vreinterpretq_s16_u16(vceqq_s16(low(), other.low())),
+        vreinterpretq_s16_u16(vceqq_s16(high(), other.high())));
+  }
+  Vec256<int16_t> operator!=(const Vec256<int16_t>& other) const {
+    return Vec256<int16_t>(
+        vreinterpretq_s16_u16(vmvnq_u16(vceqq_s16(low(), other.low()))),
+        vreinterpretq_s16_u16(vmvnq_u16(vceqq_s16(high(), other.high()))));
+  }
+  Vec256<int16_t> operator<(const Vec256<int16_t>& other) const {
+    return Vec256<int16_t>(
+        vreinterpretq_s16_u16(vcltq_s16(low(), other.low())),
+        vreinterpretq_s16_u16(vcltq_s16(high(), other.high())));
+  }
+  Vec256<int16_t> operator<=(const Vec256<int16_t>& other) const {
+    return Vec256<int16_t>(
+        vreinterpretq_s16_u16(vcleq_s16(low(), other.low())),
+        vreinterpretq_s16_u16(vcleq_s16(high(), other.high())));
+  }
+  Vec256<int16_t> operator>(const Vec256<int16_t>& other) const {
+    return Vec256<int16_t>(
+        vreinterpretq_s16_u16(vcgtq_s16(low(), other.low())),
+        vreinterpretq_s16_u16(vcgtq_s16(high(), other.high())));
+  }
+  Vec256<int16_t> operator>=(const Vec256<int16_t>& other) const {
+    return Vec256<int16_t>(
+        vreinterpretq_s16_u16(vcgeq_s16(low(), other.low())),
+        vreinterpretq_s16_u16(vcgeq_s16(high(), other.high())));
+  }
+};
+
+template <>
+Vec256<int16_t> inline operator+(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vaddq_s16(a.low(), b.low()), vaddq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline operator-(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vsubq_s16(a.low(), b.low()), vsubq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline operator*(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vmulq_s16(a.low(), b.low()), vmulq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline minimum(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vminq_s16(a.low(), b.low()), vminq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline maximum(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vmaxq_s16(a.low(), b.low()), vmaxq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline clamp(const Vec256<int16_t>& a, const Vec256<int16_t>& min_val, const Vec256<int16_t>& max_val) {
+  return minimum(max_val, maximum(a, min_val));
+}
+
+template <>
+Vec256<int16_t> inline clamp_max(const Vec256<int16_t>& a, const Vec256<int16_t>& max_val) {
+  return minimum(max_val, a);
+}
+
+template <>
+Vec256<int16_t> inline clamp_min(const Vec256<int16_t>& a, const Vec256<int16_t>& min_val) {
+  return maximum(min_val, a);
+}
+
+template <>
+Vec256<int16_t> inline operator&(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vandq_s16(a.low(), b.low()), vandq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline operator|(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      vorrq_s16(a.low(), b.low()), vorrq_s16(a.high(), b.high()));
+}
+
+template <>
+Vec256<int16_t> inline operator^(const Vec256<int16_t>& a, const Vec256<int16_t>& b) {
+  return Vec256<int16_t>(
+      veorq_s16(a.low(), b.low()), veorq_s16(a.high(), b.high()));
+}
+
+#endif
+
+}}}
@@ -1,5 +1,7 @@
 #include <ATen/CUDAGenerator.h>
+#include <c10/cuda/CUDACachingAllocator.h>
 #include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAGuard.h>
 
 namespace at {
 
@@ -83,7 +85,7 @@ CUDAGenerator::CUDAGenerator(DeviceIndex device_index)
  */
 void CUDAGenerator::set_current_seed(uint64_t seed) {
   seed_ = seed;
-  philox_offset_per_thread_ = 0;
+  this->set_philox_offset_per_thread(0);
 }
 
 /**
@@ -113,15 +115,109 @@ uint64_t CUDAGenerator::seed() {
  */
 void CUDAGenerator::set_philox_offset_per_thread(uint64_t offset) {
   philox_offset_per_thread_ = offset;
+  if (philox_offset_device_ptr_ != nullptr) {
+    c10::cuda::CUDAGuard guard(this->device().index());
+    unsigned long long value = offset;
+    C10_CUDA_CHECK(cudaMemcpy(
+        philox_offset_device_ptr_,
+        &value,
+        sizeof(value),
+        cudaMemcpyHostToDevice));
+  }
 }
 
 /**
  * Gets the current philox_offset_per_thread_ of CUDAGenerator.
+ * In device-resident mode this synchronously reads back the device counter.
  */
 uint64_t CUDAGenerator::philox_offset_per_thread() {
+  if (philox_offset_device_ptr_ != nullptr) {
+    c10::cuda::CUDAGuard guard(this->device().index());
+    unsigned long long value = 0;
+    C10_CUDA_CHECK(cudaMemcpy(
+        &value,
+        philox_offset_device_ptr_,
+        sizeof(value),
+        cudaMemcpyDeviceToHost));
+    philox_offset_per_thread_ = value;
+  }
   return philox_offset_per_thread_;
 }
 
+/**
+ * Moves the philox offset counter into (or back out of) device memory.
+ *
+ * In the default mode, every sampling kernel launch reserves its philox
+ * offset on the host while holding the generator mutex, which serializes
+ * concurrent streams that sample (e.g. dropout in multi-stream inference).
+ * With device-resident state the counter lives in device memory and each
+ * kernel reserves its counter range with a device-side atomicAdd when it
+ * executes (see at::cuda::philox::unpack), so launches need neither the
+ * mutex nor a host round-trip.
+ *
+ * While the mode is enabled, ops that still use philox_engine_inputs raise
+ * an error rather than silently reusing counters; convert them to
+ * philox_cuda_state before enabling. Disabling the mode synchronizes the
+ * device, copies the counter back to the host, and restores the default
+ * behavior.
+ */
+void CUDAGenerator::set_philox_state_on_device(bool enabled) {
+  if (enabled == (philox_offset_device_ptr_ != nullptr)) {
+    return;
+  }
+  c10::cuda::CUDAGuard guard(this->device().index());
+  if (enabled) {
+    auto* counter = static_cast<unsigned long long*>(
+        c10::cuda::CUDACachingAllocator::raw_alloc(sizeof(unsigned long long)));
+    unsigned long long value = philox_offset_per_thread_;
+    C10_CUDA_CHECK(cudaMemcpy(
+        counter, &value, sizeof(value), cudaMemcpyHostToDevice));
+    philox_offset_device_ptr_ = counter;
+  } else {
+    // Kernels on any stream may still be advancing the counter; make sure
+    // they have drained before the value is captured on the host.
+    C10_CUDA_CHECK(cudaDeviceSynchronize());
+    unsigned long long value = 0;
+    C10_CUDA_CHECK(cudaMemcpy(
+        &value,
+        philox_offset_device_ptr_,
+        sizeof(value),
+        cudaMemcpyDeviceToHost));
+    c10::cuda::CUDACachingAllocator::raw_delete(philox_offset_device_ptr_);
+    philox_offset_device_ptr_ = nullptr;
+    philox_offset_per_thread_ = value;
+  }
+}
+
+/**
+ * Returns true if the philox offset counter currently lives in device
+ * memory. When true, philox_cuda_state does not mutate host state and may
+ * be called without the generator mutex.
+ */
+bool CUDAGenerator::philox_state_on_device() const {
+  return philox_offset_device_ptr_ != nullptr;
+}
+
+/**
+ * Gets the philox arguments for a sampling kernel launch, as a
+ * PhiloxCudaState consumed by at::cuda::philox::unpack.
+ *
+ * In the default mode this reserves [offset, offset + increment) on the
+ * host exactly like philox_engine_inputs, and callers must hold the
+ * generator mutex (see Note [Acquire lock when using random generators]).
+ * In device-resident mode nothing on the host mutates: the returned state
+ * carries the device counter pointer and the increment, and each block of
+ * the launched kernel reserves its own disjoint counter range when it runs.
+ */
+PhiloxCudaState CUDAGenerator::philox_cuda_state(uint64_t increment) {
+  if (philox_offset_device_ptr_ != nullptr) {
+    return PhiloxCudaState(seed_, philox_offset_device_ptr_, increment);
+  }
+  uint64_t offset = philox_offset_per_thread_;
+  philox_offset_per_thread_ += increment;
+  return PhiloxCudaState(seed_, offset);
+}
+
 /**
  * Gets the seed and philox offset value to be used in
  * curandStatePhilox4_32_10
@@ -141,6 +237,11 @@ uint64_t CUDAGenerator::philox_offset_per_thread() {
  * See Note [Acquire lock when using random generators]
  */
 std::pair<uint64_t, uint64_t> CUDAGenerator::philox_engine_inputs(uint64_t increment) {
+  TORCH_CHECK(
+      philox_offset_device_ptr_ == nullptr,
+      "philox_engine_inputs() cannot be used while the philox state is "
+      "device-resident; this op must be converted to philox_cuda_state(), "
+      "or device-resident state must be disabled first.");
   uint64_t offset = this->philox_offset_per_thread_;
   this->philox_offset_per_thread_ += increment;
   return std::make_pair(this->seed_, offset);
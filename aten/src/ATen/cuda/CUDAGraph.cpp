@@ -0,0 +1,143 @@
+#include <ATen/cuda/CUDAGraph.h>
+
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+#include <c10/cuda/CUDACachingAllocator.h>
+#include <c10/cuda/CUDAFunctions.h>
+#include <c10/cuda/CUDAGuard.h>
+
+#include <atomic>
+
+namespace at { namespace cuda {
+
+// Graph capture is supported on CUDA 10.0+, and the stream-capture mode
+// argument only exists on 10.1+.
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000 && !defined(__HIP_PLATFORM_HCC__)
+#define AT_CUDA_GRAPHS_SUPPORTED 1
+#else
+#define AT_CUDA_GRAPHS_SUPPORTED 0
+#endif
+
+namespace {
+
+// Each graph gets a process-unique id so the caching allocator can park the
+// blocks freed during its capture until the graph is destroyed.
+std::atomic<uint64_t> graph_counter{1};
+
+} // namespace
+
+CUDAGraph::CUDAGraph()
+  // CUDAStream only has private constructors; hold the current stream until
+  // capture_begin() records the real capture stream.
+  : capture_stream_(c10::cuda::getCurrentCUDAStream()) {
+}
+
+CUDAGraph::~CUDAGraph() {
+  reset();
+}
+
+void CUDAGraph::capture_begin() {
+#if AT_CUDA_GRAPHS_SUPPORTED
+  TORCH_CHECK(!capture_underway_, "CUDA graph capture is already underway");
+  TORCH_CHECK(
+      !has_graph_exec_,
+      "This CUDAGraph instance already owns a captured graph. "
+      "To capture a new graph, create a new instance or call reset().");
+
+  auto stream = c10::cuda::getCurrentCUDAStream();
+  TORCH_CHECK(
+      stream != c10::cuda::getDefaultCUDAStream(),
+      "CUDA graphs must be captured on a non-default stream. "
+      "(However, after capture, it's ok to replay them on the default stream.)");
+
+  capture_stream_ = stream;
+  capture_dev_ = c10::cuda::current_device();
+  capture_id_ = graph_counter.fetch_add(1);
+
+  c10::cuda::CUDACachingAllocator::notifyCaptureBegin(capture_id_);
+
+#if CUDA_VERSION >= 10010
+  AT_CUDA_CHECK(cudaStreamBeginCapture(
+      capture_stream_, cudaStreamCaptureModeThreadLocal));
+#else
+  AT_CUDA_CHECK(cudaStreamBeginCapture(capture_stream_));
+#endif
+
+  capture_underway_ = true;
+#else
+  TORCH_CHECK(false, "CUDA graphs require CUDA >= 10.0 and are not supported on HIP");
+#endif
+}
+
+void CUDAGraph::capture_end() {
+#if AT_CUDA_GRAPHS_SUPPORTED
+  TORCH_CHECK(capture_underway_, "capture_end called without capture_begin");
+
+  auto stream = c10::cuda::getCurrentCUDAStream();
+  TORCH_CHECK(
+      stream == capture_stream_,
+      "Capture must end on the same stream it began on.");
+
+  AT_CUDA_CHECK(cudaStreamEndCapture(capture_stream_, &graph_));
+  TORCH_CHECK(graph_ != nullptr, "Invalid capture.");
+
+  capture_underway_ = false;
+  c10::cuda::CUDACachingAllocator::notifyCaptureEnd(capture_id_);
+
+  AT_CUDA_CHECK(cudaGraphInstantiate(&graph_exec_, graph_, nullptr, nullptr, 0));
+  has_graph_exec_ = true;
+
+  // The instantiated executable holds all the information needed for replay.
+  AT_CUDA_CHECK(cudaGraphDestroy(graph_));
+  graph_ = nullptr;
+#else
+  TORCH_CHECK(false, "CUDA graphs require CUDA >= 10.0 and are not supported on HIP");
+#endif
+}
+
+void CUDAGraph::replay() {
+#if AT_CUDA_GRAPHS_SUPPORTED
+  TORCH_CHECK(
+      has_graph_exec_,
+      "replay called on a CUDAGraph without a captured graph");
+  c10::cuda::CUDAGuard device_guard(capture_dev_);
+  AT_CUDA_CHECK(
+      cudaGraphLaunch(graph_exec_, c10::cuda::getCurrentCUDAStream()));
+#else
+  TORCH_CHECK(false, "CUDA graphs require CUDA >= 10.0 and are not supported on HIP");
+#endif
+}
+
+void CUDAGraph::reset() {
+#if AT_CUDA_GRAPHS_SUPPORTED
+  if (capture_underway_) {
+    // Abort the capture so the stream is usable again; the result is
+    // discarded. cudaStreamEndCapture returns an error for an invalidated
+    // capture, which we clear rather than throw from here (reset is called
+    // from the destructor).
+    cudaGraph_t graph = nullptr;
+    cudaStreamEndCapture(capture_stream_, &graph);
+    cudaGetLastError();
+    if (graph != nullptr) {
+      cudaGraphDestroy(graph);
+    }
+    capture_underway_ = false;
+    c10::cuda::CUDACachingAllocator::notifyCaptureEnd(capture_id_);
+  }
+  if (graph_ != nullptr) {
+    cudaGraphDestroy(graph_);
+    graph_ = nullptr;
+  }
+  if (has_graph_exec_) {
+    cudaGraphExecDestroy(graph_exec_);
+    graph_exec_ = nullptr;
+    has_graph_exec_ = false;
+  }
+  if (capture_id_ != 0) {
+    c10::cuda::CUDACachingAllocator::releaseCaptureReserves(capture_id_);
+    capture_id_ = 0;
+  }
+#endif
+}
+
+}} // namespace at::cuda
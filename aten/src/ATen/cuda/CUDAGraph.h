@@ -0,0 +1,69 @@
+#pragma once
+
+#include <ATen/cuda/ATenCUDAGeneral.h>
+#include <c10/cuda/CUDAStream.h>
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace at { namespace cuda {
+
+/*
+* CUDAGraph captures the kernel launches issued on the current stream between
+* capture_begin() and capture_end() into a CUDA graph, which replay() then
+* relaunches with a single cudaGraphLaunch. For launch-bound workloads (many
+* tiny kernels per step) this removes the per-kernel CPU launch overhead.
+*
+* The caching allocator parks every block freed during capture until the
+* graph is destroyed (see notifyCaptureBegin in CUDACachingAllocator.h), so
+* the device addresses baked into the captured kernels stay owned across
+* replays. The caller is responsible for keeping input/output tensors at
+* stable addresses: allocate them before capture, keep them alive for the
+* graph's lifetime, and refill the inputs before each replay.
+*
+* Capture must run on a non-default stream, and replay() must be ordered
+* after the capture and any refills of the input buffers (typically by
+* running on the same stream). Requires CUDA >= 10.0; capture_begin() throws
+* on older toolkits and on HIP.
+*/
+struct TORCH_CUDA_API CUDAGraph {
+  CUDAGraph();
+  ~CUDAGraph();
+
+  CUDAGraph(const CUDAGraph&) = delete;
+  CUDAGraph& operator=(const CUDAGraph&) = delete;
+
+  // Starts capturing work submitted to the current stream.
+  void capture_begin();
+
+  // Ends capture and instantiates the graph for replay.
+  void capture_end();
+
+  // Relaunches the captured work on the current stream.
+  void replay();
+
+  // Destroys the graph and returns the memory parked during capture to the
+  // caching allocator. Called automatically by the destructor.
+  void reset();
+
+ private:
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000 && !defined(__HIP_PLATFORM_HCC__)
+  cudaGraph_t graph_ = nullptr;
+  cudaGraphExec_t graph_exec_ = nullptr;
+#endif
+
+  bool capture_underway_ = false;
+  bool has_graph_exec_ = false;
+
+  // id used to tie the allocator's parked blocks to this graph
+  uint64_t capture_id_ = 0;
+
+  // stream on which capture was begun; capture_end must see the same stream
+  c10::cuda::CUDAStream capture_stream_;
+
+  // device of the capture stream
+  int capture_dev_ = -1;
+};
+
+}} // namespace at::cuda
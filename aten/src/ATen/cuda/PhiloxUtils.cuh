@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ATen/CUDAGenerator.h>
+
+#include <utility>
+
+namespace at {
+namespace cuda {
+namespace philox {
+
+// Returns the (seed, offset) pair a sampling kernel should feed to
+// curand_init.
+//
+// With host-reserved state this just unpacks the PhiloxCudaState. With
+// device-resident state (offset_ptr != nullptr) the first thread of each
+// block reserves the block's counter range by atomically advancing the
+// generator's device counter. Every reservation advances the counter past
+// its own range, so the ranges handed out are disjoint across blocks,
+// launches, and streams — uniqueness of the consumed philox counters does
+// not rely on the host serializing launches under the generator mutex.
+// A block consumes `increment` counters per thread, the same contract as
+// CUDAGenerator::philox_engine_inputs, but reserved per block rather than
+// per launch, so the random streams differ from host-reserved mode.
+__device__ __forceinline__ std::pair<uint64_t, uint64_t> unpack(
+    const PhiloxCudaState& args) {
+  if (args.offset_ptr == nullptr) {
+    return std::make_pair(args.seed, args.offset);
+  }
+  __shared__ unsigned long long reserved_offset;
+  if (threadIdx.x == 0 && threadIdx.y == 0 && threadIdx.z == 0) {
+    reserved_offset = atomicAdd(
+        args.offset_ptr, static_cast<unsigned long long>(args.increment));
+  }
+  __syncthreads();
+  return std::make_pair(args.seed, static_cast<uint64_t>(reserved_offset));
+}
+
+} // namespace philox
+} // namespace cuda
+} // namespace at
@@ -11,6 +11,7 @@
 #include <ATen/cuda/nvrtc_stub/ATenNVRTC.h>
 #include <ATen/detail/CUDAHooksInterface.h>
 #include <ATen/native/cuda/CuFFTPlanCache.h>
+#include <ATen/native/cudnn/ConvBenchmarkCache.h>
 #include <c10/util/Exception.h>
 
 #include <THC/THC.h>
@@ -181,6 +182,10 @@ Allocator* CUDAHooks::getPinnedMemoryAllocator() const {
   return at::cuda::getPinnedMemoryAllocator();
 }
 
+void CUDAHooks::reservePinnedMemory(size_t size, size_t count) const {
+  AT_CUDA_CHECK(THCCachingHostAllocator_reserve(size, count));
+}
+
 bool CUDAHooks::compiledWithCuDNN() const {
   return AT_CUDNN_ENABLED();
 }
@@ -222,6 +227,14 @@ long CUDAHooks::versionCuDNN() const {
 #endif
 }
 
+void CUDAHooks::cudnnConvBenchmarkCacheSave(const std::string& filename) const {
+  at::native::detail::cudnn_conv_benchmark_cache_save_impl(filename);
+}
+
+bool CUDAHooks::cudnnConvBenchmarkCacheLoad(const std::string& filename) const {
+  return at::native::detail::cudnn_conv_benchmark_cache_load_impl(filename);
+}
+
 std::string CUDAHooks::showConfig() const {
   std::ostringstream oss;
 
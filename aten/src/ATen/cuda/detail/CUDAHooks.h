@@ -23,11 +23,14 @@ struct CUDAHooks : public at::CUDAHooksInterface {
   bool hasPrimaryContext(int64_t device_index) const override;
   c10::optional<int64_t> getDevceIndexWithPrimaryContext() const override;
   Allocator* getPinnedMemoryAllocator() const override;
+  void reservePinnedMemory(size_t size, size_t count) const override;
   bool compiledWithCuDNN() const override;
   bool compiledWithMIOpen() const override;
   bool supportsDilatedConvolutionWithCuDNN() const override;
   bool supportsDepthwiseConvolutionWithCuDNN() const override;
   long versionCuDNN() const override;
+  void cudnnConvBenchmarkCacheSave(const std::string& filename) const override;
+  bool cudnnConvBenchmarkCacheLoad(const std::string& filename) const override;
   std::string showConfig() const override;
   double batchnormMinEpsilonCuDNN() const override;
   int64_t cuFFTGetPlanCacheMaxSize(int64_t device_index) const override;
@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <string>
 
 // Forward-declares THCState
 struct THCState;
@@ -107,6 +108,10 @@ struct CAFFE2_API CUDAHooksInterface {
     TORCH_CHECK(false, "Pinned memory requires CUDA. ", CUDA_HELP);
   }
 
+  virtual void reservePinnedMemory(size_t /*size*/, size_t /*count*/) const {
+    TORCH_CHECK(false, "Pinned memory requires CUDA. ", CUDA_HELP);
+  }
+
   virtual bool compiledWithCuDNN() const {
     return false;
   }
@@ -127,6 +132,14 @@ struct CAFFE2_API CUDAHooksInterface {
     TORCH_CHECK(false, "Cannot query cuDNN version without ATen_cuda library. ", CUDA_HELP);
   }
 
+  virtual void cudnnConvBenchmarkCacheSave(const std::string& /*filename*/) const {
+    TORCH_CHECK(false, "Cannot save the cuDNN benchmark cache without ATen_cuda library. ", CUDA_HELP);
+  }
+
+  virtual bool cudnnConvBenchmarkCacheLoad(const std::string& /*filename*/) const {
+    TORCH_CHECK(false, "Cannot load the cuDNN benchmark cache without ATen_cuda library. ", CUDA_HELP);
+  }
+
   virtual std::string showConfig() const {
     TORCH_CHECK(false, "Cannot query detailed CUDA version without ATen_cuda library. ", CUDA_HELP);
   }
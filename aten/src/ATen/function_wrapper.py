@@ -31,6 +31,23 @@ else:
 
 from env import BUILD_NAMEDTENSOR
 
+# Set by gen.py from --op_registration_whitelist. When not None, only the
+# listed operators (as `namespace::name`, no overload) get registration
+# code; everything else compiles but never registers, so a mobile build
+# linking against a model's op set drops the unused kernels and skips
+# their registrar constructors at load time.
+op_registration_whitelist = None  # type: Optional[Set[str]]
+
+
+def op_registration_whitelisted(option):
+    # type: (Any) -> bool
+    if op_registration_whitelist is None:
+        return True
+    # schema_string looks like "aten::add.Tensor(Tensor self, ...)";
+    # whitelist entries leave out the overload name.
+    name = option['schema_string'].split('(', 1)[0].split('.', 1)[0]
+    return name in op_registration_whitelist
+
 # ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 #
 # what has to be done to add a Operation ...
@@ -222,6 +239,13 @@ case Backend::${backend}:
     ${return_call} ${backend}Type::${api_name}(${native_arguments});
     break;
 """)
+# Used instead of the switch when codegen is pinned to a single backend
+# (see --static_dispatch_backend in gen.py): the backend test disappears
+# and every op call is a direct call into the backend's kernel wrapper.
+STATIC_DISPATCH_FUNCTION_SINGLE_BACKEND_BODY = CodeTemplate("""\
+at::AutoNonVariableTypeMode _var_guard(true);
+${return_call} ${backend}Type::${api_name}(${native_arguments});
+""")
 
 # add a native declaration for a native function
 NATIVE_DECLARATION = CodeTemplate("""\
@@ -298,6 +322,14 @@ scalar_types = [
 
 static_dispatch_backends = ['CPU', 'QuantizedCPU', 'SparseCPU']
 
+# Set by gen.py from --static_dispatch_backend. When not None, the
+# USE_STATIC_DISPATCH bodies call straight into this backend instead of
+# switching on the tensor's backend at every op call. Only sound for
+# builds where all tensors live on that one backend (e.g. a float-only
+# CPU mobile model); ops the backend does not implement keep the switch
+# so they still fail with the usual error.
+static_dispatch_backend = None  # type: Optional[str]
+
 
 class NYIError(Exception):
     """Indicates we don't support this declaration yet"""
@@ -1169,7 +1201,14 @@ def create_generic(top_env, declarations):
                 ', '.join(swizzle_self(t) for t in multidispatch_tensors)
             )
 
-            if isinstance(type_method_dispatch, dict):
+            if isinstance(type_method_dispatch, dict) and \
+                    static_dispatch_backend is not None and \
+                    static_dispatch_backend in type_method_dispatch:
+                static_dispatch_method_body = STATIC_DISPATCH_FUNCTION_SINGLE_BACKEND_BODY.substitute(
+                    option,
+                    backend=static_dispatch_backend,
+                    native_arguments=option['method_actuals'])
+            elif isinstance(type_method_dispatch, dict):
                 static_dispatch_function_switches = []
                 # NB: As this code is currently written, there will NEVER be
                 # a backend generated for variable dispatch.  There is nothing
@@ -1216,7 +1255,14 @@ def create_generic(top_env, declarations):
             declaration = DEPRECATED_FUNCTION_DECLARATION if option['deprecated'] else FUNCTION_DECLARATION
             fn_declaration = declaration.substitute(option)
 
-            if isinstance(type_method_dispatch, dict):
+            if isinstance(type_method_dispatch, dict) and \
+                    static_dispatch_backend is not None and \
+                    static_dispatch_backend in type_method_dispatch:
+                static_dispatch_function_body = STATIC_DISPATCH_FUNCTION_SINGLE_BACKEND_BODY.substitute(
+                    option,
+                    backend=static_dispatch_backend,
+                    native_arguments=option['native_actuals'])
+            elif isinstance(type_method_dispatch, dict):
                 static_dispatch_function_switches = []
                 for backend in static_dispatch_backends:
                     if backend in type_method_dispatch:
@@ -1331,13 +1377,14 @@ def create_generic(top_env, declarations):
                 check_namedtensor_enabled(NATIVE_DISPATCH_DECLARATION.substitute(option)))
             top_env['type_method_definitions'].append(
                 check_namedtensor_enabled(NATIVE_DISPATCH_DEFINITION_DEFAULT.substitute(option)))
-            if option['use_c10_dispatcher'] == 'full':
-                top_env['function_registrations'].append(
-                    check_namedtensor_enabled(DEFAULT_FUNCTION_REGISTRATION.substitute(option)))
-            else:
-                assert option['use_c10_dispatcher'] == 'unboxed_only'
-                top_env['function_registrations'].append(
-                    check_namedtensor_enabled(DEFAULT_UNBOXEDONLY_FUNCTION_REGISTRATION.substitute(option)))
+            if op_registration_whitelisted(option):
+                if option['use_c10_dispatcher'] == 'full':
+                    top_env['function_registrations'].append(
+                        check_namedtensor_enabled(DEFAULT_FUNCTION_REGISTRATION.substitute(option)))
+                else:
+                    assert option['use_c10_dispatcher'] == 'unboxed_only'
+                    top_env['function_registrations'].append(
+                        check_namedtensor_enabled(DEFAULT_UNBOXEDONLY_FUNCTION_REGISTRATION.substitute(option)))
 
         # generate the at::native function declarations (i.e. what the user will implement)
         if isinstance(type_method_dispatch, dict):
@@ -1785,13 +1832,14 @@ def create_derived(backend_type_env, declarations):
                     option['native_type_method_dispatch'] = native_dispatch
                     type_object_definitions.append(
                         NATIVE_DISPATCH_DEFINITION_BACKEND.substitute(env))
-                    if option['use_c10_dispatcher'] == 'full':
-                        function_registrations.append(
-                            BACKEND_FUNCTION_REGISTRATION.substitute(env))
-                    else:
-                        assert option['use_c10_dispatcher'] == 'unboxed_only'
-                        function_registrations.append(
-                            BACKEND_UNBOXEDONLY_FUNCTION_REGISTRATION.substitute(env))
+                    if op_registration_whitelisted(option):
+                        if option['use_c10_dispatcher'] == 'full':
+                            function_registrations.append(
+                                BACKEND_FUNCTION_REGISTRATION.substitute(env))
+                        else:
+                            assert option['use_c10_dispatcher'] == 'unboxed_only'
+                            function_registrations.append(
+                                BACKEND_UNBOXEDONLY_FUNCTION_REGISTRATION.substitute(env))
 
     for declaration in declarations:
         for option in declaration['options']:
@@ -44,7 +44,26 @@ parser.add_argument(
     '--rocm',
     action='store_true',
     help='reinterpret CUDA as ROCm/HIP and adjust filepaths accordingly')
+parser.add_argument(
+    '--op_registration_whitelist',
+    nargs='*',
+    help='filter op registrations by the whitelist (if set); '
+         'each item is `namespace`::`operator name` without overload name; '
+         'e.g.: aten::empty aten::conv2d. All operators still compile, but '
+         'only whitelisted ones register with the dispatcher, so the linker '
+         'can strip the rest and static init does less work at load time')
+parser.add_argument(
+    '--static_dispatch_backend',
+    choices=['CPU', 'QuantizedCPU', 'SparseCPU'],
+    help='with USE_STATIC_DISPATCH, pin op calls to this single backend '
+         'instead of switching on the tensor backend per call; only sound '
+         'when every tensor in the build lives on that backend')
 options = parser.parse_args()
+if options.op_registration_whitelist is not None:
+    function_wrapper.op_registration_whitelist = set(
+        options.op_registration_whitelist)
+if options.static_dispatch_backend is not None:
+    function_wrapper.static_dispatch_backend = options.static_dispatch_backend
 # NB: It is mandatory to NOT use os.path.join here, as the install directory
 # will eventually be ingested by cmake, which does not respect Windows style
 # path slashes.  If you switch this to use os.path.join, you'll get an error
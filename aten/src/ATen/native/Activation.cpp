@@ -352,17 +352,17 @@ Tensor hardshrink_backward_cpu(const Tensor & grad, const Tensor & self, Scalar
 }
 
 
-Tensor gelu_cpu(const Tensor& self) {
+Tensor gelu_cpu(const Tensor& self, bool approximate) {
   Tensor Y = at::native::empty_like(self, at::MemoryFormat::Contiguous);
   auto it = TensorIterator::unary_op(Y, self);
-  GeluKernel(kCPU, it);
+  GeluKernel(kCPU, it, approximate);
   return Y;
 }
 
-Tensor gelu_backward_cpu(const Tensor& grad, const Tensor& self) {
+Tensor gelu_backward_cpu(const Tensor& grad, const Tensor& self, bool approximate) {
   Tensor dX = at::native::empty_like(self, at::MemoryFormat::Contiguous);
   auto it = TensorIterator::binary_op(dX, grad, self);
-  GeluBackwardKernel(kCPU, it);
+  GeluBackwardKernel(kCPU, it, approximate);
   return dX;
 }
 
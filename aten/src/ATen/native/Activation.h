@@ -10,8 +10,8 @@ struct TensorIterator;
 
 namespace native {
 
-using activation_fn = void (*)(TensorIterator&);
-using activation_backward_fn = void (*)(TensorIterator&);
+using activation_fn = void (*)(TensorIterator&, bool /* approximate */);
+using activation_backward_fn = void (*)(TensorIterator&, bool /* approximate */);
 using threshold_fn = void (*)(TensorIterator&, Scalar, Scalar);
 using hardshrink_cpu_fn = void (*)(TensorIterator&, Scalar);
 using hardshrink_backward_cpu_fn = void (*)(TensorIterator&, Scalar);
@@ -87,6 +87,75 @@ static void avg_pool2d_out_frame(
   });
 }
 
+// Channels-last variant: one output pixel at a time, accumulating all
+// channels together. The channel dimension is the contiguous one, so the
+// inner loops are straight-line passes the compiler can vectorize.
+template <typename scalar_t>
+static void avg_pool2d_out_frame_channels_last(
+          const scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t nbatch,
+          int64_t channels,
+          int64_t inputWidth,
+          int64_t inputHeight,
+          int64_t outputWidth,
+          int64_t outputHeight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          bool count_include_pad,
+          c10::optional<int64_t> divisor_override)
+{
+  at::parallel_for(0, nbatch * outputHeight * outputWidth, 0, [&](int64_t begin, int64_t end) {
+    for (auto idx = begin; idx < end; idx++)
+    {
+      const int64_t xx = idx % outputWidth;
+      const int64_t yy = (idx / outputWidth) % outputHeight;
+      const int64_t p = idx / (outputWidth * outputHeight);
+
+      int64_t hstart = yy * dH - padH;
+      int64_t wstart = xx * dW - padW;
+      int64_t hend = std::min(hstart + kH, inputHeight + padH);
+      int64_t wend = std::min(wstart + kW, inputWidth + padW);
+      int pool_size = (hend - hstart) * (wend - wstart);
+      hstart = std::max(hstart, (int64_t) 0);
+      wstart = std::max(wstart, (int64_t) 0);
+      hend = std::min(hend, inputHeight);
+      wend = std::min(wend, inputWidth);
+
+      int divide_factor;
+      if (divisor_override.has_value()) {
+        divide_factor = divisor_override.value();
+      } else {
+        if(count_include_pad) {
+          divide_factor = pool_size;
+        } else {
+          divide_factor = (hend - hstart) * (wend - wstart);
+        }
+      }
+
+      scalar_t *ptr_output = output_data + idx * channels;
+      for (int64_t c = 0; c < channels; c++)
+        ptr_output[c] = 0;
+      for (int64_t ky = hstart; ky < hend; ky++)
+      {
+        for (int64_t kx = wstart; kx < wend; kx++)
+        {
+          const scalar_t *ptr_input =
+              input_data + ((p * inputHeight + ky) * inputWidth + kx) * channels;
+          for (int64_t c = 0; c < channels; c++)
+            ptr_output[c] += ptr_input[c];
+        }
+      }
+      for (int64_t c = 0; c < channels; c++)
+        ptr_output[c] /= divide_factor;
+    }
+  });
+}
+
 void avg_pool2d_out_cpu_template(
           Tensor &output,
           const Tensor &input_,
@@ -136,16 +205,31 @@ void avg_pool2d_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  // Keep channels-last inputs in channels-last, so NHWC pipelines don't pay
+  // for a transpose on either side of the op.
+  const bool channels_last = input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast);
+
   if (input_.ndimension() == 3) {
     output.resize_({nInputPlane, outputHeight, outputWidth});
   }
   else {
     output.resize_({nbatch, nInputPlane, outputHeight, outputWidth});
+    if (channels_last) {
+      output.unsafeGetTensorImpl()->empty_tensor_restride(
+          MemoryFormat::ChannelsLast);
+    }
   }
 
-  TORCH_CHECK(output.is_contiguous(), "avg_pool2d: output must be contiguous");
+  TORCH_CHECK(
+      output.is_contiguous(
+          channels_last ? at::MemoryFormat::ChannelsLast
+                        : at::MemoryFormat::Contiguous),
+      "avg_pool2d: output must be contiguous");
 
-  Tensor input = input_.contiguous();
+  Tensor input = channels_last
+      ? input_.contiguous(at::MemoryFormat::ChannelsLast)
+      : input_.contiguous();
 
   AT_DISPATCH_FLOATING_TYPES_AND(at::ScalarType::Long, input.scalar_type(),
     "avg_pool2d_out_frame",
@@ -153,18 +237,33 @@ void avg_pool2d_out_cpu_template(
       scalar_t *input_data = input.data_ptr<scalar_t>();
       scalar_t *output_data = output.data_ptr<scalar_t>();
 
-      avg_pool2d_out_frame(
-        input_data,
-        output_data,
-        nbatch,
-        nInputPlane,
-        inputWidth, inputHeight,
-        outputWidth, outputHeight,
-        kW, kH,
-        dW, dH,
-        padW, padH,
-        count_include_pad,
-        divisor_override);
+      if (channels_last) {
+        avg_pool2d_out_frame_channels_last(
+          input_data,
+          output_data,
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH,
+          dW, dH,
+          padW, padH,
+          count_include_pad,
+          divisor_override);
+      } else {
+        avg_pool2d_out_frame(
+          input_data,
+          output_data,
+          nbatch,
+          nInputPlane,
+          inputWidth, inputHeight,
+          outputWidth, outputHeight,
+          kW, kH,
+          dW, dH,
+          padW, padH,
+          count_include_pad,
+          divisor_override);
+      }
     }
   );
 }
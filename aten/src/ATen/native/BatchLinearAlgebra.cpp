@@ -303,6 +303,15 @@ template<> void lapackLuSolve<float>(char trans, int n, int nrhs, float *a, int
 // Below of the definitions of the functions operating on a batch that are going to be dispatched
 // in the main helper functions for the linear algebra operations
 
+// Reference LAPACK runs single-threaded per call, so batched factorizations
+// scale with cores only if we distribute the batch ourselves. Each matrix in
+// the batch is independent (disjoint data and info slots), so the loops below
+// are safe to split across threads. The grain size amortizes the dispatch
+// overhead when the matrices are tiny.
+static inline int64_t lapack_batch_grain_size(int64_t n) {
+  return std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, n * n));
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ solve ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 template<typename scalar_t>
@@ -318,19 +327,17 @@ static void apply_solve(Tensor& b, Tensor& A, std::vector<int64_t>& infos) {
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  auto ipiv = at::empty({n}, b.options().dtype(kInt));
-  auto ipiv_data = ipiv.data_ptr<int>();
-
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackSolve<scalar_t>(n, nrhs, A_working_ptr, n, ipiv_data, b_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  at::parallel_for(0, batch_size, lapack_batch_grain_size(n), [&](int64_t start, int64_t end) {
+    // The pivot workspace is written by every call, so each chunk gets its own.
+    std::vector<int> ipiv(n);
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      int info;
+      lapackSolve<scalar_t>(n, nrhs, A_working_ptr, n, ipiv.data(), b_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -521,15 +528,14 @@ static void apply_cholesky(Tensor& self, bool upper, std::vector<int64_t>& infos
   auto batch_size = batchCount(self);
   auto n = self.size(-2);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
-    infos[i] = info;
-    if (info != 0) {
-      return;
+  at::parallel_for(0, batch_size, lapack_batch_grain_size(n), [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      int info;
+      lapackCholesky<scalar_t>(uplo, n, self_working_ptr, n, &info);
+      infos[i] = info;
     }
-  }
+  });
 #endif
 }
 
@@ -585,12 +591,14 @@ static void apply_lu(Tensor& self, Tensor& pivots, Tensor& infos) {
   auto m = self.size(-2);
   auto n = self.size(-1);
 
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
-    int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
-    int* infos_working_ptr = &infos_data[i];
-    lapackLu<scalar_t>(m, n, self_working_ptr, m, pivots_working_ptr, infos_working_ptr);
-  }
+  at::parallel_for(0, batch_size, lapack_batch_grain_size(std::max(m, n)), [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* self_working_ptr = &self_data[i * self_matrix_stride];
+      int* pivots_working_ptr = &pivots_data[i * pivots_matrix_stride];
+      int* infos_working_ptr = &infos_data[i];
+      lapackLu<scalar_t>(m, n, self_working_ptr, m, pivots_working_ptr, infos_working_ptr);
+    }
+  });
 #endif
 }
 
@@ -646,12 +654,14 @@ static void apply_triangular_solve(Tensor& b, Tensor& A, bool upper, bool transp
   auto n = A.size(-2);
   auto nrhs = b.size(-1);
 
-  int info;
-  for (int64_t i = 0; i < batch_size; i++) {
-    scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
-    scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
-    lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
-  }
+  at::parallel_for(0, batch_size, lapack_batch_grain_size(n), [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; i++) {
+      scalar_t* A_working_ptr = &A_data[i * A_mat_stride];
+      scalar_t* b_working_ptr = &b_data[i * b_mat_stride];
+      int info;
+      lapackTriangularSolve<scalar_t>(uplo, trans, diag, n, nrhs, A_working_ptr, n, b_working_ptr, n, &info);
+    }
+  });
 #endif
 }
 
@@ -5,6 +5,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/MemoryOverlap.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/SmallTensorFastPath.h>
 #include <ATen/native/TensorIterator.h>
 
 namespace at {
@@ -24,17 +25,22 @@ DEFINE_DISPATCH(ge_stub);
 DEFINE_DISPATCH(eq_stub);
 DEFINE_DISPATCH(ne_stub);
 
-static inline void alpha_check(const TensorIterator& iter, Scalar alpha) {
-  TORCH_CHECK(! alpha.isBoolean() || iter.dtype() == ScalarType::Bool,
+static inline void alpha_check(const ScalarType dtype, Scalar alpha) {
+  TORCH_CHECK(! alpha.isBoolean() || dtype == ScalarType::Bool,
               "Boolean alpha only supported for Boolean results.");
-  TORCH_CHECK(isFloatingType(iter.dtype()) || alpha.isIntegral(true),
+  TORCH_CHECK(isFloatingType(dtype) || alpha.isIntegral(true),
               "For integral input tensors, argument alpha must not be a floating point number.");
 }
 
 Tensor& add_out(Tensor& result, const Tensor& self, const Tensor& other, Scalar alpha) {
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    alpha_check(self.scalar_type(), alpha);
+    return small_tensor_binary_alpha_kernel(result, self, other, alpha, "add_small_cpu",
+        [](auto a, auto b, auto alpha_val) { return a + alpha_val * b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other,
     /*check_mem_overlap=*/true);
-  alpha_check(iter, alpha);
+  alpha_check(iter.dtype(), alpha);
   add_stub(iter.device_type(), iter, alpha);
   TORCH_INTERNAL_ASSERT(result.scalar_type() == iter.output().dtype());
   return result;
@@ -42,8 +48,13 @@ Tensor& add_out(Tensor& result, const Tensor& self, const Tensor& other, Scalar
 
 Tensor add(const Tensor& self, const Tensor& other, Scalar alpha) {
   Tensor result;
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    alpha_check(self.scalar_type(), alpha);
+    return small_tensor_binary_alpha_kernel(result, self, other, alpha, "add_small_cpu",
+        [](auto a, auto b, auto alpha_val) { return a + alpha_val * b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other);
-  alpha_check(iter, alpha);
+  alpha_check(iter.dtype(), alpha);
   add_stub(iter.device_type(), iter, alpha);
   return iter.output();
 }
@@ -53,6 +64,10 @@ Tensor& add_(Tensor& self, const Tensor& other, Scalar alpha) {
 }
 
 Tensor& div_out(Tensor& result, const Tensor& self, const Tensor& other) {
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    return small_tensor_binary_kernel(result, self, other, "div_small_cpu",
+        [](auto a, auto b) { return a / b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other,
     /*check_mem_overlap=*/true);
   div_stub(iter.device_type(), iter);
@@ -61,6 +76,10 @@ Tensor& div_out(Tensor& result, const Tensor& self, const Tensor& other) {
 
 Tensor div(const Tensor& self, const Tensor& other) {
   Tensor result;
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    return small_tensor_binary_kernel(result, self, other, "div_small_cpu",
+        [](auto a, auto b) { return a / b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other);
   div_stub(iter.device_type(), iter);
   return iter.output();
@@ -71,6 +90,10 @@ Tensor& div_(Tensor& self, const Tensor& other) {
 }
 
 Tensor& mul_out(Tensor& result, const Tensor& self, const Tensor& other) {
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    return small_tensor_binary_kernel(result, self, other, "mul_small_cpu",
+        [](auto a, auto b) { return a * b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other,
     /*check_mem_overlap=*/true);
   mul_stub(iter.device_type(), iter);
@@ -79,6 +102,10 @@ Tensor& mul_out(Tensor& result, const Tensor& self, const Tensor& other) {
 
 Tensor mul(const Tensor& self, const Tensor& other) {
   Tensor result;
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    return small_tensor_binary_kernel(result, self, other, "mul_small_cpu",
+        [](auto a, auto b) { return a * b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other);
   mul_stub(iter.device_type(), iter);
   return iter.output();
@@ -100,9 +127,14 @@ static inline void sub_check(const Tensor& self, const Tensor& other) {
 
 Tensor& sub_out(Tensor& result, const Tensor& self, const Tensor& other, Scalar alpha) {
   sub_check(self, other);
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    alpha_check(self.scalar_type(), alpha);
+    return small_tensor_binary_alpha_kernel(result, self, other, alpha, "sub_small_cpu",
+        [](auto a, auto b, auto alpha_val) { return a - alpha_val * b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other,
     /*check_mem_overlap=*/true);
-  alpha_check(iter, alpha);
+  alpha_check(iter.dtype(), alpha);
   sub_stub(iter.device_type(), iter, alpha);
   TORCH_INTERNAL_ASSERT(result.scalar_type() == iter.output().dtype());
   return result;
@@ -111,8 +143,13 @@ Tensor& sub_out(Tensor& result, const Tensor& self, const Tensor& other, Scalar
 Tensor sub(const Tensor& self, const Tensor& other, Scalar alpha) {
   sub_check(self, other);
   Tensor result;
+  if (can_use_small_tensor_fast_path(result, self, other)) {
+    alpha_check(self.scalar_type(), alpha);
+    return small_tensor_binary_alpha_kernel(result, self, other, alpha, "sub_small_cpu",
+        [](auto a, auto b, auto alpha_val) { return a - alpha_val * b; });
+  }
   auto iter = TensorIterator::binary_op(result, self, other);
-  alpha_check(iter, alpha);
+  alpha_check(iter.dtype(), alpha);
   sub_stub(iter.device_type(), iter, alpha);
   return iter.output();
 }
@@ -0,0 +1,51 @@
+#include <ATen/native/ConvWorkspace.h>
+
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// A handful of slots per thread covers finput plus fgrad_input for the convs
+// live at any point in a forward/backward; anything beyond that simply gets
+// an uncached allocation.
+constexpr size_t kMaxConvWorkspaceSlots = 8;
+
+thread_local std::vector<Tensor> conv_workspace_slots;
+
+// A slot may only be handed out again once nothing outside the arena can
+// observe it. The tensor use count covers direct references; the storage use
+// count additionally covers variable wrappers made from it (make_variable
+// shallow-copies the impl but shares the storage).
+bool slot_is_free(const Tensor& slot) {
+  return slot.use_count() == 1 && slot.storage().use_count() == 1;
+}
+
+} // namespace
+
+Tensor lease_conv_workspace(IntArrayRef sizes, const TensorOptions& options) {
+  if (options.device().type() != DeviceType::CPU) {
+    return at::empty(sizes, options);
+  }
+  for (auto& slot : conv_workspace_slots) {
+    if (slot_is_free(slot) && slot.dtype() == options.dtype()) {
+      // resize_ keeps the storage when shrinking and grows it when needed,
+      // which is exactly the high-water-mark behavior we want.
+      return slot.resize_(sizes);
+    }
+  }
+  Tensor fresh = at::empty(sizes, options);
+  for (auto& slot : conv_workspace_slots) {
+    if (slot_is_free(slot)) {
+      // Free slot of another dtype; repurpose it rather than growing.
+      slot = fresh;
+      return fresh;
+    }
+  }
+  if (conv_workspace_slots.size() < kMaxConvWorkspaceSlots) {
+    conv_workspace_slots.push_back(fresh);
+  }
+  return fresh;
+}
+
+}} // namespace at::native
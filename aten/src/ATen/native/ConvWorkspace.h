@@ -0,0 +1,16 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// Thread-local workspace arena for the im2col/col2im scratch buffers
+// (finput/fgrad_input) used by the unfold-based conv kernels. Leasing hands
+// out a CPU tensor whose storage is recycled across calls high-water-mark
+// style, so shape-stable inference stops paying a multi-MB alloc/free per
+// conv call. A leased tensor is an ordinary Tensor: if a caller keeps it
+// alive (e.g. autograd saving finput for backward), the arena detects the
+// outstanding reference and allocates a fresh buffer instead of reusing it.
+CAFFE2_API Tensor lease_conv_workspace(IntArrayRef sizes, const TensorOptions& options);
+
+}} // namespace at::native
@@ -8,6 +8,14 @@
 #include "nnpack.h"
 #endif
 
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
 static const int MIOPEN_DIM_MAX = 4;
 
 namespace at { namespace native {
@@ -531,6 +539,188 @@ at::Tensor convolution_overrideable(
   AT_ERROR("You are likely triggering this with tensor backend other than CPU/CUDA/MKLDNN, if this is intended, please use torch::RegisterOperators() to override this function ");
 }
 
+// Benchmark-mode auto-tuner for the CPU backend choice. The static
+// heuristics in ConvParams::use_mkldnn/use_nnpack pick wrong backends for
+// whole shape ranges, so when benchmark mode is on (the same flag cuDNN
+// benchmark mode uses) each shape is timed once against every eligible
+// backend and the winner is cached. Setting PYTORCH_CONV_TUNER_CACHE to a
+// file path makes the cache persistent across processes: it is loaded on
+// first use and every newly tuned shape is appended.
+namespace {
+
+enum CpuConvBackend : int {
+  CONV_BACKEND_THNN = 0,
+  CONV_BACKEND_NNPACK = 1,
+  CONV_BACKEND_MKLDNN = 2,
+};
+
+struct ConvTunerCache {
+  std::mutex mutex;
+  std::unordered_map<std::string, int> winners;
+  bool loaded = false;
+  std::string path;
+
+  // Must be called with the mutex held.
+  void load_once() {
+    if (loaded) {
+      return;
+    }
+    loaded = true;
+    const char* env = std::getenv("PYTORCH_CONV_TUNER_CACHE");
+    if (env == nullptr) {
+      return;
+    }
+    path = env;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+      const size_t pos = line.rfind('\t');
+      if (pos == std::string::npos) {
+        continue;
+      }
+      winners[line.substr(0, pos)] = std::atoi(line.c_str() + pos + 1);
+    }
+  }
+
+  // Must be called with the mutex held.
+  void record(const std::string& key, int backend) {
+    winners[key] = backend;
+    if (path.empty()) {
+      return;
+    }
+    std::ofstream out(path, std::ios::app);
+    out << key << '\t' << backend << '\n';
+  }
+};
+
+ConvTunerCache& conv_tuner_cache() {
+  static ConvTunerCache cache;
+  return cache;
+}
+
+std::string conv_tuner_key(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const ConvParams& params) {
+  std::ostringstream ss;
+  ss << input.sizes() << ";" << weight.sizes()
+     << ";" << IntArrayRef{params.stride}
+     << ";" << IntArrayRef{params.padding}
+     << ";" << IntArrayRef{params.dilation}
+     << ";" << params.groups << ";" << params.transposed;
+  return ss.str();
+}
+
+std::vector<int> conv_tuner_candidates(const ConvParams& params) {
+  std::vector<int> candidates;
+  candidates.push_back(CONV_BACKEND_THNN);
+#if AT_NNPACK_ENABLED()
+  if (at::_nnpack_available() && !params.is_strided()) {
+    candidates.push_back(CONV_BACKEND_NNPACK);
+  }
+#endif
+#if AT_MKLDNN_ENABLED()
+  if (at::globalContext().userEnabledMkldnn()) {
+    candidates.push_back(CONV_BACKEND_MKLDNN);
+  }
+#endif
+  return candidates;
+}
+
+// Only shapes the tuned backends all agree on are eligible: CPU float,
+// 4-d, single group, not transposed and not dilated. Everything else keeps
+// the static heuristics.
+bool use_conv_tuner(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const ConvParams& params,
+    bool input_is_mkldnn) {
+  if (!params.benchmark || input_is_mkldnn) {
+    return false;
+  }
+  if (input.device().type() != c10::DeviceType::CPU ||
+      input.scalar_type() != kFloat || weight.scalar_type() != kFloat) {
+    return false;
+  }
+  if (params.transposed || params.groups != 1 || params.is_dilated() ||
+      input.ndimension() != 4 || weight.ndimension() != 4) {
+    return false;
+  }
+  return conv_tuner_candidates(params).size() > 1;
+}
+
+at::Tensor run_conv_backend(
+    int backend,
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias,
+    const ConvParams& params) {
+  switch (backend) {
+#if AT_MKLDNN_ENABLED()
+    case CONV_BACKEND_MKLDNN:
+      return at::mkldnn_convolution(
+          input, weight.contiguous(), bias.defined() ? bias.contiguous() : bias,
+          params.padding, params.stride, params.dilation, params.groups);
+#endif
+#if AT_NNPACK_ENABLED()
+    case CONV_BACKEND_NNPACK:
+      return at::_nnpack_spatial_convolution(input, weight, bias, params.padding);
+#endif
+    default:
+      // Also catches cached winners whose backend is not compiled into
+      // this build (e.g. a cache file written on another machine).
+      return at::thnn_conv2d(
+          input, weight, weight.sizes().slice(2), bias,
+          params.stride, params.padding);
+  }
+}
+
+at::Tensor tuned_convolution(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias,
+    const ConvParams& params) {
+  auto& cache = conv_tuner_cache();
+  const std::string key = conv_tuner_key(input, weight, params);
+  int cached_backend = -1;
+  {
+    std::lock_guard<std::mutex> guard(cache.mutex);
+    cache.load_once();
+    auto it = cache.winners.find(key);
+    if (it != cache.winners.end()) {
+      cached_backend = it->second;
+    }
+  }
+  if (cached_backend >= 0) {
+    return run_conv_backend(cached_backend, input, weight, bias, params);
+  }
+
+  // First encounter of this shape: time each candidate once and keep the
+  // fastest. The winning run's output is returned, so tuning costs one
+  // extra convolution per losing backend.
+  Tensor best_output;
+  double best_time = std::numeric_limits<double>::infinity();
+  int best_backend = CONV_BACKEND_THNN;
+  for (int backend : conv_tuner_candidates(params)) {
+    const auto start = std::chrono::steady_clock::now();
+    auto output = run_conv_backend(backend, input, weight, bias, params);
+    const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    if (elapsed < best_time) {
+      best_time = elapsed;
+      best_backend = backend;
+      best_output = output;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(cache.mutex);
+    cache.record(key, best_backend);
+  }
+  return best_output;
+}
+
+} // namespace
+
 at::Tensor _convolution(
     const Tensor& input_r, const Tensor& weight_r, const Tensor& bias_r,
     IntArrayRef stride_, IntArrayRef padding_, IntArrayRef dilation_,
@@ -628,6 +818,8 @@ at::Tensor _convolution(
           input.contiguous(), weight, bias,
           params.padding, params.stride, params.dilation, params.groups, params.benchmark, params.deterministic);
     }
+  } else if (use_conv_tuner(input, weight, params, input_is_mkldnn)) {
+    output = tuned_convolution(input.contiguous(), weight, bias, params);
   } else if (params.use_mkldnn(input)) {
 #if AT_MKLDNN_ENABLED()
     TORCH_CHECK(input.type() == weight.type(),
@@ -5,6 +5,7 @@
 #include <ATen/TensorUtils.h>
 #include <ATen/core/grad_mode.h>
 #include <ATen/div_rtn.h>
+#include <ATen/native/ConvWorkspace.h>
 #include <ATen/native/Unfold2d.h>
 
 namespace at {
@@ -462,8 +463,10 @@ std::tuple<Tensor, Tensor, Tensor> slow_conv2d_forward_cpu(
     IntArrayRef stride,
     IntArrayRef padding) {
   auto output = at::empty({0}, self.options());
-  auto finput = at::empty({0}, self.options());
-  auto fgrad_input = at::empty({0}, self.options());
+  // The im2col scratch comes from the thread-local arena; the out variant's
+  // resize_ below then reuses the recycled storage across calls.
+  auto finput = lease_conv_workspace({0}, self.options());
+  auto fgrad_input = lease_conv_workspace({0}, self.options());
   slow_conv2d_forward_out_cpu(
       output,
       finput,
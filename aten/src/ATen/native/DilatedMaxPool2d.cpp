@@ -117,6 +117,77 @@ static void max_pool2d_with_indices_out_frame(
   });
 }
 
+// Channels-last variant: one output pixel at a time, carrying the running
+// max and argmax for every channel together. The channel dimension is the
+// contiguous one, so the inner loops are straight-line passes the compiler
+// can vectorize. Stored indices use the same h*iwidth+w encoding as the
+// NCHW kernel.
+template <typename scalar_t>
+static void max_pool2d_with_indices_out_frame_channels_last(
+          const scalar_t *input_data,
+          scalar_t *output_data,
+          int64_t *indices_data,
+          int64_t nbatch,
+          int64_t channels,
+          int64_t iwidth,
+          int64_t iheight,
+          int64_t owidth,
+          int64_t oheight,
+          int kW,
+          int kH,
+          int dW,
+          int dH,
+          int padW,
+          int padH,
+          int dilationW,
+          int dilationH)
+{
+  at::parallel_for(0, nbatch * oheight * owidth, 0, [&](int64_t begin, int64_t end) {
+    for (auto idx = begin; idx < end; idx++)
+    {
+      const int64_t j = idx % owidth;
+      const int64_t i = (idx / owidth) % oheight;
+      const int64_t p = idx / (owidth * oheight);
+
+      int64_t hstart = i * dH - padH;
+      int64_t wstart = j * dW - padW;
+      const int64_t hend = std::min(hstart + (kH - 1) * dilationH + 1, iheight);
+      const int64_t wend = std::min(wstart + (kW - 1) * dilationW + 1, iwidth);
+      while(hstart < 0)
+        hstart += dilationH;
+      while(wstart < 0)
+        wstart += dilationW;
+
+      scalar_t *op = output_data + idx * channels;
+      int64_t *indp = indices_data + idx * channels;
+      for (int64_t c = 0; c < channels; c++)
+      {
+        op[c] = -std::numeric_limits<scalar_t>::infinity();
+        indp[c] = hstart*iwidth + wstart;
+      }
+
+      for (int64_t y = hstart; y < hend; y += dilationH)
+      {
+        for (int64_t x = wstart; x < wend; x += dilationW)
+        {
+          const int64_t tcntr = y*iwidth + x;
+          const scalar_t *ip =
+              input_data + ((p * iheight + y) * iwidth + x) * channels;
+          for (int64_t c = 0; c < channels; c++)
+          {
+            const scalar_t val = ip[c];
+            if ((val > op[c]) || std::isnan(val))
+            {
+              op[c] = val;
+              indp[c] = tcntr;
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
 void max_pool2d_with_indices_out_cpu_template(
           Tensor& output,
           Tensor& indices,
@@ -170,8 +241,15 @@ void max_pool2d_with_indices_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth);
 
+  // Keep channels-last inputs in channels-last, so NHWC pipelines don't pay
+  // for a transpose on either side of the op.
+  const bool channels_last = input_.ndimension() == 4 &&
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast);
+
   /* get contiguous input */
-  Tensor input = input_.contiguous();
+  Tensor input = channels_last
+      ? input_.contiguous(at::MemoryFormat::ChannelsLast)
+      : input_.contiguous();
 
   /* resize output */
   if (input.ndimension() == 3)
@@ -205,6 +283,12 @@ void max_pool2d_with_indices_out_cpu_template(
     output.resize_({nbatch, nInputPlane, outputHeight, outputWidth});
     /* indices will contain the locations for each output point */
     indices.resize_({nbatch, nInputPlane, outputHeight, outputWidth});
+    if (channels_last) {
+      output.unsafeGetTensorImpl()->empty_tensor_restride(
+          MemoryFormat::ChannelsLast);
+      indices.unsafeGetTensorImpl()->empty_tensor_restride(
+          MemoryFormat::ChannelsLast);
+    }
 
     AT_DISPATCH_FLOATING_TYPES(input.scalar_type(),
       "max_pool2d_with_indices_cpu",
@@ -213,17 +297,32 @@ void max_pool2d_with_indices_out_cpu_template(
         scalar_t *output_data = output.data_ptr<scalar_t>();
         int64_t *indices_data = indices.data_ptr<int64_t>();
 
-        max_pool2d_with_indices_out_frame(
-          input_data,
-          output_data,
-          indices_data,
-          nbatch,
-          nInputPlane,
-          inputWidth, inputHeight,
-          outputWidth, outputHeight,
-          kW, kH, dW, dH,
-          padW, padH,
-          dilationW, dilationH); }
+        if (channels_last) {
+          max_pool2d_with_indices_out_frame_channels_last(
+            input_data,
+            output_data,
+            indices_data,
+            nbatch,
+            nInputPlane,
+            inputWidth, inputHeight,
+            outputWidth, outputHeight,
+            kW, kH, dW, dH,
+            padW, padH,
+            dilationW, dilationH);
+        } else {
+          max_pool2d_with_indices_out_frame(
+            input_data,
+            output_data,
+            indices_data,
+            nbatch,
+            nInputPlane,
+            inputWidth, inputHeight,
+            outputWidth, outputHeight,
+            kW, kH, dW, dH,
+            padW, padH,
+            dilationW, dilationH);
+        }
+      }
     );
   }
 }
@@ -3,14 +3,20 @@
 #include <c10/util/Exception.h>
 
 #include <cpuinfo.h>
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <unordered_map>
 
 namespace at { namespace native {
 
 static CPUCapability compute_cpu_capability() {
   auto envar = std::getenv("ATEN_CPU_CAPABILITY");
   if (envar) {
+    if (strcmp(envar, "avx512") == 0) {
+      return CPUCapability::AVX512;
+    }
     if (strcmp(envar, "avx2") == 0) {
       return CPUCapability::AVX2;
     }
@@ -25,6 +31,11 @@ static CPUCapability compute_cpu_capability() {
 
 #if !defined(__powerpc__) && !defined(__s390x__)
   if (cpuinfo_initialize()) {
+    if (cpuinfo_has_x86_avx512f() && cpuinfo_has_x86_avx512dq() &&
+        cpuinfo_has_x86_avx512vl() && cpuinfo_has_x86_avx512bw() &&
+        cpuinfo_has_x86_fma3()) {
+      return CPUCapability::AVX512;
+    }
     if (cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
       return CPUCapability::AVX2;
     }
@@ -41,4 +52,63 @@ CPUCapability get_cpu_capability() {
   return capability;
 }
 
+const char* cpu_capability_name(CPUCapability capability) {
+  switch (capability) {
+    case CPUCapability::DEFAULT:
+      return "DEFAULT";
+    case CPUCapability::AVX:
+      return "AVX";
+    case CPUCapability::AVX2:
+      return "AVX2";
+    case CPUCapability::AVX512:
+      return "AVX512";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+namespace {
+
+// Stubs register from static initializers in many translation units, so
+// the registry is a function-local static guarded by a mutex.
+struct DispatchStubRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::unique_ptr<DispatchStubControl>> stubs;
+};
+
+DispatchStubRegistry& dispatch_stub_registry() {
+  static DispatchStubRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+void register_dispatch_stub_control(
+    std::unique_ptr<DispatchStubControl> control) {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto name = control->name();
+  registry.stubs.emplace(std::move(name), std::move(control));
+}
+
+std::vector<std::string> list_dispatch_stubs() {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  std::vector<std::string> names;
+  names.reserve(registry.stubs.size());
+  for (const auto& entry : registry.stubs) {
+    names.push_back(entry.first);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+DispatchStubControl& get_dispatch_stub_control(const std::string& name) {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto it = registry.stubs.find(name);
+  TORCH_CHECK(it != registry.stubs.end(), "Unknown dispatch stub: ", name);
+  return *it->second;
+}
+
 }}  // namespace at::native
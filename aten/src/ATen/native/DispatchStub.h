@@ -3,7 +3,10 @@
 #include <c10/core/Backend.h>
 #include <c10/core/ScalarType.h>
 #include <c10/util/Exception.h>
+#include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 // Implements instruction set specific function dispatch.
 //
@@ -35,7 +38,7 @@
 // TODO: CPU instruction set selection should be folded into whatever
 // the main dispatch mechanism is.
 
-// ignore warnings about DispatchStub::DEFAULT, AVX, AVX2 defined elsewhere
+// ignore warnings about DispatchStub::DEFAULT, AVX, AVX2, AVX512 defined elsewhere
 #if defined(__clang__)
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wundefined-var-template"
@@ -47,14 +50,73 @@ enum class CPUCapability {
   DEFAULT = 0,
   AVX = 1,
   AVX2 = 2,
+  AVX512 = 3,
   NUM_OPTIONS
 };
 
 CPUCapability get_cpu_capability();
 
+// Human-readable name of a capability ("DEFAULT", "AVX", ...); used in
+// error messages and by torch.backends introspection.
+CAFFE2_API const char* cpu_capability_name(CPUCapability capability);
+
 template <typename FnPtr, typename T>
 struct CAFFE2_API DispatchStub;
 
+// Type-erased runtime control surface over a single DispatchStub.
+//
+// The capability chosen by get_cpu_capability() is process-wide; the only
+// knob is the ATEN_CPU_CAPABILITY environment variable, which downgrades
+// every kernel at once. Sometimes one particular vectorized kernel loses to
+// its scalar counterpart on a given microarchitecture, and it should be
+// possible to pin just that kernel without giving up AVX2 everywhere else.
+// DEFINE_DISPATCH registers each stub here under its C++ identifier (e.g.
+// "add_stub"), so callers can enumerate stubs, inspect which variant each
+// one resolved to, and force a specific variant per kernel.
+//
+// Forcing is intended for setup time (benchmark harnesses, process init):
+// like the lazy dispatch pointer itself, it is not synchronized against
+// concurrent dispatch on other threads.
+struct CAFFE2_API DispatchStubControl {
+  virtual ~DispatchStubControl() {}
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  // True if a kernel is registered (non-null) for the given CPU variant.
+  virtual bool has_cpu_kernel(CPUCapability capability) const = 0;
+
+  // The variant CPU dispatch currently uses (resolving it if it has not
+  // been called yet). Reflects any forced override.
+  virtual CPUCapability resolved_cpu_capability() = 0;
+
+  // Pins CPU dispatch for this kernel to the given variant; throws if no
+  // kernel is registered for it.
+  virtual void force_cpu_capability(CPUCapability capability) = 0;
+
+  // Restores capability-based selection for this kernel.
+  virtual void reset_cpu_capability() = 0;
+
+ protected:
+  explicit DispatchStubControl(std::string name) : name_(std::move(name)) {}
+
+ private:
+  std::string name_;
+};
+
+// Names of all registered stubs, sorted. Stubs register during static
+// initialization, so the result depends on which libraries are loaded.
+CAFFE2_API std::vector<std::string> list_dispatch_stubs();
+
+// Looks up a stub by the name reported by list_dispatch_stubs(); throws
+// if there is no such stub.
+CAFFE2_API DispatchStubControl& get_dispatch_stub_control(
+    const std::string& name);
+
+CAFFE2_API void register_dispatch_stub_control(
+    std::unique_ptr<DispatchStubControl> control);
+
 template <typename rT, typename T, typename... Args>
 struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
   using FnPtr = rT (*) (Args...);
@@ -84,6 +146,12 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
   FnPtr choose_cpu_impl() {
     auto capability = static_cast<int>(get_cpu_capability());
     (void)capability;
+#ifdef HAVE_AVX512_CPU_DEFINITION
+    if (capability >= static_cast<int>(CPUCapability::AVX512)) {
+      AT_ASSERTM(AVX512, "DispatchStub: missing AVX512 kernel");
+      return AVX512;
+    }
+#endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
     if (capability >= static_cast<int>(CPUCapability::AVX2)) {
       AT_ASSERTM(AVX2, "DispatchStub: missing AVX2 kernel");
@@ -100,6 +168,64 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
     return DEFAULT;
   }
 
+  // Returns the kernel registered for the given variant, or nullptr if the
+  // variant was compiled out or has no kernel.
+  FnPtr cpu_kernel_for(CPUCapability capability) const {
+    switch (capability) {
+      case CPUCapability::DEFAULT:
+        return DEFAULT;
+#ifdef HAVE_AVX_CPU_DEFINITION
+      case CPUCapability::AVX:
+        return AVX;
+#endif
+#ifdef HAVE_AVX2_CPU_DEFINITION
+      case CPUCapability::AVX2:
+        return AVX2;
+#endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+      case CPUCapability::AVX512:
+        return AVX512;
+#endif
+      default:
+        return nullptr;
+    }
+  }
+
+  CPUCapability resolved_cpu_capability() {
+    if (!cpu_dispatch_ptr) {
+      cpu_dispatch_ptr = choose_cpu_impl();
+    }
+#ifdef HAVE_AVX512_CPU_DEFINITION
+    if (AVX512 && cpu_dispatch_ptr == AVX512) {
+      return CPUCapability::AVX512;
+    }
+#endif
+#ifdef HAVE_AVX2_CPU_DEFINITION
+    if (AVX2 && cpu_dispatch_ptr == AVX2) {
+      return CPUCapability::AVX2;
+    }
+#endif
+#ifdef HAVE_AVX_CPU_DEFINITION
+    if (AVX && cpu_dispatch_ptr == AVX) {
+      return CPUCapability::AVX;
+    }
+#endif
+    return CPUCapability::DEFAULT;
+  }
+
+  void force_cpu_capability(CPUCapability capability) {
+    auto ptr = cpu_kernel_for(capability);
+    TORCH_CHECK(
+        ptr,
+        "DispatchStub: no kernel registered for capability ",
+        cpu_capability_name(capability));
+    cpu_dispatch_ptr = ptr;
+  }
+
+  void reset_cpu_capability() {
+    cpu_dispatch_ptr = nullptr;
+  }
+
 // Fixing dispatch error in Windows debug builds.
 // See https://github.com/pytorch/pytorch/issues/22681 for more details.
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -118,6 +244,9 @@ struct CAFFE2_API DispatchStub<rT (*)(Args...), T> {
 #ifdef HAVE_AVX2_CPU_DEFINITION
   static FnPtr AVX2;
 #endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+  static FnPtr AVX512;
+#endif
 };
 
 namespace {
@@ -135,6 +264,44 @@ struct RegisterHIPDispatch {
     stub.cuda_dispatch_ptr = value;
   }
 };
+
+// Forwards the DispatchStubControl interface to a concrete stub. One of
+// these is instantiated per DEFINE_DISPATCH; the stub itself is a global
+// with static storage duration, so holding a reference is safe.
+template <typename FnPtr, typename T>
+struct DispatchStubControlImpl : DispatchStubControl {
+  DispatchStubControlImpl(std::string name, DispatchStub<FnPtr, T>& stub)
+      : DispatchStubControl(std::move(name)), stub_(stub) {}
+
+  bool has_cpu_kernel(CPUCapability capability) const override {
+    return stub_.cpu_kernel_for(capability) != nullptr;
+  }
+
+  CPUCapability resolved_cpu_capability() override {
+    return stub_.resolved_cpu_capability();
+  }
+
+  void force_cpu_capability(CPUCapability capability) override {
+    stub_.force_cpu_capability(capability);
+  }
+
+  void reset_cpu_capability() override {
+    stub_.reset_cpu_capability();
+  }
+
+ private:
+  DispatchStub<FnPtr, T>& stub_;
+};
+
+struct RegisterDispatchStubControl {
+  template <typename T>
+  RegisterDispatchStubControl(const char* name, T& stub) {
+    using FnPtr = typename T::FnPtr;
+    register_dispatch_stub_control(
+        std::unique_ptr<DispatchStubControl>(
+            new DispatchStubControlImpl<FnPtr, T>(name, stub)));
+  }
+};
 } // anonymous namespace
 
 // Compiler will complain if you put things like std::tuple<Tensor, Tensor> in
@@ -150,7 +317,9 @@ struct RegisterHIPDispatch {
   };                                       \
   extern CAFFE2_API struct name name
 
-#define DEFINE_DISPATCH(name) struct name name
+#define DEFINE_DISPATCH(name)  \
+  struct name name;            \
+  static RegisterDispatchStubControl name ## __control(#name, name)
 
 #define REGISTER_ARCH_DISPATCH(name, arch, fn) \
   template <> decltype(fn) DispatchStub<decltype(fn), struct name>::arch = fn;
@@ -167,10 +336,17 @@ struct RegisterHIPDispatch {
 #define REGISTER_AVX2_DISPATCH(name, fn)
 #endif
 
+#ifdef HAVE_AVX512_CPU_DEFINITION
+#define REGISTER_AVX512_DISPATCH(name, fn) REGISTER_ARCH_DISPATCH(name, AVX512, fn)
+#else
+#define REGISTER_AVX512_DISPATCH(name, fn)
+#endif
+
 #define REGISTER_NO_CPU_DISPATCH(name, fn_type)                                \
   REGISTER_ARCH_DISPATCH(name, DEFAULT, static_cast<fn_type>(nullptr))         \
   REGISTER_AVX_DISPATCH(name, static_cast<fn_type>(nullptr))                   \
-  REGISTER_AVX2_DISPATCH(name, static_cast<fn_type>(nullptr))
+  REGISTER_AVX2_DISPATCH(name, static_cast<fn_type>(nullptr))                  \
+  REGISTER_AVX512_DISPATCH(name, static_cast<fn_type>(nullptr))
 
 #define REGISTER_CUDA_DISPATCH(name, fn) \
   static RegisterCUDADispatch<decltype(fn), struct name> name ## __register(name, fn);
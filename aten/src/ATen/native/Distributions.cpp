@@ -10,6 +10,7 @@
 
 #include <ATen/Utils.h>
 #include <ATen/CPUGenerator.h>
+#include <ATen/Parallel.h>
 #include <ATen/core/DistributionsHelper.h>
 #include <ATen/native/Distributions.h>
 #include <ATen/native/DispatchStub.h>
@@ -108,6 +109,52 @@ int64_t sample_poisson(double lambda, at::CPUGenerator* generator) {
   }
 }
 
+/*
+ * Counter-based bernoulli sampling: every element draws from its own
+ * Philox subsequence, so the loop runs under at::parallel_for without
+ * holding the generator mutex and produces the same tensor for any
+ * number of threads.  The kernel reserves one 128-bit counter block per
+ * subsequence (a double sample needs two 32-bit randoms) from the shared
+ * generator up front.
+ *
+ * See Note [Acquire lock when using random generators]
+ */
+template <typename self_t, typename accscalar_t>
+void bernoulli_scalar_philox_kernel(
+    self_t* self_data,
+    int64_t numel,
+    double p,
+    std::pair<uint64_t, uint64_t> rng_engine_inputs) {
+  at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      at::PhiloxCPUGenerator philox(
+          rng_engine_inputs.first,
+          static_cast<uint64_t>(i),
+          rng_engine_inputs.second);
+      at::bernoulli_distribution<accscalar_t> bernoulli(static_cast<accscalar_t>(p));
+      self_data[i] = static_cast<self_t>(bernoulli(&philox));
+    }
+  });
+}
+
+template <typename self_t, typename p_t, typename accscalar_t>
+void bernoulli_tensor_philox_kernel(
+    self_t* self_data,
+    const p_t* p_data,
+    int64_t numel,
+    std::pair<uint64_t, uint64_t> rng_engine_inputs) {
+  at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      at::PhiloxCPUGenerator philox(
+          rng_engine_inputs.first,
+          static_cast<uint64_t>(i),
+          rng_engine_inputs.second);
+      at::bernoulli_distribution<accscalar_t> bernoulli(static_cast<accscalar_t>(p_data[i]));
+      self_data[i] = static_cast<self_t>(bernoulli(&philox));
+    }
+  });
+}
+
 } // namespace
 
 namespace at {
@@ -138,11 +185,22 @@ Tensor& bernoulli_tensor_cpu_(Tensor& self, const Tensor& p_, Generator* gen) {
 #endif
   AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_tensor_cpu_self_", [&] {
     CPUGenerator* generator = get_generator_or_default<CPUGenerator>(gen, detail::getDefaultCPUGenerator());
-    // See Note [Acquire lock when using random generators]
-    std::lock_guard<std::mutex> lock(generator->mutex_);
     using self_t = scalar_t;
     if (p_.scalar_type() == kDouble) {
       auto p = std::get<0>(expand_inplace(self, p_.to(kCPU)));
+      if (self.is_contiguous() && p.is_contiguous()) {
+        std::pair<uint64_t, uint64_t> rng_engine_inputs;
+        {
+          // See Note [Acquire lock when using random generators]
+          std::lock_guard<std::mutex> lock(generator->mutex_);
+          rng_engine_inputs = generator->philox_engine_inputs(1);
+        }
+        bernoulli_tensor_philox_kernel<self_t, double, double>(
+            self.data_ptr<self_t>(), p.data_ptr<double>(), self.numel(), rng_engine_inputs);
+        return;
+      }
+      // See Note [Acquire lock when using random generators]
+      std::lock_guard<std::mutex> lock(generator->mutex_);
       CPU_tensor_apply2<self_t, double>(
         self, p, [generator](self_t& ret_val, double& p_val) {
           at::bernoulli_distribution<double> bernoulli(p_val);
@@ -152,6 +210,19 @@ Tensor& bernoulli_tensor_cpu_(Tensor& self, const Tensor& p_, Generator* gen) {
       AT_DISPATCH_FLOATING_TYPES(p_.scalar_type(), "bernoulli_tensor_cpu_p_", [&] {
         auto p = std::get<0>(expand_inplace(self, p_.to(kCPU)));
         using p_t = scalar_t;
+        if (self.is_contiguous() && p.is_contiguous()) {
+          std::pair<uint64_t, uint64_t> rng_engine_inputs;
+          {
+            // See Note [Acquire lock when using random generators]
+            std::lock_guard<std::mutex> lock(generator->mutex_);
+            rng_engine_inputs = generator->philox_engine_inputs(1);
+          }
+          bernoulli_tensor_philox_kernel<self_t, p_t, float>(
+              self.data_ptr<self_t>(), p.data_ptr<p_t>(), self.numel(), rng_engine_inputs);
+          return;
+        }
+        // See Note [Acquire lock when using random generators]
+        std::lock_guard<std::mutex> lock(generator->mutex_);
         CPU_tensor_apply2<self_t, p_t>(
           self, p, [generator](self_t& ret_val, p_t& p_val) {
             at::bernoulli_distribution<float> bernoulli(p_val);
@@ -175,6 +246,17 @@ Tensor& bernoulli_scalar_cpu_(Tensor& self, double p, Generator* gen) {
 #endif
   AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
     CPUGenerator* generator = get_generator_or_default<CPUGenerator>(gen, detail::getDefaultCPUGenerator());
+    if (self.is_contiguous()) {
+      std::pair<uint64_t, uint64_t> rng_engine_inputs;
+      {
+        // See Note [Acquire lock when using random generators]
+        std::lock_guard<std::mutex> lock(generator->mutex_);
+        rng_engine_inputs = generator->philox_engine_inputs(1);
+      }
+      bernoulli_scalar_philox_kernel<scalar_t, double>(
+          self.data_ptr<scalar_t>(), self.numel(), p, rng_engine_inputs);
+      return;
+    }
     // See Note [Acquire lock when using random generators]
     std::lock_guard<std::mutex> lock(generator->mutex_);
     CPU_tensor_apply1<scalar_t>(
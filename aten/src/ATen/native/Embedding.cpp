@@ -1,10 +1,13 @@
 #include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/RadixSortUtils.h>
 
 #include <cstring>
 #include <memory>
+#include <numeric>
 #include <sstream>
 #include <vector>
 
@@ -88,6 +91,58 @@ Tensor embedding_dense_backward_cpu(
   auto indices_data = indices_contig.data_ptr<int64_t>();
   int64_t numel = indices.numel();
 
+  auto grad = grad_.contiguous().view({numel, grad_.size(-1)});
+  auto grad_weight = at::zeros({num_weights, grad_.size(-1)}, grad_.options());
+
+  // Sort-and-segment path: radix-sort the indices, find the runs of equal
+  // values, and let each thread own a disjoint range of runs - every run
+  // writes exactly one grad_weight row, so the accumulation needs no
+  // synchronization and scales with cores instead of rescanning the whole
+  // input per vocabulary stripe. The frequency counts fall out for free as
+  // the run lengths.
+  if (numel > 1000 &&
+      (grad.scalar_type() == kFloat || grad.scalar_type() == kDouble)) {
+    std::vector<int64_t> keys(indices_data, indices_data + numel);
+    std::vector<int64_t> positions(numel);
+    std::vector<int64_t> keys_scratch(numel);
+    std::vector<int64_t> positions_scratch(numel);
+    std::vector<int64_t> starts(numel + 1);
+    std::iota(positions.begin(), positions.end(), 0);
+    radix_sort_pairs_parallel(keys.data(), positions.data(), numel,
+        num_weights - 1, keys_scratch.data(), positions_scratch.data());
+    const int64_t n_runs =
+        segment_starts_parallel(keys.data(), numel, starts.data());
+
+    AT_DISPATCH_FLOATING_TYPES(grad.scalar_type(), "embedding_backward", [&] {
+      const int64_t stride = grad_.size(-1);
+      const scalar_t* grad_ptr = grad.data_ptr<scalar_t>();
+      scalar_t* grad_weight_ptr = grad_weight.data_ptr<scalar_t>();
+      int64_t grain_size = std::max((int64_t)1,
+          at::internal::GRAIN_SIZE / std::max((int64_t)1, stride));
+      at::parallel_for(0, n_runs, grain_size, [&](int64_t run_begin, int64_t run_end) {
+        for (int64_t r = run_begin; r < run_end; r++) {
+          const int64_t k = keys[starts[r]];
+          if (k == padding_idx) {
+            continue;
+          }
+          scalar_t* out_row = grad_weight_ptr + k * stride;
+          for (int64_t j = starts[r]; j < starts[r + 1]; j++) {
+            accumulate_values_row<scalar_t>(
+                stride, grad_ptr + positions[j] * stride, out_row);
+          }
+          if (scale_grad_by_freq) {
+            const scalar_t scale =
+                scalar_t(1.0) / (starts[r + 1] - starts[r]);
+            for (int64_t d = 0; d < stride; d++) {
+              out_row[d] *= scale;
+            }
+          }
+        }
+      });
+    });
+    return grad_weight;
+  }
+
   std::unique_ptr<int64_t[]> counts;
   if (scale_grad_by_freq) {
     counts.reset(new int64_t[num_weights]);
@@ -99,9 +154,6 @@ Tensor embedding_dense_backward_cpu(
     }
   }
 
-  auto grad = grad_.contiguous().view({numel, grad_.size(-1)});
-  auto grad_weight = at::zeros({num_weights, grad_.size(-1)}, grad_.options());
-
   auto parallel_section = [&](int64_t start, int64_t end) {
     for (int64_t i = 0; i < numel; i++) {
       if (indices_data[i] != padding_idx) {
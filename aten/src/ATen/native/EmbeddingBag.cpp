@@ -41,6 +41,51 @@ bool isFastPathIndexSelectScale(const Tensor& src, const Tensor& scale, Tensor&
   return src.scalar_type() == kFloat && src.stride(1) == 1 && output.stride(1) == 1 && scale.stride(0) == 1;
 }
 
+// Note [Parallel EmbeddingBag fast path]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The caffe2 perf kernel used on the fp32/int64 fast path accumulates rows
+// with vectorized (AVX2 where available) code and software-prefetches the
+// next row, but it walks all bags serially. Since bags are independent, we
+// partition them across at::parallel_for workers and run the kernel on each
+// slice. The kernel requires offsets rebased to its slice's first index, so
+// each worker builds a small rebased copy of its offsets; that cost is
+// negligible next to the row gathers. The grain is in bags: large enough to
+// amortize the dispatch, small enough to balance skewed bag lengths.
+constexpr int64_t kEmbeddingBagParallelGrain = 64;
+
+void parallel_embedding_lookup_idx(
+    int64_t block_size,
+    int64_t output_size,
+    int64_t index_size,
+    int64_t data_size,
+    const float* input,
+    const int64_t* indices,
+    const int64_t* offsets,
+    const float* weights,
+    float* out) {
+  at::parallel_for(
+      0, output_size, kEmbeddingBagParallelGrain, [&](int64_t begin, int64_t end) {
+        const int64_t start = offsets[begin];
+        const int64_t stop = (end == output_size) ? index_size : offsets[end];
+        std::vector<int64_t> rebased_offsets(offsets + begin, offsets + end);
+        for (auto& offset : rebased_offsets) {
+          offset -= start;
+        }
+        caffe2::EmbeddingLookupIdx(
+            /*block_size=*/block_size,
+            /*output_size=*/end - begin,
+            /*index_size=*/stop - start,
+            /*data_size=*/data_size,
+            /*input=*/input,
+            /*indices=*/indices + start,
+            /*offsets=*/rebased_offsets.data(),
+            /*weights=*/weights == nullptr ? nullptr : weights + start,
+            /*scale_bias=*/nullptr,
+            /*normalize_by_lengths=*/false,
+            /*out=*/out + begin * block_size);
+      });
+}
+
 // This function combines index_select (using select_indices as the index) and
 // index_add (using add_indices as the index), without creating an intermediary
 // tensor to hold the selected embeddings
@@ -81,7 +126,8 @@ void index_select_add<float>(const Tensor &select_indices,
   auto output_data = output.data_ptr<float>();
 
   if (isFastPathIndexSelect(src, output)) {
-    caffe2::EmbeddingLookupIdx(
+    // See Note [Parallel EmbeddingBag fast path]
+    parallel_embedding_lookup_idx(
       /*block_size=*/ddim,
       /*output_size=*/offsets.numel(),
       /*index_size=*/select_indices.numel(),
@@ -90,8 +136,6 @@ void index_select_add<float>(const Tensor &select_indices,
       /*indices=*/select_indices_data,
       /*offsets=*/offsets.data_ptr<int64_t>(),
       /*weights=*/nullptr,
-      /*scale_bias=*/nullptr,
-      /*normalize_by_lengths=*/false,
       /*out=*/output_data
     );
   } else {
@@ -160,7 +204,8 @@ void index_select_scale_add<float>(const Tensor &select_indices,
   auto output_data = output.data_ptr<float>();
 
   if (isFastPathIndexSelectScale(src, scale, output)) {
-    caffe2::EmbeddingLookupIdx(
+    // See Note [Parallel EmbeddingBag fast path]
+    parallel_embedding_lookup_idx(
       /*block_size=*/ddim,
       /*output_size=*/offsets.numel(),
       /*index_size=*/select_indices.numel(),
@@ -169,8 +214,6 @@ void index_select_scale_add<float>(const Tensor &select_indices,
       /*indices=*/select_indices_data,
       /*offsets=*/offsets.data_ptr<int64_t>(),
       /*weights=*/scale_data,
-      /*scale_bias=*/nullptr,
-      /*normalize_by_lengths=*/false,
       /*out=*/output_data
     );
   } else {
@@ -0,0 +1,139 @@
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
+
+namespace at {
+namespace native {
+
+// The _foreach_* family collapses per-parameter loops (optimizer steps,
+// EMA updates) into a single dispatch and a single parallel region: the
+// tensors in the list are distributed over the intra-op thread pool and
+// the per-tensor op runs serially inside each task.  These generic
+// implementations fan out to the regular per-tensor ops; a backend with a
+// fused multi-tensor kernel can take over the corresponding entries in
+// native_functions.yaml later.
+
+namespace {
+
+void check_foreach_api_restrictions(TensorList tensors) {
+  TORCH_CHECK(tensors.size() > 0, "Tensor list must have at least one tensor.");
+}
+
+void check_foreach_api_restrictions(
+    TensorList tensors,
+    TensorList tensor1,
+    TensorList tensor2) {
+  check_foreach_api_restrictions(tensors);
+  TORCH_CHECK(
+      tensors.size() == tensor1.size() && tensors.size() == tensor2.size(),
+      "Tensor lists must have the same number of tensors, got ",
+      tensors.size(), ", ", tensor1.size(), " and ", tensor2.size());
+}
+
+template <typename Op>
+std::vector<Tensor> foreach_map(TensorList tensors, const Op& op) {
+  std::vector<Tensor> result(tensors.size());
+  at::parallel_for(0, tensors.size(), 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      result[i] = op(i);
+    }
+  });
+  return result;
+}
+
+template <typename Op>
+void foreach_apply_(size_t ntensors, const Op& op) {
+  at::parallel_for(0, ntensors, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      op(i);
+    }
+  });
+}
+
+} // namespace
+
+std::vector<Tensor> _foreach_add(TensorList tensors, Scalar scalar) {
+  check_foreach_api_restrictions(tensors);
+  return foreach_map(tensors, [&](int64_t i) { return tensors[i].add(scalar); });
+}
+
+void _foreach_add_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  foreach_apply_(self.size(), [&](int64_t i) { self[i].add_(scalar); });
+}
+
+std::vector<Tensor> _foreach_sub(TensorList tensors, Scalar scalar) {
+  check_foreach_api_restrictions(tensors);
+  return foreach_map(tensors, [&](int64_t i) { return tensors[i].sub(scalar); });
+}
+
+void _foreach_sub_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  foreach_apply_(self.size(), [&](int64_t i) { self[i].sub_(scalar); });
+}
+
+std::vector<Tensor> _foreach_mul(TensorList tensors, Scalar scalar) {
+  check_foreach_api_restrictions(tensors);
+  return foreach_map(tensors, [&](int64_t i) { return tensors[i].mul(scalar); });
+}
+
+void _foreach_mul_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  foreach_apply_(self.size(), [&](int64_t i) { self[i].mul_(scalar); });
+}
+
+std::vector<Tensor> _foreach_div(TensorList tensors, Scalar scalar) {
+  check_foreach_api_restrictions(tensors);
+  return foreach_map(tensors, [&](int64_t i) { return tensors[i].div(scalar); });
+}
+
+void _foreach_div_(TensorList self, Scalar scalar) {
+  check_foreach_api_restrictions(self);
+  foreach_apply_(self.size(), [&](int64_t i) { self[i].div_(scalar); });
+}
+
+std::vector<Tensor> _foreach_addcmul(
+    TensorList tensors,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(tensors, tensor1, tensor2);
+  return foreach_map(tensors, [&](int64_t i) {
+    return tensors[i].addcmul(tensor1[i], tensor2[i], value);
+  });
+}
+
+void _foreach_addcmul_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(self, tensor1, tensor2);
+  foreach_apply_(self.size(), [&](int64_t i) {
+    self[i].addcmul_(tensor1[i], tensor2[i], value);
+  });
+}
+
+std::vector<Tensor> _foreach_addcdiv(
+    TensorList tensors,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(tensors, tensor1, tensor2);
+  return foreach_map(tensors, [&](int64_t i) {
+    return tensors[i].addcdiv(tensor1[i], tensor2[i], value);
+  });
+}
+
+void _foreach_addcdiv_(
+    TensorList self,
+    TensorList tensor1,
+    TensorList tensor2,
+    Scalar value) {
+  check_foreach_api_restrictions(self, tensor1, tensor2);
+  foreach_apply_(self.size(), [&](int64_t i) {
+    self[i].addcdiv_(tensor1[i], tensor2[i], value);
+  });
+}
+
+}} // namespace at::native
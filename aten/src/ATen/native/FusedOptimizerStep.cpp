@@ -0,0 +1,183 @@
+#include <ATen/native/FusedOptimizerStep.h>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(fused_sgd_stub);
+DEFINE_DISPATCH(fused_adam_stub);
+DEFINE_DISPATCH(fused_sparse_adagrad_stub);
+
+bool can_use_fused_step(const Tensor& tensor) {
+  if (!tensor.defined() || tensor.is_sparse() || !tensor.is_contiguous()) {
+    return false;
+  }
+  const auto type = tensor.scalar_type();
+  if (tensor.is_cuda()) {
+    return type == kHalf || type == kFloat || type == kDouble;
+  }
+  if (tensor.device().is_cpu()) {
+    return type == kFloat || type == kDouble;
+  }
+  return false;
+}
+
+namespace {
+
+// Checks that every list is either empty (an optional state buffer the
+// caller doesn't use) or elementwise compatible with `params`: same length,
+// same device and dtype, same number of elements, and eligible per
+// can_use_fused_step.
+void check_fused_step_inputs(
+    const char* name,
+    TensorList params,
+    std::initializer_list<TensorList> lists) {
+  TORCH_CHECK(!params.empty(), name, ": expected at least one parameter");
+  const auto& ref = params[0];
+  for (auto& list : lists) {
+    if (list.empty()) {
+      continue;
+    }
+    TORCH_CHECK(
+        list.size() == params.size(),
+        name, ": tensor lists must have matching lengths, got ",
+        list.size(), " and ", params.size());
+    for (size_t i = 0; i < list.size(); ++i) {
+      const auto& t = list[i];
+      TORCH_CHECK(
+          can_use_fused_step(t),
+          name, ": tensor ", i,
+          " is not eligible for a fused step (it must be a dense, contiguous "
+          "floating point tensor)");
+      TORCH_CHECK(
+          t.device() == ref.device() && t.scalar_type() == ref.scalar_type(),
+          name, ": expected all tensors to be on ", ref.device(), " with dtype ",
+          ref.scalar_type(), ", but tensor ", i, " is on ", t.device(),
+          " with dtype ", t.scalar_type());
+      TORCH_CHECK(
+          t.numel() == params[i].numel(),
+          name, ": tensor ", i, " has ", t.numel(),
+          " elements, but the corresponding parameter has ", params[i].numel());
+    }
+  }
+}
+
+// Shared validation of the two sparse-adagrad entry points; everything but
+// the state_sum shape is identical between them.
+void check_sparse_adagrad_inputs(
+    const char* name,
+    const Tensor& param,
+    const Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad_values) {
+  TORCH_CHECK(
+      param.device().is_cpu(),
+      name, ": only CPU tensors are supported");
+  TORCH_CHECK(
+      param.dim() == 2 && param.is_contiguous(),
+      name, ": param must be a contiguous 2-d tensor, got sizes ",
+      param.sizes());
+  TORCH_CHECK(
+      param.scalar_type() == kFloat || param.scalar_type() == kDouble,
+      name, ": only float and double params are supported, got ",
+      param.scalar_type());
+  TORCH_CHECK(
+      grad_values.dim() == 2 && grad_values.is_contiguous() &&
+          grad_values.size(1) == param.size(1),
+      name, ": grad_values must be a contiguous (nnz, ", param.size(1),
+      ") tensor, got sizes ", grad_values.sizes());
+  TORCH_CHECK(
+      indices.dim() == 1 && indices.scalar_type() == kLong &&
+          indices.numel() == grad_values.size(0),
+      name, ": indices must be a 1-d int64 tensor with one entry per "
+      "grad_values row, got sizes ", indices.sizes());
+  TORCH_CHECK(
+      state_sum.is_contiguous() &&
+          state_sum.scalar_type() == param.scalar_type() &&
+          grad_values.scalar_type() == param.scalar_type() &&
+          state_sum.device().is_cpu() && indices.device().is_cpu() &&
+          grad_values.device().is_cpu(),
+      name, ": state_sum and grad_values must be contiguous CPU tensors "
+      "with the param's dtype");
+}
+
+} // namespace
+
+void fused_sparse_adagrad_step(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad_values,
+    const FusedSparseAdagradParams& args) {
+  check_sparse_adagrad_inputs(
+      "fused_sparse_adagrad_step", param, state_sum, indices, grad_values);
+  TORCH_CHECK(
+      state_sum.sizes().equals(param.sizes()),
+      "fused_sparse_adagrad_step: state_sum must have the param's shape ",
+      param.sizes(), ", got ", state_sum.sizes());
+  fused_sparse_adagrad_stub(
+      param.device().type(), param, state_sum, indices, grad_values,
+      /*rowwise=*/false, args);
+}
+
+void fused_rowwise_sparse_adagrad_step(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad_values,
+    const FusedSparseAdagradParams& args) {
+  check_sparse_adagrad_inputs(
+      "fused_rowwise_sparse_adagrad_step", param, state_sum, indices, grad_values);
+  TORCH_CHECK(
+      state_sum.dim() == 1 && state_sum.size(0) == param.size(0),
+      "fused_rowwise_sparse_adagrad_step: state_sum must hold one scalar per "
+      "param row (", param.size(0), "), got sizes ", state_sum.sizes());
+  fused_sparse_adagrad_stub(
+      param.device().type(), param, state_sum, indices, grad_values,
+      /*rowwise=*/true, args);
+}
+
+void fused_sgd_step(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDParams& args) {
+  check_fused_step_inputs(
+      "fused_sgd_step", params, {params, grads, momentum_buffers});
+  TORCH_CHECK(
+      (args.momentum != 0) == !momentum_buffers.empty(),
+      "fused_sgd_step: momentum buffers must be passed iff momentum != 0");
+  fused_sgd_stub(
+      params[0].device().type(), params, grads, momentum_buffers, args);
+}
+
+void fused_adam_step(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    const FusedAdamParams& args) {
+  check_fused_step_inputs(
+      "fused_adam_step",
+      params,
+      {params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs});
+  TORCH_CHECK(
+      !exp_avgs.empty() && !exp_avg_sqs.empty(),
+      "fused_adam_step: exp_avgs and exp_avg_sqs are required");
+  TORCH_CHECK(
+      args.amsgrad == !max_exp_avg_sqs.empty(),
+      "fused_adam_step: max_exp_avg_sqs buffers must be passed iff amsgrad");
+  TORCH_CHECK(
+      args.bias_correction1 > 0 && args.bias_correction2 > 0,
+      "fused_adam_step: bias corrections must be positive, got ",
+      args.bias_correction1, " and ", args.bias_correction2);
+  fused_adam_stub(
+      params[0].device().type(),
+      params,
+      grads,
+      exp_avgs,
+      exp_avg_sqs,
+      max_exp_avg_sqs,
+      args);
+}
+
+}} // namespace at::native
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Fused multi-tensor optimizer steps.
+//
+// The C++ frontend optimizers (torch::optim::SGD, torch::optim::Adam) update
+// one parameter at a time; on CUDA that costs several kernel launches per
+// parameter, so for models with hundreds of small parameters the step is
+// dominated by launch latency.  The entry points below take whole parameter
+// groups at once and perform the update in a handful of launches (see
+// cuda/MultiTensorApply.cuh), or in a single vectorized pass per tensor on
+// CPU.
+//
+// All tensors in a call must be dense, contiguous, and live on the same
+// device with the same (supported) floating point dtype; the lists must
+// match element-wise (params[i], grads[i] and each state buffer i have the
+// same number of elements).  Callers are responsible for autograd: like the
+// NoGradGuard'ed updates they replace, these write through the tensor data
+// without recording anything.
+
+struct FusedSGDParams {
+  double lr;
+  double momentum;
+  double dampening;
+  double weight_decay;
+  bool nesterov;
+  // On the very first step the momentum buffer is seeded with the raw
+  // update instead of the dampened one, matching torch::optim::SGD.
+  bool first_step;
+};
+
+struct FusedAdamParams {
+  double lr;
+  double beta1;
+  double beta2;
+  double weight_decay;
+  double eps;
+  // 1 - beta^t, precomputed by the caller from its step counters.
+  double bias_correction1;
+  double bias_correction2;
+  bool amsgrad;
+};
+
+struct FusedSparseAdagradParams {
+  double lr; // the decayed rate for this step, precomputed by the caller
+  double eps;
+};
+
+using fused_sgd_fn = void (*)(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers, // empty iff momentum == 0
+    const FusedSGDParams& args);
+using fused_adam_fn = void (*)(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs, // empty iff !amsgrad
+    const FusedAdamParams& args);
+
+// Fused sparse-adagrad step for embedding gradients: takes the sparse
+// gradient's row indices and value rows directly and updates the touched
+// parameter and state rows in one parallel pass, instead of coalesce +
+// indexed state reads + scattered writes.  `indices` may contain
+// duplicates; duplicate rows are summed before the state update, so the
+// result matches coalescing first.  With `rowwise` set, state_sum holds a
+// single scalar per parameter row, updated with the mean of the squared
+// gradient row (like the caffe2 RowWiseSparseAdagrad op), which shrinks
+// the optimizer state of an (N, D) table from N*D to N floats.
+using fused_sparse_adagrad_fn = void (*)(
+    Tensor& param, // (N, D), contiguous
+    Tensor& state_sum, // (N, D) elementwise, (N,) rowwise
+    const Tensor& indices, // (nnz,), int64
+    const Tensor& grad_values, // (nnz, D), contiguous
+    bool rowwise,
+    const FusedSparseAdagradParams& args);
+
+DECLARE_DISPATCH(fused_sgd_fn, fused_sgd_stub);
+DECLARE_DISPATCH(fused_adam_fn, fused_adam_stub);
+DECLARE_DISPATCH(fused_sparse_adagrad_fn, fused_sparse_adagrad_stub);
+
+CAFFE2_API void fused_sgd_step(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDParams& args);
+
+CAFFE2_API void fused_adam_step(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    const FusedAdamParams& args);
+
+CAFFE2_API void fused_sparse_adagrad_step(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad_values,
+    const FusedSparseAdagradParams& args);
+
+CAFFE2_API void fused_rowwise_sparse_adagrad_step(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad_values,
+    const FusedSparseAdagradParams& args);
+
+// True if `tensor` may participate in a fused step: defined, dense,
+// contiguous, and of a floating point type the kernels for its device
+// support (float/double on CPU; additionally half on CUDA).
+CAFFE2_API bool can_use_fused_step(const Tensor& tensor);
+
+}} // namespace at::native
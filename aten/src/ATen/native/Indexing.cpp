@@ -54,6 +54,8 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/ExpandUtils.h>
+#include <ATen/LegacyTHFunctionsCPU.h>
+#include <ATen/native/RadixSortUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/core/EnableNamedTensor.h>
 
@@ -67,6 +69,10 @@ namespace at { namespace native {
 DEFINE_DISPATCH(index_stub);
 DEFINE_DISPATCH(index_put_stub);
 DEFINE_DISPATCH(index_put_accum_stub);
+DEFINE_DISPATCH(gather_stub);
+DEFINE_DISPATCH(scatter_add_stub);
+DEFINE_DISPATCH(index_select_stub);
+DEFINE_DISPATCH(masked_fill_stub);
 REGISTER_NO_CPU_DISPATCH(index_put_accum_stub, index_put_accum_fn);
 
 static bool all_strides_match(TensorList tensors) {
@@ -314,6 +320,61 @@ Tensor index_copy(const Tensor & self, int64_t dim, const Tensor & index, const
   return self.clone(at::MemoryFormat::Preserve).index_copy_(dim, index, source);
 }
 
+Tensor & index_add_cpu_(Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
+  dim = maybe_wrap_dim(dim, self.dim());
+  const int64_t n = index.numel();
+  // Sort-and-segment fast path: radix-sort the indices so that every run of
+  // equal values owns exactly one row of self, then accumulate the runs in
+  // parallel without synchronization. The serial TH kernel remains the
+  // fallback for the cases the sort does not cover.
+  bool slices_match = self.dim() >= 1 && source.dim() == self.dim() &&
+      std::equal(self.sizes().begin() + 1, self.sizes().end(),
+                 source.sizes().begin() + 1);
+  if (dim == 0 && n > 1000 && slices_match && source.size(0) == n &&
+      index.scalar_type() == kLong &&
+      (self.scalar_type() == kFloat || self.scalar_type() == kDouble) &&
+      source.scalar_type() == self.scalar_type() &&
+      self.is_contiguous() && source.is_contiguous()) {
+    auto index_contig = index.contiguous();
+    const int64_t* index_data = index_contig.data_ptr<int64_t>();
+    std::vector<int64_t> keys(n);
+    std::vector<int64_t> positions(n);
+    std::vector<int64_t> keys_scratch(n);
+    std::vector<int64_t> positions_scratch(n);
+    std::vector<int64_t> starts(n + 1);
+    for (int64_t i = 0; i < n; i++) {
+      const int64_t idx = index_data[i];
+      TORCH_CHECK_INDEX(idx >= 0 && idx < self.size(0),
+          "index out of range in self");
+      keys[i] = idx;
+      positions[i] = i;
+    }
+    radix_sort_pairs_parallel(keys.data(), positions.data(), n,
+        self.size(0) - 1, keys_scratch.data(), positions_scratch.data());
+    const int64_t n_runs =
+        segment_starts_parallel(keys.data(), n, starts.data());
+
+    AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "index_add_", [&] {
+      const int64_t stride = self.numel() / self.size(0);
+      const scalar_t* source_ptr = source.data_ptr<scalar_t>();
+      scalar_t* self_ptr = self.data_ptr<scalar_t>();
+      int64_t grain_size = std::max((int64_t)1,
+          at::internal::GRAIN_SIZE / std::max((int64_t)1, stride));
+      at::parallel_for(0, n_runs, grain_size, [&](int64_t run_begin, int64_t run_end) {
+        for (int64_t r = run_begin; r < run_end; r++) {
+          scalar_t* self_row = self_ptr + keys[starts[r]] * stride;
+          for (int64_t j = starts[r]; j < starts[r + 1]; j++) {
+            accumulate_values_row<scalar_t>(
+                stride, source_ptr + positions[j] * stride, self_row);
+          }
+        }
+      });
+    });
+    return self;
+  }
+  return legacy::cpu::_th_index_add_(self, dim, index, source);
+}
+
 Tensor index_add(const Tensor & self, int64_t dim, const Tensor & index, const Tensor & source) {
   return self.clone(at::MemoryFormat::Preserve).index_add_(dim, index, source);
 }
@@ -350,6 +411,49 @@ Tensor masked_scatter(const Tensor & self, const Tensor & mask, const Tensor & s
   return _self.clone(at::MemoryFormat::Contiguous).masked_scatter_(_mask, source);
 }
 
+static Tensor & masked_fill_impl_cpu(Tensor & self, const Tensor & mask, Scalar value) {
+  if (mask.dtype() == at::ScalarType::Byte) {
+    AT_WARN("masked_fill_ received a mask with dtype torch.uint8, this behavior is now deprecated," \
+            "please use a mask with dtype torch.bool instead.");
+  } else {
+    TORCH_CHECK(mask.dtype() == at::ScalarType::Bool,
+        "masked_fill only supports boolean masks, but got dtype ", mask.dtype());
+  }
+  auto iter = TensorIterator();
+  iter.dont_compute_common_dtype();
+  iter.dont_resize_outputs();
+  iter.add_output(self);
+  iter.add_input(self);
+  iter.add_input(mask);
+  iter.build();
+  masked_fill_stub(iter.device_type(), iter, value);
+  return self;
+}
+
+Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, Scalar value) {
+#ifdef BUILD_NAMEDTENSOR
+  auto maybe_outnames = namedinference::broadcast_to_outnames(self, mask, "masked_fill_");
+#endif
+  masked_fill_impl_cpu(self, mask, value);
+#ifdef BUILD_NAMEDTENSOR
+  namedinference::propagate_names_if_nonempty(self, maybe_outnames);
+#endif
+  return self;
+}
+
+Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, const Tensor & value) {
+#ifdef BUILD_NAMEDTENSOR
+  auto maybe_outnames = namedinference::broadcast_to_outnames(self, mask, "masked_fill_");
+#endif
+  TORCH_CHECK(value.dim() == 0, "masked_fill_ only supports a 0-dimensional value tensor, but got tensor "
+      "with ", value.dim(), " dimension(s).");
+  masked_fill_impl_cpu(self, mask, value.item());
+#ifdef BUILD_NAMEDTENSOR
+  namedinference::propagate_names_if_nonempty(self, maybe_outnames);
+#endif
+  return self;
+}
+
 Tensor masked_fill(const Tensor & self, const Tensor & mask, Scalar source) {
   Tensor result;
 #ifdef BUILD_NAMEDTENSOR
@@ -421,4 +525,98 @@ std::vector<Tensor> nonzero_numpy(const Tensor& self) {
   return self.nonzero().unbind(1);
 }
 
+// The parallel kernels below only handle the common dense case: contiguous
+// non-scalar tensors with a long index of the expected shape. Everything
+// else (legacy scalar handling, indexes smaller than self/src for scatter,
+// non-contiguous operands, unsupported dtypes) takes the TH path, which
+// keeps the old behavior bit for bit.
+static bool can_use_gather_scatter_fast_path(const Tensor& self, const Tensor& index) {
+  return self.dim() > 0 && index.dim() == self.dim() &&
+      index.scalar_type() == kLong && self.is_contiguous() &&
+      self.scalar_type() != kHalf && self.scalar_type() != kBFloat16;
+}
+
+Tensor& gather_out_cpu(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index, bool sparse_grad) {
+  dim = maybe_wrap_dim(dim, self.dim());
+  if (!can_use_gather_scatter_fast_path(self, index) ||
+      result.scalar_type() != self.scalar_type()) {
+    return legacy::cpu::_th_gather_out(result, self, dim, index);
+  }
+  for (int64_t d = 0; d < self.dim(); ++d) {
+    TORCH_CHECK(d == dim || index.size(d) == self.size(d),
+        "Expected index ", index.sizes(), " and self ", self.sizes(),
+        " to have the same size apart from dimension ", dim);
+  }
+  result.resize_(index.sizes());
+  if (index.numel() == 0) {
+    return result;
+  }
+  auto index_ = index.contiguous();
+  if (result.is_contiguous()) {
+    gather_stub(kCPU, result, self, dim, index_);
+  } else {
+    Tensor tmp = at::empty(index.sizes(), result.options());
+    gather_stub(kCPU, tmp, self, dim, index_);
+    result.copy_(tmp);
+  }
+  return result;
+}
+
+Tensor gather_cpu(const Tensor& self, int64_t dim, const Tensor& index, bool sparse_grad) {
+  Tensor result = at::empty({0}, self.options());
+  return gather_out_cpu(result, self, dim, index, sparse_grad);
+}
+
+Tensor& scatter_add_cpu_(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  dim = maybe_wrap_dim(dim, self.dim());
+  if (index.numel() == 0) {
+    return self;
+  }
+  bool fast_path = can_use_gather_scatter_fast_path(self, index) &&
+      src.dim() == self.dim() && index.sizes().equals(src.sizes()) &&
+      src.scalar_type() == self.scalar_type();
+  if (fast_path) {
+    for (int64_t d = 0; d < self.dim(); ++d) {
+      if (d != dim && index.size(d) != self.size(d)) {
+        fast_path = false;
+        break;
+      }
+    }
+  }
+  if (!fast_path) {
+    return legacy::cpu::_th_scatter_add_(self, dim, index, src);
+  }
+  scatter_add_stub(kCPU, self, dim, index.contiguous(), src.contiguous());
+  return self;
+}
+
+Tensor& index_select_out_cpu(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index) {
+  dim = maybe_wrap_dim(dim, self.dim());
+  if (self.dim() == 0 || index.dim() > 1 || index.scalar_type() != kLong ||
+      !self.is_contiguous() || result.scalar_type() != self.scalar_type() ||
+      self.scalar_type() == kHalf || self.scalar_type() == kBFloat16) {
+    return legacy::cpu::_th_index_select_out(result, self, dim, index);
+  }
+  auto new_size = self.sizes().vec();
+  new_size[dim] = index.numel();
+  result.resize_(new_size);
+  if (result.numel() == 0 && index.numel() == 0) {
+    return result;
+  }
+  auto index_ = index.contiguous();
+  if (result.is_contiguous()) {
+    index_select_stub(kCPU, result, self, dim, index_);
+  } else {
+    Tensor tmp = at::empty(new_size, result.options());
+    index_select_stub(kCPU, tmp, self, dim, index_);
+    result.copy_(tmp);
+  }
+  return result;
+}
+
+Tensor index_select_cpu(const Tensor& self, int64_t dim, const Tensor& index) {
+  Tensor result = at::empty({0}, self.options());
+  return index_select_out_cpu(result, self, dim, index);
+}
+
 }} // at::native
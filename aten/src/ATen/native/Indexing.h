@@ -15,8 +15,20 @@ using index_fn = void(*)(TensorIterator &, IntArrayRef indexed_sizes, IntArrayRe
 using index_put_fn = void(*)(TensorIterator &, IntArrayRef indexed_sizes, IntArrayRef indexed_strides, bool accumulate);
 using index_put_accum_fn = void(*)(Tensor &, TensorList , const Tensor &, bool unsafe);
 
+// The dimension-collapsed fast paths below all operate on contiguous
+// tensors; the callers are responsible for shape checks and fallbacks.
+using gather_fn = void(*)(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index);
+using scatter_add_fn = void(*)(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src);
+using index_select_fn = void(*)(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index);
+
+using masked_fill_fn = void(*)(TensorIterator &, Scalar scalar);
+
 DECLARE_DISPATCH(index_fn, index_stub);
 DECLARE_DISPATCH(index_put_fn, index_put_stub);
 DECLARE_DISPATCH(index_put_accum_fn, index_put_accum_stub);
+DECLARE_DISPATCH(gather_fn, gather_stub);
+DECLARE_DISPATCH(scatter_add_fn, scatter_add_stub);
+DECLARE_DISPATCH(index_select_fn, index_select_stub);
+DECLARE_DISPATCH(masked_fill_fn, masked_fill_stub);
 
 }} // namespace at::native
@@ -8,46 +8,7 @@ namespace at { namespace native {
 
 // Methods
 
-Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, Scalar value) {
-#ifdef BUILD_NAMEDTENSOR
-  auto maybe_outnames = namedinference::broadcast_to_outnames(self, mask, "masked_fill_");
-#endif
-  // As we dispatch on self and TH is type-checked, we need different definitions.
-  // This can be fixed by moving to ATen.
-  if (mask.dtype() == at::ScalarType::Byte) {
-    AT_WARN("masked_fill_ received a mask with dtype torch.uint8, this behavior is now deprecated," \
-            "please use a mask with dtype torch.bool instead.");
-    legacy::cpu::_th_masked_fill_(self, mask, value);
-  } else {
-    legacy::cpu::_th_masked_fill_bool_(self, mask, value);
-  }
-#ifdef BUILD_NAMEDTENSOR
-  namedinference::propagate_names_if_nonempty(self, maybe_outnames);
-#endif
-  return self;
-}
-
-Tensor & masked_fill__cpu(Tensor& self, const Tensor & mask, const Tensor & value) {
-#ifdef BUILD_NAMEDTENSOR
-  auto maybe_outnames = namedinference::broadcast_to_outnames(self, mask, "masked_fill_");
-#endif
-
-  TORCH_CHECK(value.dim() == 0, "masked_fill_ only supports a 0-dimensional value tensor, but got tensor "
-      "with ", value.dim(), " dimension(s).");
-  // As we dispatch on self and TH is type-checked, we need different definitions.
-  // This can be fixed by moving to ATen.
-  if (mask.dtype() == at::ScalarType::Byte) {
-    AT_WARN("masked_fill_ received a mask with dtype torch.uint8, this behavior is now deprecated," \
-            "please use a mask with dtype torch.bool instead.");
-    legacy::cpu::_th_masked_fill_(self, mask, value.item());
-  } else {
-    legacy::cpu::_th_masked_fill_bool_(self, mask, value.item());
-  }
-#ifdef BUILD_NAMEDTENSOR
-  namedinference::propagate_names_if_nonempty(self, maybe_outnames);
-#endif
-  return self;
-}
+// masked_fill_ lives in Indexing.cpp now, on top of TensorIterator.
 
 Tensor & masked_scatter__cpu(Tensor& self, const Tensor & mask, const Tensor & source) {
   // As we dispatch on self and TH is type-checked, we need different definitions.
@@ -89,12 +50,4 @@ Tensor argsort(const Tensor & self, int64_t dim, bool descending) {
   return std::get<1>(at::sort(self, dim, descending));
 }
 
-Tensor & gather_out_cpu(Tensor & result, const Tensor & self, int64_t dim, const Tensor & index, bool sparse_grad) {
-  return legacy::cpu::_th_gather_out(result, self, dim, index);
-}
-
-Tensor gather_cpu(const Tensor & self, int64_t dim, const Tensor & index, bool sparse_grad) {
-  return legacy::cpu::_th_gather(self, dim, index);
-}
-
 }} // namespace at::native
@@ -1,6 +1,8 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/WrapDimUtilsMulti.h>
+#include <ATen/core/grad_mode.h>
+#include <ATen/native/Linear.h>
 
 #include <array>
 #include <cctype>
@@ -27,6 +29,78 @@ Tensor linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
   return output;
 }
 
+DEFINE_DISPATCH(linear_epilogue_stub);
+
+namespace {
+
+// The fused epilogue writes the output in place without recording anything
+// for autograd, so it only runs when no operand needs a gradient; training
+// takes the composite fallback below.
+bool can_use_fused_linear(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  auto dense_cpu_float = [](const Tensor& t) {
+    return t.device().is_cpu() && t.layout() == kStrided &&
+        (t.scalar_type() == kFloat || t.scalar_type() == kDouble);
+  };
+  if (!dense_cpu_float(input) || !dense_cpu_float(weight) ||
+      input.dim() < 2 || weight.dim() != 2 ||
+      weight.scalar_type() != input.scalar_type()) {
+    return false;
+  }
+  if (bias.defined() &&
+      (!dense_cpu_float(bias) || bias.dim() != 1 || !bias.is_contiguous() ||
+       bias.size(0) != weight.size(0) ||
+       bias.scalar_type() != input.scalar_type())) {
+    return false;
+  }
+  auto needs_grad = [](const Tensor& t) {
+    return t.defined() && t.is_variable() && t.requires_grad();
+  };
+  return !(at::GradMode::is_enabled() &&
+           (needs_grad(input) || needs_grad(weight) || needs_grad(bias)));
+}
+
+// gemm, then bias add and activation folded into one pass over the output
+// instead of two. The bias is deliberately kept out of the gemm (no addmm)
+// so the epilogue applies it together with the activation.
+Tensor linear_with_epilogue(const Tensor& input, const Tensor& weight,
+    const Tensor& bias, LinearEpilogue epilogue) {
+  Tensor output = at::matmul(input, weight.t());
+  if (!output.is_contiguous()) {
+    output = output.contiguous();
+  }
+  linear_epilogue_stub(kCPU, output, bias, epilogue);
+  return output;
+}
+
+} // anonymous namespace
+
+// Fused linear+activation variants targeted by the JIT (see
+// FuseLinearActivation in torch/csrc/jit/passes/fuse_linear.cpp). The
+// mkldnn inner_product binding in this tree takes no post-op attributes,
+// so mkldnn inputs go through the composite fallback like everything else
+// that does not fit the fused CPU path.
+
+Tensor linear_relu(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  if (!input.is_mkldnn() && can_use_fused_linear(input, weight, bias)) {
+    return linear_with_epilogue(input, weight, bias, LinearEpilogue::Relu);
+  }
+  return at::relu(at::native::linear(input, weight, bias));
+}
+
+Tensor linear_gelu(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  if (!input.is_mkldnn() && can_use_fused_linear(input, weight, bias)) {
+    return linear_with_epilogue(input, weight, bias, LinearEpilogue::Gelu);
+  }
+  return at::gelu(at::native::linear(input, weight, bias));
+}
+
+Tensor linear_sigmoid(const Tensor& input, const Tensor& weight, const Tensor& bias) {
+  if (!input.is_mkldnn() && can_use_fused_linear(input, weight, bias)) {
+    return linear_with_epilogue(input, weight, bias, LinearEpilogue::Sigmoid);
+  }
+  return at::sigmoid(at::native::linear(input, weight, bias));
+}
+
 // sumproduct_pair computes `(left*right).sum(sumdims)` by means of permutation and
 // batch matrix multiplication
 // its main purpose is to provide a pairwise reduction for einsum
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Activation applied by the fused bias+activation epilogue of the linear
+// fast path (see linear_relu/linear_gelu/linear_sigmoid in Linear.cpp).
+enum class LinearEpilogue { Relu, Gelu, Sigmoid };
+
+// Applies output = act(output + bias) in a single pass. output is contiguous
+// and treated as (rows, out_features); bias is either undefined or a
+// contiguous 1-d tensor with out_features elements of the same dtype.
+using linear_epilogue_fn =
+    void (*)(Tensor& output, const Tensor& bias, LinearEpilogue epilogue);
+DECLARE_DISPATCH(linear_epilogue_fn, linear_epilogue_stub);
+
+}} // namespace at::native
@@ -2,6 +2,7 @@
 #include <ATen/ExpandUtils.h>
 #include <ATen/Dispatch.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/native/LinearAlgebra.h>
 #include <ATen/native/LinearAlgebraUtils.h>
 #include <ATen/TensorUtils.h>
 #include <ATen/Parallel.h>
@@ -17,6 +18,8 @@
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(small_gemm_stub);
+
 // Helper function for det methods.
 // For pivoted LU factorization A = P * L * U. Since we always have det(L) = 1,
 // det(P) = \pm 1, this method returns a 3-tuple:
@@ -245,8 +248,19 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
     return (t.stride(2) == 1 && t.stride(1) >= t.size(2))
             || (t.stride(1) == 1 && t.stride(2) >= t.size(1));
   };
+  // The MKL batched gemm below addresses each batch item through a pointer
+  // array, so arbitrary (including broadcast/zero) batch strides are fine;
+  // only the individual matrices have to be row-major.
+  auto batch_items_row_major = [&](const Tensor& t) {
+    return t.stride(2) == 1 && t.stride(1) >= t.size(2);
+  };
 
-  if (contraction_size * res_rows * res_cols < 400) {
+  if (use_small_gemm(batch1, batch2) && self_or_result.is_contiguous() &&
+      self_or_result.scalar_type() == batch1.scalar_type()) {
+    // Vectorized microkernel: BLAS per-matrix dispatch overhead dominates at
+    // these sizes, and the batch is parallelized inside the kernel.
+    small_gemm_stub(kCPU, self_or_result, batch1, batch2, beta, alpha, is_bmm_out);
+  } else if (contraction_size * res_rows * res_cols < 400) {
     if (is_bmm_out) {
       AT_DISPATCH_ALL_TYPES(batch1.scalar_type(), "bmm", [&] {
           baddbmm_cpu_kernel<scalar_t, true>(self_or_result, batch1, batch2, beta, alpha);
@@ -259,17 +273,44 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
   } else if (at::hasMKL() && at::native::is_floating_point(self_or_result)
             && batch_items_contiguous_or_transposed(batch1)
             && batch_items_contiguous_or_transposed(batch2)
-            && self_or_result.is_contiguous()) {
+            && batch_items_row_major(self_or_result)) {
     at::native::_baddbmm_mkl_(self_or_result, batch1, batch2, beta, alpha);
   } else { // split along batch dimension
+    // When the individual gemm is too small to use multiple cores itself,
+    // dispatch the independent batch slices across threads instead of
+    // looping serially; large slices keep the serial loop so the gemm can
+    // thread internally without oversubscription.
+    const bool parallelize_batch = bs > 1 &&
+        res_rows * res_cols * contraction_size <= 64 * internal::GRAIN_SIZE;
     if (is_bmm_out) {
-      for (int64_t b = 0; b < bs; b++) {
-        auto r = self_or_result.select(0, b);
-        legacy::cpu::_th_mm_out(r, batch1.select(0, b), batch2.select(0, b));
+      if (parallelize_batch) {
+        at::parallel_for(0, bs, 1, [&](int64_t b_begin, int64_t b_end) {
+          NoGradGuard no_grad;
+          AutoNonVariableTypeMode non_variable_type_mode;
+          for (int64_t b = b_begin; b < b_end; b++) {
+            auto r = self_or_result.select(0, b);
+            legacy::cpu::_th_mm_out(r, batch1.select(0, b), batch2.select(0, b));
+          }
+        });
+      } else {
+        for (int64_t b = 0; b < bs; b++) {
+          auto r = self_or_result.select(0, b);
+          legacy::cpu::_th_mm_out(r, batch1.select(0, b), batch2.select(0, b));
+        }
       }
     } else {
-      for (int64_t b = 0; b < bs; b++) {
-        self_or_result.select(0, b).addmm_(batch1.select(0, b), batch2.select(0, b), beta, alpha);
+      if (parallelize_batch) {
+        at::parallel_for(0, bs, 1, [&](int64_t b_begin, int64_t b_end) {
+          NoGradGuard no_grad;
+          AutoNonVariableTypeMode non_variable_type_mode;
+          for (int64_t b = b_begin; b < b_end; b++) {
+            self_or_result.select(0, b).addmm_(batch1.select(0, b), batch2.select(0, b), beta, alpha);
+          }
+        });
+      } else {
+        for (int64_t b = 0; b < bs; b++) {
+          self_or_result.select(0, b).addmm_(batch1.select(0, b), batch2.select(0, b), beta, alpha);
+        }
       }
     }
   }
@@ -362,6 +403,21 @@ Tensor matmul(
     return has_out ? at::mm_out(out, tensor1.unsqueeze(0), tensor2).squeeze_(0)
                    : tensor1.unsqueeze(0).mm(tensor2).squeeze_(0);
   } else if (dim_tensor1 == 2 && dim_tensor2 == 2) {
+    // Small-matrix fast path: skip the BLAS-backed mm when its call overhead
+    // would dominate. matmul is a composite w.r.t. autograd, so the raw
+    // kernel is only usable when no gradient needs to be recorded; shape
+    // mismatches fall through to mm for its error message.
+    if (!has_out && use_small_gemm(tensor1, tensor2) &&
+        tensor1.size(1) == tensor2.size(0) &&
+        !(at::GradMode::is_enabled() &&
+          ((tensor1.is_variable() && tensor1.requires_grad()) ||
+           (tensor2.is_variable() && tensor2.requires_grad())))) {
+      Tensor result = at::empty({tensor1.size(0), tensor2.size(1)}, tensor1.options());
+      small_gemm_stub(
+          kCPU, result.unsqueeze(0), tensor1.unsqueeze(0), tensor2.unsqueeze(0),
+          /*beta=*/0, /*alpha=*/1, /*is_bmm=*/true);
+      return result;
+    }
     return has_out ? at::mm_out(out, tensor1, tensor2) : tensor1.mm(tensor2);
   } else if (dim_tensor1 >= 3 && (dim_tensor2 == 1 || dim_tensor2 == 2)) {
     // optimization: use mm instead of bmm by folding tensor1's batch into
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// Largest m/n/k handled by the small-GEMM microkernel. Below this size the
+// fixed cost of a BLAS call (dispatch, threading setup, packing heuristics)
+// dominates the arithmetic, so a register-blocked vec256 loop wins.
+constexpr int64_t kSmallGemmMaxDim = 64;
+
+// Batched C = beta * C + alpha * A @ B over contiguous 3-d operands of shape
+// (b, m, k) x (b, k, n) -> (b, m, n). When is_bmm is true the result is
+// overwritten without being read (it may be uninitialized).
+using small_gemm_fn = void (*)(const Tensor& result, const Tensor& batch1,
+    const Tensor& batch2, Scalar beta, Scalar alpha, bool is_bmm);
+DECLARE_DISPATCH(small_gemm_fn, small_gemm_stub);
+
+// True when both operands are contiguous float/double CPU tensors whose
+// matrix dimensions all fit under kSmallGemmMaxDim. Works on the last two
+// dimensions so it applies to both mm (2-d) and bmm (3-d) operands.
+inline bool use_small_gemm(const Tensor& batch1, const Tensor& batch2) {
+  auto small_mat = [](const Tensor& t) {
+    return t.device().is_cpu() && t.layout() == kStrided && t.is_contiguous() &&
+        (t.scalar_type() == kFloat || t.scalar_type() == kDouble) &&
+        t.size(-2) <= kSmallGemmMaxDim && t.size(-1) <= kSmallGemmMaxDim;
+  };
+  return small_mat(batch1) && small_mat(batch2) &&
+      batch1.scalar_type() == batch2.scalar_type();
+}
+
+}} // namespace at::native
@@ -108,15 +108,24 @@ std::tuple<Tensor, Tensor> ctc_loss_cpu_template(const Tensor& log_probs, const
       auto log_alpha_a = log_alpha_a_global[b];
       int64_t tg_batch_offset = tg_batch_offsets[b];
 
+      // materialize l' (see get_target_prime) once per batch element, so the
+      // hot (t, s) loop below reads it from sequential memory instead of
+      // re-deriving it from the (strided) targets in every iteration
+      std::vector<int64_t> target_primes(2*target_length+1);
+      for (int64_t s=0; s<2*target_length+1; s++) {
+        target_primes[s] = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+      }
+      const int64_t* tp = target_primes.data();
+
       // the first two items of alpha_t above eq (6)
       log_alpha_a[0][0] = log_probs_a[0][BLANK];
       if (target_length > 0)
-        log_alpha_a[0][1] = log_probs_a[0][get_target_prime(targets_data, tg_batch_offset, tg_target_stride, 1, BLANK)];
+        log_alpha_a[0][1] = log_probs_a[0][tp[1]];
 
       // now the loop over the inputs
       for (int64_t t=1; t<input_length; t++) {
         for (int64_t s=0; s<2*target_length+1; s++) {
-          auto current_target_prime = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+          auto current_target_prime = tp[s];
           // this loop over s could be parallel/vectorized, too, but the required items are one index apart
           // alternatively, one might consider moving s to the outer loop to cache current_target_prime more (but then it needs to be descending)
           // for the cuda implementation, that gave a speed boost.
@@ -132,8 +141,7 @@ std::tuple<Tensor, Tensor> ctc_loss_cpu_template(const Tensor& log_probs, const
           } else {
             la2 = neginf;
           }
-          if ((s > 1) && (get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s-2, BLANK) !=
-                          current_target_prime)) {
+          if ((s > 1) && (tp[s-2] != current_target_prime)) {
             la3 = log_alpha_a[t-1][s-2];
             if (la3 > lamax)
               lamax = la3;
@@ -228,6 +236,13 @@ Tensor ctc_loss_backward_cpu_template(const Tensor& grad_out, const Tensor& log_
       int64_t target_length = target_lengths[b];
       int64_t tg_batch_offset = tg_batch_offsets[b];
 
+      // materialize l' once per batch element, as in the forward
+      std::vector<int64_t> target_primes(2*target_length+1);
+      for (int64_t s=0; s<2*target_length+1; s++) {
+        target_primes[s] = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+      }
+      const int64_t* tp = target_primes.data();
+
       // the initialization of beta before eq (10)
       // here we do the fill for each batch item separately, as the input lengths will differ, so the t in which
       // we start varies
@@ -237,7 +252,7 @@ Tensor ctc_loss_backward_cpu_template(const Tensor& grad_out, const Tensor& log_
         grad_a[input_length-1][BLANK] = log_alpha_a[input_length-1][2*target_length] + log_beta_a[input_length-1][2*target_length];
 
         if (target_length > 0) {
-          auto current_target_prime = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, 2*target_length-1, BLANK);
+          auto current_target_prime = tp[2*target_length-1];
           log_beta_a[input_length-1][2*target_length-1] = log_probs_a[input_length-1][current_target_prime];
 
           // the first two are a blank and a non-blank, so we know they are different and we don't need to do log+
@@ -254,7 +269,7 @@ Tensor ctc_loss_backward_cpu_template(const Tensor& grad_out, const Tensor& log_
           scalar_t lb1 = log_beta_a[t+1][s];
           scalar_t lbmax = lb1;
           scalar_t lb2, lb3;
-          auto current_target_prime = get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s, BLANK);
+          auto current_target_prime = tp[s];
           if (s < 2*target_length) {
             lb2 = log_beta_a[t+1][s+1];
             if (lb2 > lbmax)
@@ -262,8 +277,7 @@ Tensor ctc_loss_backward_cpu_template(const Tensor& grad_out, const Tensor& log_
           } else {
             lb2 = neginf;
           }
-          if ((s < 2*target_length-1) && (get_target_prime(targets_data, tg_batch_offset, tg_target_stride, s+2, BLANK) !=
-                                          current_target_prime)) {
+          if ((s < 2*target_length-1) && (tp[s+2] != current_target_prime)) {
             lb3 = log_beta_a[t+1][s+2];
             if (lb3 > lbmax)
               lbmax = lb3;
@@ -0,0 +1,129 @@
+#include <ATen/native/cross_entropy_loss.h>
+
+#include <tuple>
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+void check_cross_entropy_inputs(const Tensor& self, const Tensor& target) {
+  TORCH_CHECK(
+      self.dim() == 2, "cross_entropy_loss: input tensor should be 2D");
+  TORCH_CHECK(
+      target.dim() == 1,
+      "cross_entropy_loss: 1D target tensor expected, multi-target not supported");
+  TORCH_CHECK(
+      self.size(0) == target.size(0),
+      "cross_entropy_loss: size mismatch (got input: ",
+      self.sizes(),
+      ", target: ",
+      target.sizes(),
+      ")");
+  TORCH_CHECK(
+      self.size(1) > 0, "cross_entropy_loss: input needs at least one class");
+}
+
+} // namespace
+
+// Fuses log_softmax over the last dimension with NLL loss. Unlike the
+// composition of the two ops, this never materializes the [batch, classes]
+// log-probability tensor: the forward keeps only a per-row logsumexp, and
+// the backward reconstructs softmax(logits) from the logits and that vector
+// while writing the gradient.
+Tensor cross_entropy_loss(
+    const Tensor& self,
+    const Tensor& target,
+    int64_t reduction,
+    int64_t ignore_index) {
+  if (self.device().type() != kCPU) {
+    // Only the CPU backend has a fused kernel; fall back to the
+    // composition the fused op replaces.
+    return at::nll_loss(
+        at::log_softmax(self, -1, self.scalar_type()),
+        target,
+        {},
+        reduction,
+        ignore_index);
+  }
+  return std::get<0>(
+      at::cross_entropy_loss_forward(self, target, reduction, ignore_index));
+}
+
+std::tuple<Tensor, Tensor> cross_entropy_loss_forward_cpu(
+    const Tensor& self,
+    const Tensor& target,
+    int64_t reduction,
+    int64_t ignore_index) {
+  check_cross_entropy_inputs(self, target);
+  auto input_contiguous = self.contiguous();
+  auto target_contiguous = target.contiguous();
+  const int64_t batch_size = self.size(0);
+  Tensor output = reduction == Reduction::None
+      ? at::empty({batch_size}, self.options())
+      : at::empty({}, self.options());
+  Tensor logsumexp = at::empty({batch_size}, self.options());
+  CrossEntropyLossKernel(
+      kCPU,
+      input_contiguous,
+      target_contiguous,
+      reduction,
+      ignore_index,
+      &output,
+      &logsumexp);
+  return std::make_tuple(std::move(output), std::move(logsumexp));
+}
+
+Tensor cross_entropy_loss_backward_cpu(
+    const Tensor& grad_output,
+    const Tensor& self,
+    const Tensor& target,
+    const Tensor& logsumexp,
+    int64_t reduction,
+    int64_t ignore_index) {
+  check_cross_entropy_inputs(self, target);
+  TORCH_CHECK(
+      logsumexp.numel() == self.size(0),
+      "cross_entropy_loss: expected logsumexp with ",
+      self.size(0),
+      " elements, got: ",
+      logsumexp.sizes());
+  if (reduction == Reduction::None) {
+    TORCH_CHECK(
+        grad_output.numel() == self.size(0),
+        "cross_entropy_loss: expected grad_output with ",
+        self.size(0),
+        " elements, got: ",
+        grad_output.sizes());
+  } else {
+    TORCH_CHECK(
+        grad_output.dim() <= 1 && grad_output.numel() == 1,
+        "cross_entropy_loss: expected a single element grad_output tensor, but got: ",
+        grad_output.sizes());
+  }
+  auto grad_output_contiguous = grad_output.contiguous();
+  auto input_contiguous = self.contiguous();
+  auto target_contiguous = target.contiguous();
+  auto logsumexp_contiguous = logsumexp.contiguous();
+  Tensor grad_input =
+      at::native::empty_like(input_contiguous, at::MemoryFormat::Contiguous);
+  CrossEntropyLossBackwardKernel(
+      kCPU,
+      grad_output_contiguous,
+      input_contiguous,
+      target_contiguous,
+      logsumexp_contiguous,
+      reduction,
+      ignore_index,
+      &grad_input);
+  return grad_input;
+}
+
+DEFINE_DISPATCH(CrossEntropyLossKernel);
+DEFINE_DISPATCH(CrossEntropyLossBackwardKernel);
+
+} // namespace native
+} // namespace at
@@ -55,6 +55,8 @@ bool _nnpack_available() {
 
 #include "nnpack.h"
 
+#include <ATen/Parallel.h>
+#include "caffe2/utils/threadpool/ThreadPool.h"
 #include "caffe2/utils/threadpool/ThreadPoolMobile.h"
 
 namespace at {
@@ -83,35 +85,24 @@ static bool init_nnpack() {
 }
 
 static pthreadpool_t nnpack_threadpool() {
-  // Try initializing a threadpool for NNPACK's use.  If we fail to
-  // successfully initialize an implementation, return nullptr which will
-  // instruct NNPACK to run single threaded.
-
-#ifdef C10_MOBILE
-  // If building for mobile, use Caffe 2's mobile-friendly threadpool.
-  return caffe2::mobile_pthreadpool();
-#else
-  // Otherwise, try using pthreadpool if we manage to initialize it successfully.
-  static pthreadpool_t nnpack_threadpool_ = nullptr;
-  static bool called_nnpack_threadpool_ = false;
-
-  if (!called_nnpack_threadpool_) {
-    called_nnpack_threadpool_ = true;
-
-#ifdef INTRA_OP_PARALLEL
-    const uint32_t threads = at::get_num_threads();
-#else
-    const uint32_t threads = std::thread::hardware_concurrency();
-#endif
-
-    nnpack_threadpool_ = pthreadpool_create(threads);
-    if (!nnpack_threadpool_) {
-      LOG(WARNING) << "Failed to initialize pthreadpool! Running NNPACK in single-threaded mode.";
-    }
+  // NNPACK runs on the process-wide shared pool rather than a private one,
+  // so its workers are the same threads ATen's intra-op primitives and
+  // QNNPACK use and fp32/quantized interleaving cannot oversubscribe the
+  // cores.
+  caffe2::ThreadPool* pool = caffe2::shared_threadpool();
+  if (pool == nullptr) {
+    // No pool available: NNPACK runs single threaded.
+    return nullptr;
+  }
+#ifndef C10_MOBILE
+  // On server builds at::set_num_threads is the one concurrency knob;
+  // track it. Mobile keeps the big.LITTLE-aware default sizing.
+  const int threads = at::get_num_threads();
+  if (threads > 0 && pool->getNumThreads() != threads) {
+    pool->setNumThreads(threads);
   }
-
-  return nnpack_threadpool_;
 #endif
+  return reinterpret_cast<pthreadpool_t>(pool);
 }
 
 bool _nnpack_available() {
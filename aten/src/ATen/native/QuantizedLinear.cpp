@@ -13,6 +13,8 @@
 #include <cctype>
 #include <cmath>
 #include <cstddef>
+#include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -252,11 +254,55 @@ std::tuple<Tensor, Tensor, double, int64_t> fbgemm_linear_quantize_weight(
       quantized, col_offsets, q_params.scale, q_params.zero_point);
 }
 
+namespace {
+
+// Small process-wide cache of prepacked int8 weight matrices. Callers that
+// run fbgemm_pack_quantized_matrix on every invocation (e.g. inside a
+// scripted forward, rather than once at conversion time) repack the same
+// frozen weight tensor over and over; keying on the weight's TensorImpl
+// identity plus its version counter lets those calls reuse the previous
+// PackBMatrix, while an in-place update or a freed weight makes the entry
+// stale and forces a repack. Entries are ordered most recently used first.
+constexpr size_t kPackedMatrixCacheCapacity = 16;
+
+struct PackedMatrixCacheEntry {
+  c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl> source;
+  uint32_t version;
+  Tensor packed;
+};
+
+std::mutex packed_matrix_cache_mutex;
+std::list<PackedMatrixCacheEntry> packed_matrix_cache;
+
+} // namespace
+
 Tensor fbgemm_pack_quantized_matrix(const Tensor& weight) {
   // We make a strong guarantee that models using these operators will have the
   // same numerics across different machines. Therefore, we do not provide a
   // fallback path and rather fail loudly if we cannot run FBGEMM.
   TORCH_CHECK(fbgemm::fbgemmSupportedCPU(), "Your CPU doesn't support FBGEMM.");
+  auto* weight_impl = weight.unsafeGetTensorImpl();
+  const auto weight_version = weight_impl->version_counter().current_version();
+  {
+    std::lock_guard<std::mutex> guard(packed_matrix_cache_mutex);
+    for (auto it = packed_matrix_cache.begin();
+         it != packed_matrix_cache.end();) {
+      auto locked = it->source.lock();
+      if (!locked.defined() ||
+          (locked.get() == weight_impl && it->version != weight_version)) {
+        // The source weight died or was updated in place; the prepacked copy
+        // is stale.
+        it = packed_matrix_cache.erase(it);
+        continue;
+      }
+      if (locked.get() == weight_impl) {
+        packed_matrix_cache.splice(
+            packed_matrix_cache.begin(), packed_matrix_cache, it);
+        return packed_matrix_cache.front().packed;
+      }
+      ++it;
+    }
+  }
   int64_t K = weight.size(1);
   int64_t N = weight.size(0);
   auto weight_contig = weight.contiguous();
@@ -269,7 +315,19 @@ Tensor fbgemm_pack_quantized_matrix(const Tensor& weight) {
       /*ld=*/K,
       /*pmat=*/nullptr, // PackBMatrix manages ownership of pmat
       /*groups=*/1);
-  return cpp_custom_type_hack::create(std::move(ptr), weight.options());
+  auto result = cpp_custom_type_hack::create(std::move(ptr), weight.options());
+  {
+    std::lock_guard<std::mutex> guard(packed_matrix_cache_mutex);
+    if (packed_matrix_cache.size() >= kPackedMatrixCacheCapacity) {
+      packed_matrix_cache.pop_back();
+    }
+    packed_matrix_cache.push_front(PackedMatrixCacheEntry{
+        c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>(
+            weight.getIntrusivePtr()),
+        weight_version,
+        result});
+  }
+  return result;
 }
 
 Tensor fbgemm_pack_quantized_matrix(
@@ -2,6 +2,7 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 
@@ -386,6 +387,63 @@ struct SimpleCell : Cell<Tensor, cell_params> {
   }
 };
 
+// True when the fused one-pass cell kernel can take over from the chunked
+// ops below. The kernel writes hy/cy directly without recording anything for
+// autograd, so it only runs when no gradient is needed; training keeps the
+// differentiable chunked formulation.
+bool can_use_fused_lstm_cell(const Tensor& gates, const Tensor& cx) {
+  if (!gates.device().is_cpu() || gates.layout() != kStrided ||
+      cx.layout() != kStrided) {
+    return false;
+  }
+  if (gates.scalar_type() != kFloat && gates.scalar_type() != kDouble) {
+    return false;
+  }
+  if (cx.scalar_type() != gates.scalar_type() ||
+      !gates.is_contiguous() || !cx.is_contiguous()) {
+    return false;
+  }
+  if (cx.dim() == 0 || gates.size(-1) != 4 * cx.size(-1) ||
+      gates.numel() != 4 * cx.numel()) {
+    return false;
+  }
+  auto needs_grad = [](const Tensor& t) {
+    return t.is_variable() && t.requires_grad();
+  };
+  return !(at::GradMode::is_enabled() && (needs_grad(gates) || needs_grad(cx)));
+}
+
+// Same contract as can_use_fused_lstm_cell, for the GRU cell's two gate
+// buffers (reset/input/new chunks, one buffer per projection).
+bool can_use_fused_gru_cell(
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hx) {
+  if (!igates.device().is_cpu() || igates.layout() != kStrided ||
+      hgates.layout() != kStrided || hx.layout() != kStrided) {
+    return false;
+  }
+  if (igates.scalar_type() != kFloat && igates.scalar_type() != kDouble) {
+    return false;
+  }
+  if (hgates.scalar_type() != igates.scalar_type() ||
+      hx.scalar_type() != igates.scalar_type() ||
+      !igates.is_contiguous() || !hgates.is_contiguous() ||
+      !hx.is_contiguous()) {
+    return false;
+  }
+  if (hx.dim() == 0 || !igates.sizes().equals(hgates.sizes()) ||
+      igates.size(-1) != 3 * hx.size(-1) ||
+      igates.numel() != 3 * hx.numel()) {
+    return false;
+  }
+  auto needs_grad = [](const Tensor& t) {
+    return t.is_variable() && t.requires_grad();
+  };
+  return !(at::GradMode::is_enabled() &&
+           (needs_grad(igates) || needs_grad(hgates) || needs_grad(hx)));
+}
+
 // TODO: can use inplace ops?
 template <typename cell_params>
 struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
@@ -411,6 +469,12 @@ struct LSTMCell : Cell<std::tuple<Tensor, Tensor>, cell_params> {
 
     const auto gates = params.linear_hh(hx).add_(
         pre_compute_input ? input : params.linear_ih(input));
+    if (can_use_fused_lstm_cell(gates, cx)) {
+      auto hy = at::empty_like(cx);
+      auto cy = at::empty_like(cx);
+      lstm_cell_cpu_stub(kCPU, hy, cy, gates, cx);
+      return std::make_tuple(std::move(hy), std::move(cy));
+    }
     auto chunked_gates = gates.chunk(4, 1);
     auto ingate = chunked_gates[0].sigmoid_();
     auto forgetgate = chunked_gates[1].sigmoid_();
@@ -441,10 +505,15 @@ struct GRUCell : Cell<Tensor, cell_params> {
       // Slice off the workspace argument (it's needed only for AD).
       return std::move(std::get<0>(result));
     }
-    const auto chunked_igates = pre_compute_input
-        ? input.chunk(3, 1)
-        : params.linear_ih(input).chunk(3, 1);
-    auto chunked_hgates = params.linear_hh(hidden).chunk(3, 1);
+    const auto igates = pre_compute_input ? input : params.linear_ih(input);
+    auto hgates = params.linear_hh(hidden);
+    if (can_use_fused_gru_cell(igates, hgates, hidden)) {
+      auto hy = at::empty_like(hidden);
+      gru_cell_cpu_stub(kCPU, hy, igates, hgates, hidden);
+      return hy;
+    }
+    const auto chunked_igates = igates.chunk(3, 1);
+    auto chunked_hgates = hgates.chunk(3, 1);
     const auto reset_gate =
         chunked_hgates[0].add_(chunked_igates[0]).sigmoid_();
     const auto input_gate =
@@ -828,6 +897,9 @@ std::tuple<io_type, Tensor, Tensor> _lstm_impl(
 // PUBLIC FUNCTIONS
 ////////////////////////////////////////////////////////////////////////////////
 
+DEFINE_DISPATCH(lstm_cell_cpu_stub);
+DEFINE_DISPATCH(gru_cell_cpu_stub);
+
 #define ONE_HIDDEN_RNN(NAME, CELL)                                             \
 DEFINE_DISPATCH(NAME##_cudnn_stub);                                            \
 DEFINE_DISPATCH(NAME##_miopen_stub);                                           \
@@ -27,6 +27,14 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
 
+// Fused CPU LSTM cell pointwise stage: reads the summed gate buffer of shape
+// (batch, 4 * hidden_size) and the previous cell state, and writes hy and cy
+// in a single pass (see cpu/LstmCellKernel.cpp).
+using lstm_cell_cpu_fn = void(*)(Tensor& hy, Tensor& cy, const Tensor& gates, const Tensor& cx);
+DECLARE_DISPATCH(lstm_cell_cpu_fn, lstm_cell_cpu_stub);
+using gru_cell_cpu_fn = void(*)(Tensor& hy, const Tensor& igates, const Tensor& hgates, const Tensor& hx);
+DECLARE_DISPATCH(gru_cell_cpu_fn, gru_cell_cpu_stub);
+
 inline void check_device(const Tensor& input, const TensorList& params, const TensorList& hiddens) {
   auto input_device = input.device();
 
@@ -0,0 +1,151 @@
+#pragma once
+
+// Shared sort-and-segment machinery for CPU kernels that replace scattered
+// row accumulation with conflict-free parallel segmented sums (sparse
+// coalesce, embedding_dense_backward, index_add_). The keys these kernels
+// sort are nonnegative integers with a known bound, which is what makes a
+// radix sort applicable.
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace at { namespace native {
+
+constexpr int64_t RADIX_SORT_BITS = 8;
+constexpr int64_t RADIX_SORT_SIZE = 1 << RADIX_SORT_BITS;
+constexpr int64_t RADIX_SORT_MASK = RADIX_SORT_SIZE - 1;
+
+inline int64_t radix_sort_num_chunks(int64_t n) {
+  return std::min<int64_t>(
+      at::get_num_threads(), std::max<int64_t>(1, n / 4096));
+}
+
+// Stable LSD radix sort of (key, position) pairs, least-significant byte
+// first, processing only the bytes that can be nonzero given `max_key`.
+// Each pass builds per-chunk histograms in parallel, takes one serial
+// exclusive scan over (bucket, chunk) - cheap, 256 * nthreads entries - and
+// scatters in parallel; stability within a pass follows from chunks being
+// scanned in order within each bucket. `keys_scratch` and
+// `positions_scratch` must each hold n entries; callers that sort every
+// step can recycle them.
+inline void radix_sort_pairs_parallel(
+    int64_t* keys,
+    int64_t* positions,
+    int64_t n,
+    int64_t max_key,
+    int64_t* keys_scratch,
+    int64_t* positions_scratch) {
+  const int64_t num_chunks = radix_sort_num_chunks(n);
+  const int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+
+  std::vector<int64_t> histogram(num_chunks * RADIX_SORT_SIZE);
+
+  int64_t* keys_in = keys;
+  int64_t* positions_in = positions;
+  int64_t* keys_out = keys_scratch;
+  int64_t* positions_out = positions_scratch;
+
+  for (int64_t shift = 0; (max_key >> shift) != 0; shift += RADIX_SORT_BITS) {
+    std::fill(histogram.begin(), histogram.end(), 0);
+    at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+      for (int64_t chunk = chunk_begin; chunk < chunk_end; chunk++) {
+        int64_t* counts = histogram.data() + chunk * RADIX_SORT_SIZE;
+        const int64_t begin = chunk * chunk_size;
+        const int64_t end = std::min(n, begin + chunk_size);
+        for (int64_t j = begin; j < end; j++) {
+          counts[(keys_in[j] >> shift) & RADIX_SORT_MASK]++;
+        }
+      }
+    });
+    int64_t offset = 0;
+    for (int64_t bucket = 0; bucket < RADIX_SORT_SIZE; bucket++) {
+      for (int64_t chunk = 0; chunk < num_chunks; chunk++) {
+        int64_t count = histogram[chunk * RADIX_SORT_SIZE + bucket];
+        histogram[chunk * RADIX_SORT_SIZE + bucket] = offset;
+        offset += count;
+      }
+    }
+    at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+      for (int64_t chunk = chunk_begin; chunk < chunk_end; chunk++) {
+        int64_t* offsets = histogram.data() + chunk * RADIX_SORT_SIZE;
+        const int64_t begin = chunk * chunk_size;
+        const int64_t end = std::min(n, begin + chunk_size);
+        for (int64_t j = begin; j < end; j++) {
+          int64_t slot = offsets[(keys_in[j] >> shift) & RADIX_SORT_MASK]++;
+          keys_out[slot] = keys_in[j];
+          positions_out[slot] = positions_in[j];
+        }
+      }
+    });
+    std::swap(keys_in, keys_out);
+    std::swap(positions_in, positions_out);
+  }
+
+  if (keys_in != keys) {
+    std::copy(keys_in, keys_in + n, keys);
+    std::copy(positions_in, positions_in + n, positions);
+  }
+}
+
+// Writes the start offsets (into the sorted order) of each run of equal
+// keys into `starts`, which must hold at least n + 1 entries, and returns
+// the number of runs. Built with a per-chunk count followed by a parallel
+// write-out; starts[count] is a sentinel equal to n.
+inline int64_t segment_starts_parallel(
+    const int64_t* keys,
+    int64_t n,
+    int64_t* starts) {
+  const int64_t num_chunks = radix_sort_num_chunks(n);
+  const int64_t chunk_size = (n + num_chunks - 1) / num_chunks;
+
+  std::vector<int64_t> chunk_counts(num_chunks + 1, 0);
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t chunk = chunk_begin; chunk < chunk_end; chunk++) {
+      const int64_t begin = chunk * chunk_size;
+      const int64_t end = std::min(n, begin + chunk_size);
+      int64_t count = 0;
+      for (int64_t j = begin; j < end; j++) {
+        if (j == 0 || keys[j] != keys[j - 1]) {
+          count++;
+        }
+      }
+      chunk_counts[chunk + 1] = count;
+    }
+  });
+  std::partial_sum(chunk_counts.begin(), chunk_counts.end(), chunk_counts.begin());
+
+  at::parallel_for(0, num_chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t chunk = chunk_begin; chunk < chunk_end; chunk++) {
+      const int64_t begin = chunk * chunk_size;
+      const int64_t end = std::min(n, begin + chunk_size);
+      int64_t slot = chunk_counts[chunk];
+      for (int64_t j = begin; j < end; j++) {
+        if (j == 0 || keys[j] != keys[j - 1]) {
+          starts[slot++] = j;
+        }
+      }
+    }
+  });
+  starts[chunk_counts[num_chunks]] = n;  // sentinel
+  return chunk_counts[num_chunks];
+}
+
+// y += x over a unit-stride values row; the vectorized replacement for the
+// per-duplicate BLAS axpy of the serial paths.
+template <typename scalar_t>
+inline void accumulate_values_row(int64_t n, const scalar_t* x, scalar_t* y) {
+  using Vec = vec256::Vec256<scalar_t>;
+  int64_t j = 0;
+  for (; j + Vec::size() <= n; j += Vec::size()) {
+    (Vec::loadu(y + j) + Vec::loadu(x + j)).store(y + j);
+  }
+  for (; j < n; j++) {
+    y[j] += x[j];
+  }
+}
+
+}} // namespace at::native
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+
+// Fast path for elementwise ops on tiny CPU tensors.
+//
+// For tensors with a handful of elements (RL policies, per-step bookkeeping,
+// scalar-ish state), TensorIterator construction - broadcasting, type
+// promotion, dimension reordering - costs an order of magnitude more than the
+// actual arithmetic. When all operands are small, contiguous, same-dtype CPU
+// tensors of identical shape, the helpers below run a plain scalar loop
+// instead of building an iterator. Anything that doesn't exactly match falls
+// through to the regular TensorIterator path, so semantics are unchanged.
+
+namespace at {
+namespace native {
+
+constexpr int64_t kSmallTensorMaxNumel = 64;
+
+namespace detail {
+
+inline bool small_fast_path_operand_ok(const Tensor& t) {
+  if (!t.defined() || !t.device().is_cpu() || t.layout() != kStrided ||
+      t.is_quantized() || !t.is_contiguous()) {
+    return false;
+  }
+#ifdef BUILD_NAMEDTENSOR
+  // Name propagation goes through TensorIterator.
+  if (t.has_names()) {
+    return false;
+  }
+#endif
+  auto st = t.scalar_type();
+  // The types covered by AT_DISPATCH_ALL_TYPES.
+  if (!isIntegralType(st, /*includeBool=*/false) && st != kFloat && st != kDouble) {
+    return false;
+  }
+  return t.numel() > 0 && t.numel() <= kSmallTensorMaxNumel;
+}
+
+inline bool small_fast_path_result_ok(const Tensor& result, const Tensor& self) {
+  if (!result.defined()) {
+    return true;
+  }
+  if (!result.device().is_cpu() || result.layout() != kStrided ||
+      result.scalar_type() != self.scalar_type()) {
+    return false;
+  }
+  // Accept the canonical empty({0}) placeholder (resized below) or an
+  // exactly-matching contiguous output.
+  return result.numel() == 0 ||
+      (result.is_contiguous() && result.sizes().equals(self.sizes()));
+}
+
+// True if the memory regions are identical or fully disjoint. Partially
+// overlapping outputs keep the TensorIterator path (and its error checking).
+inline bool small_fast_path_no_partial_overlap(const Tensor& a, const Tensor& b) {
+  const char* a_begin = static_cast<const char*>(a.data_ptr());
+  const char* b_begin = static_cast<const char*>(b.data_ptr());
+  if (a_begin == b_begin) {
+    return true;
+  }
+  const char* a_end = a_begin + a.numel() * a.element_size();
+  const char* b_end = b_begin + b.numel() * b.element_size();
+  return a_end <= b_begin || b_end <= a_begin;
+}
+
+inline Tensor& small_fast_path_prepare_result(Tensor& result, const Tensor& self) {
+  if (!result.defined()) {
+    result = at::empty(self.sizes(), self.options());
+  } else if (result.numel() == 0) {
+    result.resize_(self.sizes());
+  }
+  return result;
+}
+
+} // namespace detail
+
+inline bool can_use_small_tensor_fast_path(const Tensor& result, const Tensor& self) {
+  if (!detail::small_fast_path_operand_ok(self) ||
+      !detail::small_fast_path_result_ok(result, self)) {
+    return false;
+  }
+  return !result.defined() || result.numel() == 0 ||
+      detail::small_fast_path_no_partial_overlap(result, self);
+}
+
+inline bool can_use_small_tensor_fast_path(
+    const Tensor& result, const Tensor& self, const Tensor& other) {
+  if (!detail::small_fast_path_operand_ok(self) ||
+      !detail::small_fast_path_operand_ok(other) ||
+      other.scalar_type() != self.scalar_type() ||
+      !other.sizes().equals(self.sizes()) ||
+      !detail::small_fast_path_result_ok(result, self)) {
+    return false;
+  }
+  return !result.defined() || result.numel() == 0 ||
+      (detail::small_fast_path_no_partial_overlap(result, self) &&
+       detail::small_fast_path_no_partial_overlap(result, other));
+}
+
+template <typename op_t>
+Tensor& small_tensor_unary_kernel(
+    Tensor& result, const Tensor& self, const char* name, const op_t& op) {
+  detail::small_fast_path_prepare_result(result, self);
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), name, [&] {
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    int64_t n = self.numel();
+    for (int64_t i = 0; i < n; i++) {
+      result_data[i] = op(self_data[i]);
+    }
+  });
+  return result;
+}
+
+template <typename op_t>
+Tensor& small_tensor_binary_kernel(
+    Tensor& result, const Tensor& self, const Tensor& other,
+    const char* name, const op_t& op) {
+  detail::small_fast_path_prepare_result(result, self);
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), name, [&] {
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    const scalar_t* other_data = other.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    int64_t n = self.numel();
+    for (int64_t i = 0; i < n; i++) {
+      result_data[i] = op(self_data[i], other_data[i]);
+    }
+  });
+  return result;
+}
+
+template <typename op_t>
+Tensor& small_tensor_binary_alpha_kernel(
+    Tensor& result, const Tensor& self, const Tensor& other, Scalar alpha,
+    const char* name, const op_t& op) {
+  detail::small_fast_path_prepare_result(result, self);
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), name, [&] {
+    scalar_t alpha_val = alpha.to<scalar_t>();
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    const scalar_t* other_data = other.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    int64_t n = self.numel();
+    for (int64_t i = 0; i < n; i++) {
+      result_data[i] = op(self_data[i], other_data[i], alpha_val);
+    }
+  });
+  return result;
+}
+
+} // namespace native
+} // namespace at
@@ -225,6 +225,40 @@ std::tuple<Tensor, Tensor> topk(
   return std::make_tuple(values, indices);
 }
 
+std::tuple<Tensor&, Tensor&> sort_out_cpu(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t dim_,
+    bool descending) {
+  int64_t dim = maybe_wrap_dim(dim_, self.dim(), /*wrap_scalar=*/true);
+  const int64_t slice_size = self.dim() > 0 ? self.size(dim) : 1;
+
+  _allocate_or_resize_output_with_indices(values, indices, self, dim_, slice_size);
+  if (self.numel() == 0) {
+    return std::forward_as_tuple(values, indices);
+  }
+  if (self.dim() == 0 && self.numel() == 1) {
+    values.copy_(self);
+    indices.zero_();
+    return std::forward_as_tuple(values, indices);
+  }
+
+  sort_stub(kCPU, values, indices, self, dim, descending);
+
+  return std::forward_as_tuple(values, indices);
+}
+
+std::tuple<Tensor, Tensor> sort_cpu(
+    const Tensor& self,
+    int64_t dim,
+    bool descending) {
+  Tensor values = at::empty({0}, self.options());
+  Tensor indices = at::empty({0}, self.options().dtype(kLong));
+  sort_out_cpu(values, indices, self, dim, descending);
+  return std::make_tuple(values, indices);
+}
+
 std::tuple<Tensor&, Tensor&> median_out(
     Tensor& values,
     Tensor& indices,
@@ -313,6 +347,7 @@ Tensor median_cpu(const Tensor& self) {
 }
 
 DEFINE_DISPATCH(topk_stub);
+DEFINE_DISPATCH(sort_stub);
 
 } // namespace native
 } // namespace at
@@ -6,7 +6,9 @@
 namespace at { namespace native {
 
 using topk_fn = void(*)(Tensor&, Tensor&, const Tensor&, int64_t, int64_t, bool, bool);
+using sort_fn = void(*)(Tensor&, Tensor&, const Tensor&, int64_t, bool);
 
 DECLARE_DISPATCH(topk_fn, topk_stub);
+DECLARE_DISPATCH(sort_fn, sort_stub);
 
 }} // at::native
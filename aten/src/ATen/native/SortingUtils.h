@@ -2,9 +2,62 @@
 
 #include <ATen/Parallel.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace at {
 namespace native {
 
+// Sequences below this length are not worth splitting across threads.
+constexpr int64_t kParallelSortGrainSize = 2048;
+
+// Sorts [data, data + n) with a chunked parallel merge sort: the range is
+// cut into a power-of-two number of chunks which are std::sort-ed in
+// parallel, then merged pairwise in log2(chunks) parallel rounds through a
+// scratch buffer. A comparator-based engine keeps one code path for every
+// dtype and whatever NaN ordering the comparator encodes. Must not be
+// called from inside a parallel region.
+template <typename T, typename Comp>
+void parallel_merge_sort(T* data, int64_t n, const Comp& comp) {
+  const int64_t max_chunks =
+      std::min<int64_t>(at::get_num_threads(), n / kParallelSortGrainSize);
+  int64_t num_chunks = 1;
+  while (num_chunks * 2 <= max_chunks) {
+    num_chunks *= 2;
+  }
+  if (num_chunks <= 1) {
+    std::sort(data, data + n, comp);
+    return;
+  }
+  std::vector<int64_t> bounds(num_chunks + 1);
+  for (int64_t i = 0; i <= num_chunks; ++i) {
+    bounds[i] = n * i / num_chunks;
+  }
+  at::parallel_for(0, num_chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      std::sort(data + bounds[i], data + bounds[i + 1], comp);
+    }
+  });
+  std::vector<T> scratch(n);
+  T* src = data;
+  T* dst = scratch.data();
+  for (int64_t width = 1; width < num_chunks; width *= 2) {
+    const int64_t stride = 2 * width;
+    at::parallel_for(0, num_chunks / stride, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t m = begin; m < end; ++m) {
+        const int64_t lo = bounds[m * stride];
+        const int64_t mid = bounds[m * stride + width];
+        const int64_t hi = bounds[(m + 1) * stride];
+        std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comp);
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src != data) {
+    std::copy(src, src + n, data);
+  }
+}
+
 template <typename Fn>
 void dim_apply(TensorList tensors, int64_t dim, Fn f) {
   AT_ASSERT(tensors.size() > 0);
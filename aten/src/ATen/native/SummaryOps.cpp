@@ -2,14 +2,80 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 
+#include <cmath>
 #include <tuple>
+#include <vector>
 
 namespace at { namespace native {
 
 ///////////////// bincount /////////////////
 namespace {
 
+// Parallel counting engine shared by bincount and histc. `get_bin` maps an
+// element index to its bin (or -1 to skip it), `get_count` to the amount
+// added to that bin. Three regimes:
+//  - small inputs run one serial pass; the buffers below would cost more
+//    than they save
+//  - moderate bin counts use per-thread private count arrays that are
+//    merged (bin-parallel) at the end
+//  - huge bin ranges, where private arrays would dwarf the input, give
+//    each thread a disjoint stripe of bins and a full scan of the input,
+//    so concurrent increments never touch the same counter
+template <typename count_t, typename bin_fn_t, typename count_fn_t>
+void parallel_count(
+    count_t* output_p,
+    int64_t nbins,
+    int64_t n,
+    const bin_fn_t& get_bin,
+    const count_fn_t& get_count) {
+  const int num_threads = at::get_num_threads();
+  if (n <= at::internal::GRAIN_SIZE || num_threads == 1) {
+    for (int64_t i = 0; i < n; i++) {
+      const int64_t bin = get_bin(i);
+      if (bin >= 0) {
+        output_p[bin] += get_count(i);
+      }
+    }
+    return;
+  }
+  if (num_threads * nbins <= std::max(n, (int64_t)at::internal::GRAIN_SIZE)) {
+    std::vector<count_t> partials(num_threads * nbins, count_t(0));
+    count_t* partials_p = partials.data();
+    at::parallel_for(0, n, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      count_t* local = partials_p + at::get_thread_num() * nbins;
+      for (int64_t i = begin; i < end; i++) {
+        const int64_t bin = get_bin(i);
+        if (bin >= 0) {
+          local[bin] += get_count(i);
+        }
+      }
+    });
+    at::parallel_for(0, nbins, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      for (int t = 0; t < num_threads; t++) {
+        const count_t* local = partials_p + t * nbins;
+        for (int64_t b = begin; b < end; b++) {
+          output_p[b] += local[b];
+        }
+      }
+    });
+    return;
+  }
+  // one stripe of bins per thread; each thread re-reads the whole input,
+  // which is bounded by the thread count and avoids both the giant
+  // partial arrays and atomics on the output
+  const int64_t stripe = (nbins + num_threads - 1) / num_threads;
+  at::parallel_for(0, nbins, stripe, [&](int64_t bin_begin, int64_t bin_end) {
+    for (int64_t i = 0; i < n; i++) {
+      const int64_t bin = get_bin(i);
+      if (bin >= bin_begin && bin < bin_end) {
+        output_p[bin] += get_count(i);
+      }
+    }
+  });
+}
+
 template <typename input_t, typename weights_t>
 Tensor _bincount_cpu_template(
     const Tensor& self,
@@ -35,19 +101,23 @@ Tensor _bincount_cpu_template(
   nbins = std::max(nbins, minlength); // at least minlength # of bins
 
   const input_t* self_p = self.data_ptr<input_t>();
+  const int64_t n = self.size(0);
+  const auto get_bin = [self_p](int64_t i) -> int64_t {
+    return static_cast<int64_t>(self_p[i]);
+  };
   if (has_weights) {
     output = native::zeros({nbins}, weights.options());
     weights_t* output_p = output.data_ptr<weights_t>();
     const weights_t* weights_p = weights.data_ptr<weights_t>();
-    for (int64_t i = 0; i < self.size(0); i++) {
-      output_p[self_p[i]] += weights_p[i];
-    }
+    parallel_count(
+        output_p, nbins, n, get_bin, [weights_p](int64_t i) -> weights_t {
+          return weights_p[i];
+        });
   } else {
     output = native::zeros({nbins}, kLong);
     int64_t* output_p = output.data_ptr<int64_t>();
-    for (int64_t i = 0; i < self.size(0); i++) {
-      output_p[self_p[i]] += 1L;
-    }
+    parallel_count(
+        output_p, nbins, n, get_bin, [](int64_t) -> int64_t { return 1; });
   }
   return output;
 }
@@ -64,4 +134,61 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+///////////////// histc /////////////////
+
+// Ported from TH (THTensor_(histc)) so the binning runs through the
+// parallel counting engine above. The bin index is computed with one
+// precomputed multiplier instead of a division per element, which also
+// lets the compiler vectorize the index arithmetic.
+Tensor& _histc_out_cpu(Tensor& hist, const Tensor& self, int64_t bins, Scalar min, Scalar max) {
+  if (bins <= 0) {
+    AT_ERROR("bins must be > 0");
+  }
+  TORCH_CHECK(hist.scalar_type() == self.scalar_type(),
+      "expected output to have scalar type ", self.scalar_type(),
+      " but got ", hist.scalar_type());
+  hist.resize_({bins});
+  hist.zero_();
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    const Tensor self_c = self.contiguous();
+    double minval = min.to<double>();
+    double maxval = max.to<double>();
+    if (minval == maxval) {
+      minval = static_cast<double>(*self_c.min().data_ptr<scalar_t>());
+      maxval = static_cast<double>(*self_c.max().data_ptr<scalar_t>());
+    }
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    TORCH_CHECK(!(std::isinf(minval) || std::isinf(maxval) ||
+        std::isnan(minval) || std::isnan(maxval)),
+        "range of [", minval, ", ", maxval, "] is not finite");
+    TORCH_CHECK(minval < maxval, "max must be larger than min");
+
+    const scalar_t* self_p = self_c.data_ptr<scalar_t>();
+    scalar_t* hist_p = hist.data_ptr<scalar_t>();
+    const double inv_width = static_cast<double>(bins) / (maxval - minval);
+    parallel_count(
+        hist_p,
+        bins,
+        self_c.numel(),
+        [=](int64_t i) -> int64_t {
+          const double v = static_cast<double>(self_p[i]);
+          if (v < minval || v > maxval) {
+            return -1;
+          }
+          return std::min(
+              static_cast<int64_t>((v - minval) * inv_width), bins - 1);
+        },
+        [](int64_t) -> scalar_t { return 1; });
+  });
+  return hist;
+}
+
+Tensor _histc_cpu(const Tensor& self, int64_t bins, Scalar min, Scalar max) {
+  Tensor hist = at::empty({0}, self.options());
+  return _histc_out_cpu(hist, self, bins, min, max);
+}
+
 }} // namespace at::native
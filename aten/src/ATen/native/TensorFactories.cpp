@@ -25,6 +25,8 @@
 #include <cmath>
 #include <cstddef>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace at {
 namespace native {
@@ -930,10 +932,54 @@ Tensor tensor_backend(ArrayRef<T> values, const TensorOptions& options) {
 AT_FORALL_SCALAR_TYPES_AND3(Bool, Half, BFloat16, TENSOR)
 #undef TENSOR
 
-Tensor from_file(std::string filename, c10::optional<bool> shared, c10::optional<int64_t> size, const TensorOptions& options) {
+namespace {
+
+// Touches every page of the mapping from several threads, so a cold read of
+// a large file does not serialize behind a single stream of page faults.
+void prefault_mapping(const void* data, size_t nbytes, int64_t num_threads) {
+  constexpr size_t kPageSize = 4096;
+  const size_t num_pages = (nbytes + kPageSize - 1) / kPageSize;
+  const size_t pages_per_thread =
+      (num_pages + num_threads - 1) / num_threads;
+  const char* base = static_cast<const char*>(data);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (int64_t t = 0; t < num_threads; ++t) {
+    const size_t begin = t * pages_per_thread;
+    const size_t end = std::min(begin + pages_per_thread, num_pages);
+    if (begin >= end) {
+      break;
+    }
+    threads.emplace_back([base, begin, end, nbytes] {
+      for (size_t page = begin; page < end; ++page) {
+        volatile char byte = base[std::min(page * kPageSize, nbytes - 1)];
+        (void)byte;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace
+
+Tensor from_file(std::string filename, c10::optional<bool> shared, c10::optional<int64_t> size,
+    c10::optional<bool> populate, c10::optional<bool> hugepage, c10::optional<int64_t> prefault_threads,
+    const TensorOptions& options) {
     TORCH_CHECK(!options.pinned_memory(), "tensors constructed from a file cannot be pinned");
+    int64_t num_prefault_threads = prefault_threads.value_or(0);
+    TORCH_CHECK(num_prefault_threads >= 0, "prefault_threads must be non-negative, got ", num_prefault_threads);
     size_t my_size = size.value_or(0);
     int flags = shared.value_or(false) ? TH_ALLOCATOR_MAPPED_SHARED : 0;
+    // Prefault threads touch the pages themselves, so MAP_POPULATE would be
+    // redundant work on the calling thread.
+    if (populate.value_or(false) && num_prefault_threads <= 1) {
+      flags |= TH_ALLOCATOR_MAPPED_POPULATE;
+    }
+    if (hugepage.value_or(false)) {
+      flags |= TH_ALLOCATOR_MAPPED_HUGEPAGE;
+    }
     auto dtype = options.dtype();
     auto storage_impl = c10::make_intrusive<at::StorageImpl>(
       dtype,
@@ -942,6 +988,10 @@ Tensor from_file(std::string filename, c10::optional<bool> shared, c10::optional
           filename.c_str(), flags, my_size * dtype.itemsize(), nullptr),
       /*allocator=*/nullptr,
       /*resizable=*/false);
+    if (num_prefault_threads > 1 && my_size > 0) {
+      prefault_mapping(
+          storage_impl->data(), my_size * dtype.itemsize(), num_prefault_threads);
+    }
     auto tensor = detail::make_tensor<at::TensorImpl>(storage_impl, at::TensorTypeId::CPUTensorId);
     tensor.unsafeGetTensorImpl()->set_sizes_contiguous({storage_impl->numel()});
     return tensor;
@@ -967,6 +1017,31 @@ Tensor clone(const Tensor& src, c10::optional<c10::MemoryFormat> optional_memory
   return self;
 }
 
+// Copy-on-write clone: O(1) for dense CPU tensors. The result shares src's
+// bytes and either tensor gets a private allocation the first time it is
+// written through the dispatcher (see StorageImpl::share_copy_on_write);
+// writes that bypass the dispatcher via raw data_ptr() access are not
+// fenced. Falls back to an eager, layout-preserving clone where
+// copy-on-write sharing is not supported.
+Tensor _lazy_clone(const Tensor& src) {
+  if (!src.has_storage() || src.is_sparse() || src.is_quantized() ||
+      src.is_mkldnn() || src.storage().device_type() != DeviceType::CPU ||
+      src.storage().unsafeGetStorageImpl()->allocator() == nullptr) {
+    return src.clone(at::MemoryFormat::Preserve);
+  }
+  auto cow_storage =
+      src.storage().unsafeGetStorageImpl()->share_copy_on_write();
+  auto impl = c10::make_intrusive<TensorImpl>(
+      Storage(std::move(cow_storage)), src.type_set());
+  impl->set_storage_offset(src.storage_offset());
+  impl->set_sizes_and_strides(src.sizes(), src.strides());
+  Tensor result(std::move(impl));
+#ifdef BUILD_NAMEDTENSOR
+  namedinference::propagate_names(result, src);
+#endif
+  return result;
+}
+
 #ifdef BUILD_NAMEDTENSOR
 // ~~~~~~~~~~~~~~~~~~~~~~~~~ named tensor overloads ~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // In the short term, these exist.
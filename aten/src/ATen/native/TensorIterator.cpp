@@ -512,12 +512,15 @@ void TensorIterator::for_each(loop_t loop) {
 
 void TensorIterator::for_each(loop2d_t loop) {
   int64_t numel = this->numel();
+  // Elementwise loops driven through the iterator are memory bound, so use
+  // the (retunable) memory-bound threshold rather than the fixed GRAIN_SIZE.
+  int64_t grain_size = at::grain_size(ParallelWorkKind::MEMORY_BOUND);
   if (numel == 0) {
     return;
-  } else if (numel < internal::GRAIN_SIZE || at::get_num_threads() == 1) {
+  } else if (numel < grain_size || at::get_num_threads() == 1) {
     return serial_for_each(loop, {0, numel});
   } else {
-    at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    at::parallel_for(0, numel, grain_size, [&](int64_t begin, int64_t end) {
       serial_for_each(loop, {begin, end});
     });
   }
@@ -777,7 +780,7 @@ void TensorIterator::compute_shape() {
       shape_ = shape;
     } else if (!shape.equals(shape_)) {
       all_ops_same_shape_ = false;
-      shape_ = DimVector(infer_size(shape_, shape));
+      shape_ = infer_size_dimvector(shape_, shape);
     }
   }
   // Outputs cannot be broadcasted. Check that the shape of the outputs matches
@@ -956,6 +959,74 @@ void TensorIterator::build() {
   }
 }
 
+TensorIteratorPlan TensorIterator::extract_plan() const {
+  TORCH_CHECK(!shape_.empty() || numel() == 1,
+      "extract_plan: iterator has not been built");
+  TensorIteratorPlan plan;
+  plan.shape = shape_;
+  plan.num_outputs = num_outputs_;
+  plan.common_dtype = common_dtype_;
+  plan.is_reduction = is_reduction_;
+  plan.have_differing_types = have_differing_types_;
+  plan.common_dtype_strategy = common_dtype_strategy_;
+  for (auto& op : operands_) {
+    TORCH_CHECK(op.tensor.defined() && !op.original_tensor.defined(),
+        "extract_plan: only iterators whose operands were provided by the "
+        "caller (no allocation or dtype cast during build) can be planned");
+    TensorIteratorPlan::OperandPlan op_plan;
+    op_plan.sizes = DimVector(op.tensor.sizes());
+    op_plan.strides = DimVector(op.tensor.strides());
+    op_plan.dtype = op.tensor.scalar_type();
+    op_plan.device = op.device;
+    op_plan.stride_bytes = op.stride_bytes;
+    op_plan.is_read_write = op.is_read_write;
+    plan.operands.push_back(std::move(op_plan));
+  }
+  return plan;
+}
+
+bool TensorIteratorPlan::matches(ArrayRef<Tensor> tensors) const {
+  if (tensors.size() != operands.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < tensors.size(); i++) {
+    auto& t = tensors[i];
+    auto& op = operands[i];
+    if (!t.defined() ||
+        t.scalar_type() != op.dtype ||
+        t.device() != op.device ||
+        !t.sizes().equals(op.sizes) ||
+        !t.strides().equals(op.strides)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TensorIterator TensorIterator::from_plan(const TensorIteratorPlan& plan, ArrayRef<Tensor> tensors) {
+  TORCH_CHECK(plan.matches(tensors),
+      "from_plan: operands do not match the planned sizes/strides/dtypes");
+  auto iter = TensorIterator();
+  iter.shape_ = plan.shape;
+  iter.num_outputs_ = plan.num_outputs;
+  iter.common_dtype_ = plan.common_dtype;
+  iter.is_reduction_ = plan.is_reduction;
+  iter.have_differing_types_ = plan.have_differing_types;
+  iter.common_dtype_strategy_ = plan.common_dtype_strategy;
+  // build() already reordered and coalesced the planned strides
+  iter.has_coalesced_dimensions_ = true;
+  for (size_t i = 0; i < tensors.size(); i++) {
+    auto& op_plan = plan.operands[i];
+    auto op = OperandInfo(tensors[i], op_plan.device, op_plan.dtype);
+    op.stride_bytes = op_plan.stride_bytes;
+    op.is_output = i < static_cast<size_t>(plan.num_outputs);
+    op.is_read_write = op_plan.is_read_write;
+    op.data = tensors[i].data_ptr();
+    iter.operands_.push_back(std::move(op));
+  }
+  return iter;
+}
+
 SplitUntil32Bit TensorIterator::with_32bit_indexing() const {
   return SplitUntil32Bit(*this);
 }
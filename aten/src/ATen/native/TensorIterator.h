@@ -125,6 +125,7 @@ struct CAFFE2_API OperandInfo {
 };
 
 struct SplitUntil32Bit;
+struct TensorIteratorPlan;
 
 enum class CommonDTypeStrategy : uint8_t {
   NONE, // Do not compute a common dtype
@@ -332,6 +333,19 @@ struct CAFFE2_API TensorIterator {
 
   void build();
 
+  /// Captures the result of build() in a reusable plan. Only valid on a built
+  /// iterator whose outputs were provided by the caller (i.e. nothing was
+  /// allocated or cast inside build()). See TensorIteratorPlan.
+  TensorIteratorPlan extract_plan() const;
+
+  /// Constructs an already-built iterator from a plan captured by
+  /// extract_plan(), skipping broadcasting, type promotion, dimension
+  /// reordering and coalescing. `tensors` are the operands in the same order
+  /// as they were added to the original iterator (outputs first) and must
+  /// match the plan's recorded sizes, strides, dtypes and devices; this is
+  /// checked via TensorIteratorPlan::matches().
+  static TensorIterator from_plan(const TensorIteratorPlan& plan, ArrayRef<Tensor> tensors);
+
 protected:
   void mark_outputs();
   void check_mem_overlaps();
@@ -371,6 +385,47 @@ protected:
   bool have_differing_types_ = false;
   bool all_ops_same_shape_ = false;
 };
+/// A reusable record of the setup work done by TensorIterator::build().
+///
+/// Elementwise serving workloads often run the same op over the same shapes
+/// millions of times; broadcasting, type promotion, dimension reordering and
+/// coalescing are then pure overhead after the first call. A plan captures the
+/// post-build iteration state (iteration shape plus per-operand byte strides
+/// and expected tensor geometry) so that subsequent calls with matching
+/// operands can go straight to the inner loop:
+///
+///   auto iter = TensorIterator::binary_op(out, a, b);
+///   auto plan = iter.extract_plan();
+///   ...
+///   if (plan.matches({out, a, b})) {
+///     auto fast_iter = TensorIterator::from_plan(plan, {out, a, b});
+///     add_stub(kCPU, fast_iter, 1);
+///   }
+struct CAFFE2_API TensorIteratorPlan {
+  struct OperandPlan {
+    /// Geometry the bound tensor must have, as passed to the original build.
+    DimVector sizes;
+    DimVector strides;
+    ScalarType dtype = ScalarType::Undefined;
+    Device device = kCPU;
+    /// Stride (in bytes) after broadcasting, reordering and coalescing.
+    TensorIterator::StrideVector stride_bytes;
+    bool is_read_write = false;
+  };
+
+  /// True if `tensors` (outputs first, then inputs) have the exact geometry
+  /// recorded in this plan.
+  bool matches(ArrayRef<Tensor> tensors) const;
+
+  DimVector shape;
+  SmallVector<OperandPlan, 4> operands;
+  int num_outputs = 0;
+  ScalarType common_dtype = ScalarType::Undefined;
+  bool is_reduction = false;
+  bool have_differing_types = false;
+  CommonDTypeStrategy common_dtype_strategy = CommonDTypeStrategy::CHECK;
+};
+
 /// A container-like struct that acts as if it contains splits of a
 /// TensorIterator that can use 32-bit indexing. Taken together the splits cover
 /// the original TensorIterator.
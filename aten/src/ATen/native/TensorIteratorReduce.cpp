@@ -26,8 +26,39 @@ void TensorIterator::parallel_reduce(loop2d_t loop) {
   }
 }
 
+/// The largest extent a single-dimension split can hand to the thread pool.
+/// Mirrors find_split_dim below: only the outer run of non-reduced
+/// dimensions can be narrowed, so the scan stops at the first reduced one.
+static int64_t max_split_size(TensorIterator& iter) {
+  auto shape = iter.shape();
+  int64_t best = 1;
+  for (int dim = iter.ndim() - 1; dim >= 0 && !iter.is_dim_reduced(dim); dim--) {
+    best = std::max(best, (int64_t)shape[dim]);
+  }
+  return best;
+}
+
+/// Strategy planner for parallel_reduce. Two-pass reduction (per-thread
+/// partial buffers combined in a second pass) is always right when the
+/// whole tensor reduces to one element. It also wins for tall-skinny
+/// shapes - e.g. sum(dim=0) of [N, C] with small C - where every
+/// splittable dimension is smaller than the thread pool, so a
+/// single-dimension split would leave most threads idle while each output
+/// element still reduces over a long column. The buffer costs
+/// out_numel * nthreads elements, so the planner additionally requires the
+/// reduction to be long enough to amortize the second pass.
 static bool use_two_pass_reduction(TensorIterator& iter) {
-  return iter.output(0).numel() == 1;
+  const int64_t out_numel = iter.output(0).numel();
+  if (out_numel == 1) {
+    return true;
+  }
+  const int64_t num_threads = at::get_num_threads();
+  if (max_split_size(iter) >= num_threads) {
+    return false;
+  }
+  const int64_t reduce_extent = iter.numel() / out_numel;
+  return reduce_extent >= 2 * num_threads &&
+      out_numel * num_threads <= iter.numel() / 2;
 }
 
 static void two_pass_reduction(TensorIterator& iter, loop2d_t loop) {
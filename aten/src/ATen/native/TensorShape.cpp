@@ -1,15 +1,18 @@
 #include <TH/THTensor.hpp>
 #include <algorithm>
+#include <cstring>
 #include <vector>
 #include <ATen/ATen.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/InferSize.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/Parallel.h>
 #include <ATen/WrapDimUtils.h>
 #include <c10/util/Exception.h>
 #include <c10/util/Optional.h>
 #include <ATen/native/Resize.h>
 #include <ATen/SparseTensorUtils.h>
+#include <ATen/native/sparse/SparseTensorMath.h>
 #include <ATen/quantized/QTensorImpl.h>
 #include <algorithm>
 #include <vector>
@@ -58,6 +61,141 @@ static void check_cat_no_zero_dim(TensorList tensors) {
   }
 }
 
+// For backwards compatibility with the legacy TH kernel, 1-dimensional empty
+// tensors (the only empty shape expressible under the legacy rules) are
+// skipped rather than concatenated; other empty sizes participate normally.
+static inline bool cat_should_skip_tensor(const Tensor& t) {
+  return t.dim() == 1 && t.numel() == 0;
+}
+
+static void check_cat_shape_except_dim(const Tensor& first, const Tensor& second, int64_t dimension) {
+  int64_t first_dims = first.dim();
+  int64_t second_dims = second.dim();
+  TORCH_CHECK(first_dims == second_dims,
+      "Tensors must have same number of dimensions: got ", first_dims,
+      " and ", second_dims);
+  for (int64_t dim = 0; dim < first_dims; ++dim) {
+    if (dim == dimension) {
+      continue;
+    }
+    TORCH_CHECK(first.size(dim) == second.size(dim),
+        "Sizes of tensors must match except in dimension ", dimension,
+        ". Got ", first.size(dim), " and ", second.size(dim),
+        " in dimension ", dim);
+  }
+}
+
+Tensor& _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
+  // The first non-skipped tensor determines the dimensionality of the result.
+  const Tensor* notSkippedTensor = nullptr;
+  for (auto const& t : tensors) {
+    if (!cat_should_skip_tensor(t)) {
+      notSkippedTensor = &t;
+      break;
+    }
+  }
+  if (notSkippedTensor == nullptr) {
+    // All inputs were skipped; leave the result untouched, as TH did.
+    return result;
+  }
+  int64_t nDims = notSkippedTensor->dim();
+  TORCH_CHECK(dim < nDims, "invalid dimension ", dim);
+
+  // Validate the inputs and compute the result shape in one pass up front,
+  // so the copy phase below only has to move bytes.
+  int64_t cat_dim_size = 0;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    const Tensor& t = tensors[i];
+    if (cat_should_skip_tensor(t)) {
+      continue;
+    }
+    TORCH_CHECK(t.scalar_type() == result.scalar_type(),
+        "Expected object of scalar type ", result.scalar_type(),
+        " but got scalar type ", t.scalar_type(),
+        " for sequence element ", i);
+    check_cat_shape_except_dim(*notSkippedTensor, t, dim);
+    cat_dim_size += t.size(dim);
+  }
+
+  auto size = notSkippedTensor->sizes().vec();
+  size[dim] = cat_dim_size;
+  result.resize_(size);
+  if (result.numel() == 0) {
+    return result;
+  }
+
+  bool allContiguous = result.is_contiguous();
+  for (auto const& t : tensors) {
+    if (!cat_should_skip_tensor(t)) {
+      allContiguous = allContiguous && t.is_contiguous();
+    }
+  }
+
+  if (allContiguous) {
+    // Every (outer slice, input) pair owns one contiguous destination span,
+    // so all spans can be copied with plain memcpy in a single parallel_for,
+    // instead of one dispatched narrow+copy_ per input.
+    int64_t outer = 1;
+    for (int64_t i = 0; i < dim; ++i) {
+      outer *= size[i];
+    }
+    int64_t inner = 1;
+    for (int64_t i = dim + 1; i < nDims; ++i) {
+      inner *= size[i];
+    }
+    const int64_t itemsize = static_cast<int64_t>(result.element_size());
+    std::vector<const char*> input_data;
+    std::vector<int64_t> input_bytes;   // bytes one input contributes per outer slice
+    std::vector<int64_t> input_offsets; // byte offset of the input inside an outer slice
+    int64_t slice_bytes = 0;
+    for (auto const& t : tensors) {
+      if (cat_should_skip_tensor(t)) {
+        continue;
+      }
+      input_data.push_back(static_cast<const char*>(t.data_ptr()));
+      input_bytes.push_back(t.size(dim) * inner * itemsize);
+      input_offsets.push_back(slice_bytes);
+      slice_bytes += input_bytes.back();
+    }
+    char* result_data = static_cast<char*>(result.data_ptr());
+    const int64_t ninputs = static_cast<int64_t>(input_data.size());
+    const int64_t region_elems =
+        std::max<int64_t>(1, slice_bytes / (itemsize * ninputs));
+    const int64_t grain =
+        std::max<int64_t>(1, at::internal::GRAIN_SIZE / region_elems);
+    at::parallel_for(0, outer * ninputs, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t r = begin; r < end; ++r) {
+        const int64_t o = r / ninputs;
+        const int64_t j = r % ninputs;
+        if (input_bytes[j] != 0) {
+          memcpy(
+              result_data + o * slice_bytes + input_offsets[j],
+              input_data[j] + o * input_bytes[j],
+              input_bytes[j]);
+        }
+      }
+    });
+  } else {
+    int64_t offset = 0;
+    for (auto const& t : tensors) {
+      if (cat_should_skip_tensor(t)) {
+        continue;
+      }
+      int64_t dimSize = t.size(dim);
+      Tensor nt = result.narrow(dim, offset, dimSize);
+      nt.copy_(t, false);
+      offset += dimSize;
+    }
+  }
+  return result;
+}
+
+Tensor _cat_cpu(TensorList tensors, int64_t dim) {
+  TORCH_CHECK(tensors.size() > 0, "_cat_cpu(): expected a non-empty list of Tensors");
+  Tensor result = at::empty({0}, tensors[0].options());
+  return _cat_out_cpu(result, tensors, dim);
+}
+
 Tensor & cat_out(Tensor & result, TensorList tensors, int64_t dim) {
   check_cat_no_zero_dim(tensors);
   dim = legacy_cat_wrap_dim(dim, tensors);
@@ -329,9 +467,10 @@ Tensor expand(const Tensor& self, IntArrayRef size, bool implicit) {
            "must be greater or equal to the number of dimensions in the tensor (",
            self.dim(), ")");
 
-  std::vector<int64_t> expandedSizes;
-  std::vector<int64_t> expandedStrides;
-  std::tie(expandedSizes, expandedStrides) = inferExpandGeometry(self.sizes(), self.strides(), size);
+  DimVector expandedSizes;
+  DimVector expandedStrides;
+  std::tie(expandedSizes, expandedStrides) =
+      inferExpandGeometry_dimvector(self.sizes(), self.strides(), size);
 
   auto result = self.as_strided(expandedSizes, expandedStrides);
 #ifdef BUILD_NAMEDTENSOR
@@ -862,6 +1001,13 @@ Tensor transpose(const Tensor & self, int64_t dim0, int64_t dim1) {
   }
 
   if (self.is_sparse()) {
+    // A coalesced 2-d matrix reuses the transpose structure memoized on its
+    // impl, so repeated backward passes over a fixed sparsity pattern (e.g.
+    // addmm against a static adjacency matrix) skip the re-sort entirely.
+    if (self.sparse_dim() == 2 && self.dense_dim() == 0 &&
+        self.is_coalesced() && self._nnz() > 0) {
+      return sparse_transpose2d_cached(self);
+    }
     Tensor self_clone = self.clone();  // yes, this is what THS does
     return sparse_transpose_(self_clone, dim0, dim1);
   }
@@ -6,46 +6,64 @@
 #include <ATen/Parallel.h>
 #include <ATen/native/TriangularOpsUtils.h>
 
+#include <cstring>
+
 namespace at {
 namespace native {
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ triu/tril ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+// Handles one row of the (batched) matrix: zeroes the masked-out segment and,
+// when not inplace, copies the kept segment from self. Both segments are
+// contiguous column ranges, so unit-column-stride rows reduce to a memset and
+// a memcpy instead of per-element stores.
 template <typename scalar_t, bool upper>
-static void apply_triu_tril_single(
-    scalar_t* result, scalar_t* self, bool inplace,
-    int64_t k, int64_t n, int64_t m,
-    int64_t res_row_stride, int64_t res_col_stride,
-    int64_t self_row_stride, int64_t self_col_stride) {
+static void apply_triu_tril_row(
+    scalar_t* result_row, scalar_t* self_row, bool inplace,
+    int64_t k, int64_t i, int64_t m,
+    int64_t res_col_stride, int64_t self_col_stride) {
 
   constexpr int64_t zero = 0;
 
+  int64_t zero_begin, zero_end, copy_begin, copy_end;
   if (upper) {
-    at::parallel_for(0, n, 0, [&](int64_t start, int64_t end) {
-      for (auto i = start; i < end; i++) {
-        for (int64_t j = 0; j < std::min(m, i + k); j++) {
-          result[i * res_row_stride + j * res_col_stride] = 0;
-        }
-        if (!inplace) {  // copy the rest of the self if not inplace
-          for (int64_t j = std::max(zero, i + k); j < m; j++) {
-            result[i * res_row_stride + j * res_col_stride] = self[i * self_row_stride + j * self_col_stride];
-          }
+    zero_begin = zero;
+    zero_end = std::min(m, i + k);
+    copy_begin = std::max(zero, i + k);
+    copy_end = m;
+  } else {
+    zero_begin = std::max(zero, i + k + 1);
+    zero_end = m;
+    copy_begin = zero;
+    copy_end = std::min(m, i + k + 1);
+  }
+
+  if (res_col_stride == 1) {
+    if (zero_end > zero_begin) {
+      std::memset(
+          result_row + zero_begin, 0, (zero_end - zero_begin) * sizeof(scalar_t));
+    }
+    if (!inplace && copy_end > copy_begin) {
+      if (self_col_stride == 1) {
+        std::memcpy(
+            result_row + copy_begin,
+            self_row + copy_begin,
+            (copy_end - copy_begin) * sizeof(scalar_t));
+      } else {
+        for (int64_t j = copy_begin; j < copy_end; j++) {
+          result_row[j] = self_row[j * self_col_stride];
         }
       }
-    });
+    }
   } else {
-    at::parallel_for(0, n, 0, [&](int64_t start, int64_t end) {
-      for (auto i = start; i < end; i++) {
-        for (int64_t j = std::max(zero, i + k + 1); j < m; j++) {
-          result[i * res_row_stride + j * res_col_stride] = 0;
-        }
-        if (!inplace) {  // copy the rest of the self if not inplace
-          for (int64_t j = zero; j < std::min(m, i + k + 1); j++) {
-            result[i * res_row_stride + j * res_col_stride] = self[i * self_row_stride + j * self_col_stride];
-          }
-        }
+    for (int64_t j = zero_begin; j < zero_end; j++) {
+      result_row[j * res_col_stride] = 0;
+    }
+    if (!inplace) {  // copy the rest of the self if not inplace
+      for (int64_t j = copy_begin; j < copy_end; j++) {
+        result_row[j * res_col_stride] = self_row[j * self_col_stride];
       }
-    });
+    }
   }
 }
 
@@ -71,13 +89,17 @@ void apply_triu_tril(Tensor& result, const Tensor& self, bool inplace, int64_t k
     result_column_stride = self_column_stride;
   }
 
-  at::parallel_for(0, batchsize, 0, [&](int64_t start, int64_t end) {
-    for (auto b = start; b < end; b++) {
-      scalar_t* self_batch = &self_data[b * self_stride];
-      scalar_t* result_batch = &result_data[b * result_stride];
-      apply_triu_tril_single<scalar_t, upper>(
-          result_batch, self_batch, inplace, k, n, m,
-          result_row_stride, result_column_stride, self_row_stride, self_column_stride);
+  // Split the flattened (batch, row) index range across the thread pool so
+  // that both many small matrices and a single large one use all threads.
+  at::parallel_for(0, batchsize * n, 0, [&](int64_t start, int64_t end) {
+    for (auto idx = start; idx < end; idx++) {
+      int64_t b = idx / n;
+      int64_t i = idx % n;
+      scalar_t* self_row = &self_data[b * self_stride + i * self_row_stride];
+      scalar_t* result_row = &result_data[b * result_stride + i * result_row_stride];
+      apply_triu_tril_row<scalar_t, upper>(
+          result_row, self_row, inplace, k, i, m,
+          result_column_stride, self_column_stride);
     }
   });
 }
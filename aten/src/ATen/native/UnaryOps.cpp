@@ -15,6 +15,7 @@
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/native/UnaryOps.h>
+#include <ATen/native/SmallTensorFastPath.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/core/EnableNamedTensor.h>
@@ -145,6 +146,10 @@ Tensor& neg_out(Tensor& result, const Tensor& self) {
   TORCH_CHECK(self.scalar_type() != kBool,
               "Negation, the `-` operator, on a bool tensor is not supported. "
               "If you are trying to invert a mask, use the `~` or `logical_not()` operator instead.");
+  if (can_use_small_tensor_fast_path(result, self)) {
+    return small_tensor_unary_kernel(result, self, "neg_small_cpu",
+        [](auto a) { return -a; });
+  }
   return unary_op_impl_out(result, self, neg_stub);
 }
 Tensor neg(const Tensor& self) { return unary_op_impl(self, at::neg_out); }
@@ -2,6 +2,8 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/SortingUtils.h>
 
 #include <set>
 #include <tuple>
@@ -26,16 +28,32 @@ std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
   Tensor inverse_indices = at::empty({0}, self.options().dtype(kLong));
   Tensor counts = at::empty({0}, self.options().dtype(kLong));
 
-  std::unordered_set<scalar_t> set(input_data, input_data + numel);
+  // Each worker hashes its own stretch of the input into a local set, so
+  // the expensive O(numel) insertion phase scales with the core count; the
+  // merge phase only touches the (typically far smaller) unique values.
+  const int num_threads = at::get_num_threads();
+  std::vector<std::unordered_set<scalar_t>> local_sets(num_threads);
+  at::parallel_for(
+      0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        local_sets[at::get_thread_num()].insert(
+            input_data + begin, input_data + end);
+      });
+  size_t unique_upper_bound = 0;
+  for (const auto& local_set : local_sets) {
+    unique_upper_bound += local_set.size();
+  }
+  std::unordered_set<scalar_t> set;
+  set.reserve(unique_upper_bound);
+  for (auto& local_set : local_sets) {
+    set.insert(local_set.begin(), local_set.end());
+  }
+
   output = at::empty({static_cast<int64_t>(set.size())}, input.options());
   scalar_t *output_data = output.data_ptr<scalar_t>();
-
+  std::copy(set.begin(), set.end(), output_data);
   if (sorted) {
-    std::vector<scalar_t> vec(set.begin(), set.end());
-    std::sort(vec.begin(), vec.end());
-    std::copy(vec.begin(), vec.end(), output_data);
-  } else {
-    std::copy(set.begin(), set.end(), output_data);
+    parallel_merge_sort(
+        output_data, output.numel(), std::less<scalar_t>());
   }
 
   if (return_inverse || return_counts) {
@@ -46,23 +64,24 @@ std::tuple<Tensor, Tensor, Tensor> unique_cpu_template(
     for (int64_t i = 0; i < output.numel(); ++i) {
       inverse_map[output_data[i]] = i;
     }
-    for(int64_t i = 0; i < numel; ++i) {
-      inverse_indices_data[i] = inverse_map[input_data[i]];
-    }
+    // Read-only lookups, so the O(numel) pass can run in parallel. NaN
+    // never compares equal to a stored key and maps to index 0, as the old
+    // operator[] code did.
+    at::parallel_for(
+        0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            const auto it = inverse_map.find(input_data[i]);
+            inverse_indices_data[i] = it == inverse_map.end() ? 0 : it->second;
+          }
+        });
     if (return_counts) {
-      std::unordered_map<scalar_t, int64_t> counts_map;
-      counts_map.reserve(output.numel());
-      for (int64_t i = 0; i < output.numel(); ++i) {
-        counts_map[output_data[i]] = 0;
-      }
-      for(int64_t i = 0; i < numel; i++) {
-        counts_map[input_data[i]] += 1;
-      }
       counts.resize_(output.sizes());
       counts.fill_(0);
       int64_t *counts_data = counts.data_ptr<int64_t>();
-      for(int64_t i = 0; i < output.numel(); i++) {
-        counts_data[i] = counts_map[output_data[i]];
+      // One increment per element off the already-computed inverse
+      // indices, instead of a third hashing pass over the input.
+      for (int64_t i = 0; i < numel; ++i) {
+        ++counts_data[inverse_indices_data[i]];
       }
     }
   }
@@ -2,10 +2,20 @@
 
 #include <ATen/ATen.h>
 #include <ATen/TensorUtils.h>
+#include <ATen/native/DispatchStub.h>
 
 namespace at {
 namespace native {
 
+// Parallel forward kernels for the common float/double dtypes; the callers
+// keep the serial frame code for everything else.
+using upsample_nearest2d_fn = void (*)(Tensor& output, const Tensor& input);
+using upsample_bilinear2d_fn =
+    void (*)(Tensor& output, const Tensor& input, bool align_corners);
+
+DECLARE_DISPATCH(upsample_nearest2d_fn, upsample_nearest2d_stub);
+DECLARE_DISPATCH(upsample_bilinear2d_fn, upsample_bilinear2d_stub);
+
 static inline void upsample_1d_shape_check(
     const Tensor& input,
     const Tensor& grad_output,
@@ -5,6 +5,8 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/UpSample.h>
 
+#include <algorithm>
+
 namespace at {
 namespace native {
 namespace {
@@ -154,6 +156,73 @@ static void upsample_bilinear2d_backward_out_frame(
   }
 }
 
+// Channels-last variant: the four source corners of each output pixel hold
+// all channels contiguously, so the interpolation runs as straight-line
+// passes over the channel dimension the compiler can vectorize.
+template <typename scalar_t>
+static void upsample_bilinear2d_out_frame_channels_last(
+    scalar_t* odata,
+    const scalar_t* idata,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    int64_t nbatch,
+    int64_t channels,
+    bool align_corners) {
+  // special case: just copy
+  if (input_height == output_height && input_width == output_width) {
+    std::copy(
+        idata,
+        idata + nbatch * channels * input_height * input_width,
+        odata);
+    return;
+  }
+  const scalar_t rheight = area_pixel_compute_scale<scalar_t>(
+      input_height, output_height, align_corners);
+
+  const scalar_t rwidth = area_pixel_compute_scale<scalar_t>(
+      input_width, output_width, align_corners);
+
+  for (int64_t n = 0; n < nbatch; ++n) {
+    const scalar_t* idata_n = idata + n * input_height * input_width * channels;
+    scalar_t* odata_n = odata + n * output_height * output_width * channels;
+
+    for (int64_t h2 = 0; h2 < output_height; ++h2) {
+      const scalar_t h1r = area_pixel_compute_source_index<scalar_t>(
+          rheight, h2, align_corners, /*cubic=*/false);
+
+      const int64_t h1 = h1r;
+      const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
+
+      const scalar_t h1lambda = h1r - h1;
+      const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
+
+      for (int64_t w2 = 0; w2 < output_width; ++w2) {
+        const scalar_t w1r = area_pixel_compute_source_index<scalar_t>(
+            rwidth, w2, align_corners, /*cubic=*/false);
+
+        const int64_t w1 = w1r;
+        const int64_t w1p = (w1 < input_width - 1) ? 1 : 0;
+
+        const scalar_t w1lambda = w1r - w1;
+        const scalar_t w0lambda = static_cast<scalar_t>(1.) - w1lambda;
+
+        const scalar_t* pos00 = idata_n + (h1 * input_width + w1) * channels;
+        const scalar_t* pos01 = pos00 + w1p * channels;
+        const scalar_t* pos10 = pos00 + h1p * input_width * channels;
+        const scalar_t* pos11 = pos10 + w1p * channels;
+        scalar_t* pos2 = odata_n + (h2 * output_width + w2) * channels;
+
+        for (int64_t c = 0; c < channels; ++c) {
+          pos2[c] = h0lambda * (w0lambda * pos00[c] + w1lambda * pos01[c]) +
+              h1lambda * (w0lambda * pos10[c] + w1lambda * pos11[c]);
+        }
+      }
+    }
+  }
+}
+
 static void upsample_bilinear2d_out_cpu_template(
     Tensor& output,
     const Tensor& input_,
@@ -182,29 +251,61 @@ static void upsample_bilinear2d_out_cpu_template(
       output_height,
       output_width);
 
-  auto input = input_.contiguous();
+  // Keep channels-last inputs in channels-last, so NHWC pipelines don't pay
+  // for a transpose on either side of the op.
+  const bool channels_last =
+      input_.is_contiguous(at::MemoryFormat::ChannelsLast);
 
-  output.resize_({nbatch, channels, output_height, output_width});
-  output.zero_();
+  auto input = channels_last
+      ? input_.contiguous(at::MemoryFormat::ChannelsLast)
+      : input_.contiguous();
 
+  output.resize_({nbatch, channels, output_height, output_width});
+  if (channels_last) {
+    output.unsafeGetTensorImpl()->empty_tensor_restride(
+        MemoryFormat::ChannelsLast);
+  }
   AT_ASSERT(
       input_height > 0 && input_width > 0 && output_height > 0 &&
       output_width > 0);
 
+  if (input.scalar_type() == at::ScalarType::Float ||
+      input.scalar_type() == at::ScalarType::Double) {
+    // The stub kernel overwrites every output element, so the zero fill
+    // below is only needed on the fallback path.
+    upsample_bilinear2d_stub(kCPU, output, input, align_corners);
+    return;
+  }
+
+  output.zero_();
+
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bilinear2d", [&] {
     auto* idata = input.data_ptr<scalar_t>();
     auto* odata = output.data_ptr<scalar_t>();
 
-    upsample_bilinear2d_out_frame<scalar_t>(
-        odata,
-        idata,
-        input_height,
-        input_width,
-        output_height,
-        output_width,
-        nbatch,
-        channels,
-        align_corners);
+    if (channels_last) {
+      upsample_bilinear2d_out_frame_channels_last<scalar_t>(
+          odata,
+          idata,
+          input_height,
+          input_width,
+          output_height,
+          output_width,
+          nbatch,
+          channels,
+          align_corners);
+    } else {
+      upsample_bilinear2d_out_frame<scalar_t>(
+          odata,
+          idata,
+          input_height,
+          input_width,
+          output_height,
+          output_width,
+          nbatch,
+          channels,
+          align_corners);
+    }
   });
 }
 
@@ -266,6 +367,8 @@ static void upsample_bilinear2d_backward_out_cpu_template(
 }
 } // namespace
 
+DEFINE_DISPATCH(upsample_bilinear2d_stub);
+
 Tensor& upsample_bilinear2d_out_cpu(
     Tensor& output,
     const Tensor& input,
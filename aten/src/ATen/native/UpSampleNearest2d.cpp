@@ -145,10 +145,19 @@ static void upsample_nearest2d_out_cpu_template(
   auto input = input_.contiguous();
 
   output.resize_({nbatch, channels, output_height, output_width});
-  output.zero_();
 
   AT_ASSERT(input_width > 0 && output_width > 0);
 
+  if (input.scalar_type() == at::ScalarType::Float ||
+      input.scalar_type() == at::ScalarType::Double) {
+    // The stub kernel overwrites every output element, so the zero fill
+    // below is only needed on the fallback path.
+    upsample_nearest2d_stub(kCPU, output, input);
+    return;
+  }
+
+  output.zero_();
+
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_nearest2d", [&] {
     auto* idata = input.data_ptr<scalar_t>();
     auto* odata = output.data_ptr<scalar_t>();
@@ -221,6 +230,8 @@ static void upsample_nearest2d_backward_out_cpu_template(
 }
 } // namespace
 
+DEFINE_DISPATCH(upsample_nearest2d_stub);
+
 Tensor& upsample_nearest2d_out_cpu(
     Tensor& output,
     const Tensor& input,
@@ -135,11 +135,79 @@ void GeluBackwardMKLKernelImpl(TensorIterator* /* it */) {
 
 #endif // AT_MKL_ENABLED()
 
-// TODO(yangxm): Add another fast kernel using formula
-// y = 0.5x * (1 + tanh(sqrt(2/Pi) * (x + 0.044715x^3)))
-// and the fast tanh impl from Eigen.
-void GeluKernelImpl(TensorIterator& it) {
-  if (at::hasMKL() && it.is_contiguous()) {
+// The tanh approximation from the GELU paper:
+//   y = 0.5x * (1 + tanh(sqrt(2/Pi) * (x + 0.044715x^3)))
+// Used by BERT-style models; opted into via gelu(x, approximate=True).
+void GeluTanhKernelImpl(TensorIterator& it) {
+  AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluTanhKernelImpl", [&]() {
+    using Vec = vec256::Vec256<scalar_t>;
+    const Vec kBetaVec(M_2_SQRTPI * M_SQRT1_2);
+    const Vec kKappaVec(0.044715);
+    const Vec kOneVec(1);
+    const Vec kPointFiveVec(0.5);
+    cpu_kernel_vec(
+        it,
+        [](scalar_t x) {
+          constexpr scalar_t kBeta = M_2_SQRTPI * M_SQRT1_2;
+          constexpr scalar_t kKappa = 0.044715;
+          const scalar_t inner = kBeta * (x + kKappa * x * x * x);
+          return x * scalar_t(0.5) * (scalar_t(1) + std::tanh(inner));
+        },
+        [&](Vec x_vec) {
+          const Vec inner_vec =
+              kBetaVec * (x_vec + kKappaVec * x_vec * x_vec * x_vec);
+          return x_vec * kPointFiveVec * (kOneVec + inner_vec.tanh());
+        });
+  });
+}
+
+void GeluTanhBackwardKernelImpl(TensorIterator& it) {
+  AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluTanhBackwardKernelImpl", [&]() {
+    using Vec = vec256::Vec256<scalar_t>;
+    const Vec kBetaVec(M_2_SQRTPI * M_SQRT1_2);
+    const Vec kKappaVec(0.044715);
+    const Vec kThreeKappaVec(3 * 0.044715);
+    const Vec kOneVec(1);
+    const Vec kPointFiveVec(0.5);
+    cpu_kernel_vec(
+        it,
+        [](scalar_t dy, scalar_t x) {
+          constexpr scalar_t kBeta = M_2_SQRTPI * M_SQRT1_2;
+          constexpr scalar_t kKappa = 0.044715;
+          const scalar_t inner = kBeta * (x + kKappa * x * x * x);
+          const scalar_t tanh_inner = std::tanh(inner);
+          const scalar_t left = scalar_t(0.5) * x;
+          const scalar_t right = scalar_t(1) + tanh_inner;
+          const scalar_t left_derivative = scalar_t(0.5) * right;
+          const scalar_t tanh_derivative =
+              scalar_t(1) - tanh_inner * tanh_inner;
+          const scalar_t inner_derivative =
+              kBeta * (scalar_t(1) + scalar_t(3) * kKappa * x * x);
+          const scalar_t right_derivative =
+              left * tanh_derivative * inner_derivative;
+          return dy * (left_derivative + right_derivative);
+        },
+        [&](Vec dy_vec, Vec x_vec) {
+          const Vec inner_vec =
+              kBetaVec * (x_vec + kKappaVec * x_vec * x_vec * x_vec);
+          const Vec tanh_inner_vec = inner_vec.tanh();
+          const Vec right_vec = kOneVec + tanh_inner_vec;
+          const Vec left_derivative_vec = kPointFiveVec * right_vec;
+          const Vec tanh_derivative_vec =
+              kOneVec - tanh_inner_vec * tanh_inner_vec;
+          const Vec inner_derivative_vec =
+              kBetaVec * (kOneVec + kThreeKappaVec * x_vec * x_vec);
+          const Vec right_derivative_vec = kPointFiveVec * x_vec *
+              tanh_derivative_vec * inner_derivative_vec;
+          return dy_vec * (left_derivative_vec + right_derivative_vec);
+        });
+  });
+}
+
+void GeluKernelImpl(TensorIterator& it, bool approximate) {
+  if (approximate) {
+    GeluTanhKernelImpl(it);
+  } else if (at::hasMKL() && it.is_contiguous()) {
     AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluKernelImpl", [&]() {
       GeluMKLKernelImpl<scalar_t>(&it);
     });
@@ -163,8 +231,10 @@ void GeluKernelImpl(TensorIterator& it) {
   }
 }
 
-void GeluBackwardKernelImpl(TensorIterator& it) {
-  if (hasMKL() && it.is_contiguous()) {
+void GeluBackwardKernelImpl(TensorIterator& it, bool approximate) {
+  if (approximate) {
+    GeluTanhBackwardKernelImpl(it);
+  } else if (hasMKL() && it.is_contiguous()) {
     AT_DISPATCH_FLOATING_TYPES(it.dtype(), "GeluBackwardKernelImpl", [&]() {
       GeluBackwardMKLKernelImpl<scalar_t>(&it);
     });
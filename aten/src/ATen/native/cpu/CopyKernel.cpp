@@ -1,15 +1,125 @@
 #include <ATen/ATen.h>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/intrinsics.h>
+#include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/Copy.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <c10/util/TypeCast.h>
 
+#include <cstring>
+
 namespace at {
 namespace native {
 namespace {
 
+// Below this size a copy is not worth the fork/join overhead of the thread
+// pool; a single-threaded memcpy already runs at cache speed.
+constexpr int64_t PARALLEL_COPY_MIN_BYTES = 2 * 1024 * 1024;
+
+// Above this size the destination is far outside any cache level, so
+// non-temporal stores avoid both polluting the cache and the
+// read-for-ownership traffic of regular stores (~1/3 of bus bandwidth).
+constexpr int64_t NON_TEMPORAL_MIN_BYTES = 32 * 1024 * 1024;
+
+// Chunks handed to the thread pool are multiples of this so that no two
+// workers ever write to the same cache line.
+constexpr int64_t COPY_CHUNK_BYTES = 4096;
+
+void memcpy_non_temporal(char* dst, const char* src, int64_t n) {
+#if defined(__AVX__) && !defined(_MSC_VER)
+  // Streaming stores require 32-byte-aligned destinations; copy the
+  // unaligned head (and below, the tail) with a plain memcpy.
+  int64_t head = (-reinterpret_cast<intptr_t>(dst)) & 31;
+  head = std::min(head, n);
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  n -= head;
+
+  int64_t vec_n = n & ~static_cast<int64_t>(31);
+  for (int64_t i = 0; i < vec_n; i += 32) {
+    auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + i), v);
+  }
+  if (vec_n > 0) {
+    _mm_sfence();
+  }
+  std::memcpy(dst + vec_n, src + vec_n, n - vec_n);
+#else
+  std::memcpy(dst, src, n);
+#endif
+}
+
+// Fast path for large same-dtype contiguous copies (copy_, contiguous(),
+// cat): split the flat byte range across the thread pool instead of running
+// memcpy on a single core, which caps out at one core's share of memory
+// bandwidth.
+bool try_parallel_copy(TensorIterator& iter) {
+  if (!iter.is_contiguous() || at::in_parallel_region()) {
+    return false;
+  }
+  const int64_t total_bytes = iter.numel() * iter.element_size(0);
+  if (total_bytes < PARALLEL_COPY_MIN_BYTES || at::get_num_threads() == 1) {
+    return false;
+  }
+  char* dst = static_cast<char*>(iter.data_ptr(0));
+  const char* src = static_cast<const char*>(iter.data_ptr(1));
+  const bool non_temporal = total_bytes >= NON_TEMPORAL_MIN_BYTES;
+  at::parallel_for(0, total_bytes, COPY_CHUNK_BYTES, [&](int64_t begin, int64_t end) {
+    // Round chunk boundaries so each worker owns whole cache lines.
+    begin = begin - (begin % COPY_CHUNK_BYTES);
+    if (end != total_bytes) {
+      end = end - (end % COPY_CHUNK_BYTES);
+    }
+    if (begin >= end) {
+      return;
+    }
+    if (non_temporal) {
+      memcpy_non_temporal(dst + begin, src + begin, end - begin);
+    } else {
+      std::memcpy(dst + begin, src + begin, end - begin);
+    }
+  });
+  return true;
+}
+
+// Fast path for contiguous fp16<->fp32 conversions, which bracket every
+// mixed-precision stage (master-weight copies, activations handed to fp32
+// ops): vec256::convert is specialized with F16C
+// _mm256_cvtph_ps/_mm256_cvtps_ph on capable builds, while cpu_kernel would
+// convert element-wise through the scalar routines in c10/util/Half-inl.h.
+bool try_half_float_conversion(TensorIterator& iter) {
+  const ScalarType dst_type = iter.dtype(0);
+  const ScalarType src_type = iter.dtype(1);
+  const bool half_to_float =
+      dst_type == ScalarType::Float && src_type == ScalarType::Half;
+  const bool float_to_half =
+      dst_type == ScalarType::Half && src_type == ScalarType::Float;
+  if ((!half_to_float && !float_to_half) || !iter.is_contiguous()) {
+    return false;
+  }
+  const int64_t numel = iter.numel();
+  if (half_to_float) {
+    const auto* src = static_cast<const at::Half*>(iter.data_ptr(1));
+    auto* dst = static_cast<float*>(iter.data_ptr(0));
+    at::parallel_for(
+        0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          vec256::convert(src + begin, dst + begin, end - begin);
+        });
+  } else {
+    const auto* src = static_cast<const float*>(iter.data_ptr(1));
+    auto* dst = static_cast<at::Half*>(iter.data_ptr(0));
+    at::parallel_for(
+        0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+          vec256::convert(src + begin, dst + begin, end - begin);
+        });
+  }
+  return true;
+}
+
 template <typename self_T>
 void copy_kernel_cast(TensorIterator& iter) {
     if (isComplexType(iter.dtype(1))) {
@@ -69,6 +179,9 @@ void copy_kernel_cast<std::complex<double>>(TensorIterator& iter) {
 static void copy_kernel(TensorIterator& iter, bool non_blocking) {
   ScalarType dtype = iter.dtype(0);
   if (dtype == iter.dtype(1)) {
+    if (try_parallel_copy(iter)) {
+      return;
+    }
     if (dtype == ScalarType::Half) {
       cpu_kernel(iter, [=](at::Half a) -> at::Half { return a; });
     } else if (dtype == ScalarType::BFloat16) {
@@ -95,6 +208,9 @@ static void copy_kernel(TensorIterator& iter, bool non_blocking) {
           });
     }
   } else {
+    if (try_half_float_conversion(iter)) {
+      return;
+    }
     AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(ScalarType::Half, ScalarType::Bool, ScalarType::BFloat16, dtype, "copy_", [&] {
       copy_kernel_cast<scalar_t>(iter);
     });
@@ -0,0 +1,209 @@
+#include <ATen/native/cross_entropy_loss.h>
+
+#include <cmath>
+#include <cstring>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at {
+namespace native {
+
+namespace {
+
+// Computes max + log(sum(exp(x - max))) of one row in two vectorized passes.
+template <typename scalar_t>
+scalar_t RowwiseLogSumExp(const scalar_t* X_ptr, int64_t C) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t n = C / Vec::size() * Vec::size();
+  scalar_t max_val = X_ptr[0];
+  if (n > 0) {
+    Vec max_vec = Vec::loadu(X_ptr);
+    for (int64_t d = Vec::size(); d < n; d += Vec::size()) {
+      max_vec = vec256::maximum(max_vec, Vec::loadu(X_ptr + d));
+    }
+    max_val = vec256::vec_reduce_all(
+        [](Vec x, Vec y) { return vec256::maximum(x, y); },
+        max_vec,
+        Vec::size());
+  }
+  for (int64_t d = n; d < C; ++d) {
+    max_val = std::max(max_val, X_ptr[d]);
+  }
+  Vec sum_vec(0);
+  for (int64_t d = 0; d < n; d += Vec::size()) {
+    sum_vec = sum_vec + (Vec::loadu(X_ptr + d) - Vec(max_val)).exp();
+  }
+  scalar_t sum_val = vec256::vec_reduce_all(
+      [](Vec x, Vec y) { return x + y; }, sum_vec, Vec::size());
+  for (int64_t d = n; d < C; ++d) {
+    sum_val += std::exp(X_ptr[d] - max_val);
+  }
+  return max_val + std::log(sum_val);
+}
+
+template <typename scalar_t>
+void CrossEntropyLossKernelImplInternal(
+    const Tensor& logits,
+    const Tensor& target,
+    int64_t reduction,
+    int64_t ignore_index,
+    Tensor* output,
+    Tensor* logsumexp) {
+  const int64_t batch_size = logits.size(0);
+  const int64_t n_classes = logits.size(1);
+  const scalar_t* input_data = logits.data_ptr<scalar_t>();
+  const int64_t* target_data = target.data_ptr<int64_t>();
+  scalar_t* logsumexp_data = logsumexp->data_ptr<scalar_t>();
+
+  // Per-row losses are cheap relative to the [batch, classes] input, so
+  // they always go through a small scratch buffer; the reduction over it
+  // afterwards is negligible.
+  Tensor losses = reduction == Reduction::None
+      ? *output
+      : at::empty({batch_size}, logits.options());
+  scalar_t* losses_data = losses.data_ptr<scalar_t>();
+
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t cur_target = target_data[i];
+      if (cur_target == ignore_index) {
+        losses_data[i] = 0;
+        logsumexp_data[i] = 0;
+        continue;
+      }
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ",
+          cur_target,
+          " is out of bounds.");
+      const scalar_t* X_ptr = input_data + i * n_classes;
+      const scalar_t lse = RowwiseLogSumExp(X_ptr, n_classes);
+      logsumexp_data[i] = lse;
+      losses_data[i] = lse - X_ptr[cur_target];
+    }
+  });
+
+  if (reduction == Reduction::None) {
+    return;
+  }
+  scalar_t loss_val = 0;
+  int64_t n_valid = 0;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    loss_val += losses_data[i];
+    n_valid += target_data[i] != ignore_index;
+  }
+  if (reduction == Reduction::Mean && (n_valid != 0 || batch_size == 0)) {
+    // allow NaN result for the all-ignored case, matching nll_loss
+    loss_val /= static_cast<scalar_t>(n_valid);
+  }
+  *output->data_ptr<scalar_t>() = loss_val;
+}
+
+void CrossEntropyLossKernelImpl(
+    const Tensor& logits,
+    const Tensor& target,
+    int64_t reduction,
+    int64_t ignore_index,
+    Tensor* output,
+    Tensor* logsumexp) {
+  AT_DISPATCH_FLOATING_TYPES(
+      logits.scalar_type(), "CrossEntropyLossKernelImpl", [&]() {
+        CrossEntropyLossKernelImplInternal<scalar_t>(
+            logits, target, reduction, ignore_index, output, logsumexp);
+      });
+}
+
+template <typename scalar_t>
+void CrossEntropyLossBackwardKernelImplInternal(
+    const Tensor& grad_output,
+    const Tensor& logits,
+    const Tensor& target,
+    const Tensor& logsumexp,
+    int64_t reduction,
+    int64_t ignore_index,
+    Tensor* grad_input) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const int64_t batch_size = logits.size(0);
+  const int64_t n_classes = logits.size(1);
+  const scalar_t* grad_output_data = grad_output.data_ptr<scalar_t>();
+  const scalar_t* input_data = logits.data_ptr<scalar_t>();
+  const int64_t* target_data = target.data_ptr<int64_t>();
+  const scalar_t* logsumexp_data = logsumexp.data_ptr<scalar_t>();
+  scalar_t* grad_input_data = grad_input->data_ptr<scalar_t>();
+
+  int64_t n_valid = 0;
+  for (int64_t i = 0; i < batch_size; ++i) {
+    n_valid += target_data[i] != ignore_index;
+  }
+
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    const int64_t n = n_classes / Vec::size() * Vec::size();
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t cur_target = target_data[i];
+      scalar_t* dX_ptr = grad_input_data + i * n_classes;
+      if (cur_target == ignore_index) {
+        std::memset(dX_ptr, 0, n_classes * sizeof(scalar_t));
+        continue;
+      }
+      TORCH_CHECK_INDEX(
+          cur_target >= 0 && cur_target < n_classes,
+          "Target ",
+          cur_target,
+          " is out of bounds.");
+      scalar_t scale = reduction == Reduction::None ? grad_output_data[i]
+                                                    : grad_output_data[0];
+      if (reduction == Reduction::Mean) {
+        scale /= static_cast<scalar_t>(n_valid);
+      }
+      // dX = scale * (softmax(x) - onehot(target)), with softmax rebuilt
+      // from the logits and the saved logsumexp.
+      const scalar_t* X_ptr = input_data + i * n_classes;
+      const scalar_t lse = logsumexp_data[i];
+      int64_t d = 0;
+      for (; d < n; d += Vec::size()) {
+        const Vec dx_vec =
+            (Vec::loadu(X_ptr + d) - Vec(lse)).exp() * Vec(scale);
+        dx_vec.store(dX_ptr + d);
+      }
+      for (; d < n_classes; ++d) {
+        dX_ptr[d] = std::exp(X_ptr[d] - lse) * scale;
+      }
+      dX_ptr[cur_target] -= scale;
+    }
+  });
+}
+
+void CrossEntropyLossBackwardKernelImpl(
+    const Tensor& grad_output,
+    const Tensor& logits,
+    const Tensor& target,
+    const Tensor& logsumexp,
+    int64_t reduction,
+    int64_t ignore_index,
+    Tensor* grad_input) {
+  AT_DISPATCH_FLOATING_TYPES(
+      logits.scalar_type(), "CrossEntropyLossBackwardKernelImpl", [&]() {
+        CrossEntropyLossBackwardKernelImplInternal<scalar_t>(
+            grad_output,
+            logits,
+            target,
+            logsumexp,
+            reduction,
+            ignore_index,
+            grad_input);
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(CrossEntropyLossKernel, &CrossEntropyLossKernelImpl);
+REGISTER_DISPATCH(
+    CrossEntropyLossBackwardKernel,
+    &CrossEntropyLossBackwardKernelImpl);
+
+} // namespace native
+} // namespace at
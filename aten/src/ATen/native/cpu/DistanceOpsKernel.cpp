@@ -193,7 +193,13 @@ struct Dist {
     }
   }
 
-  template <typename F>
+  // A tile of rows from each operand is walked together so a block of t2
+  // rows stays resident in L2 cache while every t1 row of the tile is
+  // scored against it, instead of streaming all of t2 from memory for each
+  // t1 row. One tile of rows holds roughly kCdistTileElems elements.
+  static constexpr int64_t kCdistTileElems = 16384;
+
+  template <template <typename> class F>
   static void run_parallel_cdist(Tensor& result, const Tensor& t1, const Tensor& t2, const scalar_t p) {
     const scalar_t * const t1_start = t1.data_ptr<scalar_t>();
     const scalar_t * const t2_start = t2.data_ptr<scalar_t>();
@@ -207,36 +213,28 @@ struct Dist {
     int64_t size1 = r1 * m;
     int64_t size2 = r2 * m;
 
-    parallel_for(0, combs * d, internal::GRAIN_SIZE / (16 * m), [=](int64_t start, int64_t end) {
-      scalar_t * res = res_start + start;
-      const scalar_t * const res_end = res_start + end;
-      int64_t l = start / combs;
-      int64_t k = start % combs;
-      int64_t i = k / r2;
-      int64_t j = k % r2;
-      i = i * m;
-      j = j * m;
-
-      while (res != res_end) {
-        const scalar_t * self_i = t1_start + size1 * l + i;
-        const scalar_t * self_j = t2_start + size2 * l + j;
-
-        scalar_t agg = 0;
-        for (int x = 0; x < m; x++) {
-          scalar_t a = *(self_i + x);
-          scalar_t b = *(self_j + x);
-          agg = F::red(agg, F::map(std::abs(a-b), p));
-        }
-        *res = F::finish(agg, p);
+    const int64_t tile_rows = std::max<int64_t>(1, kCdistTileElems / m);
+    const int64_t tiles1 = (r1 + tile_rows - 1) / tile_rows;
 
-        res += 1;
-        j += m;
-        if (j == size2) {
-          j = 0;
-          i += m;
-          if (i == size1) {
-            i = 0;
-            l += 1;
+    parallel_for(0, d * tiles1, 1, [=](int64_t begin, int64_t end) {
+      const Vec pvec(p);
+      for (int64_t t = begin; t < end; t++) {
+        const int64_t l = t / tiles1;
+        const int64_t i_begin = (t % tiles1) * tile_rows;
+        const int64_t i_end = std::min(i_begin + tile_rows, r1);
+        const scalar_t * const t1_l = t1_start + l * size1;
+        const scalar_t * const t2_l = t2_start + l * size2;
+        scalar_t * const res_l = res_start + l * combs;
+        for (int64_t j_begin = 0; j_begin < r2; j_begin += tile_rows) {
+          const int64_t j_end = std::min(j_begin + tile_rows, r2);
+          for (int64_t i = i_begin; i < i_end; i++) {
+            const scalar_t * const self_i = t1_l + i * m;
+            scalar_t * const res_row = res_l + i * r2;
+            for (int64_t j = j_begin; j < j_end; j++) {
+              res_row[j] = F<Vec>::finish(vec256::map2_reduce_all<scalar_t>(
+                [&pvec](Vec a, Vec b) { return F<Vec>::map((a - b).abs(), pvec); },
+                F<Vec>::red, self_i, t2_l + j * m, m), p);
+            }
           }
         }
       }
@@ -245,15 +243,15 @@ struct Dist {
 
   static void apply_cdist(Tensor& result, const Tensor& x1, const Tensor& x2, const scalar_t p) {
     if (p == 0.0) {
-      run_parallel_cdist<zdist_calc<scalar_t>>(result, x1, x2, p);
+      run_parallel_cdist<zdist_calc>(result, x1, x2, p);
     } else if (p == 1.0) {
-      run_parallel_cdist<odist_calc<scalar_t>>(result, x1, x2, p);
+      run_parallel_cdist<odist_calc>(result, x1, x2, p);
     } else if (p == 2.0) {
-      run_parallel_cdist<tdist_calc<scalar_t>>(result, x1, x2, p);
+      run_parallel_cdist<tdist_calc>(result, x1, x2, p);
     } else if (std::isinf(p)) {
-      run_parallel_cdist<idist_calc<scalar_t>>(result, x1, x2, p);
+      run_parallel_cdist<idist_calc>(result, x1, x2, p);
     } else {
-      run_parallel_cdist<pdist_calc<scalar_t>>(result, x1, x2, p);
+      run_parallel_cdist<pdist_calc>(result, x1, x2, p);
     }
   }
 
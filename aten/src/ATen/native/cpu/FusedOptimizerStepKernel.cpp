@@ -0,0 +1,345 @@
+#include <ATen/native/FusedOptimizerStep.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// The updates are elementwise over contiguous buffers, so each tensor is
+// processed in one parallel, vectorized pass with a scalar tail.  The math
+// mirrors torch::optim::SGD::step() / Adam::step() exactly.
+
+template <typename scalar_t>
+void sgd_step_dense(
+    scalar_t* p,
+    const scalar_t* g,
+    scalar_t* buf, // may be nullptr (momentum == 0)
+    int64_t numel,
+    const FusedSGDParams& args) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const scalar_t lr = static_cast<scalar_t>(args.lr);
+  const scalar_t momentum = static_cast<scalar_t>(args.momentum);
+  const scalar_t weight_decay = static_cast<scalar_t>(args.weight_decay);
+  const scalar_t dampening_factor =
+      args.first_step ? scalar_t(1) : static_cast<scalar_t>(1 - args.dampening);
+  parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    const Vec lr_vec(lr);
+    const Vec momentum_vec(momentum);
+    const Vec weight_decay_vec(weight_decay);
+    const Vec dampening_vec(dampening_factor);
+    int64_t d = begin;
+    for (; d + Vec::size() <= end; d += Vec::size()) {
+      Vec param = Vec::loadu(p + d);
+      Vec update = Vec::loadu(g + d);
+      if (weight_decay > 0) {
+        update = update + weight_decay_vec * param;
+      }
+      if (buf != nullptr) {
+        Vec m = momentum_vec * Vec::loadu(buf + d) + dampening_vec * update;
+        m.store(buf + d);
+        update = args.nesterov ? update + momentum_vec * m : m;
+      }
+      (param - lr_vec * update).store(p + d);
+    }
+    for (; d < end; ++d) {
+      scalar_t param = p[d];
+      scalar_t update = g[d];
+      if (weight_decay > 0) {
+        update += weight_decay * param;
+      }
+      if (buf != nullptr) {
+        scalar_t m = momentum * buf[d] + dampening_factor * update;
+        buf[d] = m;
+        update = args.nesterov ? update + momentum * m : m;
+      }
+      p[d] = param - lr * update;
+    }
+  });
+}
+
+template <typename scalar_t>
+void adam_step_dense(
+    scalar_t* p,
+    const scalar_t* g,
+    scalar_t* exp_avg,
+    scalar_t* exp_avg_sq,
+    scalar_t* max_exp_avg_sq, // may be nullptr (!amsgrad)
+    int64_t numel,
+    const FusedAdamParams& args) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const scalar_t beta1 = static_cast<scalar_t>(args.beta1);
+  const scalar_t beta2 = static_cast<scalar_t>(args.beta2);
+  const scalar_t one_minus_beta1 = static_cast<scalar_t>(1 - args.beta1);
+  const scalar_t one_minus_beta2 = static_cast<scalar_t>(1 - args.beta2);
+  const scalar_t weight_decay = static_cast<scalar_t>(args.weight_decay);
+  const scalar_t eps = static_cast<scalar_t>(args.eps);
+  const scalar_t step_size =
+      static_cast<scalar_t>(args.lr / args.bias_correction1);
+  const scalar_t inv_bias_correction2 =
+      static_cast<scalar_t>(1 / args.bias_correction2);
+  parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    const Vec beta1_vec(beta1);
+    const Vec beta2_vec(beta2);
+    const Vec one_minus_beta1_vec(one_minus_beta1);
+    const Vec one_minus_beta2_vec(one_minus_beta2);
+    const Vec weight_decay_vec(weight_decay);
+    const Vec eps_vec(eps);
+    const Vec step_size_vec(step_size);
+    const Vec inv_bias_correction2_vec(inv_bias_correction2);
+    int64_t d = begin;
+    for (; d + Vec::size() <= end; d += Vec::size()) {
+      Vec param = Vec::loadu(p + d);
+      Vec grad = Vec::loadu(g + d);
+      if (weight_decay > 0) {
+        grad = grad + weight_decay_vec * param;
+      }
+      Vec m = beta1_vec * Vec::loadu(exp_avg + d) + one_minus_beta1_vec * grad;
+      m.store(exp_avg + d);
+      Vec v = beta2_vec * Vec::loadu(exp_avg_sq + d) +
+          one_minus_beta2_vec * grad * grad;
+      v.store(exp_avg_sq + d);
+      if (max_exp_avg_sq != nullptr) {
+        v = vec256::maximum(Vec::loadu(max_exp_avg_sq + d), v);
+        v.store(max_exp_avg_sq + d);
+      }
+      Vec denom = (v * inv_bias_correction2_vec).sqrt() + eps_vec;
+      (param - step_size_vec * m / denom).store(p + d);
+    }
+    for (; d < end; ++d) {
+      scalar_t param = p[d];
+      scalar_t grad = g[d];
+      if (weight_decay > 0) {
+        grad += weight_decay * param;
+      }
+      scalar_t m = beta1 * exp_avg[d] + one_minus_beta1 * grad;
+      exp_avg[d] = m;
+      scalar_t v = beta2 * exp_avg_sq[d] + one_minus_beta2 * grad * grad;
+      exp_avg_sq[d] = v;
+      if (max_exp_avg_sq != nullptr) {
+        v = std::max(max_exp_avg_sq[d], v);
+        max_exp_avg_sq[d] = v;
+      }
+      const scalar_t denom = std::sqrt(v * inv_bias_correction2) + eps;
+      p[d] = param - step_size * m / denom;
+    }
+  });
+}
+
+void fused_sgd_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDParams& args) {
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_sgd_step", [&] {
+    for (size_t i = 0; i < params.size(); ++i) {
+      scalar_t* buf = momentum_buffers.empty()
+          ? nullptr
+          : momentum_buffers[i].data_ptr<scalar_t>();
+      sgd_step_dense<scalar_t>(
+          params[i].data_ptr<scalar_t>(),
+          grads[i].data_ptr<scalar_t>(),
+          buf,
+          params[i].numel(),
+          args);
+    }
+  });
+}
+
+void fused_adam_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    const FusedAdamParams& args) {
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_adam_step", [&] {
+    for (size_t i = 0; i < params.size(); ++i) {
+      scalar_t* max_exp_avg_sq = max_exp_avg_sqs.empty()
+          ? nullptr
+          : max_exp_avg_sqs[i].data_ptr<scalar_t>();
+      adam_step_dense<scalar_t>(
+          params[i].data_ptr<scalar_t>(),
+          grads[i].data_ptr<scalar_t>(),
+          exp_avgs[i].data_ptr<scalar_t>(),
+          exp_avg_sqs[i].data_ptr<scalar_t>(),
+          max_exp_avg_sq,
+          params[i].numel(),
+          args);
+    }
+  });
+}
+
+// Applies one adagrad update to param row `p` and its elementwise state
+// row `sum` from the (already duplicate-summed) gradient row `g`.
+template <typename scalar_t>
+inline void sparse_adagrad_update_row(
+    scalar_t* p,
+    scalar_t* sum,
+    const scalar_t* g,
+    int64_t dim,
+    scalar_t lr,
+    scalar_t eps) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const Vec lr_vec(lr);
+  const Vec eps_vec(eps);
+  int64_t d = 0;
+  for (; d + Vec::size() <= dim; d += Vec::size()) {
+    Vec grad = Vec::loadu(g + d);
+    Vec s = vec256::fmadd(grad, grad, Vec::loadu(sum + d));
+    s.store(sum + d);
+    (Vec::loadu(p + d) - lr_vec * grad / (s.sqrt() + eps_vec)).store(p + d);
+  }
+  for (; d < dim; ++d) {
+    scalar_t grad = g[d];
+    scalar_t s = sum[d] + grad * grad;
+    sum[d] = s;
+    p[d] -= lr * grad / (std::sqrt(s) + eps);
+  }
+}
+
+// Rowwise variant: the state is one scalar per row, advanced by the mean
+// of the squared gradient row, and the whole row shares one step size.
+template <typename scalar_t>
+inline void rowwise_sparse_adagrad_update_row(
+    scalar_t* p,
+    scalar_t* sum,
+    const scalar_t* g,
+    int64_t dim,
+    scalar_t lr,
+    scalar_t eps) {
+  using Vec = vec256::Vec256<scalar_t>;
+  Vec acc_vec(0);
+  int64_t d = 0;
+  for (; d + Vec::size() <= dim; d += Vec::size()) {
+    Vec grad = Vec::loadu(g + d);
+    acc_vec = vec256::fmadd(grad, grad, acc_vec);
+  }
+  scalar_t lanes[Vec::size()];
+  acc_vec.store(lanes);
+  scalar_t acc = 0;
+  for (int64_t l = 0; l < Vec::size(); ++l) {
+    acc += lanes[l];
+  }
+  for (; d < dim; ++d) {
+    acc += g[d] * g[d];
+  }
+  scalar_t s = *sum + acc / dim;
+  *sum = s;
+  const scalar_t step = lr / (std::sqrt(s) + eps);
+  const Vec step_vec(step);
+  d = 0;
+  for (; d + Vec::size() <= dim; d += Vec::size()) {
+    (Vec::loadu(p + d) - step_vec * Vec::loadu(g + d)).store(p + d);
+  }
+  for (; d < dim; ++d) {
+    p[d] -= step * g[d];
+  }
+}
+
+void fused_sparse_adagrad_kernel(
+    Tensor& param,
+    Tensor& state_sum,
+    const Tensor& indices,
+    const Tensor& grad_values,
+    bool rowwise,
+    const FusedSparseAdagradParams& args) {
+  const int64_t nnz = indices.numel();
+  if (nnz == 0) {
+    return;
+  }
+  const int64_t num_rows = param.size(0);
+  const int64_t dim = param.size(1);
+  Tensor indices_contig = indices.contiguous();
+  const int64_t* indices_ptr = indices_contig.data_ptr<int64_t>();
+
+  // Group duplicate indices so that each output row has exactly one owner
+  // and the updates need no atomics.  Gradients that went through coalesce
+  // (or an EmbeddingBag backward) arrive sorted and unique, in which case
+  // the sort is skipped and every entry is its own group.
+  bool sorted_unique = true;
+  for (int64_t j = 1; j < nnz; ++j) {
+    if (indices_ptr[j] <= indices_ptr[j - 1]) {
+      sorted_unique = false;
+      break;
+    }
+  }
+  std::vector<int64_t> order;
+  std::vector<int64_t> group_starts;
+  if (!sorted_unique) {
+    order.resize(nnz);
+    for (int64_t j = 0; j < nnz; ++j) {
+      order[j] = j;
+    }
+    std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return indices_ptr[a] < indices_ptr[b];
+    });
+    for (int64_t j = 0; j < nnz; ++j) {
+      if (j == 0 || indices_ptr[order[j]] != indices_ptr[order[j - 1]]) {
+        group_starts.push_back(j);
+      }
+    }
+    group_starts.push_back(nnz);
+  }
+  const int64_t num_groups =
+      sorted_unique ? nnz : static_cast<int64_t>(group_starts.size()) - 1;
+
+  AT_DISPATCH_FLOATING_TYPES(
+      param.scalar_type(), "fused_sparse_adagrad_step", [&] {
+        const scalar_t lr = static_cast<scalar_t>(args.lr);
+        const scalar_t eps = static_cast<scalar_t>(args.eps);
+        scalar_t* param_ptr = param.data_ptr<scalar_t>();
+        scalar_t* sum_ptr = state_sum.data_ptr<scalar_t>();
+        const scalar_t* values_ptr = grad_values.data_ptr<scalar_t>();
+        const int64_t grain_size = std::max(
+            (int64_t)1, internal::GRAIN_SIZE / std::max((int64_t)1, dim));
+        parallel_for(0, num_groups, grain_size, [&](int64_t begin, int64_t end) {
+          std::vector<scalar_t> accum(dim);
+          for (int64_t gr = begin; gr < end; ++gr) {
+            int64_t first = sorted_unique ? gr : group_starts[gr];
+            int64_t last = sorted_unique ? gr + 1 : group_starts[gr + 1];
+            int64_t row = indices_ptr[sorted_unique ? gr : order[first]];
+            if (row < 0 || row >= num_rows) {
+              AT_ERROR("fused sparse adagrad: index out of row bound: ", row,
+                  " not between 0 and ", num_rows - 1);
+            }
+            const scalar_t* g;
+            if (last - first == 1) {
+              g = values_ptr + (sorted_unique ? gr : order[first]) * dim;
+            } else {
+              std::copy(values_ptr + order[first] * dim,
+                        values_ptr + (order[first] + 1) * dim,
+                        accum.data());
+              for (int64_t j = first + 1; j < last; ++j) {
+                const scalar_t* dup = values_ptr + order[j] * dim;
+                for (int64_t d = 0; d < dim; ++d) {
+                  accum[d] += dup[d];
+                }
+              }
+              g = accum.data();
+            }
+            if (rowwise) {
+              rowwise_sparse_adagrad_update_row<scalar_t>(
+                  param_ptr + row * dim, sum_ptr + row, g, dim, lr, eps);
+            } else {
+              sparse_adagrad_update_row<scalar_t>(
+                  param_ptr + row * dim, sum_ptr + row * dim, g, dim, lr, eps);
+            }
+          }
+        });
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(fused_sgd_stub, &fused_sgd_kernel);
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_kernel);
+REGISTER_DISPATCH(fused_sparse_adagrad_stub, &fused_sparse_adagrad_kernel);
+
+}} // namespace at::native
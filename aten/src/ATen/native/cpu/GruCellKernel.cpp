@@ -0,0 +1,95 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/RNN.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+template <typename scalar_t>
+inline scalar_t sigmoid_scalar(scalar_t x) {
+  return scalar_t(1) / (scalar_t(1) + std::exp(-x));
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> sigmoid_vec(Vec256<scalar_t> x) {
+  using Vec = Vec256<scalar_t>;
+  return Vec(1) / (Vec(1) + (Vec(0) - x).exp());
+}
+
+// Pointwise stage of the GRU cell over the two gate buffers:
+//   r = sigmoid(ig0 + hg0)
+//   z = sigmoid(ig1 + hg1)
+//   n = tanh(ig2 + r * hg2)
+//   hy = (hx - n) * z + n
+// The chunked-ops formulation makes seven dispatched passes over the gate
+// buffers and hidden state; this does everything in one pass per row,
+// parallelized over the batch. Gate order matches gates.chunk(3, 1).
+template <typename scalar_t>
+void gru_cell_cpu_body(
+    Tensor& hy,
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hx) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t W = Vec::size();
+  int64_t hidden_size = hx.size(-1);
+  int64_t batch_size = hx.numel() / std::max((int64_t)1, hidden_size);
+
+  const scalar_t* igates_data = igates.data_ptr<scalar_t>();
+  const scalar_t* hgates_data = hgates.data_ptr<scalar_t>();
+  const scalar_t* hx_data = hx.data_ptr<scalar_t>();
+  scalar_t* hy_data = hy.data_ptr<scalar_t>();
+
+  int64_t grain_size = std::max(
+      (int64_t)1,
+      internal::GRAIN_SIZE / std::max((int64_t)1, 3 * hidden_size));
+  parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* i_reset = igates_data + b * 3 * hidden_size;
+      const scalar_t* i_input = i_reset + hidden_size;
+      const scalar_t* i_new = i_reset + 2 * hidden_size;
+      const scalar_t* h_reset = hgates_data + b * 3 * hidden_size;
+      const scalar_t* h_input = h_reset + hidden_size;
+      const scalar_t* h_new = h_reset + 2 * hidden_size;
+      const scalar_t* hx_row = hx_data + b * hidden_size;
+      scalar_t* hy_row = hy_data + b * hidden_size;
+
+      int64_t j = 0;
+      for (; j + W <= hidden_size; j += W) {
+        Vec r = sigmoid_vec(Vec::loadu(i_reset + j) + Vec::loadu(h_reset + j));
+        Vec z = sigmoid_vec(Vec::loadu(i_input + j) + Vec::loadu(h_input + j));
+        Vec n = fmadd(r, Vec::loadu(h_new + j), Vec::loadu(i_new + j)).tanh();
+        fmadd(Vec::loadu(hx_row + j) - n, z, n).store(hy_row + j);
+      }
+      for (; j < hidden_size; j++) {
+        scalar_t r = sigmoid_scalar(i_reset[j] + h_reset[j]);
+        scalar_t z = sigmoid_scalar(i_input[j] + h_input[j]);
+        scalar_t n = std::tanh(i_new[j] + r * h_new[j]);
+        hy_row[j] = (hx_row[j] - n) * z + n;
+      }
+    }
+  });
+}
+
+void gru_cell_cpu_kernel_impl(
+    Tensor& hy,
+    const Tensor& igates,
+    const Tensor& hgates,
+    const Tensor& hx) {
+  AT_DISPATCH_FLOATING_TYPES(igates.scalar_type(), "gru_cell_cpu", [&] {
+    gru_cell_cpu_body<scalar_t>(hy, igates, hgates, hx);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(gru_cell_cpu_stub, &gru_cell_cpu_kernel_impl);
+
+}} // namespace at::native
@@ -1,6 +1,8 @@
 #include <ATen/native/Indexing.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <ATen/Dispatch.h>
 #include <ATen/native/TensorIterator.h>
@@ -117,10 +119,219 @@ void index_put_kernel(TensorIterator& iter, IntArrayRef index_size, IntArrayRef
   });
 }
 
+// Collapses the dimensions around `dim` of a contiguous tensor into
+// (outer, size(dim), inner) so that a whole inner row can be moved per index.
+static void collapse_dims(IntArrayRef sizes, int64_t dim, int64_t& outer, int64_t& inner) {
+  outer = 1;
+  for (int64_t d = 0; d < dim; ++d) {
+    outer *= sizes[d];
+  }
+  inner = 1;
+  for (int64_t d = dim + 1; d < static_cast<int64_t>(sizes.size()); ++d) {
+    inner *= sizes[d];
+  }
+}
+
+void index_select_kernel(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index) {
+  int64_t outer, inner;
+  collapse_dims(self.sizes(), dim, outer, inner);
+  const int64_t n = self.size(dim);
+  const int64_t m = index.numel();
+  const int64_t* index_data = index.data_ptr<int64_t>();
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "index_select_cpu", [&] {
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    // Each index selects one contiguous row of `inner` elements, so the copy
+    // phase is a parallel loop of bulk memcpy calls over the index dimension.
+    const int64_t grain =
+        std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(inner, 1));
+    at::parallel_for(0, outer * m, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t r = begin; r < end; ++r) {
+        const int64_t i = r % m;
+        const int64_t idx = index_data[i];
+        TORCH_CHECK_INDEX(
+            idx >= 0 && idx < n,
+            "index out of range: Tried to access index ", idx,
+            " out of table with ", n - 1, " rows.");
+        std::memcpy(
+            result_data + r * inner,
+            self_data + ((r / m) * n + idx) * inner,
+            inner * sizeof(scalar_t));
+      }
+    });
+  });
+}
+
+void gather_kernel(Tensor& result, const Tensor& self, int64_t dim, const Tensor& index) {
+  int64_t outer, inner;
+  collapse_dims(index.sizes(), dim, outer, inner);
+  const int64_t M = index.size(dim);
+  const int64_t n = self.size(dim);
+  const int64_t* index_data = index.data_ptr<int64_t>();
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "gather_cpu", [&] {
+    const scalar_t* self_data = self.data_ptr<scalar_t>();
+    scalar_t* result_data = result.data_ptr<scalar_t>();
+    const int64_t grain =
+        std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(inner, 1));
+    at::parallel_for(0, outer * M, grain, [&](int64_t begin, int64_t end) {
+      for (int64_t r = begin; r < end; ++r) {
+        const int64_t o = r / M;
+        const scalar_t* self_row = self_data + o * n * inner;
+        for (int64_t j = 0; j < inner; ++j) {
+          const int64_t idx = index_data[r * inner + j];
+          TORCH_CHECK_INDEX(idx >= 0 && idx < n, "Invalid index in gather");
+          result_data[r * inner + j] = self_row[idx * inner + j];
+        }
+      }
+    });
+  });
+}
+
+void scatter_add_kernel(Tensor& self, int64_t dim, const Tensor& index, const Tensor& src) {
+  int64_t outer, inner;
+  collapse_dims(index.sizes(), dim, outer, inner);
+  const int64_t M = index.size(dim);
+  const int64_t n = self.size(dim);
+  const int64_t* index_data = index.data_ptr<int64_t>();
+  const int num_threads = at::get_num_threads();
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, self.scalar_type(), "scatter_add_cpu", [&] {
+    scalar_t* self_data = self.data_ptr<scalar_t>();
+    const scalar_t* src_data = src.data_ptr<scalar_t>();
+    if (outer >= num_threads || outer * M * inner <= internal::GRAIN_SIZE) {
+      // Writes for different outer slices never touch the same output
+      // location, so the slices can be scattered concurrently without
+      // atomics. This also covers the serial small-problem case.
+      at::parallel_for(0, outer, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t o = begin; o < end; ++o) {
+          for (int64_t m = 0; m < M; ++m) {
+            for (int64_t j = 0; j < inner; ++j) {
+              const int64_t idx = index_data[(o * M + m) * inner + j];
+              TORCH_CHECK_INDEX(idx >= 0 && idx < n, "Invalid index in scatterAdd");
+              self_data[(o * n + idx) * inner + j] +=
+                  src_data[(o * M + m) * inner + j];
+            }
+          }
+        }
+      });
+    } else if (inner > 1) {
+      // Few outer slices but a large inner dimension: give each thread a
+      // disjoint range of inner positions. Writes stay within the owned
+      // range, so this is race free as well.
+      const int64_t grain =
+          std::max<int64_t>(1, internal::GRAIN_SIZE / std::max<int64_t>(outer * M, 1));
+      at::parallel_for(0, inner, grain, [&](int64_t jbegin, int64_t jend) {
+        for (int64_t o = 0; o < outer; ++o) {
+          for (int64_t m = 0; m < M; ++m) {
+            for (int64_t j = jbegin; j < jend; ++j) {
+              const int64_t idx = index_data[(o * M + m) * inner + j];
+              TORCH_CHECK_INDEX(idx >= 0 && idx < n, "Invalid index in scatterAdd");
+              self_data[(o * n + idx) * inner + j] +=
+                  src_data[(o * M + m) * inner + j];
+            }
+          }
+        }
+      });
+    } else {
+      // Essentially a long 1-d scatter: accumulate into per-thread partial
+      // outputs and reduce them afterwards, avoiding atomics entirely.
+      Tensor buffer = at::zeros({num_threads, self.numel()}, self.options());
+      scalar_t* buffer_data = buffer.data_ptr<scalar_t>();
+      at::parallel_for(0, outer * M, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        scalar_t* partial = buffer_data + at::get_thread_num() * self.numel();
+        for (int64_t r = begin; r < end; ++r) {
+          const int64_t idx = index_data[r];
+          TORCH_CHECK_INDEX(idx >= 0 && idx < n, "Invalid index in scatterAdd");
+          partial[(r / M) * n + idx] += src_data[r];
+        }
+      });
+      at::parallel_for(0, self.numel(), internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        for (int t = 0; t < num_threads; ++t) {
+          const scalar_t* partial = buffer_data + t * self.numel();
+          for (int64_t k = begin; k < end; ++k) {
+            self_data[k] += partial[k];
+          }
+        }
+      });
+    }
+  });
+}
+
+// masked_fill for floating point types: the contiguous inner loop expands
+// the byte (or bool) mask into one lane per element (a fixed-trip loop the
+// compiler turns into a widening convert), compares against zero for the
+// lane mask and blends the fill value in with a single vector select.
+template <typename scalar_t, typename mask_t>
+typename std::enable_if<std::is_floating_point<scalar_t>::value, void>::type
+cpu_masked_fill_kernel(TensorIterator& iter, scalar_t value) {
+  using Vec = Vec256<scalar_t>;
+  // data[0] is the output, which aliases data[1] (self); data[2] is the mask
+  iter.for_each([value](char** data, const int64_t* strides, int64_t n) {
+    char* dst_bytes = data[0];
+    const char* mask_bytes = data[2];
+    if (strides[0] == sizeof(scalar_t) && strides[2] == sizeof(mask_t)) {
+      auto* dst = reinterpret_cast<scalar_t*>(dst_bytes);
+      auto* mask = reinterpret_cast<const mask_t*>(mask_bytes);
+      const Vec value_vec(value);
+      int64_t i = 0;
+      alignas(64) scalar_t lane_mask[Vec::size()];
+      for (; i + Vec::size() <= n; i += Vec::size()) {
+        for (int64_t j = 0; j < Vec::size(); j++) {
+          lane_mask[j] = mask[i + j] ? scalar_t(1) : scalar_t(0);
+        }
+        const Vec mask_vec = Vec::loadu(lane_mask) != Vec(scalar_t(0));
+        const Vec self_vec = Vec::loadu(dst + i);
+        Vec::blendv(self_vec, value_vec, mask_vec).store(dst + i);
+      }
+      for (; i < n; i++) {
+        if (mask[i]) {
+          dst[i] = value;
+        }
+      }
+    } else {
+      for (int64_t i = 0; i < n; i++) {
+        if (*reinterpret_cast<const mask_t*>(mask_bytes + i * strides[2])) {
+          *reinterpret_cast<scalar_t*>(dst_bytes + i * strides[0]) = value;
+        }
+      }
+    }
+  });
+}
+
+template <typename scalar_t, typename mask_t>
+typename std::enable_if<!std::is_floating_point<scalar_t>::value, void>::type
+cpu_masked_fill_kernel(TensorIterator& iter, scalar_t value) {
+  iter.for_each([value](char** data, const int64_t* strides, int64_t n) {
+    char* dst_bytes = data[0];
+    const char* mask_bytes = data[2];
+    for (int64_t i = 0; i < n; i++) {
+      if (*reinterpret_cast<const mask_t*>(mask_bytes + i * strides[2])) {
+        *reinterpret_cast<scalar_t*>(dst_bytes + i * strides[0]) = value;
+      }
+    }
+  });
+}
+
+void masked_fill_kernel(TensorIterator& iter, Scalar value) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
+      at::ScalarType::Bool, at::ScalarType::BFloat16, at::ScalarType::Half,
+      iter.dtype(), "masked_fill_cpu", [&] {
+    scalar_t fill_value = value.to<scalar_t>();
+    if (iter.dtype(2) == at::ScalarType::Byte) {
+      cpu_masked_fill_kernel<scalar_t, uint8_t>(iter, fill_value);
+    } else {
+      cpu_masked_fill_kernel<scalar_t, bool>(iter, fill_value);
+    }
+  });
+}
+
 } // anonymous namespace
 
 
 REGISTER_DISPATCH(index_stub, &index_kernel);
 REGISTER_DISPATCH(index_put_stub, &index_put_kernel);
+REGISTER_DISPATCH(gather_stub, &gather_kernel);
+REGISTER_DISPATCH(scatter_add_stub, &scatter_add_kernel);
+REGISTER_DISPATCH(index_select_stub, &index_select_kernel);
+REGISTER_DISPATCH(masked_fill_stub, &masked_fill_kernel);
 
 }} // namespace at::native
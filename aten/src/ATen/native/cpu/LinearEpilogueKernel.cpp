@@ -0,0 +1,112 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/Linear.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+// Runs out[r][j] = act(out[r][j] + bias[j]) over a contiguous
+// (rows, cols) output in one pass, parallelized over rows. op/vop are the
+// scalar and Vec256 forms of the activation.
+template <typename scalar_t, typename func_t, typename vec_func_t>
+void epilogue_loop(
+    Tensor& output,
+    const Tensor& bias,
+    const func_t& op,
+    const vec_func_t& vop) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t W = Vec::size();
+  int64_t cols = output.size(-1);
+  int64_t rows = output.numel() / std::max((int64_t)1, cols);
+  scalar_t* out_data = output.data_ptr<scalar_t>();
+  const scalar_t* bias_data =
+      bias.defined() ? bias.data_ptr<scalar_t>() : nullptr;
+
+  int64_t grain_size =
+      std::max((int64_t)1, internal::GRAIN_SIZE / std::max((int64_t)1, cols));
+  parallel_for(0, rows, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; r++) {
+      scalar_t* row = out_data + r * cols;
+      int64_t j = 0;
+      if (bias_data != nullptr) {
+        for (; j + W <= cols; j += W) {
+          vop(Vec::loadu(row + j) + Vec::loadu(bias_data + j)).store(row + j);
+        }
+        for (; j < cols; j++) {
+          row[j] = op(row[j] + bias_data[j]);
+        }
+      } else {
+        for (; j + W <= cols; j += W) {
+          vop(Vec::loadu(row + j)).store(row + j);
+        }
+        for (; j < cols; j++) {
+          row[j] = op(row[j]);
+        }
+      }
+    }
+  });
+}
+
+void linear_epilogue_kernel_impl(
+    Tensor& output,
+    const Tensor& bias,
+    LinearEpilogue epilogue) {
+  AT_DISPATCH_FLOATING_TYPES(output.scalar_type(), "linear_epilogue", [&] {
+    using Vec = Vec256<scalar_t>;
+    switch (epilogue) {
+      case LinearEpilogue::Relu: {
+        const Vec kZeroVec(0);
+        epilogue_loop<scalar_t>(
+            output,
+            bias,
+            [](scalar_t x) { return x > scalar_t(0) ? x : scalar_t(0); },
+            [&](Vec x) { return maximum(x, kZeroVec); });
+        break;
+      }
+      case LinearEpilogue::Gelu: {
+        // Matches GeluKernelImpl in Activation.cpp.
+        const Vec kAlphaVec(M_SQRT1_2);
+        const Vec kOneVec(1);
+        const Vec kPointFiveVec(0.5);
+        epilogue_loop<scalar_t>(
+            output,
+            bias,
+            [](scalar_t x) {
+              constexpr scalar_t kAlpha = M_SQRT1_2;
+              return x * scalar_t(0.5) * (scalar_t(1) + std::erf(x * kAlpha));
+            },
+            [&](Vec x) {
+              return x * kPointFiveVec * (kOneVec + (x * kAlphaVec).erf());
+            });
+        break;
+      }
+      case LinearEpilogue::Sigmoid: {
+        const Vec kZeroVec(0);
+        const Vec kOneVec(1);
+        epilogue_loop<scalar_t>(
+            output,
+            bias,
+            [](scalar_t x) {
+              return scalar_t(1) / (scalar_t(1) + std::exp(-x));
+            },
+            [&](Vec x) {
+              return kOneVec / (kOneVec + (kZeroVec - x).exp());
+            });
+        break;
+      }
+    }
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(linear_epilogue_stub, &linear_epilogue_kernel_impl);
+
+}} // namespace at::native
@@ -0,0 +1,99 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/RNN.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+template <typename scalar_t>
+inline scalar_t sigmoid_scalar(scalar_t x) {
+  return scalar_t(1) / (scalar_t(1) + std::exp(-x));
+}
+
+template <typename scalar_t>
+inline Vec256<scalar_t> sigmoid_vec(Vec256<scalar_t> x) {
+  using Vec = Vec256<scalar_t>;
+  return Vec(1) / (Vec(1) + (Vec(0) - x).exp());
+}
+
+// Pointwise stage of the LSTM cell over the summed gate buffer:
+//   i = sigmoid(g0), f = sigmoid(g1), g = tanh(g2), o = sigmoid(g3)
+//   cy = f * cx + i * g
+//   hy = o * tanh(cy)
+// The chunked-ops formulation makes six dispatched passes over the gate
+// buffer and cell state; this does everything in one pass per row,
+// parallelized over the batch. Gate order matches gates.chunk(4, 1).
+template <typename scalar_t>
+void lstm_cell_cpu_body(
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& gates,
+    const Tensor& cx) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t W = Vec::size();
+  int64_t hidden_size = cx.size(-1);
+  int64_t batch_size = cx.numel() / std::max((int64_t)1, hidden_size);
+
+  const scalar_t* gates_data = gates.data_ptr<scalar_t>();
+  const scalar_t* cx_data = cx.data_ptr<scalar_t>();
+  scalar_t* hy_data = hy.data_ptr<scalar_t>();
+  scalar_t* cy_data = cy.data_ptr<scalar_t>();
+
+  int64_t grain_size = std::max(
+      (int64_t)1,
+      internal::GRAIN_SIZE / std::max((int64_t)1, 4 * hidden_size));
+  parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; b++) {
+      const scalar_t* in_gate = gates_data + b * 4 * hidden_size;
+      const scalar_t* forget_gate = in_gate + hidden_size;
+      const scalar_t* cell_gate = in_gate + 2 * hidden_size;
+      const scalar_t* out_gate = in_gate + 3 * hidden_size;
+      const scalar_t* cx_row = cx_data + b * hidden_size;
+      scalar_t* hy_row = hy_data + b * hidden_size;
+      scalar_t* cy_row = cy_data + b * hidden_size;
+
+      int64_t j = 0;
+      for (; j + W <= hidden_size; j += W) {
+        Vec i = sigmoid_vec(Vec::loadu(in_gate + j));
+        Vec f = sigmoid_vec(Vec::loadu(forget_gate + j));
+        Vec g = Vec::loadu(cell_gate + j).tanh();
+        Vec o = sigmoid_vec(Vec::loadu(out_gate + j));
+        Vec c = fmadd(f, Vec::loadu(cx_row + j), i * g);
+        c.store(cy_row + j);
+        (o * c.tanh()).store(hy_row + j);
+      }
+      for (; j < hidden_size; j++) {
+        scalar_t i = sigmoid_scalar(in_gate[j]);
+        scalar_t f = sigmoid_scalar(forget_gate[j]);
+        scalar_t g = std::tanh(cell_gate[j]);
+        scalar_t o = sigmoid_scalar(out_gate[j]);
+        scalar_t c = f * cx_row[j] + i * g;
+        cy_row[j] = c;
+        hy_row[j] = o * std::tanh(c);
+      }
+    }
+  });
+}
+
+void lstm_cell_cpu_kernel_impl(
+    Tensor& hy,
+    Tensor& cy,
+    const Tensor& gates,
+    const Tensor& cx) {
+  AT_DISPATCH_FLOATING_TYPES(gates.scalar_type(), "lstm_cell_cpu", [&] {
+    lstm_cell_cpu_body<scalar_t>(hy, cy, gates, cx);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(lstm_cell_cpu_stub, &lstm_cell_cpu_kernel_impl);
+
+}} // namespace at::native
@@ -0,0 +1,126 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/LinearAlgebra.h>
+
+#include <algorithm>
+
+namespace at { namespace native {
+namespace {
+
+using namespace vec256;
+
+// Microkernel for one row-major product C[m x n] = beta * C + alpha * A @ B
+// with A[m x k], B[k x n]. The matrices are small enough (<= kSmallGemmMaxDim
+// per side) that B stays resident in L1/L2, so a single pass with the n
+// dimension in vector lanes, the A element broadcast, and two accumulators
+// per row for ILP is enough to beat a BLAS call.
+template <typename scalar_t>
+void small_gemm_single(
+    scalar_t* c,
+    const scalar_t* a,
+    const scalar_t* b,
+    int64_t m,
+    int64_t n,
+    int64_t k,
+    scalar_t beta,
+    scalar_t alpha,
+    bool is_bmm) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t W = Vec::size();
+  const Vec alpha_v(alpha);
+  const Vec beta_v(beta);
+  for (int64_t i = 0; i < m; i++) {
+    const scalar_t* a_row = a + i * k;
+    scalar_t* c_row = c + i * n;
+    int64_t j = 0;
+    for (; j + 2 * W <= n; j += 2 * W) {
+      Vec acc0(0);
+      Vec acc1(0);
+      for (int64_t p = 0; p < k; p++) {
+        const Vec a_v(a_row[p]);
+        const scalar_t* b_row = b + p * n + j;
+        acc0 = fmadd(a_v, Vec::loadu(b_row), acc0);
+        acc1 = fmadd(a_v, Vec::loadu(b_row + W), acc1);
+      }
+      if (is_bmm) {
+        (acc0 * alpha_v).store(c_row + j);
+        (acc1 * alpha_v).store(c_row + j + W);
+      } else {
+        fmadd(alpha_v, acc0, Vec::loadu(c_row + j) * beta_v).store(c_row + j);
+        fmadd(alpha_v, acc1, Vec::loadu(c_row + j + W) * beta_v)
+            .store(c_row + j + W);
+      }
+    }
+    for (; j + W <= n; j += W) {
+      Vec acc(0);
+      for (int64_t p = 0; p < k; p++) {
+        acc = fmadd(Vec(a_row[p]), Vec::loadu(b + p * n + j), acc);
+      }
+      if (is_bmm) {
+        (acc * alpha_v).store(c_row + j);
+      } else {
+        fmadd(alpha_v, acc, Vec::loadu(c_row + j) * beta_v).store(c_row + j);
+      }
+    }
+    for (; j < n; j++) {
+      scalar_t acc = 0;
+      for (int64_t p = 0; p < k; p++) {
+        acc += a_row[p] * b[p * n + j];
+      }
+      c_row[j] = is_bmm ? acc * alpha : beta * c_row[j] + alpha * acc;
+    }
+  }
+}
+
+template <typename scalar_t>
+void small_gemm_batch(
+    const Tensor& result,
+    const Tensor& batch1,
+    const Tensor& batch2,
+    Scalar beta_,
+    Scalar alpha_,
+    bool is_bmm) {
+  int64_t bs = result.size(0);
+  int64_t m = result.size(1);
+  int64_t n = result.size(2);
+  int64_t k = batch1.size(2);
+
+  scalar_t alpha = alpha_.to<scalar_t>();
+  scalar_t beta = beta_.to<scalar_t>();
+
+  scalar_t* c = result.data_ptr<scalar_t>();
+  const scalar_t* a = batch1.data_ptr<scalar_t>();
+  const scalar_t* b = batch2.data_ptr<scalar_t>();
+
+  int64_t grain_size = std::max(
+      (int64_t)1, internal::GRAIN_SIZE / std::max((int64_t)1, m * n * k));
+  parallel_for(0, bs, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t batch = begin; batch < end; batch++) {
+      small_gemm_single<scalar_t>(
+          c + batch * m * n,
+          a + batch * m * k,
+          b + batch * k * n,
+          m, n, k, beta, alpha, is_bmm);
+    }
+  });
+}
+
+void small_gemm_kernel_impl(
+    const Tensor& result,
+    const Tensor& batch1,
+    const Tensor& batch2,
+    Scalar beta,
+    Scalar alpha,
+    bool is_bmm) {
+  AT_DISPATCH_FLOATING_TYPES(result.scalar_type(), "small_gemm", [&] {
+    small_gemm_batch<scalar_t>(result, batch1, batch2, beta, alpha, is_bmm);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(small_gemm_stub, &small_gemm_kernel_impl);
+
+}} // namespace at::native
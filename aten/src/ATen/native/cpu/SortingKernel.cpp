@@ -83,8 +83,98 @@ static void topk_kernel(
   });
 }
 
+// Sorts `nslices` contiguous slices of length `n`. With enough slices to
+// keep every core busy each slice is sorted on one thread; a few long
+// slices (the 1-D case in particular) instead go one at a time through
+// parallel_merge_sort. Nesting the two would serialize the inner
+// parallel_for, hence the explicit split.
+template <typename scalar_t, typename Comp>
+void sort_slices(
+    const scalar_t* in,
+    scalar_t* out_values,
+    int64_t* out_indices,
+    int64_t nslices,
+    int64_t n,
+    const Comp& comp) {
+  using elem_t = std::pair<scalar_t, int64_t>;
+  if (nslices >= at::get_num_threads() || n < 2 * kParallelSortGrainSize) {
+    at::parallel_for(0, nslices, 1, [&](int64_t begin, int64_t end) {
+      std::vector<elem_t> slice(n);
+      for (int64_t i = begin; i < end; ++i) {
+        const scalar_t* src = in + i * n;
+        for (int64_t j = 0; j < n; ++j) {
+          slice[j] = elem_t(src[j], j);
+        }
+        std::sort(slice.begin(), slice.end(), comp);
+        for (int64_t j = 0; j < n; ++j) {
+          out_values[i * n + j] = slice[j].first;
+          out_indices[i * n + j] = slice[j].second;
+        }
+      }
+    });
+  } else {
+    std::vector<elem_t> slice(n);
+    for (int64_t i = 0; i < nslices; ++i) {
+      const scalar_t* src = in + i * n;
+      for (int64_t j = 0; j < n; ++j) {
+        slice[j] = elem_t(src[j], j);
+      }
+      parallel_merge_sort(slice.data(), n, comp);
+      for (int64_t j = 0; j < n; ++j) {
+        out_values[i * n + j] = slice[j].first;
+        out_indices[i * n + j] = slice[j].second;
+      }
+    }
+  }
+}
+
+static void sort_kernel(
+    Tensor& values,
+    Tensor& indices,
+    const Tensor& self,
+    int64_t dim,
+    bool descending) {
+  const int64_t last_dim = self.dim() - 1;
+  auto self_t = self.transpose(dim, last_dim).contiguous();
+  const int64_t n = self_t.size(last_dim);
+  const int64_t nslices = self_t.numel() / n;
+  Tensor values_t = at::empty(self_t.sizes(), self_t.options());
+  Tensor indices_t = at::empty(self_t.sizes(), self_t.options().dtype(kLong));
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "sort_cpu", [&] {
+    using elem_t = std::pair<scalar_t, int64_t>;
+    const scalar_t* self_data = self_t.data_ptr<scalar_t>();
+    scalar_t* values_data = values_t.data_ptr<scalar_t>();
+    int64_t* indices_data = indices_t.data_ptr<int64_t>();
+    // we want NaN to be sorted as top for numpy compatibility
+    if (descending) {
+      sort_slices(
+          self_data,
+          values_data,
+          indices_data,
+          nslices,
+          n,
+          [](const elem_t& x, const elem_t& y) -> bool {
+            return ((_isnan<scalar_t>(x.first) && !_isnan<scalar_t>(y.first)) || (x.first > y.first));
+          });
+    } else {
+      sort_slices(
+          self_data,
+          values_data,
+          indices_data,
+          nslices,
+          n,
+          [](const elem_t& x, const elem_t& y) -> bool {
+            return ((!_isnan<scalar_t>(x.first) && _isnan<scalar_t>(y.first)) || (x.first < y.first));
+          });
+    }
+  });
+  values.copy_(values_t.transpose(dim, last_dim));
+  indices.copy_(indices_t.transpose(dim, last_dim));
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(topk_stub, &topk_kernel);
+REGISTER_DISPATCH(sort_stub, &sort_kernel);
 
 }} //at::native
@@ -8,6 +8,9 @@
 #include <ATen/Parallel.h>
 #include <ATen/NumericUtils.h>
 #include <c10/util/Optional.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/Loops.h>
 #include <ATen/native/cpu/zmath.h>
 
 namespace at { namespace native { namespace {
@@ -101,9 +104,75 @@ static void min_kernel_impl(
   });
 }
 
+// where for floating point types: blendv on whole vectors. The byte (or
+// bool) condition has a different width than the values, so cpu_kernel_vec
+// cannot be used; instead the contiguous inner loop expands the condition
+// bytes into one lane per element (a fixed-trip loop the compiler turns
+// into a widening convert) and compares against zero to get the lane mask.
+template <typename scalar_t, typename cond_t>
+typename std::enable_if<std::is_floating_point<scalar_t>::value, void>::type
+where_kernel_cpu(TensorIterator& iter) {
+  using Vec = vec256::Vec256<scalar_t>;
+  iter.for_each([](char** data, const int64_t* strides, int64_t n) {
+    char* out_bytes = data[0];
+    const char* cond_bytes = data[1];
+    const char* self_bytes = data[2];
+    const char* other_bytes = data[3];
+    if (strides[0] == sizeof(scalar_t) && strides[1] == sizeof(cond_t) &&
+        strides[2] == sizeof(scalar_t) && strides[3] == sizeof(scalar_t)) {
+      auto* out = reinterpret_cast<scalar_t*>(out_bytes);
+      auto* cond = reinterpret_cast<const cond_t*>(cond_bytes);
+      auto* self = reinterpret_cast<const scalar_t*>(self_bytes);
+      auto* other = reinterpret_cast<const scalar_t*>(other_bytes);
+      int64_t i = 0;
+      alignas(64) scalar_t lane_mask[Vec::size()];
+      for (; i + Vec::size() <= n; i += Vec::size()) {
+        for (int64_t j = 0; j < Vec::size(); j++) {
+          lane_mask[j] = cond[i + j] ? scalar_t(1) : scalar_t(0);
+        }
+        const Vec mask = Vec::loadu(lane_mask) != Vec(scalar_t(0));
+        const Vec self_vec = Vec::loadu(self + i);
+        const Vec other_vec = Vec::loadu(other + i);
+        Vec::blendv(other_vec, self_vec, mask).store(out + i);
+      }
+      for (; i < n; i++) {
+        out[i] = cond[i] ? self[i] : other[i];
+      }
+    } else {
+      for (int64_t i = 0; i < n; i++) {
+        cond_t c = *reinterpret_cast<const cond_t*>(cond_bytes + i * strides[1]);
+        const scalar_t* src = c
+            ? reinterpret_cast<const scalar_t*>(self_bytes + i * strides[2])
+            : reinterpret_cast<const scalar_t*>(other_bytes + i * strides[3]);
+        *reinterpret_cast<scalar_t*>(out_bytes + i * strides[0]) = *src;
+      }
+    }
+  });
+}
+
+template <typename scalar_t, typename cond_t>
+typename std::enable_if<!std::is_floating_point<scalar_t>::value, void>::type
+where_kernel_cpu(TensorIterator& iter) {
+  cpu_kernel(
+      iter, [](cond_t cond_val, scalar_t self_val, scalar_t other_val) -> scalar_t {
+        return cond_val ? self_val : other_val;
+      });
+}
+
+static void where_kernel_impl(TensorIterator& iter, ScalarType condition_type) {
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX(iter.dtype(), "where_cpu", [&] {
+    if (condition_type == at::ScalarType::Byte) {
+      where_kernel_cpu<scalar_t, uint8_t>(iter);
+    } else {
+      where_kernel_cpu<scalar_t, bool>(iter);
+    }
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(max_kernel, &max_kernel_impl);
 REGISTER_DISPATCH(min_kernel, &min_kernel_impl);
+REGISTER_DISPATCH(where_kernel, &where_kernel_impl);
 
 }} // namespace at::native
@@ -4,6 +4,10 @@
 #include <ATen/native/DispatchStub.h>
 #include <c10/util/Optional.h>
 
+namespace at {
+  struct TensorIterator;
+}
+
 namespace at { namespace native {
 
 using reduce_fn =
@@ -12,4 +16,8 @@ using reduce_fn =
 DECLARE_DISPATCH(reduce_fn, max_kernel);
 DECLARE_DISPATCH(reduce_fn, min_kernel);
 
+using where_fn = void (*)(TensorIterator&, ScalarType);
+
+DECLARE_DISPATCH(where_fn, where_kernel);
+
 }} // namespace at::native
@@ -0,0 +1,249 @@
+#include <ATen/native/UpSample.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+template <typename scalar_t>
+void cpu_upsample_nearest2d(Tensor& output, const Tensor& input) {
+  const scalar_t* idata = input.data_ptr<scalar_t>();
+  scalar_t* odata = output.data_ptr<scalar_t>();
+
+  const int64_t nbatch = input.size(0);
+  const int64_t channels = input.size(1);
+  const int64_t input_height = input.size(2);
+  const int64_t input_width = input.size(3);
+  const int64_t output_height = output.size(2);
+  const int64_t output_width = output.size(3);
+
+  const float height_scale = (float)input_height / (float)output_height;
+  const float width_scale = (float)input_width / (float)output_width;
+
+  // The source column of each output column does not depend on the row, so
+  // it is computed once here instead of once per row.
+  std::vector<int64_t> source_x(output_width);
+  if (input_width != output_width) {
+    for (int64_t w2 = 0; w2 < output_width; ++w2) {
+      source_x[w2] =
+          nearest_neighbor_compute_source_index(width_scale, w2, input_width);
+    }
+  }
+
+  const int64_t rows = nbatch * channels * output_height;
+  const int64_t grain =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(output_width, 1));
+  at::parallel_for(0, rows, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; ++r) {
+      const int64_t c = r / output_height;
+      const int64_t h2 = r % output_height;
+      const int64_t h1 = input_height == output_height
+          ? h2
+          : nearest_neighbor_compute_source_index(height_scale, h2, input_height);
+      const scalar_t* src = idata + (c * input_height + h1) * input_width;
+      scalar_t* dst = odata + r * output_width;
+      if (input_width == output_width) {
+        std::memcpy(dst, src, output_width * sizeof(scalar_t));
+      } else {
+        for (int64_t w2 = 0; w2 < output_width; ++w2) {
+          dst[w2] = src[source_x[w2]];
+        }
+      }
+    }
+  });
+}
+
+template <typename scalar_t>
+void cpu_upsample_bilinear2d(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners) {
+  const scalar_t* idata = input.data_ptr<scalar_t>();
+  scalar_t* odata = output.data_ptr<scalar_t>();
+
+  const int64_t nbatch = input.size(0);
+  const int64_t channels = input.size(1);
+  const int64_t input_height = input.size(2);
+  const int64_t input_width = input.size(3);
+  const int64_t output_height = output.size(2);
+  const int64_t output_width = output.size(3);
+
+  if (input_height == output_height && input_width == output_width) {
+    std::memcpy(
+        odata,
+        idata,
+        nbatch * channels * input_height * input_width * sizeof(scalar_t));
+    return;
+  }
+
+  const scalar_t rheight = area_pixel_compute_scale<scalar_t>(
+      input_height, output_height, align_corners);
+  const scalar_t rwidth = area_pixel_compute_scale<scalar_t>(
+      input_width, output_width, align_corners);
+
+  // Horizontal source indices and interpolation weights are shared by every
+  // output row, so they are precomputed once up front.
+  std::vector<int64_t> x0(output_width);
+  std::vector<int64_t> x1p(output_width);
+  std::vector<scalar_t> w0lambda(output_width);
+  std::vector<scalar_t> w1lambda(output_width);
+  for (int64_t w2 = 0; w2 < output_width; ++w2) {
+    const scalar_t w1r = area_pixel_compute_source_index<scalar_t>(
+        rwidth, w2, align_corners, /*cubic=*/false);
+    x0[w2] = static_cast<int64_t>(w1r);
+    x1p[w2] = (x0[w2] < input_width - 1) ? 1 : 0;
+    w1lambda[w2] = w1r - x0[w2];
+    w0lambda[w2] = static_cast<scalar_t>(1.) - w1lambda[w2];
+  }
+
+  const int64_t rows = nbatch * channels * output_height;
+  const int64_t grain =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(output_width, 1));
+  at::parallel_for(0, rows, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t r = begin; r < end; ++r) {
+      const int64_t c = r / output_height;
+      const int64_t h2 = r % output_height;
+      const scalar_t h1r = area_pixel_compute_source_index<scalar_t>(
+          rheight, h2, align_corners, /*cubic=*/false);
+      const int64_t h1 = h1r;
+      const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
+      const scalar_t h1lambda = h1r - h1;
+      const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
+
+      const scalar_t* i0 = idata + (c * input_height + h1) * input_width;
+      const scalar_t* i1 = i0 + h1p * input_width;
+      scalar_t* dst = odata + r * output_width;
+      for (int64_t w2 = 0; w2 < output_width; ++w2) {
+        const int64_t w1 = x0[w2];
+        const int64_t w1p = x1p[w2];
+        dst[w2] =
+            h0lambda * (w0lambda[w2] * i0[w1] + w1lambda[w2] * i0[w1 + w1p]) +
+            h1lambda * (w0lambda[w2] * i1[w1] + w1lambda[w2] * i1[w1 + w1p]);
+      }
+    }
+  });
+}
+
+// NHWC layout: the four source corners of each output pixel hold all
+// channels contiguously, so the channel loop runs on vec256 lanes.
+template <typename scalar_t>
+void cpu_upsample_bilinear2d_channels_last(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners) {
+  using Vec = vec256::Vec256<scalar_t>;
+
+  const scalar_t* idata = input.data_ptr<scalar_t>();
+  scalar_t* odata = output.data_ptr<scalar_t>();
+
+  const int64_t nbatch = input.size(0);
+  const int64_t channels = input.size(1);
+  const int64_t input_height = input.size(2);
+  const int64_t input_width = input.size(3);
+  const int64_t output_height = output.size(2);
+  const int64_t output_width = output.size(3);
+
+  if (input_height == output_height && input_width == output_width) {
+    std::memcpy(
+        odata,
+        idata,
+        nbatch * channels * input_height * input_width * sizeof(scalar_t));
+    return;
+  }
+
+  const scalar_t rheight = area_pixel_compute_scale<scalar_t>(
+      input_height, output_height, align_corners);
+  const scalar_t rwidth = area_pixel_compute_scale<scalar_t>(
+      input_width, output_width, align_corners);
+
+  std::vector<int64_t> x0(output_width);
+  std::vector<int64_t> x1p(output_width);
+  std::vector<scalar_t> w0lambda(output_width);
+  std::vector<scalar_t> w1lambda(output_width);
+  for (int64_t w2 = 0; w2 < output_width; ++w2) {
+    const scalar_t w1r = area_pixel_compute_source_index<scalar_t>(
+        rwidth, w2, align_corners, /*cubic=*/false);
+    x0[w2] = static_cast<int64_t>(w1r);
+    x1p[w2] = (x0[w2] < input_width - 1) ? 1 : 0;
+    w1lambda[w2] = w1r - x0[w2];
+    w0lambda[w2] = static_cast<scalar_t>(1.) - w1lambda[w2];
+  }
+
+  const int64_t pixels = nbatch * output_height * output_width;
+  const int64_t grain =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / std::max<int64_t>(channels, 1));
+  at::parallel_for(0, pixels, grain, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; ++p) {
+      const int64_t w2 = p % output_width;
+      const int64_t h2 = (p / output_width) % output_height;
+      const int64_t n = p / (output_width * output_height);
+
+      const scalar_t h1r = area_pixel_compute_source_index<scalar_t>(
+          rheight, h2, align_corners, /*cubic=*/false);
+      const int64_t h1 = h1r;
+      const int64_t h1p = (h1 < input_height - 1) ? 1 : 0;
+      const scalar_t h1lambda = h1r - h1;
+      const scalar_t h0lambda = static_cast<scalar_t>(1.) - h1lambda;
+
+      const scalar_t* pos00 = idata +
+          ((n * input_height + h1) * input_width + x0[w2]) * channels;
+      const scalar_t* pos01 = pos00 + x1p[w2] * channels;
+      const scalar_t* pos10 = pos00 + h1p * input_width * channels;
+      const scalar_t* pos11 = pos10 + x1p[w2] * channels;
+      scalar_t* pos2 = odata + p * channels;
+
+      const Vec w00(h0lambda * w0lambda[w2]);
+      const Vec w01(h0lambda * w1lambda[w2]);
+      const Vec w10(h1lambda * w0lambda[w2]);
+      const Vec w11(h1lambda * w1lambda[w2]);
+      int64_t d = 0;
+      for (; d < channels - (channels % Vec::size()); d += Vec::size()) {
+        (w00 * Vec::loadu(pos00 + d) + w01 * Vec::loadu(pos01 + d) +
+         w10 * Vec::loadu(pos10 + d) + w11 * Vec::loadu(pos11 + d))
+            .store(pos2 + d);
+      }
+      for (; d < channels; ++d) {
+        pos2[d] = h0lambda * w0lambda[w2] * pos00[d] +
+            h0lambda * w1lambda[w2] * pos01[d] +
+            h1lambda * w0lambda[w2] * pos10[d] +
+            h1lambda * w1lambda[w2] * pos11[d];
+      }
+    }
+  });
+}
+
+void upsample_nearest2d_kernel_impl(Tensor& output, const Tensor& input) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "upsample_nearest2d", [&] {
+    cpu_upsample_nearest2d<scalar_t>(output, input);
+  });
+}
+
+void upsample_bilinear2d_kernel_impl(
+    Tensor& output,
+    const Tensor& input,
+    bool align_corners) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "upsample_bilinear2d", [&] {
+    if (input.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+      cpu_upsample_bilinear2d_channels_last<scalar_t>(
+          output, input, align_corners);
+    } else {
+      cpu_upsample_bilinear2d<scalar_t>(output, input, align_corners);
+    }
+  });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(upsample_nearest2d_stub, &upsample_nearest2d_kernel_impl);
+REGISTER_DISPATCH(upsample_bilinear2d_stub, &upsample_bilinear2d_kernel_impl);
+
+} // namespace native
+} // namespace at
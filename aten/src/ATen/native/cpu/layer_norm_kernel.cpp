@@ -1,16 +1,75 @@
 #include <ATen/native/layer_norm.h>
 
 #include <cmath>
+#include <cstring>
+#include <utility>
 
 #include <ATen/ATen.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
+#include <ATen/cpu/vec256/vec256.h>
 
 namespace at {
 namespace native {
 
 namespace {
 
+// Merges the moments (count, mean, sum of squared deviations) of two sample
+// sets, following Chan et al. Used to combine the per-lane Welford
+// accumulators and the scalar tail below.
+template <typename T>
+void AddMoments(int64_t m0_add, T m1_add, T m2_add, int64_t& m0, T& m1, T& m2) {
+  const int64_t n = m0 + m0_add;
+  const T c = n == 0 ? T(0) : static_cast<T>(m0_add) / static_cast<T>(n);
+  const T delta = m1_add - m1;
+  m1 += c * delta;
+  m2 += m2_add + delta * delta * c * static_cast<T>(m0);
+  m0 = n;
+}
+
+// Computes the mean and (biased) variance of one row in a single pass using
+// a vectorized Welford recurrence: each vector lane maintains its own
+// running mean and sum of squared deviations, and the lanes are merged at
+// the end. This reads the row once and is numerically stable even when the
+// values are large relative to their spread.
+template <typename T>
+std::pair<T, T> RowwiseMoments(const T* X_ptr, int64_t N) {
+  using Vec = vec256::Vec256<T>;
+  constexpr int64_t K = Vec::size();
+  const int64_t n = N / K * K;
+  Vec mean_vec(0);
+  Vec m2_vec(0);
+  int64_t k = 0;
+  for (int64_t d = 0; d < n; d += K) {
+    ++k;
+    const Vec x_vec = Vec::loadu(X_ptr + d);
+    const Vec delta_vec = x_vec - mean_vec;
+    mean_vec = mean_vec + delta_vec * Vec(T(1) / static_cast<T>(k));
+    m2_vec = m2_vec + delta_vec * (x_vec - mean_vec);
+  }
+  T mean_arr[K];
+  T m2_arr[K];
+  mean_vec.store(mean_arr);
+  m2_vec.store(m2_arr);
+  int64_t m0 = 0;
+  T m1 = T(0);
+  T m2 = T(0);
+  if (k > 0) {
+    for (int64_t i = 0; i < K; ++i) {
+      AddMoments(k, mean_arr[i], m2_arr[i], m0, m1, m2);
+    }
+  }
+  for (int64_t d = n; d < N; ++d) {
+    ++m0;
+    const T delta = X_ptr[d] - m1;
+    m1 += delta / static_cast<T>(m0);
+    m2 += delta * (X_ptr[d] - m1);
+  }
+  return std::make_pair(m1, m2 / static_cast<T>(N));
+}
+
 template <typename T>
 void LayerNormKernelImplInternal(
     const Tensor& X,
@@ -22,6 +81,7 @@ void LayerNormKernelImplInternal(
     Tensor* Y,
     Tensor* mean,
     Tensor* rstd) {
+  using Vec = vec256::Vec256<T>;
   DCHECK_EQ(X.numel(), M * N);
   DCHECK(!gamma.defined() || gamma.numel() == N);
   DCHECK(!beta.defined() || beta.numel() == N);
@@ -31,28 +91,42 @@ void LayerNormKernelImplInternal(
   T* Y_data = Y->data_ptr<T>();
   T* mean_data = mean->data_ptr<T>();
   T* rstd_data = rstd->data_ptr<T>();
-  const T c = T(1) / static_cast<T>(N);
   const bool gamma_null = gamma_data == nullptr;
   const bool beta_null = beta_data == nullptr;
   at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
     for (int64_t i = start; i < end; ++i) {
       const T* X_ptr = X_data + i * N;
       T* Y_ptr = Y_data + i * N;
-      T mean_val = T(0);
-      T rstd_val = T(0);
-      for (int64_t j = 0; j < N; ++j) {
-        mean_val += X_ptr[j];
-        rstd_val += X_ptr[j] * X_ptr[j];
-      }
-      mean_val *= c;
-      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T(0));
-      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      T mean_val;
+      T var_val;
+      std::tie(mean_val, var_val) = RowwiseMoments(X_ptr, N);
+      const T rstd_val = T(1) / std::sqrt(std::max(var_val, T(0)) + eps);
       const T scale = rstd_val;
       const T bias = -rstd_val * mean_val;
-      for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        const T beta_v = beta_null ? T(0) : beta_data[j];
-        Y_ptr[j] = (X_ptr[j] * scale + bias) * gamma_v + beta_v;
+      if (gamma_null && beta_null) {
+        vec256::map(
+            [scale, bias](Vec x) { return x * Vec(scale) + Vec(bias); },
+            Y_ptr,
+            X_ptr,
+            N);
+      } else {
+        const int64_t n = N / Vec::size() * Vec::size();
+        int64_t d = 0;
+        for (; d < n; d += Vec::size()) {
+          const Vec gamma_vec =
+              gamma_null ? Vec(T(1)) : Vec::loadu(gamma_data + d);
+          const Vec beta_vec =
+              beta_null ? Vec(T(0)) : Vec::loadu(beta_data + d);
+          const Vec y_vec =
+              (Vec::loadu(X_ptr + d) * Vec(scale) + Vec(bias)) * gamma_vec +
+              beta_vec;
+          y_vec.store(Y_ptr + d);
+        }
+        for (; d < N; ++d) {
+          const T gamma_v = gamma_null ? T(1) : gamma_data[d];
+          const T beta_v = beta_null ? T(0) : beta_data[d];
+          Y_ptr[d] = (X_ptr[d] * scale + bias) * gamma_v + beta_v;
+        }
       }
       mean_data[i] = mean_val;
       rstd_data[i] = rstd_val;
@@ -76,6 +150,143 @@ void LayerNormKernelImpl(
   });
 }
 
+// Writes the dropout + residual-add result for one row:
+//   X[d] = input[d] * mask[d] / keep_prob + residual[d]
+// A null mask means dropout is disabled (keep_prob == 1).
+template <typename T>
+void DropoutAddRow(
+    const T* input_ptr,
+    const T* residual_ptr,
+    const uint8_t* mask_ptr,
+    T pinv,
+    int64_t N,
+    T* X_ptr) {
+  using Vec = vec256::Vec256<T>;
+  if (mask_ptr == nullptr) {
+    vec256::map2(
+        [](Vec x, Vec r) { return x + r; }, X_ptr, input_ptr, residual_ptr, N);
+    return;
+  }
+  for (int64_t d = 0; d < N; ++d) {
+    X_ptr[d] = mask_ptr[d] ? input_ptr[d] * pinv + residual_ptr[d]
+                           : residual_ptr[d];
+  }
+}
+
+template <typename T>
+void DropoutAddLayerNormKernelImplInternal(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& mask,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T keep_prob,
+    T eps,
+    Tensor* X,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using Vec = vec256::Vec256<T>;
+  DCHECK_EQ(input.numel(), M * N);
+  DCHECK_EQ(residual.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* input_data = input.data_ptr<T>();
+  const T* residual_data = residual.data_ptr<T>();
+  const uint8_t* mask_data =
+      mask.defined() && mask.numel() > 0 ? mask.data_ptr<uint8_t>() : nullptr;
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* X_data = X->data_ptr<T>();
+  T* Y_data = Y->data_ptr<T>();
+  T* mean_data = mean->data_ptr<T>();
+  T* rstd_data = rstd->data_ptr<T>();
+  const T pinv = T(1) / keep_prob;
+  const bool gamma_null = gamma_data == nullptr;
+  const bool beta_null = beta_data == nullptr;
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const T* input_ptr = input_data + i * N;
+      const T* residual_ptr = residual_data + i * N;
+      const uint8_t* mask_ptr =
+          mask_data == nullptr ? nullptr : mask_data + i * N;
+      T* X_ptr = X_data + i * N;
+      T* Y_ptr = Y_data + i * N;
+      // The row is materialized once and normalized while still hot in
+      // cache, instead of round-tripping two intermediates through memory.
+      DropoutAddRow(input_ptr, residual_ptr, mask_ptr, pinv, N, X_ptr);
+      T mean_val;
+      T var_val;
+      std::tie(mean_val, var_val) = RowwiseMoments(X_ptr, N);
+      const T rstd_val = T(1) / std::sqrt(std::max(var_val, T(0)) + eps);
+      const T scale = rstd_val;
+      const T bias = -rstd_val * mean_val;
+      if (gamma_null && beta_null) {
+        vec256::map(
+            [scale, bias](Vec x) { return x * Vec(scale) + Vec(bias); },
+            Y_ptr,
+            X_ptr,
+            N);
+      } else {
+        const int64_t n = N / Vec::size() * Vec::size();
+        int64_t d = 0;
+        for (; d < n; d += Vec::size()) {
+          const Vec gamma_vec =
+              gamma_null ? Vec(T(1)) : Vec::loadu(gamma_data + d);
+          const Vec beta_vec =
+              beta_null ? Vec(T(0)) : Vec::loadu(beta_data + d);
+          const Vec y_vec =
+              (Vec::loadu(X_ptr + d) * Vec(scale) + Vec(bias)) * gamma_vec +
+              beta_vec;
+          y_vec.store(Y_ptr + d);
+        }
+        for (; d < N; ++d) {
+          const T gamma_v = gamma_null ? T(1) : gamma_data[d];
+          const T beta_v = beta_null ? T(0) : beta_data[d];
+          Y_ptr[d] = (X_ptr[d] * scale + bias) * gamma_v + beta_v;
+        }
+      }
+      mean_data[i] = mean_val;
+      rstd_data[i] = rstd_val;
+    }
+  });
+}
+
+void DropoutAddLayerNormKernelImpl(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& mask,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    double eps,
+    Tensor* X,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES(
+      input.scalar_type(), "DropoutAddLayerNormKernelImpl", [&]() {
+        DropoutAddLayerNormKernelImplInternal<scalar_t>(
+            input,
+            residual,
+            mask,
+            gamma,
+            beta,
+            M,
+            N,
+            static_cast<scalar_t>(keep_prob),
+            static_cast<scalar_t>(eps),
+            X,
+            Y,
+            mean,
+            rstd);
+      });
+}
+
 template <typename T>
 void LayerNormBackwardKernelImplInternal(
     const Tensor& dY,
@@ -88,6 +299,7 @@ void LayerNormBackwardKernelImplInternal(
     Tensor* dX,
     Tensor* dgamma,
     Tensor* dbeta) {
+  using Vec = vec256::Vec256<T>;
   DCHECK_EQ(dY.numel(), M * N);
   DCHECK_EQ(X.numel(), M * N);
   DCHECK_EQ(mean.numel(), M);
@@ -101,47 +313,118 @@ void LayerNormBackwardKernelImplInternal(
       gamma.defined() ? gamma.template data_ptr<T>() : nullptr;
   T* dX_data = dX->defined() ? dX->template data_ptr<T>() : nullptr;
   T* dgamma_data = dgamma->defined() ? dgamma->template data_ptr<T>() : nullptr;
-  if (dgamma_data != nullptr) {
-    std::memset(dgamma_data, 0, N * sizeof(T));
-  }
   T* dbeta_data = dbeta->defined() ? dbeta->template data_ptr<T>() : nullptr;
-  if (dbeta_data != nullptr) {
-    std::memset(dbeta_data, 0, N * sizeof(T));
-  }
   const T scale = T(1) / static_cast<T>(N);
   const bool gamma_null = gamma_data == nullptr;
-  for (int64_t i = 0; i < M; ++i) {
-    const T* dY_ptr = dY_data + i * N;
-    const T* X_ptr = X_data + i * N;
-    if (dX_data != nullptr) {
-      T* dX_ptr = dX_data + i * N;
-      T ds = 0;
-      T db = 0;
-      for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        ds += dY_ptr[j] * X_ptr[j] * gamma_v;
-        db += dY_ptr[j] * gamma_v;
-      }
+
+  // dgamma and dbeta are reductions over the rows, so each worker
+  // accumulates into its own slice of a scratch buffer; the slices are
+  // summed after the parallel section.
+  const int num_threads = at::get_num_threads();
+  Tensor buffer;
+  T* buffer_data = nullptr;
+  if (dgamma_data != nullptr || dbeta_data != nullptr) {
+    buffer = at::zeros({num_threads, 2 * N}, X.options());
+    buffer_data = buffer.template data_ptr<T>();
+  }
+
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    const int tid = at::get_thread_num();
+    T* dgamma_buffer_ptr =
+        buffer_data == nullptr ? nullptr : buffer_data + tid * 2 * N;
+    T* dbeta_buffer_ptr =
+        buffer_data == nullptr ? nullptr : buffer_data + tid * 2 * N + N;
+    for (int64_t i = start; i < end; ++i) {
+      const T* dY_ptr = dY_data + i * N;
+      const T* X_ptr = X_data + i * N;
       const T a = rstd_data[i];
-      const T b = (db * mean_data[i] - ds) * a * a * a * scale;
-      const T c = -b * mean_data[i] - db * a * scale;
-      for (int64_t j = 0; j < N; ++j) {
-        const T gamma_v = gamma_null ? T(1) : gamma_data[j];
-        dX_ptr[j] = a * dY_ptr[j] * gamma_v + b * X_ptr[j] + c;
+      const T b_coef = -a * mean_data[i];
+      if (dX_data != nullptr) {
+        T* dX_ptr = dX_data + i * N;
+        const int64_t n = N / Vec::size() * Vec::size();
+        Vec ds_vec(0);
+        Vec db_vec(0);
+        int64_t d = 0;
+        for (; d < n; d += Vec::size()) {
+          const Vec gamma_vec =
+              gamma_null ? Vec(T(1)) : Vec::loadu(gamma_data + d);
+          const Vec dyg_vec = Vec::loadu(dY_ptr + d) * gamma_vec;
+          ds_vec = ds_vec + dyg_vec * Vec::loadu(X_ptr + d);
+          db_vec = db_vec + dyg_vec;
+        }
+        T ds = vec256::vec_reduce_all(
+            [](Vec x, Vec y) { return x + y; }, ds_vec, Vec::size());
+        T db = vec256::vec_reduce_all(
+            [](Vec x, Vec y) { return x + y; }, db_vec, Vec::size());
+        for (; d < N; ++d) {
+          const T gamma_v = gamma_null ? T(1) : gamma_data[d];
+          ds += dY_ptr[d] * X_ptr[d] * gamma_v;
+          db += dY_ptr[d] * gamma_v;
+        }
+        const T b = (db * mean_data[i] - ds) * a * a * a * scale;
+        const T c = -b * mean_data[i] - db * a * scale;
+        d = 0;
+        for (; d < n; d += Vec::size()) {
+          const Vec gamma_vec =
+              gamma_null ? Vec(T(1)) : Vec::loadu(gamma_data + d);
+          const Vec dx_vec = Vec(a) * Vec::loadu(dY_ptr + d) * gamma_vec +
+              Vec(b) * Vec::loadu(X_ptr + d) + Vec(c);
+          dx_vec.store(dX_ptr + d);
+        }
+        for (; d < N; ++d) {
+          const T gamma_v = gamma_null ? T(1) : gamma_data[d];
+          dX_ptr[d] = a * dY_ptr[d] * gamma_v + b * X_ptr[d] + c;
+        }
       }
-    }
-    if (dgamma_data != nullptr) {
-      const T a = rstd_data[i];
-      const T b = -a * mean_data[i];
-      for (int64_t j = 0; j < N; ++j) {
-        dgamma_data[j] += dY_ptr[j] * (a * X_ptr[j] + b);
+      if (dgamma_buffer_ptr != nullptr && dgamma_data != nullptr) {
+        const int64_t n = N / Vec::size() * Vec::size();
+        int64_t d = 0;
+        for (; d < n; d += Vec::size()) {
+          const Vec dgamma_vec = Vec::loadu(dgamma_buffer_ptr + d) +
+              Vec::loadu(dY_ptr + d) *
+                  (Vec(a) * Vec::loadu(X_ptr + d) + Vec(b_coef));
+          dgamma_vec.store(dgamma_buffer_ptr + d);
+        }
+        for (; d < N; ++d) {
+          dgamma_buffer_ptr[d] += dY_ptr[d] * (a * X_ptr[d] + b_coef);
+        }
       }
-    }
-    if (dbeta_data != nullptr) {
-      for (int64_t j = 0; j < N; ++j) {
-        dbeta_data[j] += dY_ptr[j];
+      if (dbeta_buffer_ptr != nullptr && dbeta_data != nullptr) {
+        const int64_t n = N / Vec::size() * Vec::size();
+        int64_t d = 0;
+        for (; d < n; d += Vec::size()) {
+          const Vec dbeta_vec =
+              Vec::loadu(dbeta_buffer_ptr + d) + Vec::loadu(dY_ptr + d);
+          dbeta_vec.store(dbeta_buffer_ptr + d);
+        }
+        for (; d < N; ++d) {
+          dbeta_buffer_ptr[d] += dY_ptr[d];
+        }
       }
     }
+  });
+
+  if (dgamma_data != nullptr) {
+    std::memset(dgamma_data, 0, N * sizeof(T));
+    for (int tid = 0; tid < num_threads; ++tid) {
+      vec256::map2(
+          [](Vec x, Vec y) { return x + y; },
+          dgamma_data,
+          dgamma_data,
+          buffer_data + tid * 2 * N,
+          N);
+    }
+  }
+  if (dbeta_data != nullptr) {
+    std::memset(dbeta_data, 0, N * sizeof(T));
+    for (int tid = 0; tid < num_threads; ++tid) {
+      vec256::map2(
+          [](Vec x, Vec y) { return x + y; },
+          dbeta_data,
+          dbeta_data,
+          buffer_data + tid * 2 * N + N,
+          N);
+    }
   }
 }
 
@@ -163,10 +446,86 @@ void LayerNormBackwardKernelImpl(
       });
 }
 
+template <typename T>
+void DropoutAddLayerNormBackwardKernelImplInternal(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    T keep_prob,
+    Tensor* dinput,
+    Tensor* dresidual,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  // The residual branch sees the unmodified LayerNorm input gradient, so
+  // the existing backward kernel computes it (and dgamma/dbeta) directly.
+  LayerNormBackwardKernelImplInternal<T>(
+      dY, X, mean, rstd, gamma, M, N, dresidual, dgamma, dbeta);
+  if (!dinput->defined()) {
+    return;
+  }
+  // The dropout branch additionally applies the saved mask and rescale.
+  const T* dX_data = dresidual->template data_ptr<T>();
+  const uint8_t* mask_data =
+      mask.defined() && mask.numel() > 0 ? mask.data_ptr<uint8_t>() : nullptr;
+  T* dinput_data = dinput->template data_ptr<T>();
+  if (mask_data == nullptr) {
+    std::memcpy(dinput_data, dX_data, M * N * sizeof(T));
+    return;
+  }
+  const T pinv = T(1) / keep_prob;
+  at::parallel_for(0, M * N, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      dinput_data[i] = mask_data[i] ? dX_data[i] * pinv : T(0);
+    }
+  });
+}
+
+void DropoutAddLayerNormBackwardKernelImpl(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    Tensor* dinput,
+    Tensor* dresidual,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  AT_DISPATCH_FLOATING_TYPES(
+      X.scalar_type(), "DropoutAddLayerNormBackwardKernelImpl", [&]() {
+        DropoutAddLayerNormBackwardKernelImplInternal<scalar_t>(
+            dY,
+            X,
+            mask,
+            mean,
+            rstd,
+            gamma,
+            M,
+            N,
+            static_cast<scalar_t>(keep_prob),
+            dinput,
+            dresidual,
+            dgamma,
+            dbeta);
+      });
+}
+
 } // namespace
 
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
+REGISTER_DISPATCH(DropoutAddLayerNormKernel, &DropoutAddLayerNormKernelImpl);
+REGISTER_DISPATCH(
+    DropoutAddLayerNormBackwardKernel,
+    &DropoutAddLayerNormBackwardKernelImpl);
 
 } // namespace native
 } // namespace at
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at {
+namespace native {
+
+using cross_entropy_forward_fn = void (*)(
+    const Tensor& /* logits */,
+    const Tensor& /* target */,
+    int64_t /* reduction */,
+    int64_t /* ignore_index */,
+    Tensor* /* output */,
+    Tensor* /* logsumexp */);
+
+using cross_entropy_backward_fn = void (*)(
+    const Tensor& /* grad_output */,
+    const Tensor& /* logits */,
+    const Tensor& /* target */,
+    const Tensor& /* logsumexp */,
+    int64_t /* reduction */,
+    int64_t /* ignore_index */,
+    Tensor* /* grad_input */);
+
+DECLARE_DISPATCH(cross_entropy_forward_fn, CrossEntropyLossKernel);
+DECLARE_DISPATCH(cross_entropy_backward_fn, CrossEntropyLossBackwardKernel);
+
+} // namespace native
+} // namespace at
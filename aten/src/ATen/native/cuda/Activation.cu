@@ -300,7 +300,23 @@ static void threshold_kernel(TensorIterator& iter, Scalar threshold, Scalar valu
 
 namespace {
 
-void GeluCUDAKernelImpl(TensorIterator& it) {
+void GeluCUDAKernelImpl(TensorIterator& it, bool approximate) {
+  if (approximate) {
+    // The tanh approximation from the GELU paper:
+    //   y = 0.5x * (1 + tanh(sqrt(2/Pi) * (x + 0.044715x^3)))
+    AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+        it.dtype(), "GeluCUDAKernelImpl", [&]() {
+          using T_ACC = acc_type<scalar_t, true>;
+          gpu_kernel(it, [] GPU_LAMBDA(scalar_t x) -> scalar_t {
+            constexpr T_ACC kBeta = M_2_SQRTPI * M_SQRT1_2;
+            constexpr T_ACC kKappa = 0.044715;
+            const T_ACC x_acc = static_cast<T_ACC>(x);
+            const T_ACC inner = kBeta * (x_acc + kKappa * x_acc * x_acc * x_acc);
+            return x_acc * T_ACC(0.5) * (T_ACC(1) + ::tanh(inner));
+          });
+        });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(it.dtype(), "GeluCUDAKernelImpl", [&]() {
     using T_ACC = acc_type<scalar_t, true>;
     gpu_kernel(it, [] GPU_LAMBDA(scalar_t x) -> scalar_t {
@@ -310,7 +326,29 @@ void GeluCUDAKernelImpl(TensorIterator& it) {
   });
 }
 
-void GeluBackwardCUDAKernelImpl(TensorIterator& it) {
+void GeluBackwardCUDAKernelImpl(TensorIterator& it, bool approximate) {
+  if (approximate) {
+    AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+        it.dtype(), "GeluBackwardCUDAKernelImpl", [&]() {
+          using T_ACC = acc_type<scalar_t, true>;
+          gpu_kernel(it, [] GPU_LAMBDA(scalar_t dy, scalar_t x) -> scalar_t {
+            constexpr T_ACC kBeta = M_2_SQRTPI * M_SQRT1_2;
+            constexpr T_ACC kKappa = 0.044715;
+            const T_ACC x_acc = static_cast<T_ACC>(x);
+            const T_ACC inner = kBeta * (x_acc + kKappa * x_acc * x_acc * x_acc);
+            const T_ACC tanh_inner = ::tanh(inner);
+            const T_ACC left_derivative = T_ACC(0.5) * (T_ACC(1) + tanh_inner);
+            const T_ACC tanh_derivative = T_ACC(1) - tanh_inner * tanh_inner;
+            const T_ACC inner_derivative =
+                kBeta * (T_ACC(1) + T_ACC(3) * kKappa * x_acc * x_acc);
+            const T_ACC right_derivative =
+                T_ACC(0.5) * x_acc * tanh_derivative * inner_derivative;
+            return static_cast<T_ACC>(dy) *
+                (left_derivative + right_derivative);
+          });
+        });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(
       it.dtype(), "GeluBackwardCUDAKernelImpl", [&]() {
         using T_ACC = acc_type<scalar_t, true>;
@@ -328,17 +366,17 @@ void GeluBackwardCUDAKernelImpl(TensorIterator& it) {
 
 } // namespace
 
-Tensor gelu_cuda(const Tensor& self) {
+Tensor gelu_cuda(const Tensor& self, bool approximate) {
   Tensor Y = at::native::empty_like(self, at::MemoryFormat::Contiguous);
   auto it = TensorIterator::unary_op(Y, self);
-  GeluKernel(kCUDA, it);
+  GeluKernel(kCUDA, it, approximate);
   return Y;
 }
 
-Tensor gelu_backward_cuda(const Tensor& grad, const Tensor& self) {
+Tensor gelu_backward_cuda(const Tensor& grad, const Tensor& self, bool approximate) {
   Tensor dX = at::native::empty_like(self, at::MemoryFormat::Contiguous);
   auto it = TensorIterator::binary_op(dX, grad, self);
-  GeluBackwardKernel(kCUDA, it);
+  GeluBackwardKernel(kCUDA, it, approximate);
   return dX;
 }
 
@@ -2,6 +2,7 @@
 #include <ATen/AccumulateType.h>
 #include <ATen/cuda/CUDAApplyUtils.cuh>
 #include <ATen/CUDAGenerator.h>
+#include <ATen/cuda/PhiloxUtils.cuh>
 #include <ATen/cuda/detail/IndexUtils.cuh>
 #include <ATen/cuda/detail/TensorInfo.cuh>
 #include <c10/macros/Macros.h>
@@ -32,9 +33,12 @@ __global__ void
 fused_dropout_kernel(cuda::detail::TensorInfo<scalar_t, IndexType> a,
                       cuda::detail::TensorInfo<scalar_t, IndexType> b,
                       cuda::detail::TensorInfo<uint8_t, IndexType> c,
-                      IndexType totalElements, accscalar_t p, std::pair<uint64_t, uint64_t> seeds
+                      IndexType totalElements, accscalar_t p, PhiloxCudaState philox_args
                       ) {
 
+  // With a device-resident generator this reserves the block's philox
+  // counter range via atomicAdd; otherwise it unpacks the host-reserved pair.
+  auto seeds = cuda::philox::unpack(philox_args);
   accscalar_t pinv = accscalar_t(1)/p;
   IndexType idx = blockIdx.x * blockDim.x + threadIdx.x;
   curandStatePhilox4_32_10_t state;
@@ -101,11 +105,16 @@ fused_dropout_cuda(const Tensor& self, double p, Generator * gen_){
   grid.x = std::min((unsigned int)at::cuda::getCurrentDeviceProperties()->multiProcessorCount * blocks_per_sm, grid.x);
 //number of times random will be generated per thread, to offset philox counter in thc random state
   int64_t counter_offset = ((nelem - 1)/(block_size*grid.x*UNROLL)+1)*UNROLL;
-  std::pair<uint64_t, uint64_t> rng_engine_inputs;
-  {
+  PhiloxCudaState rng_engine_inputs;
+  if (gen->philox_state_on_device()) {
+    // Offset reservation happens on device when the kernel runs; nothing on
+    // the host mutates, so the generator mutex is not needed and concurrent
+    // streams do not serialize here.
+    rng_engine_inputs = gen->philox_cuda_state(counter_offset);
+  } else {
     // See Note [Acquire lock when using random generators]
     std::lock_guard<std::mutex> lock(gen->mutex_);
-    rng_engine_inputs = gen->philox_engine_inputs(counter_offset);
+    rng_engine_inputs = gen->philox_cuda_state(counter_offset);
   }
   if (cuda::detail::canUse32BitIndexMath(self)){
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(self.scalar_type(), "fused_dropout", [&] {
@@ -0,0 +1,202 @@
+#include <ATen/native/FusedOptimizerStep.h>
+
+#include <ATen/AccumulateType.h>
+#include <ATen/Dispatch.h>
+#include <ATen/DeviceGuard.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/native/cuda/MultiTensorApply.cuh>
+
+namespace at { namespace native {
+
+namespace {
+
+// Each functor updates one chunk of one tensor; the math matches
+// torch::optim::SGD::step() / Adam::step(), with the accumulation done in
+// acc_type so half parameters don't lose precision in the intermediate
+// products.
+
+template <typename scalar_t, int depth>
+__device__ __forceinline__ scalar_t* chunk_ptr(
+    TensorListMetadata<depth>& tl,
+    int list,
+    int tensor_loc,
+    int chunk_idx,
+    int chunk_size) {
+  return static_cast<scalar_t*>(tl.addresses[list][tensor_loc]) +
+      chunk_idx * chunk_size;
+}
+
+template <typename scalar_t>
+struct SGDStepFunctor {
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<2>& tl,
+      FusedSGDParams args) {
+    using accscalar_t = acc_type<scalar_t, true>;
+    const int tensor_loc = tl.block_to_tensor[blockIdx.x];
+    const int chunk_idx = tl.block_to_chunk[blockIdx.x];
+    int n = tl.sizes[tensor_loc] - chunk_idx * chunk_size;
+    n = n > chunk_size ? chunk_size : n;
+    scalar_t* p = chunk_ptr<scalar_t>(tl, 0, tensor_loc, chunk_idx, chunk_size);
+    const scalar_t* g =
+        chunk_ptr<scalar_t>(tl, 1, tensor_loc, chunk_idx, chunk_size);
+
+    const accscalar_t lr = static_cast<accscalar_t>(args.lr);
+    const accscalar_t weight_decay =
+        static_cast<accscalar_t>(args.weight_decay);
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      accscalar_t param = static_cast<accscalar_t>(p[i]);
+      accscalar_t update = static_cast<accscalar_t>(g[i]);
+      if (weight_decay > 0) {
+        update += weight_decay * param;
+      }
+      p[i] = static_cast<scalar_t>(param - lr * update);
+    }
+  }
+};
+
+template <typename scalar_t>
+struct SGDMomentumStepFunctor {
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<3>& tl,
+      FusedSGDParams args) {
+    using accscalar_t = acc_type<scalar_t, true>;
+    const int tensor_loc = tl.block_to_tensor[blockIdx.x];
+    const int chunk_idx = tl.block_to_chunk[blockIdx.x];
+    int n = tl.sizes[tensor_loc] - chunk_idx * chunk_size;
+    n = n > chunk_size ? chunk_size : n;
+    scalar_t* p = chunk_ptr<scalar_t>(tl, 0, tensor_loc, chunk_idx, chunk_size);
+    const scalar_t* g =
+        chunk_ptr<scalar_t>(tl, 1, tensor_loc, chunk_idx, chunk_size);
+    scalar_t* buf =
+        chunk_ptr<scalar_t>(tl, 2, tensor_loc, chunk_idx, chunk_size);
+
+    const accscalar_t lr = static_cast<accscalar_t>(args.lr);
+    const accscalar_t momentum = static_cast<accscalar_t>(args.momentum);
+    const accscalar_t weight_decay =
+        static_cast<accscalar_t>(args.weight_decay);
+    const accscalar_t dampening_factor = args.first_step
+        ? accscalar_t(1)
+        : static_cast<accscalar_t>(1 - args.dampening);
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      accscalar_t param = static_cast<accscalar_t>(p[i]);
+      accscalar_t update = static_cast<accscalar_t>(g[i]);
+      if (weight_decay > 0) {
+        update += weight_decay * param;
+      }
+      accscalar_t m = momentum * static_cast<accscalar_t>(buf[i]) +
+          dampening_factor * update;
+      buf[i] = static_cast<scalar_t>(m);
+      update = args.nesterov ? update + momentum * m : m;
+      p[i] = static_cast<scalar_t>(param - lr * update);
+    }
+  }
+};
+
+template <typename scalar_t, int depth>
+struct AdamStepFunctor {
+  static_assert(depth == 4 || depth == 5, "depth 5 iff amsgrad");
+  __device__ void operator()(
+      int chunk_size,
+      TensorListMetadata<depth>& tl,
+      FusedAdamParams args) {
+    using accscalar_t = acc_type<scalar_t, true>;
+    const int tensor_loc = tl.block_to_tensor[blockIdx.x];
+    const int chunk_idx = tl.block_to_chunk[blockIdx.x];
+    int n = tl.sizes[tensor_loc] - chunk_idx * chunk_size;
+    n = n > chunk_size ? chunk_size : n;
+    scalar_t* p = chunk_ptr<scalar_t>(tl, 0, tensor_loc, chunk_idx, chunk_size);
+    const scalar_t* g =
+        chunk_ptr<scalar_t>(tl, 1, tensor_loc, chunk_idx, chunk_size);
+    scalar_t* exp_avg =
+        chunk_ptr<scalar_t>(tl, 2, tensor_loc, chunk_idx, chunk_size);
+    scalar_t* exp_avg_sq =
+        chunk_ptr<scalar_t>(tl, 3, tensor_loc, chunk_idx, chunk_size);
+    scalar_t* max_exp_avg_sq = depth == 5
+        ? chunk_ptr<scalar_t>(tl, depth - 1, tensor_loc, chunk_idx, chunk_size)
+        : nullptr;
+
+    const accscalar_t beta1 = static_cast<accscalar_t>(args.beta1);
+    const accscalar_t beta2 = static_cast<accscalar_t>(args.beta2);
+    const accscalar_t weight_decay =
+        static_cast<accscalar_t>(args.weight_decay);
+    const accscalar_t eps = static_cast<accscalar_t>(args.eps);
+    const accscalar_t step_size =
+        static_cast<accscalar_t>(args.lr / args.bias_correction1);
+    const accscalar_t inv_bias_correction2 =
+        static_cast<accscalar_t>(1 / args.bias_correction2);
+    for (int i = threadIdx.x; i < n; i += blockDim.x) {
+      accscalar_t param = static_cast<accscalar_t>(p[i]);
+      accscalar_t grad = static_cast<accscalar_t>(g[i]);
+      if (weight_decay > 0) {
+        grad += weight_decay * param;
+      }
+      accscalar_t m =
+          beta1 * static_cast<accscalar_t>(exp_avg[i]) + (1 - beta1) * grad;
+      exp_avg[i] = static_cast<scalar_t>(m);
+      accscalar_t v = beta2 * static_cast<accscalar_t>(exp_avg_sq[i]) +
+          (1 - beta2) * grad * grad;
+      exp_avg_sq[i] = static_cast<scalar_t>(v);
+      if (depth == 5) {
+        v = ::max(static_cast<accscalar_t>(max_exp_avg_sq[i]), v);
+        max_exp_avg_sq[i] = static_cast<scalar_t>(v);
+      }
+      const accscalar_t denom = ::sqrt(v * inv_bias_correction2) + eps;
+      p[i] = static_cast<scalar_t>(param - step_size * m / denom);
+    }
+  }
+};
+
+void fused_sgd_cuda_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDParams& args) {
+  const OptionalDeviceGuard device_guard(device_of(params[0]));
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      params[0].scalar_type(), "fused_sgd_step_cuda", [&] {
+        if (momentum_buffers.empty()) {
+          std::vector<std::vector<Tensor>> lists{params.vec(), grads.vec()};
+          multi_tensor_apply<2>(lists, SGDStepFunctor<scalar_t>(), args);
+        } else {
+          std::vector<std::vector<Tensor>> lists{
+              params.vec(), grads.vec(), momentum_buffers.vec()};
+          multi_tensor_apply<3>(
+              lists, SGDMomentumStepFunctor<scalar_t>(), args);
+        }
+      });
+}
+
+void fused_adam_cuda_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    const FusedAdamParams& args) {
+  const OptionalDeviceGuard device_guard(device_of(params[0]));
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      params[0].scalar_type(), "fused_adam_step_cuda", [&] {
+        if (max_exp_avg_sqs.empty()) {
+          std::vector<std::vector<Tensor>> lists{
+              params.vec(), grads.vec(), exp_avgs.vec(), exp_avg_sqs.vec()};
+          multi_tensor_apply<4>(lists, AdamStepFunctor<scalar_t, 4>(), args);
+        } else {
+          std::vector<std::vector<Tensor>> lists{
+              params.vec(),
+              grads.vec(),
+              exp_avgs.vec(),
+              exp_avg_sqs.vec(),
+              max_exp_avg_sqs.vec()};
+          multi_tensor_apply<5>(lists, AdamStepFunctor<scalar_t, 5>(), args);
+        }
+      });
+}
+
+} // namespace
+
+REGISTER_DISPATCH(fused_sgd_stub, &fused_sgd_cuda_kernel);
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_cuda_kernel);
+
+}} // namespace at::native
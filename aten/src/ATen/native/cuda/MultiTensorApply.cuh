@@ -0,0 +1,110 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/cuda/CUDAContext.h>
+#include <ATen/cuda/Exceptions.h>
+
+#include <vector>
+
+namespace at { namespace native {
+
+// multi_tensor_apply launches a device functor over chunked lists of
+// tensors, so that one kernel launch covers as many tensors as fit in the
+// kernel argument space.  This is what makes the fused optimizer steps
+// cheap for models with many small parameters: instead of a few launches
+// per parameter, the whole update is a handful of launches total.
+//
+// `depth` is the number of parallel tensor lists the functor reads/writes
+// (e.g. 3 for SGD with momentum: params, grads, momentum buffers).  All
+// tensors must be contiguous and on the current device; tensors at the same
+// index of each list must have the same number of elements.  Each CUDA
+// block processes one chunk of one tensor; the functor receives the chunk
+// size and the metadata below and is responsible for the grid-stride loop
+// over its chunk.
+
+static constexpr int kMTABlockSize = 512;
+static constexpr int kMTAChunkSize = 65536;
+
+// Kernel arguments are limited to 4KB, so the number of tensors (and chunk
+// assignments) we can describe per launch depends on the depth.  Indexed by
+// depth - 1.
+static constexpr int depth_to_max_tensors[5] = {110, 64, 48, 36, 30};
+static constexpr int depth_to_max_blocks[5] = {320, 320, 320, 320, 320};
+
+template <int depth>
+struct TensorListMetadata {
+  void* addresses[depth][depth_to_max_tensors[depth - 1]];
+  int sizes[depth_to_max_tensors[depth - 1]];
+  unsigned char block_to_tensor[depth_to_max_blocks[depth - 1]];
+  int block_to_chunk[depth_to_max_blocks[depth - 1]];
+};
+
+template <typename T, typename U, typename... ArgTypes>
+C10_LAUNCH_BOUNDS_1(kMTABlockSize)
+__global__ void multi_tensor_apply_kernel(
+    T tensorListMeta,
+    U callable,
+    ArgTypes... args) {
+  callable(kMTAChunkSize, tensorListMeta, args...);
+}
+
+template <int depth, typename T, typename... ArgTypes>
+void multi_tensor_apply(
+    std::vector<std::vector<Tensor>>& tensor_lists,
+    T callable,
+    ArgTypes... args) {
+  TORCH_INTERNAL_ASSERT(
+      tensor_lists.size() == depth,
+      "multi_tensor_apply: expected ", depth, " tensor lists, got ",
+      tensor_lists.size());
+  const size_t n_tensors = tensor_lists[0].size();
+  auto stream = at::cuda::getCurrentCUDAStream();
+
+  TensorListMetadata<depth> tensorListMeta;
+  int loc_block_info = 0;
+  int loc_tensor_info = 0;
+  for (size_t t = 0; t < n_tensors; t++) {
+    tensorListMeta.sizes[loc_tensor_info] = tensor_lists[0][t].numel();
+    for (int d = 0; d < depth; d++) {
+      tensorListMeta.addresses[d][loc_tensor_info] =
+          tensor_lists[d][t].data_ptr();
+    }
+    loc_tensor_info++;
+
+    const auto chunks =
+        (tensor_lists[0][t].numel() + kMTAChunkSize - 1) / kMTAChunkSize;
+    for (int64_t chunk = 0; chunk < chunks; chunk++) {
+      tensorListMeta.block_to_tensor[loc_block_info] = loc_tensor_info - 1;
+      tensorListMeta.block_to_chunk[loc_block_info] = chunk;
+      loc_block_info++;
+
+      const bool tensors_full =
+          (loc_tensor_info == depth_to_max_tensors[depth - 1] &&
+           chunk == chunks - 1);
+      const bool blocks_full =
+          (loc_block_info == depth_to_max_blocks[depth - 1]);
+      const bool last_chunk = (t == n_tensors - 1 && chunk == chunks - 1);
+      if (tensors_full || blocks_full || last_chunk) {
+        multi_tensor_apply_kernel<<<loc_block_info, kMTABlockSize, 0, stream>>>(
+            tensorListMeta, callable, args...);
+        AT_CUDA_CHECK(cudaGetLastError());
+
+        // Reset the metadata.  If the current tensor still has chunks left,
+        // it carries over as the first tensor of the next launch.
+        loc_block_info = 0;
+        if (chunk == chunks - 1) {
+          loc_tensor_info = 0;
+        } else {
+          tensorListMeta.sizes[0] = tensorListMeta.sizes[loc_tensor_info - 1];
+          for (int d = 0; d < depth; d++) {
+            tensorListMeta.addresses[d][0] =
+                tensorListMeta.addresses[d][loc_tensor_info - 1];
+          }
+          loc_tensor_info = 1;
+        }
+      }
+    }
+  }
+}
+
+}} // namespace at::native
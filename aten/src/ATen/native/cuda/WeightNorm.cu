@@ -7,12 +7,17 @@
 #include <THC/THCDeviceUtils.cuh>
 #include <THC/THCTensorMathReduce.cuh>
 
+#include <algorithm>
+
 namespace at {
 namespace native {
 namespace {
 
 // Block size for weight_norm_*_first_dim_kernel.
-// Currently, kernels are non-persistent.
+// The first_dim kernels are persistent: the grid is capped at one resident
+// wave (see first_dim_kernel_blocks) and each block grid-strides over rows,
+// so many-short-row workloads pay one launch instead of a tail of blocks
+// whose setup cost rivals the reduction itself.
 // Dialing up the block size to, say 1024, can improve performance by
 // increase the amount of cache available per block, which can improve cache hit rate.
 // However, this is less efficient for short rows.  256 is pretty versatile.
@@ -86,48 +91,56 @@ __global__ void weight_norm_fwd_first_dim_kernel
    accscalar_t* __restrict__ norms,
    const scalar_t* __restrict__ v,
    const scalar_t* __restrict__ g,
-   const int rowSize)
+   const int rowSize,
+   const int numRows)
 {
   // We are norming each slowest-dim row of the tensor separately.
-  // For now, assign one block to each row.
+  // Each block grid-strides over rows; with a full launch (one block per
+  // row) the loop runs once and this degenerates to the non-persistent form.
   const int tid = threadIdx.x;
-  const int row = blockIdx.x;
   const int stride = blockDim.x;
 
-  // Logical index offset for this flattened row
-  const int rowStart = row*rowSize;
-
   // Hack to get around nvcc complaining when an smem array is declared with the same name
   // but different types in different kernels (in this case different instantiations)
   // extern __shared__ accscalar_t s[]; // error: declaration is incompatible with previous "s"
   extern __shared__ char buf[];
   accscalar_t* s = (accscalar_t*)buf;
 
-  accscalar_t thread_sum = 0.f;
-  for(int i = tid; i < rowSize; i += stride )
+  for(int row = blockIdx.x; row < numRows; row += gridDim.x)
   {
-    accscalar_t val_f = scalar_cast<accscalar_t>(v[i+rowStart]);
-    thread_sum += val_f*val_f; // AccumOp, could do Kahan here
-  }
+    // Logical index offset for this flattened row
+    const int rowStart = row*rowSize;
 
-  reduce_block_into_lanes(s, thread_sum, 1, ReduceAdd<accscalar_t>());
-  accscalar_t result = s[0];
+    accscalar_t thread_sum = 0.f;
+    for(int i = tid; i < rowSize; i += stride )
+    {
+      accscalar_t val_f = scalar_cast<accscalar_t>(v[i+rowStart]);
+      thread_sum += val_f*val_f; // AccumOp, could do Kahan here
+    }
 
-  result = sqrtf(result);
+    reduce_block_into_lanes(s, thread_sum, 1, ReduceAdd<accscalar_t>());
+    accscalar_t result = s[0];
 
-  if(tid == 0)
-    norms[row] = result;
+    result = sqrtf(result);
 
-  // Broadcast load, could use shared memory instead.
-  accscalar_t g_this_row = scalar_cast<accscalar_t>(g[row]);
+    if(tid == 0)
+      norms[row] = result;
 
-  accscalar_t rnorm = 1.f/result; // for consistency with backward kernel
+    // Broadcast load, could use shared memory instead.
+    accscalar_t g_this_row = scalar_cast<accscalar_t>(g[row]);
 
-  // Write data to output
-  for(int i = tid; i < rowSize; i += stride )
-  {
-    accscalar_t val_f = scalar_cast<accscalar_t>(v[i+rowStart]);
-    w[i+rowStart] = scalar_cast<scalar_t>(g_this_row*val_f*rnorm);
+    accscalar_t rnorm = 1.f/result; // for consistency with backward kernel
+
+    // Write data to output
+    for(int i = tid; i < rowSize; i += stride )
+    {
+      accscalar_t val_f = scalar_cast<accscalar_t>(v[i+rowStart]);
+      w[i+rowStart] = scalar_cast<scalar_t>(g_this_row*val_f*rnorm);
+    }
+
+    // The next row's reduction reuses s; every thread must have read this
+    // row's result before it is overwritten.
+    __syncthreads();
   }
 }
 
@@ -202,54 +215,61 @@ __global__ void weight_norm_bwd_first_dim_kernel
    const scalar_t* __restrict__ saved_v,
    const scalar_t* __restrict__ saved_g,
    const accscalar_t* __restrict__ saved_norms,
-   const int rowSize)
+   const int rowSize,
+   const int numRows)
 {
-  // For now, assign one block to each row.
+  // Persistent form, same as the forward kernel: blocks grid-stride over rows.
   const int tid = threadIdx.x;
-  const int row = blockIdx.x;
   const int stride = blockDim.x;
 
-  // Logical index offset for this flattened row
-  const int rowStart = row*rowSize;
-
   // Hack to get around nvcc complaining when an smem array is declared with the same name
   // but different types in different kernels (in this case different instantiations)
   // extern __shared__ accscalar_t s[]; // error: declaration is incompatible with previous "s"
   extern __shared__ char buf[];
   accscalar_t* s = (accscalar_t*)buf;
 
-  accscalar_t thread_sum = 0.f;
-  for(int i = tid; i < rowSize; i += stride )
+  for(int row = blockIdx.x; row < numRows; row += gridDim.x)
   {
-    accscalar_t grad_wi = scalar_cast<accscalar_t>(grad_w[i+rowStart]);
-    accscalar_t saved_vi = scalar_cast<accscalar_t>(saved_v[i+rowStart]);
-    thread_sum += grad_wi*saved_vi; // AccumOp, could do Kahan here
-  }
+    // Logical index offset for this flattened row
+    const int rowStart = row*rowSize;
 
-  reduce_block_into_lanes(s, thread_sum, 1, ReduceAdd<accscalar_t>());
-  accscalar_t result = s[0];
+    accscalar_t thread_sum = 0.f;
+    for(int i = tid; i < rowSize; i += stride )
+    {
+      accscalar_t grad_wi = scalar_cast<accscalar_t>(grad_w[i+rowStart]);
+      accscalar_t saved_vi = scalar_cast<accscalar_t>(saved_v[i+rowStart]);
+      thread_sum += grad_wi*saved_vi; // AccumOp, could do Kahan here
+    }
 
-  // Could choose to save reciprocal of norm instead I suppose, but norms is probably
-  // more handy to keep around.
-  // Broadcast load; could use shared memory instead.
-  accscalar_t rnorm = 1.f/saved_norms[row];
-  accscalar_t rnorm3 = rnorm*rnorm*rnorm;
+    reduce_block_into_lanes(s, thread_sum, 1, ReduceAdd<accscalar_t>());
+    accscalar_t result = s[0];
 
-  // Write g gradients.
-  if(tid == 0)
-    grad_g[row] = scalar_cast<scalar_t>(result*rnorm);
+    // Could choose to save reciprocal of norm instead I suppose, but norms is probably
+    // more handy to keep around.
+    // Broadcast load; could use shared memory instead.
+    accscalar_t rnorm = 1.f/saved_norms[row];
+    accscalar_t rnorm3 = rnorm*rnorm*rnorm;
 
-  // Broadcast load, could use shared memory instead.
-  accscalar_t g_this_row = scalar_cast<accscalar_t>(saved_g[row]);
+    // Write g gradients.
+    if(tid == 0)
+      grad_g[row] = scalar_cast<scalar_t>(result*rnorm);
 
-  // Write v gradients.  We are reusing values that were loaded earlier, so there
-  // is an optimization opportunity here (store values persistently).
-  for(int j = tid; j < rowSize; j += stride )
-  {
-    accscalar_t grad_wj = scalar_cast<accscalar_t>(grad_w[j+rowStart]);
-    accscalar_t saved_vj = scalar_cast<accscalar_t>(saved_v[j+rowStart]);
-    accscalar_t grad_vj = g_this_row*(rnorm*grad_wj - rnorm3*saved_vj*result);
-    grad_v[j+rowStart] = scalar_cast<scalar_t>(grad_vj);
+    // Broadcast load, could use shared memory instead.
+    accscalar_t g_this_row = scalar_cast<accscalar_t>(saved_g[row]);
+
+    // Write v gradients.  We are reusing values that were loaded earlier, so there
+    // is an optimization opportunity here (store values persistently).
+    for(int j = tid; j < rowSize; j += stride )
+    {
+      accscalar_t grad_wj = scalar_cast<accscalar_t>(grad_w[j+rowStart]);
+      accscalar_t saved_vj = scalar_cast<accscalar_t>(saved_v[j+rowStart]);
+      accscalar_t grad_vj = g_this_row*(rnorm*grad_wj - rnorm3*saved_vj*result);
+      grad_v[j+rowStart] = scalar_cast<scalar_t>(grad_vj);
+    }
+
+    // The next row's reduction reuses s; every thread must have read this
+    // row's result before it is overwritten.
+    __syncthreads();
   }
 }
 
@@ -314,6 +334,21 @@ __global__ void weight_norm_bwd_last_dim_kernel
     }
 }
 
+// Grid for the first_dim kernels: capped at one full resident wave so that
+// with many short rows (e.g. weight-norming the rows of an embedding or a
+// wide linear layer) the kernel runs persistently, grid-striding over rows,
+// instead of launching tens of thousands of blocks whose scheduling overhead
+// dominates a few-hundred-element reduction. For modest row counts this
+// returns numRows and the launch is identical to the old one-block-per-row
+// scheme.
+int first_dim_kernel_blocks(int numRows)
+{
+  const cudaDeviceProp* props = at::cuda::getCurrentDeviceProperties();
+  const int max_resident_blocks =
+    props->multiProcessorCount * (props->maxThreadsPerMultiProcessor / BLOCK);
+  return std::min(numRows, max_resident_blocks);
+}
+
 } // anonymous namespace
 
 std::tuple<Tensor,Tensor> weight_norm_cuda
@@ -354,7 +389,7 @@ std::tuple<Tensor,Tensor> weight_norm_cuda
          using accscalar_t = acc_type<scalar_t, true>;
 
          weight_norm_fwd_first_dim_kernel<scalar_t, accscalar_t>
-           <<<v.size(0),
+           <<<first_dim_kernel_blocks(v.size(0)),
               BLOCK,
               BLOCK*sizeof(accscalar_t),
               stream>>>
@@ -362,7 +397,8 @@ std::tuple<Tensor,Tensor> weight_norm_cuda
             norms.data_ptr<accscalar_t>(),
             v.data_ptr<scalar_t>(),
             g.data_ptr<scalar_t>(),
-            rowSize);
+            rowSize,
+            v.size(0));
        });
   }
   else if(dim == ndims - 1)
@@ -442,7 +478,7 @@ std::tuple<Tensor, Tensor> weight_norm_cuda_backward
          using accscalar_t = acc_type<scalar_t, true>;
 
          weight_norm_bwd_first_dim_kernel<scalar_t, accscalar_t>
-           <<<grad_w.size(0),
+           <<<first_dim_kernel_blocks(grad_w.size(0)),
               BLOCK,
               BLOCK*sizeof(accscalar_t),
               stream>>>
@@ -452,7 +488,8 @@ std::tuple<Tensor, Tensor> weight_norm_cuda_backward
             saved_v.data_ptr<scalar_t>(),
             saved_g.data_ptr<scalar_t>(),
             saved_norms.data_ptr<accscalar_t>(),
-            rowSize);
+            rowSize,
+            grad_w.size(0));
        });
   }
   else if(dim == ndims - 1)
@@ -96,6 +96,40 @@ __global__ void LayerNormForwardCUDAKernel(
   }
 }
 
+// Computes the dropout + residual-add result in one pass:
+//   X[i] = input[i] * mask[i] / keep_prob + residual[i]
+// A null mask means dropout is disabled (keep_prob == 1).
+template <typename T>
+__global__ void DropoutAddCUDAKernel(
+    int64_t size,
+    const T* input,
+    const T* residual,
+    const uint8_t* mask,
+    acc_type<T, true> pinv,
+    T* X) {
+  using T_ACC = acc_type<T, true>;
+  const int64_t index = blockIdx.x * blockDim.x + threadIdx.x;
+  for (int64_t i = index; i < size; i += blockDim.x * gridDim.x) {
+    const T_ACC keep =
+        mask == nullptr ? T_ACC(1) : static_cast<T_ACC>(mask[i]) * pinv;
+    X[i] = static_cast<T_ACC>(input[i]) * keep + static_cast<T_ACC>(residual[i]);
+  }
+}
+
+template <typename T>
+__global__ void MaskedScaleCUDAKernel(
+    int64_t size,
+    const T* dX,
+    const uint8_t* mask,
+    acc_type<T, true> pinv,
+    T* dinput) {
+  using T_ACC = acc_type<T, true>;
+  const int64_t index = blockIdx.x * blockDim.x + threadIdx.x;
+  for (int64_t i = index; i < size; i += blockDim.x * gridDim.x) {
+    dinput[i] = static_cast<T_ACC>(dX[i]) * static_cast<T_ACC>(mask[i]) * pinv;
+  }
+}
+
 template <typename T>
 __global__ void ComputeInternalGradientsCUDAKernel(
     int64_t N,
@@ -439,6 +473,166 @@ void LayerNormBackwardKernelImpl(
       });
 }
 
+template <typename T>
+void DropoutAddLayerNormKernelImplInternal(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& mask,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T eps,
+    double keep_prob,
+    Tensor* X,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  using T_ACC = acc_type<T, true>;
+  DCHECK_EQ(input.numel(), M * N);
+  DCHECK_EQ(residual.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* input_data = input.data_ptr<T>();
+  const T* residual_data = residual.data_ptr<T>();
+  const uint8_t* mask_data =
+      mask.defined() && mask.numel() > 0 ? mask.data_ptr<uint8_t>() : nullptr;
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* X_data = X->data_ptr<T>();
+  T* Y_data = Y->data_ptr<T>();
+  T* mean_data = mean->data_ptr<T>();
+  T* rstd_data = rstd->data_ptr<T>();
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t size = M * N;
+  const int64_t B = std::min<int64_t>(
+      (size + kCUDANumThreads - 1) / kCUDANumThreads, int64_t(4096));
+  DropoutAddCUDAKernel<T><<<B, kCUDANumThreads, 0, cuda_stream>>>(
+      size,
+      input_data,
+      residual_data,
+      mask_data,
+      static_cast<T_ACC>(1.0 / keep_prob),
+      X_data);
+  RowwiseMomentsCUDAKernel<T>
+      <<<M, kCUDABlockReduceNumThreads, 0, cuda_stream>>>(
+          N, eps, X_data, mean_data, rstd_data);
+  LayerNormForwardCUDAKernel<T><<<M, kCUDANumThreads, 0, cuda_stream>>>(
+      N, X_data, mean_data, rstd_data, gamma_data, beta_data, Y_data);
+  AT_CUDA_CHECK(cudaGetLastError());
+}
+
+void DropoutAddLayerNormKernelImpl(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& mask,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    double eps,
+    Tensor* X,
+    Tensor* Y,
+    Tensor* mean,
+    Tensor* rstd) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      input.scalar_type(), "DropoutAddLayerNormKernelImpl", [&]() {
+        DropoutAddLayerNormKernelImplInternal<scalar_t>(
+            input,
+            residual,
+            mask,
+            gamma,
+            beta,
+            M,
+            N,
+            static_cast<scalar_t>(eps),
+            keep_prob,
+            X,
+            Y,
+            mean,
+            rstd);
+      });
+}
+
+template <typename T>
+void DropoutAddLayerNormBackwardKernelImplInternal(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    Tensor* dinput,
+    Tensor* dresidual,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  using T_ACC = acc_type<T, true>;
+  // The residual branch sees the unmodified LayerNorm input gradient, so
+  // the existing backward kernels compute it (and dgamma/dbeta) directly.
+  LayerNormBackwardKernelImplInternal<T>(
+      dY, X, mean, rstd, gamma, M, N, dresidual, dgamma, dbeta);
+  if (!dinput->defined()) {
+    return;
+  }
+  // The dropout branch additionally applies the saved mask and rescale.
+  const uint8_t* mask_data =
+      mask.defined() && mask.numel() > 0 ? mask.data_ptr<uint8_t>() : nullptr;
+  if (mask_data == nullptr) {
+    dinput->copy_(*dresidual);
+    return;
+  }
+  const T* dX_data = dresidual->template data_ptr<T>();
+  T* dinput_data = dinput->template data_ptr<T>();
+  cudaStream_t cuda_stream = at::cuda::getCurrentCUDAStream();
+  const int64_t size = M * N;
+  const int64_t B = std::min<int64_t>(
+      (size + kCUDANumThreads - 1) / kCUDANumThreads, int64_t(4096));
+  MaskedScaleCUDAKernel<T><<<B, kCUDANumThreads, 0, cuda_stream>>>(
+      size,
+      dX_data,
+      mask_data,
+      static_cast<T_ACC>(1.0 / keep_prob),
+      dinput_data);
+  AT_CUDA_CHECK(cudaGetLastError());
+}
+
+void DropoutAddLayerNormBackwardKernelImpl(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    Tensor* dinput,
+    Tensor* dresidual,
+    Tensor* dgamma,
+    Tensor* dbeta) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(
+      X.scalar_type(), "DropoutAddLayerNormBackwardKernelImpl", [&]() {
+        DropoutAddLayerNormBackwardKernelImplInternal<scalar_t>(
+            dY,
+            X,
+            mask,
+            mean,
+            rstd,
+            gamma,
+            M,
+            N,
+            keep_prob,
+            dinput,
+            dresidual,
+            dgamma,
+            dbeta);
+      });
+}
+
 } // namespace
 
 std::tuple<Tensor, Tensor, Tensor> layer_norm_cuda(
@@ -486,8 +680,89 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cuda(
 }
 
 
+std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> dropout_add_layer_norm_cuda(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& gamma /* optional */,
+    const Tensor& beta /* optional */,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    double eps,
+    Generator* generator) {
+  Tensor X = at::native::empty_like(input, at::MemoryFormat::Contiguous);
+  Tensor Y = at::native::empty_like(input, at::MemoryFormat::Contiguous);
+  Tensor mean = at::empty({M}, input.options());
+  Tensor rstd = at::empty({M}, input.options());
+  // An empty mask means dropout is disabled (keep_prob == 1); kept defined
+  // so autograd can save it unconditionally.
+  Tensor mask = at::empty({0}, input.options().dtype(kByte));
+  if (keep_prob < 1.0) {
+    mask = at::empty(input.sizes(), input.options().dtype(kByte));
+    mask.bernoulli_(keep_prob, generator);
+  }
+  if (M > 0) {
+    DropoutAddLayerNormKernelImpl(
+        input, residual, mask, gamma, beta, M, N, keep_prob, eps, &X, &Y, &mean, &rstd);
+  }
+  return std::make_tuple(
+      std::move(Y),
+      std::move(X),
+      std::move(mask),
+      std::move(mean),
+      std::move(rstd));
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor>
+dropout_add_layer_norm_backward_cuda(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    std::array<bool, 4> grad_input_mask) {
+  Tensor dinput;
+  Tensor dresidual;
+  Tensor dgamma;
+  Tensor dbeta;
+  if (grad_input_mask[0]) {
+    dinput = at::native::empty_like(X, at::MemoryFormat::Contiguous);
+  }
+  // dresidual is the LayerNorm input gradient; it is also needed as an
+  // intermediate for dinput, so compute it whenever either is requested.
+  if (grad_input_mask[0] || grad_input_mask[1]) {
+    dresidual = at::native::empty_like(X, at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[2]) {
+    dgamma = M > 0 ? at::native::empty_like(gamma, at::MemoryFormat::Contiguous) : at::native::zeros_like(gamma, at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[3]) {
+    dbeta = M > 0 ? at::native::empty_like(gamma, at::MemoryFormat::Contiguous) : at::native::zeros_like(gamma, at::MemoryFormat::Contiguous);
+  }
+  if (M > 0) {
+    DropoutAddLayerNormBackwardKernelImpl(
+        dY, X, mask, mean, rstd, gamma, M, N, keep_prob, &dinput, &dresidual, &dgamma, &dbeta);
+  }
+  if (!grad_input_mask[1]) {
+    dresidual.reset();
+  }
+  return std::make_tuple(
+      std::move(dinput),
+      std::move(dresidual),
+      std::move(dgamma),
+      std::move(dbeta));
+}
+
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
+REGISTER_DISPATCH(DropoutAddLayerNormKernel, &DropoutAddLayerNormKernelImpl);
+REGISTER_DISPATCH(
+    DropoutAddLayerNormBackwardKernel,
+    &DropoutAddLayerNormBackwardKernelImpl);
 
 } // namespace native
 } // namespace at
@@ -3,6 +3,7 @@
 #include <ATen/Config.h>
 #include <ATen/cuda/CUDAConfig.h>
 #include <ATen/cuda/Exceptions.h>
+#include <ATen/native/cudnn/ConvBenchmarkCache.h>
 
 #if !AT_CUDNN_ENABLED()
 
@@ -71,12 +72,25 @@ std::tuple<at::Tensor,at::Tensor,at::Tensor> cudnn_convolution_transpose_backwar
   AT_ERROR("cudnn_convolution_transpose_backward: ATen not compiled with cuDNN support");
 }
 
+namespace detail {
+
+void cudnn_conv_benchmark_cache_save_impl(const std::string& filename) {
+  AT_ERROR("cudnn_conv_benchmark_cache_save: ATen not compiled with cuDNN support");
+}
+
+bool cudnn_conv_benchmark_cache_load_impl(const std::string& filename) {
+  AT_ERROR("cudnn_conv_benchmark_cache_load: ATen not compiled with cuDNN support");
+}
+
+} // namespace detail
+
 }}
 
 #else  // AT_CUDNN_ENABLED
 
 #include <THC/THC.h>
 
+#include <ATen/cuda/CUDAContext.h>
 #include <ATen/cudnn/cudnn-wrapper.h>
 #include <ATen/cudnn/Descriptors.h>
 #include <ATen/cudnn/Types.h>
@@ -85,6 +99,8 @@ std::tuple<at::Tensor,at::Tensor,at::Tensor> cudnn_convolution_transpose_backwar
 
 #include <ATen/TensorUtils.h>
 
+#include <cstring>
+#include <fstream>
 #include <functional>
 #include <iterator>
 #include <sstream>
@@ -367,6 +383,125 @@ BenchmarkCache<cudnnConvolutionFwdAlgoPerf_t> fwd_algos;
 BenchmarkCache<cudnnConvolutionBwdDataAlgoPerf_t> bwd_data_algos;
 BenchmarkCache<cudnnConvolutionBwdFilterAlgoPerf_t> bwd_filter_algos;
 
+// ---------------------------------------------------------------------
+//
+// Benchmark cache persistence
+//
+// ---------------------------------------------------------------------
+//
+// The benchmark caches above can be snapshotted to a file and merged back
+// into a later process, so a restarted job (e.g. after preemption) doesn't
+// redo the exhaustive cudnnFind* sweeps.  ConvolutionParams and the cuDNN
+// perf structs are PODs, so entries are written raw; the header records the
+// GPU model and cuDNN version they were measured with, and loading rejects
+// a file produced under a different configuration.
+
+constexpr uint64_t kBenchmarkCacheFileMagic = 0x436e764243616368ull; // "CnvBCach"
+constexpr uint32_t kBenchmarkCacheFileVersion = 1;
+
+// NB: Like ConvolutionParams, this must stay a POD (it is written and read
+// as raw bytes).
+struct BenchmarkCacheFileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t params_size;
+  uint64_t cudnn_version;
+  char gpu_name[256];  // same capacity as cudaDeviceProp::name
+};
+
+template <typename T>
+void writeCacheEntries(std::ostream& out, BenchmarkCache<T>& cache) {
+  std::lock_guard<std::mutex> guard(cache.mutex);
+  uint32_t result_size = sizeof(T);
+  uint64_t count = cache.map.size();
+  out.write(reinterpret_cast<const char*>(&result_size), sizeof(result_size));
+  out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const auto& entry : cache.map) {
+    out.write(reinterpret_cast<const char*>(&entry.first), sizeof(ConvolutionParams));
+    out.write(reinterpret_cast<const char*>(&entry.second), sizeof(T));
+  }
+}
+
+template <typename T>
+bool readCacheEntries(std::istream& in, BenchmarkCache<T>& cache) {
+  uint32_t result_size;
+  uint64_t count;
+  in.read(reinterpret_cast<char*>(&result_size), sizeof(result_size));
+  in.read(reinterpret_cast<char*>(&count), sizeof(count));
+  if (!in || result_size != sizeof(T)) {
+    return false;
+  }
+  for (uint64_t i = 0; i != count; ++i) {
+    ConvolutionParams params;
+    T result;
+    in.read(reinterpret_cast<char*>(&params), sizeof(params));
+    in.read(reinterpret_cast<char*>(&result), sizeof(result));
+    if (!in) {
+      return false;
+    }
+    cache.insert(params, result);
+  }
+  return true;
+}
+
+namespace detail {
+
+void cudnn_conv_benchmark_cache_save_impl(const std::string& filename) {
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  TORCH_CHECK(out, "Could not open ", filename, " for writing the cuDNN benchmark cache");
+
+  BenchmarkCacheFileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kBenchmarkCacheFileMagic;
+  header.version = kBenchmarkCacheFileVersion;
+  header.params_size = sizeof(ConvolutionParams);
+  header.cudnn_version = cudnnGetVersion();
+  cudaDeviceProp* prop = at::cuda::getCurrentDeviceProperties();
+  strncpy(header.gpu_name, prop->name, sizeof(header.gpu_name) - 1);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  writeCacheEntries(out, fwd_algos);
+  writeCacheEntries(out, bwd_data_algos);
+  writeCacheEntries(out, bwd_filter_algos);
+  TORCH_CHECK(out.good(), "Failed to write the cuDNN benchmark cache to ", filename);
+}
+
+bool cudnn_conv_benchmark_cache_load_impl(const std::string& filename) {
+  std::ifstream in(filename, std::ios::binary);
+  TORCH_CHECK(in, "Could not open the cuDNN benchmark cache file ", filename);
+
+  BenchmarkCacheFileHeader header;
+  memset(&header, 0, sizeof(header));
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!in || header.magic != kBenchmarkCacheFileMagic ||
+      header.version != kBenchmarkCacheFileVersion ||
+      header.params_size != sizeof(ConvolutionParams)) {
+    TORCH_WARN(
+        "Ignoring ", filename,
+        ": not a cuDNN benchmark cache file, or written by an incompatible "
+        "PyTorch version");
+    return false;
+  }
+  cudaDeviceProp* prop = at::cuda::getCurrentDeviceProperties();
+  if (header.cudnn_version != cudnnGetVersion() ||
+      strncmp(header.gpu_name, prop->name, sizeof(header.gpu_name)) != 0) {
+    TORCH_WARN(
+        "Ignoring ", filename, ": it was written for GPU \"", header.gpu_name,
+        "\" with cuDNN ", header.cudnn_version, ", but the current device is \"",
+        prop->name, "\" with cuDNN ", cudnnGetVersion());
+    return false;
+  }
+  if (!readCacheEntries(in, fwd_algos) ||
+      !readCacheEntries(in, bwd_data_algos) ||
+      !readCacheEntries(in, bwd_filter_algos)) {
+    TORCH_WARN("Ignoring (the rest of) ", filename, ": file is truncated or corrupt");
+    return false;
+  }
+  return true;
+}
+
+} // namespace detail
+
 // TODO: Stop manually allocating CUDA memory; allocate an ATen byte
 // tensor instead.
 struct Workspace {
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+namespace at { namespace native { namespace detail {
+
+// Persistence for the cuDNN convolution benchmark caches (see
+// native/cudnn/Conv.cpp).  Saving writes a snapshot of all three caches
+// (forward, backward-data, backward-filter) to `filename`, tagged with the
+// GPU model and cuDNN version that produced it; loading merges a snapshot
+// back into the in-memory caches, so a restarted job skips the exhaustive
+// cudnnFind* sweep for every convolution it has already benchmarked.
+// Loading returns false (with a warning) if the file was written on a
+// different GPU model, with a different cuDNN version, or by an
+// incompatible PyTorch version.  These are the raw implementations; CPU
+// code should go through CUDAHooksInterface instead.
+
+void cudnn_conv_benchmark_cache_save_impl(const std::string& filename);
+bool cudnn_conv_benchmark_cache_load_impl(const std::string& filename);
+
+}}} // namespace at::native::detail
@@ -60,13 +60,14 @@ std::tuple<Tensor, Tensor, Tensor> layer_norm_backward_cpu(
   return std::make_tuple(std::move(dX), std::move(dgamma), std::move(dbeta));
 }
 
-Tensor layer_norm(
+// Shape-checks input against normalized_shape and the optional affine
+// parameters, and returns the (M, N) factorization of the input used by the
+// native kernels. Shared by layer_norm and dropout_add_layer_norm.
+static std::pair<int64_t, int64_t> check_layer_norm_inputs(
     const Tensor& input,
     IntArrayRef normalized_shape,
     const Tensor& weight /* optional */,
-    const Tensor& bias /* optional */,
-    double eps,
-    bool /* cudnn_enable, deprecated */) {
+    const Tensor& bias /* optional */) {
   const int normalized_ndim = normalized_shape.size();
   TORCH_CHECK(
       normalized_ndim >= 1,
@@ -116,14 +117,173 @@ Tensor layer_norm(
       1LL,
       std::multiplies<int64_t>());
 
+  return std::make_pair(M, N);
+}
+
+Tensor layer_norm(
+    const Tensor& input,
+    IntArrayRef normalized_shape,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double eps,
+    bool /* cudnn_enable, deprecated */) {
+  int64_t M;
+  int64_t N;
+  std::tie(M, N) =
+      check_layer_norm_inputs(input, normalized_shape, weight, bias);
+
   const auto& X = input.is_contiguous() ? input : input.contiguous();
   const auto& gamma = weight.is_contiguous() ? weight : weight.contiguous();
   const auto& beta = bias.is_contiguous() ? bias : bias.contiguous();
   return std::get<0>(at::native_layer_norm(X, gamma, beta, M, N, eps));
 }
 
+std::tuple<Tensor, Tensor, Tensor, Tensor, Tensor> dropout_add_layer_norm_cpu(
+    const Tensor& input,
+    const Tensor& residual,
+    const Tensor& gamma /* optional */,
+    const Tensor& beta /* optional */,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    double eps,
+    Generator* generator) {
+  Tensor X = at::native::empty_like(input, at::MemoryFormat::Contiguous);
+  Tensor Y = at::native::empty_like(input, at::MemoryFormat::Contiguous);
+  Tensor mean = at::empty({M}, input.options());
+  Tensor rstd = at::empty({M}, input.options());
+  // An empty mask means dropout is disabled (keep_prob == 1); kept defined
+  // so autograd can save it unconditionally.
+  Tensor mask = at::empty({0}, input.options().dtype(kByte));
+  if (keep_prob < 1.0) {
+    mask = at::empty(input.sizes(), input.options().dtype(kByte));
+    mask.bernoulli_(keep_prob, generator);
+  }
+  if (M > 0) {
+    DropoutAddLayerNormKernel(
+        kCPU,
+        input,
+        residual,
+        mask,
+        gamma,
+        beta,
+        M,
+        N,
+        keep_prob,
+        eps,
+        &X,
+        &Y,
+        &mean,
+        &rstd);
+  }
+  return std::make_tuple(
+      std::move(Y),
+      std::move(X),
+      std::move(mask),
+      std::move(mean),
+      std::move(rstd));
+}
+
+std::tuple<Tensor, Tensor, Tensor, Tensor>
+dropout_add_layer_norm_backward_cpu(
+    const Tensor& dY,
+    const Tensor& X,
+    const Tensor& mask,
+    const Tensor& mean,
+    const Tensor& rstd,
+    const Tensor& gamma,
+    int64_t M,
+    int64_t N,
+    double keep_prob,
+    std::array<bool, 4> grad_input_mask) {
+  Tensor dinput;
+  Tensor dresidual;
+  Tensor dgamma;
+  Tensor dbeta;
+  if (grad_input_mask[0]) {
+    dinput = at::native::empty_like(X, at::MemoryFormat::Contiguous);
+  }
+  // dresidual is the LayerNorm input gradient; it is also needed as an
+  // intermediate for dinput, so compute it whenever either is requested.
+  if (grad_input_mask[0] || grad_input_mask[1]) {
+    dresidual = at::native::empty_like(X, at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[2]) {
+    dgamma = M > 0 ? at::native::empty_like(gamma, at::MemoryFormat::Contiguous) : at::native::zeros_like(gamma, at::MemoryFormat::Contiguous);
+  }
+  if (grad_input_mask[3]) {
+    dbeta = M > 0 ? at::native::empty_like(gamma, at::MemoryFormat::Contiguous) : at::native::zeros_like(gamma, at::MemoryFormat::Contiguous);
+  }
+  if (M > 0) {
+    DropoutAddLayerNormBackwardKernel(
+        kCPU,
+        dY,
+        X,
+        mask,
+        mean,
+        rstd,
+        gamma,
+        M,
+        N,
+        keep_prob,
+        &dinput,
+        &dresidual,
+        &dgamma,
+        &dbeta);
+  }
+  if (!grad_input_mask[1]) {
+    dresidual.reset();
+  }
+  return std::make_tuple(
+      std::move(dinput),
+      std::move(dresidual),
+      std::move(dgamma),
+      std::move(dbeta));
+}
+
+// Fused dropout + residual add + LayerNorm, the epilogue of every
+// transformer sublayer. Running the three ops separately materializes two
+// full intermediate tensors; the fused kernels produce the dropout-add
+// result and the normalized output in a single pass over the data.
+Tensor dropout_add_layer_norm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double p,
+    bool train,
+    double eps,
+    Generator* generator) {
+  TORCH_CHECK(
+      p >= 0 && p <= 1,
+      "dropout probability has to be between 0 and 1, but got ",
+      p);
+  TORCH_CHECK(
+      input.sizes().equals(residual.sizes()),
+      "Expected input and residual to have the same shape, but got input of ",
+      "shape ",
+      input.sizes(),
+      " and residual of shape ",
+      residual.sizes());
+  int64_t M;
+  int64_t N;
+  std::tie(M, N) =
+      check_layer_norm_inputs(input, normalized_shape, weight, bias);
+
+  const double keep_prob = train ? 1.0 - p : 1.0;
+  const auto& X = input.is_contiguous() ? input : input.contiguous();
+  const auto& R = residual.is_contiguous() ? residual : residual.contiguous();
+  const auto& gamma = weight.is_contiguous() ? weight : weight.contiguous();
+  const auto& beta = bias.is_contiguous() ? bias : bias.contiguous();
+  return std::get<0>(at::_dropout_add_layer_norm(
+      X, R, gamma, beta, M, N, keep_prob, eps, generator));
+}
+
 DEFINE_DISPATCH(LayerNormKernel);
 DEFINE_DISPATCH(LayerNormBackwardKernel);
+DEFINE_DISPATCH(DropoutAddLayerNormKernel);
+DEFINE_DISPATCH(DropoutAddLayerNormBackwardKernel);
 
 } // namespace native
 } // namespace at
@@ -29,8 +29,40 @@ using backward_fn = void (*)(
     Tensor* /* dgamma */,
     Tensor* /* dbeta */);
 
+using dropout_add_forward_fn = void (*)(
+    const Tensor& /* input */,
+    const Tensor& /* residual */,
+    const Tensor& /* mask (Byte, undefined if keep_prob == 1) */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* keep_prob */,
+    double /* eps */,
+    Tensor* /* X (dropout(input) + residual, saved for backward) */,
+    Tensor* /* Y */,
+    Tensor* /* mean */,
+    Tensor* /* rstd */);
+
+using dropout_add_backward_fn = void (*)(
+    const Tensor& /* dY */,
+    const Tensor& /* X */,
+    const Tensor& /* mask */,
+    const Tensor& /* mean */,
+    const Tensor& /* rstd */,
+    const Tensor& /* gamma */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* keep_prob */,
+    Tensor* /* dinput */,
+    Tensor* /* dresidual */,
+    Tensor* /* dgamma */,
+    Tensor* /* dbeta */);
+
 DECLARE_DISPATCH(forward_fn, LayerNormKernel);
 DECLARE_DISPATCH(backward_fn, LayerNormBackwardKernel);
+DECLARE_DISPATCH(dropout_add_forward_fn, DropoutAddLayerNormKernel);
+DECLARE_DISPATCH(dropout_add_backward_fn, DropoutAddLayerNormBackwardKernel);
 
 } // namespace native
 } // namespace at
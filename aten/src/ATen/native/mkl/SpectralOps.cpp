@@ -27,9 +27,13 @@ Tensor _fft_mkl(const Tensor& input, int64_t signal_ndim,
 #include <ATen/Utils.h>
 
 #include <algorithm>
-#include <vector>
-#include <numeric>
 #include <cmath>
+#include <list>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <mkl_dfti.h>
 #include <ATen/mkl/Exceptions.h>
@@ -145,6 +149,43 @@ static inline void _fft_fill_with_conjugate_symmetry_(Tensor& input,
 }
 
 // MKL DFTI
+// LRU cache of committed DFTI descriptors, keyed by everything that
+// parametrizes a plan (precision, domain, signal sizes, batch, distances,
+// strides, scaling). Building and committing a descriptor costs more than
+// the transform itself for the small repeated FFTs of e.g. STFT pipelines.
+// The cache is per-thread so concurrent pipelines neither serialize on a
+// lock nor share a handle; capacity is small and lookup is a linear scan.
+namespace {
+
+constexpr size_t kDftiPlanCacheCapacity = 64;
+
+struct DftiPlanCache {
+  // Most recently used first.
+  std::list<std::pair<std::string, DftiDescriptor>> plans;
+
+  DFTI_DESCRIPTOR* lookup(const std::string& key) {
+    for (auto it = plans.begin(); it != plans.end(); ++it) {
+      if (it->first == key) {
+        plans.splice(plans.begin(), plans, it);
+        return it->second.get();
+      }
+    }
+    return nullptr;
+  }
+
+  DFTI_DESCRIPTOR* insert(const std::string& key, DftiDescriptor descriptor) {
+    if (plans.size() >= kDftiPlanCacheCapacity) {
+      plans.pop_back();
+    }
+    plans.emplace_front(key, std::move(descriptor));
+    return plans.front().second.get();
+  }
+};
+
+thread_local DftiPlanCache dfti_plan_cache;
+
+} // namespace
+
 Tensor _fft_mkl(const Tensor& self, int64_t signal_ndim,
                 bool complex_input, bool complex_output,
                 bool inverse, IntArrayRef checked_signal_sizes,
@@ -213,22 +254,14 @@ Tensor _fft_mkl(const Tensor& self, int64_t signal_ndim,
   } else {
     signal_type = complex_output ? DFTI_COMPLEX : DFTI_REAL;
   }
-  // create descriptor with signal size
+  // signal sizes
   std::vector<MKL_LONG> mkl_signal_sizes(checked_signal_sizes.begin(), checked_signal_sizes.end());
-  DftiDescriptor descriptor;
-  descriptor.init(prec, signal_type, signal_ndim, mkl_signal_sizes.data());
-  // out of place FFT
-  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_PLACEMENT, DFTI_NOT_INPLACE));
-  // batch mode
-  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_NUMBER_OF_TRANSFORMS, batch));
 
   auto istrides = input.strides();
   auto ostrides = output.strides();
   // batch dim stride, i.e., dist between each data
   MKL_LONG idist = complex_input ? istrides[0] >> 1 : istrides[0];
   MKL_LONG odist = complex_output ? ostrides[0] >> 1 : ostrides[0];
-  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_INPUT_DISTANCE, idist));
-  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_OUTPUT_DISTANCE, odist));
   // signal strides
   // first val is offset, set to zero (ignored)
   std::vector<MKL_LONG> mkl_istrides(1 + signal_ndim, 0), mkl_ostrides(1 + signal_ndim, 0);
@@ -236,33 +269,60 @@ Tensor _fft_mkl(const Tensor& self, int64_t signal_ndim,
     mkl_istrides[i] = complex_input ? istrides[i] >> 1 : istrides[i];
     mkl_ostrides[i] = complex_output ? ostrides[i] >> 1 : ostrides[i];
   }
-  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_INPUT_STRIDES, mkl_istrides.data()));
-  MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_OUTPUT_STRIDES, mkl_ostrides.data()));
-  // if conjugate domain of real is involved, set standard CCE storage type
-  // this will become default in MKL in future
-  if (!complex_input || !complex_output) {
-    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX));
+
+  // Everything the committed descriptor depends on goes into the cache key.
+  std::ostringstream key_ss;
+  key_ss << prec << ";" << signal_type << ";" << signal_ndim << ";" << batch
+         << ";" << idist << ";" << odist << ";" << complex_input << complex_output
+         << normalized << inverse;
+  for (int64_t i = 0; i < signal_ndim; i++) {
+    key_ss << ";" << mkl_signal_sizes[i];
   }
-  // rescale if needed by normalized flag or inverse transform
-  if (normalized || inverse) {
-    auto signal_numel = at::prod_intlist(checked_signal_sizes);
-    double double_scale;
-    if (normalized) {
-      double_scale = 1.0 / std::sqrt(static_cast<double>(signal_numel));
-    } else {
-      double_scale = 1.0 / static_cast<double>(signal_numel);
+  for (int64_t i = 1; i <= signal_ndim; i++) {
+    key_ss << ";" << mkl_istrides[i] << "," << mkl_ostrides[i];
+  }
+  const std::string plan_key = key_ss.str();
+
+  DFTI_DESCRIPTOR* raw_descriptor = dfti_plan_cache.lookup(plan_key);
+  if (raw_descriptor == nullptr) {
+    // create descriptor with signal size
+    DftiDescriptor descriptor;
+    descriptor.init(prec, signal_type, signal_ndim, mkl_signal_sizes.data());
+    // out of place FFT
+    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_PLACEMENT, DFTI_NOT_INPLACE));
+    // batch mode
+    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_NUMBER_OF_TRANSFORMS, batch));
+    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_INPUT_DISTANCE, idist));
+    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_OUTPUT_DISTANCE, odist));
+    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_INPUT_STRIDES, mkl_istrides.data()));
+    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_OUTPUT_STRIDES, mkl_ostrides.data()));
+    // if conjugate domain of real is involved, set standard CCE storage type
+    // this will become default in MKL in future
+    if (!complex_input || !complex_output) {
+      MKL_DFTI_CHECK(DftiSetValue(descriptor.get(), DFTI_CONJUGATE_EVEN_STORAGE, DFTI_COMPLEX_COMPLEX));
+    }
+    // rescale if needed by normalized flag or inverse transform
+    if (normalized || inverse) {
+      auto signal_numel = at::prod_intlist(checked_signal_sizes);
+      double double_scale;
+      if (normalized) {
+        double_scale = 1.0 / std::sqrt(static_cast<double>(signal_numel));
+      } else {
+        double_scale = 1.0 / static_cast<double>(signal_numel);
+      }
+      MKL_DFTI_CHECK(DftiSetValue(descriptor.get(),
+        inverse ? DFTI_BACKWARD_SCALE : DFTI_FORWARD_SCALE,
+        prec == DFTI_DOUBLE ? double_scale : static_cast<float>(double_scale)));
     }
-    MKL_DFTI_CHECK(DftiSetValue(descriptor.get(),
-      inverse ? DFTI_BACKWARD_SCALE : DFTI_FORWARD_SCALE,
-      prec == DFTI_DOUBLE ? double_scale : static_cast<float>(double_scale)));
+    // finalize
+    MKL_DFTI_CHECK(DftiCommitDescriptor(descriptor.get()));
+    raw_descriptor = dfti_plan_cache.insert(plan_key, std::move(descriptor));
   }
-  // finalize
-  MKL_DFTI_CHECK(DftiCommitDescriptor(descriptor.get()));
   // run
   if (!inverse) {
-    MKL_DFTI_CHECK(DftiComputeForward(descriptor.get(), input.data_ptr(), output.data_ptr()));
+    MKL_DFTI_CHECK(DftiComputeForward(raw_descriptor, input.data_ptr(), output.data_ptr()));
   } else {
-    MKL_DFTI_CHECK(DftiComputeBackward(descriptor.get(), input.data_ptr(), output.data_ptr()));
+    MKL_DFTI_CHECK(DftiComputeBackward(raw_descriptor, input.data_ptr(), output.data_ptr()));
   }
   // now if needed, fill out the other half using Hermitian symmetry dim
   if (!complex_input && complex_output && !onesided) {
@@ -36,8 +36,11 @@ std::tuple<at::Tensor,at::Tensor,at::Tensor> mkldnn_convolution_backward(
 
 #include <ATen/mkldnn/Runtime.h>
 #include <ATen/native/mkldnn/MKLDNNCommon.h>
+#include <ATen/native/mkldnn/PrimitiveCache.h>
 #include <ATen/native/mkldnn/Utils.h>
 
+#include <sstream>
+
 using namespace mkldnn;
 
 namespace {
@@ -53,6 +56,55 @@ inline ideep::tensor get_mkldnn_tensor(const at::Tensor& tensor) {
     return at::native::itensor_view_from_dense(tensor);
   }
 }
+
+inline std::string conv_weight_cache_key(
+    const at::Tensor& weight,
+    at::IntArrayRef padding,
+    at::IntArrayRef stride,
+    at::IntArrayRef dilation,
+    int64_t groups) {
+  std::ostringstream ss;
+  ss << weight.unsafeGetTensorImpl() << ";" << weight.sizes() << ";"
+     << weight.strides() << ";" << weight.scalar_type() << ";" << stride
+     << ";" << padding << ";" << dilation << ";" << groups;
+  return ss.str();
+}
+
+// Dense weights get reordered into the blocked format mkldnn expects on
+// every single call (see the note in mkldnn_reorder_conv2d_weight); for
+// small batches that reorder dominates the conv itself. Prepack once and
+// keep the result in the shape-keyed LRU cache; in-place weight updates
+// invalidate the entry through its version counter.
+ideep::tensor get_prepacked_conv_weight(
+    const at::Tensor& weight,
+    at::IntArrayRef padding,
+    at::IntArrayRef stride,
+    at::IntArrayRef dilation,
+    int64_t groups) {
+  auto& cache = at::native::mkldnn_conv_weight_cache();
+  const std::string key =
+      conv_weight_cache_key(weight, padding, stride, dilation, groups);
+  ideep::tensor packed;
+  if (cache.lookup(key, weight, &packed)) {
+    return packed;
+  }
+  ideep::tensor w = at::native::itensor_view_from_dense(weight).as_weights();
+  w.make_group(groups);
+  ideep::tensor::descriptor desc =
+      ideep::convolution_forward::expected_weights_descriptor(
+          w.get_dims(),
+          w.get_data_type(),
+          {stride.begin(), stride.end()},
+          {padding.begin(), padding.end()},
+          {padding.begin(), padding.end()},
+          {dilation.begin(), dilation.end()},
+          groups,
+          ideep::algorithm::convolution_direct);
+  packed.init<at::native::AllocForMKLDNN>(desc);
+  packed.feed_from(w);
+  cache.insert(key, weight, packed);
+  return packed;
+}
 }
 
 namespace at { namespace native {
@@ -127,7 +179,9 @@ at::Tensor mkldnn_convolution(
     IntArrayRef dilation,
     int64_t groups) {
   const ideep::tensor mkldnn_input = get_mkldnn_tensor(input);
-  const ideep::tensor mkldnn_weight = get_mkldnn_tensor(weight);
+  const ideep::tensor mkldnn_weight = weight.is_mkldnn()
+      ? itensor_from_mkldnn(weight)
+      : get_prepacked_conv_weight(weight, padding, stride, dilation, groups);
   c10::optional<ideep::tensor> mkldnn_bias{c10::nullopt};
   if (bias.defined()) {
     mkldnn_bias = get_mkldnn_tensor(bias);
@@ -20,10 +20,43 @@ Tensor mkldnn_linear(
 #else // AT_MKLDNN_EBABLED
 
 #include <ATen/native/mkldnn/MKLDNNCommon.h>
+#include <ATen/native/mkldnn/PrimitiveCache.h>
+
+#include <sstream>
 
 namespace at {
 namespace native {
 
+namespace {
+
+// Weights in the public format are reordered to the blocked inner_product
+// format on every call; prepack once and reuse through the LRU cache.
+ideep::tensor get_prepacked_linear_weight(const Tensor& weight) {
+  const ideep::tensor& w = itensor_from_mkldnn(weight);
+  ideep::tensor::descriptor desc =
+      ideep::inner_product_forward::expected_weights_descriptor(
+          w.get_dims(), w.get_data_type());
+  if (w.get_descriptor() == desc) {
+    // Already prepacked (e.g. by to_mkldnn on the module).
+    return w;
+  }
+  auto& cache = mkldnn_linear_weight_cache();
+  std::ostringstream ss;
+  ss << weight.unsafeGetTensorImpl() << ";" << weight.sizes() << ";"
+     << weight.scalar_type();
+  const std::string key = ss.str();
+  ideep::tensor packed;
+  if (cache.lookup(key, weight, &packed)) {
+    return packed;
+  }
+  packed.init<AllocForMKLDNN>(desc);
+  packed.feed_from(w);
+  cache.insert(key, weight, packed);
+  return packed;
+}
+
+} // namespace
+
 Tensor mkldnn_linear(
     const Tensor& self,
     const Tensor& weight,
@@ -38,7 +71,7 @@ Tensor mkldnn_linear(
   // reshape first if input dim is greater than 2 and the reshape will cost a memory copy.
   auto self_reshaped = self.dim() > 2 ? self.reshape({-1, self.size(self.dim() - 1)}) : self;
   const ideep::tensor x = itensor_from_mkldnn(self_reshaped);
-  const ideep::tensor w = itensor_from_mkldnn(weight);
+  const ideep::tensor w = get_prepacked_linear_weight(weight);
 
   ideep::tensor y;
   if (bias.defined()) {
@@ -0,0 +1,115 @@
+#include <ATen/native/mkldnn/PrimitiveCache.h>
+
+#if AT_MKLDNN_ENABLED()
+
+namespace at { namespace native {
+
+bool MkldnnPrimitiveCache::lookup(
+    const std::string& key,
+    const Tensor& source,
+    ideep::tensor* packed) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  Entry& entry = it->second;
+  auto locked = entry.source.lock();
+  if (!locked.defined() || locked.get() != source.unsafeGetTensorImpl() ||
+      entry.version !=
+          source.unsafeGetTensorImpl()->version_counter().current_version()) {
+    // The source tensor died or was updated in place; the prepacked copy
+    // is stale.
+    lru_.erase(entry.lru_it);
+    pinned_.erase(key);
+    entries_.erase(it);
+    return false;
+  }
+  lru_.splice(lru_.begin(), lru_, entry.lru_it);
+  *packed = entry.packed;
+  return true;
+}
+
+void MkldnnPrimitiveCache::insert(
+    const std::string& key,
+    const Tensor& source,
+    const ideep::tensor& packed) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.erase(it->second.lru_it);
+    entries_.erase(it);
+  }
+  evict_if_needed();
+  lru_.push_front(key);
+  entries_.emplace(
+      key,
+      Entry(
+          weak_tensor_impl(source.getIntrusivePtr()),
+          source.unsafeGetTensorImpl()->version_counter().current_version(),
+          packed,
+          lru_.begin()));
+}
+
+void MkldnnPrimitiveCache::pin(const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (entries_.count(key) != 0) {
+    pinned_.insert(key);
+  }
+}
+
+void MkldnnPrimitiveCache::unpin(const std::string& key) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  pinned_.erase(key);
+}
+
+void MkldnnPrimitiveCache::flush() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    if (pinned_.count(*it) != 0) {
+      ++it;
+      continue;
+    }
+    entries_.erase(*it);
+    it = lru_.erase(it);
+  }
+}
+
+void MkldnnPrimitiveCache::set_capacity(size_t capacity) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  capacity_ = capacity;
+  evict_if_needed();
+}
+
+size_t MkldnnPrimitiveCache::size() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return entries_.size();
+}
+
+void MkldnnPrimitiveCache::evict_if_needed() {
+  // Walk from the least recently used end, skipping pinned entries. If
+  // everything left is pinned the cache is allowed to exceed capacity.
+  auto it = lru_.end();
+  while (entries_.size() >= capacity_ && it != lru_.begin()) {
+    --it;
+    if (pinned_.count(*it) != 0) {
+      continue;
+    }
+    entries_.erase(*it);
+    it = lru_.erase(it);
+  }
+}
+
+MkldnnPrimitiveCache& mkldnn_conv_weight_cache() {
+  static MkldnnPrimitiveCache cache;
+  return cache;
+}
+
+MkldnnPrimitiveCache& mkldnn_linear_weight_cache() {
+  static MkldnnPrimitiveCache cache;
+  return cache;
+}
+
+}} // namespace at::native
+
+#endif // AT_MKLDNN_ENABLED
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Config.h>
+
+#if AT_MKLDNN_ENABLED()
+#include <ATen/native/mkldnn/MKLDNNCommon.h>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace at { namespace native {
+
+// Shape-keyed LRU cache for prepacked mkldnn state (currently reordered
+// weights). Keys encode the full shape/stride/dtype/attribute tuple of a
+// computation; each entry additionally remembers which source tensor it was
+// packed from (as a weak reference plus its version counter), so in-place
+// updates or a freed weight invalidate the entry instead of returning stale
+// data. Entries can be pinned to exempt them from LRU eviction, and the
+// cache can be flushed to release the prepacked buffers.
+class MkldnnPrimitiveCache {
+ public:
+  explicit MkldnnPrimitiveCache(size_t capacity = 64) : capacity_(capacity) {}
+
+  // Returns true and writes the prepacked tensor if a valid entry exists.
+  // Stale entries (source dead or modified in place) are dropped.
+  bool lookup(const std::string& key, const Tensor& source, ideep::tensor* packed);
+
+  void insert(const std::string& key, const Tensor& source, const ideep::tensor& packed);
+
+  // Pinned entries are never evicted by the LRU policy (flush still
+  // removes them only via unpin + flush).
+  void pin(const std::string& key);
+  void unpin(const std::string& key);
+
+  // Drops every unpinned entry.
+  void flush();
+
+  void set_capacity(size_t capacity);
+  size_t size() const;
+
+ private:
+  using weak_tensor_impl =
+      c10::weak_intrusive_ptr<c10::TensorImpl, c10::UndefinedTensorImpl>;
+
+  struct Entry {
+    Entry(
+        weak_tensor_impl source_,
+        uint32_t version_,
+        const ideep::tensor& packed_,
+        std::list<std::string>::iterator lru_it_)
+        : source(std::move(source_)),
+          version(version_),
+          packed(packed_),
+          lru_it(lru_it_) {}
+
+    weak_tensor_impl source;
+    uint32_t version;
+    ideep::tensor packed;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  // Must be called with the mutex held.
+  void evict_if_needed();
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  std::list<std::string> lru_; // most recently used first
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_set<std::string> pinned_;
+};
+
+// Process-wide caches for the conv and linear prepacked weights.
+CAFFE2_API MkldnnPrimitiveCache& mkldnn_conv_weight_cache();
+CAFFE2_API MkldnnPrimitiveCache& mkldnn_linear_weight_cache();
+
+}} // namespace at::native
+
+#endif // AT_MKLDNN_ENABLED
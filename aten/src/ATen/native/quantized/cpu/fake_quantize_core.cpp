@@ -2,6 +2,7 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
 #include <c10/util/math_compat.h>
 
 /* Core operations for fake-quantization shared between per tensor
@@ -9,6 +10,9 @@
 namespace at {
 namespace native {
 
+DEFINE_DISPATCH(fake_quant_slice_stub);
+DEFINE_DISPATCH(fake_quant_grad_slice_stub);
+
 /* Fake quantize a tensor, common block for per-channel & per-tensor fake quant
 Args:
   output: output tensor.
@@ -19,6 +23,10 @@ Args:
   quant_max: maximum quantized value
 Returns:
   Fake quantized tensor (double dtype).
+
+The heavy lifting lives in the vectorized kernels behind the stubs; these
+wrappers keep the original entry points used by the per-tensor op and by
+each channel slice of the per-channel op.
 */
 void fake_quantize_slice(
     Tensor& output,
@@ -27,18 +35,8 @@ void fake_quantize_slice(
     int64_t z_point,
     int64_t quant_min,
     int64_t quant_max) {
-  float inv_scale = 1.0f / sc;
-  auto iter = TensorIterator::unary_op(output, input);
-  cpu_kernel(iter, [&](float self) -> float {
-    return (std::fmin(
-                std::fmax(
-                    static_cast<int64_t>(
-                        std::nearbyint(self * inv_scale + z_point)),
-                    quant_min),
-                quant_max) -
-            z_point) *
-        sc;
-  });
+  fake_quant_slice_stub(
+      input.device().type(), output, input, sc, z_point, quant_min, quant_max);
 }
 
 void fake_quantize_grad_slice(
@@ -49,12 +47,15 @@ void fake_quantize_grad_slice(
     int64_t z_point,
     int64_t quant_min,
     int64_t quant_max) {
-  float inv_scale = 1.0f / sc;
-  auto iter = TensorIterator::binary_op(input_grad, input, output_grad);
-  cpu_kernel(iter, [&](float x, float dy) -> float {
-    int64_t xq = static_cast<int64_t>(std::nearbyint(x * inv_scale + z_point));
-    return dy * (xq >= quant_min && xq <= quant_max);
-  });
+  fake_quant_grad_slice_stub(
+      input.device().type(),
+      input_grad,
+      input,
+      output_grad,
+      sc,
+      z_point,
+      quant_min,
+      quant_max);
 }
 
 } // namespace native
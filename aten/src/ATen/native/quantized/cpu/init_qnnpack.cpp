@@ -3,8 +3,13 @@
 #include "init_qnnpack.h"
 #include <ATen/ATen.h>
 #include <ATen/Config.h>
+#include <ATen/Parallel.h>
+#include <caffe2/utils/threadpool/ThreadPool.h>
+#include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 #include <pytorch_qnnpack.h>
 
+#include <atomic>
+
 namespace at {
 namespace native {
 
@@ -18,6 +23,45 @@ void initQNNPACK() {
       "failed to initialize QNNPACK");
 }
 
+namespace {
+
+// Explicit thread-count override from set_qnnpack_num_threads; 0 means no
+// override is active.
+std::atomic<int> qnnpack_num_threads_override{0};
+
+} // namespace
+
+pthreadpool_t qnnpack_threadpool() {
+  // The process-wide shared pool: the same threads ATen's intra-op
+  // primitives and NNPACK use, so fp32/quantized interleaving cannot
+  // oversubscribe the cores.
+  const int override_threads = qnnpack_num_threads_override.load();
+  caffe2::ThreadPool* pool = caffe2::shared_threadpool();
+  if (pool == nullptr) {
+    return nullptr;
+  }
+#ifdef C10_MOBILE
+  // Mobile keeps the big.LITTLE-aware default sizing unless the caller
+  // asked for something else.
+  const int target = override_threads;
+#else
+  const int target =
+      override_threads > 0 ? override_threads : at::get_num_threads();
+#endif
+  if (target > 0 && pool->getNumThreads() != target) {
+    pool->setNumThreads(target);
+  }
+  return reinterpret_cast<pthreadpool_t>(pool);
+}
+
+void set_qnnpack_num_threads(int num_threads) {
+  TORCH_CHECK(
+      num_threads >= 0,
+      "set_qnnpack_num_threads expects a non-negative thread count, got ",
+      num_threads);
+  qnnpack_num_threads_override.store(num_threads);
+}
+
 } // namespace native
 } // namespace at
 
@@ -2,11 +2,25 @@
 
 #ifdef USE_PYTORCH_QNNPACK
 
+#include <caffe2/utils/threadpool/ThreadPoolMobile.h>
+
 namespace at {
 namespace native {
 
 void initQNNPACK();
 
+// Returns the threadpool QNNPACK kernels should run on. On mobile this is
+// the shared caffe2 mobile pool; on server builds (where no mobile pool
+// exists) it is a process-wide pool kept in sync with at::get_num_threads()
+// so QNNPACK ops follow the same intra-op thread count as the rest of ATen.
+pthreadpool_t qnnpack_threadpool();
+
+// Overrides the number of threads QNNPACK kernels use, resizing the pool at
+// run time; pass 0 to drop the override (mobile then keeps the mobile
+// pool's sizing, server follows at::get_num_threads()). Callers that want
+// per-operator control can set this around individual ops.
+void set_qnnpack_num_threads(int num_threads);
+
 } // namespace native
 } // namespace at
 
@@ -192,10 +192,20 @@ void qrelu6_kernel(const Tensor& qx, Tensor& qy) {
   });
 }
 
+// Generic dequantize -> op -> requantize loop shared by the quantized binary
+// elementwise kernels. `fp_op` combines two dequantized float values and
+// `fp_vec_op` is its Vec256<float> analogue; both run on float registers, so
+// no fp32 intermediate tensor is materialized. ReLU is fused by clamping the
+// float result before requantization.
 // Note: out is assumed to be the same size as self and other.
-// Note: Addition is only supported when self, other, out are of the same dtype.
-template <bool ReLUFused = false>
-void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
+// Note: self, other and out must be of the same dtype.
+template <bool ReLUFused, typename ScalarOp, typename VecOp>
+void qbinary_kernel(
+    Tensor& out,
+    const Tensor& self,
+    const Tensor& other,
+    ScalarOp fp_op,
+    VecOp fp_vec_op) {
   int64_t zero_point = out.q_zero_point();
   float scale = out.q_scale();
   float inv_scale = 1.0f / scale;
@@ -218,14 +228,14 @@ void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
 
   auto iter = TensorIterator::binary_op(out, self, other);
 
-  AT_DISPATCH_QINT_TYPES(out.scalar_type(), "qadd", [&]() {
+  AT_DISPATCH_QINT_TYPES(out.scalar_type(), "qbinary", [&]() {
     using Vec = Vec256<scalar_t>;
     cpu_kernel_vec(
         iter,
         [&](scalar_t a, scalar_t b) -> scalar_t {
           const auto da = at::dequantize_val(self_scale, self_zero_point, a);
           const auto db = at::dequantize_val(other_scale, other_zero_point, b);
-          float c = da + db;
+          float c = fp_op(da, db);
           if (ReLUFused) {
             c = std::max<float>(c, 0.0);
           }
@@ -238,7 +248,7 @@ void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
               other_scale_vec, other_zero_point_vec, other_scale_zp_premul_vec);
           Vec::float_vec_return_type retvals;
           for (int i = 0; i < Vec::float_num_vecs(); ++i) {
-            auto c = da[i] + db[i];
+            auto c = fp_vec_op(da[i], db[i]);
             if (ReLUFused) {
               c = vec256::maximum(c, Vec256<float>(0.0f));
             }
@@ -256,6 +266,97 @@ void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
   });
 }
 
+template <bool ReLUFused = false>
+void qadd_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
+  qbinary_kernel<ReLUFused>(
+      out,
+      self,
+      other,
+      [](float a, float b) -> float { return a + b; },
+      [](Vec256<float> a, Vec256<float> b) -> Vec256<float> { return a + b; });
+}
+
+template <bool ReLUFused = false>
+void qmul_kernel(Tensor& out, const Tensor& self, const Tensor& other) {
+  qbinary_kernel<ReLUFused>(
+      out,
+      self,
+      other,
+      [](float a, float b) -> float { return a * b; },
+      [](Vec256<float> a, Vec256<float> b) -> Vec256<float> { return a * b; });
+}
+
+// Vectorized core of fake quantization: quantize into float registers,
+// clamp to the quantized range and dequantize again (forward), or pass the
+// incoming gradient through wherever the quantized value stays in range
+// (backward). Shared by the per-tensor op and each channel slice of the
+// per-channel op.
+void fake_quant_slice_kernel(
+    Tensor& output,
+    const Tensor& input,
+    float sc,
+    int64_t z_point,
+    int64_t quant_min,
+    int64_t quant_max) {
+  float inv_scale = 1.0f / sc;
+  using Vec = Vec256<float>;
+  auto inv_scale_vec = Vec(inv_scale);
+  auto zero_point_vec = Vec((float)z_point);
+  auto quant_min_vec = Vec((float)quant_min);
+  auto quant_max_vec = Vec((float)quant_max);
+  auto scale_vec = Vec(sc);
+  auto iter = TensorIterator::unary_op(output, input);
+  cpu_kernel_vec(
+      iter,
+      [&](float self) -> float {
+        return (std::fmin(
+                    std::fmax(
+                        static_cast<int64_t>(
+                            std::nearbyint(self * inv_scale + z_point)),
+                        quant_min),
+                    quant_max) -
+                z_point) *
+            sc;
+      },
+      [&](Vec self) -> Vec {
+        auto xq = vec256::fmadd(self, inv_scale_vec, zero_point_vec).round();
+        xq = vec256::minimum(vec256::maximum(xq, quant_min_vec), quant_max_vec);
+        return (xq - zero_point_vec) * scale_vec;
+      });
+}
+
+void fake_quant_grad_slice_kernel(
+    Tensor& input_grad,
+    const Tensor& input,
+    const Tensor& output_grad,
+    float sc,
+    int64_t z_point,
+    int64_t quant_min,
+    int64_t quant_max) {
+  float inv_scale = 1.0f / sc;
+  using Vec = Vec256<float>;
+  auto inv_scale_vec = Vec(inv_scale);
+  auto zero_point_vec = Vec((float)z_point);
+  auto quant_min_vec = Vec((float)quant_min);
+  auto quant_max_vec = Vec((float)quant_max);
+  auto iter = TensorIterator::binary_op(input_grad, input, output_grad);
+  cpu_kernel_vec(
+      iter,
+      [&](float x, float dy) -> float {
+        int64_t xq =
+            static_cast<int64_t>(std::nearbyint(x * inv_scale + z_point));
+        return dy * (xq >= quant_min && xq <= quant_max);
+      },
+      [&](Vec x, Vec dy) -> Vec {
+        auto xq = vec256::fmadd(x, inv_scale_vec, zero_point_vec).round();
+        // The comparisons produce all-ones lanes where the quantized value
+        // is in range, so the bitwise and keeps dy there and zeroes it
+        // elsewhere.
+        auto mask = (xq >= quant_min_vec) & (xq <= quant_max_vec);
+        return dy & mask;
+      });
+}
+
 void qmaxpool_2d_nhwc_kernel(
     const Tensor& qx,
     int64_t iC, // input/output channels
@@ -814,6 +915,10 @@ REGISTER_DISPATCH(qrelu_stub, &qrelu_kernel);
 REGISTER_DISPATCH(qrelu6_stub, &qrelu6_kernel);
 REGISTER_DISPATCH(qadd_relu_stub, &qadd_kernel<true>);
 REGISTER_DISPATCH(qadd_stub, &qadd_kernel<false>);
+REGISTER_DISPATCH(qmul_relu_stub, &qmul_kernel<true>);
+REGISTER_DISPATCH(qmul_stub, &qmul_kernel<false>);
+REGISTER_DISPATCH(fake_quant_slice_stub, &fake_quant_slice_kernel);
+REGISTER_DISPATCH(fake_quant_grad_slice_stub, &fake_quant_grad_slice_kernel);
 REGISTER_DISPATCH(qmaxpool_2d_nhwc_stub, &qmaxpool_2d_nhwc_kernel);
 REGISTER_DISPATCH(
     qadaptive_avg_pool2d_nhwc_stub,
@@ -1,10 +1,14 @@
 #include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/WrapDimUtils.h>
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <ATen/native/quantized/cpu/quantized_ops.h>
+#include <ATen/quantized/Quantizer.h>
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace at {
@@ -29,6 +33,101 @@ bool is_valid_quantization_scheme(const Tensor& t) {
   return (qtype == kPerTensorAffine) || (qtype == kPerTensorSymmetric);
 }
 
+// True when every input has the same rank and matching sizes outside the
+// concatenation dimension, i.e. plain cat semantics with none of at::cat's
+// legacy shape special cases. Only then can we concatenate in the quantized
+// domain below.
+bool is_cat_int8_path(const c10::List<Tensor>& qxs, int64_t dim) {
+  const auto& qx0 = qxs.get(0);
+  if (qx0.dim() == 0) {
+    return false;
+  }
+  for (const at::Tensor& qx : qxs) {
+    if (qx.dim() != qx0.dim()) {
+      return false;
+    }
+    for (int64_t d = 0; d < qx.dim(); ++d) {
+      if (d != dim && qx.size(d) != qx0.size(d)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Concatenate without leaving the quantized domain. Inputs whose scale and
+// zero point already match the output are copied bytewise; the rest are
+// requantized int8->int8 elementwise. Either way no fp32 intermediate is
+// materialized.
+template <bool ReLUFused>
+Tensor qcat_int8(
+    const c10::List<Tensor>& qxs,
+    int64_t dim,
+    double scale,
+    int64_t zero_point) {
+  const auto& qx0 = qxs.get(0);
+  std::vector<Tensor> xs;
+  xs.reserve(qxs.size());
+  std::vector<int64_t> out_sizes = qx0.sizes().vec();
+  out_sizes[dim] = 0;
+  for (const at::Tensor& qx : qxs) {
+    out_sizes[dim] += qx.size(dim);
+    xs.push_back(qx.contiguous());
+  }
+
+  Tensor qy;
+  AT_DISPATCH_QINT_TYPES(qx0.scalar_type(), "qcat_int8", [&]() {
+    qy = at::_empty_affine_quantized(
+        out_sizes,
+        at::device(kCPU).dtype(SCALAR_TYPE),
+        scale,
+        zero_point);
+    int64_t outer = 1;
+    for (int64_t d = 0; d < dim; ++d) {
+      outer *= out_sizes[d];
+    }
+    const int64_t out_row = outer > 0 ? qy.numel() / outer : 0;
+    scalar_t* out_data = static_cast<scalar_t*>(qy.data_ptr());
+
+    int64_t col_offset = 0;
+    for (const auto& x : xs) {
+      const int64_t in_row = outer > 0 ? x.numel() / outer : 0;
+      const scalar_t* in_data = static_cast<const scalar_t*>(x.data_ptr());
+      const bool same_qparams =
+          x.q_scale() == scale && x.q_zero_point() == zero_point;
+      const double x_scale = x.q_scale();
+      const int64_t x_zero_point = x.q_zero_point();
+      int64_t grain_size = std::max<int64_t>(
+          1, at::internal::GRAIN_SIZE / std::max<int64_t>(1, in_row));
+      at::parallel_for(0, outer, grain_size, [&](int64_t begin, int64_t end) {
+        for (int64_t o = begin; o < end; ++o) {
+          const scalar_t* src = in_data + o * in_row;
+          scalar_t* dst = out_data + o * out_row + col_offset;
+          if (same_qparams && !ReLUFused) {
+            std::memcpy(dst, src, in_row * sizeof(scalar_t));
+          } else if (same_qparams) {
+            for (int64_t e = 0; e < in_row; ++e) {
+              dst[e] = scalar_t(
+                  std::max<underlying_t>(src[e].val_, zero_point));
+            }
+          } else {
+            for (int64_t e = 0; e < in_row; ++e) {
+              scalar_t v = at::requantize_val<scalar_t, scalar_t>(
+                  x_scale, x_zero_point, scale, zero_point, src[e]);
+              if (ReLUFused) {
+                v = scalar_t(std::max<underlying_t>(v.val_, zero_point));
+              }
+              dst[e] = v;
+            }
+          }
+        }
+      });
+      col_offset += in_row;
+    }
+  });
+  return qy;
+}
+
 /* Quantized concatenation.
  *
  * Note: This function uses a dequantization.
@@ -53,12 +152,20 @@ Tensor quantized_cat(
 
   const auto x_dtype = qxs.get(0).scalar_type();
   const auto x_qscheme = qxs.get(0).qscheme();
-  std::vector<Tensor> xs;
-  xs.reserve(qxs.size());
   for (const at::Tensor& qx : qxs) {
     TORCH_CHECK(x_dtype == qx.scalar_type(), "All dtypes must be the same.");
     TORCH_CHECK(
         x_qscheme == qx.qscheme(), "Quantization schemes must be the same.");
+  }
+
+  const int64_t wrapped_dim = maybe_wrap_dim(dim, qxs.get(0).dim());
+  if (is_cat_int8_path(qxs, wrapped_dim)) {
+    return qcat_int8<ReLUFused>(qxs, wrapped_dim, scale, zero_point);
+  }
+
+  std::vector<Tensor> xs;
+  xs.reserve(qxs.size());
+  for (const at::Tensor& qx : qxs) {
     xs.push_back(qx.dequantize());
   }
   const Tensor y = at::cat(xs, dim);
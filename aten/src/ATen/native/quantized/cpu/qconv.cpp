@@ -8,6 +8,7 @@
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
+#include <ATen/native/quantized/cpu/init_qnnpack.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 
@@ -625,7 +626,7 @@ class QConvInt8 final : public c10::OperatorKernel {
         output.q_scale(),
         output.q_zero_point(),
         reinterpret_cast<uint8_t*>(output.data_ptr<c10::quint8>()),
-        caffe2::mobile_pthreadpool());
+        qnnpack_threadpool());
 
     TORCH_INTERNAL_ASSERT(
         run_status == pytorch_qnnp_status_success,
@@ -0,0 +1,302 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/op_registration/op_registration.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace at {
+namespace native {
+namespace {
+
+// Rowwise-quantized embedding tables. Each row of the fp32 table is
+// quantized independently against its own min/max and stored as uint8 codes
+// (one per element for the byte format, two per byte for the 4-bit format)
+// followed by the row's float scale and bias:
+//
+//   byte row:  [D uint8 codes][float scale][float bias]     -> D + 8 bytes
+//   4-bit row: [D/2 packed codes][float scale][float bias]  -> D/2 + 8 bytes
+//
+// An element dequantizes as `code * scale + bias`. The lookup kernels below
+// accumulate dequantized rows directly into the fp32 output, so the fp32
+// table is never materialized; only the bags that are actually looked up
+// cost any bandwidth.
+constexpr int64_t kRowwiseFooterBytes = 2 * sizeof(float);
+
+inline void rowwise_scale_bias(
+    const float* row,
+    int64_t D,
+    int64_t levels,
+    float* scale,
+    float* bias) {
+  float minimum = row[0];
+  float maximum = row[0];
+  for (int64_t j = 1; j < D; ++j) {
+    minimum = std::min(minimum, row[j]);
+    maximum = std::max(maximum, row[j]);
+  }
+  *bias = minimum;
+  *scale = (maximum - minimum) / levels;
+  if (*scale == 0.f) {
+    *scale = 1.f;
+  }
+}
+
+inline uint8_t quantize_element(float x, float scale, float bias, int64_t levels) {
+  auto code = std::nearbyint((x - bias) / scale);
+  return static_cast<uint8_t>(
+      std::min<float>(std::max<float>(code, 0.f), (float)levels));
+}
+
+Tensor embedding_bag_byte_prepack(const Tensor& weight) {
+  TORCH_CHECK(weight.dim() == 2, "embedding table must be 2-dimensional");
+  TORCH_CHECK(
+      weight.scalar_type() == kFloat,
+      "'embedding_bag_byte_prepack' expects a float table");
+  auto weight_contig = weight.contiguous();
+  const int64_t N = weight.size(0);
+  const int64_t D = weight.size(1);
+  auto packed = at::empty(
+      {N, D + kRowwiseFooterBytes}, weight.options().dtype(kByte));
+  const float* weight_data = weight_contig.data_ptr<float>();
+  uint8_t* packed_data = packed.data_ptr<uint8_t>();
+
+  at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const float* row = weight_data + i * D;
+      uint8_t* packed_row = packed_data + i * (D + kRowwiseFooterBytes);
+      float scale, bias;
+      rowwise_scale_bias(row, D, /*levels=*/255, &scale, &bias);
+      for (int64_t j = 0; j < D; ++j) {
+        packed_row[j] = quantize_element(row[j], scale, bias, /*levels=*/255);
+      }
+      std::memcpy(packed_row + D, &scale, sizeof(float));
+      std::memcpy(packed_row + D + sizeof(float), &bias, sizeof(float));
+    }
+  });
+  return packed;
+}
+
+Tensor embedding_bag_4bit_prepack(const Tensor& weight) {
+  TORCH_CHECK(weight.dim() == 2, "embedding table must be 2-dimensional");
+  TORCH_CHECK(
+      weight.scalar_type() == kFloat,
+      "'embedding_bag_4bit_prepack' expects a float table");
+  TORCH_CHECK(
+      weight.size(1) % 2 == 0,
+      "4-bit embedding packing requires an even embedding dimension, got ",
+      weight.size(1));
+  auto weight_contig = weight.contiguous();
+  const int64_t N = weight.size(0);
+  const int64_t D = weight.size(1);
+  auto packed = at::empty(
+      {N, D / 2 + kRowwiseFooterBytes}, weight.options().dtype(kByte));
+  const float* weight_data = weight_contig.data_ptr<float>();
+  uint8_t* packed_data = packed.data_ptr<uint8_t>();
+
+  at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      const float* row = weight_data + i * D;
+      uint8_t* packed_row = packed_data + i * (D / 2 + kRowwiseFooterBytes);
+      float scale, bias;
+      rowwise_scale_bias(row, D, /*levels=*/15, &scale, &bias);
+      for (int64_t j = 0; j < D; j += 2) {
+        // Even column in the low nibble, odd column in the high nibble.
+        uint8_t lo = quantize_element(row[j], scale, bias, /*levels=*/15);
+        uint8_t hi = quantize_element(row[j + 1], scale, bias, /*levels=*/15);
+        packed_row[j / 2] = static_cast<uint8_t>(lo | (hi << 4));
+      }
+      std::memcpy(packed_row + D / 2, &scale, sizeof(float));
+      std::memcpy(packed_row + D / 2 + sizeof(float), &bias, sizeof(float));
+    }
+  });
+  return packed;
+}
+
+void check_embedding_bag_args(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const c10::optional<Tensor>& per_sample_weights) {
+  TORCH_CHECK(weight.dim() == 2, "packed embedding table must be 2-dimensional");
+  TORCH_CHECK(
+      weight.scalar_type() == kByte,
+      "expected a rowwise-quantized uint8 table, got ", weight.scalar_type());
+  TORCH_CHECK(indices.dim() == 1, "indices must be 1-dimensional");
+  TORCH_CHECK(offsets.dim() == 1, "offsets must be 1-dimensional");
+  TORCH_CHECK(
+      indices.scalar_type() == kLong && offsets.scalar_type() == kLong,
+      "indices and offsets must be int64 tensors");
+  if (per_sample_weights.has_value() && per_sample_weights->defined()) {
+    TORCH_CHECK(
+        per_sample_weights->scalar_type() == kFloat &&
+            per_sample_weights->numel() == indices.numel(),
+        "per_sample_weights must be a float tensor with one entry per index");
+  }
+}
+
+// Shared lookup loop: `unpack` dequantize-accumulates one packed row into the
+// bag accumulator with the given coefficient.
+template <typename unpack_fn>
+Tensor embedding_bag_rowwise_offsets_impl(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const c10::optional<Tensor>& per_sample_weights,
+    int64_t D,
+    const unpack_fn& unpack) {
+  auto weight_contig = weight.contiguous();
+  auto indices_contig = indices.contiguous();
+  auto offsets_contig = offsets.contiguous();
+  const int64_t N = weight.size(0);
+  const int64_t row_bytes = weight.size(1);
+  const int64_t num_indices = indices.numel();
+  const int64_t num_bags = offsets.numel();
+
+  const uint8_t* weight_data = weight_contig.data_ptr<uint8_t>();
+  const int64_t* indices_data = indices_contig.data_ptr<int64_t>();
+  const int64_t* offsets_data = offsets_contig.data_ptr<int64_t>();
+  const float* sample_weights_data = nullptr;
+  Tensor sample_weights_contig;
+  if (per_sample_weights.has_value() && per_sample_weights->defined()) {
+    sample_weights_contig = per_sample_weights->contiguous();
+    sample_weights_data = sample_weights_contig.data_ptr<float>();
+  }
+
+  auto output = at::zeros(
+      {num_bags, D}, weight.options().dtype(kFloat));
+  float* output_data = output.data_ptr<float>();
+
+  int64_t grain_size = std::max(
+      (int64_t)1, internal::GRAIN_SIZE / std::max((int64_t)1, D));
+  at::parallel_for(0, num_bags, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t b = begin; b < end; ++b) {
+      int64_t bag_begin = offsets_data[b];
+      int64_t bag_end = b + 1 < num_bags ? offsets_data[b + 1] : num_indices;
+      TORCH_CHECK(
+          bag_begin >= 0 && bag_begin <= bag_end && bag_end <= num_indices,
+          "offsets must be increasing and within the indices range");
+      float* out_row = output_data + b * D;
+      for (int64_t s = bag_begin; s < bag_end; ++s) {
+        int64_t idx = indices_data[s];
+        TORCH_CHECK(
+            idx >= 0 && idx < N,
+            "embedding index out of range: ", idx, " for table of size ", N);
+        float coeff =
+            sample_weights_data != nullptr ? sample_weights_data[s] : 1.f;
+        unpack(weight_data + idx * row_bytes, coeff, out_row);
+      }
+    }
+  });
+  return output;
+}
+
+Tensor embedding_bag_byte_rowwise_offsets(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const c10::optional<Tensor>& per_sample_weights) {
+  check_embedding_bag_args(weight, indices, offsets, per_sample_weights);
+  const int64_t D = weight.size(1) - kRowwiseFooterBytes;
+  TORCH_CHECK(D >= 0, "packed rows are too short to hold a scale and bias");
+  return embedding_bag_rowwise_offsets_impl(
+      weight, indices, offsets, per_sample_weights, D,
+      [D](const uint8_t* row, float coeff, float* out_row) {
+        float scale, bias;
+        std::memcpy(&scale, row + D, sizeof(float));
+        std::memcpy(&bias, row + D + sizeof(float), sizeof(float));
+        scale *= coeff;
+        bias *= coeff;
+        for (int64_t j = 0; j < D; ++j) {
+          out_row[j] += row[j] * scale + bias;
+        }
+      });
+}
+
+Tensor embedding_bag_4bit_rowwise_offsets(
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const c10::optional<Tensor>& per_sample_weights) {
+  check_embedding_bag_args(weight, indices, offsets, per_sample_weights);
+  const int64_t D = 2 * (weight.size(1) - kRowwiseFooterBytes);
+  TORCH_CHECK(D >= 0, "packed rows are too short to hold a scale and bias");
+  return embedding_bag_rowwise_offsets_impl(
+      weight, indices, offsets, per_sample_weights, D,
+      [D](const uint8_t* row, float coeff, float* out_row) {
+        float scale, bias;
+        std::memcpy(&scale, row + D / 2, sizeof(float));
+        std::memcpy(&bias, row + D / 2 + sizeof(float), sizeof(float));
+        scale *= coeff;
+        bias *= coeff;
+        for (int64_t j = 0; j < D; j += 2) {
+          uint8_t packed_pair = row[j / 2];
+          out_row[j] += (packed_pair & 0x0f) * scale + bias;
+          out_row[j + 1] += (packed_pair >> 4) * scale + bias;
+        }
+      });
+}
+
+class QEmbeddingBagBytePrepack final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight) {
+    return embedding_bag_byte_prepack(weight);
+  }
+};
+
+class QEmbeddingBag4BitPrepack final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight) {
+    return embedding_bag_4bit_prepack(weight);
+  }
+};
+
+class QEmbeddingBagByteRowwiseOffsets final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor weight,
+      Tensor indices,
+      Tensor offsets,
+      c10::optional<Tensor> per_sample_weights) {
+    return embedding_bag_byte_rowwise_offsets(
+        weight, indices, offsets, per_sample_weights);
+  }
+};
+
+class QEmbeddingBag4BitRowwiseOffsets final : public c10::OperatorKernel {
+ public:
+  Tensor operator()(
+      Tensor weight,
+      Tensor indices,
+      Tensor offsets,
+      c10::optional<Tensor> per_sample_weights) {
+    return embedding_bag_4bit_rowwise_offsets(
+        weight, indices, offsets, per_sample_weights);
+  }
+};
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("quantized::embedding_bag_byte_prepack(Tensor weight) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBagBytePrepack>(TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_4bit_prepack(Tensor weight) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitPrepack>(TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_byte_rowwise_offsets(Tensor weight,"
+            " Tensor indices, Tensor offsets,"
+            " Tensor? per_sample_weights=None) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBagByteRowwiseOffsets>(
+                    TensorTypeId::CPUTensorId))
+        .op("quantized::embedding_bag_4bit_rowwise_offsets(Tensor weight,"
+            " Tensor indices, Tensor offsets,"
+            " Tensor? per_sample_weights=None) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QEmbeddingBag4BitRowwiseOffsets>(
+                    TensorTypeId::CPUTensorId));
+
+} // namespace
+} // namespace native
+} // namespace at
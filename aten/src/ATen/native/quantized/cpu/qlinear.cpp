@@ -3,6 +3,7 @@
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
+#include <ATen/native/quantized/cpu/init_qnnpack.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <caffe2/utils/threadpool/ThreadPoolMobile.h>
 
@@ -316,7 +317,7 @@ class QLinearInt8 final : public torch::OperatorKernel {
         packB->getPackedWeights(),
         (uint8_t*)output.data_ptr<c10::quint8>(),
         rows_w /* output_stride */,
-        caffe2::mobile_pthreadpool() /* threadpool */);
+        qnnpack_threadpool() /* threadpool */);
 
     TORCH_INTERNAL_ASSERT(
         runStatus == pytorch_qnnp_status_success,
@@ -0,0 +1,221 @@
+#include <ATen/ATen.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/cpp_custom_type_hack.h>
+#include <ATen/native/quantized/cpu/fbgemm_utils.h>
+
+#include <cstring>
+#include <vector>
+
+namespace at {
+namespace native {
+namespace {
+
+#ifdef USE_FBGEMM
+
+// Flat archive format for prepacked linear weights, so TorchScript modules
+// can stash the result of quantized::linear_prepack as a plain byte-tensor
+// attribute (e.g. in __getstate__) and rebuild the fbgemm state on load
+// without re-running quantization, the per-channel qparam extraction or the
+// column-offset computation. Layout:
+//
+//   int64 header[8]: magic, version, payload kind, qscheme, N, K,
+//                    qparam count, bias flag
+//   float   scales[qparam count]
+//   int32   zero_points[qparam count]
+//   int32   col_offsets[N]
+//   int8    weight codes[N * K]   (original N x K layout)
+//   float   bias[N]               (if the bias flag is set)
+//
+// Payload kind 0 stores portable int8 codes and is valid on any machine;
+// the field doubles as an ISA tag so a future version can carry
+// ISA-specific packed buffers and fall back to repacking when the tag does
+// not match the loading CPU. Deserialization always goes through one
+// PackBMatrix packing pass today, which is the cheap part of prepack.
+constexpr int64_t kLinearPrepackMagic = 0x5154504b4c573031; // "QTPKLW01"
+constexpr int64_t kLinearPrepackVersion = 1;
+constexpr int64_t kLinearPrepackPayloadPortable = 0;
+constexpr int64_t kLinearPrepackHeaderFields = 8;
+
+at::Tensor fbgemm_linear_prepack_serialize(at::Tensor packed_weight) {
+  auto& pack_ptr =
+      cpp_custom_type_hack::cast<PackedLinearWeight>(packed_weight);
+  auto packB = pack_ptr.w.get();
+
+  const int64_t N = static_cast<int64_t>(packB->numCols());
+  const int64_t K = static_cast<int64_t>(packB->numRows());
+  const int64_t num_qparams = static_cast<int64_t>(pack_ptr.w_scale.size());
+  const bool has_bias = pack_ptr.bias.has_value();
+
+  Tensor bias_contig;
+  if (has_bias) {
+    bias_contig = pack_ptr.bias->contiguous();
+    TORCH_CHECK(
+        bias_contig.scalar_type() == kFloat && bias_contig.numel() == N,
+        "prepacked linear bias must be a float vector with N elements");
+  }
+
+  const int64_t total_bytes = kLinearPrepackHeaderFields * sizeof(int64_t) +
+      num_qparams * (sizeof(float) + sizeof(int32_t)) +
+      N * sizeof(int32_t) + N * K * sizeof(int8_t) +
+      (has_bias ? N * sizeof(float) : 0);
+
+  auto blob = at::empty({total_bytes}, at::device(kCPU).dtype(kByte));
+  uint8_t* out = blob.data_ptr<uint8_t>();
+
+  int64_t header[kLinearPrepackHeaderFields] = {
+      kLinearPrepackMagic,
+      kLinearPrepackVersion,
+      kLinearPrepackPayloadPortable,
+      static_cast<int64_t>(pack_ptr.q_scheme),
+      N,
+      K,
+      num_qparams,
+      has_bias ? 1 : 0};
+  std::memcpy(out, header, sizeof(header));
+  out += sizeof(header);
+
+  std::memcpy(out, pack_ptr.w_scale.data(), num_qparams * sizeof(float));
+  out += num_qparams * sizeof(float);
+  std::memcpy(out, pack_ptr.w_zp.data(), num_qparams * sizeof(int32_t));
+  out += num_qparams * sizeof(int32_t);
+  std::memcpy(out, pack_ptr.col_offsets.data(), N * sizeof(int32_t));
+  out += N * sizeof(int32_t);
+
+  // Unpack the tiled fbgemm buffer back into the original N x K layout;
+  // these codes are what payload kind 0 ships.
+  packB->unpack(reinterpret_cast<int8_t*>(out));
+  out += N * K * sizeof(int8_t);
+
+  if (has_bias) {
+    std::memcpy(out, bias_contig.data_ptr<float>(), N * sizeof(float));
+  }
+  return blob;
+}
+
+at::Tensor fbgemm_linear_prepack_deserialize(at::Tensor blob) {
+  TORCH_CHECK(
+      blob.scalar_type() == kByte && blob.dim() == 1,
+      "expected a serialized prepacked weight byte tensor");
+  auto blob_contig = blob.contiguous();
+  const uint8_t* in = blob_contig.data_ptr<uint8_t>();
+  TORCH_CHECK(
+      blob.numel() >=
+          static_cast<int64_t>(kLinearPrepackHeaderFields * sizeof(int64_t)),
+      "serialized prepacked weight is truncated");
+
+  int64_t header[kLinearPrepackHeaderFields];
+  std::memcpy(header, in, sizeof(header));
+  in += sizeof(header);
+
+  TORCH_CHECK(
+      header[0] == kLinearPrepackMagic,
+      "not a serialized prepacked linear weight");
+  TORCH_CHECK(
+      header[1] == kLinearPrepackVersion,
+      "unsupported prepacked weight format version ", header[1]);
+  TORCH_CHECK(
+      header[2] == kLinearPrepackPayloadPortable,
+      "unsupported prepacked weight payload kind ", header[2],
+      " for this machine");
+  const auto q_scheme = static_cast<c10::QScheme>(header[3]);
+  const int64_t N = header[4];
+  const int64_t K = header[5];
+  const int64_t num_qparams = header[6];
+  const bool has_bias = header[7] != 0;
+  TORCH_CHECK(
+      N > 0 && K > 0 && (num_qparams == 1 || num_qparams == N),
+      "corrupt prepacked weight header");
+  TORCH_CHECK(
+      blob.numel() ==
+          static_cast<int64_t>(
+              kLinearPrepackHeaderFields * sizeof(int64_t) +
+              num_qparams * (sizeof(float) + sizeof(int32_t)) +
+              N * sizeof(int32_t) + N * K * sizeof(int8_t) +
+              (has_bias ? N * sizeof(float) : 0)),
+      "serialized prepacked weight has unexpected size");
+
+  std::vector<float> w_scale(num_qparams);
+  std::memcpy(w_scale.data(), in, num_qparams * sizeof(float));
+  in += num_qparams * sizeof(float);
+  std::vector<int32_t> w_zp(num_qparams);
+  std::memcpy(w_zp.data(), in, num_qparams * sizeof(int32_t));
+  in += num_qparams * sizeof(int32_t);
+  std::vector<int32_t> col_offsets(N);
+  std::memcpy(col_offsets.data(), in, N * sizeof(int32_t));
+  in += N * sizeof(int32_t);
+
+  const int8_t* weight_codes = reinterpret_cast<const int8_t*>(in);
+  in += N * K * sizeof(int8_t);
+
+  c10::optional<at::Tensor> bias;
+  if (has_bias) {
+    auto bias_tensor = at::empty({N}, at::device(kCPU).dtype(kFloat));
+    std::memcpy(bias_tensor.data_ptr<float>(), in, N * sizeof(float));
+    bias = bias_tensor;
+  }
+
+  auto ret_ptr = guts::make_unique<PackedLinearWeight>(PackedLinearWeight{
+      guts::make_unique<fbgemm::PackBMatrix<int8_t>>(
+          /*trans=*/fbgemm::matrix_op_t::Transpose,
+          /*nRow=*/K,
+          /*nCol=*/N,
+          /*smat=*/weight_codes,
+          /*ld=*/K,
+          /*pmat=*/nullptr, // PackBMatrix manages ownership of pmat
+          /*groups=*/1),
+      bias,
+      std::move(col_offsets),
+      std::move(w_scale),
+      std::move(w_zp),
+      q_scheme});
+  return cpp_custom_type_hack::create(
+      std::move(ret_ptr), at::device(kCPU).dtype(kQInt8));
+}
+
+#endif // USE_FBGEMM
+
+class QLinearPrepackSerialize final : public c10::OperatorKernel {
+ public:
+  at::Tensor operator()(at::Tensor packed_weight) {
+#ifdef USE_FBGEMM
+    TORCH_CHECK(
+        at::globalContext().qEngine() == at::QEngine::FBGEMM,
+        "quantized::linear_prepack_serialize is only supported for the"
+        " FBGEMM quantization engine");
+    return fbgemm_linear_prepack_serialize(packed_weight);
+#else
+    TORCH_CHECK(
+        false, "This PyTorch installation was not built with FBGEMM operators");
+#endif
+  }
+};
+
+class QLinearPrepackDeserialize final : public c10::OperatorKernel {
+ public:
+  at::Tensor operator()(at::Tensor blob) {
+#ifdef USE_FBGEMM
+    TORCH_CHECK(
+        at::globalContext().qEngine() == at::QEngine::FBGEMM,
+        "quantized::linear_prepack_deserialize is only supported for the"
+        " FBGEMM quantization engine");
+    return fbgemm_linear_prepack_deserialize(blob);
+#else
+    TORCH_CHECK(
+        false, "This PyTorch installation was not built with FBGEMM operators");
+#endif
+  }
+};
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("quantized::linear_prepack_serialize(Tensor W_prepack) -> Tensor",
+            torch::RegisterOperators::options()
+                .kernel<QLinearPrepackSerialize>(TensorTypeId::CPUTensorId))
+        .op("quantized::linear_prepack_deserialize(Tensor W_blob)"
+            " -> Tensor W_prepack",
+            torch::RegisterOperators::options()
+                .kernel<QLinearPrepackDeserialize>(TensorTypeId::CPUTensorId));
+
+} // namespace
+} // namespace native
+} // namespace at
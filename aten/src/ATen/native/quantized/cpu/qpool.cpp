@@ -383,7 +383,7 @@ class QMaxPool2D_arr_args final : public torch::OperatorKernel {
          setupStatus == pytorch_qnnp_status_success,
          "failed to setup QNNPACK MaxPool operator");
 
-     pthreadpool_t threadpool = caffe2::mobile_pthreadpool();
+     pthreadpool_t threadpool = qnnpack_threadpool();
      const pytorch_qnnp_status runStatus =
          pytorch_qnnp_run_operator(qnnpack_operator, threadpool);
      TORCH_INTERNAL_ASSERT(
@@ -8,6 +8,8 @@ namespace native {
 using qrelu_fn = void (*)(const at::Tensor& /*qx*/, at::Tensor& /*qy*/);
 using qadd_fn =
     void (*)(Tensor& /*out*/, const Tensor& /*self*/, const Tensor& /*other*/);
+using qmul_fn =
+    void (*)(Tensor& /*out*/, const Tensor& /*self*/, const Tensor& /*other*/);
 using qmaxpool_2d_fn = void (*)(
     const Tensor& qx,
     int64_t iC, // input/output channels
@@ -67,6 +69,22 @@ using qupsample_bilinear2d_fn = void (*)(
     int64_t channels,
     bool align_corners);
 
+using fake_quant_slice_fn = void (*)(
+    Tensor& /*output*/,
+    const Tensor& /*input*/,
+    float sc,
+    int64_t z_point,
+    int64_t quant_min,
+    int64_t quant_max);
+using fake_quant_grad_slice_fn = void (*)(
+    Tensor& /*input_grad*/,
+    const Tensor& /*input*/,
+    const Tensor& /*output_grad*/,
+    float sc,
+    int64_t z_point,
+    int64_t quant_min,
+    int64_t quant_max);
+
 using qcat_nhwc_fn = Tensor (*)(
     const c10::List<Tensor>& qxs,
     int64_t dim,
@@ -79,6 +97,10 @@ DECLARE_DISPATCH(qrelu_fn, qrelu_stub);
 DECLARE_DISPATCH(qrelu_fn, qrelu6_stub);
 DECLARE_DISPATCH(qadd_fn, qadd_stub);
 DECLARE_DISPATCH(qadd_fn, qadd_relu_stub);
+DECLARE_DISPATCH(qmul_fn, qmul_stub);
+DECLARE_DISPATCH(qmul_fn, qmul_relu_stub);
+DECLARE_DISPATCH(fake_quant_slice_fn, fake_quant_slice_stub);
+DECLARE_DISPATCH(fake_quant_grad_slice_fn, fake_quant_grad_slice_stub);
 DECLARE_DISPATCH(qmaxpool_2d_fn, qmaxpool_2d_nhwc_stub);
 DECLARE_DISPATCH(qadaptive_avg_pool2d_fn, qadaptive_avg_pool2d_nhwc_stub);
 DECLARE_DISPATCH(qavg_pool2d_fn, qavg_pool2d_nhwc_stub);
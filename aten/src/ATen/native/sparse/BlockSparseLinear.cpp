@@ -0,0 +1,215 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/cpp_custom_type_hack.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace at {
+namespace native {
+
+// Block-sparse (BSR) linear layer for block-pruned dense weights.
+//
+// Unstructured sparsity buys no CPU speedup: the COO kernels in
+// SparseTensorMath.cpp chase one index per element and cannot vectorize.
+// Block pruning does, provided the kernel sees whole blocks: the ops below
+// prepack a pruned (out_features, in_features) weight into block-CSR over a
+// grid of block_size x block_size tiles, skipping all-zero tiles, and the
+// matching linear op multiplies one stored tile at a time with vec256
+// register blocking, so the work (and the memory traffic) scales with the
+// surviving blocks.
+//
+//   packed = sparse::linear_bsr_prepack(W, B, block_size)
+//   Y = sparse::linear_bsr(X, packed)   # Y = X @ W^T + B
+//
+// Float CPU tensors only; out_features and in_features must be divisible by
+// block_size.  The packed result is an opaque tensor (cpp_custom_type_hack,
+// like the fbgemm prepacked weights) and holds its own copy of the blocks,
+// so the original weight can be freed.
+struct CAFFE2_API BSRLinearWeight {
+  int64_t out_features;
+  int64_t in_features;
+  int64_t block_size;
+  // Block CSR over the (out_features / block_size) x
+  // (in_features / block_size) grid of weight tiles.
+  std::vector<int64_t> row_ptr;
+  std::vector<int64_t> block_cols;
+  // Stored tiles, one block_size * block_size run each.  The within-tile
+  // layout is transposed to [k][n] -- element (n, k) of a tile lives at
+  // data[k * block_size + n] -- so the inner SpMM loop broadcasts one
+  // input element and FMAs into contiguous output lanes.
+  std::vector<float> data;
+  std::vector<float> bias; // empty when the layer has no bias
+};
+
+namespace {
+
+class BSRLinearPrepack final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(Tensor weight, c10::optional<Tensor> bias, int64_t block_size) {
+    TORCH_CHECK(
+        weight.dim() == 2,
+        "sparse::linear_bsr_prepack: expected a 2-d weight, got ",
+        weight.dim(), "-d");
+    TORCH_CHECK(
+        weight.scalar_type() == kFloat && weight.device().is_cpu(),
+        "sparse::linear_bsr_prepack: only float CPU weights are supported");
+    TORCH_CHECK(
+        block_size > 0,
+        "sparse::linear_bsr_prepack: block_size must be positive, got ",
+        block_size);
+    const int64_t N = weight.size(0);
+    const int64_t K = weight.size(1);
+    TORCH_CHECK(
+        N % block_size == 0 && K % block_size == 0,
+        "sparse::linear_bsr_prepack: weight dimensions (", N, ", ", K,
+        ") must be divisible by block_size ", block_size);
+
+    Tensor weight_contig = weight.contiguous();
+    const float* w = weight_contig.data_ptr<float>();
+
+    auto packed = guts::make_unique<BSRLinearWeight>();
+    packed->out_features = N;
+    packed->in_features = K;
+    packed->block_size = block_size;
+
+    const int64_t grid_rows = N / block_size;
+    const int64_t grid_cols = K / block_size;
+    packed->row_ptr.reserve(grid_rows + 1);
+    packed->row_ptr.push_back(0);
+    for (int64_t nb = 0; nb < grid_rows; nb++) {
+      for (int64_t kb = 0; kb < grid_cols; kb++) {
+        const float* tile = w + nb * block_size * K + kb * block_size;
+        bool nonzero = false;
+        for (int64_t nn = 0; nn < block_size && !nonzero; nn++) {
+          for (int64_t kk = 0; kk < block_size; kk++) {
+            if (tile[nn * K + kk] != 0.f) {
+              nonzero = true;
+              break;
+            }
+          }
+        }
+        if (!nonzero) {
+          continue;
+        }
+        packed->block_cols.push_back(kb);
+        const size_t off = packed->data.size();
+        packed->data.resize(off + block_size * block_size);
+        for (int64_t kk = 0; kk < block_size; kk++) {
+          for (int64_t nn = 0; nn < block_size; nn++) {
+            packed->data[off + kk * block_size + nn] = tile[nn * K + kk];
+          }
+        }
+      }
+      packed->row_ptr.push_back(packed->block_cols.size());
+    }
+
+    if (bias.has_value() && bias->defined()) {
+      TORCH_CHECK(
+          bias->dim() == 1 && bias->size(0) == N &&
+              bias->scalar_type() == kFloat && bias->device().is_cpu(),
+          "sparse::linear_bsr_prepack: bias must be a float CPU vector of ",
+          N, " elements");
+      Tensor bias_contig = bias->contiguous();
+      const float* b = bias_contig.data_ptr<float>();
+      packed->bias.assign(b, b + N);
+    }
+
+    return cpp_custom_type_hack::create(std::move(packed), weight.options());
+  }
+};
+
+class BSRLinear final : public torch::OperatorKernel {
+ public:
+  Tensor operator()(Tensor input, Tensor packed) {
+    const auto& w = cpp_custom_type_hack::cast<BSRLinearWeight>(packed);
+    TORCH_CHECK(
+        input.dim() >= 2,
+        "sparse::linear_bsr: expected input of at least 2 dimensions, got ",
+        input.dim());
+    TORCH_CHECK(
+        input.scalar_type() == kFloat && input.device().is_cpu(),
+        "sparse::linear_bsr: only float CPU inputs are supported");
+    const int64_t K = w.in_features;
+    const int64_t N = w.out_features;
+    TORCH_CHECK(
+        input.size(input.dim() - 1) == K,
+        "sparse::linear_bsr: input has ", input.size(input.dim() - 1),
+        " features, but the packed weight expects ", K);
+
+    Tensor input_contig = input.contiguous();
+    const int64_t M = input_contig.numel() / K;
+    auto out_sizes = input.sizes().vec();
+    out_sizes.back() = N;
+    Tensor output = at::empty(out_sizes, input.options());
+
+    const float* in_ptr = input_contig.data_ptr<float>();
+    float* out_ptr = output.data_ptr<float>();
+    const int64_t B = w.block_size;
+    const int64_t block_rows = N / B;
+    const float* bias_ptr = w.bias.empty() ? nullptr : w.bias.data();
+
+    using Vec = vec256::Vec256<float>;
+    // Each input row touches every stored tile once.
+    const int64_t row_cost = std::max(
+        (int64_t)1, static_cast<int64_t>(w.data.size()));
+    const int64_t grain_size = std::max(
+        (int64_t)1, at::internal::GRAIN_SIZE / row_cost);
+    at::parallel_for(0, M, grain_size, [&](int64_t start, int64_t end) {
+      for (int64_t m = start; m < end; m++) {
+        const float* in_row = in_ptr + m * K;
+        float* out_row = out_ptr + m * N;
+        if (bias_ptr) {
+          std::copy(bias_ptr, bias_ptr + N, out_row);
+        } else {
+          std::fill(out_row, out_row + N, 0.f);
+        }
+        for (int64_t nb = 0; nb < block_rows; nb++) {
+          float* out_blk = out_row + nb * B;
+          for (int64_t idx = w.row_ptr[nb]; idx < w.row_ptr[nb + 1]; idx++) {
+            const float* tile = w.data.data() + idx * B * B;
+            const float* in_blk = in_row + w.block_cols[idx] * B;
+            // Register-blocked tile multiply: hold one vector of outputs
+            // across the whole k loop, broadcasting one input element per
+            // FMA.  The [k][n] tile layout makes every load contiguous.
+            int64_t j = 0;
+            for (; j + Vec::size() <= B; j += Vec::size()) {
+              Vec acc = Vec::loadu(out_blk + j);
+              for (int64_t kk = 0; kk < B; kk++) {
+                acc = vec256::fmadd(
+                    Vec(in_blk[kk]), Vec::loadu(tile + kk * B + j), acc);
+              }
+              acc.store(out_blk + j);
+            }
+            for (; j < B; j++) {
+              float acc = out_blk[j];
+              for (int64_t kk = 0; kk < B; kk++) {
+                acc += in_blk[kk] * tile[kk * B + j];
+              }
+              out_blk[j] = acc;
+            }
+          }
+        }
+      }
+    });
+
+    return output;
+  }
+};
+
+static auto registry =
+    torch::RegisterOperators()
+        .op("sparse::linear_bsr_prepack(Tensor W, Tensor? B=None, int block_size=16) -> Tensor W_prepack",
+            torch::RegisterOperators::options().kernel<BSRLinearPrepack>(
+                TensorTypeId::CPUTensorId))
+        .op("sparse::linear_bsr(Tensor X, Tensor W_prepack) -> Tensor Y",
+            torch::RegisterOperators::options().kernel<BSRLinear>(
+                TensorTypeId::CPUTensorId));
+
+} // namespace
+} // namespace native
+} // namespace at
+
+CAFFE_KNOWN_TYPE(at::native::BSRLinearWeight);
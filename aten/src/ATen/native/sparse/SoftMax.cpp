@@ -0,0 +1,333 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/SparseTensorUtils.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/WrapDimUtils.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace at { namespace native {
+
+using namespace at::sparse;
+
+// Softmax over the nonzeros of each row of a sparse matrix.
+//
+// Graph-attention models need exactly this: normalizing the per-edge
+// scores of every node without materializing the O(N^2) dense score
+// matrix.  The kernels below are segmented by row -- a row-pointer table
+// locates each row's run of values, rows are distributed across threads,
+// and the max/exp/sum within a run is vectorized -- so both time and
+// memory scale with nnz.  Absent entries are treated as -inf (they get
+// zero weight), not as zeros; this is the masked-attention reading of
+// sparsity, and it is what keeps the result sparse.
+
+namespace {
+
+// out[i] = exp(in[i] - max(in)) / sum(exp(in - max(in))) over one row's run.
+template <typename scalar_t>
+void row_softmax(const scalar_t* in, scalar_t* out, int64_t n) {
+  using Vec = vec256::Vec256<scalar_t>;
+  scalar_t max_val = std::numeric_limits<scalar_t>::lowest();
+  int64_t i = 0;
+  if (n >= Vec::size()) {
+    Vec vmax = Vec::loadu(in);
+    for (i = Vec::size(); i + Vec::size() <= n; i += Vec::size()) {
+      vmax = vec256::maximum(vmax, Vec::loadu(in + i));
+    }
+    scalar_t lanes[Vec::size()];
+    vmax.store(lanes);
+    for (int64_t j = 0; j < Vec::size(); j++) {
+      max_val = std::max(max_val, lanes[j]);
+    }
+  }
+  for (; i < n; i++) {
+    max_val = std::max(max_val, in[i]);
+  }
+
+  Vec vsum(static_cast<scalar_t>(0));
+  const Vec vmax_b(max_val);
+  scalar_t sum = 0;
+  for (i = 0; i + Vec::size() <= n; i += Vec::size()) {
+    Vec e = (Vec::loadu(in + i) - vmax_b).exp();
+    e.store(out + i);
+    vsum = vsum + e;
+  }
+  scalar_t lanes[Vec::size()];
+  vsum.store(lanes);
+  for (int64_t j = 0; j < Vec::size(); j++) {
+    sum += lanes[j];
+  }
+  for (; i < n; i++) {
+    out[i] = std::exp(in[i] - max_val);
+    sum += out[i];
+  }
+
+  const Vec vinv(static_cast<scalar_t>(1) / sum);
+  for (i = 0; i + Vec::size() <= n; i += Vec::size()) {
+    (Vec::loadu(out + i) * vinv).store(out + i);
+  }
+  for (; i < n; i++) {
+    out[i] /= sum;
+  }
+}
+
+// grad_in[i] = out[i] * (grad[i] - dot(grad, out)) over one row's run.
+template <typename scalar_t>
+void row_softmax_backward(
+    const scalar_t* grad,
+    const scalar_t* out,
+    scalar_t* grad_in,
+    int64_t n) {
+  using Vec = vec256::Vec256<scalar_t>;
+  Vec vdot(static_cast<scalar_t>(0));
+  scalar_t dot = 0;
+  int64_t i = 0;
+  for (; i + Vec::size() <= n; i += Vec::size()) {
+    vdot = vec256::fmadd(Vec::loadu(grad + i), Vec::loadu(out + i), vdot);
+  }
+  scalar_t lanes[Vec::size()];
+  vdot.store(lanes);
+  for (int64_t j = 0; j < Vec::size(); j++) {
+    dot += lanes[j];
+  }
+  for (; i < n; i++) {
+    dot += grad[i] * out[i];
+  }
+
+  const Vec vdot_b(dot);
+  for (i = 0; i + Vec::size() <= n; i += Vec::size()) {
+    ((Vec::loadu(grad + i) - vdot_b) * Vec::loadu(out + i)).store(grad_in + i);
+  }
+  for (; i < n; i++) {
+    grad_in[i] = (grad[i] - dot) * out[i];
+  }
+}
+
+// Row pointers for a coalesced 2-d COO tensor (rows are sorted, so one
+// counting pass suffices).
+std::vector<int64_t> coo_row_ptr(const LongTensor& indices, int64_t nrows, int64_t nnz) {
+  std::vector<int64_t> row_ptr(nrows + 1, 0);
+  auto indices_accessor = indices.accessor<int64_t, 2>();
+  for (int64_t i = 0; i < nnz; i++) {
+    row_ptr[indices_accessor[0][i] + 1]++;
+  }
+  std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+  return row_ptr;
+}
+
+int64_t check_softmax_dim(const char* name, int64_t dim, int64_t ndim) {
+  int64_t d = maybe_wrap_dim(dim, ndim);
+  TORCH_CHECK(d == ndim - 1,
+      name, ": only softmax over the last dimension is supported, got dim ", dim);
+  return d;
+}
+
+// Shared segmented driver: `row_ptr` has nrows + 1 entries and `fn` is
+// called with (values offset, run length) for each nonempty row.
+template <typename F>
+void foreach_row(const std::vector<int64_t>& row_ptr, int64_t nnz, const F& fn) {
+  const int64_t nrows = static_cast<int64_t>(row_ptr.size()) - 1;
+  const int64_t grain_size = std::max((int64_t)1,
+      at::internal::GRAIN_SIZE * nrows / std::max((int64_t)1, nnz));
+  at::parallel_for(0, nrows, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t r = start; r < end; r++) {
+      const int64_t len = row_ptr[r + 1] - row_ptr[r];
+      if (len > 0) {
+        fn(row_ptr[r], len);
+      }
+    }
+  });
+}
+
+} // namespace
+
+Tensor softmax_sparse_cpu(const Tensor& self, int64_t dim) {
+  TORCH_CHECK(self.is_sparse(), "_sparse_softmax: expected a sparse tensor");
+  TORCH_CHECK(self.sparse_dim() == 2 && self.dense_dim() == 0,
+      "_sparse_softmax: expected a 2-d sparse matrix with scalar values, but got ",
+      self.sparse_dim(), " sparse and ", self.dense_dim(), " dense dimensions");
+  check_softmax_dim("_sparse_softmax", dim, 2);
+
+  SparseTensor input = self.coalesce();
+  const int64_t nnz = input._nnz();
+  if (nnz == 0) {
+    return input.clone();
+  }
+  Tensor values = input._values().contiguous();
+  // NB: promotes int32 indices for the row-pointer pass; the result
+  // shares the input's (possibly int32) indices.
+  auto row_ptr = coo_row_ptr(long_indices(input), input.size(0), nnz);
+
+  Tensor out_values = at::empty_like(values);
+  AT_DISPATCH_FLOATING_TYPES(values.scalar_type(), "sparse_softmax", [&] {
+    const scalar_t* in_ptr = values.data_ptr<scalar_t>();
+    scalar_t* out_ptr = out_values.data_ptr<scalar_t>();
+    foreach_row(row_ptr, nnz, [&](int64_t offset, int64_t len) {
+      row_softmax<scalar_t>(in_ptr + offset, out_ptr + offset, len);
+    });
+  });
+
+  Tensor result = at::_sparse_coo_tensor_unsafe(
+      input._indices(), out_values, input.sizes(), input.options());
+  result._coalesced_(true);
+  return result;
+}
+
+Tensor softmax_backward_sparse_cpu(
+    const Tensor& grad_,
+    const Tensor& output_,
+    int64_t dim) {
+  TORCH_CHECK(grad_.is_sparse() && output_.is_sparse(),
+      "_sparse_softmax_backward_data: expected sparse tensors");
+  TORCH_CHECK(grad_.sizes().equals(output_.sizes()),
+      "_sparse_softmax_backward_data: grad and output sizes must match, but got ",
+      grad_.sizes(), " and ", output_.sizes());
+  check_softmax_dim("_sparse_softmax_backward_data", dim, 2);
+
+  SparseTensor grad = grad_.coalesce();
+  SparseTensor output = output_.coalesce();
+  const int64_t nnz = output._nnz();
+  if (nnz == 0) {
+    return output.clone();
+  }
+  // The gradient must live on the output's sparsity pattern: softmax only
+  // produced values there, so a mismatch means the graph upstream went
+  // through a densifying op.
+  TORCH_CHECK(grad._nnz() == nnz &&
+          long_indices(grad).equal(long_indices(output)),
+      "_sparse_softmax_backward_data: grad and output must have the same "
+      "sparsity pattern");
+
+  Tensor grad_values = grad._values().contiguous();
+  Tensor out_values = output._values().contiguous();
+  auto row_ptr = coo_row_ptr(long_indices(output), output.size(0), nnz);
+
+  Tensor grad_in_values = at::empty_like(out_values);
+  AT_DISPATCH_FLOATING_TYPES(out_values.scalar_type(), "sparse_softmax_backward", [&] {
+    const scalar_t* grad_ptr = grad_values.data_ptr<scalar_t>();
+    const scalar_t* out_ptr = out_values.data_ptr<scalar_t>();
+    scalar_t* grad_in_ptr = grad_in_values.data_ptr<scalar_t>();
+    foreach_row(row_ptr, nnz, [&](int64_t offset, int64_t len) {
+      row_softmax_backward<scalar_t>(
+          grad_ptr + offset, out_ptr + offset, grad_in_ptr + offset, len);
+    });
+  });
+
+  Tensor result = at::_sparse_coo_tensor_unsafe(
+      output._indices(), grad_in_values, output.sizes(), output.options());
+  result._coalesced_(true);
+  return result;
+}
+
+namespace {
+
+// CSR inputs already carry the row-pointer table, so the kernels are the
+// same segmented loops minus the counting pass.
+
+Tensor softmax_sparse_csr_cpu(const Tensor& self, int64_t dim) {
+  TORCH_CHECK(self.is_sparse_csr(),
+      "_sparse_softmax: expected a sparse CSR tensor");
+  check_softmax_dim("_sparse_softmax", dim, 2);
+
+  auto* impl = get_sparse_csr_impl(self);
+  Tensor crow_indices = impl->crow_indices();
+  Tensor values = impl->values().contiguous();
+  const int64_t nnz = impl->nnz();
+  const int64_t nrows = self.size(0);
+
+  Tensor out_values = at::empty_like(values);
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  AT_DISPATCH_FLOATING_TYPES(values.scalar_type(), "sparse_softmax", [&] {
+    const scalar_t* in_ptr = values.data_ptr<scalar_t>();
+    scalar_t* out_ptr = out_values.data_ptr<scalar_t>();
+    const int64_t grain_size = std::max((int64_t)1,
+        at::internal::GRAIN_SIZE * nrows / std::max((int64_t)1, nnz));
+    at::parallel_for(0, nrows, grain_size, [&](int64_t start, int64_t end) {
+      for (int64_t r = start; r < end; r++) {
+        const int64_t len = crow_accessor[r + 1] - crow_accessor[r];
+        if (len > 0) {
+          row_softmax<scalar_t>(
+              in_ptr + crow_accessor[r], out_ptr + crow_accessor[r], len);
+        }
+      }
+    });
+  });
+
+  return at::native::_sparse_csr_tensor_unsafe(
+      crow_indices, impl->col_indices(), out_values, self.sizes(),
+      self.options());
+}
+
+Tensor softmax_backward_sparse_csr_cpu(
+    const Tensor& grad,
+    const Tensor& output,
+    int64_t dim) {
+  TORCH_CHECK(grad.is_sparse_csr() && output.is_sparse_csr(),
+      "_sparse_softmax_backward_data: expected sparse CSR tensors");
+  TORCH_CHECK(grad.sizes().equals(output.sizes()),
+      "_sparse_softmax_backward_data: grad and output sizes must match, but got ",
+      grad.sizes(), " and ", output.sizes());
+  check_softmax_dim("_sparse_softmax_backward_data", dim, 2);
+
+  auto* grad_impl = get_sparse_csr_impl(grad);
+  auto* out_impl = get_sparse_csr_impl(output);
+  TORCH_CHECK(grad_impl->nnz() == out_impl->nnz() &&
+          grad_impl->crow_indices().equal(out_impl->crow_indices()) &&
+          grad_impl->col_indices().equal(out_impl->col_indices()),
+      "_sparse_softmax_backward_data: grad and output must have the same "
+      "sparsity pattern");
+
+  Tensor crow_indices = out_impl->crow_indices();
+  Tensor grad_values = grad_impl->values().contiguous();
+  Tensor out_values = out_impl->values().contiguous();
+  const int64_t nnz = out_impl->nnz();
+  const int64_t nrows = output.size(0);
+
+  Tensor grad_in_values = at::empty_like(out_values);
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  AT_DISPATCH_FLOATING_TYPES(out_values.scalar_type(), "sparse_softmax_backward", [&] {
+    const scalar_t* grad_ptr = grad_values.data_ptr<scalar_t>();
+    const scalar_t* out_ptr = out_values.data_ptr<scalar_t>();
+    scalar_t* grad_in_ptr = grad_in_values.data_ptr<scalar_t>();
+    const int64_t grain_size = std::max((int64_t)1,
+        at::internal::GRAIN_SIZE * nrows / std::max((int64_t)1, nnz));
+    at::parallel_for(0, nrows, grain_size, [&](int64_t start, int64_t end) {
+      for (int64_t r = start; r < end; r++) {
+        const int64_t len = crow_accessor[r + 1] - crow_accessor[r];
+        if (len > 0) {
+          row_softmax_backward<scalar_t>(
+              grad_ptr + crow_accessor[r], out_ptr + crow_accessor[r],
+              grad_in_ptr + crow_accessor[r], len);
+        }
+      }
+    });
+  });
+
+  return at::native::_sparse_csr_tensor_unsafe(
+      crow_indices, out_impl->col_indices(), grad_in_values, output.sizes(),
+      output.options());
+}
+
+// The codegen cannot emit per-backend wrappers for SparseCsrCPU, so the
+// CSR kernels register directly at the CSR tensor type id, like the ones
+// in SparseCsrTensorMath.cpp.
+static auto registry = torch::RegisterOperators()
+    .op("aten::_sparse_softmax(Tensor self, int dim) -> Tensor",
+        torch::RegisterOperators::options()
+            .kernel<decltype(softmax_sparse_csr_cpu), &softmax_sparse_csr_cpu>(
+                TensorTypeId::SparseCsrCPUTensorId))
+    .op("aten::_sparse_softmax_backward_data(Tensor grad_output, Tensor output, int dim) -> Tensor",
+        torch::RegisterOperators::options()
+            .kernel<decltype(softmax_backward_sparse_csr_cpu), &softmax_backward_sparse_csr_cpu>(
+                TensorTypeId::SparseCsrCPUTensorId));
+
+} // namespace
+
+}} // namespace at::native
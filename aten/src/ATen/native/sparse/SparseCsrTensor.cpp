@@ -0,0 +1,225 @@
+// Basic functions on sparse CSR tensors
+
+#include <ATen/ATen.h>
+#include <ATen/Layout.h>
+#include <ATen/Parallel.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/SparseTensorUtils.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/InitialTensorOptions.h>
+#include <ATen/core/op_registration/op_registration.h>
+
+namespace at { namespace native {
+
+using namespace at::sparse;
+
+/******************************************************************************
+ * access methods
+ ******************************************************************************/
+
+Tensor crow_indices(const Tensor& self) {
+  TORCH_CHECK(self.is_sparse_csr(),
+      "crow_indices is only defined for sparse CSR tensors, but got layout ", self.layout());
+  return get_sparse_csr_impl(self)->crow_indices().alias();
+}
+
+Tensor col_indices(const Tensor& self) {
+  TORCH_CHECK(self.is_sparse_csr(),
+      "col_indices is only defined for sparse CSR tensors, but got layout ", self.layout());
+  return get_sparse_csr_impl(self)->col_indices().alias();
+}
+
+// Registered at SparseCsrCPUTensorId for aten::values below; unlike COO
+// there is no coalescing state to check, the values are always valid.
+Tensor values_sparse_csr(const Tensor& self) {
+  return get_sparse_csr_impl(self)->values().alias();
+}
+
+/******************************************************************************
+ * creation methods
+ ******************************************************************************/
+
+namespace {
+
+Tensor new_csr_tensor(const caffe2::TypeMeta& dtype) {
+  TORCH_INTERNAL_ASSERT(impl::variable_excluded_from_dispatch());
+  return detail::make_tensor<SparseCsrTensorImpl>(
+      TensorTypeSet(TensorTypeId::SparseCsrCPUTensorId), dtype);
+}
+
+// Checks the parts of the CSR invariants that set_member_tensors_unsafe
+// deliberately skips: the row pointers must be a nondecreasing sequence
+// from 0 to nnz, and every column index must be within [0, ncols).
+void validate_sparse_csr_invariants(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size) {
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  TORCH_CHECK(crow_accessor[0] == 0,
+      "crow_indices must start with 0, but got ", crow_accessor[0]);
+  TORCH_CHECK(crow_accessor[size[0]] == values.size(0),
+      "last value of crow_indices must equal nnz (", values.size(0),
+      "), but got ", crow_accessor[size[0]]);
+  for (int64_t i = 0; i < size[0]; i++) {
+    TORCH_CHECK(crow_accessor[i] <= crow_accessor[i + 1],
+        "crow_indices must be nondecreasing, but got crow_indices[", i, "] = ",
+        crow_accessor[i], " > crow_indices[", i + 1, "] = ", crow_accessor[i + 1]);
+  }
+  if (col_indices.numel() > 0) {
+    int64_t min_col = col_indices.min().item<int64_t>();
+    int64_t max_col = col_indices.max().item<int64_t>();
+    TORCH_CHECK(min_col >= 0, "found negative column index ", min_col);
+    TORCH_CHECK(max_col < size[1],
+        "size is inconsistent with col_indices: number of columns is ", size[1],
+        " but found index ", max_col);
+  }
+}
+
+} // namespace
+
+Tensor _sparse_csr_tensor_unsafe(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size,
+    const TensorOptions& options) {
+  TORCH_CHECK(!options.has_layout() || options.layout() == kSparseCsr,
+      "expected sparse CSR layout, but got layout ", options.layout());
+  TORCH_CHECK(options.device().is_cpu(), "sparse CSR tensors are only supported on CPU");
+  Tensor self = new_csr_tensor(values.dtype());
+  alias_into_sparse_csr(self, crow_indices.contiguous(), col_indices.contiguous(), values.contiguous(), size);
+  return self;
+}
+
+Tensor sparse_csr_tensor(
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    IntArrayRef size,
+    const TensorOptions& options) {
+  // The cheap mutual-consistency checks (dtypes, lengths, 2-dimensionality)
+  // run in set_member_tensors_unsafe; validate the semantic invariants here
+  // so user-provided indices cannot produce an out-of-bounds read later.
+  TORCH_CHECK(size.size() == 2, "CSR tensors must be 2-dimensional, but got size ", size);
+  TORCH_CHECK(crow_indices.dim() == 1 && crow_indices.size(0) == size[0] + 1,
+      "crow_indices must have nrows + 1 = ", size[0] + 1, " elements, but got: ", crow_indices.sizes());
+  auto crow_contig = crow_indices.contiguous();
+  auto col_contig = col_indices.contiguous();
+  validate_sparse_csr_invariants(crow_contig, col_contig, values, size);
+  return at::native::_sparse_csr_tensor_unsafe(crow_contig, col_contig, values, size, options);
+}
+
+/******************************************************************************
+ * conversion methods
+ ******************************************************************************/
+
+Tensor to_sparse_csr(const Tensor& self) {
+  if (self.is_sparse_csr()) {
+    return self;
+  }
+  if (self.is_sparse()) {
+    // A coalesced COO tensor has its indices sorted by row, so the row
+    // pointers can be read off with one pass over the row indices.
+    TORCH_CHECK(self.sparse_dim() == 2 && self.dense_dim() == 0,
+        "to_sparse_csr expects a 2-d sparse tensor with scalar values, but got ",
+        self.sparse_dim(), " sparse and ", self.dense_dim(), " dense dimensions");
+    Tensor coalesced = self.coalesce();
+    // NB: promotes int32 COO indices; CSR members are always int64
+    LongTensor indices = at::sparse::long_indices(coalesced);
+    int64_t nrows = self.size(0);
+    int64_t nnz = coalesced._nnz();
+    LongTensor crow_indices = at::zeros({nrows + 1}, indices.options());
+    auto row_accessor = indices.accessor<int64_t, 2>();
+    auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+    for (int64_t i = 0; i < nnz; i++) {
+      crow_accessor[row_accessor[0][i] + 1]++;
+    }
+    for (int64_t r = 0; r < nrows; r++) {
+      crow_accessor[r + 1] += crow_accessor[r];
+    }
+    return at::native::_sparse_csr_tensor_unsafe(
+        crow_indices,
+        indices.select(0, 1).contiguous(),
+        coalesced._values(),
+        self.sizes(),
+        self.options().layout(kSparseCsr));
+  }
+  TORCH_CHECK(self.layout() == kStrided,
+      "to_sparse_csr is not supported for tensors of layout ", self.layout());
+  TORCH_CHECK(self.dim() == 2, "to_sparse_csr expects a 2-d tensor, but got ", self.dim(), "-d");
+  Tensor contig = self.contiguous();
+  int64_t nrows = contig.size(0);
+  int64_t ncols = contig.size(1);
+  LongTensor crow_indices = at::zeros({nrows + 1}, contig.options().dtype(kLong));
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  std::vector<int64_t> col_vec;
+  Tensor values;
+  AT_DISPATCH_ALL_TYPES(contig.scalar_type(), "to_sparse_csr", [&] {
+    const scalar_t* data = contig.data_ptr<scalar_t>();
+    std::vector<scalar_t> values_vec;
+    for (int64_t r = 0; r < nrows; r++) {
+      for (int64_t c = 0; c < ncols; c++) {
+        scalar_t v = data[r * ncols + c];
+        if (v != scalar_t(0)) {
+          col_vec.push_back(c);
+          values_vec.push_back(v);
+        }
+      }
+      crow_accessor[r + 1] = static_cast<int64_t>(col_vec.size());
+    }
+    values = at::empty({static_cast<int64_t>(values_vec.size())}, contig.options());
+    std::copy(values_vec.begin(), values_vec.end(), values.data_ptr<scalar_t>());
+  });
+  LongTensor col_indices = at::empty({static_cast<int64_t>(col_vec.size())}, crow_indices.options());
+  std::copy(col_vec.begin(), col_vec.end(), col_indices.data_ptr<int64_t>());
+  return at::native::_sparse_csr_tensor_unsafe(
+      crow_indices, col_indices, values, contig.sizes(), contig.options().layout(kSparseCsr));
+}
+
+Tensor sparse_csr_to_dense(const Tensor& self) {
+  Tensor dense = at::zeros(self.sizes(), self.options().layout(kStrided));
+  auto* impl = get_sparse_csr_impl(self);
+  Tensor crow_indices = impl->crow_indices();
+  Tensor col_indices = impl->col_indices();
+  Tensor values = impl->values();
+  int64_t nrows = self.size(0);
+  int64_t ncols = self.size(1);
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  auto col_accessor = col_indices.accessor<int64_t, 1>();
+  AT_DISPATCH_ALL_TYPES(values.scalar_type(), "sparse_csr_to_dense", [&] {
+    const scalar_t* values_ptr = values.data_ptr<scalar_t>();
+    scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+    at::parallel_for(0, nrows, 0, [&](int64_t start, int64_t end) {
+      for (int64_t r = start; r < end; r++) {
+        scalar_t* dense_row = dense_ptr + r * ncols;
+        for (int64_t i = crow_accessor[r]; i < crow_accessor[r + 1]; i++) {
+          // += rather than =: duplicate column entries within a row are not
+          // forbidden by the invariants, and summing matches COO to_dense.
+          dense_row[col_accessor[i]] += values_ptr[i];
+        }
+      }
+    });
+  });
+  return dense;
+}
+
+namespace {
+
+// The codegen cannot emit per-backend wrappers for SparseCsrCPU, so the CSR
+// kernels for existing schemas are registered directly at the CSR tensor
+// type id (the same open-registration route out-of-tree backends use).
+static auto registry = torch::RegisterOperators()
+    .op("aten::to_dense(Tensor self) -> Tensor",
+        torch::RegisterOperators::options()
+            .kernel<decltype(sparse_csr_to_dense), &sparse_csr_to_dense>(
+                TensorTypeId::SparseCsrCPUTensorId))
+    .op("aten::values(Tensor(a) self) -> Tensor(a)",
+        torch::RegisterOperators::options()
+            .impl_unboxedOnlyKernel<decltype(values_sparse_csr), &values_sparse_csr>(
+                TensorTypeId::SparseCsrCPUTensorId));
+
+} // namespace
+
+}} // namespace at::native
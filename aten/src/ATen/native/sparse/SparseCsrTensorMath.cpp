@@ -0,0 +1,178 @@
+// CSR matrix multiplication kernels (addmm, addmv)
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/SparseCsrTensorImpl.h>
+#include <ATen/SparseCsrTensorUtils.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/core/op_registration/op_registration.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+
+namespace at { namespace native {
+
+using namespace at::sparse;
+
+namespace {
+
+// y += a * x over unit-stride rows; same vectorized body as the COO CSR
+// engine in SparseTensorMath.cpp.
+template <typename scalar_t>
+inline void csr_dense_row_axpy(int64_t n, scalar_t a, const scalar_t* x, scalar_t* y) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const Vec a_vec(a);
+  int64_t j = 0;
+  for (; j + Vec::size() <= n; j += Vec::size()) {
+    vec256::fmadd(a_vec, Vec::loadu(x + j), Vec::loadu(y + j)).store(y + j);
+  }
+  for (; j < n; j++) {
+    y[j] += a * x[j];
+  }
+}
+
+// Writes beta * t into r; shared prologue of the addmm/addmv kernels.
+void init_result_with_beta(Tensor& r, const Tensor& t, Scalar beta) {
+  if (beta.toDouble() == 0) {
+    r.zero_();
+  } else if (beta.toDouble() == 1) {
+    r.copy_(t.expand_as(r));
+  } else {
+    at::mul_out(r, t.expand_as(r), scalar_to_tensor(beta));
+  }
+}
+
+// CSR x dense: the row structure is explicit, so each output row is
+// produced by exactly one thread with no sorting, conversion or atomics.
+// r, t and dense must have unit-stride rows (r is freshly allocated and
+// dense comes in contiguous).
+template <typename scalar_t>
+void addmm_sparse_csr_dense_worker(
+    int64_t nrows,
+    int64_t dense_cols,
+    Tensor& r,
+    Scalar alpha,
+    const Tensor& crow_indices,
+    const Tensor& col_indices,
+    const Tensor& values,
+    const Tensor& dense) {
+  scalar_t cast_alpha = alpha.to<scalar_t>();
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  auto col_accessor = col_indices.accessor<int64_t, 1>();
+  auto values_accessor = values.accessor<scalar_t, 1>();
+  const scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+  scalar_t* r_ptr = r.data_ptr<scalar_t>();
+
+  int64_t dense_stride0 = dense.stride(0);
+  int64_t r_stride0 = r.stride(0);
+  int64_t nnz = values.size(0);
+  int64_t grain_size = std::max((int64_t)1,
+      at::internal::GRAIN_SIZE * nrows / std::max((int64_t)1, nnz * dense_cols));
+  at::parallel_for(0, nrows, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t row = start; row < end; row++) {
+      scalar_t* r_row = r_ptr + row * r_stride0;
+      for (int64_t i = crow_accessor[row]; i < crow_accessor[row + 1]; i++) {
+        csr_dense_row_axpy<scalar_t>(dense_cols,
+            cast_alpha * values_accessor[i],
+            dense_ptr + col_accessor[i] * dense_stride0,
+            r_row);
+      }
+    }
+  });
+}
+
+Tensor addmm_sparse_csr_dense_cpu(
+    const Tensor& self,
+    const Tensor& mat1,
+    const Tensor& mat2,
+    Scalar beta,
+    Scalar alpha) {
+  TORCH_CHECK(mat1.is_sparse_csr(),
+      "addmm: expected mat1 to be a sparse CSR matrix, but got layout ", mat1.layout());
+  TORCH_CHECK(mat2.layout() == kStrided && mat2.dim() == 2,
+      "addmm: expected mat2 to be a strided matrix, but got layout ", mat2.layout());
+  TORCH_CHECK(mat2.device().is_cpu(), "addmm: expected mat2 to be a CPU tensor");
+  TORCH_CHECK(mat1.size(1) == mat2.size(0),
+      "addmm: mat1 and mat2 shapes cannot be multiplied (", mat1.size(0), "x", mat1.size(1),
+      " and ", mat2.size(0), "x", mat2.size(1), ")");
+  TORCH_CHECK(mat1.scalar_type() == mat2.scalar_type() && mat1.scalar_type() == self.scalar_type(),
+      "addmm: expected all operands to have the same dtype, but got ",
+      self.scalar_type(), ", ", mat1.scalar_type(), " and ", mat2.scalar_type());
+
+  auto* impl = get_sparse_csr_impl(mat1);
+  Tensor dense = mat2.contiguous();
+  Tensor r = at::empty({mat1.size(0), mat2.size(1)}, dense.options());
+  init_result_with_beta(r, self, beta);
+  AT_DISPATCH_ALL_TYPES(r.scalar_type(), "addmm_sparse_csr_dense", [&] {
+    addmm_sparse_csr_dense_worker<scalar_t>(
+        mat1.size(0), mat2.size(1), r, alpha,
+        impl->crow_indices(), impl->col_indices(), impl->values(), dense);
+  });
+  return r;
+}
+
+Tensor addmv_sparse_csr_cpu(
+    const Tensor& self,
+    const Tensor& mat,
+    const Tensor& vec,
+    Scalar beta,
+    Scalar alpha) {
+  TORCH_CHECK(mat.is_sparse_csr(),
+      "addmv: expected mat to be a sparse CSR matrix, but got layout ", mat.layout());
+  TORCH_CHECK(vec.layout() == kStrided && vec.dim() == 1,
+      "addmv: expected vec to be a strided vector, but got layout ", vec.layout());
+  TORCH_CHECK(vec.device().is_cpu(), "addmv: expected vec to be a CPU tensor");
+  TORCH_CHECK(mat.size(1) == vec.size(0),
+      "addmv: mat and vec shapes cannot be multiplied (", mat.size(0), "x", mat.size(1),
+      " and ", vec.size(0), ")");
+  TORCH_CHECK(mat.scalar_type() == vec.scalar_type() && mat.scalar_type() == self.scalar_type(),
+      "addmv: expected all operands to have the same dtype, but got ",
+      self.scalar_type(), ", ", mat.scalar_type(), " and ", vec.scalar_type());
+
+  auto* impl = get_sparse_csr_impl(mat);
+  Tensor vec_contig = vec.contiguous();
+  Tensor r = at::empty({mat.size(0)}, vec_contig.options());
+  init_result_with_beta(r, self, beta);
+  Tensor crow_indices = impl->crow_indices();
+  Tensor col_indices = impl->col_indices();
+  Tensor values = impl->values();
+  auto crow_accessor = crow_indices.accessor<int64_t, 1>();
+  auto col_accessor = col_indices.accessor<int64_t, 1>();
+  int64_t nrows = mat.size(0);
+  int64_t nnz = values.size(0);
+  AT_DISPATCH_ALL_TYPES(r.scalar_type(), "addmv_sparse_csr", [&] {
+    scalar_t cast_alpha = alpha.to<scalar_t>();
+    auto values_accessor = values.accessor<scalar_t, 1>();
+    const scalar_t* vec_ptr = vec_contig.data_ptr<scalar_t>();
+    scalar_t* r_ptr = r.data_ptr<scalar_t>();
+    int64_t grain_size = std::max((int64_t)1,
+        at::internal::GRAIN_SIZE * nrows / std::max((int64_t)1, nnz));
+    at::parallel_for(0, nrows, grain_size, [&](int64_t start, int64_t end) {
+      for (int64_t row = start; row < end; row++) {
+        scalar_t sum = 0;
+        for (int64_t i = crow_accessor[row]; i < crow_accessor[row + 1]; i++) {
+          sum += values_accessor[i] * vec_ptr[col_accessor[i]];
+        }
+        r_ptr[row] += cast_alpha * sum;
+      }
+    });
+  });
+  return r;
+}
+
+// See the note in SparseCsrTensor.cpp: the codegen cannot emit per-backend
+// wrappers for SparseCsrCPU, so these kernels register directly at the CSR
+// tensor type id.
+static auto registry = torch::RegisterOperators()
+    .op("aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1) -> Tensor",
+        torch::RegisterOperators::options()
+            .kernel<decltype(addmm_sparse_csr_dense_cpu), &addmm_sparse_csr_dense_cpu>(
+                TensorTypeId::SparseCsrCPUTensorId))
+    .op("aten::addmv(Tensor self, Tensor mat, Tensor vec, *, Scalar beta=1, Scalar alpha=1) -> Tensor",
+        torch::RegisterOperators::options()
+            .kernel<decltype(addmv_sparse_csr_cpu), &addmv_sparse_csr_cpu>(
+                TensorTypeId::SparseCsrCPUTensorId));
+
+} // namespace
+
+}} // namespace at::native
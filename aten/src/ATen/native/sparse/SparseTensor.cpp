@@ -7,9 +7,17 @@
 #include <ATen/NativeFunctions.h>
 #include <ATen/InitialTensorOptions.h>
 #include <ATen/SparseTensorUtils.h>
+#include <ATen/native/RadixSortUtils.h>
+#include <ATen/native/sparse/SparseWorkspace.h>
 
 #include <TH/THBlasUtils.h>
 
+#include <ATen/cpu/vec256/vec256.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 namespace at { namespace native {
 
 using namespace at::sparse;
@@ -163,8 +171,9 @@ Tensor sparse_coo_tensor(const Tensor& indices, const Tensor& values_, const Ten
     LongTensor min_indices = std::get</* values */ 0>(indices.min(/* dim */ 1, /* keepdim */ false));
     LongTensor computed_indices_sizes = std::get</* values */ 0>(indices.max(/* dim */ 1, /* keepdim */ false));
     computed_indices_sizes.add_(1); // len = max_index + 1
-    LongTensor cpu_min_indices = min_indices.to(at::DeviceType::CPU);
-    LongTensor cpu_computed_indices_sizes = computed_indices_sizes.to(at::DeviceType::CPU);
+    // NB: promote to int64 so the accessors below work for int32 indices too
+    LongTensor cpu_min_indices = min_indices.to(at::DeviceType::CPU).to(kLong);
+    LongTensor cpu_computed_indices_sizes = computed_indices_sizes.to(at::DeviceType::CPU).to(kLong);
     auto cpu_min_indices_accessor = cpu_min_indices.accessor<int64_t, 1>();
     auto cpu_computed_indices_sizes_accessor = cpu_computed_indices_sizes.accessor<int64_t, 1>();
     for (int64_t d = 0; d < sparse_dim; d++) {
@@ -216,6 +225,9 @@ Tensor sparse_coo_tensor(const Tensor& indices, const Tensor& values_, ArrayRef<
       cpu_min_indices = min_indices;
       cpu_max_indices = max_indices;
     }
+    // NB: promote to int64 so the accessors below work for int32 indices too
+    cpu_min_indices = cpu_min_indices.to(kLong);
+    cpu_max_indices = cpu_max_indices.to(kLong);
     auto cpu_min_indices_accessor = cpu_min_indices.accessor<int64_t, 1>();
     auto cpu_max_indices_accessor = cpu_max_indices.accessor<int64_t, 1>();
     for (int64_t d = 0; d < sparse_dim; d++) {
@@ -352,6 +364,12 @@ SparseTensor& copy_sparse_(SparseTensor& self, const SparseTensor& src, bool non
   return self._coalesced_(src.is_coalesced());
 }
 
+// The parallel coalesce path below is a sort of the flattened indices
+// followed by a segmented reduction of duplicates; both stages come from
+// RadixSortUtils.h, which also backs embedding_dense_backward and
+// index_add_. The sort is a radix sort because the keys are nonnegative
+// integers bounded by the product of the sparse dimension sizes.
+
 SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
   AT_ASSERT(self.defined());
   AT_ASSERT(!self.is_variable());  // TODO: change this to check `.requires_grad()` and `GradMode::is_enabled()` when Variable and Tensor are merged
@@ -383,16 +401,91 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
   Tensor newValues = at::empty(values.sizes(), values.options());
   alias_into_sparse(dst, newIndices, newValues);
 
+  // Parallel path: radix-sort the flattened indices across threads, find
+  // duplicate runs with a parallel segmented scan, and let each thread own
+  // a disjoint range of output rows so values accumulate without atomics.
+  // Small tensors keep the serial sort below, whose constant factor is
+  // lower.
+  if (nnz >= at::internal::GRAIN_SIZE && at::get_num_threads() > 1) {
+    // flatten_indices produces keys in [0, prod(sparse sizes)), so the
+    // radix passes stop at the highest byte that bound can reach.
+    int64_t key_bound = 1;
+    for (int64_t d = 0; d < sparse_dim; d++) {
+      key_bound *= self.size(d);
+    }
+    // The sort keys, permutation, ping-pong scratch and segment table are
+    // leased from the sparse buffer pool, so repeated coalesces recycle the
+    // same storage instead of churning the heap once per call.
+    LongTensor keys_tensor = lease_sparse_buffer({nnz}, indices_scalar.options());
+    LongTensor positions_tensor = lease_sparse_buffer({nnz}, indices_scalar.options());
+    LongTensor keys_scratch = lease_sparse_buffer({nnz}, indices_scalar.options());
+    LongTensor positions_scratch = lease_sparse_buffer({nnz}, indices_scalar.options());
+    LongTensor starts_tensor = lease_sparse_buffer({nnz + 1}, indices_scalar.options());
+    int64_t* keys = keys_tensor.data_ptr<int64_t>();
+    int64_t* positions = positions_tensor.data_ptr<int64_t>();
+    const int64_t* flat_ptr = indices_scalar.data_ptr<int64_t>();
+    at::parallel_for(0, nnz, internal::GRAIN_SIZE, [&](int64_t start, int64_t end) {
+      for (int64_t j = start; j < end; j++) {
+        keys[j] = flat_ptr[j];
+        positions[j] = j;
+      }
+    });
+    radix_sort_pairs_parallel(keys, positions, nnz, key_bound - 1,
+        keys_scratch.data_ptr<int64_t>(), positions_scratch.data_ptr<int64_t>());
+    const int64_t* starts = starts_tensor.data_ptr<int64_t>();
+    const int64_t n_unique = segment_starts_parallel(
+        keys, nnz, starts_tensor.data_ptr<int64_t>());
+
+    AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "coalesce_indices", [&] {
+      auto newIndicesAccessor = newIndices.accessor<index_t, 2>();
+      auto indicesAccessor = indices.accessor<index_t, 2>();
+      AT_DISPATCH_ALL_TYPES(
+        values.scalar_type(), "coalesce", [&] {
+          int64_t blockSize = values.stride(0);
+          scalar_t* values_ptr = values.data_ptr<scalar_t>();
+          scalar_t* newValues_ptr = newValues.data_ptr<scalar_t>();
+          int64_t grain_size = std::max((int64_t)1,
+              at::internal::GRAIN_SIZE / std::max((int64_t)1, blockSize));
+          at::parallel_for(0, n_unique, grain_size, [&](int64_t seg_begin, int64_t seg_end) {
+            for (int64_t s = seg_begin; s < seg_end; s++) {
+              int64_t first = starts[s];
+              int64_t pos = positions[first];
+              for (int64_t d = 0; d < sparse_dim; d++) {
+                newIndicesAccessor[d][s] = indicesAccessor[d][pos];
+              }
+              if (values.numel() > 0) {  // if values is an empty tensor, there are no elements to copy
+                std::copy(values_ptr + pos * blockSize,
+                          values_ptr + (pos + 1) * blockSize,
+                          newValues_ptr + s * blockSize);
+                for (int64_t j = first + 1; j < starts[s + 1]; j++) {
+                  accumulate_values_row<scalar_t>(blockSize,
+                      values_ptr + positions[j] * blockSize,
+                      newValues_ptr + s * blockSize);
+                }
+              }
+            }
+          });
+      });
+    });
+
+    dst._coalesced_(true);
+    get_sparse_impl(dst)->set_nnz_and_narrow(n_unique);
+    return dst;
+  }
+
   LongTensor indicesBuffer;
   LongTensor indicesPermutation;
   std::tie(indicesBuffer, indicesPermutation) = indices_scalar.sort(0);
   // NB: The accessor accesses here rely on self._nnz() > 0 (tested earlier in this function)
-  auto newIndicesAccessor = newIndices.accessor<int64_t, 2>();
-  auto indicesAccessor = indices.accessor<int64_t, 2>();
+  // NB: the flattened keys (indicesBuffer/indicesPermutation) are always
+  // int64; only the 2-d indices tensors carry the caller's index dtype.
   auto indicesPermutationAccessor = indicesPermutation.accessor<int64_t, 1>();
   auto indicesBufferAccessor = indicesBuffer.accessor<int64_t, 1>();
 
   int64_t i = -1;
+  AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "coalesce_indices", [&] {
+  auto newIndicesAccessor = newIndices.accessor<index_t, 2>();
+  auto indicesAccessor = indices.accessor<index_t, 2>();
   AT_DISPATCH_ALL_TYPES(
       values.scalar_type(), "coalesce", [&] {
         int64_t prev = -1;
@@ -418,6 +511,7 @@ SparseTensor coalesce_sparse_cpu(const SparseTensor& self) {
           prev = curr;
         }
     });
+  });
 
   dst._coalesced_(true);
   get_sparse_impl(dst)->set_nnz_and_narrow(i + 1);
@@ -469,7 +563,9 @@ SparseTensor& sparse_mask_out_cpu(SparseTensor& r, const Tensor& t, const Sparse
   }
   int64_t dim = t.dim();
   int64_t sparse_dim = mask.sparse_dim();
-  LongTensor mask_indices = mask._indices();
+  // NB: promotes int32 mask indices; the kernel accessors and the
+  // index_select below want int64.
+  LongTensor mask_indices = long_indices(mask);
   Tensor mask_values = mask._values();
   Tensor r_values = at::empty(mask_values.sizes(), r._values().options());
   alias_into_sparse(r, mask_indices.clone(), r_values);
@@ -485,7 +581,11 @@ SparseTensor& sparse_mask_out_cpu(SparseTensor& r, const Tensor& t, const Sparse
 
     // Get a flattened sparse indices, similar to NOTE [ Flatten Sparse Indices ].
     // Keeping this implementation because it is faster than flatten_indices()
-    LongTensor indices = at::zeros({mask._nnz()}, mask_indices.options());
+    // NB: leased from the sparse buffer pool -- this flattened key vector
+    // is dropped before the function returns.
+    LongTensor indices =
+        lease_sparse_buffer({mask._nnz()}, mask_indices.options());
+    indices.zero_();
     for (int64_t d = 0; d < mask.sparse_dim(); d++) {
       indices.mul_(mask.size(d));
       indices.add_(mask_indices.select(0, d));
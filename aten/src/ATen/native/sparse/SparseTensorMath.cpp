@@ -8,9 +8,13 @@
 #include <ATen/InitialTensorOptions.h>
 #include <ATen/SparseTensorUtils.h>
 #include <ATen/WrapDimUtilsMulti.h>
+#include <ATen/cpu/vec256/vec256.h>
 
 #include <TH/THBlasUtils.h>
 
+#include <algorithm>
+#include <mutex>
+
 namespace at { namespace native {
 
 using namespace at::sparse;
@@ -19,7 +23,8 @@ using namespace at::sparse;
 // --------------------------------------------------------------------
 
 namespace {
-  LongTensor _to_csr(const int64_t* indices, int64_t dim, int64_t nnz) {
+  template <typename index_t>
+  LongTensor _to_csr(const index_t* indices, int64_t dim, int64_t nnz) {
     LongTensor csr = native::zeros({dim + 1}, kLong);
 
     // TODO: eliminate this conditional when zero-size dims supported correctly
@@ -40,6 +45,82 @@ namespace {
     return csr;
   }
 
+  // Returns the CSR row pointers for a coalesced 2-d `sparse`, reusing the
+  // table cached on its SparseTensorImpl when the indices are unchanged
+  // since it was built (repeated multiplies skip the conversion entirely).
+  LongTensor _to_csr_cached(const SparseTensor& sparse, int64_t dim) {
+    // addmm is a read-only op on `sparse` and may run concurrently on the
+    // same tensor from several threads; serialize access to the cache slots.
+    static std::mutex csr_cache_mutex;
+    auto* impl = get_sparse_impl(sparse);
+    {
+      std::lock_guard<std::mutex> guard(csr_cache_mutex);
+      LongTensor csr = impl->csr_cache();
+      if (csr.defined() && csr.size(0) == dim + 1) {
+        return csr;
+      }
+    }
+    LongTensor indices = sparse._indices();
+    LongTensor csr = AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "to_csr", [&] {
+      return _to_csr(indices.data_ptr<index_t>(), dim, sparse._nnz());
+    });
+    {
+      std::lock_guard<std::mutex> guard(csr_cache_mutex);
+      impl->set_csr_cache(csr);
+    }
+    return csr;
+  }
+
+}
+
+// Transpose of a coalesced 2-d sparse matrix with memoized structure.  The
+// sorted transposed indices, the value permutation that produces them and
+// the CSC column pointers depend only on the sparsity pattern, so they are
+// cached on the source SparseTensorImpl (keyed, like the CSR cache above,
+// on the version counter of the indices).  Repeated transposes over a
+// fixed pattern -- addmm backward on a static adjacency matrix every
+// training step -- then re-sort nothing and only permute the values.
+Tensor sparse_transpose2d_cached(const Tensor& self) {
+  TORCH_INTERNAL_ASSERT(self.is_sparse() && self.sparse_dim() == 2 &&
+      self.dense_dim() == 0 && self.is_coalesced());
+  auto* impl = get_sparse_impl(self);
+  std::vector<int64_t> out_sizes{self.size(1), self.size(0)};
+  int64_t nnz = self._nnz();
+
+  // Like the CSR cache, the slots may be probed concurrently from several
+  // backward threads reading the same tensor; serialize access to them.
+  static std::mutex transpose_cache_mutex;
+  LongTensor t_indices, perm, csc;
+  bool hit;
+  {
+    std::lock_guard<std::mutex> guard(transpose_cache_mutex);
+    hit = impl->transpose_cache(&t_indices, &perm, &csc);
+  }
+  if (!hit) {
+    LongTensor indices = long_indices(self);
+    LongTensor flipped = at::stack({indices.select(0, 1), indices.select(0, 0)});
+    // The entries of a coalesced matrix are unique, so sorting the
+    // flattened transposed keys yields coalesced order directly -- a plain
+    // sort, no duplicate merge.
+    LongTensor keys = flatten_indices(flipped, out_sizes);
+    LongTensor keysSorted;
+    std::tie(keysSorted, perm) = keys.sort(0);
+    t_indices = flipped.index_select(1, perm).contiguous();
+    csc = _to_csr(t_indices.data_ptr<int64_t>(), out_sizes[0], nnz);
+    std::lock_guard<std::mutex> guard(transpose_cache_mutex);
+    impl->set_transpose_cache(t_indices, perm, csc);
+  }
+
+  // Hand out a copy of the cached indices: transpose has always returned
+  // freshly allocated indices, and callers may mutate them in place.
+  Tensor t_values = self._values().index_select(0, perm);
+  SparseTensor r = at::_sparse_coo_tensor_unsafe(
+      t_indices.clone(), t_values, out_sizes, self.options());
+  r._coalesced_(true);
+  // Seed the result's CSR cache with the memoized column pointers, so a
+  // following sparse-dense mm skips the row-pointer build as well.
+  get_sparse_impl(r)->set_csr_cache(csc);
+  return r;
 }
 
 // --------------------------------------------------------------------
@@ -230,6 +311,55 @@ Tensor& sub_out_sparse(Tensor& r, const Tensor& self, const Tensor& other, Scala
 
 Tensor& add_out_dense_sparse_cpu(Tensor& r, const Tensor& dense, const SparseTensor& sparse_, Scalar value);
 
+// --------------------------------------------------------------------
+// add_sparse_uncoalesced(TensorList) -> SparseTensor
+//
+// Elementwise sum of same-shaped sparse tensors in deferred form: the
+// operands' index and value blocks are concatenated into one uncoalesced
+// tensor, leaving the sort/merge to the first consumer that calls
+// coalesce().  For n accumulations of b entries each this costs O(n*b)
+// total instead of the O(n^2*b) of repeated pairwise merges, which is
+// what autograd's InputBuffer needs when an embedding gradient is only
+// consumed once per step at optimizer time.
+// --------------------------------------------------------------------
+
+Tensor add_sparse_uncoalesced(TensorList tensors) {
+  TORCH_CHECK(!tensors.empty(), "add_sparse_uncoalesced: expected at least one tensor");
+  const Tensor& first = tensors[0];
+  TORCH_CHECK(first.is_sparse(), "add_sparse_uncoalesced: expected sparse tensors, but got layout ", first.layout());
+  std::vector<Tensor> indices_list;
+  std::vector<Tensor> values_list;
+  indices_list.reserve(tensors.size());
+  values_list.reserve(tensors.size());
+  bool mixed_index_types = false;
+  for (auto& t : tensors) {
+    TORCH_CHECK(t.is_sparse(), "add_sparse_uncoalesced: expected sparse tensors, but got layout ", t.layout());
+    TORCH_CHECK(t.sizes().equals(first.sizes()), "add_sparse_uncoalesced: expected all tensors to have size ",
+        first.sizes(), ", but got ", t.sizes());
+    TORCH_CHECK(is_same_density(t, first), "add_sparse_uncoalesced: expected all tensors to have ",
+        first.sparse_dim(), " sparse and ", first.dense_dim(), " dense dimensions");
+    TORCH_CHECK(t.scalar_type() == first.scalar_type() && t.device() == first.device(),
+        "add_sparse_uncoalesced: expected all tensors to be ", first.scalar_type(), " tensors on ",
+        first.device(), ", but got ", t.scalar_type(), " on ", t.device());
+    indices_list.push_back(t._indices());
+    values_list.push_back(t._values());
+    mixed_index_types |= indices_list.back().scalar_type() != indices_list.front().scalar_type();
+  }
+  if (mixed_index_types) {
+    // int32 and int64 indices can't be concatenated directly; promote once
+    for (auto& indices : indices_list) {
+      if (indices.scalar_type() != kLong) {
+        indices = indices.to(kLong);
+      }
+    }
+  }
+  LongTensor new_indices = at::cat(indices_list, 1);
+  Tensor new_values = at::cat(values_list, 0);
+  // NB: _sparse_coo_tensor_unsafe leaves the result marked uncoalesced,
+  // which is what makes the duplicates between blocks legal.
+  return at::_sparse_coo_tensor_unsafe(new_indices, new_values, first.sizes(), first.options());
+}
+
 SparseTensor& add_out_sparse_cpu(SparseTensor& r, const SparseTensor& t, const SparseTensor& src, Scalar value) {
   if (!t.is_sparse()) {
     return add_out_dense_sparse_cpu(r, t, src, value);
@@ -255,9 +385,10 @@ SparseTensor& add_out_sparse_cpu(SparseTensor& r, const SparseTensor& t, const S
   int64_t t_nnz = t._nnz(), s_nnz = src._nnz(), max_nnz = t_nnz + s_nnz;
   bool t_coalesced = t.is_coalesced(), s_coalesced = src.is_coalesced();
   int64_t sparse_dim = src.sparse_dim();
-  LongTensor t_indices = t._indices();
+  // NB: promotes int32 indices; the merge below walks int64 accessors
+  LongTensor t_indices = long_indices(t);
   Tensor t_values = t._values();
-  LongTensor src_indices = src._indices();
+  LongTensor src_indices = long_indices(src);
   Tensor s_values = src._values();
   r.resize_as_(src);
 
@@ -389,7 +520,8 @@ Tensor& add_out_dense_sparse_cpu(Tensor& r, const Tensor& dense, const SparseTen
   r.resize_as_(dense);
   SparseTensor sparse = sparse_.coalesce();
 
-  LongTensor indices = sparse._indices();
+  // NB: promotes int32 indices; the scatter below walks int64 accessors
+  LongTensor indices = long_indices(sparse);
   Tensor values = sparse._values();
   int64_t nDim = dense.dim();
   int64_t nDimI = sparse.sparse_dim();
@@ -456,9 +588,10 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
   int64_t t_nnz = t._nnz(), s_nnz = src._nnz();
   int64_t max_nnz = std::min(t_nnz, s_nnz);  // multiply by zero is zero, and can be dropped
   int64_t sparse_dim = src.sparse_dim();
-  LongTensor t_indices = t._indices();
+  // NB: promotes int32 indices; the merge below walks int64 accessors
+  LongTensor t_indices = long_indices(t);
   Tensor t_values = t._values();
-  LongTensor src_indices = src._indices();
+  LongTensor src_indices = long_indices(src);
   Tensor s_values = src._values();
   LongTensor r_indices = at::empty({sparse_dim, max_nnz}, t_indices.options());
   Tensor r_values = new_values_with_size_of(t_values, max_nnz).zero_();
@@ -533,7 +666,7 @@ SparseTensor& mul_out_sparse_cpu(SparseTensor& r, const Tensor& t_, const Tensor
 // D = beta * D1 + alpha * mm(S, D2)
 // --------------------------------------------------------------------
 
-template <typename scalar_t>
+template <typename scalar_t, typename index_t>
 void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const Tensor& indices, const Tensor& values, const Tensor& dense) {
   int64_t i;
 
@@ -550,7 +683,7 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
     at::mul_out(r, t, scalar_to_tensor(beta));
   }
 
-  auto indices_accessor = indices.accessor<int64_t, 2>();
+  auto indices_accessor = indices.accessor<index_t, 2>();
 
   auto values_accessor = values.accessor<scalar_t, 1>();
   scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
@@ -579,6 +712,68 @@ void s_addmm_out_sparse_dense_worker(int64_t nnz, int64_t dim_i, int64_t dim_j,
   }
 };
 
+// y += a * x over unit-stride rows; the vectorized body of the CSR worker.
+template <typename scalar_t>
+inline void dense_row_axpy(int64_t n, scalar_t a, const scalar_t* x, scalar_t* y) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const Vec a_vec(a);
+  int64_t j = 0;
+  for (; j + Vec::size() <= n; j += Vec::size()) {
+    vec256::fmadd(a_vec, Vec::loadu(x + j), Vec::loadu(y + j)).store(y + j);
+  }
+  for (; j < n; j++) {
+    y[j] += a * x[j];
+  }
+}
+
+// CSR variant of the worker above: each output row is produced by exactly
+// one thread, so rows parallelize without atomics. Requires a coalesced
+// sparse operand (rows sorted, so the CSR row pointers are valid) and
+// unit-stride rows in r and dense.
+template <typename scalar_t, typename index_t>
+void s_addmm_out_sparse_dense_csr_worker(int64_t dim_i, int64_t dim_j, int64_t dim_k, Tensor& r, Scalar beta, const Tensor& t, Scalar alpha, const LongTensor& csr, const Tensor& indices, const Tensor& values, const Tensor& dense) {
+  scalar_t cast_alpha = alpha.to<scalar_t>();
+  scalar_t cast_beta = beta.to<scalar_t>();
+  if (cast_beta == 0) {
+    r.zero_();
+  } else if (cast_beta == 1) {
+    if (!is_same_tensor(r, t)) {
+      r.copy_(t);
+    }
+  } else {
+    at::mul_out(r, t, scalar_to_tensor(beta));
+  }
+
+  // NB: the row-pointer table is always int64 (see _to_csr); only the
+  // column indices carry the operand's index dtype.
+  auto csr_accessor = csr.accessor<int64_t, 1>();
+  auto indices_accessor = indices.accessor<index_t, 2>();
+  auto values_accessor = values.accessor<scalar_t, 1>();
+  const scalar_t* dense_ptr = dense.data_ptr<scalar_t>();
+  scalar_t* r_ptr = r.data_ptr<scalar_t>();
+
+  int64_t dense_stride0 = dense.stride(0);
+  int64_t r_stride0 = r.stride(0);
+  int64_t nnz = values.size(0);
+  int64_t grain_size = std::max((int64_t)1,
+      at::internal::GRAIN_SIZE * dim_i / std::max((int64_t)1, nnz * dim_k));
+  at::parallel_for(0, dim_i, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t row = start; row < end; row++) {
+      scalar_t* r_row = r_ptr + row * r_stride0;
+      for (int64_t i = csr_accessor[row]; i < csr_accessor[row + 1]; i++) {
+        int64_t col = indices_accessor[1][i];
+        if (col < 0 || col >= dim_j) {
+          AT_ERROR("addmm: index out of column bound: ", col, " not between 1 and ", dim_j);
+        }
+        dense_row_axpy<scalar_t>(dim_k,
+            cast_alpha * values_accessor[i],
+            dense_ptr + col * dense_stride0,
+            r_row);
+      }
+    }
+  });
+};
+
 Tensor& s_addmm_out_sparse_dense_cpu(
     Tensor& r,
     const Tensor& t,
@@ -621,11 +816,33 @@ Tensor& s_addmm_out_sparse_dense_cpu(
   LongTensor indices = sparse_._indices();
   Tensor values      = sparse_._values();
 
-  AT_DISPATCH_ALL_TYPES(
-      values.scalar_type(), "addmm_sparse_dense", [&] {
-        s_addmm_out_sparse_dense_worker<scalar_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense);
-      }
-  );
+  // Row-parallel CSR engine for the common case: a coalesced operand (rows
+  // sorted, so the row-pointer table is valid) with in-bounds row indices
+  // and unit-stride rows on both dense tensors. Everything else keeps the
+  // serial COO worker below.
+  AT_DISPATCH_INDEX_TYPES(indices.scalar_type(), "addmm_sparse_dense_indices", [&] {
+    bool use_csr = sparse_.is_coalesced() &&
+        indices.is_contiguous() && values.is_contiguous() &&
+        dense.stride(1) == 1 && r.is_contiguous();
+    if (use_csr) {
+      auto indices_accessor = indices.accessor<index_t, 2>();
+      use_csr = indices_accessor[0][0] >= 0 && indices_accessor[0][nnz - 1] < dim_i;
+    }
+    if (use_csr) {
+      LongTensor csr = _to_csr_cached(sparse_, dim_i);
+      AT_DISPATCH_ALL_TYPES(
+          values.scalar_type(), "addmm_sparse_dense", [&] {
+            s_addmm_out_sparse_dense_csr_worker<scalar_t, index_t>(dim_i, dim_j, dim_k, r, beta, t, alpha, csr, indices, values, dense);
+          }
+      );
+    } else {
+      AT_DISPATCH_ALL_TYPES(
+          values.scalar_type(), "addmm_sparse_dense", [&] {
+            s_addmm_out_sparse_dense_worker<scalar_t, index_t>(nnz, dim_i, dim_j, dim_k, r, beta, t, alpha, indices, values, dense);
+          }
+      );
+    }
+  });
 
   return r;
 
@@ -755,6 +972,13 @@ SparseTensor& hspmm_out_sparse_cpu(SparseTensor& r, const SparseTensor& sparse_,
   // Initialize the sparse matrix that will be used with spaddmm to send rows
   // from the dense matrix to rows of the output's value tensor
   SparseTensor newSparse = sparse.clone();
+  // The loop below rewrites newSparse's row indices in place, which needs
+  // int64 storage; promote a clone's int32 indices up front.
+  if (newSparse._indices().scalar_type() != kLong) {
+    get_sparse_impl(newSparse)->set_indices_and_values_unsafe(
+        newSparse._indices().to(kLong), newSparse._values());
+    newSparse._coalesced_(true);  // promotion preserves the coalesced order
+  }
   LongTensor spIndices = newSparse._indices();
   LongTensor valueIndices = spIndices.select(0, 0);
 
@@ -837,7 +1061,9 @@ SparseTensor& _sspaddmm_out_cpu(
       "sspaddmm: Argument #1: Expected dim 1 size ", dim_k, ", got ", t.size(1));
 
   int64_t nnz        = sparse._nnz();
-  LongTensor indices = sparse._indices();
+  // NB: promotes int32 indices; the output indices and the accessors below
+  // are int64
+  LongTensor indices = long_indices(sparse);
   Tensor values      = sparse._values();
 
   LongTensor csr = _to_csr(indices.data_ptr<int64_t>(), dim_i, nnz);
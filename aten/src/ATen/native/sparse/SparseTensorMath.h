@@ -8,4 +8,16 @@ namespace at { namespace native {
 sparse::SparseTensor& mul_out_sparse_scalar(sparse::SparseTensor& r, const sparse::SparseTensor& t, Scalar value);
 sparse::SparseTensor& mul_out_sparse_zerodim(sparse::SparseTensor& r, const sparse::SparseTensor& t, const Tensor& value);
 
+// Elementwise sum of same-shaped sparse tensors without merging: the
+// operands' index and value blocks are concatenated into one uncoalesced
+// tensor, deferring the sort/merge until a consumer calls coalesce().
+// Used by autograd's InputBuffer for sparse gradient accumulation.
+CAFFE2_API Tensor add_sparse_uncoalesced(TensorList tensors);
+
+// Transpose of a coalesced 2-d sparse matrix, reusing the transpose
+// structure (index permutation and CSC column pointers) memoized on the
+// source SparseTensorImpl so a fixed sparsity pattern pays the sort once.
+// Used by at::transpose for sparse tensors.
+CAFFE2_API Tensor sparse_transpose2d_cached(const Tensor& self);
+
 }}
@@ -0,0 +1,82 @@
+#include <ATen/native/sparse/SparseWorkspace.h>
+
+#include <vector>
+
+namespace at { namespace native {
+
+namespace {
+
+// Buckets hold buffers of up to 1 << (kMinBucketLog2 + bucket) elements;
+// anything past the last bucket gets an uncached allocation. A few slots
+// per bucket cover the keys/positions/scratch quartet a coalesce keeps
+// live at once.
+constexpr size_t kMinBucketLog2 = 8;
+constexpr size_t kNumBuckets = 20; // up to 128M elements
+constexpr size_t kMaxSlotsPerBucket = 6;
+
+thread_local std::vector<Tensor> sparse_buffer_buckets[kNumBuckets];
+
+// A slot may only be handed out again once nothing outside the pool can
+// observe it; as in the conv workspace arena, the tensor use count covers
+// direct references and the storage use count covers wrappers sharing the
+// storage.
+bool slot_is_free(const Tensor& slot) {
+  return slot.use_count() == 1 && slot.storage().use_count() == 1;
+}
+
+size_t bucket_index(int64_t numel) {
+  size_t bucket = 0;
+  int64_t capacity = int64_t(1) << kMinBucketLog2;
+  while (capacity < numel && bucket + 1 < kNumBuckets) {
+    capacity <<= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+int64_t bucket_capacity(size_t bucket) {
+  return int64_t(1) << (kMinBucketLog2 + bucket);
+}
+
+} // namespace
+
+Tensor lease_sparse_buffer(IntArrayRef sizes, const TensorOptions& options) {
+  if (options.device().type() != DeviceType::CPU) {
+    return at::empty(sizes, options);
+  }
+  int64_t numel = 1;
+  for (auto s : sizes) {
+    numel *= s;
+  }
+  const size_t bucket = bucket_index(numel);
+  if (numel > bucket_capacity(bucket)) {
+    // Larger than the biggest size class; not worth pinning that much
+    // memory per thread.
+    return at::empty(sizes, options);
+  }
+  auto& slots = sparse_buffer_buckets[bucket];
+  for (auto& slot : slots) {
+    if (slot_is_free(slot) && slot.dtype() == options.dtype()) {
+      // The slot's storage was allocated at full bucket capacity, so this
+      // resize_ only rewrites the sizes -- no reallocation.
+      return slot.resize_(sizes);
+    }
+  }
+  // Allocate at bucket capacity so the storage can serve any later request
+  // of this size class, then shrink the view to what was asked for.
+  Tensor fresh = at::empty({bucket_capacity(bucket)}, options);
+  fresh.resize_(sizes);
+  for (auto& slot : slots) {
+    if (slot_is_free(slot)) {
+      // Free slot of another dtype; repurpose it rather than growing.
+      slot = fresh;
+      return fresh;
+    }
+  }
+  if (slots.size() < kMaxSlotsPerBucket) {
+    slots.push_back(fresh);
+  }
+  return fresh;
+}
+
+}} // namespace at::native
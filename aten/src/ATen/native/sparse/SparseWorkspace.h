@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ATen/ATen.h>
+
+namespace at { namespace native {
+
+// Thread-local, size-bucketed recycling pool for the short-lived auxiliary
+// buffers the sparse CPU kernels churn through (flattened keys, sort
+// permutations, radix scratch, segment tables). Workloads that coalesce and
+// accumulate sparse tensors every step -- embedding training in particular --
+// otherwise pay a malloc/free pair per temporary per iteration. Leasing
+// hands out an ordinary CPU tensor whose storage is rounded up to a
+// power-of-two element count, so a buffer returning to its bucket can be
+// resized to any request of the same class without reallocating. A leased
+// tensor that a caller keeps alive is detected through its reference counts
+// and simply skipped on the next lease, so escaping a lease is safe.
+CAFFE2_API Tensor lease_sparse_buffer(IntArrayRef sizes, const TensorOptions& options);
+
+}} // namespace at::native
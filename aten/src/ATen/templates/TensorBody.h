@@ -276,6 +276,9 @@ class CAFFE2_API Tensor {
   /// Returns if a `Tensor` has sparse backend.
   bool is_sparse() const;
 
+  /// Returns if a `Tensor` has sparse CSR backend.
+  bool is_sparse_csr() const;
+
   /// Returns if a `Tensor` is mkldnn tensor.
   bool is_mkldnn() const;
 
@@ -120,6 +120,15 @@ inline bool is_sparse(Tensor self) {
   return self.is_sparse();
 }
 
+inline bool Tensor::is_sparse_csr() const {
+  // NB: this is not a native function to avoid dispatching overhead.
+  return impl_->is_sparse_csr();
+}
+
+inline bool is_sparse_csr(Tensor self) {
+  return self.is_sparse_csr();
+}
+
 inline bool Tensor::is_mkldnn() const {
   // NB: this is not a native function to avoid dispatching overhead.
   return impl_->is_mkldnn();
@@ -3,6 +3,7 @@
 #include <ATen/ATen.h>
 #include <ATen/Utils.h>
 #include <ATen/CPUGenerator.h>
+#include <ATen/core/DistributionsHelper.h>
 #include <ATen/core/PhiloxRNGEngine.h>
 #include <thread>
 #include <limits>
@@ -120,7 +121,41 @@ TEST(CPUGenerator, TestRNGForking) {
   ASSERT_EQ(target_value.sum().item<double>(), forked_value.sum().item<double>());
 }
 
-/** 
+TEST(CPUGenerator, TestPhiloxEngineInputs) {
+  // Test Description:
+  //   Tests the offset bookkeeping used by counter-based sampling
+  //   kernels. Each call reserves [offset, offset+increment) and
+  //   reseeding restarts the offset, so seeded runs are reproducible.
+  // See Note [Acquire lock when using random generators]
+  auto gen = at::detail::createCPUGenerator();
+  std::lock_guard<std::mutex> lock(gen->mutex_);
+  gen->set_current_seed(123);
+  auto inputs1 = gen->philox_engine_inputs(4);
+  auto inputs2 = gen->philox_engine_inputs(1);
+  ASSERT_EQ(inputs1.first, 123);
+  ASSERT_EQ(inputs1.second, 0);
+  ASSERT_EQ(inputs2.first, 123);
+  ASSERT_EQ(inputs2.second, 4);
+  gen->set_current_seed(123);
+  ASSERT_EQ(gen->philox_engine_inputs(1).second, 0);
+}
+
+TEST(CPUGenerator, TestPhiloxCPUGeneratorReproducibility) {
+  // Test Description:
+  //   Tests that samples drawn through PhiloxCPUGenerator are a pure
+  //   function of (seed, subsequence, offset), which is what makes
+  //   counter-based kernels deterministic for any thread partitioning.
+  at::PhiloxCPUGenerator gen1(0, 7, 4);
+  at::PhiloxCPUGenerator gen2(0, 7, 4);
+  ASSERT_EQ(gen1.random64(), gen2.random64());
+  at::uniform_real_distribution<double> uniform(0, 1);
+  ASSERT_EQ(uniform(&gen1), uniform(&gen2));
+  // different subsequences give different streams
+  at::PhiloxCPUGenerator gen3(0, 8, 4);
+  ASSERT_NE(gen2.random(), gen3.random());
+}
+
+/**
  * Philox CPU Engine Tests
  */
 
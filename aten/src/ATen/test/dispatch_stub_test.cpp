@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+#include <algorithm>
+
+using namespace at;
+using namespace at::native;
+
+TEST(DispatchStubTest, ListsRegisteredStubs) {
+  auto names = list_dispatch_stubs();
+  ASSERT_FALSE(names.empty());
+  EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+  // add_stub is defined in BinaryOps.cpp, which is always linked in.
+  EXPECT_NE(
+      std::find(names.begin(), names.end(), "add_stub"), names.end());
+}
+
+TEST(DispatchStubTest, QueryResolvedCapability) {
+  auto& ctl = get_dispatch_stub_control("add_stub");
+  EXPECT_EQ(ctl.name(), "add_stub");
+  ASSERT_TRUE(ctl.has_cpu_kernel(CPUCapability::DEFAULT));
+  auto resolved = ctl.resolved_cpu_capability();
+  EXPECT_LE(
+      static_cast<int>(resolved), static_cast<int>(get_cpu_capability()));
+  EXPECT_TRUE(ctl.has_cpu_kernel(resolved));
+}
+
+TEST(DispatchStubTest, ForceCapabilityPerKernel) {
+  auto& ctl = get_dispatch_stub_control("add_stub");
+  ctl.force_cpu_capability(CPUCapability::DEFAULT);
+  EXPECT_EQ(ctl.resolved_cpu_capability(), CPUCapability::DEFAULT);
+
+  // Forcing one stub must not affect any other.
+  auto& other = get_dispatch_stub_control("mul_stub");
+  EXPECT_EQ(other.resolved_cpu_capability(), other.resolved_cpu_capability());
+
+  auto x = at::ones({4}, at::kFloat);
+  auto y = at::add(x, x);
+  EXPECT_TRUE(y.equal(at::full({4}, 2, at::kFloat)));
+
+  ctl.reset_cpu_capability();
+  EXPECT_LE(
+      static_cast<int>(ctl.resolved_cpu_capability()),
+      static_cast<int>(get_cpu_capability()));
+}
+
+TEST(DispatchStubTest, ForceUnavailableCapabilityThrows) {
+  auto& ctl = get_dispatch_stub_control("add_stub");
+  // NUM_OPTIONS is never a registered variant.
+  EXPECT_ANY_THROW(ctl.force_cpu_capability(CPUCapability::NUM_OPTIONS));
+  EXPECT_ANY_THROW(get_dispatch_stub_control("no_such_stub"));
+}
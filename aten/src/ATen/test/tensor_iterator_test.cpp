@@ -224,3 +224,25 @@ TEST(TensorIteratorTest, FailNonPromotingBinaryOp) {
   iter.add_input(at::ones({1,1}, at::dtype(at::kInt)));
   ASSERT_ANY_THROW(iter.build());
 }
+
+TEST(TensorIteratorTest, PlanReuse) {
+  auto out = at::empty({5, 5});
+  auto x = at::randn({5, 5});
+  auto y = at::randn({5, 1});  // broadcast along dim 1
+  auto iter = TensorIterator::binary_op(out, x, y);
+  auto plan = iter.extract_plan();
+
+  // Fresh operands with the same geometry should match and compute the same
+  // result through the planned iterator.
+  auto out2 = at::empty({5, 5});
+  auto x2 = at::randn({5, 5});
+  auto y2 = at::randn({5, 1});
+  ASSERT_TRUE(plan.matches({out2, x2, y2}));
+  auto fast_iter = TensorIterator::from_plan(plan, {out2, x2, y2});
+  at::native::cpu_kernel(fast_iter, [](float a, float b) { return a + b; });
+  ASSERT_TRUE(at::allclose(out2, x2 + y2));
+
+  // Mismatched geometry must be rejected.
+  ASSERT_FALSE(plan.matches({out2, x2, at::randn({1, 5})}));
+  ASSERT_ANY_THROW(TensorIterator::from_plan(plan, {out2, x2, at::randn({1, 5})}));
+}
@@ -4,6 +4,7 @@
 #include <ATen/DLConvertor.h>
 #include <ATen/Parallel.h>
 
+#include <atomic>
 #include <iostream>
 #include <string.h>
 #include <sstream>
@@ -69,3 +70,39 @@ TEST(TestParallel, IntraOpLaunchFuture) {
 
   ASSERT_TRUE(v1 == 1 && v2 == 2);
 }
+
+#if AT_PARALLEL_NATIVE
+TEST(TestParallel, WorkStealingScheduler) {
+  at::internal::_set_work_stealing_enabled(true);
+  std::atomic<int64_t> sum{0};
+  at::parallel_for(0, 1000, 1, [&](int64_t begin, int64_t end) {
+    for (auto i = begin; i < end; i++) {
+      sum += i;
+    }
+  });
+  ASSERT_EQ(sum.load(), 499500);
+
+  auto total = at::parallel_reduce(0, 1000, 1, (int64_t)0,
+    [](int64_t begin, int64_t end, int64_t ident) {
+      for (auto i = begin; i < end; i++) {
+        ident += i;
+      }
+      return ident;
+    },
+    std::plus<int64_t>());
+  at::internal::_set_work_stealing_enabled(false);
+  ASSERT_EQ(total, 499500);
+}
+#endif
+
+TEST(TestParallel, GrainSizeThresholds) {
+  auto compute = at::grain_size(at::ParallelWorkKind::COMPUTE_BOUND);
+  auto memory = at::grain_size(at::ParallelWorkKind::MEMORY_BOUND);
+  ASSERT_EQ(compute, at::internal::GRAIN_SIZE);
+  ASSERT_EQ(memory, 4 * at::internal::GRAIN_SIZE);
+
+  at::set_grain_size(at::ParallelWorkKind::MEMORY_BOUND, 1024);
+  ASSERT_EQ(at::grain_size(at::ParallelWorkKind::MEMORY_BOUND), 1024);
+  ASSERT_ANY_THROW(at::set_grain_size(at::ParallelWorkKind::MEMORY_BOUND, 0));
+  at::set_grain_size(at::ParallelWorkKind::MEMORY_BOUND, memory);
+}
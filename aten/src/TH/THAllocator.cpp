@@ -280,14 +280,37 @@ THMapAllocator::THMapAllocator(WithFd, const char *filename, int fd, int flags,
     size_ = size; /* if we are here, it must be the right size */
 
     /* map it */
-    if (flags_ & (TH_ALLOCATOR_MAPPED_SHARED | TH_ALLOCATOR_MAPPED_SHAREDMEM)) {
-      base_ptr_ = mmap(nullptr, size_, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
-    } else {
-      base_ptr_ = mmap(nullptr, size_, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+    int mmap_flags = (flags_ & (TH_ALLOCATOR_MAPPED_SHARED | TH_ALLOCATOR_MAPPED_SHAREDMEM))
+        ? MAP_SHARED : MAP_PRIVATE;
+    bool populated_at_map_time = false;
+#ifdef MAP_POPULATE
+    if ((flags_ & TH_ALLOCATOR_MAPPED_POPULATE) &&
+        !(flags_ & TH_ALLOCATOR_MAPPED_HUGEPAGE)) {
+      /* Prefault at map time. When huge pages are also requested, faulting
+       * is deferred until after the MADV_HUGEPAGE below, so the pages can
+       * actually be backed by huge pages. */
+      mmap_flags |= MAP_POPULATE;
+      populated_at_map_time = true;
     }
+#endif
+    base_ptr_ = mmap(nullptr, size_, PROT_READ|PROT_WRITE, mmap_flags, fd, 0);
 
     if (base_ptr_ == MAP_FAILED) {
       base_ptr_ = nullptr; /* let's be sure it is NULL */
+    } else {
+      /* Both calls below are advisory, so their return values are ignored. */
+#ifdef MADV_HUGEPAGE
+      if (flags_ & TH_ALLOCATOR_MAPPED_HUGEPAGE) {
+        madvise(base_ptr_, size_, MADV_HUGEPAGE);
+      }
+#endif
+#ifdef MADV_WILLNEED
+      if ((flags_ & TH_ALLOCATOR_MAPPED_POPULATE) && !populated_at_map_time) {
+        /* MAP_POPULATE was unavailable or skipped for huge pages; ask for
+         * readahead instead. */
+        madvise(base_ptr_, size_, MADV_WILLNEED);
+      }
+#endif
     }
 
     if (flags_ & TH_ALLOCATOR_MAPPED_KEEPFD) {
@@ -11,6 +11,12 @@
 #define TH_ALLOCATOR_MAPPED_KEEPFD 16
 #define TH_ALLOCATOR_MAPPED_FROMFD 32
 #define TH_ALLOCATOR_MAPPED_UNLINK 64
+/* Prefault the mapping (MAP_POPULATE, or MADV_WILLNEED where that is not
+ * available) so first-touch page faults do not serialize large reads. */
+#define TH_ALLOCATOR_MAPPED_POPULATE 128
+/* Advise the kernel to back the mapping with transparent huge pages
+ * (MADV_HUGEPAGE). A no-op where unsupported. */
+#define TH_ALLOCATOR_MAPPED_HUGEPAGE 256
 
 /* default malloc/free allocator. malloc and realloc raise an error (using
  * THError) on allocation failure.
@@ -3,11 +3,16 @@
 #include <ATen/detail/CUDAHooksInterface.h>
 
 
+#include <c10/util/llvmMathExtras.h>
+
 #include <cuda_runtime_api.h>
+#include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <stdint.h>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
@@ -15,6 +20,18 @@
 
 namespace {
 
+// Pinned buffers are recycled by power-of-two size class so that requests
+// whose sizes vary slightly from batch to batch (e.g. ragged dataloader
+// batches) still hit the cache instead of falling through to cudaHostAlloc.
+constexpr size_t kHostAllocMinBlockSize = 4096;
+
+size_t roundHostAllocSize(size_t size) {
+  if (size <= kHostAllocMinBlockSize) {
+    return kHostAllocMinBlockSize;
+  }
+  return llvm::PowerOf2Ceil(size);
+}
+
 struct BlockSize
 {
   size_t  size; // allocation size
@@ -58,12 +75,35 @@ struct HostAllocator
   // outstanding cuda events
   std::deque<std::pair<cudaEvent_t, void*>> cuda_events;
 
+  // background thread that polls outstanding events and recycles buffers,
+  // so a dataloader thread never stalls in malloc waiting on event queries
+  std::thread reaper_thread;
+  std::condition_variable reaper_cv;
+  bool reaper_started = false;
+  bool shutdown = false;
+
   HostAllocator() : available(BlockComparator) {}
 
+  ~HostAllocator()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      shutdown = true;
+    }
+    reaper_cv.notify_all();
+    if (reaper_thread.joinable()) {
+      reaper_thread.join();
+    }
+  }
+
   cudaError_t malloc(void** ptr, size_t size)
   {
     std::lock_guard<std::mutex> lock(mutex);
 
+    if (size > 0) {
+      size = roundHostAllocSize(size);
+    }
+
     // process outstanding cuda events which may have occurred
     cudaError_t err = processEvents();
     if (err != cudaSuccess) {
@@ -139,6 +179,39 @@ struct HostAllocator
     if (block.event_count == 0) {
       // the block can be re-used if there are no outstanding cuda events
       available.insert(block);
+    } else {
+      // hand the block to the background reaper, which recycles it as soon
+      // as its events complete instead of on the next malloc/free call
+      startReaperIfNeeded();
+      reaper_cv.notify_one();
+    }
+    return cudaSuccess;
+  }
+
+  /** Pre-allocates `count` pinned buffers of `size` (rounded to its size
+   *  class) bytes each, so steady-state pipelines with that many in-flight
+   *  batches never hit cudaHostAlloc. **/
+  cudaError_t reserve(size_t size, size_t count)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    size = roundHostAllocSize(size);
+
+    // Grab any existing primary context, as in malloc above.
+    at::OptionalDeviceGuard device_guard;
+    auto primary_ctx_device_index = at::detail::getCUDAHooks().getDevceIndexWithPrimaryContext();
+    if (primary_ctx_device_index.has_value()) {
+      device_guard.reset_device(at::Device(at::DeviceType::CUDA, *primary_ctx_device_index));
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      void* ptr = nullptr;
+      cudaError_t err = cudaHostAlloc(&ptr, size, cudaHostAllocDefault);
+      if (err != cudaSuccess) {
+        return err;
+      }
+      auto inserted = blocks.insert({ptr, Block(size, ptr, /*allocated=*/false)});
+      available.insert(inserted.first->second);
     }
     return cudaSuccess;
   }
@@ -224,6 +297,37 @@ struct HostAllocator
     }
   }
 
+  void startReaperIfNeeded()
+  {
+    // caller must hold mutex
+    if (reaper_started) {
+      return;
+    }
+    reaper_started = true;
+    reaper_thread = std::thread([this] { reaperLoop(); });
+  }
+
+  void reaperLoop()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!shutdown) {
+      if (cuda_events.empty()) {
+        reaper_cv.wait(lock, [this] { return shutdown || !cuda_events.empty(); });
+        continue;
+      }
+      // Coarse polling interval: events complete at copy granularity, so
+      // sub-millisecond precision buys nothing.
+      reaper_cv.wait_for(lock, std::chrono::microseconds(200));
+      if (shutdown) {
+        break;
+      }
+      cudaError_t err = processEvents();
+      if (err != cudaSuccess) {
+        THCudaCheckWarn(err);
+      }
+    }
+  }
+
   cudaError_t insertEvents(Block& block)
   {
     cudaError_t err;
@@ -267,6 +371,11 @@ void THCCachingHostAllocator_emptyCache()
   allocator.emptyCache();
 }
 
+cudaError_t THCCachingHostAllocator_reserve(size_t size, size_t count)
+{
+  return allocator.reserve(size, count);
+}
+
 static void THCCachingHostDeleter(void* ptr) {
   allocator.free(ptr);
 }
@@ -30,4 +30,9 @@ THC_API cudaError_t THCCachingHostAllocator_recordEvent(void *ptr, at::cuda::CUD
 // Releases cached pinned memory allocations via cudaHostFree
 THC_API void THCCachingHostAllocator_emptyCache(void);
 
+// Pre-allocates `count` pinned buffers of `size` bytes each (rounded up to
+// the allocator's size class), e.g. one per in-flight dataloader batch, so
+// steady-state pipelines never stall in cudaHostAlloc.
+THC_API cudaError_t THCCachingHostAllocator_reserve(size_t size, size_t count);
+
 #endif
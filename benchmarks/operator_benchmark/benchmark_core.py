@@ -15,8 +15,9 @@ import ast
 import cpp_extension # noqa
 
 import cpp_extension # noqa
+import benchmark_pmu
 import benchmark_utils
-from collections import namedtuple
+from collections import namedtuple, OrderedDict
 
 """Performance microbenchmarks.
 
@@ -181,6 +182,12 @@ class BenchmarkRunner(object):
         if self.args.iterations and self.args.iterations != -1:
             self.has_explicit_iteration_count = True
             self.iters = self.args.iterations
+        self.pmu_counters = None
+        if getattr(self.args, 'report_pmu', False):
+            self.pmu_counters = benchmark_pmu.create_counter_group()
+            if self.pmu_counters is None:
+                print("# Warning: hardware performance counters are not "
+                      "available on this platform, reporting time only")
         # when a specific test is selected by a user, we don't need
         # to match the tag anymore
         if self.args.test_name is not None:
@@ -312,6 +319,26 @@ class BenchmarkRunner(object):
         reported_run_time_us = np.percentile(np.array(time_trace), 50)
         return reported_run_time_us
 
+    def _measure_pmu(self, launch_test, test_case, iters):
+        """ This function re-runs the test case under a perf_event counter
+        group and returns per-iteration hardware counts. It is a separate
+        pass so counter collection never perturbs the reported wall time.
+        """
+        with self.pmu_counters:
+            launch_test(test_case, iters, print_per_iter=False)
+        counts = self.pmu_counters.read()
+        return OrderedDict(
+            (name, value / iters) for name, value in counts.items())
+
+    def _print_pmu_result(self, pmu_stats):
+        print("# Hardware counters (per iteration):")
+        for name, value in pmu_stats.items():
+            print("{} : {:.0f}".format(name, value))
+        if pmu_stats.get('cycles'):
+            print("ipc : {:.2f}".format(
+                pmu_stats.get('instructions', 0) / pmu_stats['cycles']))
+        print()
+
     def _check_keep(self, test_flag, cmd_flag):
         return (cmd_flag is None or test_flag == cmd_flag)
 
@@ -399,3 +426,7 @@ class BenchmarkRunner(object):
                                  for _ in range(self.num_runs)]
 
                 self._print_perf_result(reported_time, test_case)
+
+                if self.pmu_counters is not None:
+                    self._print_pmu_result(
+                        self._measure_pmu(launch_func, test_case, self.iters))
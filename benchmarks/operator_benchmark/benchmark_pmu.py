@@ -0,0 +1,181 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import ctypes
+import os
+import platform
+import struct
+import sys
+from collections import OrderedDict
+
+"""Hardware performance-counter collection for the microbenchmarks.
+
+This module wraps the Linux perf_event_open syscall via ctypes so benchmark
+cases can be annotated with PMU counters (cycles, instructions, LLC misses,
+stalled cycles) in addition to wall time. No external dependencies are
+needed; on unsupported platforms (or when access to the PMU is denied, e.g.
+by perf_event_paranoid) collection is silently unavailable and callers
+should fall back to time-only reporting.
+"""
+
+# perf_event_attr.type / .config values (linux/perf_event.h)
+PERF_TYPE_HARDWARE = 0
+PERF_COUNT_HW_CPU_CYCLES = 0
+PERF_COUNT_HW_INSTRUCTIONS = 1
+PERF_COUNT_HW_CACHE_MISSES = 3
+PERF_COUNT_HW_STALLED_CYCLES_FRONTEND = 7
+PERF_COUNT_HW_STALLED_CYCLES_BACKEND = 8
+
+# perf_event_attr.read_format
+PERF_FORMAT_TOTAL_TIME_ENABLED = 1 << 0
+PERF_FORMAT_TOTAL_TIME_RUNNING = 1 << 1
+PERF_FORMAT_GROUP = 1 << 3
+
+# perf_event_attr flag bits
+ATTR_FLAG_DISABLED = 1 << 0
+ATTR_FLAG_EXCLUDE_KERNEL = 1 << 5
+ATTR_FLAG_EXCLUDE_HV = 1 << 6
+
+# ioctls on the perf event fd
+PERF_EVENT_IOC_ENABLE = 0x2400
+PERF_EVENT_IOC_DISABLE = 0x2401
+PERF_EVENT_IOC_RESET = 0x2403
+PERF_IOC_FLAG_GROUP = 1
+
+# sizeof(struct perf_event_attr), PERF_ATTR_SIZE_VER5
+PERF_ATTR_SIZE = 112
+
+# perf_event_open has no libc wrapper; the syscall number is per-arch.
+PERF_EVENT_OPEN_SYSCALL_NR = {
+    'x86_64': 298,
+    'i686': 336,
+    'i386': 336,
+    'aarch64': 241,
+    'armv7l': 364,
+    'ppc64le': 319,
+}
+
+# Counters collected by default: enough to tell cache-bound from
+# frequency/stall-bound from plain instruction-count regressions.
+DEFAULT_EVENTS = [
+    ('cycles', PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES),
+    ('instructions', PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS),
+    ('llc_misses', PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES),
+    ('stalled_cycles_frontend', PERF_TYPE_HARDWARE,
+     PERF_COUNT_HW_STALLED_CYCLES_FRONTEND),
+    ('stalled_cycles_backend', PERF_TYPE_HARDWARE,
+     PERF_COUNT_HW_STALLED_CYCLES_BACKEND),
+]
+
+
+def _pack_perf_event_attr(event_type, config, disabled):
+    """Builds the raw bytes of a struct perf_event_attr."""
+    flags = ATTR_FLAG_EXCLUDE_KERNEL | ATTR_FLAG_EXCLUDE_HV
+    if disabled:
+        flags |= ATTR_FLAG_DISABLED
+    read_format = (PERF_FORMAT_TOTAL_TIME_ENABLED |
+                   PERF_FORMAT_TOTAL_TIME_RUNNING |
+                   PERF_FORMAT_GROUP)
+    attr = struct.pack(
+        'IIQQQQQ',
+        event_type,        # type
+        PERF_ATTR_SIZE,    # size
+        config,            # config
+        0,                 # sample_period / sample_freq
+        0,                 # sample_type
+        read_format,       # read_format
+        flags)             # bitfield flags
+    return attr + b'\0' * (PERF_ATTR_SIZE - len(attr))
+
+
+def _perf_event_open(attr, pid, cpu, group_fd):
+    nr = PERF_EVENT_OPEN_SYSCALL_NR[platform.machine()]
+    libc = ctypes.CDLL(None, use_errno=True)
+    fd = libc.syscall(
+        ctypes.c_long(nr),
+        ctypes.c_char_p(attr),
+        ctypes.c_int(pid),
+        ctypes.c_int(cpu),
+        ctypes.c_int(group_fd),
+        ctypes.c_ulong(0))
+    if fd < 0:
+        errno = ctypes.get_errno()
+        raise OSError(errno, os.strerror(errno))
+    return fd
+
+
+class PerfCounterGroup(object):
+    """A group of PMU counters measuring the calling thread.
+
+    All events are opened in one perf event group so they are scheduled onto
+    the PMU together; when the kernel has to multiplex them, counts are
+    scaled by time_enabled / time_running on read. Typical use:
+
+        counters = PerfCounterGroup()
+        with counters:
+            run_benchmark()
+        print(counters.read())
+    """
+
+    def __init__(self, events=None):
+        self.events = events if events is not None else DEFAULT_EVENTS
+        self.fds = []
+        group_fd = -1
+        try:
+            for i, (_, event_type, config) in enumerate(self.events):
+                attr = _pack_perf_event_attr(
+                    event_type, config, disabled=(i == 0))
+                fd = _perf_event_open(
+                    attr, pid=0, cpu=-1, group_fd=group_fd)
+                self.fds.append(fd)
+                if group_fd == -1:
+                    group_fd = fd
+        except OSError:
+            self.close()
+            raise
+
+    def __enter__(self):
+        import fcntl
+        fcntl.ioctl(self.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP)
+        fcntl.ioctl(self.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP)
+        return self
+
+    def __exit__(self, *exc_info):
+        import fcntl
+        fcntl.ioctl(self.fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP)
+        return False
+
+    def read(self):
+        """Returns an OrderedDict mapping event name to (scaled) count."""
+        nr_events = len(self.events)
+        data = os.read(self.fds[0], 8 * (3 + nr_events))
+        values = struct.unpack('{}Q'.format(3 + nr_events), data)
+        nr, time_enabled, time_running = values[0], values[1], values[2]
+        assert nr == nr_events
+        scale = 1.0
+        if 0 < time_running < time_enabled:
+            scale = float(time_enabled) / time_running
+        counts = OrderedDict()
+        for i, (name, _, _) in enumerate(self.events):
+            counts[name] = values[3 + i] * scale
+        return counts
+
+    def close(self):
+        for fd in self.fds:
+            os.close(fd)
+        self.fds = []
+
+
+def create_counter_group():
+    """Returns a PerfCounterGroup, or None when the PMU is unavailable
+    (non-Linux platform, unknown architecture, or access denied)."""
+    if not sys.platform.startswith('linux'):
+        return None
+    if platform.machine() not in PERF_EVENT_OPEN_SYSCALL_NR:
+        return None
+    try:
+        return PerfCounterGroup()
+    except OSError:
+        return None
@@ -127,6 +127,18 @@ def main():
         help='Run tests on the provided architecture (cpu, cuda)',
         default='None')
 
+    parser.add_argument(
+        "--report_pmu",
+        type=benchmark_utils.str2bool,
+        nargs='?',
+        const=True,
+        default=False,
+        help="Collect hardware performance counters (cycles, instructions, "
+             "LLC misses, stalled cycles) via perf_event_open for each test "
+             "case and report them alongside time. Linux only; needs PMU "
+             "access (see /proc/sys/kernel/perf_event_paranoid)"
+    )
+
     parser.add_argument(
         '--wipe_cache',
         help='Wipe cache before benchmarking each operator',
@@ -33,6 +33,7 @@
 #include "caffe2/core/net.h"
 #include "caffe2/core/operator.h"
 #include "caffe2/core/tensor_int8.h"
+#include "caffe2/core/timer.h"
 #include "caffe2/utils/bench_utils.h"
 #include "caffe2/utils/string_utils.h"
 #include <observers/net_observer_reporter_print.h>
@@ -260,9 +261,20 @@ void runNetwork(
   LOG(INFO) << "Starting benchmark.";
   caffe2::ObserverConfig::initSampleRate(1, 1, 1, run_individual, warmup);
   LOG(INFO) << "Running warmup runs.";
+  // The first run ever executed pays for first-touch allocation and cold
+  // caches; report it separately so it can be compared against the
+  // steady-state number logged after the main runs.
+  caffe2::Timer run_timer;
+  bool first_run_reported = false;
   for (int i = 0; i < warmup; ++i) {
     fillInputBlob(workspace, tensor_protos_map, i);
+    run_timer.Start();
     CAFFE_ENFORCE(net->Run(), "Warmup run ", i, " has failed.");
+    if (!first_run_reported) {
+      logBenchmarkResult(
+          "NET_", "first_run_latency", "us", (int)run_timer.MicroSeconds());
+      first_run_reported = true;
+    }
   }
 
   if (wipe_cache) {
@@ -278,13 +290,22 @@ void runNetwork(
       iter,
       ".");
   LOG(INFO) << "net runs.";
+  double main_run_us = 0;
   for (int i = 0; i < iter; ++i) {
     caffe2::ObserverConfig::initSampleRate(1, 1, 1, 0, warmup);
     fillInputBlob(workspace, tensor_protos_map, i);
     if (wipe_cache) {
       caffe2::wipe_cache();
     }
+    run_timer.Start();
     CAFFE_ENFORCE(net->Run(), "Main run ", i, " has failed.");
+    const double this_run_us = run_timer.MicroSeconds();
+    main_run_us += this_run_us;
+    if (!first_run_reported) {
+      // No warmup runs: the first main run is the cold one.
+      logBenchmarkResult("NET_", "first_run_latency", "us", (int)this_run_us);
+      first_run_reported = true;
+    }
     // Write the output for the first num_blobs times
     writeOutput(
         workspace,
@@ -302,6 +323,10 @@ void runNetwork(
           std::chrono::seconds(sleep_between_iteration));
     }
   }
+  if (iter > 0) {
+    logBenchmarkResult(
+        "NET_", "steady_state_latency", "us", (int)(main_run_us / iter));
+  }
   if (run_individual) {
     LOG(INFO) << "operator runs.";
     if (sleep_between_net_and_operator > 0) {
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2016-present, Facebook, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmarks for the hot framework paths whose overhead dominates
+// small-tensor workloads: TensorImpl creation/destruction, dispatch,
+// IValue boxing, intrusive_ptr refcounting and TensorIterator setup.
+//
+// For CI gating, run with googlebenchmark's machine-readable output, e.g.
+//   framework_overhead_benchmark --benchmark_format=json \
+//       --benchmark_out=framework_overhead.json
+// and compare the per-benchmark real_time against a recorded baseline.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+#include <ATen/NativeFunctions.h>
+#include <ATen/core/ivalue.h>
+#include <ATen/native/TensorIterator.h>
+#include <c10/util/intrusive_ptr.h>
+
+// Tensor (and thus TensorImpl + Storage) creation and destruction, without
+// any meaningful data: the per-tensor fixed cost.
+static void BM_TensorCreateDestroy(benchmark::State& state) {
+  auto options = at::TensorOptions().dtype(at::kFloat).device(at::kCPU);
+  while (state.KeepRunning()) {
+    at::Tensor t = at::empty({1}, options);
+    benchmark::DoNotOptimize(t);
+  }
+}
+BENCHMARK(BM_TensorCreateDestroy);
+
+// A one-element add through the full dispatcher. Compare against
+// BM_NativeAdd: the difference is what dispatch, the variable wrappers and
+// out-tensor creation cost per call.
+static void BM_DispatchedAdd(benchmark::State& state) {
+  at::Tensor x = at::ones({1});
+  at::Tensor y = at::ones({1});
+  while (state.KeepRunning()) {
+    at::Tensor z = at::add(x, y);
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK(BM_DispatchedAdd);
+
+// The same add, calling the native CPU kernel entry point directly.
+static void BM_NativeAdd(benchmark::State& state) {
+  at::Tensor x = at::ones({1});
+  at::Tensor y = at::ones({1});
+  while (state.KeepRunning()) {
+    at::Tensor z = at::native::add(x, y, 1);
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK(BM_NativeAdd);
+
+// In-place dispatched add: no output allocation, so closer to pure
+// dispatch + kernel-launch overhead.
+static void BM_DispatchedAddInplace(benchmark::State& state) {
+  at::Tensor x = at::ones({1});
+  at::Tensor y = at::ones({1});
+  while (state.KeepRunning()) {
+    x.add_(y);
+  }
+  benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_DispatchedAddInplace);
+
+// Boxing a tensor into an IValue and unboxing it again, the unit of work
+// on every boxed operator call and interpreter step.
+static void BM_IValueBoxUnboxTensor(benchmark::State& state) {
+  at::Tensor t = at::ones({1});
+  while (state.KeepRunning()) {
+    c10::IValue boxed(t);
+    at::Tensor unboxed = boxed.toTensor();
+    benchmark::DoNotOptimize(unboxed);
+  }
+}
+BENCHMARK(BM_IValueBoxUnboxTensor);
+
+namespace {
+struct RefcountedPayload : c10::intrusive_ptr_target {
+  int64_t value = 0;
+};
+} // namespace
+
+// A bare intrusive_ptr copy/destroy: two atomic refcount operations.
+static void BM_IntrusivePtrCopy(benchmark::State& state) {
+  auto ptr = c10::make_intrusive<RefcountedPayload>();
+  while (state.KeepRunning()) {
+    c10::intrusive_ptr<RefcountedPayload> copy = ptr;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_IntrusivePtrCopy);
+
+// The same refcount traffic through the Tensor handle, as it occurs on
+// every pass of a tensor by value.
+static void BM_TensorHandleCopy(benchmark::State& state) {
+  at::Tensor t = at::ones({1});
+  while (state.KeepRunning()) {
+    at::Tensor copy = t;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_TensorHandleCopy);
+
+// TensorIterator construction for a binary op: shape computation, type
+// promotion and dimension coalescing, paid before any kernel work starts.
+static void BM_TensorIteratorBinarySetup(benchmark::State& state) {
+  at::Tensor x = at::ones({state.range(0)});
+  at::Tensor y = at::ones({state.range(0)});
+  at::Tensor out = at::empty({state.range(0)});
+  while (state.KeepRunning()) {
+    auto iter = at::TensorIterator::binary_op(out, x, y);
+    benchmark::DoNotOptimize(iter);
+  }
+}
+BENCHMARK(BM_TensorIteratorBinarySetup)->Arg(1)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
@@ -14,11 +14,17 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ATen/ATen.h"
+#include "c10/core/Allocator.h"
 #include "caffe2/core/timer.h"
+#include "caffe2/utils/bench_utils.h"
 #include "caffe2/utils/string_utils.h"
 #include "torch/csrc/autograd/grad_mode.h"
 #include "torch/csrc/jit/import.h"
@@ -43,11 +49,43 @@ C10_DEFINE_bool(
   "Whether to print output with all one input tensor.");
 C10_DEFINE_int(warmup, 0, "The number of iterations to warm up.");
 C10_DEFINE_int(iter, 10, "The number of iterations to run.");
+C10_DEFINE_int(
+    threads,
+    1,
+    "Number of closed-loop request threads driving the model concurrently; "
+    "each thread issues its next request as soon as the previous one "
+    "finishes.");
+C10_DEFINE_string(
+    output_csv,
+    "",
+    "Write one row per iteration (thread, iter, start_us, latency_us) to "
+    "this file.");
+C10_DEFINE_string(
+    output_json,
+    "",
+    "Write per-iteration samples and the summary to this file as JSON.");
+C10_DEFINE_bool(
+    report_memory,
+    false,
+    "Report CPU allocator activity (allocation count and bytes) for the "
+    "warmup and main phases separately.");
+C10_DEFINE_bool(
+    prefault_weights,
+    false,
+    "Touch every page of the model's parameters and buffers before the "
+    "first run, so first-touch page faults are not measured.");
+C10_DEFINE_bool(
+    wipe_cache,
+    false,
+    "Flush CPU caches before every timed iteration, for cold-cache "
+    "measurement instead of the default steady-state (warm) protocol.");
 C10_DEFINE_bool(
   report_pep,
   false,
   "Whether to print performance stats for AI-PEP.");
 
+namespace {
+
 std::vector<std::string>
 split(char separator, const std::string& string, bool ignore_empty = true) {
   std::vector<std::string> pieces;
@@ -61,6 +99,132 @@ split(char separator, const std::string& string, bool ignore_empty = true) {
   return pieces;
 }
 
+// One forward() call: when it started (relative to the main phase) and
+// how long it took, both in microseconds.
+struct Sample {
+  int thread;
+  int iter;
+  double start_us;
+  double latency_us;
+};
+
+// Counts CPU allocator traffic while installed; used for the per-phase
+// allocator deltas. Frees keep the delegate's deleters, so installing
+// and uninstalling at any point is safe.
+struct CountingAllocator final : at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+    allocations++;
+    bytes += nbytes;
+    return delegate->allocate(nbytes);
+  }
+
+  at::Allocator* delegate = nullptr;
+  mutable std::atomic<uint64_t> allocations{0};
+  mutable std::atomic<uint64_t> bytes{0};
+};
+
+double percentile(const std::vector<double>& sorted_latencies, double p) {
+  if (sorted_latencies.empty()) {
+    return 0;
+  }
+  size_t rank = static_cast<size_t>(p / 100.0 * sorted_latencies.size());
+  rank = std::min(rank, sorted_latencies.size() - 1);
+  return sorted_latencies[rank];
+}
+
+// Reads one byte per page of every parameter and buffer so that mmap'd
+// weight pages are faulted in before the first timed run.
+void prefault_weights(torch::jit::script::Module& module) {
+  static constexpr size_t kPageSize = 4096;
+  volatile char sink = 0;
+  size_t bytes = 0;
+  auto touch = [&](const at::Tensor& tensor) {
+    if (!tensor.defined() || !tensor.device().is_cpu()) {
+      return;
+    }
+    const char* data = static_cast<const char*>(tensor.data_ptr());
+    const size_t nbytes = tensor.numel() * tensor.element_size();
+    for (size_t offset = 0; offset < nbytes; offset += kPageSize) {
+      sink += data[offset];
+    }
+    bytes += nbytes;
+  };
+  for (const at::Tensor& parameter : module.parameters()) {
+    touch(parameter);
+  }
+  for (const at::Tensor& buffer : module.buffers()) {
+    touch(buffer);
+  }
+  (void)sink;
+  std::cout << "Prefaulted " << bytes << " bytes of weights." << std::endl;
+}
+
+void run_closed_loop(
+    torch::jit::script::Module& module,
+    const std::vector<c10::IValue>& inputs,
+    int thread,
+    int iters,
+    high_resolution_clock::time_point phase_start,
+    std::vector<Sample>* samples) {
+  torch::autograd::AutoGradMode guard(false);
+  samples->reserve(iters);
+  for (int i = 0; i < iters; ++i) {
+    if (FLAGS_wipe_cache) {
+      // Flushed outside the timed region: the measurement starts on a cold
+      // cache but does not pay for the flush itself.
+      caffe2::wipe_cache();
+    }
+    auto start = high_resolution_clock::now();
+    module.forward(inputs);
+    auto stop = high_resolution_clock::now();
+    Sample sample;
+    sample.thread = thread;
+    sample.iter = i;
+    sample.start_us =
+        duration_cast<microseconds>(start - phase_start).count();
+    sample.latency_us =
+        duration_cast<nanoseconds>(stop - start).count() / 1000.0;
+    samples->push_back(sample);
+  }
+}
+
+void write_csv(const std::string& path, const std::vector<Sample>& samples) {
+  std::ofstream out(path);
+  CAFFE_ENFORCE(out.is_open(), "Could not open output file: ", path);
+  out << "thread,iter,start_us,latency_us\n";
+  for (const auto& sample : samples) {
+    out << sample.thread << "," << sample.iter << "," << sample.start_us
+        << "," << sample.latency_us << "\n";
+  }
+}
+
+void write_json(
+    const std::string& path,
+    const std::vector<Sample>& samples,
+    const std::vector<double>& sorted_latencies) {
+  std::ofstream out(path);
+  CAFFE_ENFORCE(out.is_open(), "Could not open output file: ", path);
+  out << "{\"unit\": \"us\", \"summary\": {"
+      << "\"p50\": " << percentile(sorted_latencies, 50)
+      << ", \"p95\": " << percentile(sorted_latencies, 95)
+      << ", \"p99\": " << percentile(sorted_latencies, 99)
+      << ", \"max\": "
+      << (sorted_latencies.empty() ? 0 : sorted_latencies.back())
+      << "}, \"samples\": [";
+  for (size_t i = 0; i < samples.size(); ++i) {
+    if (i != 0) {
+      out << ", ";
+    }
+    out << "{\"thread\": " << samples[i].thread
+        << ", \"iter\": " << samples[i].iter
+        << ", \"start_us\": " << samples[i].start_us
+        << ", \"latency_us\": " << samples[i].latency_us << "}";
+  }
+  out << "]}\n";
+}
+
+} // namespace
+
 int main(int argc, char** argv) {
   c10::SetUsageMessage(
     "Run speed benchmark for pytorch model.\n"
@@ -70,7 +234,9 @@ int main(int argc, char** argv) {
     " --input_dims=\"1,3,224,224\""
     " --input_type=float"
     " --warmup=5"
-    " --iter=20");
+    " --iter=20"
+    " --threads=4"
+    " --output_csv=latencies.csv");
   if (!c10::ParseCommandLineFlags(&argc, &argv)) {
     std::cerr << "Failed to parse command line flags!" << std::endl;
     return 1;
@@ -110,11 +276,33 @@ int main(int argc, char** argv) {
   auto module = torch::jit::load(FLAGS_model);
 
   module.eval();
-  if (FLAGS_print_output) {
-    std::cout << module.forward(inputs) << std::endl;
+  if (FLAGS_prefault_weights) {
+    prefault_weights(module);
+  }
+
+  CountingAllocator counting_allocator;
+  if (FLAGS_report_memory) {
+    counting_allocator.delegate = c10::GetAllocator(at::DeviceType::CPU);
+    c10::SetAllocator(at::DeviceType::CPU, &counting_allocator);
   }
 
   std::cout << "Starting benchmark." << std::endl;
+  // The very first forward pays for lazy initialization, first-touch
+  // allocation and cold caches; time it separately so the steady-state
+  // numbers below are not polluted by it.
+  double first_run_us;
+  {
+    auto start = high_resolution_clock::now();
+    auto output = module.forward(inputs);
+    auto stop = high_resolution_clock::now();
+    first_run_us = duration_cast<nanoseconds>(stop - start).count() / 1000.0;
+    if (FLAGS_print_output) {
+      std::cout << output << std::endl;
+    }
+  }
+  std::cout << "First run (cold) latency: " << first_run_us << " us."
+            << std::endl;
+
   std::cout << "Running warmup runs." << std::endl;
   CAFFE_ENFORCE(
       FLAGS_warmup >= 0,
@@ -125,32 +313,99 @@ int main(int argc, char** argv) {
     module.forward(inputs);
   }
 
+  if (FLAGS_report_memory) {
+    std::cout << "Warmup allocator activity: "
+              << counting_allocator.allocations.load() << " allocations, "
+              << counting_allocator.bytes.load() << " bytes" << std::endl;
+    counting_allocator.allocations = 0;
+    counting_allocator.bytes = 0;
+  }
+
   std::cout << "Main runs." << std::endl;
   CAFFE_ENFORCE(
       FLAGS_iter >= 0,
       "Number of main runs should be non negative, provided ",
       FLAGS_iter,
       ".");
+  CAFFE_ENFORCE(
+      FLAGS_threads >= 1,
+      "Number of threads should be positive, provided ",
+      FLAGS_threads,
+      ".");
+
   caffe2::Timer timer;
-  std::vector<float> times;
+  auto phase_start = high_resolution_clock::now();
+  std::vector<std::vector<Sample>> per_thread_samples(FLAGS_threads);
+  if (FLAGS_threads == 1) {
+    run_closed_loop(
+        module, inputs, 0, FLAGS_iter, phase_start, &per_thread_samples[0]);
+  } else {
+    // Closed-loop mode: every thread hammers the same module instance,
+    // issuing its next request as soon as the previous one returns, the
+    // way concurrent request streams hit one loaded model in serving.
+    std::vector<std::thread> workers;
+    for (int t = 0; t < FLAGS_threads; ++t) {
+      workers.emplace_back(
+          run_closed_loop,
+          std::ref(module),
+          std::cref(inputs),
+          t,
+          FLAGS_iter,
+          phase_start,
+          &per_thread_samples[t]);
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
   auto millis = timer.MilliSeconds();
-  for (int i = 0; i < FLAGS_iter; ++i) {
-    auto start = high_resolution_clock::now();
-    module.forward(inputs);
-    auto stop = high_resolution_clock::now();
-    auto duration = duration_cast<microseconds>(stop - start);
-    times.push_back(duration.count());
+
+  std::vector<Sample> samples;
+  for (const auto& thread_samples : per_thread_samples) {
+    samples.insert(
+        samples.end(), thread_samples.begin(), thread_samples.end());
+  }
+
+  if (FLAGS_report_memory) {
+    std::cout << "Main run allocator activity: "
+              << counting_allocator.allocations.load() << " allocations, "
+              << counting_allocator.bytes.load() << " bytes" << std::endl;
+    c10::SetAllocator(at::DeviceType::CPU, counting_allocator.delegate);
   }
-  millis = timer.MilliSeconds();
+
   if (FLAGS_report_pep) {
-    for (auto t : times) {
-      std::cout << "PyTorchObserver {\"type\": \"NET\", \"unit\": \"us\", \"metric\": \"latency\", \"value\": \"" << t << "\"}" << std::endl;
+    for (const auto& sample : samples) {
+      std::cout << "PyTorchObserver {\"type\": \"NET\", \"unit\": \"us\", \"metric\": \"latency\", \"value\": \"" << sample.latency_us << "\"}" << std::endl;
     }
   }
+
+  std::vector<double> sorted_latencies;
+  sorted_latencies.reserve(samples.size());
+  for (const auto& sample : samples) {
+    sorted_latencies.push_back(sample.latency_us);
+  }
+  std::sort(sorted_latencies.begin(), sorted_latencies.end());
+
+  const int total_iters = FLAGS_iter * FLAGS_threads;
   std::cout << "Main run finished. Milliseconds per iter: "
-            << millis / FLAGS_iter
-            << ". Iters per second: " << 1000.0 * FLAGS_iter / millis
+            << millis / total_iters
+            << ". Iters per second: " << 1000.0 * total_iters / millis
             << std::endl;
+  std::cout << "First run (cold) latency: " << first_run_us
+            << " us. Steady-state latency percentiles (us):"
+            << " p50: " << percentile(sorted_latencies, 50)
+            << " p95: " << percentile(sorted_latencies, 95)
+            << " p99: " << percentile(sorted_latencies, 99)
+            << " max: "
+            << (sorted_latencies.empty() ? 0 : sorted_latencies.back())
+            << std::endl;
+
+  if (!FLAGS_output_csv.empty()) {
+    write_csv(FLAGS_output_csv, samples);
+  }
+  if (!FLAGS_output_json.empty()) {
+    write_json(FLAGS_output_json, samples, sorted_latencies);
+  }
 
   return 0;
 }
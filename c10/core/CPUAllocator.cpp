@@ -1,5 +1,18 @@
 #include <c10/core/CPUAllocator.h>
 #include <c10/core/DeviceType.h>
+#include <c10/util/Backtrace.h>
+#include <c10/util/FlightRecorder.h>
+#include <c10/util/llvmMathExtras.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 // TODO: rename flags to C10
 C10_DEFINE_bool(
@@ -17,6 +30,22 @@ C10_DEFINE_bool(
     false,
     "If set, fill memory with deterministic junk when allocating on CPU");
 
+C10_DEFINE_int64(
+    caffe2_cpu_hugepage_threshold,
+    0,
+    "If positive, CPU allocations of at least this many bytes are served "
+    "from a huge-page tier (mmap + MADV_HUGEPAGE) to cut TLB misses on "
+    "large long-lived tensors such as embedding tables. 0 disables the "
+    "tier. Linux only; typical values start around 64MB.");
+
+C10_DEFINE_bool(
+    caffe2_cpu_hugepage_use_1gb,
+    false,
+    "If set (together with caffe2_cpu_hugepage_threshold), the huge-page "
+    "tier first tries explicit 1GB pages (MAP_HUGETLB); this requires "
+    "pre-reserved 1GB pages on the host and rounds each mapping up to a "
+    "1GB multiple. Falls back to MADV_HUGEPAGE, then to the normal path.");
+
 namespace c10 {
 
 void memset_junk(void* data, size_t num) {
@@ -36,7 +65,120 @@ void memset_junk(void* data, size_t num) {
   }
 }
 
+namespace {
+
+// Registry for the huge-page tier: free_cpu must know whether a pointer
+// came from mmap (and its mapping length), so every tier allocation is
+// recorded here. Doubles as the source of the coverage stats.
+struct HugePageMapping {
+  size_t length = 0;
+  bool is_1gb = false;
+};
+
+struct HugePageRegistry {
+  std::mutex mutex;
+  std::unordered_map<void*, HugePageMapping> mappings;
+  CPUHugePageStats stats;
+};
+
+HugePageRegistry& hugepage_registry() {
+  static HugePageRegistry registry;
+  return registry;
+}
+
+#if defined(__linux__)
+
+constexpr size_t k1GBPage = 1ull << 30;
+
+// Tries to serve `nbytes` from the huge-page tier. Returns nullptr on any
+// failure; the caller falls back to the normal allocation path.
+void* alloc_cpu_hugepages(size_t nbytes) {
+  void* data = MAP_FAILED;
+  size_t length = nbytes;
+  bool used_1gb = false;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+  if (FLAGS_caffe2_cpu_hugepage_use_1gb) {
+    // Explicit 1GB pages must be mapped in whole-page units.
+    length = (nbytes + k1GBPage - 1) & ~(k1GBPage - 1);
+    data = mmap(
+        nullptr,
+        length,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT),
+        -1,
+        0);
+    used_1gb = data != MAP_FAILED;
+  }
+#endif
+  if (data == MAP_FAILED) {
+    length = nbytes;
+    data = mmap(
+        nullptr,
+        length,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    if (data == MAP_FAILED) {
+      return nullptr;
+    }
+#if defined(MADV_HUGEPAGE)
+    // Advisory only: the kernel backs the mapping with transparent huge
+    // pages as they become available; 4K pages otherwise.
+    madvise(data, length, MADV_HUGEPAGE);
+#endif
+  }
+  HugePageRegistry& registry = hugepage_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  registry.mappings[data] = HugePageMapping{length, used_1gb};
+  registry.stats.hugepage_bytes += length;
+  if (used_1gb) {
+    registry.stats.hugepage_1gb_bytes += length;
+  }
+  ++registry.stats.hugepage_allocation_count;
+  return data;
+}
+
+#else // defined(__linux__)
+
+void* alloc_cpu_hugepages(size_t /* nbytes */) {
+  return nullptr;
+}
+
+#endif // defined(__linux__)
+
+// Returns true iff `data` belonged to the huge-page tier and was unmapped.
+bool free_cpu_hugepages(void* data) {
+  HugePageRegistry& registry = hugepage_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  auto it = registry.mappings.find(data);
+  if (it == registry.mappings.end()) {
+    return false;
+  }
+#if defined(__linux__)
+  munmap(data, it->second.length);
+#endif
+  registry.stats.hugepage_bytes -= it->second.length;
+  if (it->second.is_1gb) {
+    registry.stats.hugepage_1gb_bytes -= it->second.length;
+  }
+  registry.mappings.erase(it);
+  return true;
+}
+
+} // namespace
+
+CPUHugePageStats GetCPUHugePageStats() {
+  HugePageRegistry& registry = hugepage_registry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  return registry.stats;
+}
+
 void* alloc_cpu(size_t nbytes) {
+  return alloc_cpu(nbytes, GetCurrentNUMANode());
+}
+
+void* alloc_cpu(size_t nbytes, int numa_node_id) {
   if (nbytes == 0) {
     return nullptr;
   }
@@ -46,24 +188,38 @@ void* alloc_cpu(size_t nbytes) {
     ((ptrdiff_t)nbytes) >= 0,
     "alloc_cpu() seems to have been called with negative number: ", nbytes);
 
-  void* data;
+  void* data = nullptr;
+  // Huge-page tier for large allocations: mmap is page-aligned, so the
+  // gAlignment contract is satisfied. On failure we fall through to the
+  // normal path so the tier can never make an allocation fail.
+  if (FLAGS_caffe2_cpu_hugepage_threshold > 0 &&
+      nbytes >= static_cast<size_t>(FLAGS_caffe2_cpu_hugepage_threshold)) {
+    data = alloc_cpu_hugepages(nbytes);
+    if (data == nullptr) {
+      HugePageRegistry& registry = hugepage_registry();
+      std::lock_guard<std::mutex> guard(registry.mutex);
+      ++registry.stats.hugepage_fallback_count;
+    }
+  }
+  if (data == nullptr) {
 #ifdef __ANDROID__
-  data = memalign(gAlignment, nbytes);
+    data = memalign(gAlignment, nbytes);
 #elif defined(_MSC_VER)
-  data = _aligned_malloc(nbytes, gAlignment);
+    data = _aligned_malloc(nbytes, gAlignment);
 #else
-  int err = posix_memalign(&data, gAlignment, nbytes);
-  if (err != 0) {
-    CAFFE_THROW(
-        "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
-        nbytes,
-        " bytes. Error code ",
-        err,
-        " (",
-        strerror(err),
-        ")");
-  }
+    int err = posix_memalign(&data, gAlignment, nbytes);
+    if (err != 0) {
+      CAFFE_THROW(
+          "DefaultCPUAllocator: can't allocate memory: you tried to allocate ",
+          nbytes,
+          " bytes. Error code ",
+          err,
+          " (",
+          strerror(err),
+          ")");
+    }
 #endif
+  }
 
   CAFFE_ENFORCE(
       data,
@@ -71,8 +227,8 @@ void* alloc_cpu(size_t nbytes) {
       nbytes,
       " bytes. Buy new RAM!");
 
-  // move data to a thread's NUMA node
-  NUMAMove(data, nbytes, GetCurrentNUMANode());
+  // move data to the requested NUMA node (the caller's node by default)
+  NUMAMove(data, nbytes, numa_node_id);
   CHECK(
       !FLAGS_caffe2_cpu_allocator_do_zero_fill ||
       !FLAGS_caffe2_cpu_allocator_do_junk_fill)
@@ -83,10 +239,17 @@ void* alloc_cpu(size_t nbytes) {
     memset_junk(data, nbytes);
   }
 
+  FlightRecord(FlightEventType::ALLOC, "cpu", nbytes);
   return data;
 }
 
 void free_cpu(void* data) {
+  if (data) {
+    FlightRecord(FlightEventType::FREE, "cpu");
+    if (free_cpu_hugepages(data)) {
+      return;
+    }
+  }
 #ifdef _MSC_VER
   _aligned_free(data);
 #else
@@ -94,6 +257,51 @@ void free_cpu(void* data) {
 #endif
 }
 
+namespace {
+
+size_t size_bucket(size_t nbytes) {
+  if (nbytes == 0) {
+    return 0;
+  }
+  return std::min<size_t>(llvm::Log2_64(nbytes), kCPUMemorySizeBuckets - 1);
+}
+
+std::atomic<bool> cpu_memory_profiling_enabled{false};
+
+// Allocations are credited to the allocating thread; frees may happen
+// elsewhere, so current/peak are only tracked process-wide.
+CPUMemoryStats& cpu_memory_thread_stats() {
+  static thread_local CPUMemoryStats stats;
+  return stats;
+}
+
+struct AllocationCallbackState {
+  std::mutex mutex;
+  CPUAllocationCallback callback;
+  size_t threshold = 0;
+};
+
+AllocationCallbackState& allocation_callback_state() {
+  static AllocationCallbackState state;
+  return state;
+}
+
+void maybe_invoke_allocation_callback(size_t nbytes) {
+  CPUAllocationCallback callback;
+  {
+    AllocationCallbackState& state = allocation_callback_state();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    if (!state.callback || nbytes < state.threshold) {
+      return;
+    }
+    callback = state.callback;
+  }
+  // Capture outside the lock; the backtrace is by far the expensive part.
+  callback(nbytes, get_backtrace(/*frames_to_skip=*/1));
+}
+
+} // namespace
+
 // A virtual struct that is used to report C10's memory allocation and
 // deallocation status
 class C10_API MemoryAllocationReporter {
@@ -101,19 +309,39 @@ class C10_API MemoryAllocationReporter {
   MemoryAllocationReporter() : allocated_(0) {}
   void New(void* ptr, size_t nbytes);
   void Delete(void* ptr);
+  CPUMemoryStats stats();
+  void reset_peak();
+  void enable_events(size_t capacity);
+  void disable_events();
+  CPUMemoryEvents drain_events();
 
  private:
+  void record_event(bool is_free, size_t nbytes);
+
   std::mutex mutex_;
   std::unordered_map<void*, size_t> size_table_;
   size_t allocated_;
+  CPUMemoryStats stats_;
+  // ring buffer of alloc/free events; empty() means recording disabled
+  std::vector<CPUMemoryEvent> event_ring_;
+  size_t event_ring_head_ = 0;  // index of the oldest buffered event
+  size_t event_ring_count_ = 0;
+  uint64_t events_overwritten_ = 0;
 };
 
+static MemoryAllocationReporter& getMemoryAllocationReporter() {
+  static MemoryAllocationReporter reporter_;
+  return reporter_;
+}
+
 struct C10_API DefaultCPUAllocator final : at::Allocator {
   DefaultCPUAllocator() {}
   ~DefaultCPUAllocator() override {}
   at::DataPtr allocate(size_t nbytes) const override {
     void* data = alloc_cpu(nbytes);
-    if (FLAGS_caffe2_report_cpu_memory_usage && nbytes > 0) {
+    if ((FLAGS_caffe2_report_cpu_memory_usage ||
+         CPUMemoryProfilingEnabled()) &&
+        nbytes > 0) {
       getMemoryAllocationReporter().New(data, nbytes);
       return {data, data, &ReportAndDelete, at::Device(at::DeviceType::CPU)};
     }
@@ -129,20 +357,92 @@ struct C10_API DefaultCPUAllocator final : at::Allocator {
   }
 
   at::DeleterFnPtr raw_deleter() const override {
-    if (FLAGS_caffe2_report_cpu_memory_usage) {
+    if (FLAGS_caffe2_report_cpu_memory_usage || CPUMemoryProfilingEnabled()) {
       return &ReportAndDelete;
     }
     return &free_cpu;
   }
+};
+
+void SetCPUMemoryProfilingEnabled(bool enabled) {
+  cpu_memory_profiling_enabled.store(enabled);
+}
+
+bool CPUMemoryProfilingEnabled() {
+  return cpu_memory_profiling_enabled.load(std::memory_order_relaxed);
+}
+
+CPUMemoryStats GetCPUMemoryStats() {
+  return getMemoryAllocationReporter().stats();
+}
+
+CPUMemoryStats GetThreadCPUMemoryStats() {
+  return cpu_memory_thread_stats();
+}
 
- protected:
-  static MemoryAllocationReporter& getMemoryAllocationReporter() {
-    static MemoryAllocationReporter reporter_;
-    return reporter_;
+void ResetPeakCPUMemoryStats() {
+  getMemoryAllocationReporter().reset_peak();
+}
+
+void EnableCPUMemoryEventRecording(size_t capacity) {
+  // Events are recorded by the tracking deleter, which is only installed
+  // while profiling is on.
+  SetCPUMemoryProfilingEnabled(true);
+  getMemoryAllocationReporter().enable_events(capacity);
+}
+
+void DisableCPUMemoryEventRecording() {
+  getMemoryAllocationReporter().disable_events();
+}
+
+CPUMemoryEvents GetCPUMemoryEvents() {
+  return getMemoryAllocationReporter().drain_events();
+}
+
+void SetCPUAllocationCallback(
+    CPUAllocationCallback callback,
+    size_t threshold) {
+  AllocationCallbackState& state = allocation_callback_state();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  state.callback = std::move(callback);
+  state.threshold = threshold;
+}
+
+// An allocation pool bound to a single NUMA node. Identical to
+// DefaultCPUAllocator except that pages are moved to the pool's node instead
+// of the calling thread's node.
+struct C10_API NUMANodeCPUAllocator final : at::Allocator {
+  explicit NUMANodeCPUAllocator(int numa_node_id) : numa_node_id_(numa_node_id) {}
+  at::DataPtr allocate(size_t nbytes) const override {
+    void* data = alloc_cpu(nbytes, numa_node_id_);
+    return {data, data, &free_cpu, at::Device(at::DeviceType::CPU)};
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return &free_cpu;
   }
 
+ private:
+  int numa_node_id_;
 };
 
+at::Allocator* GetNUMANodeCPUAllocator(int numa_node_id) {
+  TORCH_CHECK(
+      numa_node_id >= 0 && numa_node_id < std::max(GetNumNUMANodes(), 1),
+      "Invalid NUMA node id: ",
+      numa_node_id);
+  static std::mutex mutex;
+  static std::vector<std::unique_ptr<NUMANodeCPUAllocator>> pools;
+  std::lock_guard<std::mutex> guard(mutex);
+  if (numa_node_id >= static_cast<int>(pools.size())) {
+    pools.resize(numa_node_id + 1);
+  }
+  if (!pools[numa_node_id]) {
+    pools[numa_node_id] = std::make_unique<NUMANodeCPUAllocator>(numa_node_id);
+  }
+  return pools[numa_node_id].get();
+}
+
 void NoDelete(void*) {}
 
 at::Allocator* GetCPUAllocator() {
@@ -163,11 +463,26 @@ at::Allocator* GetDefaultCPUAllocator() {
 REGISTER_ALLOCATOR(DeviceType::CPU, &g_cpu_alloc);
 
 void MemoryAllocationReporter::New(void* ptr, size_t nbytes) {
-  std::lock_guard<std::mutex> guard(mutex_);
-  size_table_[ptr] = nbytes;
-  allocated_ += nbytes;
-  LOG(INFO) << "C10 alloc " << nbytes << " bytes, total alloc " << allocated_
-            << " bytes.";
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    size_table_[ptr] = nbytes;
+    allocated_ += nbytes;
+    stats_.current_bytes = allocated_;
+    stats_.peak_bytes = std::max<uint64_t>(stats_.peak_bytes, allocated_);
+    stats_.total_allocated_bytes += nbytes;
+    ++stats_.allocation_count;
+    ++stats_.size_histogram[size_bucket(nbytes)];
+    record_event(/*is_free=*/false, nbytes);
+    if (FLAGS_caffe2_report_cpu_memory_usage) {
+      LOG(INFO) << "C10 alloc " << nbytes << " bytes, total alloc "
+                << allocated_ << " bytes.";
+    }
+  }
+  CPUMemoryStats& thread_stats = cpu_memory_thread_stats();
+  thread_stats.total_allocated_bytes += nbytes;
+  ++thread_stats.allocation_count;
+  ++thread_stats.size_histogram[size_bucket(nbytes)];
+  maybe_invoke_allocation_callback(nbytes);
 }
 
 void MemoryAllocationReporter::Delete(void* ptr) {
@@ -175,9 +490,80 @@ void MemoryAllocationReporter::Delete(void* ptr) {
   auto it = size_table_.find(ptr);
   CHECK(it != size_table_.end());
   allocated_ -= it->second;
-  LOG(INFO) << "C10 deleted " << it->second << " bytes, total alloc "
-            << allocated_ << " bytes.";
+  stats_.current_bytes = allocated_;
+  ++stats_.free_count;
+  record_event(/*is_free=*/true, it->second);
+  if (FLAGS_caffe2_report_cpu_memory_usage) {
+    LOG(INFO) << "C10 deleted " << it->second << " bytes, total alloc "
+              << allocated_ << " bytes.";
+  }
   size_table_.erase(it);
 }
 
+CPUMemoryStats MemoryAllocationReporter::stats() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return stats_;
+}
+
+void MemoryAllocationReporter::reset_peak() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  stats_.peak_bytes = stats_.current_bytes;
+}
+
+// Caller must hold mutex_.
+void MemoryAllocationReporter::record_event(bool is_free, size_t nbytes) {
+  if (event_ring_.empty()) {
+    return;
+  }
+  CPUMemoryEvent event;
+  event.timestamp_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  event.is_free = is_free;
+  event.nbytes = nbytes;
+  event.allocated_bytes = allocated_;
+  if (event_ring_count_ < event_ring_.size()) {
+    event_ring_[(event_ring_head_ + event_ring_count_) % event_ring_.size()] =
+        event;
+    ++event_ring_count_;
+  } else {
+    event_ring_[event_ring_head_] = event;
+    event_ring_head_ = (event_ring_head_ + 1) % event_ring_.size();
+    ++events_overwritten_;
+  }
+}
+
+void MemoryAllocationReporter::enable_events(size_t capacity) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  TORCH_CHECK(capacity > 0, "event ring capacity must be positive");
+  event_ring_.assign(capacity, CPUMemoryEvent());
+  event_ring_head_ = 0;
+  event_ring_count_ = 0;
+  events_overwritten_ = 0;
+}
+
+void MemoryAllocationReporter::disable_events() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  event_ring_.clear();
+  event_ring_head_ = 0;
+  event_ring_count_ = 0;
+  events_overwritten_ = 0;
+}
+
+CPUMemoryEvents MemoryAllocationReporter::drain_events() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  CPUMemoryEvents result;
+  result.events.reserve(event_ring_count_);
+  for (size_t i = 0; i < event_ring_count_; ++i) {
+    result.events.push_back(
+        event_ring_[(event_ring_head_ + i) % event_ring_.size()]);
+  }
+  result.overwritten = events_overwritten_;
+  event_ring_head_ = 0;
+  event_ring_count_ = 0;
+  events_overwritten_ = 0;
+  return result;
+}
+
 } // namespace c10
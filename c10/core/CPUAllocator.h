@@ -1,7 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/util/Logging.h>
@@ -11,6 +16,8 @@
 C10_DECLARE_bool(caffe2_report_cpu_memory_usage);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_zero_fill);
 C10_DECLARE_bool(caffe2_cpu_allocator_do_junk_fill);
+C10_DECLARE_int64(caffe2_cpu_hugepage_threshold);
+C10_DECLARE_bool(caffe2_cpu_hugepage_use_1gb);
 
 namespace c10 {
 
@@ -28,6 +35,9 @@ C10_API void NoDelete(void*);
 C10_API void memset_junk(void* data, size_t num);
 
 C10_API void* alloc_cpu(size_t nbytes);
+// Allocates CPU memory whose pages are bound to the given NUMA node rather
+// than the calling thread's node. No-op binding if NUMA is unavailable.
+C10_API void* alloc_cpu(size_t nbytes, int numa_node_id);
 C10_API void free_cpu(void* data);
 
 // Get the CPU Allocator.
@@ -39,4 +49,104 @@ C10_API void SetCPUAllocator(at::Allocator* alloc);
 // Get the Default CPU Allocator
 C10_API at::Allocator* GetDefaultCPUAllocator();
 
+// Number of log2-spaced buckets in the allocation-size histogram; bucket i
+// counts allocations of [2^i, 2^(i+1)) bytes.
+constexpr size_t kCPUMemorySizeBuckets = 64;
+
+// Statistics collected by the default CPU allocator while CPU memory
+// profiling is enabled, so RSS spikes can be attributed without an external
+// heap profiler (the CPU analogue of CUDACachingAllocator's stats).
+struct C10_API CPUMemoryStats {
+  // Bytes currently allocated and the high-water mark since the last
+  // ResetPeakCPUMemoryStats(). Only meaningful in the process-wide stats:
+  // a thread is credited for what it allocates, but blocks may be freed on
+  // a different thread.
+  uint64_t current_bytes = 0;
+  uint64_t peak_bytes = 0;
+  // Cumulative counters.
+  uint64_t total_allocated_bytes = 0;
+  uint64_t allocation_count = 0;
+  uint64_t free_count = 0;
+  std::array<uint64_t, kCPUMemorySizeBuckets> size_histogram{{}};
+};
+
+// Starts (or stops) collecting CPUMemoryStats in the default CPU allocator.
+// Only allocations made while profiling is enabled are tracked; the
+// steady-state cost is one mutex-protected table update per allocation and
+// free, like the caffe2_report_cpu_memory_usage logging path.
+C10_API void SetCPUMemoryProfilingEnabled(bool enabled);
+C10_API bool CPUMemoryProfilingEnabled();
+
+// Event stream for the default CPU allocator: a bounded ring buffer of
+// timestamped alloc/free events (the CPU analogue of
+// CUDACachingAllocator's MemoryEvent stream), so an external agent can
+// scrape memory behavior per request window and catch leak-like growth.
+// Pair with ResetPeakCPUMemoryStats() for rolling high-water marks.
+struct C10_API CPUMemoryEvent {
+  // steady-clock nanoseconds; comparable across events in the process
+  int64_t timestamp_ns = 0;
+  bool is_free = false;
+  uint64_t nbytes = 0;
+  // Bytes tracked by the allocator after the event.
+  uint64_t allocated_bytes = 0;
+};
+
+struct C10_API CPUMemoryEvents {
+  // Chronological; at most the configured ring capacity per drain.
+  std::vector<CPUMemoryEvent> events;
+  // Events lost to ring overflow since the previous drain.
+  uint64_t overwritten = 0;
+};
+
+// Starts recording allocator events into a ring of `capacity` entries
+// (replacing any previous ring). Event recording needs the tracking
+// deleter, so this also enables CPU memory profiling; disabling recording
+// leaves profiling as it was.
+C10_API void EnableCPUMemoryEventRecording(size_t capacity);
+C10_API void DisableCPUMemoryEventRecording();
+// Returns and clears the buffered events.
+C10_API CPUMemoryEvents GetCPUMemoryEvents();
+
+// Process-wide statistics, merged over all threads.
+C10_API CPUMemoryStats GetCPUMemoryStats();
+// Allocations made by the calling thread only (current/peak not tracked).
+C10_API CPUMemoryStats GetThreadCPUMemoryStats();
+// Resets peak_bytes to current_bytes in the process-wide statistics.
+C10_API void ResetPeakCPUMemoryStats();
+
+// Callback invoked for every allocation of at least `threshold` bytes, with
+// the requested size and the C++ backtrace of the allocation site — capture
+// is expensive, so pick a threshold that fires only on the spikes being
+// hunted. Pass a nullptr function to uninstall. The callback runs with no
+// allocator locks held; it must not allocate CPU tensors.
+using CPUAllocationCallback =
+    std::function<void(size_t nbytes, const std::string& backtrace)>;
+C10_API void SetCPUAllocationCallback(
+    CPUAllocationCallback callback,
+    size_t threshold);
+
+// Statistics for the huge-page allocation tier, tracked whenever the tier
+// is enabled (independent of CPU memory profiling), so production can
+// verify that large long-lived tensors actually landed on huge pages.
+struct C10_API CPUHugePageStats {
+  // Bytes currently mapped by the huge-page tier and how many of those are
+  // backed by explicit 1GB pages (the rest are MADV_HUGEPAGE mappings).
+  uint64_t hugepage_bytes = 0;
+  uint64_t hugepage_1gb_bytes = 0;
+  // Cumulative counters: tier allocations served, and threshold-eligible
+  // allocations that fell back to the normal path because mmap failed.
+  uint64_t hugepage_allocation_count = 0;
+  uint64_t hugepage_fallback_count = 0;
+};
+
+C10_API CPUHugePageStats GetCPUHugePageStats();
+
+// Returns a per-node allocation pool whose allocations are bound to
+// `numa_node_id`, so tensors produced on one socket (e.g. by a dataloader
+// thread) can live on the socket that will consume them. Use it directly for
+// one-off allocations or install it via SetCPUAllocator() from a worker that
+// should produce node-local tensors. Query a tensor's home node with
+// c10::GetNUMANode(tensor.data_ptr()).
+C10_API at::Allocator* GetNUMANodeCPUAllocator(int numa_node_id);
+
 } // namespace c10
@@ -0,0 +1,168 @@
+#include <c10/core/CPUCachingAllocator.h>
+
+#include <c10/util/Exception.h>
+#include <c10/util/llvmMathExtras.h>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace c10 {
+namespace CPUCachingAllocator {
+
+namespace {
+
+// Blocks smaller than this are rounded up to it; together with power-of-two
+// size classes this bounds internal fragmentation at 2x.
+constexpr size_t kMinCachedBytes = 64;
+// Blocks larger than this bypass the cache entirely.
+constexpr size_t kMaxCachedBytes = 1ULL << 20; // 1 MiB
+// Per-thread cache budget; freeing beyond this releases to the system.
+constexpr size_t kMaxCachedBytesPerThread = 64ULL << 20; // 64 MiB
+
+constexpr size_t kNumSizeClasses = 15; // 64 B .. 1 MiB inclusive
+
+// Each cached block is prefixed by one gAlignment-sized header holding the
+// rounded allocation size, so raw_deallocate() can find the block's size
+// class without a global table. The pointer handed out stays gAlignment
+// aligned.
+static_assert(sizeof(size_t) <= gAlignment, "header must fit in alignment");
+
+inline size_t round_size(size_t nbytes) {
+  if (nbytes <= kMinCachedBytes) {
+    return kMinCachedBytes;
+  }
+  return static_cast<size_t>(1) << (64 - llvm::countLeadingZeros(nbytes - 1));
+}
+
+inline size_t size_class(size_t rounded) {
+  // rounded is a power of two in [kMinCachedBytes, kMaxCachedBytes]
+  return llvm::countTrailingZeros(rounded) - llvm::countTrailingZeros(kMinCachedBytes);
+}
+
+void* system_allocate(size_t rounded) {
+  char* base = static_cast<char*>(alloc_cpu(rounded + gAlignment));
+  *reinterpret_cast<size_t*>(base) = rounded;
+  return base + gAlignment;
+}
+
+inline size_t block_size(void* ptr) {
+  return *reinterpret_cast<size_t*>(static_cast<char*>(ptr) - gAlignment);
+}
+
+inline void system_deallocate(void* ptr) {
+  free_cpu(static_cast<char*>(ptr) - gAlignment);
+}
+
+struct ThreadCache {
+  std::array<std::vector<void*>, kNumSizeClasses> free_lists;
+  size_t cached_bytes = 0;
+
+  void* allocate(size_t nbytes) {
+    size_t rounded = round_size(nbytes);
+    if (rounded > kMaxCachedBytes) {
+      return system_allocate(rounded);
+    }
+    auto& list = free_lists[size_class(rounded)];
+    if (!list.empty()) {
+      void* ptr = list.back();
+      list.pop_back();
+      cached_bytes -= rounded;
+      return ptr;
+    }
+    return system_allocate(rounded);
+  }
+
+  void deallocate(void* ptr) {
+    size_t rounded = block_size(ptr);
+    if (rounded > kMaxCachedBytes ||
+        cached_bytes + rounded > kMaxCachedBytesPerThread) {
+      system_deallocate(ptr);
+      return;
+    }
+    free_lists[size_class(rounded)].push_back(ptr);
+    cached_bytes += rounded;
+  }
+
+  void release_all() {
+    for (auto& list : free_lists) {
+      for (void* ptr : list) {
+        system_deallocate(ptr);
+      }
+      list.clear();
+    }
+    cached_bytes = 0;
+  }
+
+  ~ThreadCache() {
+    release_all();
+  }
+};
+
+ThreadCache& thread_cache() {
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
+struct CachingCPUAllocator final : at::Allocator {
+  // NB: qualified names below; at::Allocator has raw_allocate/raw_deallocate
+  // members that would otherwise shadow the namespace-level cache entry
+  // points.
+  at::DataPtr allocate(size_t nbytes) const override {
+    if (nbytes == 0) {
+      return {nullptr, nullptr, &c10::CPUCachingAllocator::raw_deallocate,
+              at::Device(at::DeviceType::CPU)};
+    }
+    void* data = c10::CPUCachingAllocator::raw_allocate(nbytes);
+    return {data, data, &c10::CPUCachingAllocator::raw_deallocate,
+            at::Device(at::DeviceType::CPU)};
+  }
+
+  at::DeleterFnPtr raw_deleter() const override {
+    return &c10::CPUCachingAllocator::raw_deallocate;
+  }
+};
+
+} // namespace
+
+void* raw_allocate(size_t nbytes) {
+  return thread_cache().allocate(nbytes);
+}
+
+void raw_deallocate(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  thread_cache().deallocate(ptr);
+}
+
+void emptyThreadCache() {
+  thread_cache().release_all();
+}
+
+size_t currentThreadCachedBytes() {
+  return thread_cache().cached_bytes;
+}
+
+at::Allocator* get() {
+  static CachingCPUAllocator allocator;
+  return &allocator;
+}
+
+} // namespace CPUCachingAllocator
+
+namespace {
+std::atomic<bool> g_cpu_caching_allocator_enabled{false};
+} // namespace
+
+void EnableCPUCachingAllocator(bool enable) {
+  g_cpu_caching_allocator_enabled = enable;
+  SetCPUAllocator(enable ? CPUCachingAllocator::get() : GetDefaultCPUAllocator());
+}
+
+bool IsCPUCachingAllocatorEnabled() {
+  return g_cpu_caching_allocator_enabled;
+}
+
+} // namespace c10
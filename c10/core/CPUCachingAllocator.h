@@ -0,0 +1,47 @@
+#pragma once
+
+#include <c10/core/Allocator.h>
+#include <c10/core/CPUAllocator.h>
+
+namespace c10 {
+
+// A caching allocator for CPU tensors.
+//
+// Under multi-threaded inference serving, going to posix_memalign/free on
+// every tensor allocation makes malloc contention show up at the top of
+// profiles. This allocator mirrors the design of CUDACachingAllocator at a
+// smaller scale: freed blocks are parked on per-thread size-class free lists
+// (power-of-two classes between kMinCachedBytes and kMaxCachedBytes) and
+// handed back on the next allocation of the same class without touching the
+// system allocator or any lock. Blocks above kMaxCachedBytes, and overflow
+// beyond the per-thread cache budget, go straight to alloc_cpu/free_cpu.
+//
+// The default CPU allocator is unchanged; opt in per process via
+// at::globalContext().setCPUCachingAllocatorEnabled(true) (which routes
+// through EnableCPUCachingAllocator below).
+namespace CPUCachingAllocator {
+
+// Allocate/deallocate through the cache. Safe to call from any thread;
+// blocks may be freed on a different thread than the one that allocated them.
+C10_API void* raw_allocate(size_t nbytes);
+C10_API void raw_deallocate(void* ptr);
+
+// Returns cached blocks of the calling thread to the system allocator.
+// Other threads' caches are flushed when those threads exit.
+C10_API void emptyThreadCache();
+
+// Total bytes currently parked in the calling thread's free lists.
+C10_API size_t currentThreadCachedBytes();
+
+// The at::Allocator view of the cache, suitable for SetCPUAllocator().
+C10_API at::Allocator* get();
+
+} // namespace CPUCachingAllocator
+
+// Installs (or uninstalls) the caching allocator as the process-wide CPU
+// allocator. Already-allocated DataPtrs keep their original deleter, so
+// flipping this at runtime is safe.
+C10_API void EnableCPUCachingAllocator(bool enable);
+C10_API bool IsCPUCachingAllocatorEnabled();
+
+} // namespace c10
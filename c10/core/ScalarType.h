@@ -190,13 +190,19 @@ static inline caffe2::TypeMeta scalarTypeToTypeMeta(ScalarType scalar_type) {
 
 static inline c10::optional<ScalarType> tryTypeMetaToScalarType(
     caffe2::TypeMeta dtype) {
-#define DEFINE_IF(ctype, name)                    \
-  if (dtype == caffe2::TypeMeta::Make<ctype>()) { \
-    return {ScalarType::name};                    \
+  // Compare constexpr type ids instead of TypeMeta pointers: each
+  // right-hand side below is a compile-time constant, so the chain lowers
+  // to integer compares on a single loaded id instead of one out-of-line
+  // _typeMetaDataInstance call per candidate type. This is on the hot path
+  // of scalar_type() and thus of every AT_DISPATCH switch.
+  const auto id = dtype.id();
+#define DEFINE_IF(ctype, name)               \
+  if (id == caffe2::TypeMeta::Id<ctype>()) { \
+    return {ScalarType::name};               \
   }
   AT_FORALL_SCALAR_TYPES_WITH_COMPLEX_AND_QINTS(DEFINE_IF)
 #undef DEFINE_IF
-  if (dtype == caffe2::TypeMeta()) {
+  if (id == caffe2::TypeIdentifier::uninitialized()) {
     return {ScalarType::Undefined};
   }
   return c10::nullopt;
@@ -1 +1,71 @@
 #include <c10/core/StorageImpl.h>
+
+#include <cstring>
+
+namespace c10 {
+
+namespace detail {
+
+void deleteCowContext(void* ctx_) {
+  auto* ctx = static_cast<CowContext*>(ctx_);
+  if (ctx->refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // Destroying the context destroys original_ptr, which runs the real
+    // deleter and frees the shared allocation.
+    delete ctx;
+  }
+}
+
+} // namespace detail
+
+c10::intrusive_ptr<StorageImpl> StorageImpl::share_copy_on_write() {
+  TORCH_CHECK(
+      device_type() == DeviceType::CPU,
+      "Copy-on-write storage sharing is only supported for CPU storages, "
+      "but got device ",
+      device());
+  TORCH_CHECK(
+      allocator_ != nullptr,
+      "Copy-on-write storage sharing requires an allocator so the storage "
+      "can be materialized on write.");
+  detail::CowContext* ctx;
+  if (is_copy_on_write()) {
+    ctx = static_cast<detail::CowContext*>(data_ptr_.get_context());
+  } else {
+    // Turn this storage into a copy-on-write root: move the original
+    // DataPtr into a fresh control block and view it from here on.
+    void* data = data_ptr_.get();
+    Device data_device = data_ptr_.device();
+    ctx = new detail::CowContext(std::move(data_ptr_));
+    data_ptr_ =
+        at::DataPtr(data, ctx, &detail::deleteCowContext, data_device);
+  }
+  ctx->refcount.fetch_add(1, std::memory_order_relaxed);
+  return c10::make_intrusive<StorageImpl>(
+      data_type_,
+      numel_,
+      at::DataPtr(
+          data_ptr_.get(), ctx, &detail::deleteCowContext, data_ptr_.device()),
+      allocator_,
+      resizable_);
+}
+
+void StorageImpl::materialize_copy_on_write() {
+  TORCH_INTERNAL_ASSERT(is_copy_on_write());
+  auto* ctx = static_cast<detail::CowContext*>(data_ptr_.get_context());
+  if (ctx->refcount.load(std::memory_order_acquire) == 1) {
+    // We are the only storage left viewing the allocation, so reclaim it
+    // instead of copying. Replacing data_ptr_ drops the last context
+    // reference, which deletes the (now empty) control block.
+    at::DataPtr original = std::move(ctx->original_ptr);
+    data_ptr_ = std::move(original);
+    return;
+  }
+  const size_t nbytes = capacity();
+  at::DataPtr new_ptr = allocator_->allocate(nbytes);
+  if (nbytes > 0) {
+    std::memcpy(new_ptr.get(), data_ptr_.get(), nbytes);
+  }
+  data_ptr_ = std::move(new_ptr);
+}
+
+} // namespace c10
@@ -7,6 +7,28 @@
 
 namespace c10 {
 
+struct StorageImpl;
+
+namespace detail {
+
+// Control block shared by all storages that view one copy-on-write
+// allocation (see StorageImpl::share_copy_on_write). It keeps the original
+// DataPtr - and thus the real deleter - alive until the last viewing
+// storage materializes or is destroyed.
+struct C10_API CowContext final {
+  explicit CowContext(at::DataPtr original)
+      : original_ptr(std::move(original)), refcount(1) {}
+
+  at::DataPtr original_ptr;
+  std::atomic<size_t> refcount;
+};
+
+// Deleter installed on every DataPtr that views a CowContext. Drops one
+// reference and frees the original allocation with the last one.
+C10_API void deleteCowContext(void* ctx);
+
+} // namespace detail
+
 struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
  public:
   StorageImpl(
@@ -173,6 +195,36 @@ struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
     resizable_ = resizable;
   }
 
+  /**
+   * Returns true if this storage currently shares its bytes copy-on-write
+   * with other storages, i.e. a write through it must materialize first.
+   */
+  bool is_copy_on_write() const {
+    return data_ptr_.get_deleter() == &detail::deleteCowContext;
+  }
+
+  /**
+   * Share this storage's bytes copy-on-write and return a new storage
+   * viewing them. Both this storage and the returned one keep reading the
+   * same allocation until one of them is written through, at which point
+   * the writer gets a private copy (see maybe_materialize_copy_on_write).
+   * Only supported for CPU storages with an allocator; materialization
+   * copies with memcpy. Not thread safe with respect to concurrent
+   * accesses to this storage.
+   */
+  c10::intrusive_ptr<StorageImpl> share_copy_on_write();
+
+  /**
+   * Write fence: callers that are about to write through this storage's
+   * data pointer must call this first so copy-on-write sharing can be
+   * resolved to a private allocation. No-op for ordinary storages.
+   */
+  void maybe_materialize_copy_on_write() {
+    if (C10_UNLIKELY(is_copy_on_write())) {
+      materialize_copy_on_write();
+    }
+  }
+
   /**
    * Can only be called when use_count is 1
    */
@@ -222,6 +274,8 @@ struct C10_API StorageImpl final : public c10::intrusive_ptr_target {
   }
 
  private:
+  void materialize_copy_on_write();
+
   caffe2::TypeMeta data_type_;
   DataPtr data_ptr_;
   int64_t numel_;
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <c10/macros/Macros.h>
+#include <c10/util/ArrayRef.h>
+#include <c10/util/Exception.h>
+
+namespace c10 {
+namespace impl {
+
+// Packed storage for a TensorImpl's sizes and strides.
+//
+// TensorImpl used to hold sizes and strides as two separate
+// SmallVector<int64_t,5> fields.  Since the two arrays always have the
+// same length, that representation wastes a redundant size word and, for
+// tensors with more than 5 dimensions, costs two heap allocations where
+// one suffices; every view/reshape clones both vectors.  This class packs
+// both arrays into a single inline buffer (sizes first, then strides) and
+// falls back to a single heap allocation when the dimensionality exceeds
+// the inline capacity.
+//
+// Invariant: the sizes and strides arrays always have the same length,
+// which is also the dimensionality of the tensor.  resize() zero-fills
+// any newly exposed elements of both arrays, matching the behavior of the
+// old resize(ndim, 0) calls on the separate vectors.
+class C10_API SizesAndStrides {
+ public:
+  using sizes_iterator = int64_t*;
+  using sizes_const_iterator = const int64_t*;
+  using strides_iterator = int64_t*;
+  using strides_const_iterator = const int64_t*;
+
+  // TensorImpl is born as a scalar-shaped (but zero-element) 1-dim tensor:
+  // sizes {0}, strides {1}.
+  SizesAndStrides() : size_(1) {
+    size_at_unchecked(0) = 0;
+    stride_at_unchecked(0) = 1;
+  }
+
+  ~SizesAndStrides() {
+    if (C10_UNLIKELY(!isInline())) {
+      free(outOfLineStorage_);
+    }
+  }
+
+  SizesAndStrides(const SizesAndStrides& rhs) : size_(rhs.size_) {
+    if (C10_LIKELY(rhs.isInline())) {
+      copyDataInline(rhs);
+    } else {
+      allocOutOfLineStorage(size_);
+      copyDataOutline(rhs);
+    }
+  }
+
+  SizesAndStrides& operator=(const SizesAndStrides& rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+    if (C10_LIKELY(rhs.isInline())) {
+      if (C10_UNLIKELY(!isInline())) {
+        free(outOfLineStorage_);
+      }
+      copyDataInline(rhs);
+    } else {
+      if (isInline()) {
+        allocOutOfLineStorage(rhs.size_);
+      } else {
+        reallocOutOfLineStorage(rhs.size_);
+      }
+      copyDataOutline(rhs);
+    }
+    size_ = rhs.size_;
+    return *this;
+  }
+
+  // Moves are implemented as copies that leave the source in the
+  // default (1-dim) state; since the common case is inline, there is no
+  // indirection worth stealing.
+  SizesAndStrides(SizesAndStrides&& rhs) noexcept : size_(rhs.size_) {
+    if (C10_LIKELY(isInline())) {
+      memcpy(inlineStorage_, rhs.inlineStorage_, sizeof(inlineStorage_));
+    } else {
+      outOfLineStorage_ = rhs.outOfLineStorage_;
+      rhs.outOfLineStorage_ = nullptr;
+    }
+    rhs.size_ = 1;
+    rhs.size_at_unchecked(0) = 0;
+    rhs.stride_at_unchecked(0) = 1;
+  }
+
+  SizesAndStrides& operator=(SizesAndStrides&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+    if (C10_LIKELY(rhs.isInline())) {
+      if (C10_UNLIKELY(!isInline())) {
+        free(outOfLineStorage_);
+      }
+      copyDataInline(rhs);
+    } else {
+      // Steal their heap allocation.
+      if (C10_UNLIKELY(!isInline())) {
+        free(outOfLineStorage_);
+      }
+      outOfLineStorage_ = rhs.outOfLineStorage_;
+      rhs.outOfLineStorage_ = nullptr;
+    }
+    size_ = rhs.size_;
+    rhs.size_ = 1;
+    rhs.size_at_unchecked(0) = 0;
+    rhs.stride_at_unchecked(0) = 1;
+    return *this;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  const int64_t* sizes_data() const {
+    return isInline() ? &inlineStorage_[0] : &outOfLineStorage_[0];
+  }
+
+  int64_t* sizes_data() {
+    return isInline() ? &inlineStorage_[0] : &outOfLineStorage_[0];
+  }
+
+  sizes_const_iterator sizes_begin() const {
+    return sizes_data();
+  }
+
+  sizes_iterator sizes_begin() {
+    return sizes_data();
+  }
+
+  sizes_const_iterator sizes_end() const {
+    return sizes_begin() + size();
+  }
+
+  sizes_iterator sizes_end() {
+    return sizes_begin() + size();
+  }
+
+  IntArrayRef sizes_arrayref() const {
+    return IntArrayRef{sizes_data(), size()};
+  }
+
+  void set_sizes(IntArrayRef newSizes) {
+    resize(newSizes.size());
+    std::copy(newSizes.begin(), newSizes.end(), sizes_begin());
+  }
+
+  const int64_t* strides_data() const {
+    return isInline() ? &inlineStorage_[MAX_INLINE_SIZE]
+                      : &outOfLineStorage_[size()];
+  }
+
+  int64_t* strides_data() {
+    return isInline() ? &inlineStorage_[MAX_INLINE_SIZE]
+                      : &outOfLineStorage_[size()];
+  }
+
+  strides_const_iterator strides_begin() const {
+    return strides_data();
+  }
+
+  strides_iterator strides_begin() {
+    return strides_data();
+  }
+
+  strides_const_iterator strides_end() const {
+    return strides_begin() + size();
+  }
+
+  strides_iterator strides_end() {
+    return strides_begin() + size();
+  }
+
+  IntArrayRef strides_arrayref() const {
+    return IntArrayRef{strides_data(), size()};
+  }
+
+  int64_t size_at(size_t idx) const {
+    TORCH_INTERNAL_ASSERT(idx < size());
+    return sizes_data()[idx];
+  }
+
+  int64_t& size_at(size_t idx) {
+    TORCH_INTERNAL_ASSERT(idx < size());
+    return sizes_data()[idx];
+  }
+
+  int64_t size_at_unchecked(size_t idx) const {
+    return sizes_data()[idx];
+  }
+
+  int64_t& size_at_unchecked(size_t idx) {
+    return sizes_data()[idx];
+  }
+
+  int64_t stride_at(size_t idx) const {
+    TORCH_INTERNAL_ASSERT(idx < size());
+    return strides_data()[idx];
+  }
+
+  int64_t& stride_at(size_t idx) {
+    TORCH_INTERNAL_ASSERT(idx < size());
+    return strides_data()[idx];
+  }
+
+  int64_t stride_at_unchecked(size_t idx) const {
+    return strides_data()[idx];
+  }
+
+  int64_t& stride_at_unchecked(size_t idx) {
+    return strides_data()[idx];
+  }
+
+  // Changes the dimensionality.  Overlapping elements of both arrays are
+  // preserved; newly exposed elements are zero-filled.
+  void resize(size_t newSize) {
+    const auto oldSize = size();
+    if (newSize == oldSize) {
+      return;
+    }
+    if (C10_LIKELY(newSize <= MAX_INLINE_SIZE && isInline())) {
+      if (oldSize < newSize) {
+        const auto bytesToZero =
+            (newSize - oldSize) * sizeof(inlineStorage_[0]);
+        memset(&inlineStorage_[oldSize], 0, bytesToZero);
+        memset(&inlineStorage_[MAX_INLINE_SIZE + oldSize], 0, bytesToZero);
+      }
+      size_ = newSize;
+    } else {
+      resizeSlowPath(newSize, oldSize);
+    }
+  }
+
+ private:
+  // Sizes beyond this stop fitting in the inline buffer; see the field
+  // comment in TensorImpl for why 5 was chosen as the common case.
+  static constexpr size_t MAX_INLINE_SIZE = 5;
+
+  bool isInline() const {
+    return size_ <= MAX_INLINE_SIZE;
+  }
+
+  void copyDataInline(const SizesAndStrides& rhs) {
+    TORCH_INTERNAL_ASSERT(rhs.isInline());
+    memcpy(inlineStorage_, rhs.inlineStorage_, sizeof(inlineStorage_));
+  }
+
+  static size_t storageBytes(size_t size) {
+    return size * 2 * sizeof(int64_t);
+  }
+
+  void allocOutOfLineStorage(size_t size) {
+    outOfLineStorage_ = static_cast<int64_t*>(malloc(storageBytes(size)));
+    TORCH_CHECK(
+        outOfLineStorage_,
+        "Could not allocate memory for Tensor sizes and strides!");
+  }
+
+  void reallocOutOfLineStorage(size_t newSize) {
+    outOfLineStorage_ = static_cast<int64_t*>(
+        realloc(outOfLineStorage_, storageBytes(newSize)));
+    TORCH_CHECK(
+        outOfLineStorage_,
+        "Could not allocate memory for Tensor sizes and strides!");
+  }
+
+  void copyDataOutline(const SizesAndStrides& rhs) {
+    memcpy(outOfLineStorage_, rhs.outOfLineStorage_, storageBytes(rhs.size_));
+  }
+
+  void resizeSlowPath(size_t newSize, size_t oldSize) {
+    if (newSize <= MAX_INLINE_SIZE) {
+      TORCH_INTERNAL_ASSERT(
+          !isInline(), "resizeSlowPath called when fast path should have been hit!");
+      int64_t* tempStorage = outOfLineStorage_;
+      memcpy(
+          &inlineStorage_[0],
+          &tempStorage[0],
+          newSize * sizeof(inlineStorage_[0]));
+      memcpy(
+          &inlineStorage_[MAX_INLINE_SIZE],
+          &tempStorage[oldSize],
+          newSize * sizeof(inlineStorage_[0]));
+      // CANNOT USE outOfLineStorage_ here! The above memcpy clobbered it.
+      free(tempStorage);
+    } else {
+      if (isInline()) {
+        // CANNOT USE outOfLineStorage_ here! It's important to keep the
+        // original data around in inlineStorage_ until it is copied over.
+        int64_t* tempStorage =
+            static_cast<int64_t*>(malloc(storageBytes(newSize)));
+        TORCH_CHECK(
+            tempStorage,
+            "Could not allocate memory for Tensor sizes and strides!");
+        const auto bytesToCopy = oldSize * sizeof(inlineStorage_[0]);
+        const auto bytesToZero = (newSize > oldSize)
+            ? (newSize - oldSize) * sizeof(tempStorage[0])
+            : 0;
+        memcpy(&tempStorage[0], &inlineStorage_[0], bytesToCopy);
+        if (bytesToZero) {
+          memset(&tempStorage[oldSize], 0, bytesToZero);
+        }
+        memcpy(
+            &tempStorage[newSize],
+            &inlineStorage_[MAX_INLINE_SIZE],
+            bytesToCopy);
+        if (bytesToZero) {
+          memset(&tempStorage[newSize + oldSize], 0, bytesToZero);
+        }
+        outOfLineStorage_ = tempStorage;
+      } else {
+        const bool isGrowing = oldSize < newSize;
+        if (isGrowing) {
+          // Resize before shifting so that we have room.
+          reallocOutOfLineStorage(newSize);
+        }
+        // Shift the old strides to their new starting point. Note
+        // that this does not occur in the inline path above because
+        // the stride starting point is not moving.
+        memmove(
+            outOfLineStorage_ + newSize,
+            outOfLineStorage_ + oldSize,
+            std::min(oldSize, newSize) * sizeof(outOfLineStorage_[0]));
+        if (!isGrowing) {
+          // Resize after shifting so that we don't lose data.
+          reallocOutOfLineStorage(newSize);
+        } else {
+          // Zero the end of the sizes portion and the end of the
+          // strides portion.
+          const auto bytesToZero =
+              (newSize - oldSize) * sizeof(outOfLineStorage_[0]);
+          memset(&outOfLineStorage_[oldSize], 0, bytesToZero);
+          memset(&outOfLineStorage_[newSize + oldSize], 0, bytesToZero);
+        }
+      }
+    }
+    size_ = newSize;
+  }
+
+  size_t size_;
+  union {
+    int64_t* outOfLineStorage_;
+    // Sizes occupy the first MAX_INLINE_SIZE slots, strides the rest.
+    int64_t inlineStorage_[MAX_INLINE_SIZE * 2]{};
+  };
+};
+
+} // namespace impl
+} // namespace c10
@@ -0,0 +1,160 @@
+#include <c10/core/work_stealing_thread_pool.h>
+
+#include <random>
+
+namespace c10 {
+
+namespace {
+
+// Which pool (if any) the current thread belongs to, and its worker
+// index in that pool. Lets run() route nested submissions to the local
+// deque and makes inThreadPool() O(1).
+thread_local WorkStealingThreadPool* current_pool = nullptr;
+thread_local size_t current_worker_index = 0;
+
+} // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(
+    int pool_size,
+    int numa_node_id,
+    std::function<void()> init_thread)
+    : workers_(),
+      threads_(pool_size < 0 ? defaultNumThreads() : pool_size),
+      next_worker_(0),
+      pending_(0),
+      idle_(0),
+      running_(true),
+      numa_node_id_(numa_node_id) {
+  workers_.reserve(threads_.size());
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    workers_.emplace_back(new Worker());
+  }
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    threads_[i] = std::thread([this, i, init_thread]() {
+      if (init_thread) {
+        init_thread();
+      }
+      current_pool = this;
+      current_worker_index = i;
+      this->main_loop(i);
+    });
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  running_.store(false);
+  {
+    std::lock_guard<std::mutex> guard(sleep_mutex_);
+    sleep_condition_.notify_all();
+  }
+  for (auto& t : threads_) {
+    try {
+      t.join();
+    } catch (const std::exception&) {
+    }
+  }
+}
+
+size_t WorkStealingThreadPool::size() const {
+  return threads_.size();
+}
+
+size_t WorkStealingThreadPool::numAvailable() const {
+  return idle_.load();
+}
+
+bool WorkStealingThreadPool::inThreadPool() const {
+  return current_pool == this;
+}
+
+void WorkStealingThreadPool::run(const std::function<void()>& func) {
+  if (threads_.empty()) {
+    throw std::runtime_error("No threads to run a task");
+  }
+  // Pool threads submit to their own deque so nested fork tasks run
+  // LIFO without touching anyone else's lock; external submitters are
+  // spread round-robin.
+  const size_t index = (current_pool == this)
+      ? current_worker_index
+      : next_worker_.fetch_add(1) % workers_.size();
+  {
+    std::lock_guard<std::mutex> guard(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(func);
+  }
+  pending_.fetch_add(1);
+  // See the comment on pending_ for why this unsynchronized check is
+  // safe: a worker going idle re-checks pending_ after registering on
+  // the idle list.
+  if (idle_.load() > 0) {
+    std::lock_guard<std::mutex> guard(sleep_mutex_);
+    sleep_condition_.notify_one();
+  }
+}
+
+bool WorkStealingThreadPool::try_pop_local(
+    size_t index,
+    std::function<void()>& task) {
+  Worker& worker = *workers_[index];
+  std::lock_guard<std::mutex> guard(worker.mutex);
+  if (worker.tasks.empty()) {
+    return false;
+  }
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+bool WorkStealingThreadPool::try_steal(
+    size_t index,
+    std::function<void()>& task) {
+  const size_t num_workers = workers_.size();
+  if (num_workers <= 1) {
+    return false;
+  }
+  // Randomize the first victim so concurrent thieves spread out instead
+  // of all hammering worker 0.
+  thread_local std::mt19937 rng(std::random_device{}());
+  const size_t start = rng() % num_workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    const size_t victim = (start + i) % num_workers;
+    if (victim == index) {
+      continue;
+    }
+    Worker& worker = *workers_[victim];
+    // Skip victims whose lock is busy; pending_ keeps us scanning until
+    // every submitted task has been claimed by someone.
+    std::unique_lock<std::mutex> guard(worker.mutex, std::try_to_lock);
+    if (!guard.owns_lock() || worker.tasks.empty()) {
+      continue;
+    }
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void WorkStealingThreadPool::main_loop(size_t index) {
+  std::function<void()> task;
+  while (running_.load()) {
+    if (try_pop_local(index, task) || try_steal(index, task)) {
+      pending_.fetch_sub(1);
+      try {
+        task();
+      } catch (const std::exception&) {
+      }
+      // Destroy captured state promptly, matching ThreadPool's behavior
+      // for tasks holding shared_ptrs.
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    ++idle_;
+    if (pending_.load() == 0 && running_.load()) {
+      sleep_condition_.wait(lock);
+    }
+    --idle_;
+  }
+}
+
+} // namespace c10
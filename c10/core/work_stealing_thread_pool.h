@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <c10/core/thread_pool.h>
+
+namespace c10 {
+
+/**
+ * A work-stealing task pool behind the TaskThreadPoolBase interface.
+ *
+ * Unlike ThreadPool, which funnels every submission and every dequeue
+ * through one mutex and one std::queue, each worker here owns a deque
+ * guarded by its own mutex. Workers pop their own deque from the back
+ * (LIFO, so nested fork tasks run while their state is still warm) and
+ * steal from other workers' fronts (FIFO) when theirs runs dry, starting
+ * at a randomized victim so concurrent thieves spread out. Submissions
+ * from pool threads go to the submitter's own deque; external
+ * submissions are distributed round-robin. At high task rates the
+ * per-worker locks see almost no contention, which is what serialized
+ * fork-join scripted models on the old single-queue pool.
+ *
+ * Like ThreadPool, shutdown does not drain: tasks still queued when the
+ * pool is destroyed are dropped.
+ */
+class C10_API WorkStealingThreadPool : public TaskThreadPoolBase {
+ public:
+  WorkStealingThreadPool() = delete;
+
+  explicit WorkStealingThreadPool(
+      int pool_size,
+      int numa_node_id = -1,
+      std::function<void()> init_thread = nullptr);
+
+  ~WorkStealingThreadPool() override;
+
+  void run(const std::function<void()>& func) override;
+
+  size_t size() const override;
+
+  /**
+   * The number of workers currently sleeping on the idle list. Workers
+   * between tasks that are still scanning for work are not counted.
+   */
+  size_t numAvailable() const override;
+
+  bool inThreadPool() const override;
+
+ private:
+  // One per worker thread. The owner pops from the back; thieves and
+  // external submitters touch the front/back under the same mutex, which
+  // is only ever held for a push or a pop.
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool try_pop_local(size_t index, std::function<void()>& task);
+  bool try_steal(size_t index, std::function<void()>& task);
+  void main_loop(size_t index);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_worker_;
+  // Number of submitted but not yet claimed tasks. Together with idle_
+  // this forms the sleep/wake handshake: submitters bump pending_ before
+  // checking idle_, sleepers bump idle_ (under sleep_mutex_) before
+  // re-checking pending_, so one of the two sides always sees the other.
+  std::atomic<size_t> pending_;
+  std::atomic<size_t> idle_;
+  std::atomic<bool> running_;
+  int numa_node_id_;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
+};
+
+} // namespace c10
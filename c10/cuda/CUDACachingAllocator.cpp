@@ -8,6 +8,7 @@
 #include <cuda_runtime_api.h>
 #include <algorithm>
 #include <bitset>
+#include <chrono>
 #include <deque>
 #include <iterator>
 #include <map>
@@ -21,6 +22,7 @@
 namespace c10 {
 
 C10_DEFINE_REGISTRY(FreeCudaMemoryCallbacksRegistry, FreeMemoryCallback);
+C10_DEFINE_REGISTRY(CudaMemoryPressureCallbacksRegistry, MemoryPressureCallback);
 
 namespace cuda {
 namespace CUDACachingAllocator {
@@ -175,6 +177,9 @@ class THCCachingAllocator {
   // device statistics
   std::vector<DeviceStats> device_stats;
 
+  // per-device caps on reserved bytes (0 = unlimited); see setMemoryLimit
+  std::vector<size_t> memory_limits;
+
   // unallocated cached blocks larger than 1 MB
   BlockPool large_blocks;
 
@@ -187,6 +192,21 @@ class THCCachingAllocator {
   // outstanding cuda events
   std::deque<std::pair<cudaEvent_t, Block*>> cuda_events;
 
+  // whether a CUDA graph capture is underway, and under which id
+  bool capture_underway = false;
+  uint64_t capture_id = 0;
+
+  // blocks freed during a capture, parked until the capturing graph is
+  // destroyed so their addresses stay valid across replays
+  std::unordered_map<uint64_t, std::vector<Block*>> capture_reserved_blocks;
+
+  // ring buffer of allocator events (see MemoryEvent in the header);
+  // event_ring.empty() means recording is disabled
+  std::vector<MemoryEvent> event_ring;
+  size_t event_ring_head = 0;  // index of the oldest buffered event
+  size_t event_ring_count = 0;
+  uint64_t events_overwritten = 0;
+
  public:
 
   THCCachingAllocator() :
@@ -246,12 +266,17 @@ class THCCachingAllocator {
     if (block == nullptr) {
       void* ptr;
       size_t alloc_size = get_allocation_size(size);
-      cudaError_t err = cuda_malloc_with_retry(device, &ptr, alloc_size);
+      const size_t memory_limit = memory_limit_for_device(device);
+      cudaError_t err = cudaErrorMemoryAllocation;
+      if (reserve_within_limit(device, alloc_size)) {
+        err = cuda_malloc_with_retry(device, &ptr, alloc_size);
+      }
 
       if (err == cudaSuccess) {
         block = new Block(device, stream, alloc_size, &pool, ptr);
         update_stat_array(stats.segment, 1, stat_types);
         update_stat_array(stats.reserved_bytes, alloc_size, stat_types);
+        record_event(MemoryEventType::SEGMENT_ALLOC, device, alloc_size, ptr);
       } else if (err == cudaErrorMemoryAllocation) {
         cudaGetLastError();  // clear CUDA error
 
@@ -278,6 +303,10 @@ class THCCachingAllocator {
         // Note that at this point cuda_malloc_with_retry has already returned all
         // possible "cached" memory to the driver. The only remaining "cached"
         // memory is split from a larger block that is partially in-use.
+        std::string limit_note;
+        if (memory_limit != 0) {
+          limit_note = "; " + format_size(memory_limit) + " per-process limit";
+        }
         AT_ERROR(
           "CUDA out of memory. Tried to allocate ", format_size(alloc_size),
           " (GPU ", device, "; ",
@@ -286,7 +315,7 @@ class THCCachingAllocator {
           " already allocated; ",
           format_size(device_free), " free; ",
           format_size(stats.reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)].current),
-          " reserved in total by PyTorch)");
+          " reserved in total by PyTorch", limit_note, ")");
       } else {
         C10_CUDA_CHECK(err);
       }
@@ -335,6 +364,7 @@ class THCCachingAllocator {
     update_stat_array(stats.allocated_bytes, block->size, stat_types);
     update_stat_array(stats.active, 1, stat_types);
     update_stat_array(stats.active_bytes, block->size, stat_types);
+    record_event(MemoryEventType::ALLOC, device, block->size, block->ptr);
   }
 
   void free(void* ptr)
@@ -359,8 +389,15 @@ class THCCachingAllocator {
     stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
     update_stat_array(stats.allocation, -1, {stat_types});
     update_stat_array(stats.allocated_bytes, -block->size, {stat_types});
-
-    if (!block->stream_uses.empty()) {
+    record_event(
+        MemoryEventType::FREE, block->device, block->size, block->ptr);
+
+    if (capture_underway) {
+      // Captured kernels reference this address on every replay; park the
+      // block until the graph is destroyed. Note the block stays counted as
+      // active until then.
+      capture_reserved_blocks[capture_id].push_back(block);
+    } else if (!block->stream_uses.empty()) {
       insert_events(block);
     } else {
       free_block(block);
@@ -412,6 +449,9 @@ class THCCachingAllocator {
   /** returns cached blocks to the system allocator **/
   void emptyCache() {
     std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        !capture_underway,
+        "emptyCache is not allowed during CUDA graph capture");
     synchronize_and_free_events(nullopt);
     free_blocks(large_blocks, large_blocks.begin(), large_blocks.end());
     free_blocks(small_blocks, small_blocks.begin(), small_blocks.end());
@@ -467,6 +507,128 @@ class THCCachingAllocator {
     }
   }
 
+  /** starts event recording into a fresh ring of `capacity` entries **/
+  void enableEventRecording(size_t capacity) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(capacity > 0, "event ring capacity must be positive");
+    event_ring.assign(capacity, MemoryEvent());
+    event_ring_head = 0;
+    event_ring_count = 0;
+    events_overwritten = 0;
+  }
+
+  void disableEventRecording() {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    event_ring.clear();
+    event_ring_head = 0;
+    event_ring_count = 0;
+    events_overwritten = 0;
+  }
+
+  /** returns the buffered events in chronological order and clears them **/
+  MemoryEventStream drainEvents() {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    MemoryEventStream stream;
+    stream.events.reserve(event_ring_count);
+    for (size_t i = 0; i < event_ring_count; ++i) {
+      stream.events.push_back(
+          event_ring[(event_ring_head + i) % event_ring.size()]);
+    }
+    stream.overwritten = events_overwritten;
+    event_ring_head = 0;
+    event_ring_count = 0;
+    events_overwritten = 0;
+    return stream;
+  }
+
+  /** Returns the fraction of cached free memory not covered by the largest free block **/
+  double getFragmentation(int dev_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    size_t total = 0;
+    size_t largest = 0;
+    cache_info_aux(large_blocks, dev_id, &total, &largest);
+    cache_info_aux(small_blocks, dev_id, &total, &largest);
+    if (total == 0) {
+      return 0.0;
+    }
+    return 1.0 - static_cast<double>(largest) / static_cast<double>(total);
+  }
+
+  /** Returns idle cached memory on the device to the driver; see header **/
+  size_t compactCache(int dev_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        !capture_underway,
+        "compactCache is not allowed during CUDA graph capture");
+    const size_t reserved_before = get_stats_for_device(dev_id)
+        .reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)].current;
+    // Waits on outstanding events so that event-held blocks rejoin the cache
+    // and merge with their neighbors before we decide what is releasable.
+    free_cached_blocks(dev_id);
+    const size_t reserved_after = get_stats_for_device(dev_id)
+        .reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)].current;
+    return reserved_before - reserved_after;
+  }
+
+  /** Caps the bytes reserved on the device (0 = unlimited); see header **/
+  void setMemoryLimit(int dev_id, size_t limit) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (dev_id >= static_cast<int>(memory_limits.size())) {
+      memory_limits.resize(dev_id + 1, 0);
+    }
+    memory_limits[dev_id] = limit;
+  }
+
+  /** Returns the reservation cap for the device (0 = unlimited) **/
+  size_t getMemoryLimit(int dev_id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return memory_limit_for_device(dev_id);
+  }
+
+  /** Enters capture mode; blocks freed until notifyCaptureEnd are parked **/
+  void notifyCaptureBegin(uint64_t id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        !capture_underway,
+        "Only one CUDA graph capture may be underway at a time");
+    TORCH_CHECK(
+        capture_reserved_blocks.count(id) == 0,
+        "Capture id ", id, " was already used");
+    capture_underway = true;
+    capture_id = id;
+    capture_reserved_blocks[id];  // creates the (possibly empty) reserve list
+  }
+
+  /** Leaves capture mode; the capture's reserve list stays parked **/
+  void notifyCaptureEnd(uint64_t id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        capture_underway && capture_id == id,
+        "notifyCaptureEnd for capture id ", id, " which is not underway");
+    capture_underway = false;
+  }
+
+  /** Returns a destroyed graph's parked blocks to the cache **/
+  void releaseCaptureReserves(uint64_t id) {
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    TORCH_CHECK(
+        !(capture_underway && capture_id == id),
+        "releaseCaptureReserves called while capture id ", id,
+        " is still underway");
+    auto it = capture_reserved_blocks.find(id);
+    if (it == capture_reserved_blocks.end()) {
+      return;
+    }
+    for (Block* block : it->second) {
+      if (!block->stream_uses.empty()) {
+        insert_events(block);
+      } else {
+        free_block(block);
+      }
+    }
+    capture_reserved_blocks.erase(it);
+  }
+
   /** Dump a complete snapshot of the memory held by the allocator. Potentially VERY expensive. **/
   std::vector<SegmentInfo> snapshot() const {
     std::lock_guard<std::recursive_mutex> lock(mutex);
@@ -482,6 +644,7 @@ class THCCachingAllocator {
       SegmentInfo& segment_info = result.back();
       segment_info.device = head_block->device;
       segment_info.address = reinterpret_cast<int64_t>(head_block->ptr);
+      segment_info.stream = head_block->stream;
       segment_info.is_large = (head_block->pool == &large_blocks);
 
       const Block* block = head_block;
@@ -527,6 +690,37 @@ class THCCachingAllocator {
     return device_stats.at(device);
   }
 
+  /** appends an event to the ring, overwriting the oldest when full **/
+  void record_event(MemoryEventType type, int device, int64_t size, void* ptr)
+  {
+    if (event_ring.empty()) {
+      return;
+    }
+    MemoryEvent event;
+    event.timestamp_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    event.type = type;
+    event.device = device;
+    event.size = size;
+    event.addr = reinterpret_cast<int64_t>(ptr);
+    DeviceStats& stats = get_stats_for_device(device);
+    event.allocated_bytes =
+        stats.allocated_bytes[static_cast<size_t>(StatType::AGGREGATE)].current;
+    event.reserved_bytes =
+        stats.reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)].current;
+    if (event_ring_count < event_ring.size()) {
+      event_ring[(event_ring_head + event_ring_count) % event_ring.size()] =
+          event;
+      ++event_ring_count;
+    } else {
+      event_ring[event_ring_head] = event;
+      event_ring_head = (event_ring_head + 1) % event_ring.size();
+      ++events_overwritten;
+    }
+  }
+
   std::vector<const Block*> get_all_blocks() const {
     std::vector<const Block*> blocks;
     blocks.insert(blocks.end(), small_blocks.begin(), small_blocks.end());
@@ -651,6 +845,63 @@ class THCCachingAllocator {
     }
   }
 
+  size_t memory_limit_for_device(int device) {
+    if (device >= 0 && device < static_cast<int>(memory_limits.size())) {
+      return memory_limits[device];
+    }
+    return 0;
+  }
+
+  size_t reserved_bytes_on_device(int device) {
+    return static_cast<size_t>(
+        get_stats_for_device(device)
+            .reserved_bytes[static_cast<size_t>(StatType::AGGREGATE)]
+            .current);
+  }
+
+  // Invokes the registered memory pressure callbacks; returns true if any
+  // of them claims to have released memory.  `limit` is the configured
+  // per-process cap, or 0 when the pressure comes from the device itself.
+  bool notify_memory_pressure(int device, size_t allocated, size_t limit) {
+    bool freed_memory = false;
+    for (const auto& name : CudaMemoryPressureCallbacksRegistry()->Keys()) {
+      freed_memory |= CudaMemoryPressureCallbacksRegistry()
+                          ->Create(name)
+                          ->Execute(device, allocated, limit);
+    }
+    return freed_memory;
+  }
+
+  // Enforces the per-process cap: when reserving `alloc_size` more bytes
+  // would exceed the device's limit, sheds cached blocks, then gives the
+  // pressure callbacks a chance to free tensors (re-entering the allocator
+  // is fine -- the mutex is recursive), and re-checks.  Returns false if
+  // the reservation still does not fit.
+  bool reserve_within_limit(int device, size_t alloc_size) {
+    const size_t limit = memory_limit_for_device(device);
+    if (limit == 0) {
+      return true;
+    }
+    if (reserved_bytes_on_device(device) + alloc_size <= limit) {
+      return true;
+    }
+    if (!capture_underway) {
+      free_cached_blocks(device);
+      if (reserved_bytes_on_device(device) + alloc_size <= limit) {
+        return true;
+      }
+    }
+    if (notify_memory_pressure(device, reserved_bytes_on_device(device), limit)) {
+      if (!capture_underway) {
+        free_cached_blocks(device);
+      }
+      if (reserved_bytes_on_device(device) + alloc_size <= limit) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   cudaError_t cuda_malloc_with_retry(int device, void** devPtr, size_t size)
   {
     // Try cudaMalloc. If cudaMalloc fails, frees all non-split cached blocks
@@ -661,10 +912,27 @@ class THCCachingAllocator {
       DeviceStats& stats = get_stats_for_device(device);
       stats.num_alloc_retries += 1;
       cudaGetLastError();  // reset the last CUDA error
+      if (capture_underway) {
+        // cudaFree is illegal during stream capture; surface the failure
+        // rather than flushing the cache.
+        return err;
+      }
       free_cached_blocks(device);
       err = cudaMalloc(devPtr, size);
       if (err != cudaSuccess) {
-        return err;
+        cudaGetLastError();  // reset the last CUDA error
+        // The device itself is out of memory even with our cache flushed --
+        // typically a sibling process is crowding it.  Give the registered
+        // pressure callbacks one chance to shed memory before giving up.
+        if (!notify_memory_pressure(
+                device, reserved_bytes_on_device(device), /*limit=*/0)) {
+          return err;
+        }
+        free_cached_blocks(device);
+        err = cudaMalloc(devPtr, size);
+        if (err != cudaSuccess) {
+          return err;
+        }
       }
     }
 
@@ -705,6 +973,11 @@ class THCCachingAllocator {
         stat_types[static_cast<size_t>(get_stat_type_for_pool(*(block->pool)))] = true;
         update_stat_array(stats.segment, -1, stat_types);
         update_stat_array(stats.reserved_bytes, -block->size, stat_types);
+        record_event(
+            MemoryEventType::SEGMENT_FREE,
+            block->device,
+            block->size,
+            block->ptr);
 
         auto cur = it;
         ++it;
@@ -895,6 +1168,50 @@ std::vector<SegmentInfo> snapshot() {
   return caching_allocator.snapshot();
 }
 
+void enableMemoryEventRecording(size_t capacity) {
+  caching_allocator.enableEventRecording(capacity);
+}
+
+void disableMemoryEventRecording() {
+  caching_allocator.disableEventRecording();
+}
+
+MemoryEventStream drainMemoryEvents() {
+  return caching_allocator.drainEvents();
+}
+
+double getFragmentation(int device) {
+  assertValidDevice(device);
+  return caching_allocator.getFragmentation(device);
+}
+
+size_t compactCache(int device) {
+  assertValidDevice(device);
+  return caching_allocator.compactCache(device);
+}
+
+void setMemoryLimit(int device, size_t limit) {
+  assertValidDevice(device);
+  caching_allocator.setMemoryLimit(device, limit);
+}
+
+size_t getMemoryLimit(int device) {
+  assertValidDevice(device);
+  return caching_allocator.getMemoryLimit(device);
+}
+
+void notifyCaptureBegin(uint64_t capture_id) {
+  caching_allocator.notifyCaptureBegin(capture_id);
+}
+
+void notifyCaptureEnd(uint64_t capture_id) {
+  caching_allocator.notifyCaptureEnd(capture_id);
+}
+
+void releaseCaptureReserves(uint64_t capture_id) {
+  caching_allocator.releaseCaptureReserves(capture_id);
+}
+
 //
 // In CUDA IPC, sender sends a tensor to receiver, getIpcDevPtr
 // is called by the receiving process to map the CUDA memory from the sending
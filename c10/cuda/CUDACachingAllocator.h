@@ -23,6 +23,25 @@ C10_DECLARE_REGISTRY(FreeCudaMemoryCallbacksRegistry, FreeMemoryCallback);
 #define REGISTER_FREE_MEMORY_CALLBACK(name, ...) \
   C10_REGISTER_CLASS(FreeCudaMemoryCallbacksRegistry, name, __VA_ARGS__);
 
+// Executed when a device is under memory pressure: either an allocation
+// would push this process over its per-device limit (see
+// CUDACachingAllocator::setMemoryLimit), or the driver itself reported
+// out-of-memory even after the cache was flushed (in which case `limit` is
+// 0 -- typically a sibling process is crowding the device).  `allocated` is
+// the number of bytes currently reserved by this process on `device`.
+// Return true after releasing memory so the allocator re-checks the limit
+// (or retries the cudaMalloc).  Callbacks may free tensors, which re-enters
+// the allocator; that is safe.
+class C10_CUDA_API MemoryPressureCallback {
+ public:
+  virtual ~MemoryPressureCallback() {};
+  virtual bool Execute(int device, size_t allocated, size_t limit) = 0;
+};
+
+C10_DECLARE_REGISTRY(CudaMemoryPressureCallbacksRegistry, MemoryPressureCallback);
+#define REGISTER_CUDA_MEMORY_PRESSURE_CALLBACK(name, ...) \
+  C10_REGISTER_CLASS(CudaMemoryPressureCallbacksRegistry, name, __VA_ARGS__);
+
 namespace cuda {
 
 // TODO: Turn this into an honest to goodness class. I briefly attempted to do
@@ -97,10 +116,55 @@ struct SegmentInfo {
   int64_t total_size = 0;
   int64_t allocated_size = 0;
   int64_t active_size = 0;
+  // All blocks carved from a segment share its allocation stream; cached
+  // blocks can only be reused by allocations on this stream.
+  cudaStream_t stream = nullptr;
   bool is_large = false;
   std::vector<BlockInfo> blocks;
 };
 
+// Allocator event stream: a bounded ring buffer of alloc/free/segment
+// events, timestamped so an external agent can scrape memory behavior per
+// request window and catch leak-like growth before an OOM. Pair with
+// resetPeakStats() for rolling per-window high-water marks.
+enum struct MemoryEventType : uint8_t {
+  // client-visible allocation and free (malloc/free on the allocator)
+  ALLOC = 0,
+  FREE = 1,
+  // segment acquired from / returned to the driver (cudaMalloc/cudaFree)
+  SEGMENT_ALLOC = 2,
+  SEGMENT_FREE = 3,
+};
+
+struct MemoryEvent {
+  // steady-clock nanoseconds; comparable across events within the process
+  int64_t timestamp_ns = 0;
+  MemoryEventType type = MemoryEventType::ALLOC;
+  int64_t device = 0;
+  int64_t size = 0;
+  int64_t addr = 0;
+  // Aggregate allocated/reserved bytes on `device` after the event, so a
+  // scraper can plot the curve without replaying from the beginning.
+  int64_t allocated_bytes = 0;
+  int64_t reserved_bytes = 0;
+};
+
+struct MemoryEventStream {
+  // Chronological. At most the configured ring capacity per drain.
+  std::vector<MemoryEvent> events;
+  // Events lost to ring overflow since the previous drain; nonzero means
+  // the consumer should drain more often or enlarge the ring.
+  uint64_t overwritten = 0;
+};
+
+// Starts recording allocator events into a ring of `capacity` entries
+// (replacing any previous ring). Recording costs one clock read and one
+// ring store per event under the allocator lock.
+C10_CUDA_API void enableMemoryEventRecording(size_t capacity);
+C10_CUDA_API void disableMemoryEventRecording();
+// Returns and clears the buffered events.
+C10_CUDA_API MemoryEventStream drainMemoryEvents();
+
 C10_CUDA_API void* raw_alloc(size_t nbytes);
 C10_CUDA_API void raw_delete(void* ptr);
 
@@ -114,6 +178,53 @@ C10_CUDA_API void resetAccumulatedStats(int device);
 C10_CUDA_API void resetPeakStats(int device);
 C10_CUDA_API std::vector<SegmentInfo> snapshot();
 
+// Fraction of the device's cached-but-free memory that is unusable for a
+// single allocation of the largest-free-block size: 1 - largest_free_block /
+// total_free_cached. 0 means the cache could satisfy one request as large as
+// everything it holds; values close to 1 mean the cache is shattered into
+// many small blocks. Returns 0 when nothing is cached.
+C10_CUDA_API double getFragmentation(int device);
+
+// On-demand defragmentation pass for one device. Returns outstanding
+// event-held blocks to the cache (synchronizing on their events), merges
+// adjacent free blocks, and releases every idle, unsplit segment back to the
+// driver so subsequent cudaMallocs can carve contiguous memory again.
+// Blocks split from a partially-active segment cannot be migrated -- client
+// pointers into them are stable -- so those stay cached. Returns the number
+// of bytes released to the driver.
+C10_CUDA_API size_t compactCache(int device);
+
+// Per-process cap on the total bytes the allocator may reserve on `device`
+// through cudaMalloc (0 = unlimited, the default), for co-locating several
+// processes on one GPU.  When an allocation would push the reservation over
+// the limit, the allocator first sheds its own cached blocks, then invokes
+// any registered memory pressure callbacks (see MemoryPressureCallback
+// above), and only raises the usual out-of-memory error if the reservation
+// still does not fit.  Lowering the limit below the current reservation
+// does not reclaim anything by itself; the cap applies to future
+// reservations (call emptyCache()/compactCache() to shrink eagerly).
+C10_CUDA_API void setMemoryLimit(int device, size_t limit);
+C10_CUDA_API size_t getMemoryLimit(int device);
+
+// CUDA graph capture support (see ATen/cuda/CUDAGraph.h).
+//
+// Kernels captured into a CUDA graph bake in the device addresses they were
+// launched with, so between capture and the last replay the allocator must
+// neither recycle blocks freed during capture nor release memory to the
+// driver. While a capture (identified by the caller-chosen id) is underway:
+// - blocks freed through the allocator are parked on a per-capture reserve
+//   list instead of rejoining the cache;
+// - emptyCache()/compactCache() are refused (cudaFree is illegal during
+//   capture anyway);
+// - the malloc retry path does not flush the cache.
+// notifyCaptureEnd() ends the capture but keeps the reserve list alive, so
+// the captured addresses stay owned across replays; releaseCaptureReserves()
+// returns them to the cache once the graph is destroyed. Only one capture
+// may be underway at a time.
+C10_CUDA_API void notifyCaptureBegin(uint64_t capture_id);
+C10_CUDA_API void notifyCaptureEnd(uint64_t capture_id);
+C10_CUDA_API void releaseCaptureReserves(uint64_t capture_id);
+
 C10_CUDA_API std::mutex* getFreeMutex();
 
 C10_CUDA_API std::shared_ptr<void> getIpcDevPtr(std::string handle);
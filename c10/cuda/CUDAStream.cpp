@@ -46,7 +46,6 @@ static constexpr unsigned int kDefaultFlags = cudaStreamNonBlocking;
 // Note: stream priority is not supported by HIP
 // Note: lower numbers are higher priorities, zero is default priority
 #ifndef __HIP_PLATFORM_HCC__
-static int kHighPriority = -1;
 static int kLowPriority = 0;
 #endif // __HIP_PLATFORM_HCC__
 
@@ -222,6 +221,17 @@ static void initDeviceStreamState(DeviceIndex device_index) {
   // with it.
   CUDAGuard device_guard{device_index};
 
+#ifndef __HIP_PLATFORM_HCC__
+  // The high priority pool uses the strongest priority the device supports
+  // (not a hard-coded -1; some devices expose more than two levels), so
+  // e.g. communication kernels launched on it overtake long-running
+  // compute kernels from any other stream.
+  int least_priority = 0;
+  int greatest_priority = 0;
+  C10_CUDA_CHECK(cudaDeviceGetStreamPriorityRange(
+      &least_priority, &greatest_priority));
+#endif // __HIP_PLATFORM_HCC__
+
   for (auto i = decltype(kStreamsPerPool){0}; i < kStreamsPerPool; ++i) {
     auto& lowpri_stream = low_priority_streams[device_index][i];
     auto& hipri_stream = high_priority_streams[device_index][i];
@@ -233,7 +243,7 @@ static void initDeviceStreamState(DeviceIndex device_index) {
     C10_CUDA_CHECK(cudaStreamCreateWithPriority(
         &lowpri_stream.stream, kDefaultFlags, kLowPriority));
     C10_CUDA_CHECK(cudaStreamCreateWithPriority(
-        &hipri_stream.stream, kDefaultFlags, kHighPriority));
+        &hipri_stream.stream, kDefaultFlags, greatest_priority));
 #else
     C10_CUDA_CHECK(
         cudaStreamCreateWithFlags(&lowpri_stream.stream, kDefaultFlags));
@@ -345,6 +355,43 @@ CUDAStream getStreamFromPool(
   return CUDAStream_fromInternals(&low_priority_streams[device_index][idx]);
 }
 
+StreamPoolStats getStreamPoolStats(DeviceIndex device_index) {
+  initCUDAStreamsOnce();
+  if (device_index == -1) {
+    device_index = current_device();
+  }
+  check_gpu(device_index);
+
+  StreamPoolStats stats;
+  stats.pool_size = kStreamsPerPool;
+  stats.low_priority_requested = low_priority_counters[device_index].load();
+  stats.high_priority_requested = high_priority_counters[device_index].load();
+
+  // The pools are created lazily by the first getStreamFromPool on this
+  // device; before that, there is nothing to query.
+  if (low_priority_streams[device_index][0].stream == nullptr) {
+    return stats;
+  }
+
+  CUDAGuard device_guard{device_index};
+  auto count_busy =
+      [](const std::array<LeakyStreamInternals, kStreamsPerPool>& streams) {
+        int busy = 0;
+        for (const auto& internals : streams) {
+          cudaError_t err = cudaStreamQuery(internals.stream);
+          if (err == cudaErrorNotReady) {
+            busy++;
+          } else if (err != cudaSuccess) {
+            C10_CUDA_CHECK(err);
+          }
+        }
+        return busy;
+      };
+  stats.low_priority_busy = count_busy(low_priority_streams[device_index]);
+  stats.high_priority_busy = count_busy(high_priority_streams[device_index]);
+  return stats;
+}
+
 CUDAStream getDefaultCUDAStream(DeviceIndex device_index) {
   initCUDAStreamsOnce();
   if (device_index == -1) {
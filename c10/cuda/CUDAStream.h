@@ -9,6 +9,7 @@
 #include <c10/cuda/CUDAMacros.h>
 #include <c10/core/DeviceGuard.h>
 #include <c10/util/Exception.h>
+#include <c10/util/FlightRecorder.h>
 #include <c10/core/Stream.h>
 
 /*
@@ -115,6 +116,8 @@ public:
   }
 
   void synchronize() const {
+    FlightRecord(
+        FlightEventType::SYNC, "stream", static_cast<uint64_t>(stream_.id()));
     DeviceGuard guard{stream_.device()};
     C10_CUDA_CHECK(cudaStreamSynchronize(stream()));
   }
@@ -184,6 +187,30 @@ private:
 CAFFE2_API CUDAStream
 getStreamFromPool(const bool isHighPriority = false, DeviceIndex device = -1);
 
+/**
+ * Occupancy snapshot of a device's stream pools, for schedulers that want
+ * to decide which pool to draw from (or whether to wait).  "requested"
+ * counts are monotonic: each pool holds kStreamsPerPool distinct streams,
+ * so once more than pool_size streams have been requested, further
+ * requests wrap around and share streams with earlier ones.  "busy" counts
+ * how many of the pool's streams currently have pending work (in the
+ * cudaStreamQuery sense); it is 0 if the device's pools have not been
+ * initialized yet.
+ */
+struct StreamPoolStats {
+  uint64_t low_priority_requested = 0;
+  uint64_t high_priority_requested = 0;
+  int low_priority_busy = 0;
+  int high_priority_busy = 0;
+  int pool_size = 0;
+};
+
+/**
+ * Get an occupancy snapshot of the stream pools for the passed CUDA
+ * device, or for the current device if no device index is passed.
+ */
+CAFFE2_API StreamPoolStats getStreamPoolStats(DeviceIndex device_index = -1);
+
 /**
  * Get the default CUDA stream, for the passed CUDA device, or for the
  * current device if no device index is passed.  The default stream is
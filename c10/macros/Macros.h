@@ -123,6 +123,17 @@ namespace at { namespace cuda { using namespace c10::hip; }}
 #define C10_NORETURN __attribute__((noreturn))
 #endif
 
+// C10_COLD
+//
+// Marks a function as rarely called (e.g. the throwing half of an error
+// check), so the compiler optimizes it for size and moves it out of the
+// hot text section.
+#if defined(__GNUC__) || defined(__clang__)
+#define C10_COLD __attribute__((cold))
+#else
+#define C10_COLD
+#endif
+
 // C10_LIKELY/C10_UNLIKELY
 //
 // These macros provide parentheses, so you can use these macros as:
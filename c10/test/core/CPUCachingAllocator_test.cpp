@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/CPUCachingAllocator.h>
+
+using namespace c10;
+
+TEST(CPUCachingAllocatorTest, ReusesBlocksOfSameSizeClass) {
+  CPUCachingAllocator::emptyThreadCache();
+  void* ptr = CPUCachingAllocator::raw_allocate(1000);
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % gAlignment, 0);
+  CPUCachingAllocator::raw_deallocate(ptr);
+  ASSERT_GT(CPUCachingAllocator::currentThreadCachedBytes(), 0);
+  // Same size class (rounded to 1024) must come back from the cache.
+  void* again = CPUCachingAllocator::raw_allocate(700);
+  ASSERT_EQ(again, ptr);
+  CPUCachingAllocator::raw_deallocate(again);
+  CPUCachingAllocator::emptyThreadCache();
+  ASSERT_EQ(CPUCachingAllocator::currentThreadCachedBytes(), 0);
+}
+
+TEST(CPUCachingAllocatorTest, LargeBlocksBypassCache) {
+  CPUCachingAllocator::emptyThreadCache();
+  void* ptr = CPUCachingAllocator::raw_allocate(4 << 20);
+  ASSERT_NE(ptr, nullptr);
+  CPUCachingAllocator::raw_deallocate(ptr);
+  ASSERT_EQ(CPUCachingAllocator::currentThreadCachedBytes(), 0);
+}
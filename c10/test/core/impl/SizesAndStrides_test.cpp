@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/impl/SizesAndStrides.h>
+
+using namespace c10;
+using namespace c10::impl;
+
+static void checkData(
+    const SizesAndStrides& sz,
+    IntArrayRef sizes,
+    IntArrayRef strides) {
+  EXPECT_EQ(sizes.size(), strides.size())
+      << "bad test case: size() of sizes and strides don't match";
+  EXPECT_EQ(sz.size(), sizes.size());
+  EXPECT_TRUE(sz.sizes_arrayref().equals(sizes));
+  EXPECT_TRUE(sz.strides_arrayref().equals(strides));
+}
+
+TEST(SizesAndStridesTest, DefaultConstructor) {
+  SizesAndStrides sz;
+  checkData(sz, {0}, {1});
+}
+
+TEST(SizesAndStridesTest, SetSizes) {
+  SizesAndStrides sz;
+  sz.set_sizes({5, 6, 7, 8});
+  checkData(sz, {5, 6, 7, 8}, {1, 0, 0, 0});
+}
+
+TEST(SizesAndStridesTest, Resize) {
+  SizesAndStrides sz;
+
+  // Grow within the inline buffer; newly exposed elements are zeroed.
+  sz.resize(2);
+  checkData(sz, {0, 0}, {1, 0});
+
+  sz.size_at(1) = 3;
+  sz.stride_at(1) = 4;
+  checkData(sz, {0, 3}, {1, 4});
+
+  // Shrinking and growing back re-zeroes the vacated slots.
+  sz.resize(1);
+  checkData(sz, {0}, {1});
+  sz.resize(2);
+  checkData(sz, {0, 0}, {1, 0});
+
+  // Grow past the inline buffer (5) and back.
+  sz.size_at(0) = 1;
+  sz.stride_at(0) = 2;
+  sz.resize(7);
+  checkData(sz, {1, 0, 0, 0, 0, 0, 0}, {2, 0, 0, 0, 0, 0, 0});
+  for (size_t ii = 0; ii < sz.size(); ++ii) {
+    sz.size_at(ii) = ii + 1;
+    sz.stride_at(ii) = 2 * (ii + 1);
+  }
+  checkData(sz, {1, 2, 3, 4, 5, 6, 7}, {2, 4, 6, 8, 10, 12, 14});
+
+  // Out-of-line to out-of-line growth preserves the overlap.
+  sz.resize(9);
+  checkData(sz, {1, 2, 3, 4, 5, 6, 7, 0, 0}, {2, 4, 6, 8, 10, 12, 14, 0, 0});
+
+  // Shrink back into the inline buffer.
+  sz.resize(3);
+  checkData(sz, {1, 2, 3}, {2, 4, 6});
+}
+
+TEST(SizesAndStridesTest, CopyAndMove) {
+  SizesAndStrides sz;
+  sz.set_sizes({5, 6, 7, 8, 9, 10});
+  for (size_t ii = 0; ii < sz.size(); ++ii) {
+    sz.stride_at(ii) = ii;
+  }
+
+  SizesAndStrides copied(sz);
+  checkData(copied, {5, 6, 7, 8, 9, 10}, {0, 1, 2, 3, 4, 5});
+
+  SizesAndStrides assigned;
+  assigned = sz;
+  checkData(assigned, {5, 6, 7, 8, 9, 10}, {0, 1, 2, 3, 4, 5});
+
+  SizesAndStrides moved(std::move(copied));
+  checkData(moved, {5, 6, 7, 8, 9, 10}, {0, 1, 2, 3, 4, 5});
+  // The moved-from object is reset to the default state.
+  checkData(copied, {0}, {1});
+}
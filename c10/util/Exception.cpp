@@ -63,6 +63,58 @@ void Error::AppendMessage(const std::string& new_msg) {
   msg_without_backtrace_ = msg_without_backtrace();
 }
 
+namespace detail {
+
+void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg) {
+  throw ::c10::Error({func, file, line}, msg);
+}
+
+void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg) {
+  throw ::c10::Error({func, file, line}, msg);
+}
+
+void torchIndexCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg) {
+  throw ::c10::IndexError({func, file, line}, msg);
+}
+
+void torchIndexCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg) {
+  throw ::c10::IndexError({func, file, line}, msg);
+}
+
+void torchInternalAssertFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* cond_msg,
+    const std::string& user_msg) {
+  throw ::c10::Error(
+      {func, file, line},
+      str(cond_msg,
+          file,
+          ":",
+          line,
+          ", please report a bug to PyTorch. ",
+          user_msg));
+}
+
+} // namespace detail
+
 namespace Warning {
 
 namespace {
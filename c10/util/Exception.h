@@ -130,6 +130,56 @@ inline std::string if_empty_then(std::string x, std::string y) {
   }
 }
 
+// Out-of-line, cold throw helpers backing the check macros below.
+// Routing the actual Error construction and throw through these keeps the
+// exception machinery out of the (typically inlined, hot) functions that
+// perform the checks; the failure branch at a call site reduces to message
+// assembly plus one call.  Distinct symbols for checks, index checks and
+// internal asserts also make convenient breakpoint targets.
+[[noreturn]] C10_API C10_COLD void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg);
+[[noreturn]] C10_API C10_COLD void torchCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg);
+[[noreturn]] C10_API C10_COLD void torchIndexCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const std::string& msg);
+[[noreturn]] C10_API C10_COLD void torchIndexCheckFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* msg);
+[[noreturn]] C10_API C10_COLD void torchInternalAssertFail(
+    const char* func,
+    const char* file,
+    uint32_t line,
+    const char* cond_msg,
+    const std::string& user_msg);
+
+// Assembles the user-supplied part of a TORCH_CHECK message.  The
+// non-template overloads keep the common cases cheap: with no extra
+// arguments or a single string literal, no std::string is constructed at
+// the call site at all.
+inline const char* torchCheckMsg(const char* default_msg) {
+  return default_msg;
+}
+inline const char* torchCheckMsg(
+    const char* /*default_msg*/,
+    const char* msg) {
+  return msg;
+}
+template <typename... Args>
+std::string torchCheckMsg(const char* /*default_msg*/, const Args&... args) {
+  return ::c10::str(args...);
+}
+
 }
 
 
@@ -197,24 +247,24 @@ inline std::string if_empty_then(std::string x, std::string y) {
 // (unlike assert()).
 //
 #ifdef C10_MOBILE
-#define TORCH_INTERNAL_ASSERT(cond, ...)      \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
-    C10_THROW_ERROR(Error,                    \
-        #cond " INTERNAL ASSERT FAILED at"    \
-        __FILE__                              \
-    );                                        \
+#define TORCH_INTERNAL_ASSERT(cond, ...)       \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {        \
+    ::c10::detail::torchCheckFail(             \
+        __func__,                              \
+        __FILE__,                              \
+        static_cast<uint32_t>(__LINE__),       \
+        #cond " INTERNAL ASSERT FAILED at"     \
+        __FILE__);                             \
   }
 #else
-#define TORCH_INTERNAL_ASSERT(cond, ...)      \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
-    C10_THROW_ERROR(Error, ::c10::str(        \
-        #cond " INTERNAL ASSERT FAILED at ",  \
-        __FILE__,                             \
-        ":",                                  \
-        __LINE__,                             \
-        ", please report a bug to PyTorch. ", \
-        ::c10::str(__VA_ARGS__)               \
-    ));                                       \
+#define TORCH_INTERNAL_ASSERT(cond, ...)          \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {           \
+    ::c10::detail::torchInternalAssertFail(       \
+        __func__,                                 \
+        __FILE__,                                 \
+        static_cast<uint32_t>(__LINE__),          \
+        #cond " INTERNAL ASSERT FAILED at ",      \
+        ::c10::str(__VA_ARGS__));                 \
   }
 #endif
 
@@ -238,50 +288,76 @@ inline std::string if_empty_then(std::string x, std::string y) {
 // simply raises an exception, it does NOT unceremoniously quit the process
 // (unlike CHECK() from glog.)
 //
+// Assembles the message for TORCH_CHECK; the default message is only used
+// when no extra arguments are given.  Message construction happens strictly
+// inside the failure branch of the checks below, so passing expensive-to-
+// format operands costs nothing while the check passes.
+#define TORCH_CHECK_MSG(cond, ...)                         \
+  (::c10::detail::torchCheckMsg(                           \
+      "Expected " #cond                                    \
+      " to be true, but got false.  "                      \
+      "(Could this error message be improved?  If so, "    \
+      "please report an enhancement request to PyTorch.)", \
+      ##__VA_ARGS__))
+
 #ifdef C10_MOBILE
 #define TORCH_CHECK(cond, ...)                \
   if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
-    C10_THROW_ERROR(Error,                    \
+    ::c10::detail::torchCheckFail(            \
+        __func__,                             \
+        __FILE__,                             \
+        static_cast<uint32_t>(__LINE__),      \
         #cond " CHECK FAILED at "             \
-        __FILE__                              \
-    );                                        \
+        __FILE__);                            \
   }
 #else
-#define TORCH_CHECK(cond, ...)                              \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {                     \
-    C10_THROW_ERROR(Error,                                  \
-      ::c10::detail::if_empty_then(                         \
-        ::c10::str(__VA_ARGS__),                            \
-        "Expected " #cond " to be true, but got false.  "   \
-        "(Could this error message be improved?  If so, "   \
-        "please report an enhancement request to PyTorch.)" \
-      )                                                     \
-    );                                                      \
+#define TORCH_CHECK(cond, ...)                \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
+    ::c10::detail::torchCheckFail(            \
+        __func__,                             \
+        __FILE__,                             \
+        static_cast<uint32_t>(__LINE__),      \
+        TORCH_CHECK_MSG(cond, ##__VA_ARGS__)); \
   }
 #endif
 // TODO: We're going to get a lot of similar looking string literals
 // this way; check if this actually affects binary size.
 
+// Like TORCH_CHECK, but takes a callable instead of message pieces: on
+// failure, `msg_fn` is invoked with no arguments and must return something
+// convertible to std::string.  Use this when even naming the operands for
+// operator<< is too expensive for the hot path, e.g. when the diagnostic
+// walks a graph or formats a whole container:
+//
+//    TORCH_CHECK_LAZY(valid, [&] { return dump_state(graph); });
+#define TORCH_CHECK_LAZY(cond, msg_fn)        \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
+    ::c10::detail::torchCheckFail(            \
+        __func__,                             \
+        __FILE__,                             \
+        static_cast<uint32_t>(__LINE__),      \
+        std::string((msg_fn)()));             \
+  }
+
 // Like TORCH_CHECK, but raises IndexErrors instead of Errors.
 #ifdef C10_MOBILE
 #define TORCH_CHECK_INDEX(cond, ...)          \
   if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
-    C10_THROW_ERROR(Error,                    \
+    ::c10::detail::torchIndexCheckFail(       \
+        __func__,                             \
+        __FILE__,                             \
+        static_cast<uint32_t>(__LINE__),      \
         #cond " INDEX CHECK FAILED at "       \
-        __FILE__                              \
-    );                                        \
+        __FILE__);                            \
   }
 #else
-#define TORCH_CHECK_INDEX(cond, ...)                        \
-  if (C10_UNLIKELY_OR_CONST(!(cond))) {                     \
-    C10_THROW_ERROR(IndexError,                             \
-      ::c10::detail::if_empty_then(                         \
-        ::c10::str(__VA_ARGS__),                            \
-        "Expected " #cond " to be true, but got false.  "   \
-        "(Could this error message be improved?  If so, "   \
-        "please report an enhancement request to PyTorch.)" \
-      )                                                     \
-    );                                                      \
+#define TORCH_CHECK_INDEX(cond, ...)          \
+  if (C10_UNLIKELY_OR_CONST(!(cond))) {       \
+    ::c10::detail::torchIndexCheckFail(       \
+        __func__,                             \
+        __FILE__,                             \
+        static_cast<uint32_t>(__LINE__),      \
+        TORCH_CHECK_MSG(cond, ##__VA_ARGS__)); \
   }
 #endif
 
@@ -0,0 +1,172 @@
+#include <c10/util/FlightRecorder.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace c10 {
+
+namespace detail {
+std::atomic<bool> flight_recorder_enabled{false};
+} // namespace detail
+
+namespace {
+
+// One ring per thread. Owned via shared_ptr by both the thread (through
+// its thread_local cache) and the registry, so the events of a thread
+// that exits before the dump are not lost.
+struct ThreadRing {
+  explicit ThreadRing(uint64_t id, size_t capacity)
+      : thread_id(id), events(capacity), mask(capacity - 1) {}
+
+  const uint64_t thread_id;
+  std::vector<FlightEvent> events;
+  const uint64_t mask;  // capacity - 1; capacity is a power of two
+  // Monotonic append counter; only the owning thread writes events.
+  uint64_t pos = 0;
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadRing>> rings;
+  size_t capacity = 0;
+  // Bumped on every EnableFlightRecorder so threads drop their cached
+  // ring (with the old capacity) and re-register.
+  std::atomic<uint64_t> generation{0};
+  uint64_t next_thread_id = 0;
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+struct ThreadCache {
+  std::shared_ptr<ThreadRing> ring;
+  uint64_t generation = 0;
+};
+
+ThreadRing& thread_ring() {
+  static thread_local ThreadCache cache;
+  auto& reg = registry();
+  const uint64_t generation = reg.generation.load(std::memory_order_acquire);
+  if (C10_UNLIKELY(!cache.ring || cache.generation != generation)) {
+    std::lock_guard<std::mutex> guard(reg.mutex);
+    cache.ring = std::make_shared<ThreadRing>(reg.next_thread_id++, reg.capacity);
+    cache.generation = generation;
+    reg.rings.push_back(cache.ring);
+  }
+  return *cache.ring;
+}
+
+size_t round_up_pow2(size_t n) {
+  size_t result = 1;
+  while (result < n) {
+    result <<= 1;
+  }
+  return result;
+}
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+const char* event_type_name(FlightEventType type) {
+  switch (type) {
+    case FlightEventType::OP_BEGIN:
+      return "op_begin";
+    case FlightEventType::OP_END:
+      return "op_end";
+    case FlightEventType::ALLOC:
+      return "alloc";
+    case FlightEventType::FREE:
+      return "free";
+    case FlightEventType::SYNC:
+      return "sync";
+    case FlightEventType::CUSTOM:
+      return "custom";
+  }
+  return "unknown";
+}
+
+} // namespace
+
+namespace detail {
+
+void flight_record_impl(FlightEventType type, const char* name, uint64_t arg) {
+  ThreadRing& ring = thread_ring();
+  FlightEvent& event = ring.events[ring.pos & ring.mask];
+  event.timestamp_ns = now_ns();
+  event.arg = arg;
+  event.type = type;
+  std::strncpy(event.name, name, kFlightEventNameLength);
+  event.name[kFlightEventNameLength] = '\0';
+  ++ring.pos;
+}
+
+} // namespace detail
+
+void EnableFlightRecorder(size_t capacity) {
+  auto& reg = registry();
+  detail::flight_recorder_enabled.store(false);
+  {
+    std::lock_guard<std::mutex> guard(reg.mutex);
+    reg.capacity = round_up_pow2(std::max<size_t>(capacity, 2));
+    reg.rings.clear();
+  }
+  // Release pairs with the acquire in thread_ring(): a thread that sees
+  // the new generation also sees the new capacity.
+  reg.generation.fetch_add(1, std::memory_order_release);
+  detail::flight_recorder_enabled.store(true);
+}
+
+void DisableFlightRecorder() {
+  detail::flight_recorder_enabled.store(false);
+}
+
+std::vector<ThreadFlightTrace> GetFlightTraces() {
+  auto& reg = registry();
+  std::lock_guard<std::mutex> guard(reg.mutex);
+  std::vector<ThreadFlightTrace> result;
+  result.reserve(reg.rings.size());
+  for (const auto& ring : reg.rings) {
+    ThreadFlightTrace trace;
+    trace.thread_id = ring->thread_id;
+    const uint64_t capacity = ring->mask + 1;
+    const uint64_t count = std::min(ring->pos, capacity);
+    trace.events.reserve(count);
+    for (uint64_t i = ring->pos - count; i < ring->pos; ++i) {
+      trace.events.push_back(ring->events[i & ring->mask]);
+    }
+    if (!trace.events.empty()) {
+      result.push_back(std::move(trace));
+    }
+  }
+  return result;
+}
+
+void DumpFlightRecorder(std::ostream& out) {
+  for (const auto& trace : GetFlightTraces()) {
+    out << "thread " << trace.thread_id << " (" << trace.events.size()
+        << " events):\n";
+    const int64_t base = trace.events.front().timestamp_ns;
+    for (const auto& event : trace.events) {
+      out << "  +" << (event.timestamp_ns - base) / 1000.0 << " us "
+          << event_type_name(event.type);
+      if (event.name[0] != '\0') {
+        out << " " << event.name;
+      }
+      if (event.arg != 0) {
+        out << " (" << event.arg << ")";
+      }
+      out << "\n";
+    }
+  }
+}
+
+} // namespace c10
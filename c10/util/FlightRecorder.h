@@ -0,0 +1,95 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace c10 {
+
+// Flight recorder: a fixed-size thread-local ring buffer of hot-path
+// events, cheap enough (one clock read and a ring store, no locks) to
+// leave enabled around a latency-sensitive section. When a rare spike
+// occurs, freeze the recorder and dump it to see the exact op sequence
+// and timing in the microseconds leading up to the spike.
+//
+// Producers guard their append with FlightRecorderEnabled(), which is a
+// single relaxed atomic load when the recorder is off. RecordFunction
+// feeds OP_BEGIN/OP_END for autograd and dispatcher ops, the JIT
+// interpreter for interpreted ops, and the CPU allocator ALLOC/FREE;
+// other subsystems can append their own events the same way.
+//
+// Usage:
+//   c10::EnableFlightRecorder(4096);   // events kept per thread
+//   ... workload ...
+//   // on demand or from a watchdog when a deadline is missed:
+//   c10::DisableFlightRecorder();      // freeze; buffers are retained
+//   c10::DumpFlightRecorder(std::cerr);
+
+enum class FlightEventType : uint8_t {
+  OP_BEGIN = 0,
+  OP_END = 1,
+  ALLOC = 2,
+  FREE = 3,
+  SYNC = 4,
+  CUSTOM = 5,
+};
+
+// Event names longer than this are truncated on append; copying a small
+// fixed-size array keeps the append cheap and independent of the name's
+// lifetime.
+constexpr size_t kFlightEventNameLength = 23;
+
+struct FlightEvent {
+  int64_t timestamp_ns = 0;  // steady-clock; comparable across threads
+  uint64_t arg = 0;          // event-specific (e.g. bytes for ALLOC)
+  char name[kFlightEventNameLength + 1] = {0};
+  FlightEventType type = FlightEventType::CUSTOM;
+};
+
+struct ThreadFlightTrace {
+  uint64_t thread_id = 0;  // recorder-assigned, stable for the thread
+  std::vector<FlightEvent> events;  // chronological, oldest first
+};
+
+// Starts recording with a fresh ring of (at least) `capacity` events per
+// thread; any previously buffered events are discarded. Capacity is
+// rounded up to a power of two.
+C10_API void EnableFlightRecorder(size_t capacity);
+// Freezes the recorder: appends stop, buffered events are retained for
+// dumping. Appends racing with the freeze may be partially recorded.
+C10_API void DisableFlightRecorder();
+// Buffered events of every thread that recorded since the last enable,
+// including threads that have since exited. Call after
+// DisableFlightRecorder(); events appended concurrently with a dump may
+// be torn.
+C10_API std::vector<ThreadFlightTrace> GetFlightTraces();
+// Formats the traces with per-thread relative timestamps.
+C10_API void DumpFlightRecorder(std::ostream& out);
+
+namespace detail {
+extern C10_API std::atomic<bool> flight_recorder_enabled;
+C10_API void flight_record_impl(
+    FlightEventType type,
+    const char* name,
+    uint64_t arg);
+} // namespace detail
+
+inline bool FlightRecorderEnabled() {
+  return detail::flight_recorder_enabled.load(std::memory_order_relaxed);
+}
+
+// Appends an event to the calling thread's ring; no-op when the recorder
+// is disabled. `name` is copied (truncated to kFlightEventNameLength).
+inline void FlightRecord(
+    FlightEventType type,
+    const char* name,
+    uint64_t arg = 0) {
+  if (C10_UNLIKELY(FlightRecorderEnabled())) {
+    detail::flight_record_impl(type, name, arg);
+  }
+}
+
+} // namespace c10
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "c10/macros/Macros.h"
+#include "c10/util/StaticInitProfiler.h"
 #include "c10/util/Type.h"
 
 namespace c10 {
@@ -167,7 +168,12 @@ class Registerer {
       Registry<SrcType, ObjectPtrType, Args...>* registry,
       typename Registry<SrcType, ObjectPtrType, Args...>::Creator creator,
       const std::string& help_msg = "") {
-    registry->Register(key, creator, help_msg);
+    if (static_init_profiling_enabled()) {
+      StaticInitCostGuard guard("registry", KeyStrRepr(key));
+      registry->Register(key, creator, help_msg);
+    } else {
+      registry->Register(key, creator, help_msg);
+    }
   }
 
   explicit Registerer(
@@ -176,7 +182,12 @@ class Registerer {
       Registry<SrcType, ObjectPtrType, Args...>* registry,
       typename Registry<SrcType, ObjectPtrType, Args...>::Creator creator,
       const std::string& help_msg = "") {
-    registry->Register(key, creator, help_msg, priority);
+    if (static_init_profiling_enabled()) {
+      StaticInitCostGuard guard("registry", KeyStrRepr(key));
+      registry->Register(key, creator, help_msg, priority);
+    } else {
+      registry->Register(key, creator, help_msg, priority);
+    }
   }
 
   template <class DerivedType>
@@ -0,0 +1,95 @@
+#include <c10/util/StaticInitProfiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+
+namespace c10 {
+
+namespace {
+
+struct ProfilerState {
+  std::mutex mutex;
+  std::vector<StaticInitCostRecord> records;
+};
+
+// Function-local static so that reporting works no matter which static
+// constructor runs first.
+ProfilerState& profiler_state() {
+  static ProfilerState state;
+  return state;
+}
+
+uint64_t now_nanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void dump_costs_to_stderr() {
+  dump_static_init_costs(std::cerr);
+}
+
+} // namespace
+
+bool static_init_profiling_enabled() {
+  static const bool enabled = []() {
+    const char* env = std::getenv("C10_PROFILE_STATIC_INIT");
+    const bool on = env != nullptr && std::strcmp(env, "1") == 0;
+    if (on) {
+      // Print the profile on clean exit so no caller changes are needed.
+      std::atexit(dump_costs_to_stderr);
+    }
+    return on;
+  }();
+  return enabled;
+}
+
+void report_static_init_cost(
+    const char* kind,
+    std::string key,
+    uint64_t nanos) {
+  ProfilerState& state = profiler_state();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  StaticInitCostRecord record;
+  record.kind = kind;
+  record.key = std::move(key);
+  record.nanos = nanos;
+  state.records.push_back(std::move(record));
+}
+
+std::vector<StaticInitCostRecord> static_init_cost_records() {
+  ProfilerState& state = profiler_state();
+  std::lock_guard<std::mutex> guard(state.mutex);
+  return state.records;
+}
+
+void dump_static_init_costs(std::ostream& out) {
+  std::vector<StaticInitCostRecord> records = static_init_cost_records();
+  std::sort(
+      records.begin(),
+      records.end(),
+      [](const StaticInitCostRecord& a, const StaticInitCostRecord& b) {
+        return a.nanos > b.nanos;
+      });
+  uint64_t total = 0;
+  for (const StaticInitCostRecord& record : records) {
+    total += record.nanos;
+    out << record.nanos / 1000 << " us\t" << record.kind << "\t"
+        << record.key << "\n";
+  }
+  out << total / 1000 << " us\ttotal\t(" << records.size() << " registrars)"
+      << "\n";
+}
+
+StaticInitCostGuard::StaticInitCostGuard(const char* kind, std::string key)
+    : kind_(kind), key_(std::move(key)), start_(now_nanos()) {}
+
+StaticInitCostGuard::~StaticInitCostGuard() {
+  report_static_init_cost(kind_, std::move(key_), now_nanos() - start_);
+}
+
+} // namespace c10
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <c10/macros/Macros.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace c10 {
+
+// Instrumentation for static initialization cost. Loading the library
+// runs thousands of static registrar constructors -- operator schema
+// parsing and registration, registry population -- before main() gets
+// control. When hunting a load-time regression, set
+// C10_PROFILE_STATIC_INIT=1 and each instrumented registrar reports how
+// long it ran; dump_static_init_costs() prints them most expensive
+// first. Records accumulate in a function-local static, so reporting is
+// safe from any static constructor regardless of initialization order.
+// With the environment variable unset, the hooks cost one predicate
+// check per registrar.
+
+struct StaticInitCostRecord {
+  const char* kind; // a string literal, e.g. "registry" or "c10_op"
+  std::string key;
+  uint64_t nanos;
+};
+
+// True iff C10_PROFILE_STATIC_INIT=1 is set in the environment.
+C10_API bool static_init_profiling_enabled();
+
+C10_API void report_static_init_cost(
+    const char* kind,
+    std::string key,
+    uint64_t nanos);
+
+// A copy of all records collected so far, in registration order.
+C10_API std::vector<StaticInitCostRecord> static_init_cost_records();
+
+// Writes the records to `out`, most expensive first, with a total.
+C10_API void dump_static_init_costs(std::ostream& out);
+
+// RAII timer: reports the enclosing scope as one record. Construct only
+// when static_init_profiling_enabled() -- callers check the predicate so
+// the key string is never built in the common disabled case.
+class C10_API StaticInitCostGuard {
+ public:
+  StaticInitCostGuard(const char* kind, std::string key);
+  ~StaticInitCostGuard();
+
+  C10_DISABLE_COPY_AND_ASSIGN(StaticInitCostGuard);
+
+ private:
+  const char* kind_;
+  std::string key_;
+  uint64_t start_;
+};
+
+} // namespace c10
@@ -1 +1,19 @@
 #include <c10/util/intrusive_ptr.h>
+
+namespace c10 {
+
+namespace detail {
+std::atomic<bool> intrusive_ptr_single_threaded_{false};
+} // namespace detail
+
+void set_intrusive_ptr_single_threaded(bool single_threaded) {
+  detail::intrusive_ptr_single_threaded_.store(
+      single_threaded, std::memory_order_relaxed);
+}
+
+bool intrusive_ptr_is_single_threaded() {
+  return detail::intrusive_ptr_single_threaded_.load(
+      std::memory_order_relaxed);
+}
+
+} // namespace c10
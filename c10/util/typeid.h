@@ -407,7 +407,11 @@ class C10_API TypeMeta final {
 
   template <typename T>
   bool Match() const noexcept {
-    return (*this == Make<T>());
+    // Compare type ids rather than TypeMetaData pointers: the right-hand
+    // side is a compile-time constant (a constexpr crc of the type name),
+    // so this is a single load and integer compare instead of a call to
+    // the out-of-line _typeMetaDataInstance<T>() specialization.
+    return id() == TypeIdentifier::Get<T>();
   }
 
   // Below are static functions that can be called by passing a specific type.
@@ -4,6 +4,7 @@
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <sstream>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -17,9 +18,44 @@
 
 #include "miniz.h"
 
+#ifdef CAFFE2_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace caffe2 {
 namespace serialize {
 
+// Name of the record listing which other records are stored as zstd frames.
+// Written last so that one-pass writers do not need to know up front which
+// records will end up compressed.
+constexpr const char* kCompressionManifestRecordName = "compression";
+// Compressing very small records costs more in zip bookkeeping and codec
+// overhead than it saves; they are stored raw regardless of the level.
+constexpr size_t kMinRecordSizeToCompress = 200;
+
+#ifndef _WIN32
+namespace {
+
+struct MmapRecordContext {
+  void* base;
+  size_t length;
+};
+
+void munmapRecord(void* opaque) {
+  auto ctx = static_cast<MmapRecordContext*>(opaque);
+  munmap(ctx->base, ctx->length);
+  delete ctx;
+}
+
+} // namespace
+#endif
+
 size_t istream_read_func(void *pOpaque, mz_uint64 file_ofs, void *pBuf, size_t n) {
   auto self = static_cast<PyTorchStreamReader*>(pOpaque);
   return self->read(file_ofs, static_cast<char*>(pBuf), n);
@@ -53,6 +89,11 @@ size_t PyTorchStreamReader::read(uint64_t pos, char* buf, size_t n) {
 PyTorchStreamReader::PyTorchStreamReader(const std::string& file_name)
     : ar_(caffe2::make_unique<mz_zip_archive>()),
       in_(caffe2::make_unique<FileAdapter>(file_name)) {
+#ifndef _WIN32
+  // a file-backed reader can hand out mmaped records; if the open fails we
+  // silently fall back to copying reads through the adapter
+  mmap_fd_ = open(file_name.c_str(), O_RDONLY);
+#endif
   init();
 }
 
@@ -130,6 +171,31 @@ void PyTorchStreamReader::init() {
       ", but the maximum supported version for reading is ",
       kMaxSupportedFileFormatVersion,
       ". Your PyTorch installation may be too old.");
+
+  // archives written with compression enabled carry a manifest naming the
+  // records that are stored as zstd frames; the manifest itself and any
+  // record not listed in it are stored raw
+  if (hasRecord(kCompressionManifestRecordName)) {
+    at::DataPtr manifest_ptr;
+    size_t manifest_size;
+    std::tie(manifest_ptr, manifest_size) =
+        getRecord(kCompressionManifestRecordName);
+    std::string manifest(
+        static_cast<const char*>(manifest_ptr.get()), manifest_size);
+    std::istringstream lines(manifest);
+    std::string line;
+    std::getline(lines, line);
+    AT_ASSERTM(
+        line == "zstd",
+        "Archive uses unsupported compression codec '",
+        line,
+        "'. Your PyTorch installation may be too old.");
+    while (std::getline(lines, line)) {
+      if (!line.empty()) {
+        zstd_records_.insert(line);
+      }
+    }
+  }
 }
 
 void PyTorchStreamReader::valid(const char* what, const char* info) {
@@ -206,6 +272,71 @@ std::tuple<at::DataPtr, size_t> PyTorchStreamReader::getRecord(const std::string
   mz_zip_archive_file_stat stat;
   mz_zip_reader_file_stat(ar_.get(), key, &stat);
   valid("retrieving file meta-data for ", name.c_str());
+  if (zstd_records_.count(name) != 0) {
+    // The stored zip entry holds a zstd frame; decompress it into a heap
+    // buffer. Compressed records are never mmaped since the raw bytes in
+    // the archive are not the record's data.
+#ifdef CAFFE2_USE_ZSTD
+    std::string frame(stat.m_uncomp_size, '\0');
+    mz_zip_reader_extract_to_mem(ar_.get(), key, &frame[0], frame.size(), 0);
+    valid("reading file ", name.c_str());
+    const unsigned long long content_size =
+        ZSTD_getFrameContentSize(frame.data(), frame.size());
+    if (content_size == ZSTD_CONTENTSIZE_ERROR ||
+        content_size == ZSTD_CONTENTSIZE_UNKNOWN) {
+      CAFFE_THROW("record ", name, " is not a valid zstd frame");
+    }
+    void* ptr = malloc(content_size);
+    const size_t actual_size =
+        ZSTD_decompress(ptr, content_size, frame.data(), frame.size());
+    if (ZSTD_isError(actual_size) || actual_size != content_size) {
+      free(ptr);
+      CAFFE_THROW(
+          "zstd decompression of record ",
+          name,
+          " failed: ",
+          ZSTD_isError(actual_size) ? ZSTD_getErrorName(actual_size)
+                                    : "unexpected decompressed size");
+    }
+    at::DataPtr retval(ptr, ptr, free, at::kCPU);
+    return std::make_tuple(std::move(retval), content_size);
+#else
+    CAFFE_THROW(
+        "record ",
+        name,
+        " is zstd-compressed, but this build of PyTorch was compiled without "
+        "zstd support (USE_ZSTD=0)");
+#endif
+  }
+#ifndef _WIN32
+  // Records stored uncompressed in a file-backed archive are mapped rather
+  // than copied. The mapping is private (copy-on-write), so callers may
+  // write through the pointer; untouched pages stay shared with the page
+  // cache. mmap requires a page-aligned file offset, so the mapping starts
+  // at the page boundary preceding the record and the returned pointer is
+  // offset into it, which preserves the record's 64 byte data alignment.
+  if (mmap_fd_ != -1 && stat.m_method == 0 && stat.m_uncomp_size > 0) {
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t offset = getRecordOffset(name);
+    size_t map_start = offset & ~(page_size - 1);
+    size_t delta = offset - map_start;
+    size_t map_length = delta + stat.m_uncomp_size;
+    void* base = mmap(
+        nullptr,
+        map_length,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE,
+        mmap_fd_,
+        static_cast<off_t>(map_start));
+    if (base != MAP_FAILED) {
+      auto ctx = new MmapRecordContext{base, map_length};
+      at::DataPtr retval(
+          static_cast<char*>(base) + delta, ctx, munmapRecord, at::kCPU);
+      return std::make_tuple(std::move(retval), stat.m_uncomp_size);
+    }
+    // mapping failed (e.g. out of address space); fall through to copying
+  }
+#endif
   void * ptr = malloc(stat.m_uncomp_size);
   mz_zip_reader_extract_to_mem(ar_.get(), key, ptr, stat.m_uncomp_size, 0);
   valid("reading file ", name.c_str());
@@ -235,6 +366,12 @@ size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
 
 
 PyTorchStreamReader::~PyTorchStreamReader() {
+#ifndef _WIN32
+  if (mmap_fd_ != -1) {
+    // outstanding mappings keep their pages valid after the fd is closed
+    close(mmap_fd_);
+  }
+#endif
   mz_zip_reader_end(ar_.get());
   valid("closing reader for archive ", archive_name_.c_str());
 }
@@ -297,6 +434,27 @@ void PyTorchStreamWriter::setup(const string& file_name) {
   writeRecord("version", version.c_str(), version.size());
 }
 
+void PyTorchStreamWriter::setCompressionLevel(int level) {
+  AT_ASSERT(!finalized_);
+#ifdef CAFFE2_USE_ZSTD
+  if (level < 0 || level > ZSTD_maxCLevel()) {
+    CAFFE_THROW(
+        "invalid zstd compression level ",
+        level,
+        "; must be between 0 and ",
+        ZSTD_maxCLevel());
+  }
+  compression_level_ = level;
+#else
+  if (level != 0) {
+    CAFFE_THROW(
+        "this build of PyTorch was compiled without zstd support "
+        "(USE_ZSTD=0), so compressed archives cannot be written");
+  }
+  compression_level_ = 0;
+#endif
+}
+
 void PyTorchStreamWriter::writeRecord(
     const std::string& name,
     const void* data,
@@ -305,6 +463,32 @@ void PyTorchStreamWriter::writeRecord(
   AT_ASSERT(!finalized_);
   AT_ASSERT(!archive_name_plus_slash_.empty());
   std::string full_name = archive_name_plus_slash_ + name;
+#ifdef CAFFE2_USE_ZSTD
+  // When a zstd level is set it takes the place of the deflate flag: each
+  // record becomes its own zstd frame, stored as an uncompressed zip entry
+  // so it stays independently addressable, and its name is remembered for
+  // the manifest written at finalization. Records that do not shrink are
+  // stored raw so they remain mmapable on load.
+  std::string zstd_frame;
+  if (compression_level_ != 0 && size > kMinRecordSizeToCompress) {
+    zstd_frame.resize(ZSTD_compressBound(size));
+    const size_t compressed_size = ZSTD_compress(
+        &zstd_frame[0], zstd_frame.size(), data, size, compression_level_);
+    if (ZSTD_isError(compressed_size)) {
+      CAFFE_THROW(
+          "zstd compression of record ",
+          name,
+          " failed: ",
+          ZSTD_getErrorName(compressed_size));
+    }
+    if (compressed_size < size) {
+      data = zstd_frame.data();
+      size = compressed_size;
+      compress = false;
+      compressed_records_.push_back(name);
+    }
+  }
+#endif
   size_t padding_size =
       getPadding(ar_->m_archive_size, full_name.size(), size, padding_);
   uint32_t flags = compress ? MZ_BEST_COMPRESSION : 0;
@@ -328,6 +512,17 @@ void PyTorchStreamWriter::writeRecord(
 
 void PyTorchStreamWriter::writeEndOfFile() {
   AT_ASSERT(!finalized_);
+  if (!compressed_records_.empty()) {
+    std::string manifest = "zstd\n";
+    for (const auto& record_name : compressed_records_) {
+      manifest += record_name;
+      manifest += '\n';
+    }
+    // the manifest itself must be readable before the reader knows which
+    // records are compressed, so store it raw
+    compression_level_ = 0;
+    writeRecord(kCompressionManifestRecordName, manifest.data(), manifest.size());
+  }
   finalized_ = true;
   mz_zip_writer_finalize_archive(ar_.get());
   mz_zip_writer_end(ar_.get());
@@ -6,6 +6,7 @@
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <unordered_set>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/Backend.h>
@@ -38,7 +39,15 @@ typedef struct mz_zip_archive mz_zip_archive;
 //          archive_name_my_submodule.py # submodules have separate files
 //
 // The PyTorchStreamWriter also ensures additional useful properties for these files
-// 1. All files are stored uncompressed.
+// 1. All files are stored uncompressed by default. When a zstd compression
+//    level is set with setCompressionLevel, each record large enough to be
+//    worth compressing is compressed into its own zstd frame, which is then
+//    stored as an uncompressed zip entry; the names of compressed records
+//    are listed in a "compression" record written when the archive is
+//    finalized. Records that do not shrink under compression stay raw. This
+//    per-record framing means that each record can still be located and read
+//    independently, and that records written without compression keep the
+//    mmap-friendly layout below.
 // 2. All files in the archive are aligned to 64 byte boundaries such that
 //    it is possible to mmap the entire file and get an aligned pointer to
 //    tensor data.
@@ -51,6 +60,12 @@ typedef struct mz_zip_archive mz_zip_archive;
 // 2. It provides a getRecordOffset function which returns the offset into the
 //    raw file where file data lives. If the file was written with PyTorchStreamWriter
 //    it is guarenteed to be 64 byte aligned.
+// 3. When it is constructed from a file name on platforms with mmap, records
+//    that are stored uncompressed are returned as copy-on-write mappings of
+//    the archive rather than heap copies, so loading a large model does not
+//    double its resident size. The mapping starts at the page boundary
+//    preceding the record, which together with the 64 byte record alignment
+//    keeps the returned tensor data pointers aligned.
 
 // PyTorchReader/Writer handle checking the version number on the archive format
 // and ensure that all files are written to a archive_name directory so they
@@ -124,6 +139,12 @@ class CAFFE2_API PyTorchStreamReader final {
   std::string archive_name_plus_slash_;
   std::unique_ptr<ReadAdapterInterface> in_;
   int64_t version_;
+  // File descriptor used to mmap uncompressed records; -1 when the reader
+  // is not file-backed or mapping is unavailable
+  int mmap_fd_ = -1;
+  // Names of records stored as zstd frames, parsed from the "compression"
+  // record. Empty for archives written without compression.
+  std::unordered_set<std::string> zstd_records_;
 };
 
 class CAFFE2_API PyTorchStreamWriter final {
@@ -139,6 +160,11 @@ class CAFFE2_API PyTorchStreamWriter final {
       bool compress = false);
   void writeEndOfFile();
 
+  // Compress subsequent records into per-record zstd frames at the given
+  // level; 0 (the default) stores records raw. Throws when this build was
+  // compiled without zstd support.
+  void setCompressionLevel(int level);
+
   bool finalized() const {
     return finalized_;
   }
@@ -159,6 +185,8 @@ class CAFFE2_API PyTorchStreamWriter final {
   std::string padding_;
   std::ofstream file_stream_;
   std::function<size_t(const void*, size_t)> writer_func_;
+  int compression_level_ = 0;
+  std::vector<std::string> compressed_records_;
   bool finalized_ = false;
   bool err_seen_ = false;
   friend size_t ostream_write_func(
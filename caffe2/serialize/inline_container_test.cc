@@ -63,6 +63,85 @@ TEST(PyTorchStreamWriterAndReader, SaveAndLoad) {
   ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
 }
 
+TEST(PyTorchStreamWriterAndReader, LoadFromFile) {
+  // file-backed readers return uncompressed records as copy-on-write
+  // mappings on platforms that support mmap; the contents and write
+  // semantics must match the copying path
+  std::string file_name = "file_reader_test.zip";
+  {
+    PyTorchStreamWriter writer(file_name);
+    std::array<char, 127> data1;
+    for (int i = 0; i < data1.size(); ++i) {
+      data1[i] = data1.size() - i;
+    }
+    writer.writeRecord("key1", data1.data(), data1.size());
+    writer.writeEndOfFile();
+  }
+
+  PyTorchStreamReader reader(file_name);
+  ASSERT_TRUE(reader.hasRecord("key1"));
+  at::DataPtr data_ptr;
+  int64_t size;
+  std::tie(data_ptr, size) = reader.getRecord("key1");
+  ASSERT_EQ(size, 127);
+  auto bytes = static_cast<char*>(data_ptr.get());
+  for (int i = 0; i < size; ++i) {
+    ASSERT_EQ(bytes[i], static_cast<char>(127 - i));
+  }
+  // records are writable and writes are private to this read
+  bytes[0] = 42;
+  at::DataPtr data_ptr2;
+  std::tie(data_ptr2, size) = reader.getRecord("key1");
+  ASSERT_EQ(static_cast<char*>(data_ptr2.get())[0], 127);
+
+  std::remove(file_name.c_str());
+}
+
+#ifdef CAFFE2_USE_ZSTD
+TEST(PyTorchStreamWriterAndReader, ZstdCompressedRecords) {
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  writer.setCompressionLevel(3);
+
+  // highly compressible and larger than the compression threshold
+  std::string data1(4096, '\0');
+  for (size_t i = 0; i < data1.size(); ++i) {
+    data1[i] = i % 8;
+  }
+  writer.writeRecord("key1", data1.data(), data1.size());
+
+  // too small to be compressed; must be stored raw
+  std::array<char, 16> data2;
+  for (int i = 0; i < data2.size(); ++i) {
+    data2[i] = data2.size() - i;
+  }
+  writer.writeRecord("key2", data2.data(), data2.size());
+  writer.writeEndOfFile();
+
+  std::string the_file = oss.str();
+  ASSERT_LT(the_file.size(), data1.size());
+
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  ASSERT_TRUE(reader.hasRecord("compression"));
+  at::DataPtr data_ptr;
+  int64_t size;
+  std::tie(data_ptr, size) = reader.getRecord("key1");
+  ASSERT_EQ(size, data1.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), data1.data(), data1.size()), 0);
+
+  std::tie(data_ptr, size) = reader.getRecord("key2");
+  ASSERT_EQ(size, data2.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), data2.data(), data2.size()), 0);
+  // the small record stays raw in the archive
+  size_t off2 = reader.getRecordOffset("key2");
+  ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
+}
+#endif
+
 } // namespace
 } // namespace serialize
 } // namespace caffe2
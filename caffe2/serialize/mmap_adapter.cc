@@ -0,0 +1,89 @@
+#include "caffe2/serialize/mmap_adapter.h"
+#include <c10/util/Exception.h>
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace caffe2 {
+namespace serialize {
+
+#ifndef _WIN32
+
+MmapFileAdapter::MmapFileAdapter(const std::string& file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    AT_ERROR("open file failed, file path: ", file_name);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    AT_ERROR("stat file failed, file path: ", file_name);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ > 0) {
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data_ == MAP_FAILED) {
+      close(fd);
+      AT_ERROR("mmap file failed, file path: ", file_name);
+    }
+  }
+  // The mapping keeps the file alive; the descriptor is not needed anymore.
+  close(fd);
+}
+
+size_t MmapFileAdapter::size() const {
+  return size_;
+}
+
+size_t MmapFileAdapter::read(uint64_t pos, void* buf, size_t n, const char*)
+    const {
+  if (pos >= size_) {
+    return 0;
+  }
+  n = std::min(n, static_cast<size_t>(size_ - pos));
+  std::memcpy(buf, static_cast<const char*>(data_) + pos, n);
+  return n;
+}
+
+MmapFileAdapter::~MmapFileAdapter() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+}
+
+bool MmapFileAdapter::is_supported() {
+  return true;
+}
+
+#else // _WIN32
+
+MmapFileAdapter::MmapFileAdapter(const std::string& file_name) {
+  AT_ERROR(
+      "MmapFileAdapter is not supported on this platform, "
+      "file path: ", file_name);
+}
+
+size_t MmapFileAdapter::size() const {
+  return 0;
+}
+
+size_t MmapFileAdapter::read(uint64_t, void*, size_t, const char*) const {
+  return 0;
+}
+
+MmapFileAdapter::~MmapFileAdapter() {}
+
+bool MmapFileAdapter::is_supported() {
+  return false;
+}
+
+#endif
+
+} // namespace serialize
+} // namespace caffe2
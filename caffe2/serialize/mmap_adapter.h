@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+
+#include "c10/macros/Macros.h"
+#include "caffe2/serialize/read_adapter_interface.h"
+
+namespace caffe2 {
+namespace serialize {
+
+// Read adapter backed by a memory-mapped file. Reads are served straight
+// from the mapping, so loading touches only the pages it actually needs
+// and the archive contents stay clean (file-backed) instead of dirty
+// memory -- which is what the mobile module loader wants for cold start.
+// Only built on POSIX; call is_supported() before constructing one and
+// fall back to FileAdapter otherwise.
+class CAFFE2_API MmapFileAdapter final : public ReadAdapterInterface {
+ public:
+  C10_DISABLE_COPY_AND_ASSIGN(MmapFileAdapter);
+  explicit MmapFileAdapter(const std::string& file_name);
+  size_t size() const override;
+  size_t read(uint64_t pos, void* buf, size_t n, const char* what = "")
+      const override;
+  ~MmapFileAdapter();
+
+  static bool is_supported();
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+} // namespace serialize
+} // namespace caffe2
@@ -37,6 +37,10 @@ class CAFFE2_API /*alignas(kCacheLineSize)*/ ThreadPool {
   // Returns the number of threads currently in use
   int getNumThreads() const;
 
+  // Resizes the pool at run time. Worker threads are created lazily on the
+  // next run(), so shrinking simply leaves the extra workers idle.
+  void setNumThreads(size_t numThreads);
+
   // Sets the minimum work size (range) for which to invoke the
   // threadpool; work sizes smaller than this will just be run on the
   // main (calling) thread
@@ -17,4 +17,18 @@ caffe2::ThreadPool* mobile_threadpool() {
 pthreadpool_t mobile_pthreadpool() {
   return reinterpret_cast<pthreadpool_t>(mobile_threadpool());
 }
+
+caffe2::ThreadPool* shared_threadpool() {
+#ifdef C10_MOBILE
+  return mobile_threadpool();
+#else
+  static std::unique_ptr<caffe2::ThreadPool> thread_pool =
+      caffe2::ThreadPool::defaultThreadPool();
+  return thread_pool.get();
+#endif
+}
+
+pthreadpool_t shared_pthreadpool() {
+  return reinterpret_cast<pthreadpool_t>(shared_threadpool());
+}
 } // namespace caffe2
@@ -20,4 +20,14 @@ ThreadPool* mobile_threadpool();
 // "at::parallel_for" primitive to replace pthreadpool_compute_1d for Pytorch;
 pthreadpool_t mobile_pthreadpool();
 
+// Process-wide pool shared by every pthreadpool consumer (NNPACK,
+// QNNPACK) and, on mobile, by ATen's intra-op primitives. On mobile this
+// is mobile_threadpool(); on server builds it is one lazily created pool
+// so pthreadpool consumers stop spinning up their own workers next to
+// ATen's intra-op pool. Sizing goes through
+// ThreadPool::defaultThreadPool(), which caps the thread count to the
+// performance cores on known big.LITTLE topologies.
+ThreadPool* shared_threadpool();
+pthreadpool_t shared_pthreadpool();
+
 } // namespace caffe2
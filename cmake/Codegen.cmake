@@ -115,10 +115,20 @@ if (INTERN_BUILD_ATEN_OPS)
     IF(MSVC)
       LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG}/arch:AVX2")
     ELSE(MSVC)
-      LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx2 -mfma ${CPU_NO_AVX256_SPLIT_FLAGS}")
+      LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx2 -mfma -mf16c ${CPU_NO_AVX256_SPLIT_FLAGS}")
     ENDIF(MSVC)
   ENDIF(CXX_AVX2_FOUND)
 
+  IF(CXX_AVX512_FOUND)
+    SET(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_AVX512_CPU_DEFINITION")
+    LIST(APPEND CPU_CAPABILITY_NAMES "AVX512")
+    IF(MSVC)
+      LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG}/arch:AVX512")
+    ELSE(MSVC)
+      LIST(APPEND CPU_CAPABILITY_FLAGS "${OPT_FLAG} -mavx512f -mavx512dq -mavx512vl -mavx512bw -mfma -mf16c")
+    ENDIF(MSVC)
+  ENDIF(CXX_AVX512_FOUND)
+
   list(LENGTH CPU_CAPABILITY_NAMES NUM_CPU_CAPABILITY_NAMES)
   math(EXPR NUM_CPU_CAPABILITY_NAMES "${NUM_CPU_CAPABILITY_NAMES}-1")
 
@@ -154,11 +164,26 @@ if (INTERN_BUILD_ATEN_OPS)
     set(GEN_ROCM_FLAG --rocm)
   endif()
 
+  set(GEN_OP_WHITELIST_FLAG)
+  if (SELECTED_OP_LIST)
+    # Selective build: only the listed ops get dispatcher registrations;
+    # the rest compile but never register, so the linker strips them.
+    set(GEN_OP_WHITELIST_FLAG --op_registration_whitelist ${SELECTED_OP_LIST})
+  endif()
+
+  set(GEN_STATIC_DISPATCH_BACKEND_FLAG)
+  if (USE_STATIC_DISPATCH AND STATIC_DISPATCH_BACKEND)
+    set(GEN_STATIC_DISPATCH_BACKEND_FLAG
+        --static_dispatch_backend ${STATIC_DISPATCH_BACKEND})
+  endif()
+
   SET(GEN_COMMAND
       "${PYTHON_EXECUTABLE}" ${CMAKE_CURRENT_LIST_DIR}/../aten/src/ATen/gen.py
       --source-path ${CMAKE_CURRENT_LIST_DIR}/../aten/src/ATen
       --install_dir ${CMAKE_BINARY_DIR}/aten/src/ATen
       ${GEN_ROCM_FLAG}
+      ${GEN_OP_WHITELIST_FLAG}
+      ${GEN_STATIC_DISPATCH_BACKEND_FLAG}
       ${cwrap_files}
   )
 
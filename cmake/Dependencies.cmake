@@ -1119,6 +1119,7 @@ if (NOT INTERN_BUILD_MOBILE AND BUILD_CAFFE2_OPS)
 endif()
 
 if (USE_ZSTD)
+  set(CAFFE2_USE_ZSTD ON)
   list(APPEND Caffe2_DEPENDENCY_LIBS libzstd_static)
   include_directories(SYSTEM ${CMAKE_CURRENT_LIST_DIR}/../third_party/zstd/lib)
   add_subdirectory(${CMAKE_CURRENT_LIST_DIR}/../third_party/zstd/build/cmake)
@@ -2,6 +2,8 @@
 
 #include <torch/torch.h>
 
+#include <torch/csrc/autograd/functions/accumulate_grad.h>
+
 #include <test/cpp/api/support.h>
 
 using namespace torch::autograd;
@@ -47,6 +49,61 @@ TEST(AutogradAPITests, BackwardTest) {
   ASSERT_VARIABLE_EQ(y.grad(), 2 * (x + torch::ones({2, 2})*2));
 }
 
+TEST(AutogradAPITests, BackwardRetainGraphTest) {
+  // Repeated backward over the same retained graph reuses the cached
+  // dependency counts; see Note [Backward plan cache] in engine.cpp.
+  Variable x = torch::randn({2, 2}, torch::requires_grad());
+  Variable y = torch::randn({2, 2}, torch::requires_grad());
+  auto res = simple_fn(x, y);
+  for (int i = 0; i < 3; ++i) {
+    backward({res}, {torch::ones({2, 2})}, /*retain_graph=*/true);
+  }
+
+  ASSERT_VARIABLE_EQ(x.grad(), 3 * (y + torch::ones({2, 2})));
+  ASSERT_VARIABLE_EQ(y.grad(), 3 * (x + torch::ones({2, 2}) * 2));
+}
+
+TEST(AutogradAPITests, InferenceMode) {
+  Variable x = torch::ones({2, 2}, torch::requires_grad());
+  Variable y;
+  {
+    AutoInferenceMode guard;
+    ASSERT_FALSE(GradMode::is_enabled());
+    y = x * 2;
+    ASSERT_FALSE(y.requires_grad());
+    ASSERT_FALSE(y.grad_fn());
+    // Views do not get autograd view metadata attached.
+    auto view = y.view({4});
+    ASSERT_FALSE(as_variable_ref(view).is_view());
+    // In-place ops do not bump the version counter.
+    auto version_before = y.current_version();
+    y.add_(1);
+    ASSERT_EQ(y.current_version(), version_before);
+  }
+  ASSERT_TRUE(GradMode::is_enabled());
+  // Bookkeeping resumes once the guard is gone.
+  auto version_before = y.current_version();
+  y.add_(1);
+  ASSERT_GT(y.current_version(), version_before);
+}
+
+TEST(AutogradAPITests, FlatGradBuffer) {
+  Variable x = torch::randn({2, 2}, torch::requires_grad());
+  Variable y = torch::randn({2, 2}, torch::requires_grad());
+  auto flat = make_flat_grad_buffer({x, y});
+  ASSERT_EQ(flat.numel(), 8);
+
+  auto res = simple_fn(x, y);
+  backward({res}, {torch::ones({2, 2})});
+
+  ASSERT_VARIABLE_EQ(x.grad(), y + torch::ones({2, 2}));
+  ASSERT_VARIABLE_EQ(y.grad(), x + torch::ones({2, 2}) * 2);
+  // The grads were accumulated into views of the flat buffer.
+  ASSERT_EQ(x.grad().data_ptr(), flat.data_ptr());
+  ASSERT_VARIABLE_EQ(flat.narrow(0, 0, 4).view({2, 2}), x.grad());
+  ASSERT_VARIABLE_EQ(flat.narrow(0, 4, 4).view({2, 2}), y.grad());
+}
+
 TEST(AutogradAPITests, GradSimpleTest) {
   // basic grad
   Variable x = torch::randn({2,2}, torch::requires_grad());
@@ -421,6 +478,67 @@ TEST(CustomAutogradTest, DepNoGrad) {
   ASSERT_VARIABLE_EQ(x.grad(), torch::ones(x.sizes()));
 }
 
+TEST(CustomAutogradTest, Checkpoint) {
+  auto segment = [](const variable_list& inputs) -> variable_list {
+    return {inputs[0] * inputs[1] + inputs[0].sigmoid()};
+  };
+
+  auto x = torch::randn({4, 4}, torch::requires_grad());
+  auto y = torch::randn({4, 4}, torch::requires_grad());
+
+  auto expected = segment({x, y})[0];
+  expected.sum().backward();
+  auto expected_gx = x.grad().clone();
+  auto expected_gy = y.grad().clone();
+
+  x.grad().zero_();
+  y.grad().zero_();
+  auto out = checkpoint(segment, {x, y})[0];
+  ASSERT_VARIABLE_EQ(out, expected);
+  out.sum().backward();
+  ASSERT_VARIABLE_EQ(x.grad(), expected_gx);
+  ASSERT_VARIABLE_EQ(y.grad(), expected_gy);
+}
+
+TEST(CustomAutogradTest, CheckpointRNG) {
+  auto segment = [](const variable_list& inputs) -> variable_list {
+    return {torch::dropout(inputs[0], /*p=*/0.5, /*train=*/true)};
+  };
+
+  auto x = torch::ones({64, 64}, torch::requires_grad());
+  auto out = checkpoint(segment, {x})[0];
+  out.sum().backward();
+
+  // The replay in backward must draw the same dropout mask as the original
+  // run: the gradient is the scale factor exactly where the output kept a
+  // value, which for an all-ones input equals the output itself.
+  ASSERT_VARIABLE_EQ(x.grad(), out.detach());
+}
+
+TEST(CustomAutogradTest, SharedGradNotAccumulatedInPlace) {
+  // accumulate() in input_buffer.cpp may add into a gradient in place only
+  // when the buffer owns it outright; a grad returned for two edges is
+  // shared and must be left untouched.
+  static Variable stashed_grad;
+  struct MyFn : public Function<MyFn> {
+    static Variable forward(AutogradContext*, Variable a, Variable b) {
+      return a + b;
+    }
+
+    static variable_list backward(AutogradContext*, variable_list grad) {
+      stashed_grad = grad[0];
+      return {grad[0], grad[0]};
+    }
+  };
+
+  auto x = torch::randn({5, 5}, torch::requires_grad());
+  MyFn::apply(x, x).sum().backward();
+
+  ASSERT_VARIABLE_EQ(x.grad(), 2 * torch::ones({5, 5}));
+  ASSERT_VARIABLE_EQ(stashed_grad, torch::ones({5, 5}));
+  stashed_grad = Variable();
+}
+
 TEST(CustomAutogradTest, Reentrant) {
   static Variable y_data = torch::randn({2, 2});
   struct Reenter : public Function<Reenter> {
@@ -485,6 +485,51 @@ TEST(DataTest, StackTransformWorksForTensorExample) {
   ASSERT_TRUE(second.data.allclose(torch::eye(4).slice(/*dim=*/0, 2, 4)));
 }
 
+TEST(DataTest, BufferedStackTransformReusesItsBuffer) {
+  struct D : public datasets::Dataset<D> {
+    Example<> get(size_t index) override {
+      return {tensor[index], 1 + tensor[index]};
+    }
+
+    torch::optional<size_t> size() const override {
+      return tensor.size(0);
+    }
+
+    torch::Tensor tensor{torch::eye(4)};
+  };
+
+  auto d = D().map(transforms::BufferedStack<Example<>>());
+
+  Example<> batch = d.get_batch({0, 1});
+  ASSERT_TRUE(batch.data.allclose(torch::eye(4).slice(/*dim=*/0, 0, 2)));
+  ASSERT_TRUE(batch.target.allclose(1 + torch::eye(4).slice(/*dim=*/0, 0, 2)));
+  void* data_ptr = batch.data.data_ptr();
+
+  // The second batch is collated into the same buffer, invalidating the
+  // first one.
+  Example<> second = d.get_batch({2, 3});
+  ASSERT_EQ(second.data.data_ptr(), data_ptr);
+  ASSERT_TRUE(second.data.allclose(torch::eye(4).slice(/*dim=*/0, 2, 4)));
+  ASSERT_TRUE(second.target.allclose(1 + torch::eye(4).slice(/*dim=*/0, 2, 4)));
+
+  // A smaller final batch is a prefix view of the same buffer.
+  Example<> partial = d.get_batch({0});
+  ASSERT_EQ(partial.data.size(0), 1);
+  ASSERT_TRUE(partial.data[0].allclose(torch::eye(4)[0]));
+}
+
+TEST(DataTest, BufferedStackTransformWorksForTensorExample) {
+  auto d = datasets::TensorDataset(torch::eye(4))
+               .map(transforms::BufferedStack<TensorExample>());
+
+  TensorExample batch = d.get_batch({0, 1});
+  ASSERT_TRUE(batch.data.allclose(torch::eye(4).slice(/*dim=*/0, 0, 2)));
+
+  TensorExample second = d.get_batch({2, 3});
+  ASSERT_EQ(second.data.data_ptr(), batch.data.data_ptr());
+  ASSERT_TRUE(second.data.allclose(torch::eye(4).slice(/*dim=*/0, 2, 4)));
+}
+
 // Template classes cannot be nested in functions.
 template <typename Target>
 struct T : transforms::TensorTransform<Target> {
@@ -1045,6 +1090,43 @@ TEST(DataLoaderTest, MakeDataLoaderDefaultsAsExpected) {
   ASSERT_EQ(data_loader->options().batch_size, 1);
 }
 
+TEST(DataLoaderTest, DevicePrefetcherDeliversBatchesInOrder) {
+  const auto kBatchSize = 25;
+  auto data_loader = torch::data::make_data_loader(
+      DummyDataset(),
+      samplers::SequentialSampler(100),
+      DataLoaderOptions(kBatchSize).workers(2));
+  DevicePrefetcher<decltype(*data_loader)> prefetcher(
+      *data_loader, torch::kCPU);
+  // Two epochs, to verify the prefetcher restarts cleanly.
+  for (size_t epoch = 0; epoch < 2; ++epoch) {
+    size_t batch_index = 0;
+    for (auto& batch : prefetcher) {
+      ASSERT_EQ(batch.size(), kBatchSize);
+      for (size_t j = 0; j < kBatchSize; ++j) {
+        ASSERT_EQ(batch.at(j), 1 + (batch_index * kBatchSize) + j);
+      }
+      batch_index += 1;
+    }
+    ASSERT_EQ(batch_index, 4);
+  }
+}
+
+TEST(DataLoaderTest, DevicePrefetcherPropagatesExceptions) {
+  struct ThrowingDataset : datasets::Dataset<ThrowingDataset, int> {
+    int get(size_t index) override {
+      throw std::invalid_argument("badness");
+    }
+    torch::optional<size_t> size() const override {
+      return 10;
+    }
+  };
+  auto data_loader = torch::data::make_data_loader(ThrowingDataset(), 5);
+  DevicePrefetcher<decltype(*data_loader)> prefetcher(
+      *data_loader, torch::kCPU);
+  ASSERT_THROWS_WITH(*prefetcher.begin(), "badness");
+}
+
 struct UnsizedDataset : public datasets::Dataset<UnsizedDataset> {
   torch::data::Example<> get(size_t i) {
     return {torch::ones(i), torch::ones(i)};
@@ -1690,6 +1772,127 @@ TEST(DataLoaderTest, ChunkDataSetGetBatch) {
   }
 }
 
+TEST(DataLoaderTest, MmapChunkDataReaderRoundTrip) {
+#ifndef _WIN32
+  const size_t examples_per_chunk = 7;
+  auto first_tempfile = c10::make_tempfile();
+  auto second_tempfile = c10::make_tempfile();
+  std::vector<std::string> chunk_files = {
+      first_tempfile.name, second_tempfile.name};
+  for (size_t chunk = 0; chunk < 2; ++chunk) {
+    std::vector<torch::data::Example<>> examples;
+    for (size_t i = 0; i < examples_per_chunk; ++i) {
+      const auto value = chunk * examples_per_chunk + i;
+      examples.emplace_back(
+          torch::full({2, 3}, (float)value),
+          torch::full({1}, (int64_t)value, torch::kInt64));
+    }
+    datasets::MmapChunkDataReader::write_chunk(chunk_files[chunk], examples);
+  }
+
+  datasets::MmapChunkDataReader reader(chunk_files);
+  ASSERT_EQ(reader.chunk_count(), 2);
+  for (size_t chunk = 0; chunk < 2; ++chunk) {
+    auto examples = reader.read_chunk(chunk);
+    ASSERT_EQ(examples.size(), examples_per_chunk);
+    for (size_t i = 0; i < examples_per_chunk; ++i) {
+      const auto value = chunk * examples_per_chunk + i;
+      ASSERT_TRUE(examples[i].data.allclose(torch::full({2, 3}, (float)value)));
+      ASSERT_EQ(examples[i].target.item<int64_t>(), (int64_t)value);
+    }
+  }
+
+  ASSERT_THROWS_WITH(reader.read_chunk(2), "out of range");
+#endif
+}
+
+TEST(DataLoaderTest, ChunkDataSetPersistentWorkers) {
+  const size_t batch_size = 5;
+  const size_t total_example_count = 35;
+
+  DummyChunkDataReader data_reader;
+  samplers::SequentialSampler sampler(0);
+
+  datasets::SharedBatchDataset<datasets::ChunkDataset<
+      DummyChunkDataReader,
+      samplers::SequentialSampler,
+      samplers::SequentialSampler>>
+      dataset = datasets::make_shared_dataset<datasets::ChunkDataset<
+          DummyChunkDataReader,
+          samplers::SequentialSampler,
+          samplers::SequentialSampler>>(
+          data_reader,
+          sampler,
+          sampler,
+          datasets::ChunkDatasetOptions(
+              /*preloader_count=*/2, batch_size)
+              .persistent_workers(true));
+
+  auto data_loader = torch::data::make_data_loader(
+      dataset, DataLoaderOptions(batch_size).workers(0));
+
+  // A partially read epoch, to exercise the mid-epoch abort path.
+  {
+    auto iterator = data_loader->begin();
+    ASSERT_NE(iterator, data_loader->end());
+  }
+
+  // Full epochs afterwards must still see every example, with the
+  // preloader threads surviving all epoch boundaries.
+  for (int epoch_index = 0; epoch_index < 3; ++epoch_index) {
+    std::vector<bool> result(total_example_count, false);
+    for (auto& batch : *data_loader) {
+      for (auto example : batch) {
+        result[example] = true;
+      }
+    }
+    for (auto data : result) {
+      ASSERT_EQ(data, true);
+    }
+  }
+}
+
+TEST(DataLoaderTest, BufferedShuffleDatasetYieldsAllExamples) {
+  const size_t batch_size = 5;
+  const size_t total_example_count = 35;
+
+  using ChunkDatasetType = datasets::ChunkDataset<
+      DummyChunkDataReader,
+      samplers::SequentialSampler,
+      samplers::SequentialSampler>;
+
+  DummyChunkDataReader data_reader;
+  samplers::SequentialSampler sampler(0);
+
+  auto chunk_dataset = std::make_shared<ChunkDatasetType>(
+      data_reader,
+      sampler,
+      sampler,
+      datasets::ChunkDatasetOptions(/*preloader_count=*/1, batch_size));
+
+  // The reservoir never indexes the corpus; it only ever holds about
+  // `buffer_size` examples pulled from the stream.
+  auto dataset = datasets::make_shared_dataset<
+      datasets::BufferedShuffleDataset<ChunkDatasetType>>(
+      chunk_dataset, /*buffer_size=*/10);
+
+  auto data_loader = torch::data::make_data_loader(
+      dataset, DataLoaderOptions(batch_size).workers(0));
+
+  for (int epoch_index = 0; epoch_index < 2; ++epoch_index) {
+    std::vector<bool> result(total_example_count, false);
+    for (auto& batch : *data_loader) {
+      for (auto example : batch) {
+        ASSERT_FALSE(result[example]);
+        result[example] = true;
+      }
+    }
+    for (auto data : result) {
+      ASSERT_EQ(data, true);
+    }
+  }
+}
+
 TEST(DataLoaderTest, ChunkDataSetWithBatchSizeMismatch) {
   const size_t prefetch_count = 1;
   const size_t batch_size = 5;
@@ -60,6 +60,26 @@ TEST(SerializeTest, BasicToFile) {
   ASSERT_TRUE(x.allclose(y));
 }
 
+TEST(SerializeTest, SaveAsyncSnapshotsBeforeMutation) {
+  torch::manual_seed(0);
+
+  auto x = torch::randn({5, 5});
+  auto expected = x.clone();
+
+  auto tempfile = c10::make_tempfile();
+  auto future = torch::save_async(x, tempfile.name);
+  // Mutations after the call must not leak into the checkpoint.
+  x.add_(1);
+  future.get();
+
+  torch::Tensor y;
+  torch::load(y, tempfile.name);
+
+  ASSERT_TRUE(y.defined());
+  ASSERT_EQ(expected.sizes().vec(), y.sizes().vec());
+  ASSERT_TRUE(expected.allclose(y));
+}
+
 TEST(SerializeTest, BasicViaFunc) {
   torch::manual_seed(0);
 
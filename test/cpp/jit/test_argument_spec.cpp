@@ -89,6 +89,11 @@ void testCompleteArgumentSpec() {
   Stack stack = {var(CF, {1, 2}, true), 3, var(CF, {1, 2}, true)};
   CompleteArgumentSpec with_const(true, stack);
   ASSERT_EQ(with_const.at(2).sizes().size(), 2);
+
+  // shape bucketing rounds extents up to the next multiple of the bucket
+  ASSERT_EQ(bucketShape(33, 32), 64);
+  ASSERT_EQ(bucketShape(32, 32), 32);
+  ASSERT_EQ(bucketShape(0, 32), 0);
 }
 
 size_t hashCode(const TensorTypePtr& ptr) {
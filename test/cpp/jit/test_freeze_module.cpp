@@ -0,0 +1,72 @@
+#include <test/cpp/jit/test_base.h>
+
+#include <torch/csrc/jit/passes/freeze_module.h>
+#include <torch/csrc/jit/script/module.h>
+
+#include <ATen/ATen.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+bool graphHasGetAttr(Block* block) {
+  for (Node* node : block->nodes()) {
+    if (node->kind() == prim::GetAttr) {
+      return true;
+    }
+    for (Block* sub_block : node->blocks()) {
+      if (graphHasGetAttr(sub_block)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void testFreezeModule() {
+  // Parameters reached through a submodule chain become constants and the
+  // frozen module still computes the same result
+  script::Module sub("sub");
+  sub.register_parameter("weight", 2 * torch::ones({2, 2}), false);
+  sub.define(R"(
+    def forward(self, x):
+      return self.weight * x
+  )");
+  script::Module m("m");
+  m.register_parameter("bias", torch::ones({2, 2}), false);
+  m.register_module("sub", sub);
+  m.define(R"(
+    def forward(self, x):
+      return self.sub.forward(x) + self.bias
+  )");
+  auto input = torch::randn({2, 2});
+  auto expected = m.forward({input}).toTensor();
+  FreezeModule(m);
+  auto graph = m.get_method("forward").graph();
+  ASSERT_FALSE(graphHasGetAttr(graph->block()));
+  auto frozen = m.forward({input}).toTensor();
+  ASSERT_TRUE(expected.allclose(frozen));
+
+  // An attribute assigned in forward is not folded and keeps mutating
+  script::Module counter("counter");
+  counter.register_attribute("count", IntType::get(), 0);
+  counter.define(R"(
+    def forward(self, x):
+      self.count = self.count + 1
+      return x + self.count
+  )");
+  FreezeModule(counter);
+  ASSERT_TRUE(
+      graphHasGetAttr(counter.get_method("forward").graph()->block()));
+  auto ones = torch::ones({2});
+  auto first = counter.forward({ones}).toTensor();
+  auto second = counter.forward({ones}).toTensor();
+  ASSERT_TRUE(first.allclose(2 * ones));
+  ASSERT_TRUE(second.allclose(3 * ones));
+}
+
+} // namespace jit
+} // namespace torch
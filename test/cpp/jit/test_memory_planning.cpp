@@ -0,0 +1,73 @@
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/irparser.h>
+#include <torch/csrc/jit/passes/memory_planning.h>
+#include "test/cpp/jit/test_base.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+void testMemoryPlanning() {
+  auto graph = std::make_shared<Graph>();
+  std::unordered_map<std::string, Value*> vmap;
+  script::parseIR(
+      R"IR(
+graph(%a : Float(4, 16)):
+  %b : Float(4, 16) = aten::relu(%a)
+  %c : Float(4, 16) = aten::relu(%b)
+  %d : Float(4, 16) = aten::relu(%c)
+  %e : Float(4, 16) = aten::relu(%d)
+  return (%e)
+  )IR",
+      &*graph,
+      vmap);
+
+  auto plan = PlanMemory(graph);
+
+  // %a (input) and %e (output) are not planned; %b, %c, %d are
+  ASSERT_EQ(plan.offsets.size(), 3);
+  ASSERT_EQ(plan.offsets.count(vmap["a"]), 0);
+  ASSERT_EQ(plan.offsets.count(vmap["e"]), 0);
+
+  const auto b = plan.offsets.at(vmap["b"]);
+  const auto c = plan.offsets.at(vmap["c"]);
+  const auto d = plan.offsets.at(vmap["d"]);
+  constexpr size_t tensor_bytes = 4 * 16 * sizeof(float);
+
+  // slices are as aligned as freshly allocated tensors
+  ASSERT_EQ(b % 64, 0);
+  ASSERT_EQ(c % 64, 0);
+  ASSERT_EQ(d % 64, 0);
+
+  // %c is live at the same time as both %b and %d, so it may not share
+  // bytes with either
+  ASSERT_TRUE(c + tensor_bytes <= b || b + tensor_bytes <= c);
+  ASSERT_TRUE(c + tensor_bytes <= d || d + tensor_bytes <= c);
+
+  // %b is dead by the time %d is defined, so their slots coincide and the
+  // arena only needs room for two tensors
+  ASSERT_EQ(b, d);
+  ASSERT_EQ(plan.arena_size, 2 * tensor_bytes);
+
+  // values without a static shape are left out of the plan
+  auto dynamic_graph = std::make_shared<Graph>();
+  std::unordered_map<std::string, Value*> dynamic_vmap;
+  script::parseIR(
+      R"IR(
+graph(%a : Float(4, 16)):
+  %b : Tensor = aten::relu(%a)
+  %c : Float(4, 16) = aten::relu(%b)
+  %d : Float(4, 16) = aten::relu(%c)
+  return (%d)
+  )IR",
+      &*dynamic_graph,
+      dynamic_vmap);
+  auto dynamic_plan = PlanMemory(dynamic_graph);
+  ASSERT_EQ(dynamic_plan.offsets.size(), 1);
+  ASSERT_EQ(dynamic_plan.offsets.count(dynamic_vmap["c"]), 1);
+}
+
+} // namespace jit
+} // namespace torch
@@ -809,6 +809,25 @@ void testRecordFunction() {
 
   autograd::profiler::popCallback();
   autograd::profiler::popCallback();
+
+  // per-callback sampling probability, decided with the geometric skip
+  // counter
+  int per_cb_ctr = 0;
+  autograd::profiler::pushCallback(
+      [&per_cb_ctr](const autograd::profiler::RecordFunction& fn) {
+        if (std::string(fn.name().str()) == "test") {
+          ++per_cb_ctr;
+        }
+      },
+      [](const autograd::profiler::RecordFunction&) {},
+      /* needs_inputs */ false,
+      /* sampled */ false,
+      /* sampling_prob */ 0.5);
+
+  run_test_function();
+  TORCH_CHECK(per_cb_ctr > 0 && per_cb_ctr < 1000);
+
+  autograd::profiler::popCallback();
 }
 
 class TestThreadLocalDebugInfo
@@ -899,6 +918,24 @@ void testAutogradProfiler() {
        count++, pos++) {
   }
   TORCH_CHECK(count == 200);
+
+  // Streaming mode: the background writer flushes completed ranges
+  // incrementally, but the resulting trace has the same contents.
+  std::stringstream ss_streaming;
+  {
+    autograd::profiler::RecordProfile guard(
+        ss_streaming, std::chrono::milliseconds(1));
+    for (size_t i = 0; i < 100; ++i) {
+      std::tie(hx, cx) = lstm(input[0], hx, cx, w_ih, w_hh);
+    }
+  }
+
+  result = ss_streaming.str();
+  count = 0;
+  for (size_t pos = 0; (pos = result.find("tanh", pos)) != std::string::npos;
+       count++, pos++) {
+  }
+  TORCH_CHECK(count == 200);
 }
 
 void testNoneSchemaMatch() {
@@ -1149,5 +1186,42 @@ void testProfiler() {
   checkShape(*tanh_n, eltwise);
 }
 
+void testProfilerMultipleRuns() {
+  auto prev_runs = getNumProfiledRuns().exchange(2);
+  static const auto basic_example = R"JIT(
+  def basic(x):
+    return x + x
+  )JIT";
+
+  auto cu = compile(basic_example);
+  auto& fun = cu->get_function("basic");
+  auto pr = ProfilingRecord::instrumentGraph(fun.graph());
+  Code cd(pr->profiled_graph_);
+  auto run = [&](std::vector<int64_t> shape) {
+    auto stack = createStack({at::randn(shape, at::kCPU)});
+    InterpreterState is{cd};
+    is.run(stack);
+  };
+  run({2, 3});
+  ASSERT_FALSE(pr->ready());
+  run({4, 3});
+  ASSERT_TRUE(pr->ready());
+
+  // profiles from both runs are merged: the varying dimension becomes
+  // dynamic while the stable one keeps its recorded extent
+  auto begin = pr->profiled_graph_->block()->nodes().begin();
+  auto end = pr->profiled_graph_->block()->nodes().end();
+  auto add =
+      std::find_if(begin, end, [](Node* n) { return n->kind() == aten::add; });
+  ASSERT_NE(add, end);
+  auto profiled_type =
+      add->inputs().at(0)->node()->output()->type()->expect<TensorType>();
+  auto sizes = profiled_type->sizes();
+  ASSERT_EQ(sizes.size().value(), 2);
+  ASSERT_FALSE(sizes[0].has_value());
+  ASSERT_EQ(sizes[1].value(), 3);
+  getNumProfiledRuns() = prev_runs;
+}
+
 } // namespace jit
 } // namespace torch
@@ -0,0 +1,45 @@
+#include <test/cpp/jit/test_base.h>
+#include <test/cpp/jit/test_utils.h>
+
+#include <torch/csrc/jit/script/compilation_unit.h>
+#include <torch/csrc/jit/static_runtime.h>
+
+namespace torch {
+namespace jit {
+
+const auto staticRuntimeSource = R"JIT(
+def forward(a, b):
+    c = a * b
+    return c + a
+
+def branchy(a, flag: bool):
+    if flag:
+        return a + a
+    return a
+)JIT";
+
+void testStaticRuntime() {
+  script::CompilationUnit cu(staticRuntimeSource);
+
+  auto g = cu.get_function("forward").graph();
+  ASSERT_TRUE(StaticRuntime::canRun(*g));
+  StaticRuntime runtime(g);
+
+  auto a = at::rand({2, 3});
+  auto b = at::rand({2, 3});
+  auto expect = a * b + a;
+  // run twice: the register file is reused across calls
+  for (int i = 0; i < 2; ++i) {
+    auto outputs = runtime.run({a, b});
+    ASSERT_EQ(outputs.size(), 1);
+    ASSERT_TRUE(expect.allclose(outputs[0].toTensor()));
+  }
+
+  // control flow is rejected up front rather than mis-executed
+  auto branchy = cu.get_function("branchy").graph();
+  ASSERT_FALSE(StaticRuntime::canRun(*branchy));
+  ASSERT_ANY_THROW(StaticRuntime{branchy});
+}
+
+} // namespace jit
+} // namespace torch
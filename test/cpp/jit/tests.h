@@ -47,6 +47,7 @@ namespace jit {
   _(NoneSchemaMatch)                   \
   _(ClassParser)                       \
   _(Profiler)                          \
+  _(ProfilerMultipleRuns)              \
   _(InsertAndEliminateRedundantGuards) \
   _(InsertBailOuts)                    \
   _(PeepholeOptimize)                  \
@@ -65,6 +66,9 @@ namespace jit {
   _(ClassDerive)                       \
   _(ModuleInterfaceSerialization)      \
   _(ClassTypeAddRemoveAttr)            \
+  _(FreezeModule)                      \
+  _(StaticRuntime)                     \
+  _(MemoryPlanning)                    \
   _(Inliner)                           \
   _(LiteInterpreterAdd)                \
   _(LiteInterpreterConv)               \
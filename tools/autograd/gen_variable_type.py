@@ -922,6 +922,20 @@ def emit_body(declaration):
             return []
         return ['check_inplace({});'.format(arg['name']) for arg in differentiable_outputs]
 
+    def emit_write_fence():
+        # Copy-on-write storages must materialize before a kernel writes
+        # through them. Unlike check_inplace, this has to run for every
+        # mutating op (including out= variants and non-differentiable
+        # in-place ops), so it is emitted unconditionally.
+        if not modifies_arguments:
+            return []
+        if is_out_fn:
+            modified = [arg for arg in arguments
+                        if arg.get('output', False) and arg['simple_type'] == 'Tensor']
+        else:
+            modified = [r for r in returns if r['dynamic_type'] == 'Tensor']
+        return ['materialize_for_write({});'.format(arg['name']) for arg in modified]
+
     def emit_increment_version():
         if not modifies_arguments:
             return []
@@ -953,6 +967,7 @@ def emit_body(declaration):
     pre_record_trace, post_record_trace = format_trace(declaration)
 
     body.append(pre_record_trace)
+    body.extend(emit_write_fence())
     body.append(emit_call(env))
     if requires_derivative:
         # set_flags has to appear after version_counter, because rebase_history
@@ -837,7 +837,19 @@ Tensor glu_double_backward_grad_output(const Tensor & grad, const Tensor & input
 
 Tensor infinitely_differentiable_gelu_backward(
     const Tensor& grad,
-    const Tensor& self) {
+    const Tensor& self,
+    bool approximate) {
+  if (approximate) {
+    constexpr double kBeta = M_2_SQRTPI * M_SQRT1_2;
+    constexpr double kKappa = 0.044715;
+    Tensor inner = kBeta * (self + kKappa * self * self * self);
+    Tensor tanh_inner = inner.tanh();
+    Tensor left_derivative = 0.5 * (1.0 + tanh_inner);
+    Tensor tanh_derivative = 1.0 - tanh_inner * tanh_inner;
+    Tensor inner_derivative = kBeta * (1.0 + 3.0 * kKappa * self * self);
+    Tensor right_derivative = 0.5 * self * tanh_derivative * inner_derivative;
+    return grad * (left_derivative + right_derivative);
+  }
   constexpr double kAlpha = M_2_SQRTPI * M_SQRT1_2 * 0.5;
   Tensor cdf = (1.0 + (self * M_SQRT1_2).erf_()).mul_(0.5);
   Tensor pdf = (-0.5 * self * self).exp_();
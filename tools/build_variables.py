@@ -45,6 +45,7 @@ libtorch_sources = [
     "torch/csrc/autograd/functions/tensor.cpp",
     "torch/csrc/autograd/functions/utils.cpp",
     "torch/csrc/autograd/input_buffer.cpp",
+    "torch/csrc/autograd/op_latency_histogram.cpp",
     "torch/csrc/autograd/profiler.cpp",
     "torch/csrc/autograd/record_function.cpp",
     "torch/csrc/autograd/record_function_ops.cpp",
@@ -86,6 +87,7 @@ libtorch_sources = [
     "torch/csrc/jit/pickler.cpp",
     "torch/csrc/jit/unpickler.cpp",
     "torch/csrc/jit/graph_executor.cpp",
+    "torch/csrc/jit/static_runtime.cpp",
     "torch/csrc/jit/import.cpp",
     "torch/csrc/jit/import_legacy.cpp",
     "torch/csrc/jit/pickle.cpp",
@@ -116,6 +118,7 @@ libtorch_sources = [
     "torch/csrc/jit/passes/dead_code_elimination.cpp",
     "torch/csrc/jit/passes/erase_number_types.cpp",
     "torch/csrc/jit/passes/fixup_trace_scope_blocks.cpp",
+    "torch/csrc/jit/passes/freeze_module.cpp",
     "torch/csrc/jit/passes/graph_fuser.cpp",
     "torch/csrc/jit/passes/guard_elimination.cpp",
     "torch/csrc/jit/passes/inline_autodiff_subgraphs.cpp",
@@ -124,7 +127,9 @@ libtorch_sources = [
     "torch/csrc/jit/passes/inline_forked_closures.cpp",
     "torch/csrc/jit/passes/inplace_check.cpp",
     "torch/csrc/jit/passes/insert_guards.cpp",
+    "torch/csrc/jit/passes/insert_mixed_precision_casts.cpp",
     "torch/csrc/jit/passes/liveness.cpp",
+    "torch/csrc/jit/passes/memory_planning.cpp",
     "torch/csrc/jit/passes/loop_unrolling.cpp",
     "torch/csrc/jit/passes/lower_grad_of.cpp",
     "torch/csrc/jit/passes/lower_graph.cpp",
@@ -205,6 +210,7 @@ def add_torch_libs():
 
     torch_cpp_srcs = [
         "torch/csrc/api/src/cuda.cpp",  # this just forwards stuff, no real CUDA
+        "torch/csrc/api/src/data/datasets/mmap_chunk.cpp",
         "torch/csrc/api/src/data/datasets/mnist.cpp",
         "torch/csrc/api/src/data/samplers/distributed.cpp",
         "torch/csrc/api/src/data/samplers/random.cpp",
@@ -247,6 +253,7 @@ def add_torch_libs():
         "torch/csrc/api/src/optim/adagrad.cpp",
         "torch/csrc/api/src/optim/adam.cpp",
         "torch/csrc/api/src/optim/lbfgs.cpp",
+        "torch/csrc/api/src/optim/loss_scaler.cpp",
         "torch/csrc/api/src/optim/optimizer.cpp",
         "torch/csrc/api/src/optim/rmsprop.cpp",
         "torch/csrc/api/src/optim/serialize.cpp",
@@ -290,6 +297,7 @@ def add_torch_libs():
         "torch/csrc/distributed/c10d/comm.cpp",
         "torch/csrc/distributed/c10d/init.cpp",
         "torch/csrc/distributed/c10d/reducer.cpp",
+        "torch/csrc/distributed/c10d/sharded_optimizer.cpp",
         "torch/csrc/distributed/rpc/init.cpp",
         "torch/csrc/distributed/rpc/process_group_agent.cpp",
         "torch/csrc/distributed/rpc/py_rref.cpp",
@@ -106,6 +106,11 @@ class EventList(list):
             chrome_events = []
             next_id = 0
             for evt in self:
+                # The correlation id was handed out at launch time by the
+                # profiler; fall back to a synthetic id for events that do
+                # not carry one (e.g. nvprof imports).
+                flow_id = getattr(evt, 'correlation_id', 0)
+                args = {'correlation': flow_id} if flow_id else {}
                 chrome_events.append(dict(
                     name=evt.name,
                     ph='X',
@@ -113,9 +118,12 @@ class EventList(list):
                     dur=evt.cpu_interval.elapsed_us(),
                     tid=evt.thread,
                     pid='CPU functions',
-                    args={},
+                    args=args,
                 ))
                 for k in evt.kernels:
+                    if not flow_id:
+                        next_id += 1
+                        flow_id = 'synthetic_{}'.format(next_id)
                     # 's' and 'f' draw Flow arrows from
                     # the CPU launch to the GPU kernel
                     chrome_events.append(dict(
@@ -124,7 +132,7 @@ class EventList(list):
                         ts=evt.cpu_interval.start,
                         tid=evt.thread,
                         pid='CPU functions',
-                        id=next_id,
+                        id=flow_id,
                         cat='cpu_to_cuda',
                         args={},
                     ))
@@ -134,8 +142,9 @@ class EventList(list):
                         ts=k.interval.start,
                         tid=k.device,
                         pid='CUDA functions',
-                        id=next_id,
+                        id=flow_id,
                         cat='cpu_to_cuda',
+                        bp='e',
                         args={},
                     ))
                     chrome_events.append(dict(
@@ -145,9 +154,8 @@ class EventList(list):
                         dur=k.interval.elapsed_us(),
                         tid=k.device,
                         pid='CUDA functions',
-                        args={},
+                        args=args,
                     ))
-                    next_id += 1
 
             json.dump(chrome_events, f)
 
@@ -460,6 +468,64 @@ class emit_nvtx(object):
         return False
 
 
+class emit_itt(object):
+    """Context manager that makes every autograd operation emit an ITT range.
+
+    It is useful when running the program under Intel VTune::
+
+        vtune -collect hotspots -start-paused -- <regular command here>
+
+    The Instrumentation and Tracing Technology (ITT) API lets the program
+    annotate VTune timelines with named tasks, so op-level ranges show up
+    in the VTune GUI the way NVTX ranges do in Nvidia tools. Requires a
+    PyTorch build with ``USE_ITT``.
+
+    .. warning:
+        This context manager should not be called recursively, i.e. at most one
+        instance should be enabled at any given time.
+
+    Arguments:
+        enabled (bool, optional, default=True): Setting ``enabled=False`` makes this context manager a no-op.
+            Default: ``True``.
+        record_shapes (bool, optional, default=False): If ``record_shapes=True``, the itt range wrapping
+            each autograd op will append information about the sizes of Tensor arguments received
+            by that op, in the following format:
+            ``[[arg0.size(0), arg0.size(1), ...], [arg1.size(0), arg1.size(1), ...], ...]``
+            Non-tensor arguments will be represented by ``[]``.
+            Arguments will be listed in the order they are received by the backend op.
+            Please note that this order may not match the order in which those arguments were passed
+            on the Python side.  Also note that shape recording may increase the overhead of itt range creation.
+
+    Example:
+        >>> with torch.autograd.profiler.emit_itt():
+        ...     model(x)
+    """
+    def __init__(self, enabled=True, record_shapes=False):
+        self.enabled = enabled
+        self.entered = False
+        self.record_shapes = record_shapes
+
+    def __enter__(self):
+        if not self.enabled:
+            return
+        if self.entered:
+            raise RuntimeError("ITT annotation context manager is not reentrant")
+        self.entered = True
+        torch.autograd._enable_profiler(
+            torch.autograd.ProfilerConfig(
+                torch.autograd.ProfilerState.ITT,
+                self.record_shapes
+            )
+        )
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        if not self.enabled:
+            return
+        torch.autograd._disable_profiler()
+        return False
+
+
 def load_nvprof(path):
     """Opens an nvprof trace file and parses autograd annotations.
 
@@ -530,7 +596,8 @@ Kernel = namedtuple('Kernel', ['name', 'device', 'interval'])
 # TODO: record TID too
 class FunctionEvent(FormattedTimesMixin):
     """Profiling information about a single function."""
-    def __init__(self, id, name, thread, cpu_start, cpu_end, input_shapes=None):
+    def __init__(self, id, name, thread, cpu_start, cpu_end, input_shapes=None,
+                 correlation_id=0):
         self.id = id
         self.name = name
         self.cpu_interval = Interval(cpu_start, cpu_end)
@@ -539,6 +606,9 @@ class FunctionEvent(FormattedTimesMixin):
         self.count = 1
         self.cpu_children = []
         self.input_shapes = input_shapes
+        # Assigned at launch time by the profiler when recording CUDA; links
+        # this CPU range to the device execution it caused. 0 if unassigned.
+        self.correlation_id = correlation_id
 
     def append_kernel(self, name, device, start, end):
         self.kernels.append(Kernel(name, device, Interval(start, end)))
@@ -684,7 +754,8 @@ def parse_cpu_trace(thread_records):
                 thread=start.thread_id(),
                 cpu_start=start_record.cpu_elapsed_us(start),
                 cpu_end=start_record.cpu_elapsed_us(record),
-                input_shapes=start.shapes())
+                input_shapes=start.shapes(),
+                correlation_id=start.correlation_id())
             if start.has_cuda():
                 cuda_start = adjusted_time(start)
                 cuda_end = adjusted_time(record)
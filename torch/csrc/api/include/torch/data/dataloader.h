@@ -6,6 +6,7 @@
 #include <torch/csrc/utils/memory.h>
 #include <torch/csrc/utils/variadic.h>
 
+#include <ATen/detail/CUDAHooksInterface.h>
 #include <c10/util/Exception.h>
 
 #include <cstddef>
@@ -54,5 +55,15 @@ std::unique_ptr<StatefulDataLoader<Dataset>> make_data_loader(
   return torch::make_unique<StatefulDataLoader<Dataset>>(
       std::move(dataset), std::move(options));
 }
+
+/// Pre-reserves `n_batches` pinned host buffers of `bytes_per_batch` bytes
+/// each in the CUDA caching host allocator. Call this before starting a
+/// pipeline that keeps `n_batches` batches in flight (e.g. a `DataLoader`
+/// with that many workers feeding asynchronous H2D copies), so steady-state
+/// iteration never stalls in `cudaHostAlloc`. Requires the CUDA library to
+/// be loaded; throws otherwise.
+inline void reserve_pinned_memory(size_t bytes_per_batch, size_t n_batches) {
+  at::detail::getCUDAHooks().reservePinnedMemory(bytes_per_batch, n_batches);
+}
 } // namespace data
 } // namespace torch
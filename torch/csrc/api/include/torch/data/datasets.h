@@ -1,8 +1,10 @@
 #pragma once
 
 #include <torch/data/datasets/base.h>
+#include <torch/data/datasets/buffered_shuffle.h>
 #include <torch/data/datasets/chunk.h>
 #include <torch/data/datasets/map.h>
+#include <torch/data/datasets/mmap_chunk.h>
 #include <torch/data/datasets/mnist.h>
 #include <torch/data/datasets/shared.h>
 #include <torch/data/datasets/stateful.h>
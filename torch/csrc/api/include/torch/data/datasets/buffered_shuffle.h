@@ -0,0 +1,153 @@
+#pragma once
+
+#include <torch/data/datasets/stateful.h>
+#include <torch/types.h>
+
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// A stateful dataset stage that shuffles a streaming source through a
+/// fixed-capacity reservoir.
+///
+/// Index-based samplers like `RandomSampler` permute the whole index range up
+/// front and therefore need to know the dataset size, which an unbounded or
+/// streamed corpus cannot provide. This stage instead keeps at most
+/// `buffer_size` examples in memory: batches pulled from the source dataset
+/// refill the reservoir, and returned examples are drawn from it uniformly at
+/// random (without replacement) using ATen's generator, so runs are
+/// reproducible under `torch::manual_seed`. A deeper reservoir shuffles more
+/// thoroughly; a `buffer_size` several times the batch size is a reasonable
+/// starting point.
+///
+/// The source is held through a `shared_ptr` and must provide a
+/// no-argument `get_batch()` yielding its next batch, as `ChunkDataset`
+/// does. This stage's own accessors are internally synchronized, so it can
+/// itself be wrapped in a `SharedBatchDataset` and used from multiple
+/// dataloader workers:
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   auto chunk_dataset = std::make_shared<ChunkDatasetType>(...);
+///   auto dataset = datasets::make_shared_dataset<
+///       datasets::BufferedShuffleDataset<ChunkDatasetType>>(
+///       chunk_dataset, /*buffer_size=*/512);
+///   auto data_loader = torch::data::make_data_loader(dataset, options);
+/// \endrst
+template <typename SourceDataset>
+class BufferedShuffleDataset
+    : public StatefulDataset<
+          BufferedShuffleDataset<SourceDataset>,
+          typename SourceDataset::BatchType::value_type,
+          size_t> {
+ public:
+  using BatchType = typename SourceDataset::BatchType;
+  using UnwrappedBatchType = typename BatchType::value_type;
+  using ExampleType = typename UnwrappedBatchType::value_type;
+
+  BufferedShuffleDataset(
+      std::shared_ptr<SourceDataset> source,
+      size_t buffer_size)
+      : source_(std::move(source)), buffer_size_(buffer_size) {
+    TORCH_CHECK(source_ != nullptr, "source dataset must not be null");
+    TORCH_CHECK(buffer_size_ > 0, "buffer_size must be greater than 0");
+    buffer_.reserve(buffer_size_);
+  }
+
+  /// Refills the reservoir from the source and draws up to `batch_size`
+  /// random examples from it. Returns an empty optional once the source is
+  /// exhausted and the reservoir has drained, signaling the end of an epoch.
+  BatchType get_batch(size_t batch_size) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    fill_buffer();
+    if (buffer_.empty()) {
+      return nullopt;
+    }
+    const size_t count = std::min(batch_size, buffer_.size());
+    auto permutation = torch::randperm(static_cast<int64_t>(buffer_.size()));
+    std::vector<int64_t> selected(
+        permutation.data_ptr<int64_t>(),
+        permutation.data_ptr<int64_t>() + count);
+    // Remove the largest index first, so that filling each hole with the
+    // current last element never moves another selected example.
+    std::sort(selected.begin(), selected.end(), std::greater<int64_t>());
+    UnwrappedBatchType batch;
+    batch.reserve(count);
+    for (int64_t index : selected) {
+      batch.push_back(std::move(buffer_[index]));
+      buffer_[index] = std::move(buffer_.back());
+      buffer_.pop_back();
+    }
+    return batch;
+  }
+
+  /// Resets the source dataset and discards any buffered examples.
+  void reset() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source_->reset();
+    buffer_.clear();
+    source_exhausted_ = false;
+  }
+
+  /// Returns the `size` of the source dataset, if it has one.
+  optional<size_t> size() const override {
+    return source_->size();
+  }
+
+  /// Saves the source dataset's state. The reservoir itself is not
+  /// serialized; after loading, an epoch resumes with a fresh buffer.
+  void save(serialize::OutputArchive& archive) const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source_->save(archive);
+  }
+
+  /// Restores the source dataset's state.
+  void load(serialize::InputArchive& archive) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    source_->load(archive);
+    buffer_.clear();
+    source_exhausted_ = false;
+  }
+
+  /// Accesses the source dataset.
+  SourceDataset& dataset() {
+    return *source_;
+  }
+
+ private:
+  /// Pulls batches from the source until the reservoir is full or the source
+  /// reports the end of its epoch. The source decides its own batch size
+  /// (`ChunkDataset` rejects any other), so the reservoir may briefly
+  /// overshoot `buffer_size` by less than one source batch.
+  void fill_buffer() {
+    while (buffer_.size() < buffer_size_ && !source_exhausted_) {
+      auto batch = source_->get_batch();
+      if (!batch || batch->empty()) {
+        source_exhausted_ = true;
+        break;
+      }
+      std::move(batch->begin(), batch->end(), std::back_inserter(buffer_));
+    }
+  }
+
+  std::shared_ptr<SourceDataset> source_;
+  const size_t buffer_size_;
+  std::vector<ExampleType> buffer_;
+  bool source_exhausted_ = false;
+  mutable std::mutex mutex_;
+};
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -290,6 +290,14 @@ struct ChunkDatasetOptions {
   // penalty when this value is greater than 1, as we need to do extra merge
   // between multiple chunks before performing example sampling.
   TORCH_ARG(size_t, cross_chunk_shuffle_count) = 1;
+
+  /// Whether preloader threads survive epoch boundaries. By default,
+  /// `reset()` joins the preloaders and spawns fresh ones, which also
+  /// discards any per-thread state (file handles, decompression contexts)
+  /// the chunk reader may have built up. With persistent workers, the
+  /// preloaders go idle at the end of an epoch and are woken by the next
+  /// `reset()`, keeping that state warm across epochs.
+  TORCH_ARG(bool, persistent_workers) = false;
 };
 
 /// A stateful dataset that support hierarchical sampling and prefetching of
@@ -330,6 +338,7 @@ class ChunkDataset final
         preprocessing_policy_(preprocessing_policy),
         quit_worker_(false),
         running_preloaders_(0),
+        abort_epoch_(false),
         load_checkpoint_(false) {}
 
   virtual ~ChunkDataset() {
@@ -365,13 +374,28 @@ class ChunkDataset final
   /// This will clear any internal state and starts the internal prefetching
   /// mechanism for the chunk dataset.
   void reset() override {
+    const bool workers_alive =
+        options_.persistent_workers() && !preload_threads_.empty();
+
+    // Raise the abort flag before waking writers blocked on the buffer, so
+    // persistent preloaders stop reading chunks as soon as they return.
+    abort_epoch_ = workers_alive;
     // We need this to support partial data reads via dataloader iterator.
     if (batch_buffer_) {
       batch_buffer_->stop();
     }
-    // free workers from previous reset if there is any.
-    free_workers();
-    preload_threads_.clear();
+    if (workers_alive) {
+      // Persistent workers are not torn down; wait until every preloader
+      // has gone idle, so that the state below can be swapped out safely.
+      std::unique_lock<std::mutex> lock(epoch_mutex_);
+      epoch_done_cv_.wait(
+          lock, [this] { return running_preloaders_.load() == 0; });
+      abort_epoch_ = false;
+    } else {
+      // free workers from previous reset if there is any.
+      free_workers();
+      preload_threads_.clear();
+    }
 
     if (!load_checkpoint_){
       chunk_reader_.reset();
@@ -387,13 +411,22 @@ class ChunkDataset final
         example_sampler_,
         options_.cache_size());
 
-    // create new workers for this new epoch.
+    // start workers for this new epoch.
     quit_worker_ = false;
 
     AT_ASSERT(running_preloaders_ == 0);
     running_preloaders_ = options_.preloader_count();
-    for (size_t i = 0; i < options_.preloader_count(); ++i) {
-      preload_threads_.emplace_back([this, i]() { this->preloader(i); });
+    if (workers_alive) {
+      // wake the idle preloaders for the new epoch.
+      {
+        std::lock_guard<std::mutex> lock(epoch_mutex_);
+        ++epoch_;
+      }
+      epoch_begin_cv_.notify_all();
+    } else {
+      for (size_t i = 0; i < options_.preloader_count(); ++i) {
+        preload_threads_.emplace_back([this, i]() { this->preloader(i); });
+      }
     }
   }
 
@@ -423,6 +456,42 @@ class ChunkDataset final
   /// running on worker thread to preload chunk data.
   void preloader(size_t id) {
     while (!quit_worker_.load()) {
+      preload_epoch(id);
+
+      // Mark this preloader as done with the epoch. The epoch number is
+      // captured under the same lock as the decrement: `reset()` only
+      // advances it once every preloader has gone idle, so this is the
+      // epoch this preloader just finished.
+      size_t finished_epoch;
+      {
+        std::lock_guard<std::mutex> lock(epoch_mutex_);
+        finished_epoch = epoch_;
+        AT_ASSERT(running_preloaders_.load() > 0);
+        --running_preloaders_;
+        if (running_preloaders_.load() == 0) {
+          // all preloaders are completed, so we can notify the batch_buffer.
+          batch_buffer_->stop();
+        }
+      }
+      epoch_done_cv_.notify_all();
+
+      if (!options_.persistent_workers()) {
+        return;
+      }
+
+      // Go idle until the next epoch begins (or the dataset shuts down),
+      // keeping any state the chunk reader built up warm.
+      std::unique_lock<std::mutex> lock(epoch_mutex_);
+      epoch_begin_cv_.wait(lock, [this, finished_epoch] {
+        return quit_worker_.load() || epoch_ != finished_epoch;
+      });
+    }
+  }
+
+  /// Preloads chunks until the chunk sampler exhausts, the epoch is
+  /// aborted by `reset()`, or the dataset shuts down.
+  void preload_epoch(size_t id) {
+    while (!quit_worker_.load() && !abort_epoch_.load()) {
       try {
         std::vector<size_t> chunk_idx;
         {
@@ -449,18 +518,19 @@ class ChunkDataset final
         batch_buffer_->add_chunk_data(std::current_exception());
       }
     }
-    AT_ASSERT(running_preloaders_.load() > 0);
-    --running_preloaders_;
-    if (running_preloaders_.load() == 0) {
-      // all preloaders are completed, so we can notify the batch_buffer.
-      batch_buffer_->stop();
-    }
   }
 
   /// Block the current thread until the workers finish execution and exit.
   void free_workers() {
     if (!quit_worker_.load()) {
-      quit_worker_ = true;
+      {
+        // Hold the lock so that idle persistent workers cannot miss the
+        // notification between evaluating their wait predicate and going
+        // to sleep.
+        std::lock_guard<std::mutex> lock(epoch_mutex_);
+        quit_worker_ = true;
+      }
+      epoch_begin_cv_.notify_all();
       for (auto& worker_thread : preload_threads_) {
         worker_thread.join();
       }
@@ -508,6 +578,18 @@ class ChunkDataset final
   // indicates that the chunk loading is completed.
   std::atomic<size_t> running_preloaders_;
 
+  // set by reset() to make persistent workers abandon the remainder of an
+  // epoch that was only partially read.
+  std::atomic<bool> abort_epoch_;
+
+  // the current epoch number; incremented by reset() to wake idle
+  // persistent workers. Guarded by epoch_mutex_, which also guards
+  // running_preloaders_ transitions the epoch logic waits on.
+  size_t epoch_ = 0;
+  std::mutex epoch_mutex_;
+  std::condition_variable epoch_begin_cv_;
+  std::condition_variable epoch_done_cv_;
+
   // mutex to synchronize chunk sampler next() call.
   mutable std::mutex chunk_index_guard_;
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <torch/data/datasets/chunk.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+/// A `ChunkDataReader` over a binary, memory-mappable chunk file format.
+///
+/// Each chunk is a single file of fixed-shape records:
+///
+///   int64 magic
+///   int64 version
+///   int64 record count
+///   int64 data scalar type   | int64 target scalar type
+///   int64 data ndim, dims... | int64 target ndim, dims...
+///   (zero padding up to the record alignment)
+///   records: data bytes, target bytes, each padded to the record alignment
+///
+/// All integers are native-endian, records are aligned to 64 bytes, and
+/// every record in a file shares the same dtypes and shapes. Because the
+/// tensor bytes are stored exactly as laid out in memory, `read_chunk`
+/// can `mmap` the file and wrap each record in a tensor pointing straight
+/// into the mapping: chunk loading is then driven by the page cache and
+/// involves no deserialization or copies. The mapping is private
+/// (copy-on-write), so writing to a returned tensor will not corrupt the
+/// chunk file. The mapping stays alive for as long as any tensor of the
+/// chunk does.
+///
+/// Not supported on Windows.
+class TORCH_API MmapChunkDataReader : public ChunkDataReader<Example<>> {
+ public:
+  using ChunkType = ChunkDataReader<Example<>>::ChunkType;
+
+  /// Constructs the reader from one chunk file path per chunk.
+  explicit MmapChunkDataReader(std::vector<std::string> chunk_files);
+
+  /// Maps the given chunk file and returns its records as tensors that
+  /// alias the mapping.
+  ChunkType read_chunk(size_t chunk_index) override;
+
+  /// Returns the number of chunk files.
+  size_t chunk_count() override;
+
+  /// The reader keeps no per-epoch state.
+  void reset() override;
+
+  /// Writes `examples` to `filename` in the format described above. All
+  /// examples must be CPU tensors with the same dtypes and shapes.
+  static void write_chunk(const std::string& filename, const ChunkType& examples);
+
+ private:
+  std::vector<std::string> chunk_files_;
+};
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -0,0 +1,347 @@
+#pragma once
+
+#include <torch/arg.h>
+#include <torch/data/example.h>
+#include <torch/data/iterator.h>
+#include <torch/types.h>
+
+#include <torch/csrc/utils/memory.h>
+
+#include <c10/core/Device.h>
+#include <c10/core/DeviceGuard.h>
+#include <c10/core/Event.h>
+#include <c10/core/Stream.h>
+#include <c10/core/impl/VirtualGuardImpl.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace torch {
+namespace data {
+
+/// Options for a `DevicePrefetcher`.
+struct DevicePrefetcherOptions {
+  DevicePrefetcherOptions() = default;
+
+  /// The number of device-resident batches to keep ready ahead of the
+  /// consumer. Two is classic double buffering: one batch in use, one in
+  /// flight.
+  TORCH_ARG(size_t, buffer_size) = 2;
+
+  /// Whether to move CPU batches into pinned memory before the device copy.
+  /// Pinned source memory is required for the copy to actually be
+  /// asynchronous on CUDA devices.
+  TORCH_ARG(bool, pin_memory) = true;
+
+  /// The stream on which to issue device copies. Pass a side stream (e.g.
+  /// one from `at::cuda::getStreamFromPool()`) to overlap the copies with
+  /// compute on the default stream; when unset, the device's current
+  /// stream is used and copies only overlap with host work.
+  TORCH_ARG(optional<c10::Stream>, stream);
+};
+
+namespace detail {
+
+/// Moves a batch to a device, one tensor at a time. Overloads below cover
+/// the batch shapes the data API produces; user-defined batch types can
+/// add their own overload in this namespace.
+inline Tensor to_device(Tensor tensor, Device device, bool pin_memory) {
+  if (!tensor.defined() || tensor.device() == device) {
+    return tensor;
+  }
+  if (pin_memory && device.is_cuda() && tensor.device().is_cpu() &&
+      !tensor.is_pinned()) {
+    tensor = tensor.pin_memory();
+  }
+  return tensor.to(device, tensor.scalar_type(), /*non_blocking=*/true);
+}
+
+inline Example<> to_device(Example<> example, Device device, bool pin_memory) {
+  example.data = to_device(std::move(example.data), device, pin_memory);
+  example.target = to_device(std::move(example.target), device, pin_memory);
+  return example;
+}
+
+inline TensorExample to_device(
+    TensorExample example,
+    Device device,
+    bool pin_memory) {
+  example.data = to_device(std::move(example.data), device, pin_memory);
+  return example;
+}
+
+template <typename T>
+std::vector<T> to_device(std::vector<T> batch, Device device, bool pin_memory) {
+  for (auto& element : batch) {
+    element = to_device(std::move(element), device, pin_memory);
+  }
+  return batch;
+}
+
+} // namespace detail
+
+/// Wraps a DataLoader and hands out device-resident batches.
+///
+/// A background thread drains the wrapped DataLoader, pins each batch and
+/// copies it to the target device, keeping up to `buffer_size` transferred
+/// batches ready for the consumer. When given a side stream, the copies
+/// overlap with compute on the consumer's stream; each hand-off then
+/// synchronizes the consumer's current stream with the copy through an
+/// event, so a batch is never visible before its transfer has finished.
+///
+/// Stream-ordering caveats (CUDA devices with a side stream): the
+/// prefetcher retains a reference to each handed-out batch for
+/// `buffer_size` further hand-offs and orders new transfers after the
+/// consumer's stream position at the previous hand-off. This makes the
+/// usual training loop -- enqueue all work on a batch before asking for
+/// the next one -- safe without further synchronization; consumers that
+/// hold batches across more iterations than that must synchronize
+/// themselves.
+///
+/// Like the DataLoader itself, an epoch started with `begin()` must be
+/// exhausted before `begin()` is called again. The wrapped DataLoader must
+/// outlive the prefetcher.
+///
+/// Example usage:
+/// \rst
+/// .. code-block:: cpp
+///
+///   auto data_loader = torch::data::make_data_loader(std::move(dataset));
+///   torch::data::DevicePrefetcher<decltype(*data_loader)> prefetcher(
+///       *data_loader, torch::kCUDA);
+///   for (auto& batch : prefetcher) {
+///     // batch is already on the GPU.
+///   }
+/// \endrst
+template <typename DataLoader>
+class DevicePrefetcher {
+ public:
+  /// `DataLoader` may be spelled as a reference type (e.g. through
+  /// `decltype(*data_loader)`), hence the `remove_reference`.
+  using LoaderType = typename std::remove_reference<DataLoader>::type;
+  using BatchType = typename LoaderType::BatchType;
+
+  DevicePrefetcher(
+      LoaderType& loader,
+      Device device,
+      DevicePrefetcherOptions options = DevicePrefetcherOptions())
+      : loader_(loader), device_(device), options_(std::move(options)) {
+    TORCH_CHECK(
+        options_.buffer_size() > 0,
+        "DevicePrefetcher buffer_size must be positive");
+    if (!device_.is_cpu()) {
+      c10::impl::VirtualGuardImpl impl(device_.type());
+      stream_ = options_.stream().value_or(impl.getStream(device_));
+      TORCH_CHECK(
+          stream_->device() == device_,
+          "DevicePrefetcher stream must belong to the target device, got ",
+          stream_->device(),
+          " and ",
+          device_);
+      // Events order the consumer's stream with the copy stream. They are
+      // only meaningful (and only supported) on devices with streams.
+      use_events_ =
+          device_.is_cuda() || device_.type() == DeviceType::HIP;
+    }
+  }
+
+  ~DevicePrefetcher() {
+    join();
+  }
+
+  DevicePrefetcher(const DevicePrefetcher&) = delete;
+  DevicePrefetcher& operator=(const DevicePrefetcher&) = delete;
+
+  /// Starts a new epoch over the wrapped DataLoader and returns an
+  /// iterator over device-resident batches.
+  Iterator<BatchType> begin() {
+    reset();
+    return Iterator<BatchType>(torch::make_unique<detail::ValidIterator<BatchType>>(
+        [this] { return this->next(); }));
+  }
+
+  /// Returns a sentinel iterator that compares equal to a non-sentinel
+  /// iterator once the prefetcher is exhausted.
+  Iterator<BatchType> end() {
+    return Iterator<BatchType>(
+        torch::make_unique<detail::SentinelIterator<BatchType>>());
+  }
+
+  /// Stops the background thread and discards buffered batches.
+  void join() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+    }
+    not_full_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+ private:
+  /// A transferred batch waiting for the consumer, together with the event
+  /// that marks completion of its copy.
+  struct BufferedBatch {
+    BufferedBatch() = default;
+    optional<BatchType> batch;
+    optional<c10::Event> ready;
+    std::exception_ptr exception;
+  };
+
+  void reset() {
+    join();
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer_.clear();
+    retained_.clear();
+    consumer_event_ = nullopt;
+    exhausted_ = false;
+    quit_ = false;
+    worker_ = std::thread([this] { this->worker_thread(); });
+  }
+
+  /// The background thread: drains the DataLoader and transfers batches.
+  void worker_thread() {
+    c10::OptionalDeviceGuard guard;
+    if (!device_.is_cpu()) {
+      guard.reset_device(device_);
+    }
+    try {
+      for (auto iterator = loader_.begin(); iterator != loader_.end();
+           ++iterator) {
+        BufferedBatch buffered;
+        buffered.batch = transfer(std::move(*iterator));
+        if (use_events_) {
+          buffered.ready = c10::Event(device_.type());
+          buffered.ready->record(*stream_);
+        }
+        if (!push(std::move(buffered))) {
+          return;
+        }
+      }
+    } catch (...) {
+      BufferedBatch buffered;
+      buffered.exception = std::current_exception();
+      if (!push(std::move(buffered))) {
+        return;
+      }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    exhausted_ = true;
+    not_empty_.notify_all();
+  }
+
+  /// Issues the device copy for one batch on the copy stream.
+  BatchType transfer(BatchType batch) {
+    if (device_.is_cpu()) {
+      return batch;
+    }
+    c10::impl::VirtualGuardImpl impl(device_.type());
+    const auto previous_stream = impl.exchangeStream(*stream_);
+    if (use_events_) {
+      // Order this transfer after the consumer's stream position at the
+      // last hand-off, so that allocator blocks freed by the consumer are
+      // not reused while its kernels may still read them.
+      optional<c10::Event> consumer_event;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        consumer_event = std::move(consumer_event_);
+        consumer_event_ = nullopt;
+      }
+      if (consumer_event) {
+        consumer_event->block(*stream_);
+      }
+    }
+    batch = detail::to_device(std::move(batch), device_, options_.pin_memory());
+    impl.exchangeStream(previous_stream);
+    return batch;
+  }
+
+  /// Adds a transferred batch to the buffer, blocking while the buffer is
+  /// full. Returns false if the prefetcher is shutting down.
+  bool push(BufferedBatch buffered) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] {
+      return quit_ || buffer_.size() < options_.buffer_size();
+    });
+    if (quit_) {
+      return false;
+    }
+    buffer_.push_back(std::move(buffered));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /// Hands the next device-resident batch to the consumer, or an empty
+  /// `optional` once the epoch is exhausted.
+  optional<BatchType> next() {
+    BufferedBatch buffered;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return exhausted_ || !buffer_.empty(); });
+      if (buffer_.empty()) {
+        lock.unlock();
+        join();
+        return nullopt;
+      }
+      buffered = std::move(buffer_.front());
+      buffer_.pop_front();
+    }
+    not_full_.notify_one();
+    if (buffered.exception) {
+      join();
+      std::rethrow_exception(buffered.exception);
+    }
+    if (use_events_) {
+      c10::impl::VirtualGuardImpl impl(device_.type());
+      const auto consumer_stream = impl.getStream(device_);
+      // The consumer may only see the batch after its copy has finished.
+      buffered.ready->block(consumer_stream);
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Keep the batch alive for a few more hand-offs and remember the
+      // consumer's stream position; see the class comment.
+      retained_.push_back(*buffered.batch);
+      while (retained_.size() > options_.buffer_size()) {
+        retained_.pop_front();
+      }
+      consumer_event_ = c10::Event(device_.type());
+      consumer_event_->record(consumer_stream);
+    }
+    return std::move(buffered.batch);
+  }
+
+  LoaderType& loader_;
+  const Device device_;
+  const DevicePrefetcherOptions options_;
+
+  /// The stream copies are issued on; unset for CPU targets.
+  optional<c10::Stream> stream_;
+  /// Whether the device supports the stream/event synchronization dance.
+  bool use_events_ = false;
+
+  /// Transferred batches ready for the consumer; guarded by `mutex_`, as
+  /// are all fields below.
+  std::deque<BufferedBatch> buffer_;
+  /// Recently handed-out batches, kept alive to delay allocator reuse.
+  std::deque<BatchType> retained_;
+  /// The consumer's stream position at the last hand-off.
+  optional<c10::Event> consumer_event_;
+  bool exhausted_ = false;
+  bool quit_ = false;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::thread worker_;
+};
+
+} // namespace data
+} // namespace torch
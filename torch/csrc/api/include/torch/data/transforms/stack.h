@@ -4,6 +4,8 @@
 #include <torch/data/transforms/collate.h>
 #include <torch/types.h>
 
+#include <ATen/Parallel.h>
+
 #include <utility>
 #include <vector>
 
@@ -44,6 +46,102 @@ struct Stack<TensorExample>
     return torch::stack(data);
   }
 };
+
+namespace detail {
+/// Returns `buffer` if it can hold a batch of `batch_size` examples shaped
+/// and typed like `first`, and otherwise allocates a suitable (optionally
+/// pinned) buffer.
+inline Tensor buffered_stack_buffer(
+    Tensor buffer,
+    const Tensor& first,
+    int64_t batch_size,
+    bool pin_memory) {
+  if (buffer.defined() && buffer.size(0) >= batch_size &&
+      buffer.sizes().slice(1) == first.sizes() &&
+      buffer.scalar_type() == first.scalar_type()) {
+    return buffer;
+  }
+  std::vector<int64_t> sizes;
+  sizes.reserve(1 + first.dim());
+  sizes.push_back(batch_size);
+  sizes.insert(sizes.end(), first.sizes().begin(), first.sizes().end());
+  auto options = first.options();
+  if (pin_memory && first.device().is_cpu()) {
+    options = options.pinned_memory(true);
+  }
+  return torch::empty(sizes, options);
+}
+} // namespace detail
+
+template <typename T = Example<>>
+struct BufferedStack;
+
+/// A `Collation` like `Stack`, but one that copies examples into a batch
+/// buffer that is reused across batches instead of allocating a fresh output
+/// tensor every time. The copies are performed in parallel across examples.
+/// Optionally the buffer is allocated in pinned memory, which makes the
+/// subsequent host-to-device copy of the batch asynchronous.
+///
+/// Because the buffer is reused, a returned batch is only valid until the
+/// next batch is collated; consume it (e.g. copy it to the device) before
+/// advancing the iterator. For the same reason a single instance must not be
+/// shared between concurrently collating worker threads.
+template <>
+struct BufferedStack<Example<>> : public Collation<Example<>> {
+  explicit BufferedStack(bool pin_memory = false) : pin_memory_(pin_memory) {}
+
+  Example<> apply_batch(std::vector<Example<>> examples) override {
+    TORCH_CHECK(!examples.empty(), "Cannot collate an empty batch");
+    const int64_t batch_size = examples.size();
+    data_buffer_ = detail::buffered_stack_buffer(
+        std::move(data_buffer_), examples.front().data, batch_size, pin_memory_);
+    target_buffer_ = detail::buffered_stack_buffer(
+        std::move(target_buffer_),
+        examples.front().target,
+        batch_size,
+        pin_memory_);
+    at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        data_buffer_[i].copy_(examples[i].data);
+        target_buffer_[i].copy_(examples[i].target);
+      }
+    });
+    // A final partial batch returns a view of the buffer's prefix.
+    return {data_buffer_.narrow(0, 0, batch_size),
+            target_buffer_.narrow(0, 0, batch_size)};
+  }
+
+ private:
+  bool pin_memory_;
+  Tensor data_buffer_;
+  Tensor target_buffer_;
+};
+
+/// A `Collation` like `Stack` for `Example<Tensor, NoTarget>` types that
+/// copies the data tensors into a reused (optionally pinned) batch buffer.
+/// See `BufferedStack<Example<>>` for the buffer lifetime caveats.
+template <>
+struct BufferedStack<TensorExample>
+    : public Collation<Example<Tensor, example::NoTarget>> {
+  explicit BufferedStack(bool pin_memory = false) : pin_memory_(pin_memory) {}
+
+  TensorExample apply_batch(std::vector<TensorExample> examples) override {
+    TORCH_CHECK(!examples.empty(), "Cannot collate an empty batch");
+    const int64_t batch_size = examples.size();
+    data_buffer_ = detail::buffered_stack_buffer(
+        std::move(data_buffer_), examples.front().data, batch_size, pin_memory_);
+    at::parallel_for(0, batch_size, 1, [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        data_buffer_[i].copy_(examples[i].data);
+      }
+    });
+    return data_buffer_.narrow(0, 0, batch_size);
+  }
+
+ private:
+  bool pin_memory_;
+  Tensor data_buffer_;
+};
 } // namespace transforms
 } // namespace data
 } // namespace torch
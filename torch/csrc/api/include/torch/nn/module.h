@@ -261,6 +261,29 @@ class TORCH_API Module : public std::enable_shared_from_this<Module> {
   /// Do not override this method, override `train()` instead.
   void eval();
 
+  /// Prepares the module for inference-only use.
+  ///
+  /// Calls `eval()` and then gives every submodule a chance to precompute
+  /// values its `forward()` would otherwise re-derive on every call (see
+  /// `freeze()`). In addition, inside `Sequential` containers, folds each
+  /// `BatchNorm{1,2,3}d` that directly follows a `Conv{1,2,3}d` into the
+  /// convolution's weight and bias, reducing the batchnorm to an identity.
+  ///
+  /// Calling `train()` afterwards drops the cached values, but the
+  /// conv/batchnorm folding is not undone — only freeze a module whose
+  /// learned state is final. Freeze again after moving the module with
+  /// `to()`, since cached values are not moved along with parameters.
+  void eval_freeze();
+
+  /// Called on every submodule by `eval_freeze()`.
+  ///
+  /// Modules whose `forward()` derives values that are constant in eval
+  /// mode (e.g. batchnorm's `1 / sqrt(running_var + eps)`) can override
+  /// this to compute them once; the default does nothing. This is about
+  /// caching derived inference state, not about `requires_grad`.
+  /// Overrides should make `train(true)` invalidate whatever they cache.
+  virtual void freeze();
+
   /// True if the module is in training mode.
   ///
   /// Every `Module` has a boolean associated with it that determines whether
@@ -92,6 +92,15 @@ class TORCH_API BatchNormImplBase : public torch::nn::Cloneable<Derived> {
 
   void reset() override;
 
+  /// Precomputes the per-channel scale and shift that `forward()` applies in
+  /// eval mode, so frozen inference performs a single multiply-add instead of
+  /// re-deriving `1 / sqrt(running_var + eps)` on every call. Called by
+  /// `Module::eval_freeze()`; a no-op unless `track_running_stats` is `true`.
+  void freeze() override;
+
+  /// Drops the cached scale and shift when re-entering training mode.
+  void train(bool on = true) override;
+
   /// Pretty prints the `BatchNorm{1,2,3}d` module into the given `stream`.
   void pretty_print(std::ostream& stream) const override;
 
@@ -117,6 +126,14 @@ class TORCH_API BatchNormImplBase : public torch::nn::Cloneable<Derived> {
   /// The number of the forward call.
   /// Only defined if the `track_running_stats` option was `true` upon construction.
   Tensor num_batches_tracked;
+
+  /// Cached `weight / sqrt(running_var + eps)`.
+  /// Only defined after `freeze()`; neither serialized nor moved by `to()`.
+  Tensor frozen_scale;
+
+  /// Cached `bias - running_mean * frozen_scale`.
+  /// Only defined after `freeze()`; neither serialized nor moved by `to()`.
+  Tensor frozen_shift;
 };
 
 /// Applies the BatchNorm1d function.
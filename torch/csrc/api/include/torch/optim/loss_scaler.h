@@ -0,0 +1,76 @@
+#pragma once
+
+#include <torch/optim/optimizer.h>
+#include <torch/types.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace torch {
+namespace optim {
+
+/// Dynamic loss scaling for mixed-precision training.
+///
+/// Half-precision gradients underflow for small loss values, so the loss
+/// is multiplied by a large scale before `backward()` and the gradients
+/// are divided by the same scale before the optimizer step. The scale
+/// adapts at runtime: it is halved whenever non-finite gradients show up
+/// (and that step is skipped), and grown again after a streak of
+/// `growth_interval` successful steps, so it settles just below the
+/// overflow threshold of the current model.
+///
+/// Typical use:
+/// \rst
+/// .. code-block:: cpp
+///
+///   torch::optim::LossScaler scaler;
+///   for (auto& batch : data_loader) {
+///     optimizer.zero_grad();
+///     auto loss = model->forward(batch.data).nll_loss(batch.target);
+///     scaler.scale(loss).backward();
+///     scaler.step(optimizer);
+///   }
+/// \endrst
+class TORCH_API LossScaler {
+ public:
+  explicit LossScaler(
+      double initial_scale = 65536.0,
+      double growth_factor = 2.0,
+      double backoff_factor = 0.5,
+      int64_t growth_interval = 2000);
+
+  /// Returns the loss multiplied by the current scale. Call `backward()`
+  /// on the result instead of on the raw loss.
+  Tensor scale(const Tensor& loss) const;
+
+  /// Divides the gradients of `parameters` by the current scale, in
+  /// place. Returns false if any gradient is non-finite, in which case
+  /// the optimizer step should be skipped.
+  bool unscale(std::vector<Tensor>& parameters);
+
+  /// Unscales the gradients of the optimizer's parameters, runs
+  /// `optimizer.step()` only if they are all finite, and updates the
+  /// scale. Returns true if the step was taken.
+  bool step(Optimizer& optimizer);
+
+  /// Adjusts the scale after an iteration: backoff when non-finite
+  /// gradients were found, growth after `growth_interval` clean
+  /// iterations. Called by `step()`; call it directly only when driving
+  /// `unscale()` and the optimizer step by hand.
+  void update(bool found_inf);
+
+  /// The current loss scale.
+  double current_scale() const noexcept;
+
+ private:
+  double scale_;
+  double growth_factor_;
+  double backoff_factor_;
+  int64_t growth_interval_;
+  /// Number of consecutive steps with finite gradients since the last
+  /// scale change.
+  int64_t growth_tracker_{0};
+};
+
+} // namespace optim
+} // namespace torch
@@ -4,6 +4,8 @@
 #include <torch/serialize/tensor.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
+#include <future>
+#include <string>
 #include <utility>
 
 namespace torch {
@@ -19,7 +21,9 @@ namespace torch {
 ///
 /// To perform the serialization, a `serialize::OutputArchive` is constructed,
 /// and all arguments after the `value` are forwarded to its `save_to` method.
-/// For example, you can pass a filename, or an `ostream`.
+/// For example, you can pass a filename, or an `ostream`, optionally followed
+/// by a zstd compression level (builds with `USE_ZSTD` only; the default of 0
+/// writes records uncompressed):
 ///
 /// \rst
 /// .. code-block:: cpp
@@ -35,6 +39,9 @@ namespace torch {
 ///
 ///   auto tensor = torch::ones({3, 4});
 ///   torch::save(tensor, "my_tensor.pt");
+///
+///   // Compress records with zstd at level 3.
+///   torch::save(model, "model.pt", /*compression_level=*/3);
 /// \endrst
 template <typename Value, typename... SaveToArgs>
 void save(const Value& value, SaveToArgs&&... args) {
@@ -73,6 +80,36 @@ void save(const std::vector<torch::Tensor>& tensor_vec, SaveToArgs&&... args) {
   archive.save_to(std::forward<SaveToArgs>(args)...);
 }
 
+/// Serializes the given `value` to a file at `filename` from a background
+/// thread.
+///
+/// The value's tensors are first snapshotted into host memory (device tensors
+/// are staged through pinned buffers), which is fast relative to writing the
+/// checkpoint; once this function returns, the tensors may be mutated again
+/// (e.g. training may resume) without affecting what is written. The
+/// returned future becomes ready when the file is fully written and rethrows
+/// any serialization error. Note that destroying the future waits for the
+/// write to finish.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   torch::nn::Linear model(3, 4);
+///   auto checkpoint = torch::save_async(model, "model.pt");
+///   // ... continue training ...
+///   checkpoint.get(); // surface any write error
+/// \endrst
+template <typename Value>
+std::future<void> save_async(
+    const Value& value,
+    std::string filename,
+    int compression_level = 0) {
+  serialize::OutputArchive archive(
+      std::make_shared<jit::script::CompilationUnit>());
+  archive << value;
+  return archive.save_to_async(std::move(filename), compression_level);
+}
+
 TORCH_API std::vector<char> pickle_save(const torch::IValue& ivalue);
 
 /// Deserializes the given `value`.
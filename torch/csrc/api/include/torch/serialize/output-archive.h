@@ -3,6 +3,7 @@
 #include <torch/csrc/WindowsTorchApiMacro.h>
 #include <torch/csrc/jit/script/module.h>
 
+#include <future>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -55,16 +56,31 @@ class TORCH_API OutputArchive final {
   void write(const std::string& key, OutputArchive& nested_archive);
 
   /// Saves the `OutputArchive` into a serialized representation in a file at
-  /// `filename`.
-  void save_to(const std::string& filename);
+  /// `filename`. A non-zero `compression_level` compresses the archive's
+  /// records with zstd at that level, which requires a build with zstd
+  /// support (USE_ZSTD).
+  void save_to(const std::string& filename, int compression_level = 0);
 
   /// Saves the `OutputArchive` into a serialized representation into the given
   /// `stream`.
-  void save_to(std::ostream& stream);
+  void save_to(std::ostream& stream, int compression_level = 0);
 
   /// Saves the `OutputArchive` into a serialized representation using the
   /// given writer function.
-  void save_to(const std::function<size_t(const void*, size_t)>& func);
+  void save_to(
+      const std::function<size_t(const void*, size_t)>& func,
+      int compression_level = 0);
+
+  /// Snapshots all of the archive's tensors into host memory (staging device
+  /// tensors through pinned buffers), then serializes and writes the archive
+  /// to a file at `filename` from a background thread. The call returns as
+  /// soon as the snapshot is taken, so the tensors may be mutated again
+  /// immediately; the returned future reports completion and rethrows any
+  /// serialization error. The archive must not be written to or saved again
+  /// after this call. Destroying the future waits for the write to finish.
+  std::future<void> save_to_async(
+      std::string filename,
+      int compression_level = 0);
 
   /// Forwards all arguments to `write()`.
   /// Useful for generic code that can be re-used for both `OutputArchive` and
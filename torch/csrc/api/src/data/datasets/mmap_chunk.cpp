@@ -0,0 +1,245 @@
+#include <torch/data/datasets/mmap_chunk.h>
+
+#include <torch/types.h>
+
+#include <ATen/Utils.h>
+#include <c10/core/ScalarType.h>
+#include <c10/util/Exception.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace data {
+namespace datasets {
+namespace {
+
+constexpr int64_t kMagic = 0x4b4e484343524f54; // "TORCCHNK"
+constexpr int64_t kVersion = 1;
+constexpr size_t kRecordAlignment = 64;
+
+size_t align_up(size_t size) {
+  return (size + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+}
+
+void write_int64(std::ofstream& stream, int64_t value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(int64_t));
+}
+
+/// Writes the raw bytes of a tensor followed by zero padding up to the
+/// record alignment.
+void write_padded(std::ofstream& stream, const Tensor& tensor) {
+  const auto nbytes = tensor.nbytes();
+  stream.write(static_cast<const char*>(tensor.data_ptr()), nbytes);
+  static const char padding[kRecordAlignment] = {0};
+  stream.write(padding, align_up(nbytes) - nbytes);
+}
+
+#ifndef _WIN32
+/// Owns one mmap-ed chunk file. Every tensor of the chunk holds a
+/// reference through its deleter, so the mapping outlives the last
+/// tensor that aliases it.
+struct ChunkMapping {
+  ChunkMapping(void* base, size_t size) : base(base), size(size) {}
+  ~ChunkMapping() {
+    munmap(base, size);
+  }
+  void* base;
+  size_t size;
+};
+
+int64_t read_int64(const char*& ptr) {
+  int64_t value;
+  std::memcpy(&value, ptr, sizeof(int64_t));
+  ptr += sizeof(int64_t);
+  return value;
+}
+
+std::vector<int64_t> read_sizes(const char*& ptr, const std::string& filename) {
+  const auto ndim = read_int64(ptr);
+  TORCH_CHECK(
+      ndim >= 0 && ndim <= 64,
+      "Corrupt chunk file ",
+      filename,
+      ": invalid number of dimensions ",
+      ndim);
+  std::vector<int64_t> sizes(ndim);
+  for (auto& size : sizes) {
+    size = read_int64(ptr);
+    TORCH_CHECK(
+        size >= 0, "Corrupt chunk file ", filename, ": negative dimension");
+  }
+  return sizes;
+}
+#endif
+
+} // namespace
+
+MmapChunkDataReader::MmapChunkDataReader(std::vector<std::string> chunk_files)
+    : chunk_files_(std::move(chunk_files)) {
+  TORCH_CHECK(
+      !chunk_files_.empty(),
+      "MmapChunkDataReader requires at least one chunk file");
+}
+
+size_t MmapChunkDataReader::chunk_count() {
+  return chunk_files_.size();
+}
+
+void MmapChunkDataReader::reset() {}
+
+MmapChunkDataReader::ChunkType MmapChunkDataReader::read_chunk(
+    size_t chunk_index) {
+#ifdef _WIN32
+  AT_ERROR("MmapChunkDataReader is not supported on Windows");
+#else
+  TORCH_CHECK(
+      chunk_index < chunk_files_.size(),
+      "Chunk index ",
+      chunk_index,
+      " is out of range; there are ",
+      chunk_files_.size(),
+      " chunk files");
+  const std::string& filename = chunk_files_[chunk_index];
+
+  const int fd = open(filename.c_str(), O_RDONLY);
+  TORCH_CHECK(
+      fd != -1, "Failed to open chunk file ", filename, ": ", strerror(errno));
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) == -1) {
+    close(fd);
+    AT_ERROR("Failed to stat chunk file ", filename, ": ", strerror(errno));
+  }
+  const size_t file_size = file_stat.st_size;
+  // A private mapping keeps reads page-cache-driven while making writes
+  // to the returned tensors copy-on-write instead of file corruption.
+  void* base =
+      mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  TORCH_CHECK(
+      base != MAP_FAILED,
+      "Failed to mmap chunk file ",
+      filename,
+      ": ",
+      strerror(errno));
+  auto mapping = std::make_shared<ChunkMapping>(base, file_size);
+
+  const char* begin = static_cast<const char*>(base);
+  const char* ptr = begin;
+  TORCH_CHECK(
+      file_size >= kRecordAlignment && read_int64(ptr) == kMagic,
+      filename,
+      " is not a chunk file");
+  const auto version = read_int64(ptr);
+  TORCH_CHECK(
+      version == kVersion,
+      "Chunk file ",
+      filename,
+      " has unsupported version ",
+      version);
+  const auto record_count = read_int64(ptr);
+  const auto data_type = static_cast<ScalarType>(read_int64(ptr));
+  const auto target_type = static_cast<ScalarType>(read_int64(ptr));
+  const auto data_sizes = read_sizes(ptr, filename);
+  const auto target_sizes = read_sizes(ptr, filename);
+
+  const auto data_options = TensorOptions().dtype(data_type);
+  const auto target_options = TensorOptions().dtype(target_type);
+  const size_t data_bytes =
+      align_up(c10::elementSize(data_type) * at::prod_intlist(data_sizes));
+  const size_t target_bytes =
+      align_up(c10::elementSize(target_type) * at::prod_intlist(target_sizes));
+
+  size_t offset = align_up(ptr - begin);
+  TORCH_CHECK(
+      record_count >= 0 &&
+          offset + record_count * (data_bytes + target_bytes) <= file_size,
+      "Corrupt chunk file ",
+      filename,
+      ": records exceed the file size");
+
+  ChunkType examples;
+  examples.reserve(record_count);
+  for (int64_t i = 0; i < record_count; ++i) {
+    auto data = torch::from_blob(
+        const_cast<char*>(begin) + offset,
+        data_sizes,
+        [mapping](void*) {},
+        data_options);
+    offset += data_bytes;
+    auto target = torch::from_blob(
+        const_cast<char*>(begin) + offset,
+        target_sizes,
+        [mapping](void*) {},
+        target_options);
+    offset += target_bytes;
+    examples.emplace_back(std::move(data), std::move(target));
+  }
+  return examples;
+#endif
+}
+
+void MmapChunkDataReader::write_chunk(
+    const std::string& filename,
+    const ChunkType& examples) {
+  TORCH_CHECK(!examples.empty(), "Cannot write an empty chunk");
+  const auto& first = examples.front();
+  for (const auto& example : examples) {
+    TORCH_CHECK(
+        example.data.defined() && example.target.defined(),
+        "Chunk examples must have defined data and target tensors");
+    TORCH_CHECK(
+        example.data.device().is_cpu() && example.target.device().is_cpu(),
+        "Chunk examples must be CPU tensors");
+    TORCH_CHECK(
+        example.data.sizes() == first.data.sizes() &&
+            example.target.sizes() == first.target.sizes() &&
+            example.data.scalar_type() == first.data.scalar_type() &&
+            example.target.scalar_type() == first.target.scalar_type(),
+        "All examples in a chunk must have the same dtypes and shapes");
+  }
+
+  std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+  TORCH_CHECK(stream, "Failed to open ", filename, " for writing");
+  write_int64(stream, kMagic);
+  write_int64(stream, kVersion);
+  write_int64(stream, (int64_t)examples.size());
+  write_int64(stream, (int64_t)first.data.scalar_type());
+  write_int64(stream, (int64_t)first.target.scalar_type());
+  write_int64(stream, first.data.dim());
+  for (auto size : first.data.sizes()) {
+    write_int64(stream, size);
+  }
+  write_int64(stream, first.target.dim());
+  for (auto size : first.target.sizes()) {
+    write_int64(stream, size);
+  }
+  // Pad the header to the record alignment.
+  const size_t header_size =
+      (7 + first.data.dim() + first.target.dim()) * sizeof(int64_t);
+  static const char padding[kRecordAlignment] = {0};
+  stream.write(padding, align_up(header_size) - header_size);
+
+  for (const auto& example : examples) {
+    write_padded(stream, example.data.contiguous());
+    write_padded(stream, example.target.contiguous());
+  }
+  TORCH_CHECK(stream, "Failed to write chunk file ", filename);
+}
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
@@ -1,6 +1,10 @@
 #include <torch/nn/module.h>
 
+#include <torch/nn/modules/batchnorm.h>
+#include <torch/nn/modules/container/sequential.h>
+#include <torch/nn/modules/conv.h>
 #include <torch/ordered_dict.h>
+#include <torch/utils.h>
 
 #include <torch/csrc/autograd/generated/VariableType.h>
 
@@ -41,6 +45,72 @@ void extend(
     vector.push_back(item.value());
   }
 }
+
+/// Folds `second` (a batchnorm) into `first` (the preceding convolution), so
+/// that at inference time the convolution alone already produces the
+/// batch-normalized result, and resets the batchnorm to an exact identity.
+/// Returns false without touching either module if the pair does not match.
+template <typename ConvType, typename BatchNormType>
+bool try_fold_conv_batchnorm(Module* first, Module* second) {
+  auto* conv = dynamic_cast<ConvType*>(first);
+  auto* batchnorm = dynamic_cast<BatchNormType*>(second);
+  if (conv == nullptr || batchnorm == nullptr) {
+    return false;
+  }
+  if (conv->options.transposed() ||
+      !batchnorm->options.track_running_stats() ||
+      !batchnorm->running_mean.defined() ||
+      batchnorm->options.num_features() != conv->options.out_channels()) {
+    return false;
+  }
+
+  NoGradGuard no_grad;
+  const double eps = batchnorm->options.eps();
+  Tensor scale = (batchnorm->running_var + eps).rsqrt();
+  if (batchnorm->weight.defined()) {
+    scale = scale * batchnorm->weight;
+  }
+  Tensor shift = -batchnorm->running_mean * scale;
+  if (batchnorm->bias.defined()) {
+    shift = shift + batchnorm->bias;
+  }
+
+  // The output channel is the leading dimension of a (non-transposed)
+  // convolution weight.
+  std::vector<int64_t> scale_shape(conv->weight.dim(), 1);
+  scale_shape[0] = -1;
+  conv->weight.mul_(scale.reshape(scale_shape));
+
+  // Reset the batchnorm so that it computes an identity: running_var is
+  // chosen such that sqrt(running_var + eps) == 1. When the convolution has
+  // no bias to absorb `shift`, the batchnorm keeps applying it through its
+  // running mean instead.
+  batchnorm->running_var.fill_(1.0 - eps);
+  if (batchnorm->weight.defined()) {
+    batchnorm->weight.fill_(1);
+    batchnorm->bias.zero_();
+  }
+  if (conv->bias.defined()) {
+    conv->bias.mul_(scale).add_(shift);
+    batchnorm->running_mean.zero_();
+  } else {
+    batchnorm->running_mean.copy_(-shift);
+  }
+  return true;
+}
+
+/// Folds every batchnorm that directly follows a matching convolution among
+/// the children of `sequential`.
+void fold_sequential_batchnorms(SequentialImpl& sequential) {
+  const auto modules = sequential.children();
+  for (size_t i = 0; i + 1 < modules.size(); ++i) {
+    Module* first = modules[i].get();
+    Module* second = modules[i + 1].get();
+    try_fold_conv_batchnorm<Conv1dImpl, BatchNorm1dImpl>(first, second) ||
+        try_fold_conv_batchnorm<Conv2dImpl, BatchNorm2dImpl>(first, second) ||
+        try_fold_conv_batchnorm<Conv3dImpl, BatchNorm3dImpl>(first, second);
+  }
+}
 } // namespace
 
 Module::Module()
@@ -241,6 +311,20 @@ void Module::eval() {
   train(/*on=*/false);
 }
 
+void Module::eval_freeze() {
+  eval();
+  // Fold batchnorms into preceding convolutions first, so that each module's
+  // freeze() caches its post-folding state.
+  apply([](Module& module) {
+    if (auto* sequential = dynamic_cast<SequentialImpl*>(&module)) {
+      fold_sequential_batchnorms(*sequential);
+    }
+  });
+  apply([](Module& module) { module.freeze(); });
+}
+
+void Module::freeze() {}
+
 void Module::to(torch::Device device, torch::Dtype dtype, bool non_blocking) {
   to_impl(device, dtype, non_blocking);
 }
@@ -4,6 +4,7 @@
 #include <torch/cuda.h>
 #include <torch/types.h>
 #include <torch/nn/init.h>
+#include <torch/utils.h>
 
 #include <c10/util/Exception.h>
 
@@ -119,6 +120,31 @@ void BatchNormImplBase<D, Derived>::reset() {
   }
 }
 
+template <size_t D, typename Derived>
+void BatchNormImplBase<D, Derived>::freeze() {
+  if (!options.track_running_stats()) {
+    return;
+  }
+  NoGradGuard no_grad;
+  frozen_scale = (running_var + options.eps()).rsqrt();
+  if (weight.defined()) {
+    frozen_scale = frozen_scale * weight;
+  }
+  frozen_shift = -running_mean * frozen_scale;
+  if (bias.defined()) {
+    frozen_shift = frozen_shift + bias;
+  }
+}
+
+template <size_t D, typename Derived>
+void BatchNormImplBase<D, Derived>::train(bool on) {
+  if (on) {
+    frozen_scale = Tensor();
+    frozen_shift = Tensor();
+  }
+  Module::train(on);
+}
+
 template <size_t D, typename Derived>
 void BatchNormImplBase<D, Derived>::pretty_print(std::ostream& stream) const {
   stream << std::boolalpha
@@ -134,6 +160,15 @@ template <size_t D, typename Derived>
 Tensor BatchNormImplBase<D, Derived>::forward(const Tensor& input) {
   _check_input_dim(input);
 
+  if (frozen_scale.defined() && !this->is_training()) {
+    // Frozen fast path: a single multiply-add with the cached per-channel
+    // scale and shift (see freeze()), broadcast over the channel dimension.
+    std::vector<int64_t> stats_shape(input.dim(), 1);
+    stats_shape[1] = -1;
+    return input * frozen_scale.reshape(stats_shape) +
+        frozen_shift.reshape(stats_shape);
+  }
+
   double exponential_average_factor;
   if (options.momentum() == c10::nullopt) {
     exponential_average_factor = 0.0;
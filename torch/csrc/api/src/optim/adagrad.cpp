@@ -5,6 +5,7 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizerStep.h>
 
 #include <functional>
 
@@ -23,6 +24,41 @@ void Adagrad::step() {
       continue;
     }
 
+    // Sparse (embedding) gradients go through the fused sparse-adagrad
+    // kernel: one parallel pass over the touched rows instead of
+    // coalesce + indexed state reads + scattered writes.  The fused step
+    // consumes the gradient's indices/values directly, duplicates and all.
+    if (p.grad().is_sparse()) {
+      TORCH_CHECK(
+          options.weight_decay() == 0,
+          "Adagrad does not support weight_decay with sparse gradients");
+      buffer_at(step_buffers, i) += 1.0;
+      const auto clr = options.learning_rate() /
+          (1.0 + (buffer_at(step_buffers, i) - 1.0) * options.lr_decay());
+      auto& sum = buffer_at(sum_buffers, i);
+
+      NoGradGuard guard;
+      const Tensor grad = p.grad();
+      TORCH_CHECK(
+          p.dim() == 2 && grad.sparse_dim() == 1 && grad.dense_dim() == 1,
+          "Adagrad only supports sparse gradients for 2-d (embedding) "
+          "parameters");
+      Tensor param = p;
+      if (!param.is_contiguous()) {
+        param = param.contiguous();
+      }
+      at::native::fused_sparse_adagrad_step(
+          param,
+          sum,
+          grad._indices().select(0, 0),
+          grad._values().contiguous(),
+          {clr, 1e-10});
+      if (!p.is_contiguous()) {
+        p.copy_(param);
+      }
+      continue;
+    }
+
     if (options.weight_decay() > 0) {
       NoGradGuard guard;
       p.grad() = p.grad() + options.weight_decay() * p;
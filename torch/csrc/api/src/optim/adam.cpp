@@ -6,6 +6,7 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizerStep.h>
 
 #include <cmath>
 #include <functional>
@@ -16,12 +17,47 @@ AdamOptions::AdamOptions(double learning_rate)
     : learning_rate_(learning_rate) {}
 
 void Adam::step() {
+  // Parameters whose tensors qualify (dense, contiguous, supported floating
+  // point type) are batched into one fused multi-tensor update per
+  // (device, dtype, step count) group -- the step count matters because it
+  // determines the bias corrections.  Everything else takes the original
+  // per-parameter path below.  NB: unlike that path, the fused step does
+  // not write the weight-decayed gradient back into p.grad().
+  std::vector<std::vector<size_t>> fused_groups;
+  auto fused_group_for = [&](const Tensor& p, int64_t step) -> std::vector<size_t>& {
+    for (auto& group : fused_groups) {
+      const size_t j = group.front();
+      const Tensor& ref = parameters_.at(j);
+      if (ref.device() == p.device() && ref.scalar_type() == p.scalar_type() &&
+          step_buffers.at(j) == step) {
+        return group;
+      }
+    }
+    fused_groups.emplace_back();
+    return fused_groups.back();
+  };
+
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
     if (!p.grad().defined()) {
       continue;
     }
 
+    bool fusable = at::native::can_use_fused_step(p) &&
+        at::native::can_use_fused_step(p.grad()) &&
+        p.grad().numel() == p.numel() &&
+        at::native::can_use_fused_step(buffer_at(exp_average_buffers, i)) &&
+        at::native::can_use_fused_step(buffer_at(exp_average_sq_buffers, i));
+    if (fusable && options.amsgrad()) {
+      fusable =
+          at::native::can_use_fused_step(buffer_at(max_exp_average_sq_buffers, i));
+    }
+    if (fusable) {
+      buffer_at(step_buffers, i) += 1;
+      fused_group_for(p, step_buffers.at(i)).push_back(i);
+      continue;
+    }
+
     if (options.weight_decay() > 0) {
       NoGradGuard guard;
       p.grad() = p.grad() + options.weight_decay() * p;
@@ -55,6 +91,34 @@ void Adam::step() {
     NoGradGuard guard;
     p.addcdiv_(exp_average, denom.sqrt() + options.eps(), -step_size);
   }
+
+  for (const auto& group : fused_groups) {
+    std::vector<Tensor> params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs;
+    params.reserve(group.size());
+    grads.reserve(group.size());
+    for (size_t i : group) {
+      params.push_back(parameters_.at(i));
+      grads.push_back(parameters_.at(i).grad());
+      exp_avgs.push_back(exp_average_buffers.at(i));
+      exp_avg_sqs.push_back(exp_average_sq_buffers.at(i));
+      if (options.amsgrad()) {
+        max_exp_avg_sqs.push_back(max_exp_average_sq_buffers.at(i));
+      }
+    }
+    const auto step = step_buffers.at(group.front());
+    const at::native::FusedAdamParams args = {
+        options.learning_rate(),
+        options.beta1(),
+        options.beta2(),
+        options.weight_decay(),
+        options.eps(),
+        1 - std::pow(options.beta1(), step),
+        1 - std::pow(options.beta2(), step),
+        options.amsgrad()};
+    NoGradGuard guard;
+    at::native::fused_adam_step(
+        params, grads, exp_avgs, exp_avg_sqs, max_exp_avg_sqs, args);
+  }
 }
 
 void Adam::save(serialize::OutputArchive& archive) const {
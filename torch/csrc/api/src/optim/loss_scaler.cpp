@@ -0,0 +1,77 @@
+#include <torch/optim/loss_scaler.h>
+
+#include <torch/types.h>
+#include <torch/utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace torch {
+namespace optim {
+
+LossScaler::LossScaler(
+    double initial_scale,
+    double growth_factor,
+    double backoff_factor,
+    int64_t growth_interval)
+    : scale_(initial_scale),
+      growth_factor_(growth_factor),
+      backoff_factor_(backoff_factor),
+      growth_interval_(growth_interval) {
+  TORCH_CHECK(initial_scale > 0, "initial_scale must be positive");
+  TORCH_CHECK(growth_factor > 1, "growth_factor must be greater than 1");
+  TORCH_CHECK(
+      backoff_factor > 0 && backoff_factor < 1,
+      "backoff_factor must be in (0, 1)");
+  TORCH_CHECK(growth_interval > 0, "growth_interval must be positive");
+}
+
+Tensor LossScaler::scale(const Tensor& loss) const {
+  return loss * scale_;
+}
+
+bool LossScaler::unscale(std::vector<Tensor>& parameters) {
+  NoGradGuard guard;
+  const double inv_scale = 1.0 / scale_;
+  bool finite = true;
+  for (auto& parameter : parameters) {
+    if (!parameter.grad().defined()) {
+      continue;
+    }
+    auto grad = parameter.grad();
+    grad.mul_(inv_scale);
+    // A sum of absolute values is finite iff every element is: NaN
+    // propagates and +/-inf saturates. One reduction per parameter is
+    // cheap next to the backward pass that produced the gradient.
+    if (!std::isfinite(grad.abs().sum().item<double>())) {
+      finite = false;
+    }
+  }
+  return finite;
+}
+
+bool LossScaler::step(Optimizer& optimizer) {
+  const bool finite = unscale(optimizer.parameters());
+  if (finite) {
+    optimizer.step();
+  }
+  update(/*found_inf=*/!finite);
+  return finite;
+}
+
+void LossScaler::update(bool found_inf) {
+  if (found_inf) {
+    scale_ = std::max(scale_ * backoff_factor_, 1.0);
+    growth_tracker_ = 0;
+  } else if (++growth_tracker_ >= growth_interval_) {
+    scale_ *= growth_factor_;
+    growth_tracker_ = 0;
+  }
+}
+
+double LossScaler::current_scale() const noexcept {
+  return scale_;
+}
+
+} // namespace optim
+} // namespace torch
@@ -8,6 +8,7 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizerStep.h>
 
 #include <functional>
 
@@ -16,6 +17,23 @@ namespace optim {
 SGDOptions::SGDOptions(double learning_rate) : learning_rate_(learning_rate) {}
 
 void SGD::step() {
+  // Parameters whose tensors qualify (dense, contiguous, supported floating
+  // point type) are batched into one fused multi-tensor update per
+  // (device, dtype) group, so the whole step costs a handful of kernel
+  // launches instead of several per parameter.  Everything else takes the
+  // original per-parameter path below.
+  std::vector<std::vector<size_t>> fused_groups;
+  auto fused_group_for = [&](const Tensor& p) -> std::vector<size_t>& {
+    for (auto& group : fused_groups) {
+      const Tensor& ref = parameters_.at(group.front());
+      if (ref.device() == p.device() && ref.scalar_type() == p.scalar_type()) {
+        return group;
+      }
+    }
+    fused_groups.emplace_back();
+    return fused_groups.back();
+  };
+
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
 
@@ -23,6 +41,17 @@ void SGD::step() {
       continue;
     }
 
+    bool fusable = at::native::can_use_fused_step(p) &&
+        at::native::can_use_fused_step(p.grad()) &&
+        p.grad().numel() == p.numel();
+    if (fusable && options.momentum() != 0) {
+      fusable = at::native::can_use_fused_step(buffer_at(momentum_buffers, i));
+    }
+    if (fusable) {
+      fused_group_for(p).push_back(i);
+      continue;
+    }
+
     auto update = p.grad();
 
     if (options.weight_decay() > 0) {
@@ -46,6 +75,29 @@ void SGD::step() {
     NoGradGuard guard;
     p.add_(-options.learning_rate() * update);
   }
+
+  for (const auto& group : fused_groups) {
+    std::vector<Tensor> params, grads, buffers;
+    params.reserve(group.size());
+    grads.reserve(group.size());
+    for (size_t i : group) {
+      params.push_back(parameters_.at(i));
+      grads.push_back(parameters_.at(i).grad());
+      if (options.momentum() != 0) {
+        buffers.push_back(momentum_buffers.at(i));
+      }
+    }
+    const at::native::FusedSGDParams args = {
+        options.learning_rate(),
+        options.momentum(),
+        options.dampening(),
+        options.weight_decay(),
+        options.nesterov(),
+        iteration_ == 0};
+    NoGradGuard guard;
+    at::native::fused_sgd_step(params, grads, buffers, args);
+  }
+
   iteration_ += 1;
 }
 
@@ -8,12 +8,43 @@
 
 #include <c10/util/Exception.h>
 
+#include <future>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 
 namespace torch {
 namespace serialize {
+namespace {
+
+Tensor snapshot_tensor(const Tensor& tensor) {
+  if (!tensor.defined() || tensor.device().is_cpu()) {
+    return tensor.defined() ? tensor.clone() : tensor;
+  }
+  // Stage device tensors through pinned host memory so the device-to-host
+  // copy runs at full DMA bandwidth.
+  auto staging = torch::empty(
+      tensor.sizes(), tensor.options().device(torch::kCPU).pinned_memory(true));
+  staging.copy_(tensor);
+  return staging;
+}
+
+// Replaces every tensor attribute in the module hierarchy with a host-side
+// copy, so the caller can keep mutating the originals while a background
+// thread serializes the snapshot.
+void snapshot_tensors(jit::script::Module& module) {
+  for (jit::script::Module child : module.modules()) {
+    for (const jit::script::NameValue& attribute :
+         child.named_attributes(/*recurse=*/false)) {
+      if (attribute.value.isTensor()) {
+        child.setattr(attribute.name, snapshot_tensor(attribute.value.toTensor()));
+      }
+    }
+  }
+}
+
+} // namespace
 OutputArchive::OutputArchive(std::shared_ptr<jit::script::CompilationUnit> cu)
     : cu_(std::move(cu)),
       module_("__torch__.Module", cu_, /*shouldMangle=*/true) {}
@@ -35,17 +66,52 @@ void OutputArchive::write(
   module_.register_module(key, nested_archive.module_);
 }
 
-void OutputArchive::save_to(const std::string& filename) {
-  jit::ExportModule(module_, filename);
+void OutputArchive::save_to(const std::string& filename, int compression_level) {
+  jit::ExportModule(
+      module_,
+      filename,
+      jit::script::ExtraFilesMap(),
+      /*bytecode_format=*/false,
+      compression_level);
+}
+
+void OutputArchive::save_to(std::ostream& stream, int compression_level) {
+  jit::ExportModule(
+      module_,
+      stream,
+      jit::script::ExtraFilesMap(),
+      /*bytecode_format=*/false,
+      compression_level);
 }
 
-void OutputArchive::save_to(std::ostream& stream) {
-  jit::ExportModule(module_, stream);
+std::future<void> OutputArchive::save_to_async(
+    std::string filename,
+    int compression_level) {
+  snapshot_tensors(module_);
+  // A class type only weakly references its compilation unit, so the
+  // background thread keeps the archive's one alive itself.
+  auto cu = cu_;
+  auto module = module_;
+  return std::async(
+      std::launch::async, [cu, module, filename, compression_level] {
+        jit::ExportModule(
+            module,
+            filename,
+            jit::script::ExtraFilesMap(),
+            /*bytecode_format=*/false,
+            compression_level);
+      });
 }
 
 void OutputArchive::save_to(
-    const std::function<size_t(const void*, size_t)>& func) {
-  jit::ExportModule(module_, func);
+    const std::function<size_t(const void*, size_t)>& func,
+    int compression_level) {
+  jit::ExportModule(
+      module_,
+      func,
+      jit::script::ExtraFilesMap(),
+      /*bytecode_format=*/false,
+      compression_level);
 }
 } // namespace serialize
 } // namespace torch
@@ -47,6 +47,20 @@ inline void check_inplace(const Tensor& tensor) {
   }
 }
 
+// Write fence for copy-on-write storages (see
+// StorageImpl::share_copy_on_write). Every mutating op calls this on the
+// tensors it is about to write through, so lazily cloned storages get a
+// private allocation before the kernel touches the shared bytes. Writes
+// that bypass the dispatcher (raw data_ptr() access) are not fenced.
+inline void materialize_for_write(const Tensor& tensor) {
+  if (tensor.defined() && tensor.has_storage()) {
+    tensor.unsafeGetTensorImpl()
+        ->storage()
+        .unsafeGetStorageImpl()
+        ->maybe_materialize_copy_on_write();
+  }
+}
+
 inline void throw_error_out_requires_grad(const char* name) {
   AT_ERROR(
       name, "(): functions with out=... arguments don't support automatic differentiation, "
@@ -77,6 +91,11 @@ inline void rebase_history(std::vector<Variable>&& vars, std::shared_ptr<Node> g
 }
 
 inline void increment_version(Tensor & t) {
+  // In inference mode nothing is saved for backward, so the version counter
+  // has no observers; skip the bump entirely.
+  if (InferenceMode::is_enabled()) {
+    return;
+  }
   as_variable_ref(t).bump_version();
 }
 
@@ -102,6 +121,11 @@ inline Tensor as_view(const Tensor & base, Tensor tensor, bool is_differentiable
   if (base_var.is_view()) {
     base_var = base_var.base();
   }
+  // Inference mode never tracks the view's history; take the cheap
+  // non-differentiable path (shared version counter, no DifferentiableViewMeta).
+  if (InferenceMode::is_enabled()) {
+    is_differentiable = false;
+  }
   return make_variable_view(std::move(base_var), std::move(tensor), is_differentiable);
 }
 
@@ -112,6 +136,9 @@ inline std::vector<Tensor> as_view(const Tensor & base, std::vector<Tensor> tens
   if (base_var.is_view()) {
     base_var = base_var.base();
   }
+  if (InferenceMode::is_enabled()) {
+    is_differentiable = false;
+  }
   for(Tensor &tensor : tensors) {
     tensor = make_variable_view(base_var, std::move(tensor), is_differentiable);
   }
@@ -1,5 +1,9 @@
+#include <torch/csrc/autograd/autograd.h>
 #include <torch/csrc/autograd/custom_function.h>
 #include <torch/csrc/autograd/functions/accumulate_grad.h>
+#include <torch/csrc/autograd/grad_mode.h>
+
+#include <ATen/CPUGenerator.h>
 
 namespace torch { namespace autograd {
 
@@ -182,4 +186,160 @@ const std::unordered_set<at::TensorImpl*>& AutogradContext::get_dirty() const {
 const std::unordered_set<at::TensorImpl*>& AutogradContext::get_non_differentiable() const {
   return non_differentiable_;
 }
+
+namespace {
+
+// Installs the state of `src` on the default CPU generator and returns the
+// state it replaced. CPUGenerator has no set_state, so the state is moved
+// field by field under the generator's mutex.
+std::shared_ptr<at::CPUGenerator> swap_default_cpu_rng_state(
+    const std::shared_ptr<at::CPUGenerator>& src) {
+  auto gen = at::detail::getDefaultCPUGenerator();
+  std::lock_guard<std::mutex> lock(gen->mutex_);
+  auto previous = gen->clone();
+  gen->set_engine(src->engine());
+  gen->set_next_float_normal_sample(src->next_float_normal_sample());
+  gen->set_next_double_normal_sample(src->next_double_normal_sample());
+  return previous;
+}
+
+// Backward node created by checkpoint(). Instead of the segment's
+// intermediate activations it holds the detached inputs, the callable and the
+// CPU RNG state; apply() replays the forward with grad enabled and
+// differentiates through the recomputed graph.
+struct CheckpointBackward : public Node {
+  variable_list apply(variable_list&& grads) override;
+  void release_variables() override;
+
+  checkpoint_function_t function_;
+  std::vector<SavedVariable> saved_inputs_;
+  std::vector<bool> input_requires_grad_;
+  std::shared_ptr<at::CPUGenerator> rng_state_;
+  bool has_freed_buffers_ = false;
+};
+
+void CheckpointBackward::release_variables() {
+  saved_inputs_.clear();
+  has_freed_buffers_ = true;
+}
+
+variable_list CheckpointBackward::apply(variable_list&& grads) {
+  TORCH_CHECK(!has_freed_buffers_, ERR_BACKWARD_TWICE);
+
+  // Rebuild fresh leaves from the stashed inputs so every replay records its
+  // own graph (backward with retain_graph may run this more than once).
+  variable_list recomputed_inputs;
+  recomputed_inputs.reserve(saved_inputs_.size());
+  for (size_t i = 0; i < saved_inputs_.size(); ++i) {
+    auto var = saved_inputs_[i].unpack();
+    if (var.defined() && input_requires_grad_[i]) {
+      var = var.detach().requires_grad_(true);
+    }
+    recomputed_inputs.push_back(var);
+  }
+
+  // Replay under the RNG state stashed in forward; restore the ambient state
+  // afterwards so the replay is invisible to the rest of the program.
+  auto outer_rng_state = swap_default_cpu_rng_state(rng_state_);
+  variable_list outputs;
+  {
+    AutoGradMode grad_mode(true);
+    outputs = function_(recomputed_inputs);
+  }
+  swap_default_cpu_rng_state(outer_rng_state);
+
+  TORCH_CHECK(
+      outputs.size() == grads.size(),
+      "checkpoint: function returned ", outputs.size(),
+      " outputs on recomputation, but ", grads.size(), " during forward");
+
+  variable_list diff_outputs;
+  variable_list grad_outputs;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].defined() && outputs[i].requires_grad() &&
+        grads[i].defined()) {
+      diff_outputs.push_back(outputs[i]);
+      grad_outputs.push_back(grads[i]);
+    }
+  }
+  TORCH_CHECK(
+      !diff_outputs.empty(),
+      "checkpoint: none of the recomputed outputs requires grad; "
+      "checkpointing this function is unnecessary");
+
+  variable_list diff_inputs;
+  std::vector<size_t> diff_input_positions;
+  for (size_t i = 0; i < recomputed_inputs.size(); ++i) {
+    if (recomputed_inputs[i].defined() && input_requires_grad_[i]) {
+      diff_inputs.push_back(recomputed_inputs[i]);
+      diff_input_positions.push_back(i);
+    }
+  }
+  auto input_grads = grad(
+      diff_outputs,
+      diff_inputs,
+      grad_outputs,
+      /*retain_graph=*/false,
+      /*create_graph=*/false,
+      /*allow_unused=*/true);
+
+  variable_list results(saved_inputs_.size());
+  for (size_t i = 0; i < input_grads.size(); ++i) {
+    results[diff_input_positions[i]] = std::move(input_grads[i]);
+  }
+  return results;
+}
+
+} // namespace
+
+variable_list checkpoint(checkpoint_function_t function, variable_list inputs) {
+  TORCH_CHECK(function, "checkpoint expects a callable");
+
+  const bool is_executable =
+      GradMode::is_enabled() && any_variable_requires_grad(inputs);
+
+  std::shared_ptr<CheckpointBackward> node;
+  if (is_executable) {
+    node = std::shared_ptr<CheckpointBackward>(
+        new CheckpointBackward(), deleteNode);
+    node->function_ = function;
+    node->input_requires_grad_.reserve(inputs.size());
+    for (const auto& var : inputs) {
+      node->input_requires_grad_.push_back(
+          var.defined() && var.requires_grad());
+    }
+    node->set_next_edges(collect_next_edges(inputs));
+    // Stash the RNG state before the first run so backward can replay it
+    auto gen = at::detail::getDefaultCPUGenerator();
+    std::lock_guard<std::mutex> lock(gen->mutex_);
+    node->rng_state_ = gen->clone();
+  }
+
+  variable_list outputs;
+  {
+    AutoGradMode grad_mode(false);
+    outputs = function(inputs);
+  }
+
+  if (!is_executable) {
+    return outputs;
+  }
+
+  node->saved_inputs_.reserve(inputs.size());
+  for (const auto& var : inputs) {
+    if (var.defined()) {
+      node->saved_inputs_.emplace_back(var.detach(), /*is_output=*/false);
+    } else {
+      node->saved_inputs_.emplace_back();
+    }
+  }
+
+  return _wrap_outputs(
+      inputs,
+      /*non_differentiable=*/{},
+      /*dirty_inputs=*/{},
+      outputs,
+      node);
+}
+
 }} // namespace torch::autograd
@@ -4,6 +4,7 @@
 #include <torch/csrc/autograd/variable.h>
 #include <ATen/core/ivalue.h>
 #include <c10/util/flat_hash_map.h>
+#include <functional>
 #include <vector>
 
 namespace torch { namespace autograd {
@@ -309,4 +310,23 @@ void CppNode<T>::set_ctx_grad_fn(const std::shared_ptr<Node> &node) {
   ctx_.grad_fn_ = node;
 }
 
+// The recomputable callable passed to checkpoint(). Apart from consuming RNG
+// it must be free of side effects: backward calls it a second time with the
+// same inputs and RNG state and expects structurally identical outputs.
+using checkpoint_function_t = std::function<variable_list(const variable_list&)>;
+
+// Runs `function` on `inputs` without recording an autograd graph for its
+// intermediates, the C++ counterpart of `torch.utils.checkpoint`. Only the
+// detached inputs and the CPU RNG state are kept alive; backward replays
+// `function` with grad enabled to rebuild the segment's graph and then
+// differentiates through it, trading one extra forward pass for not storing
+// the segment's activations.
+//
+// Limitations: the CUDA RNG state is not snapshotted, double backward through
+// a checkpointed segment is not supported, and `function` must not modify its
+// inputs in place.
+TORCH_API variable_list checkpoint(
+    checkpoint_function_t function,
+    variable_list inputs);
+
 }} // namespace torch::autograd
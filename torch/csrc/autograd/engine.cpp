@@ -20,6 +20,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -47,11 +48,30 @@ static thread_local int worker_device = NO_DEVICE;
 static thread_local bool checkpoint_valid = true;
 
 // XXX: Changes to the way multithreading works in execute should be done with
-// great care. Right now the implementation guarantees that a single function's
+// great care. The implementation guarantees that a single function's
 // apply will never be entered concurrently (even if multiple graphs are
-// executed at the same time). Adding multiple threads per-device or removing
-// engine thread affinity to the device can break this invariant, and we depend
-// on it in a few places (e.g. AccumulateGrad function).
+// executed at the same time); we depend on it in a few places (e.g.
+// AccumulateGrad function). With a single worker thread per device the
+// guarantee was structural; now that the CPU queue may be drained by
+// several workers (see num_cpu_backward_threads below) it is upheld by
+// holding the Node's mutex while executing it.
+
+// Number of worker threads draining the CPU ready queue. Independent ready
+// nodes (parallel branches, mixture-of-experts style graphs) then execute
+// concurrently instead of serializing on one core. Defaults to 1, the
+// historical behavior; set PYTORCH_BACKWARD_CPU_THREADS to raise it.
+static int num_cpu_backward_threads() {
+  static const int count = [] {
+    if (const char* env = std::getenv("PYTORCH_BACKWARD_CPU_THREADS")) {
+      const auto parsed = std::atol(env);
+      if (parsed > 0) {
+        return static_cast<int>(parsed);
+      }
+    }
+    return 1;
+  }();
+  return count;
+}
 
 // Number of nested reentrant backwards calls currently on this thread
 static thread_local int current_depth = 0;
@@ -90,6 +110,14 @@ struct ReadyQueue {
   void push(NodeTask item, bool incrementOutstandingTasks = true);
   void pushShutdownTask();
   NodeTask pop();
+  // Like pop(), but also returns (with `false`) when `graph_task` completes,
+  // so a thread waiting for a reentrant graph task does not stay blocked
+  // after another worker finished the task's last node. Used together with
+  // notifyAll().
+  bool popOrDone(NodeTask& task, GraphTask& graph_task);
+  // Wakes every thread blocked on the queue without enqueuing work, so
+  // popOrDone() waiters re-check their completion predicate
+  void notifyAll();
 };
 
 // Note [Reentrant backwards]
@@ -188,6 +216,29 @@ auto ReadyQueue::pop() -> NodeTask {
   return task;
 }
 
+bool graph_task_completed(const GraphTask& graph_task);
+
+auto ReadyQueue::popOrDone(NodeTask& task, GraphTask& graph_task) -> bool {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_empty_.wait(lock, [this, &graph_task] {
+    return !heap_.empty() || graph_task_completed(graph_task);
+  });
+  if (heap_.empty()) {
+    return false;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  task = std::move(const_cast<NodeTask&>(heap_.top()));
+  heap_.pop();
+  return true;
+}
+
+auto ReadyQueue::notifyAll() -> void {
+  // Taking the mutex orders the wakeup after the state change the waiters
+  // re-check (the notifier updated it before calling us)
+  std::lock_guard<std::mutex> lock(mutex_);
+  not_empty_.notify_all();
+}
+
 // This limit is based on the default python recursion limit which is 1000
 Engine::Engine() : max_recursion_depth_(100) {}
 
@@ -204,6 +255,12 @@ Engine::~Engine() {
     for (auto& queue : ready_queues_) {
      queue->pushShutdownTask();
     }
+    // every extra CPU worker beyond the first needs its own shutdown task
+    if (!ready_queues_.empty()) {
+      for (int i = 1; i < num_cpu_backward_threads(); ++i) {
+        ready_queues_[0]->pushShutdownTask();
+      }
+    }
   }
   // Othewise threads are leaked
 }
@@ -277,7 +334,17 @@ auto Engine::thread_main(
   // Why the test on graph_task->outstanding_tasks_?  See
   // Note [Reentrant backwards]
   while (!reentrant_thread || graph_task->outstanding_tasks_ > 0) {
-    NodeTask task = queue->pop();
+    NodeTask task({}, nullptr, InputBuffer(0));
+    if (reentrant_thread) {
+      // With several workers on this queue, the task that completes our
+      // graph task may be run by another thread, so a plain pop() could
+      // block forever; popOrDone also wakes on completion.
+      if (!queue->popOrDone(task, *graph_task)) {
+        continue; // completed; the loop condition exits for us
+      }
+    } else {
+      task = queue->pop();
+    }
     // This will only work if the worker is running a non backward task
     // TODO Needs to be fixed this to work in all cases
     if (task.isShutdownTask_) {
@@ -318,21 +385,17 @@ auto Engine::thread_main(
         local_graph_task->not_done_.notify_all();
       }
     } else {
-      // If it's a task initiated from this thread, decrease the counter, but
-      // don't do anything - loop condition will do all checks for us next.
-      if (base_owner == worker_device) {
-        --local_graph_task->outstanding_tasks_;
-        // Otherwise send a dummy function task to the owning thread just to
-        // ensure that it's not sleeping. If it has work, it might see that
-        // graph_task->outstanding_tasks_ == 0 before it gets to the task, but
-        // it's a no-op anyway.
-      } else if (base_owner != worker_device) {
-        if (--local_graph_task->outstanding_tasks_ == 0) {
-          // Synchronize outstanding_tasks_ with queue mutex
-          std::atomic_thread_fence(std::memory_order_release);
-          ready_queue_by_index(base_owner)
-              .push(NodeTask(local_graph_task, nullptr, InputBuffer(0)));
+      // The owner is a worker thread waiting for this graph task: either
+      // blocked on its device's ready queue (see popOrDone, which also
+      // covers owners sharing our worker_device once several workers drain
+      // the CPU queue) or on not_done_ after being handed to the reentrant
+      // thread pool. Wake both so they re-check completion.
+      if (--local_graph_task->outstanding_tasks_ == 0) {
+        {
+          std::lock_guard<std::mutex> lock(local_graph_task->mutex_);
+          local_graph_task->not_done_.notify_all();
         }
+        ready_queue_by_index(base_owner).notifyAll();
       }
     }
   }
@@ -554,12 +617,20 @@ void Engine::evaluate_function(
   const auto opt_parent_stream = (*func).stream(c10::DeviceType::CUDA);
   c10::OptionalStreamGuard parent_stream_guard{opt_parent_stream};
 
-  auto outputs = call_function(graph_task, func, inputs);
+  variable_list outputs;
+  {
+    // Concurrent graph tasks may share Nodes (AccumulateGrad in
+    // particular); holding the Node's mutex across apply and the release of
+    // its saved variables keeps the single-entry guarantee that a lone
+    // worker per device used to provide structurally. See Node::mutex().
+    std::lock_guard<std::mutex> node_lock(func->mutex());
+    outputs = call_function(graph_task, func, inputs);
+    if (!graph_task->keep_graph_) {
+      func->release_variables();
+    }
+  }
 
   auto& fn = *func;
-  if (!graph_task->keep_graph_) {
-    fn.release_variables();
-  }
 
   int num_outputs = outputs.size();
   if (num_outputs == 0) { // Note: doesn't acquire the mutex
@@ -673,6 +744,60 @@ auto Engine::compute_dependencies(Node* root, GraphTask& task) -> void {
   }
 }
 
+// Note [Backward plan cache]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Training loops that retain their graph (or reuse a statically built one)
+// run compute_dependencies over an identical graph on every backward() call.
+// The dependency counts are fully determined by the set of root nodes: a
+// graph owns its interior through next_edges and its structure is fixed once
+// constructed, so as long as the same roots are alive the counts cannot
+// change. We therefore keep a single-entry cache of the last repeated graph,
+// keyed on the root nodes and held through weak_ptrs. A fresh graph built
+// every iteration allocates fresh nodes, so its roots never match a prior
+// entry and such loops only pay an O(#roots) comparison; counts are copied
+// into the cache only once the same roots are seen a second time.
+bool Engine::dependencies_cache_matches(const edge_list& roots) const {
+  if (dependencies_cache_.roots_.size() != roots.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < roots.size(); ++i) {
+    if (dependencies_cache_.roots_[i].lock() != roots[i].function) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Engine::compute_dependencies_cached(
+    const edge_list& roots,
+    Node* graph_root,
+    GraphTask& task) {
+  {
+    std::lock_guard<std::mutex> lock(dependencies_cache_mutex_);
+    if (dependencies_cache_matches(roots)) {
+      if (dependencies_cache_.populated_) {
+        task.dependencies_ = dependencies_cache_.dependencies_;
+        return;
+      }
+    } else {
+      dependencies_cache_.roots_.clear();
+      dependencies_cache_.roots_.reserve(roots.size());
+      for (const auto& root : roots) {
+        dependencies_cache_.roots_.emplace_back(root.function);
+      }
+      dependencies_cache_.dependencies_.clear();
+      dependencies_cache_.populated_ = false;
+    }
+  }
+  compute_dependencies(graph_root, task);
+  std::lock_guard<std::mutex> lock(dependencies_cache_mutex_);
+  if (!dependencies_cache_.populated_ && dependencies_cache_matches(roots)) {
+    // Second execution of the same roots; keep a copy for subsequent calls
+    dependencies_cache_.dependencies_ = task.dependencies_;
+    dependencies_cache_.populated_ = true;
+  }
+}
+
 struct ClearCallbacks {
   ClearCallbacks(std::vector<std::function<void()>>& callbacks,
                  std::mutex &callbacks_lock)
@@ -710,7 +835,7 @@ auto Engine::execute(const edge_list& roots,
 
   // Now compute the dependencies for all executable functions and queue the root
   auto graph_root = std::make_shared<GraphRoot>(roots, inputs);
-  compute_dependencies(graph_root.get(), *graph_task);
+  compute_dependencies_cached(roots, graph_root.get(), *graph_task);
 
   if (!outputs.empty()) {
     graph_task->init_to_execute(*graph_root, outputs);
@@ -869,6 +994,12 @@ auto Engine::start_threads() -> void {
     std::thread t(&Engine::thread_init, this, i - 1);
     t.detach();
   }
+  // Additional workers draining the CPU queue; device threads stay at one
+  // apiece since their work is serialized on the device anyway
+  for (int i = 1; i < num_cpu_backward_threads(); ++i) {
+    std::thread t(&Engine::thread_init, this, /*device=*/-1);
+    t.detach();
+  }
 }
 
 void Engine::add_thread_pool_task(const std::weak_ptr<GraphTask>& graph_task) {
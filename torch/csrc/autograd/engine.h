@@ -193,6 +193,16 @@ struct TORCH_API Engine {
 
 protected:
   void compute_dependencies(Node* root, GraphTask& task);
+  // Fills in task.dependencies_ for a graph rooted at `graph_root` (whose
+  // next_edges are `roots`), reusing counts cached from a previous execution
+  // of the same graph when possible.
+  // See Note [Backward plan cache] in engine.cpp.
+  void compute_dependencies_cached(
+      const edge_list& roots,
+      Node* graph_root,
+      GraphTask& task);
+  // Requires dependencies_cache_mutex_ to be held.
+  bool dependencies_cache_matches(const edge_list& roots) const;
   void evaluate_function(
       std::shared_ptr<GraphTask>& graph_task,
       Node* func,
@@ -222,6 +232,21 @@ protected:
   // How many nested reentrant calls are allowed until a new thread is used
   int max_recursion_depth_;
 
+  // See Note [Backward plan cache] in engine.cpp.
+  struct DependenciesCache {
+    // The root nodes the cached counts were computed from. Held weakly: if
+    // any root has been freed the entry is stale, and a dead weak_ptr can
+    // never lock to a live node, so recycled addresses cannot alias.
+    std::vector<std::weak_ptr<Node>> roots_;
+    dependencies_type dependencies_;
+    // Set once the same roots have been executed twice; counts are only
+    // cached for graphs that are demonstrably reused.
+    bool populated_ = false;
+  };
+  DependenciesCache dependencies_cache_;
+  // To protect reads and writes to dependencies_cache_
+  mutable std::mutex dependencies_cache_mutex_;
+
   struct ThreadPoolShared {
     // Data structures used by the threads for executing reentrant backwards
     // tasks. See Note [Reentrant backwards]
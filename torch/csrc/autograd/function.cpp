@@ -19,6 +19,84 @@ namespace torch { namespace autograd {
 /// numbers.
 thread_local uint64_t Function_next_sequence_nr_ = 0;
 
+// Note [Node allocation pool]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Every traced op allocates a grad_fn Node and each backward frees it again,
+// so the general-purpose allocator sees thousands of short-lived small
+// allocations per training step. Nodes are shared_ptr-owned and may outlive
+// the iteration that created them (user code can hold on to a grad_fn), so an
+// arena released wholesale after backward would be unsound. Instead each
+// thread keeps free lists bucketed by size and recycles Node memory across
+// iterations: blocks are returned to the list of the freeing thread, which in
+// steady state is the thread that destroys the graph and rebuilds it on the
+// next iteration. edge_list vectors still come from the heap; threading a
+// custom allocator through that type would ripple through the public API.
+namespace {
+
+constexpr size_t kNodePoolBucketSize = 64;
+// Nodes larger than this go straight to the heap.
+constexpr size_t kNodePoolMaxBytes = 1024;
+// Cap on cached blocks per bucket, bounding pool memory per thread.
+constexpr size_t kNodePoolMaxPerBucket = 4096;
+
+// Trivially destructible, so it stays valid for the whole thread lifetime
+// even after the pool's own thread-local destructor has run.
+thread_local bool node_pool_alive = false;
+
+struct NodePool {
+  std::vector<void*> buckets_[kNodePoolMaxBytes / kNodePoolBucketSize];
+
+  NodePool() {
+    node_pool_alive = true;
+  }
+
+  ~NodePool() {
+    node_pool_alive = false;
+    for (auto& bucket : buckets_) {
+      for (void* ptr : bucket) {
+        ::operator delete(ptr);
+      }
+    }
+  }
+};
+
+NodePool& node_pool() {
+  static thread_local NodePool pool;
+  return pool;
+}
+
+size_t node_pool_bucket(size_t size) {
+  return (size + kNodePoolBucketSize - 1) / kNodePoolBucketSize - 1;
+}
+
+} // namespace
+
+void* Node::operator new(std::size_t size) {
+  if (size <= kNodePoolMaxBytes) {
+    auto& free_list = node_pool().buckets_[node_pool_bucket(size)];
+    if (!free_list.empty()) {
+      void* ptr = free_list.back();
+      free_list.pop_back();
+      return ptr;
+    }
+    // Allocate the full bucket so the block is reusable by anything that
+    // rounds to the same bucket.
+    return ::operator new((node_pool_bucket(size) + 1) * kNodePoolBucketSize);
+  }
+  return ::operator new(size);
+}
+
+void Node::operator delete(void* ptr, std::size_t size) {
+  if (size <= kNodePoolMaxBytes && node_pool_alive) {
+    auto& free_list = node_pool().buckets_[node_pool_bucket(size)];
+    if (free_list.size() < kNodePoolMaxPerBucket) {
+      free_list.push_back(ptr);
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
 uint64_t Node::peek_at_next_sequence_nr() {
   return Function_next_sequence_nr_;
 }
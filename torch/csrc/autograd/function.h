@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -110,6 +111,13 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   Node& operator=(Node&& other) = delete;
   virtual ~Node() = default;
 
+  /// Nodes are allocated and freed in large numbers every iteration, so their
+  /// memory is recycled through per-thread, size-bucketed free lists instead
+  /// of the general-purpose heap.
+  /// See Note [Node allocation pool] in function.cpp.
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
   /// Evaluates the function on the given inputs and returns the result of the
   /// function call.
   variable_list operator()(variable_list&& inputs) {
@@ -225,6 +233,17 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
     return sequence_nr_;
   }
 
+  /// Serializes execution of this `Node`. The engine holds this mutex while
+  /// running `apply` and releasing saved variables, so a `Node` shared
+  /// between graphs (e.g. an `AccumulateGrad` leaf reached by concurrent
+  /// backward calls) is never entered concurrently even when several CPU
+  /// worker threads drain the ready queue. A `Node` whose `apply` reentrantly
+  /// triggers its own execution would self-deadlock here; that was already
+  /// unsupported (and racy) before the lock existed.
+  std::mutex& mutex() noexcept {
+    return mutex_;
+  }
+
   /// Returns the name of the dynamic type of the function, for debugging.
   virtual std::string name() const;
 
@@ -350,6 +369,9 @@ struct TORCH_API Node : std::enable_shared_from_this<Node> {
   // fields.
   const uint64_t sequence_nr_;
 
+  // See mutex()
+  std::mutex mutex_;
+
   edge_list next_edges_;
   PyObject* pyobj_ = nullptr; // weak reference
   std::unique_ptr<AnomalyMetadata> anomaly_metadata_ = nullptr;
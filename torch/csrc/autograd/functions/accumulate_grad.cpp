@@ -91,4 +91,34 @@ auto AccumulateGrad::apply(variable_list&& grads) -> variable_list {
   return variable_list();
 }
 
+at::Tensor make_flat_grad_buffer(const std::vector<Variable>& parameters) {
+  TORCH_CHECK(!parameters.empty(), "make_flat_grad_buffer: expected at least one parameter");
+  int64_t total_numel = 0;
+  const auto& first = parameters.front();
+  for (const auto& param : parameters) {
+    TORCH_CHECK(param.defined(), "make_flat_grad_buffer: undefined parameter");
+    TORCH_CHECK(!param.is_sparse(), "make_flat_grad_buffer: sparse parameters are not supported");
+    TORCH_CHECK(param.is_leaf() && param.requires_grad(),
+        "make_flat_grad_buffer: parameters must be leaf variables that require grad");
+    TORCH_CHECK(param.dtype() == first.dtype() && param.device() == first.device(),
+        "make_flat_grad_buffer: parameters must share one dtype and device; "
+        "use a separate buffer per bucket");
+    total_numel += param.numel();
+  }
+  // The buffer and the views into it are plain gradient storage; keep the
+  // view relations out of autograd.
+  AutoGradMode grad_mode(false);
+  auto buffer = at::zeros({total_numel}, first.options());
+  int64_t offset = 0;
+  for (auto param : parameters) {
+    auto view = buffer.narrow(0, offset, param.numel()).view(param.sizes());
+    if (param.grad().defined()) {
+      view.copy_(param.grad());
+    }
+    param.grad() = view;
+    offset += param.numel();
+  }
+  return buffer;
+}
+
 }} // namespace torch::autograd
@@ -14,4 +14,19 @@ struct TORCH_API AccumulateGrad : public Node {
   Variable variable;
 };
 
+/// Preallocates one contiguous buffer covering the gradients of `parameters`
+/// and installs each parameter's `.grad` as a view into it. AccumulateGrad
+/// then adds into the views in place, so after a backward pass the buffer
+/// holds all gradients back to back: optimizers can sweep it with a single
+/// contiguous pass and bucketed allreduce can send it without gathering.
+/// Any already-accumulated `.grad` is copied into its view; the rest of the
+/// buffer starts out zeroed.
+///
+/// The parameters must be dense leaf variables that require grad, and must
+/// share one dtype and device (use one buffer per bucket otherwise). The
+/// views are only preserved under first-order backward; `create_graph=true`
+/// backward or a sparse gradient replaces the affected `.grad` with a fresh
+/// tensor, detaching that parameter from the buffer.
+TORCH_API at::Tensor make_flat_grad_buffer(const std::vector<Variable>& parameters);
+
 }} // namespace torch::autograd
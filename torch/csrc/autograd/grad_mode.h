@@ -7,5 +7,7 @@ namespace torch { namespace autograd {
 
 using GradMode = at::GradMode;
 using AutoGradMode = at::AutoGradMode;
+using InferenceMode = at::InferenceMode;
+using AutoInferenceMode = at::AutoInferenceMode;
 
 }}
@@ -1,5 +1,7 @@
 #include <torch/csrc/autograd/input_buffer.h>
 
+#include <ATen/native/sparse/SparseTensorMath.h>
+
 #include <c10/core/DeviceGuard.h>
 #include <c10/core/StreamGuard.h>
 #include <c10/core/Event.h>
@@ -11,6 +13,34 @@
 
 namespace torch { namespace autograd {
 
+  // A gradient may be accumulated into in place only when the buffer holds
+  // the last reference to it: use_count() rules out other handles to the
+  // tensor and storage().use_count() rules out views aliasing its memory.
+  // Storage use_count is a big hammer, but for anything lighter there's an
+  // adversarial example with unexpected inplace modification.
+  static bool can_accumulate_inplace(const Variable& var) {
+    return var.is_contiguous() && var.use_count() == 1 &&
+        var.storage().use_count() == 1;
+  }
+
+  // Sparse gradients of the same input can be summed lazily: appending the
+  // new index/value block to a chunk list is O(1), and the blocks are
+  // concatenated into one uncoalesced tensor only when the slot is consumed
+  // (at::native::add_sparse_uncoalesced), so the actual sort/merge runs once
+  // — at the first coalesce(), typically in the optimizer — instead of once
+  // per accumulation.  Restricted to CPU tensors (CUDA accumulation is tied
+  // to the stream handling in add() below) that don't require grad (with
+  // create_graph the addition itself must be recorded).
+  static bool can_append_sparse(const Variable& old_var, const Variable& var) {
+    return old_var.is_sparse() && var.is_sparse() &&
+        !old_var.is_cuda() && !var.is_cuda() &&
+        !old_var.requires_grad() && !var.requires_grad() &&
+        old_var.sizes().equals(var.sizes()) &&
+        old_var.scalar_type() == var.scalar_type() &&
+        old_var.sparse_dim() == var.sparse_dim() &&
+        old_var.dense_dim() == var.dense_dim();
+  }
+
   static void accumulate(std::vector<Variable>& buffer,
                          const size_t pos,
                          Variable&& var) {
@@ -19,15 +49,24 @@ namespace torch { namespace autograd {
     // ATen doesn't route sparse additions correctly...
     // do dense + sparse in-place if possible
     if (old_var.is_sparse()) {
-      //storage use_count is a big hammer, but for anything lighter there's an adversarial example with unexpected inplace modification
-      if (!var.is_sparse() && var.is_contiguous() && var.storage().use_count() == 1) {
+      if (!var.is_sparse() && can_accumulate_inplace(var)) {
           buffer[pos] = var.add_(old_var);
       } else {
           buffer[pos] = var + old_var;
       }
+    } else if (var.is_sparse()) {
+      if (can_accumulate_inplace(old_var)) {
+          buffer[pos] = old_var.add_(var);
+      } else {
+          buffer[pos] = old_var + var;
+      }
     } else {
-      if (var.is_sparse() && !old_var.is_sparse() && old_var.is_contiguous() && old_var.storage().use_count() == 1) {
+      // Dense + dense: accumulate into whichever operand the buffer owns
+      // outright rather than allocating a fresh tensor for the sum.
+      if (can_accumulate_inplace(old_var)) {
           buffer[pos] = old_var.add_(var);
+      } else if (can_accumulate_inplace(var)) {
+          buffer[pos] = var.add_(old_var);
       } else {
           buffer[pos] = old_var + var;
       }
@@ -85,7 +124,12 @@ namespace torch { namespace autograd {
   auto& old_var = buffer[pos];
   if (!old_var.defined()) {
     buffer[pos] = std::move(var);
+  } else if (can_append_sparse(old_var, var)) {
+    pending_sparse[pos].emplace_back(std::move(var));
   } else {
+    // A pending sparse chunk list can only be continued by another
+    // appendable sparse gradient; anything else consumes the slot.
+    materialize(pos);
     if (opt_accumulate_stream) {
       c10::OptionalStreamGuard stream_guard{opt_accumulate_stream};
       accumulate(buffer, pos, std::move(var));
@@ -98,6 +142,19 @@ namespace torch { namespace autograd {
   }
 }
 
+void InputBuffer::materialize(size_t pos) {
+  auto& chunks = pending_sparse[pos];
+  if (chunks.empty()) {
+    return;
+  }
+  std::vector<at::Tensor> blocks;
+  blocks.reserve(chunks.size() + 1);
+  blocks.push_back(buffer[pos]);
+  blocks.insert(blocks.end(), chunks.begin(), chunks.end());
+  buffer[pos] = at::native::add_sparse_uncoalesced(blocks);
+  chunks.clear();
+}
+
 auto InputBuffer::device() const -> at::Device {
   // Since we pick the first non-CPU tensor, this won't work with
   // mixed device-type operations (e.g., an op that is both CUDA
@@ -117,6 +174,9 @@ auto InputBuffer::device() const -> at::Device {
 }
 
 auto InputBuffer::variables(InputBuffer&& g) -> std::vector<Variable> {
+  for (size_t pos = 0; pos < g.buffer.size(); ++pos) {
+    g.materialize(pos);
+  }
   std::vector<Variable> result = std::move(g.buffer);
   return result;
 }
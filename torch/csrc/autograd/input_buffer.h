@@ -18,7 +18,8 @@ namespace torch { namespace autograd {
 
 struct InputBuffer {
   explicit InputBuffer(size_t size)
-    : buffer(size) {}
+    : buffer(size)
+    , pending_sparse(size) {}
   InputBuffer(const InputBuffer& other) = delete;
   InputBuffer(InputBuffer&& other) = default;
   InputBuffer& operator=(InputBuffer&& other) = default;
@@ -33,13 +34,25 @@ struct InputBuffer {
 
   at::Device device() const;
 
-  Variable operator[](size_t pos) { return buffer[pos]; }
+  Variable operator[](size_t pos) {
+    materialize(pos);
+    return buffer[pos];
+  }
 
   // Returns the inputs as a list of variables. Destroys given InputBuffer.
   static std::vector<Variable> variables(InputBuffer&& g);
 
 private:
+  // Folds any sparse gradient blocks pending for `pos` into buffer[pos]
+  // as a single uncoalesced tensor; a no-op when nothing is pending.
+  void materialize(size_t pos);
+
   std::vector<Variable> buffer;
+  // Sparse gradients for the same input are appended here instead of
+  // being merged eagerly; the concatenation (and, much later, the
+  // coalesce) happens only when the slot is consumed.  See accumulate()
+  // in input_buffer.cpp.
+  std::vector<std::vector<Variable>> pending_sparse;
 };
 
 }}  // namespace torch::autograd
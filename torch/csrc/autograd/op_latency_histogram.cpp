@@ -0,0 +1,197 @@
+#include <torch/csrc/autograd/op_latency_histogram.h>
+
+#include <torch/csrc/autograd/profiler.h>
+#include <torch/csrc/autograd/record_function.h>
+
+#include <c10/util/llvmMathExtras.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace torch { namespace autograd { namespace profiler {
+
+namespace {
+
+size_t bucket_index(uint64_t ns) {
+  if (ns == 0) {
+    return 0;
+  }
+  return std::min<size_t>(llvm::Log2_64(ns), kOpLatencyHistogramBuckets - 1);
+}
+
+// Histogram written by exactly one thread with relaxed stores; the merger
+// only ever reads, so no increment is ever contended.
+struct ThreadHistogram {
+  ThreadHistogram() {
+    for (auto& bucket : buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void record(uint64_t ns) {
+    auto& bucket = buckets[bucket_index(ns)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+                 std::memory_order_relaxed);
+    count.store(count.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    total_ns.store(total_ns.load(std::memory_order_relaxed) + ns,
+                   std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, kOpLatencyHistogramBuckets> buckets;
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> total_ns{0};
+};
+
+// One recording thread's histograms, keyed by op name. The owning thread
+// looks entries up without a lock; `mutex` is only taken when the owner
+// inserts a histogram for an op name it has not seen before, and by the
+// merger while it iterates, so the hot path never blocks.
+struct ThreadRecords {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::unique_ptr<ThreadHistogram>> histograms;
+};
+
+struct Registry {
+  std::mutex mutex;
+  // shared_ptrs keep records alive after their thread exits, so counts
+  // from short-lived threads are not lost.
+  std::vector<std::shared_ptr<ThreadRecords>> records;
+};
+
+Registry& registry() {
+  static Registry r;
+  return r;
+}
+
+ThreadRecords& thread_records() {
+  static thread_local std::shared_ptr<ThreadRecords> records = []() {
+    auto r = std::make_shared<ThreadRecords>();
+    std::lock_guard<std::mutex> guard(registry().mutex);
+    registry().records.push_back(r);
+    return r;
+  }();
+  return *records;
+}
+
+ThreadHistogram& thread_histogram(const std::string& op_name) {
+  ThreadRecords& records = thread_records();
+  auto it = records.histograms.find(op_name);
+  if (it == records.histograms.end()) {
+    std::lock_guard<std::mutex> guard(records.mutex);
+    it = records.histograms
+             .emplace(op_name, std::unique_ptr<ThreadHistogram>(
+                                   new ThreadHistogram()))
+             .first;
+  }
+  return *it->second;
+}
+
+// Start timestamps of the currently nested RecordFunctions on this thread;
+// end callbacks run in reverse nesting order, so a stack pairs them up.
+thread_local std::vector<int64_t> start_times;
+
+std::atomic<bool> histograms_enabled{false};
+
+void onFunctionEnter(const RecordFunction& /* fn */) {
+  start_times.push_back(getTime());
+}
+
+void onFunctionExit(const RecordFunction& fn) {
+  if (start_times.empty()) {
+    // Enabled between this RecordFunction's start and end; nothing to pair.
+    return;
+  }
+  const int64_t elapsed = getTime() - start_times.back();
+  start_times.pop_back();
+  if (fn.name().str() != nullptr) {
+    thread_histogram(fn.name().str()).record(elapsed > 0 ? elapsed : 0);
+  }
+}
+
+} // namespace
+
+void OpLatencyHistogram::merge(const OpLatencyHistogram& other) {
+  for (size_t i = 0; i < kOpLatencyHistogramBuckets; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+  count += other.count;
+  total_ns += other.total_ns;
+}
+
+uint64_t OpLatencyHistogram::quantile_ns(double q) const {
+  if (count == 0) {
+    return 0;
+  }
+  const uint64_t target =
+      std::min<uint64_t>(static_cast<uint64_t>(q * count), count - 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kOpLatencyHistogramBuckets; ++i) {
+    seen += buckets[i];
+    if (seen > target) {
+      return uint64_t(1) << std::min<size_t>(i + 1, 63);
+    }
+  }
+  return uint64_t(1) << 63;
+}
+
+void enableOpLatencyHistograms() {
+  if (histograms_enabled.exchange(true)) {
+    return;
+  }
+  pushCallback(
+      [](const RecordFunction& fn) { onFunctionEnter(fn); },
+      [](const RecordFunction& fn) { onFunctionExit(fn); },
+      /* needs_inputs */ false);
+}
+
+void disableOpLatencyHistograms() {
+  if (!histograms_enabled.exchange(false)) {
+    return;
+  }
+  popCallback();
+}
+
+bool opLatencyHistogramsEnabled() {
+  return histograms_enabled.load();
+}
+
+std::unordered_map<std::string, OpLatencyHistogram> getOpLatencyHistograms() {
+  std::unordered_map<std::string, OpLatencyHistogram> result;
+  std::lock_guard<std::mutex> registry_guard(registry().mutex);
+  for (const auto& records : registry().records) {
+    std::lock_guard<std::mutex> records_guard(records->mutex);
+    for (const auto& entry : records->histograms) {
+      OpLatencyHistogram snapshot;
+      const ThreadHistogram& histogram = *entry.second;
+      for (size_t i = 0; i < kOpLatencyHistogramBuckets; ++i) {
+        snapshot.buckets[i] =
+            histogram.buckets[i].load(std::memory_order_relaxed);
+      }
+      snapshot.count = histogram.count.load(std::memory_order_relaxed);
+      snapshot.total_ns = histogram.total_ns.load(std::memory_order_relaxed);
+      result[entry.first].merge(snapshot);
+    }
+  }
+  return result;
+}
+
+void clearOpLatencyHistograms() {
+  std::lock_guard<std::mutex> registry_guard(registry().mutex);
+  for (const auto& records : registry().records) {
+    std::lock_guard<std::mutex> records_guard(records->mutex);
+    for (const auto& entry : records->histograms) {
+      ThreadHistogram& histogram = *entry.second;
+      for (auto& bucket : histogram.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+      histogram.count.store(0, std::memory_order_relaxed);
+      histogram.total_ns.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+} // namespace profiler
+}} // namespace torch::autograd
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+namespace torch { namespace autograd { namespace profiler {
+
+// Always-on per-op latency histograms.
+//
+// Unlike the full profiler, this sink is cheap enough to leave enabled in
+// serving: each observed op costs one hash lookup plus a few relaxed
+// atomic increments into a fixed-size, log2-bucketed histogram owned by
+// the recording thread. Histograms are merged across threads only when
+// queried. Enable with enableOpLatencyHistograms() (which installs a
+// RecordFunction callback, so anything under RECORD_FUNCTION is counted)
+// and pull aggregated results with getOpLatencyHistograms().
+
+// Number of log2-spaced latency buckets per op; bucket i counts ops whose
+// latency fell in [2^i, 2^(i+1)) nanoseconds. 48 buckets cover latencies
+// up to ~3 days, so the last bucket never saturates in practice.
+constexpr size_t kOpLatencyHistogramBuckets = 48;
+
+struct TORCH_API OpLatencyHistogram {
+  std::array<uint64_t, kOpLatencyHistogramBuckets> buckets{{}};
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+
+  void merge(const OpLatencyHistogram& other);
+
+  // Estimates the q-th latency quantile (q in [0, 1]) as the upper bound
+  // of the bucket containing it; accurate to within a factor of two.
+  uint64_t quantile_ns(double q) const;
+};
+
+// Installs the aggregation callback via pushCallback(). Like all callback
+// registration, enable/disable follow stack discipline and must not
+// overlap with other code execution.
+TORCH_API void enableOpLatencyHistograms();
+TORCH_API void disableOpLatencyHistograms();
+TORCH_API bool opLatencyHistogramsEnabled();
+
+// Merges the per-thread histograms of every thread that ever recorded
+// (including exited ones) into one histogram per op name.
+TORCH_API std::unordered_map<std::string, OpLatencyHistogram>
+getOpLatencyHistograms();
+
+// Resets all per-thread histograms to zero.
+TORCH_API void clearOpLatencyHistograms();
+
+} // namespace profiler
+}} // namespace torch::autograd
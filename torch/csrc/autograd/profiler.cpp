@@ -1,6 +1,7 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/jit/code_template.h>
 
+#include <atomic>
 #include <fstream>
 #include <list>
 #include <mutex>
@@ -20,8 +21,22 @@ void registerCUDAMethods(CUDAStubs* stubs) {
   cuda_stubs = stubs;
 }
 
+AnnotationStubs default_annotation_stubs;
+constexpr AnnotationStubs* default_annotation_stubs_addr =
+    &default_annotation_stubs;
+// constant initialization, as above, so a backend built into the library
+// can safely register itself during static initialization
+static AnnotationStubs* annotation_stubs = default_annotation_stubs_addr;
+
+void registerAnnotationMethods(AnnotationStubs* stubs) {
+  annotation_stubs = stubs;
+}
+
 ProfilerState state = ProfilerState::Disabled;
 uint16_t next_thread_id = 0;
+// Correlation ids are handed out at launch time (see pushRangeImpl), so a
+// CPU range and the device execution it caused can be linked in traces.
+std::atomic<uint64_t> next_correlation_id{0};
 std::mutex all_event_lists_mutex;
 std::list<std::shared_ptr<RangeEventList>> all_event_lists;
 thread_local std::shared_ptr<RangeEventList> event_list;
@@ -45,6 +60,8 @@ void mark(std::string name, bool include_cuda /* = true */) {
   }
   if (state == ProfilerState::NVTX) {
     cuda_stubs->nvtxMarkA(name.c_str());
+  } else if (state == ProfilerState::ITT) {
+    annotation_stubs->markA(name.c_str());
   } else {
     getEventList().record(
         EventKind::Mark,
@@ -62,7 +79,14 @@ void pushRangeImpl(
   if (state == ProfilerState::Disabled) {
     return;
   }
-  if (state == ProfilerState::NVTX) {
+  if (state == ProfilerState::NVTX || state == ProfilerState::ITT) {
+    auto range_push = [](const char* range_name) {
+      if (state == ProfilerState::NVTX) {
+        cuda_stubs->nvtxRangePushA(range_name);
+      } else {
+        annotation_stubs->rangePushA(range_name);
+      }
+    };
     if(sequence_nr >= 0 || shapes.size() > 0) {
       std::stringstream s;
       if(sequence_nr >= 0)
@@ -86,17 +110,22 @@ void pushRangeImpl(
         }
         s << "]";
       }
-      cuda_stubs->nvtxRangePushA(s.str().c_str());
+      range_push(s.str().c_str());
     } else {
-      cuda_stubs->nvtxRangePushA(name.str());
+      range_push(name.str());
     }
   } else {
+    uint64_t correlation_id = 0;
+    if (state == ProfilerState::CUDA) {
+      correlation_id = ++next_correlation_id;
+    }
     getEventList().record(
         EventKind::PushRange,
         name,
         thread_id,
         state == ProfilerState::CUDA,
-        std::move(shapes));
+        std::move(shapes),
+        correlation_id);
   }
 }
 
@@ -110,6 +139,8 @@ void popRange() {
   }
   if (state == ProfilerState::NVTX) {
     cuda_stubs->nvtxRangePop();
+  } else if (state == ProfilerState::ITT) {
+    annotation_stubs->rangePop();
   } else {
     getEventList().record(
         EventKind::PopRange,
@@ -124,6 +155,8 @@ void enableProfiler(ProfilerConfig config) {
   AT_ASSERT(new_state != ProfilerState::Disabled);
   if (new_state == ProfilerState::NVTX && !cuda_stubs->enabled())
     throw std::runtime_error("Can't use NVTX profiler - PyTorch was compiled without CUDA");
+  if (new_state == ProfilerState::ITT && !annotation_stubs->enabled())
+    throw std::runtime_error("Can't use ITT profiler - PyTorch was compiled without USE_ITT");
   if (state != ProfilerState::Disabled && new_state != state) {
     throw std::runtime_error("can't change kind of profiling (e.g. NVTX to CPU) while profiler is running");
   }
@@ -185,7 +218,7 @@ thread_event_lists disableProfiler() {
   popCallback();
   state = ProfilerState::Disabled;
 
-  if (old_state == ProfilerState::NVTX) {
+  if (old_state == ProfilerState::NVTX || old_state == ProfilerState::ITT) {
     return thread_event_lists();
   } else {
     thread_event_lists result;
@@ -224,7 +257,32 @@ double Event::cuda_elapsed_us(const Event & e) {
   return cuda_stubs->elapsed(event, e.event);
 }
 
+std::vector<double> Event::cuda_elapsed_us_batch(
+    const std::vector<std::pair<const Event*, const Event*>>& pairs) {
+  std::vector<CUDAEventStub> starts;
+  std::vector<CUDAEventStub> ends;
+  starts.reserve(pairs.size());
+  ends.reserve(pairs.size());
+  for (const auto& pair : pairs) {
+    const Event* start = pair.first;
+    const Event* end = pair.second;
+    if (!start->has_cuda() || !end->has_cuda()) {
+      throw std::logic_error("Events were not recorded for CUDA");
+    }
+    if (start->device() != end->device()) {
+      throw std::logic_error("Events are not on the same device");
+    }
+    starts.push_back(start->event);
+    ends.push_back(end->event);
+  }
+  std::vector<float> elapsed_us(pairs.size());
+  cuda_stubs->elapsed_batch(
+      starts.data(), ends.data(), elapsed_us.data(), pairs.size());
+  return std::vector<double>(elapsed_us.begin(), elapsed_us.end());
+}
+
 CUDAStubs::~CUDAStubs() = default;
+AnnotationStubs::~AnnotationStubs() = default;
 
 
 static jit::CodeTemplate event_template(R"(
@@ -239,66 +297,100 @@ static jit::CodeTemplate event_template(R"(
 })");
 
 
-RecordProfile::RecordProfile(std::ostream& out)
+// Consolidates the events recorded so far on all threads without stopping
+// the profiler; used by the streaming RecordProfile writer.
+static thread_event_lists drainAllEventLists() {
+  thread_event_lists result;
+  std::lock_guard<std::mutex> guard(all_event_lists_mutex);
+  for (auto& list : all_event_lists) {
+    result.emplace_back(list->consolidate());
+  }
+  return result;
+}
+
+RecordProfile::RecordProfile(
+    std::ostream& out,
+    std::chrono::milliseconds flush_interval)
 : out_(out) {
-  init();
+  init(flush_interval);
 }
 
-RecordProfile::RecordProfile(const std::string& filename)
+RecordProfile::RecordProfile(
+    const std::string& filename,
+    std::chrono::milliseconds flush_interval)
 : file_(new std::ofstream(filename)), out_(*file_) {
-  init();
+  init(flush_interval);
 }
 
-void RecordProfile::init() {
+void RecordProfile::init(std::chrono::milliseconds flush_interval) {
+  TORCH_CHECK(out_, "could not open file");
   enableProfiler(ProfilerConfig(ProfilerState::CPU, false /* report shapes */));
+  // Reference point for the trace's timestamps; recorded with the same clock
+  // and at the same time as the __start_profile mark.
+  profile_start_.reset(
+      new Event(EventKind::Mark, StringView("__start_profile"), 0, false));
+  out_ << "[\n";
+  if (flush_interval.count() > 0) {
+    flush_thread_ =
+        std::thread(&RecordProfile::flushThread, this, flush_interval);
+  }
+}
+
+void RecordProfile::flushThread(std::chrono::milliseconds flush_interval) {
+  std::unique_lock<std::mutex> lock(stop_mutex_);
+  while (!stop_) {
+    stop_cv_.wait_for(lock, flush_interval);
+    if (stop_) {
+      break;
+    }
+    lock.unlock();
+    writeEvents(drainAllEventLists());
+    out_.flush();
+    lock.lock();
+  }
 }
 
 RecordProfile::~RecordProfile() {
-  thread_event_lists event_lists = disableProfiler();
-  std::vector<Event*> events;
-  for(auto& l : event_lists) {
-    for(auto& e : l) {
-        events.push_back(&e);
+  if (flush_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(stop_mutex_);
+      stop_ = true;
     }
+    stop_cv_.notify_all();
+    flush_thread_.join();
   }
-  processEvents(events);
+  writeEvents(disableProfiler());
+  out_ << "]\n";
   if (file_){
     file_->close();
   }
 }
 
-void RecordProfile::processEvents(const std::vector<Event*>& events) {
-  TORCH_CHECK(out_, "could not open file");
-  Event* start = nullptr;
-  for (Event* e : events) {
-    if(0 == strcmp(e->name(), "__start_profile")) {
-      start = e;
-      break;
-    }
-  }
-  TORCH_CHECK(start, "could not find start?");
-  std::vector<Event*> stack;
-  out_ << "[\n";
-  bool first = true;
-  for(Event* e : events) {
-    if(e->kind() == "push") {
-      stack.push_back(e);
-    } else if(e->kind() == "pop") {
-      if(!first) {
-        out_ << ",\n";
+void RecordProfile::writeEvents(thread_event_lists&& event_lists) {
+  for (auto& list : event_lists) {
+    for (auto& e : list) {
+      if (e.kind() == "push") {
+        pending_stacks_[e.thread_id()].push_back(std::move(e));
+      } else if (e.kind() == "pop") {
+        auto& stack = pending_stacks_[e.thread_id()];
+        if (stack.empty()) {
+          continue;
+        }
+        Event e_start = std::move(stack.back());
+        stack.pop_back();
+        if (!first_entry_) {
+          out_ << ",\n";
+        }
+        first_entry_ = false;
+        jit::TemplateEnv env;
+        env.s("name", e_start.name());
+        env.d("ts", profile_start_->cpu_elapsed_us(e_start));
+        env.d("dur", e_start.cpu_elapsed_us(e));
+        env.d("tid", e_start.thread_id());
+        out_ << event_template.format(env);
       }
-      first = false;
-      Event* e_start = stack.back();
-      stack.pop_back();
-      jit::TemplateEnv env;
-      env.s("name", e_start->name());
-      env.d("ts", start->cpu_elapsed_us(*e_start));
-      env.d("dur", e_start->cpu_elapsed_us(*e));
-      env.d("tid", e_start->thread_id());
-      out_ << event_template.format(env);
     }
   }
-  out_ << "]\n";
 }
 
 }}}
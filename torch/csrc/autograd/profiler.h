@@ -1,8 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
 #include <mutex>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <cstdint>
 #include <string>
@@ -33,6 +37,18 @@ struct TORCH_API CUDAStubs {
     fail();
     return 0.f;
   }
+  // Computes elapsed times for a batch of event pairs at once; the CUDA
+  // implementation synchronizes each distinct event only once instead of
+  // twice per pair.
+  virtual void elapsed_batch(
+      const CUDAEventStub* starts,
+      const CUDAEventStub* ends,
+      float* out_us,
+      size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      out_us[i] = elapsed(starts[i], ends[i]);
+    }
+  }
   virtual void nvtxMarkA(const char* name) {
     fail();
   }
@@ -61,6 +77,36 @@ private:
 
 TORCH_API void registerCUDAMethods(CUDAStubs* stubs);
 
+// Generic external-annotation backend, the CPU-side analogue of the NVTX
+// methods above: pushes profiler ranges into a vendor tool's timeline.
+// The default stubs fail; an implementation registers itself at static
+// initialization time (see profiler_itt.cpp for the ITT/VTune backend,
+// built with USE_ITT).
+struct TORCH_API AnnotationStubs {
+  virtual void markA(const char* name) {
+    fail();
+  }
+  virtual void rangePushA(const char* name) {
+    fail();
+  }
+  virtual void rangePop() {
+    fail();
+  }
+  virtual bool enabled() {
+    return false;
+  }
+  virtual ~AnnotationStubs();
+
+ private:
+  void fail() {
+    AT_ERROR(
+        "External annotations used in profiler but no backend is "
+        "registered (PyTorch was built without USE_ITT).");
+  }
+};
+
+TORCH_API void registerAnnotationMethods(AnnotationStubs* stubs);
+
 constexpr inline size_t ceilToMultiple(size_t a, size_t b) {
   return ((a + b - 1) / b) * b;
 }
@@ -99,6 +145,8 @@ enum class TORCH_API ProfilerState {
     CPU, // CPU-only profiling
     CUDA, // CPU + CUDA events
     NVTX,  // only emit NVTX markers
+    ITT,  // only emit markers for an external annotation backend (e.g.
+          // ITT/VTune); see AnnotationStubs
 };
 
 struct TORCH_API ProfilerConfig {
@@ -124,11 +172,13 @@ struct TORCH_API Event final {
       StringView name,
       uint16_t thread_id,
       bool record_cuda,
-      std::vector<std::vector<int64_t>>&& shapes = {})
+      std::vector<std::vector<int64_t>>&& shapes = {},
+      uint64_t correlation_id = 0)
       : name_(std::move(name)),
         kind_(kind),
         thread_id_(thread_id),
-        shapes_(shapes) {
+        shapes_(shapes),
+        correlation_id_(correlation_id) {
     record(record_cuda);
   }
 
@@ -154,12 +204,24 @@ struct TORCH_API Event final {
     return (e.cpu_ns_ - cpu_ns_)/(1000.0);
   }
   double cuda_elapsed_us(const Event & e);
+  // Batched variant of cuda_elapsed_us: one entry per (start, end) pair.
+  // Synchronizes each distinct CUDA event once, so post-processing a long
+  // trace doesn't pay two synchronizations per range.
+  static std::vector<double> cuda_elapsed_us_batch(
+      const std::vector<std::pair<const Event*, const Event*>>& pairs);
   bool has_cuda() const {
     return event != nullptr;
   }
   int device() const {
     return device_;
   }
+  // Correlation id assigned at launch time when profiling CUDA. The push
+  // event and the device interval derived from its CUDA event pair share
+  // it, so trace consumers can draw flow arrows from the dispatcher call
+  // to the device execution. 0 when no id was assigned.
+  uint64_t correlation_id() const {
+    return correlation_id_;
+  }
 private:
   // signed to allow for negative intervals, initialized for safety.
   int64_t cpu_ns_ = 0;
@@ -169,6 +231,7 @@ private:
   std::vector<std::vector<int64_t>> shapes_;
   int device_ = -1;
   struct CUevent_st* event = nullptr;
+  uint64_t correlation_id_ = 0;
 };
 
 // a linked-list of fixed sized vectors, to avoid
@@ -197,6 +260,7 @@ struct RangeEventList {
 
   template<typename... Args>
   void record(Args&&... args) {
+    std::lock_guard<std::mutex> guard(mutex_);
     if (blocks.empty() || blocks.front().size() == num_block_elements) {
       allocBlock();
     }
@@ -204,6 +268,7 @@ struct RangeEventList {
   }
 
   std::vector<Event> consolidate() {
+    std::lock_guard<std::mutex> guard(mutex_);
     std::vector<Event> result;
     for (auto & block : blocks) {
       result.insert(result.begin(),
@@ -215,6 +280,9 @@ struct RangeEventList {
   }
 
   std::forward_list<block_type> blocks;
+  // Serializes record() on the owning thread against consolidate() from the
+  // thread draining the lists (disableProfiler or a streaming RecordProfile).
+  std::mutex mutex_;
 };
 
 TORCH_API RangeEventList& getEventList();
@@ -235,16 +303,35 @@ TORCH_API thread_event_lists disableProfiler();
 //     // code you want to profile
 //   }
 // Then open filename.trace in chrome://tracing
+//
+// When constructed with a nonzero flush interval, a background thread
+// periodically drains the completed ranges from all threads and appends them
+// to the trace, so a long run writes its output incrementally instead of
+// buffering every event until the guard is destroyed.
 struct TORCH_API RecordProfile {
-  RecordProfile(std::ostream& out);
-  RecordProfile(const std::string& filename);
+  RecordProfile(
+      std::ostream& out,
+      std::chrono::milliseconds flush_interval = std::chrono::milliseconds(0));
+  RecordProfile(
+      const std::string& filename,
+      std::chrono::milliseconds flush_interval = std::chrono::milliseconds(0));
 
   ~RecordProfile();
 private:
-  void init();
+  void init(std::chrono::milliseconds flush_interval);
+  void flushThread(std::chrono::milliseconds flush_interval);
+  void writeEvents(thread_event_lists&& event_lists);
   std::unique_ptr<std::ofstream> file_;
   std::ostream& out_;
-  void processEvents(const std::vector<Event*>& events);
+  // Reference point for trace timestamps, recorded when profiling starts.
+  std::unique_ptr<Event> profile_start_;
+  bool first_entry_ = true;
+  // Pushes whose matching pop has not been drained yet, per thread id.
+  std::unordered_map<uint16_t, std::vector<Event>> pending_stacks_;
+  std::thread flush_thread_;
+  std::mutex stop_mutex_;
+  std::condition_variable stop_cv_;
+  bool stop_ = false;
 };
 
 
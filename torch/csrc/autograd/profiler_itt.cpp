@@ -0,0 +1,48 @@
+#include <torch/csrc/autograd/profiler.h>
+#include <ittnotify.h>
+
+namespace torch { namespace autograd { namespace profiler {
+
+namespace {
+
+__itt_domain* ittDomain() {
+  static __itt_domain* domain = __itt_domain_create("PyTorch");
+  return domain;
+}
+
+struct ITTMethods : public AnnotationStubs {
+  void markA(const char* name) override {
+    __itt_task_begin(
+        ittDomain(),
+        __itt_null,
+        __itt_null,
+        __itt_string_handle_create(name));
+    __itt_task_end(ittDomain());
+  }
+  void rangePushA(const char* name) override {
+    __itt_task_begin(
+        ittDomain(),
+        __itt_null,
+        __itt_null,
+        __itt_string_handle_create(name));
+  }
+  void rangePop() override {
+    __itt_task_end(ittDomain());
+  }
+  bool enabled() override {
+    return true;
+  }
+};
+
+struct RegisterITTMethods {
+  RegisterITTMethods() {
+    static ITTMethods methods;
+    registerAnnotationMethods(&methods);
+  }
+};
+RegisterITTMethods reg;
+
+} // namespaces
+} // namespace profiler
+} // namespace autograd
+} // namespace torch
@@ -1,6 +1,8 @@
 #include <torch/csrc/autograd/record_function.h>
+#include <c10/util/FlightRecorder.h>
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/utils/memory.h>
+#include <algorithm>
 #include <cstdlib>
 #include <random>
 
@@ -20,31 +22,76 @@ class CallbackManager {
       sampling_prop_set = true;
     }
     sampling_prob = prob;
+    updateSamplingConfig();
   }
 
   double getSamplingProbability() {
     return sampling_prob;
   }
 
+  // The per-op sampling decision. Skipped ops only pay for a thread-local
+  // decrement: the number of ops until the next hit is drawn from a
+  // geometric distribution with the largest effective per-callback
+  // probability, and counted down on each call.
   bool shouldRunSampledCallbacks() {
-    return (num_sampled_callbacks > 0) &&
-        (!sampling_prop_set || (sample_zero_one() < sampling_prob));
+    if (num_sampled_callbacks == 0) {
+      return false;
+    }
+    if (max_effective_prob >= 1.0) {
+      return true;
+    }
+    if (max_effective_prob <= 0.0) {
+      return false;
+    }
+    auto& skip = sample_state();
+    if (skip.version != config_version) {
+      skip.version = config_version;
+      skip.ops_until_hit = sample_geometric(max_effective_prob);
+    }
+    if (--skip.ops_until_hit > 0) {
+      return false;
+    }
+    skip.ops_until_hit = sample_geometric(max_effective_prob);
+    return true;
+  }
+
+  // Given that shouldRunSampledCallbacks() returned true for this op,
+  // whether the sampled callback at `idx` runs: true for the callbacks at
+  // the largest effective probability, a conditional coin flip for the rest.
+  bool shouldRunSampledCallback(size_t idx) {
+    const double prob = effectiveProb(idx);
+    if (prob >= max_effective_prob) {
+      return true;
+    }
+    if (prob <= 0.0) {
+      return false;
+    }
+    return sample_zero_one() < prob / max_effective_prob;
   }
 
   void pushCallback(
       RecordFunctionCallback start,
       RecordFunctionCallback end,
       bool needs_inputs,
-      bool sampled) {
+      bool sampled,
+      double sampling_prob_param) {
+    TORCH_CHECK(
+        sampling_prob_param >= 0.0 && sampling_prob_param <= 1.0,
+        "sampling probability must be in [0, 1]");
+    if (sampling_prob_param < 1.0) {
+      sampled = true;
+    }
     start_callbacks.push_back(std::move(start));
     end_callbacks.push_back(std::move(end));
     if (callback_needs_inputs > 0 || needs_inputs) {
       ++callback_needs_inputs;
     }
     is_callback_sampled.push_back(sampled);
+    callback_sampling_probs.push_back(sampling_prob_param);
     if (sampled) {
       ++num_sampled_callbacks;
     }
+    updateSamplingConfig();
   }
 
   void popCallback() {
@@ -60,6 +107,8 @@ class CallbackManager {
       --num_sampled_callbacks;
     }
     is_callback_sampled.pop_back();
+    callback_sampling_probs.pop_back();
+    updateSamplingConfig();
   }
 
   bool hasCallbacks() {
@@ -77,16 +126,66 @@ class CallbackManager {
   std::vector<RecordFunctionCallback> start_callbacks;
   std::vector<RecordFunctionCallback> end_callbacks;
   std::vector<bool> is_callback_sampled;
+  std::vector<double> callback_sampling_probs;
   size_t num_sampled_callbacks = 0;
   size_t callback_needs_inputs = 0;
   bool sampling_prop_set = false;
   double sampling_prob = 1.0;
+  // Largest effective probability over the sampled callbacks; the geometric
+  // skip counter is drawn against it.
+  double max_effective_prob = 1.0;
+  // Bumped whenever the callback set or a probability changes, invalidating
+  // the per-thread skip counters.
+  uint64_t config_version = 0;
+
+ private:
+  // A sampled callback's chance of observing a given op: its own probability,
+  // scaled by the global one when that is set.
+  double effectiveProb(size_t idx) {
+    double prob = callback_sampling_probs[idx];
+    if (is_callback_sampled[idx] && sampling_prop_set) {
+      prob *= sampling_prob;
+    }
+    return prob;
+  }
 
-  static double sample_zero_one() {
+  void updateSamplingConfig() {
+    max_effective_prob = 0.0;
+    for (size_t idx = 0; idx < start_callbacks.size(); ++idx) {
+      if (is_callback_sampled[idx]) {
+        max_effective_prob = std::max(max_effective_prob, effectiveProb(idx));
+      }
+    }
+    if (num_sampled_callbacks == 0) {
+      max_effective_prob = 1.0;
+    }
+    ++config_version;
+  }
+
+  struct SampleState {
+    uint64_t version = 0;
+    int64_t ops_until_hit = 0;
+  };
+
+  static SampleState& sample_state() {
+    static thread_local SampleState state;
+    return state;
+  }
+
+  static std::mt19937& gen() {
     static thread_local auto gen =
         torch::make_unique<std::mt19937>(std::random_device()());
+    return *gen;
+  }
+
+  static double sample_zero_one() {
     std::uniform_real_distribution<double> dist(0.0, 1.0);
-    return dist(*gen);
+    return dist(gen());
+  }
+
+  static int64_t sample_geometric(double prob) {
+    std::geometric_distribution<int64_t> dist(prob);
+    return dist(gen()) + 1;
   }
 };
 
@@ -116,9 +215,10 @@ void pushCallback(
     RecordFunctionCallback start,
     RecordFunctionCallback end,
     bool needs_inputs,
-    bool sampled) {
+    bool sampled,
+    double sampling_prob) {
   manager().pushCallback(
-      std::move(start), std::move(end), needs_inputs, sampled);
+      std::move(start), std::move(end), needs_inputs, sampled, sampling_prob);
 }
 
 void popCallback() {
@@ -138,6 +238,10 @@ bool hasNonSampledCallbacks() {
 }
 
 void RecordFunction::before(const char* name, int64_t sequence_nr) {
+  if (C10_UNLIKELY(c10::FlightRecorderEnabled())) {
+    c10::FlightRecord(c10::FlightEventType::OP_BEGIN, name);
+    flight_recorded_ = true;
+  }
   if (!hasCallbacks()) {
     return;
   }
@@ -150,6 +254,10 @@ void RecordFunction::before(const char* name, int64_t sequence_nr) {
 }
 
 void RecordFunction::before(std::string name, int64_t sequence_nr) {
+  if (C10_UNLIKELY(c10::FlightRecorderEnabled())) {
+    c10::FlightRecord(c10::FlightEventType::OP_BEGIN, name.c_str());
+    flight_recorded_ = true;
+  }
   if (!hasCallbacks()) {
     return;
   }
@@ -162,6 +270,10 @@ void RecordFunction::before(std::string name, int64_t sequence_nr) {
 }
 
 void RecordFunction::before(Node* fn, int64_t sequence_nr) {
+  if (C10_UNLIKELY(c10::FlightRecorderEnabled())) {
+    c10::FlightRecord(c10::FlightEventType::OP_BEGIN, fn->name().c_str());
+    flight_recorded_ = true;
+  }
   if (!hasCallbacks()) {
     return;
   }
@@ -177,10 +289,19 @@ void RecordFunction::before(Node* fn, int64_t sequence_nr) {
 void RecordFunction::processCallbacks() {
   parent_ = thread_local_func_;
   thread_local_func_ = this;
+  sampled_run_mask_ = 0;
 
   for (size_t idx = 0; idx < manager().start_callbacks.size(); ++idx) {
-    if (!manager().is_callback_sampled[idx] || run_sampled_) {
+    if (!manager().is_callback_sampled[idx]) {
       manager().start_callbacks[idx](*this);
+    } else if (run_sampled_) {
+      // Callbacks past the mask width fall back to the joint decision.
+      if (idx >= 64) {
+        manager().start_callbacks[idx](*this);
+      } else if (manager().shouldRunSampledCallback(idx)) {
+        sampled_run_mask_ |= (uint64_t(1) << idx);
+        manager().start_callbacks[idx](*this);
+      }
     }
   }
 }
@@ -190,9 +311,18 @@ RecordFunction::~RecordFunction() {
 }
 
 void RecordFunction::end() {
+  if (C10_UNLIKELY(flight_recorded_)) {
+    // Pairing with the begin is by LIFO nesting within the thread, so the
+    // name need not be repeated.
+    c10::FlightRecord(c10::FlightEventType::OP_END, "");
+    flight_recorded_ = false;
+  }
   if (initialized_) {
     for (size_t idx = 0; idx < manager().end_callbacks.size(); ++idx) {
-      if (!manager().is_callback_sampled[idx] || run_sampled_) {
+      const bool ran_start = !manager().is_callback_sampled[idx] ||
+          (run_sampled_ &&
+           (idx >= 64 || (sampled_run_mask_ & (uint64_t(1) << idx))));
+      if (ran_start) {
         manager().end_callbacks[idx](*this);
       }
     }
@@ -115,6 +115,13 @@ struct TORCH_API RecordFunction {
 
   bool initialized_ = false;
   bool run_sampled_ = false;
+  // Whether before() appended an OP_BEGIN to the flight recorder, so end()
+  // appends the matching OP_END exactly once.
+  bool flight_recorded_ = false;
+  // Which of the first 64 sampled callbacks actually ran in before(), so that
+  // end() invokes exactly the matching end callbacks when callbacks have
+  // per-callback sampling probabilities.
+  uint64_t sampled_run_mask_ = 0;
 };
 
 TORCH_API bool hasCallbacks();
@@ -143,12 +150,19 @@ TORCH_API bool shouldRunSampledCallbacks();
 
 // WARNING: all calls to pushCallback/popCallback are not thread safe and
 // must not overlap with other code execution
+//
+// `sampling_prob` is this callback's own sampling probability: it observes
+// roughly one in 1/sampling_prob ops, decided with a thread-local geometric
+// skip counter so the skipped ops cost little more than a decrement. A value
+// below 1.0 implies `sampled`; sampled callbacks are additionally subject to
+// the global probability set with setSamplingProbability().
 using RecordFunctionCallback = std::function<void(const RecordFunction&)>;
 TORCH_API void pushCallback(
     RecordFunctionCallback start,
     RecordFunctionCallback end = [](const RecordFunction&){},
     bool needs_inputs = false,
-    bool sampled = false);
+    bool sampled = false,
+    double sampling_prob = 1.0);
 TORCH_API void popCallback();
 
 } // namespace profiler
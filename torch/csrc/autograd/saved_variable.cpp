@@ -8,12 +8,31 @@
 #include <ATen/Tensor.h>
 
 #include <cstdint>
+#include <cstdlib>
 #include <list>
 #include <memory>
 #include <sstream>
 
 namespace torch { namespace autograd {
 
+namespace {
+size_t initialOffloadMinBytes() {
+  const char* env = std::getenv("PYTORCH_SAVED_VARIABLE_OFFLOAD_MIN_BYTES");
+  if (env) {
+    const long long parsed = atoll(env);
+    if (parsed > 0) {
+      return static_cast<size_t>(parsed);
+    }
+  }
+  return 0;
+}
+} // namespace
+
+std::atomic<size_t>& savedVariableOffloadMinBytes() {
+  static std::atomic<size_t> min_bytes{initialOffloadMinBytes()};
+  return min_bytes;
+}
+
 SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_inplace_view) {
   if (variable.defined()) {
     was_default_constructed_ = false;
@@ -24,6 +43,22 @@ SavedVariable::SavedVariable(const Variable& variable, bool is_output, bool is_i
     // These copies are all shared_ptr copies, so slightly more expensive.
     // Do them here instead of in the init list in case data is undefined.
     data_ = variable.tensor_data();
+    const size_t offload_min_bytes = savedVariableOffloadMinBytes().load();
+    if (offload_min_bytes > 0 && !data_.device().is_cpu() &&
+        !data_.is_sparse() &&
+        static_cast<size_t>(data_.numel()) * data_.dtype().itemsize() >=
+            offload_min_bytes) {
+      // Stage the snapshot to pinned host memory. The copy is asynchronous
+      // with respect to the host; the producing stream orders it after the
+      // kernels that wrote the tensor, and the device memory is released for
+      // the remainder of forward.
+      original_device_ = data_.device();
+      auto host = at::empty(
+          data_.sizes(), data_.options().device(at::kCPU).pinned_memory(true));
+      host.copy_(data_, /*non_blocking=*/true);
+      data_ = std::move(host);
+      offloaded_ = true;
+    }
     if (variable.is_leaf()) {
       grad_accumulator_ = variable.grad_accumulator();
     } else if (!is_output) {
@@ -78,14 +113,23 @@ Variable SavedVariable::unpack(std::shared_ptr<Node> saved_for) const {
     throw std::runtime_error(message.str());
   }
 
+  auto data = data_;
+  if (offloaded_) {
+    // Bring the staged snapshot back to its original device. The copy is
+    // enqueued on the current stream ahead of the consumer that unpacked us,
+    // which orders the compute after it without blocking the host.
+    data = data.to(data.options().device(original_device_),
+                   /*non_blocking=*/true);
+  }
+
   // NB: saved views are unpacked as normal Variables (not views) even though
   // they still share the same storage. This works only because we never call
   // in-place functions on unpacked variables.
   Variable var;
   if (grad_fn) {
-    var = make_variable(data_, Edge(std::move(grad_fn), output_nr_));
+    var = make_variable(data, Edge(std::move(grad_fn), output_nr_));
   } else {
-    var = make_variable(data_, requires_grad_);
+    var = make_variable(data, requires_grad_);
   }
   var.set_version_counter(saved_version_);
 
@@ -4,6 +4,7 @@
 
 #include <ATen/ATen.h>
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
@@ -14,6 +15,13 @@ struct Node;
 
 TORCH_API extern const char* ERR_BACKWARD_TWICE;
 
+/// Minimum size in bytes at which saved non-CPU tensors are staged to pinned
+/// host memory after forward and copied back to their device when unpacked
+/// during backward, trading PCIe traffic for activation memory. 0 disables
+/// offloading (the default). Initialized from the
+/// PYTORCH_SAVED_VARIABLE_OFFLOAD_MIN_BYTES environment variable.
+TORCH_API std::atomic<size_t>& savedVariableOffloadMinBytes();
+
 /// A snapshot of a variable at a certain version. A `SavedVariable` stores
 /// enough information to reconstruct a variable from a certain point in time.
 class TORCH_API SavedVariable {
@@ -39,6 +47,11 @@ class TORCH_API SavedVariable {
  private:
   at::Tensor data_;
 
+  // Set when data_ has been staged to pinned host memory; remembers where to
+  // copy it back to in unpack().
+  bool offloaded_ = false;
+  at::Device original_device_ = at::kCPU;
+
   // The gradient function associated with this node. If has_grad_fn
   // is false, then this is a leaf node. Note that the grad_fn is not saved if
   // it would create a circular reference. In that case, the grad_fn must be
@@ -83,7 +83,23 @@ PyObject* c10d_init(PyObject* _unused) {
           [](::c10d::Reducer& reducer, const torch::autograd::Variable& output)
               -> void { reducer.prepare_for_backward({output}); },
           py::call_guard<py::gil_scoped_release>())
-      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats);
+      .def("get_backward_stats", &::c10d::Reducer::get_backward_stats)
+      .def(
+          "enable_bucket_autotuning",
+          &::c10d::Reducer::enable_bucket_autotuning,
+          py::call_guard<py::gil_scoped_release>())
+      .def("get_bucket_assignment", &::c10d::Reducer::get_bucket_assignment)
+      .def(
+          "enable_sparse_to_dense_conversion",
+          &::c10d::Reducer::enable_sparse_to_dense_conversion,
+          py::call_guard<py::gil_scoped_release>())
+      .def(
+          "register_fp16_compression_hook",
+          [](::c10d::Reducer& reducer) {
+            reducer.register_comm_hook(std::unique_ptr<::c10d::CommHook>(
+                new ::c10d::FP16CompressHook()));
+          },
+          py::call_guard<py::gil_scoped_release>());
 
   py::enum_<::c10d::ReduceOp>(module, "ReduceOp", R"(
 An enum-like class for available reduction operations: ``SUM``, ``PRODUCT``,
@@ -209,6 +225,31 @@ They are used in specifying strategies for reduction collectives, e.g.,
           .def("rank", &::c10d::ProcessGroup::getRank)
           .def("size", &::c10d::ProcessGroup::getSize)
 
+          .def(
+              "_set_collective_profiling",
+              &::c10d::ProcessGroup::setCollectiveProfiling,
+              py::arg("enable"))
+
+          .def(
+              "_get_collective_stats",
+              [](::c10d::ProcessGroup& pg) {
+                py::list result;
+                for (const auto& stats : pg.getCollectiveStats()) {
+                  py::dict entry;
+                  entry["op_type"] = stats.opType;
+                  entry["count"] = stats.count;
+                  entry["total_bytes"] = stats.totalBytes;
+                  entry["total_time_ms"] = stats.totalTimeMs;
+                  entry["size_histogram"] = stats.sizeHistogram;
+                  result.append(entry);
+                }
+                return result;
+              })
+
+          .def(
+              "_reset_collective_stats",
+              &::c10d::ProcessGroup::resetCollectiveStats)
+
           .def(
               "broadcast",
               &::c10d::ProcessGroup::broadcast,
@@ -1,7 +1,9 @@
 #include <torch/csrc/distributed/c10d/reducer.h>
 
+#include <algorithm>
 #include <functional>
 
+#include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/autograd/engine.h>
 #include <torch/csrc/autograd/function_hook.h>
@@ -38,6 +40,28 @@ inline int64_t current_time_in_nanos() {
 
 } // namespace
 
+CommHook::~CommHook() = default;
+
+std::vector<at::Tensor> FP16CompressHook::compress(
+    const std::vector<at::Tensor>& tensors) {
+  std::vector<at::Tensor> compressed;
+  compressed.reserve(tensors.size());
+  for (const auto& tensor : tensors) {
+    compressed.push_back(tensor.to(at::kHalf));
+  }
+  return compressed;
+}
+
+void FP16CompressHook::decompress(
+    const std::vector<at::Tensor>& reduced,
+    std::vector<at::Tensor>& tensors) {
+  AT_ASSERT(reduced.size() == tensors.size());
+  for (size_t i = 0; i < tensors.size(); i++) {
+    // copy_ casts back up to the bucket's full precision.
+    tensors[i].copy_(reduced[i]);
+  }
+}
+
 Reducer::Reducer(
     std::vector<std::vector<torch::autograd::Variable>> replicas,
     std::vector<std::vector<size_t>> bucket_indices,
@@ -50,7 +74,9 @@ Reducer::Reducer(
       require_finalize_(false),
       next_bucket_(0),
       has_marked_unused_parameters_(false),
-      backward_stats_base_(0) {
+      backward_stats_base_(0),
+      autotune_iterations_remaining_(0),
+      autotune_iterations_total_(0) {
   AT_ASSERTM(replicas_.size() >= 1, "Expected at least one model replica.");
   AT_ASSERTM(replicas_[0].size() >= 1, "Expected at least one parameter.");
 
@@ -228,6 +254,25 @@ void Reducer::mark_variable_ready_sparse(VariableIndex index) {
   // in a single reduction operation like we can for dense tensors.
   // Therefore, the `offsets` and `lengths` vectors in the bucket replica
   // struct are empty, and there is no pre-existing accumulation tensor.
+  if (convert_sparse_to_dense_) {
+    // Materializing a large embedding gradient as a dense tensor is
+    // expensive; run the conversion on an inter-op worker so it overlaps
+    // with the allreduces of dense buckets already in flight.
+    // `mark_bucket_ready` collects the result when this bucket's turn in
+    // the reduction order comes, by which time the conversion has
+    // typically finished. The task also applies the world-size prescaling
+    // that `mark_variable_ready` would otherwise apply to `contents`,
+    // which are not materialized yet at that point.
+    const auto div_factor = process_group_->getSize();
+    at::Tensor sparse_grad = grad;
+    auto task = std::make_shared<std::packaged_task<at::Tensor()>>(
+        [sparse_grad, div_factor] {
+          return sparse_grad.to_dense().div_(div_factor);
+        });
+    bucket.sparse_dense_futures[replica_index] = task->get_future();
+    at::launch([task] { (*task)(); });
+    return;
+  }
   // Directly assign the sparse tensor to the `contents` field.
   replica.contents = grad;
 }
@@ -319,7 +364,11 @@ void Reducer::mark_variable_ready(VariableIndex index) {
   // Check if this was the final gradient for this bucket.
   if (--replica.pending == 0) {
     // Prescale bucket contents to turn the global sum into the global average.
-    replica.contents.div_(process_group_->getSize());
+    // Asynchronously converted sparse gradients are prescaled by their
+    // conversion task instead, since `contents` is not materialized yet.
+    if (!(bucket.expect_sparse_gradient && convert_sparse_to_dense_)) {
+      replica.contents.div_(process_group_->getSize());
+    }
     // Kick off reduction if all replicas for this bucket are ready.
     if (--bucket.pending == 0) {
       mark_bucket_ready(bucket_index.bucket_index);
@@ -351,6 +400,14 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
   for (; next_bucket_ < buckets_.size() && buckets_[next_bucket_].pending == 0;
        next_bucket_++) {
     auto& bucket = buckets_[next_bucket_];
+    if (bucket.expect_sparse_gradient && convert_sparse_to_dense_) {
+      // Collect the asynchronously converted dense gradients. This only
+      // blocks if a conversion is still running, i.e. when there was no
+      // dense reduction left to overlap it with.
+      for (size_t i = 0; i < bucket.replicas.size(); i++) {
+        bucket.replicas[i].contents = bucket.sparse_dense_futures[i].get();
+      }
+    }
     std::vector<at::Tensor> tensors;
     tensors.reserve(bucket.replicas.size());
     for (const auto& replica : bucket.replicas) {
@@ -365,7 +422,14 @@ void Reducer::mark_bucket_ready(size_t bucket_index) {
       //
       tensors.push_back(replica.contents);
     }
-    bucket.work = process_group_->allreduce(tensors);
+    bucket.allreduce_start_time = current_time_in_nanos();
+    if (comm_hook_ != nullptr && !bucket.expect_sparse_gradient) {
+      bucket.comm_tensors = comm_hook_->compress(tensors);
+      bucket.work = process_group_->allreduce(bucket.comm_tensors);
+    } else {
+      bucket.comm_tensors.clear();
+      bucket.work = process_group_->allreduce(tensors);
+    }
   }
 }
 
@@ -378,6 +442,13 @@ void Reducer::initialize_buckets(
       !expect_autograd_hooks_,
       "`initialize_buckets` must NOT be called during autograd execution.");
 
+  assign_buckets(std::move(bucket_indices));
+}
+
+void Reducer::assign_buckets(std::vector<std::vector<size_t>> bucket_indices) {
+  // Keep a copy of the assignment around for inspection.
+  bucket_indices_ = bucket_indices;
+
   // Clear current bucket assignment.
   buckets_.clear();
   variable_locators_.clear();
@@ -461,6 +532,12 @@ void Reducer::initialize_buckets(
       bucket.replicas.push_back(std::move(replica));
     }
 
+    // One conversion future slot per replica; the slots are overwritten
+    // every backward pass when sparse-to-dense conversion is enabled.
+    if (bucket.expect_sparse_gradient) {
+      bucket.sparse_dense_futures.resize(bucket.replicas.size());
+    }
+
     // Map participating variables to this bucket.
     // This is identical across replicas so we only need to do this once.
     size_t intra_bucket_index = 0;
@@ -593,6 +670,17 @@ void Reducer::finalize_bucket_dense(Bucket& bucket) {
 // A bucket with a single sparse tensor doesn't need to be unflattened,
 // but merely assigned to the corresponding variable its grad.
 void Reducer::finalize_bucket_sparse(Bucket& bucket) {
+  if (convert_sparse_to_dense_) {
+    // The bucket was allreduced as the dense conversion of the sparse
+    // gradient, which has the variable's shape already; hand the reduced
+    // dense tensor to the variable so it is directly optimizer-ready.
+    for (auto& replica : bucket.replicas) {
+      AT_ASSERT(replica.variables.size() == 1);
+      replica.variables.front().grad() = replica.contents;
+      replica.contents.reset();
+    }
+    return;
+  }
   const auto result = bucket.work->result();
   AT_ASSERT(bucket.replicas.size() == result.size());
   for (size_t i = 0; i < bucket.replicas.size(); i++) {
@@ -619,12 +707,226 @@ void Reducer::finalize_backward() {
   for (auto& bucket : buckets_) {
     AT_ASSERT(bucket.work);
     bucket.work->wait();
+    if (!bucket.comm_tensors.empty()) {
+      // A communication hook produced the tensors that were reduced; copy
+      // the result back into the full-precision bucket contents before
+      // unflattening them into the gradients.
+      std::vector<at::Tensor> tensors;
+      tensors.reserve(bucket.replicas.size());
+      for (const auto& replica : bucket.replicas) {
+        tensors.push_back(replica.contents);
+      }
+      comm_hook_->decompress(bucket.comm_tensors, tensors);
+      bucket.comm_tensors.clear();
+    }
+    if (autotune_iterations_remaining_ > 0 && !bucket.expect_sparse_gradient) {
+      // Record a (bytes, latency) sample for this bucket's allreduce. The
+      // latency is observed from the host after `wait` returns, so earlier
+      // buckets (waited on first) give the tightest samples; the linear fit
+      // below averages out the slack on the later ones.
+      const auto& contents = bucket.replicas[0].contents;
+      comm_bytes_samples_.push_back(
+          static_cast<double>(contents.numel() * contents.element_size()));
+      comm_time_samples_.push_back(static_cast<double>(
+          current_time_in_nanos() - bucket.allreduce_start_time));
+    }
     if (bucket.expect_sparse_gradient) {
       finalize_bucket_sparse(bucket);
     } else {
       finalize_bucket_dense(bucket);
     }
   }
+
+  // If auto-tuning is active, fold in this iteration's gradient arrival
+  // times, and rebuild the buckets once the last tuning iteration is done.
+  // It is safe to do this here: autograd hooks are no longer expected and
+  // all outstanding reductions have completed.
+  if (autotune_iterations_remaining_ > 0) {
+    for (size_t i = 0; i < backward_stats_[0].size(); i++) {
+      arrival_time_sums_[i] += static_cast<double>(backward_stats_[0][i]);
+    }
+    if (--autotune_iterations_remaining_ == 0) {
+      assign_buckets(compute_tuned_bucket_assignment());
+    }
+  }
+}
+
+void Reducer::register_comm_hook(std::unique_ptr<CommHook> hook) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AT_ASSERTM(
+      !expect_autograd_hooks_,
+      "`register_comm_hook` must NOT be called during autograd execution.");
+  comm_hook_ = std::move(hook);
+}
+
+void Reducer::enable_sparse_to_dense_conversion() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AT_ASSERTM(
+      !expect_autograd_hooks_,
+      "`enable_sparse_to_dense_conversion` must NOT be called ",
+      "during autograd execution.");
+  convert_sparse_to_dense_ = true;
+}
+
+void Reducer::enable_bucket_autotuning(size_t num_iterations) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  AT_ASSERTM(
+      num_iterations > 0, "Expected a positive number of tuning iterations.");
+  AT_ASSERTM(
+      !expect_autograd_hooks_,
+      "`enable_bucket_autotuning` must NOT be called during autograd execution.");
+  autotune_iterations_remaining_ = num_iterations;
+  autotune_iterations_total_ = num_iterations;
+  arrival_time_sums_.assign(replicas_[0].size(), 0.0);
+  comm_bytes_samples_.clear();
+  comm_time_samples_.clear();
+}
+
+std::vector<std::vector<size_t>> Reducer::compute_tuned_bucket_assignment() {
+  const auto variable_count = replicas_[0].size();
+  const auto sample_count = comm_time_samples_.size();
+
+  // Average the measurements across processes. Every process must arrive at
+  // the identical bucket assignment or the allreduce calls won't line up,
+  // and arrival times and latencies differ per process. The sample layout is
+  // identical everywhere (same bucket assignment, same number of tuning
+  // iterations), so a single summing allreduce followed by a division by the
+  // world size does the job. The stats tensor lives on the same device as
+  // the parameters so that any process group backend can reduce it.
+  {
+    auto stats = at::empty(
+        {static_cast<int64_t>(variable_count + sample_count)}, at::kDouble);
+    auto* data = stats.data_ptr<double>();
+    std::copy(arrival_time_sums_.begin(), arrival_time_sums_.end(), data);
+    std::copy(
+        comm_time_samples_.begin(),
+        comm_time_samples_.end(),
+        data + variable_count);
+    stats = stats.to(replicas_[0][0].device());
+    std::vector<at::Tensor> tensors = {stats};
+    process_group_->allreduce(tensors)->wait();
+    stats = tensors[0].to(at::kCPU).div(process_group_->getSize());
+    data = stats.data_ptr<double>();
+    std::copy(data, data + variable_count, arrival_time_sums_.begin());
+    std::copy(
+        data + variable_count,
+        data + variable_count + sample_count,
+        comm_time_samples_.begin());
+  }
+
+  // Turn the accumulated arrival times into per-iteration averages so they
+  // are on the same scale as the (single allreduce) latency samples.
+  for (auto& sum : arrival_time_sums_) {
+    sum /= static_cast<double>(autotune_iterations_total_);
+  }
+
+  // Fit latency(bytes) = alpha + beta * bytes to the allreduce samples by
+  // least squares; alpha captures the fixed per-allreduce overhead (large on
+  // high-latency interconnects) and beta the per-byte cost.
+  double alpha = 0.0;
+  double beta = 0.0;
+  {
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+    for (size_t i = 0; i < sample_count; i++) {
+      sum_x += comm_bytes_samples_[i];
+      sum_y += comm_time_samples_[i];
+      sum_xx += comm_bytes_samples_[i] * comm_bytes_samples_[i];
+      sum_xy += comm_bytes_samples_[i] * comm_time_samples_[i];
+    }
+    const auto n = static_cast<double>(sample_count);
+    const double denominator = n * sum_xx - sum_x * sum_x;
+    if (denominator > 0.0) {
+      beta = (n * sum_xy - sum_x * sum_y) / denominator;
+      alpha = (sum_y - beta * sum_x) / n;
+    }
+    if (beta <= 0.0 && sum_x > 0.0) {
+      // Degenerate fit (e.g. all buckets the same size); fall back to a
+      // pure bandwidth model.
+      beta = sum_y / sum_x;
+      alpha = 0.0;
+    }
+  }
+
+  // Order variables by average gradient arrival time; this is the order in
+  // which buckets can fill up during backward.
+  std::vector<size_t> order(variable_count);
+  for (size_t i = 0; i < variable_count; i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return arrival_time_sums_[a] < arrival_time_sums_[b];
+  });
+
+  // Packs the variables, in arrival order, into buckets of at most
+  // `bytes_cap` bytes. Buckets cannot span dtypes or devices, and variables
+  // that expect a sparse gradient keep their own bucket.
+  const auto& variables = replicas_[0];
+  auto pack = [&](double bytes_cap) {
+    std::vector<std::vector<size_t>> assignment;
+    std::vector<size_t> current;
+    double current_bytes = 0.0;
+    auto flush = [&] {
+      if (!current.empty()) {
+        assignment.emplace_back(std::move(current));
+        current.clear();
+        current_bytes = 0.0;
+      }
+    };
+    for (const auto variable_index : order) {
+      if (expect_sparse_gradients_[0][variable_index]) {
+        flush();
+        assignment.push_back({variable_index});
+        continue;
+      }
+      const auto& variable = variables[variable_index];
+      const double bytes =
+          static_cast<double>(variable.numel() * variable.element_size());
+      const bool same_key = current.empty() ||
+          (variables[current.front()].scalar_type() == variable.scalar_type() &&
+           variables[current.front()].device() == variable.device());
+      if (!same_key || (current_bytes > 0.0 && current_bytes + bytes > bytes_cap)) {
+        flush();
+      }
+      current.push_back(variable_index);
+      current_bytes += bytes;
+    }
+    flush();
+    return assignment;
+  };
+
+  // Estimated wall time of a backward pass under a given assignment:
+  // a bucket is ready when its last gradient arrives, and the reductions
+  // execute in sequence on the interconnect.
+  auto simulate = [&](const std::vector<std::vector<size_t>>& assignment) {
+    double comm_end = 0.0;
+    for (const auto& bucket : assignment) {
+      double ready = 0.0;
+      double bytes = 0.0;
+      for (const auto variable_index : bucket) {
+        ready = std::max(ready, arrival_time_sums_[variable_index]);
+        bytes += static_cast<double>(
+            variables[variable_index].numel() *
+            variables[variable_index].element_size());
+      }
+      comm_end = std::max(comm_end, ready) + alpha + beta * bytes;
+    }
+    return comm_end;
+  };
+
+  // Try power-of-two bucket-size caps from 256KiB to 256MiB and keep the one
+  // whose simulated backward pass finishes first.
+  std::vector<std::vector<size_t>> best_assignment;
+  double best_time = 0.0;
+  for (double cap = 256.0 * 1024.0; cap <= 256.0 * 1024.0 * 1024.0;
+       cap *= 2.0) {
+    auto assignment = pack(cap);
+    const auto time = simulate(assignment);
+    if (best_assignment.empty() || time < best_time) {
+      best_assignment = std::move(assignment);
+      best_time = time;
+    }
+  }
+  return best_assignment;
 }
 
 namespace {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <tuple>
@@ -13,6 +14,41 @@
 
 namespace c10d {
 
+// A communication hook intercepts the reduction of a dense bucket. Instead
+// of allreducing the full-precision bucket contents directly, the reducer
+// hands them to `compress`, allreduces whatever that returns, and calls
+// `decompress` with the reduced result once the allreduce has completed.
+// Custom schemes (e.g. PowerSGD) implement this interface; fp16 compression
+// is provided as a built-in (see `FP16CompressHook`).
+class CommHook {
+ public:
+  virtual ~CommHook();
+
+  // Maps the full-precision bucket tensors (one per model replica) to the
+  // tensors that are handed to the allreduce.
+  virtual std::vector<at::Tensor> compress(
+      const std::vector<at::Tensor>& tensors) = 0;
+
+  // Copies the reduced result back into the full-precision bucket tensors.
+  virtual void decompress(
+      const std::vector<at::Tensor>& reduced,
+      std::vector<at::Tensor>& tensors) = 0;
+};
+
+// Built-in communication hook that halves gradient bytes on the wire:
+// buckets are cast to half precision for the allreduce and the reduced
+// result is cast back into the full-precision bucket, so accumulation into
+// `.grad` stays at master precision.
+class FP16CompressHook : public CommHook {
+ public:
+  std::vector<at::Tensor> compress(
+      const std::vector<at::Tensor>& tensors) override;
+
+  void decompress(
+      const std::vector<at::Tensor>& reduced,
+      std::vector<at::Tensor>& tensors) override;
+};
+
 class Reducer {
  public:
   // The constructor takes a list of variables for every model replica.
@@ -47,6 +83,39 @@ class Reducer {
     return backward_stats_;
   }
 
+  // Enables bucket-size auto-tuning. For the next `num_iterations` backward
+  // passes the reducer measures per-bucket allreduce latency and the time at
+  // which every gradient becomes ready, then rebuilds the buckets to maximize
+  // overlap of gradient computation and reduction. The measurements are
+  // averaged across processes so that every process arrives at the identical
+  // assignment. Must be called between iterations.
+  void enable_bucket_autotuning(size_t num_iterations);
+
+  // Returns the current bucket assignment, in the same format as the
+  // `bucket_indices` constructor argument. Useful to inspect the layout
+  // chosen by auto-tuning.
+  std::vector<std::vector<size_t>> get_bucket_assignment() const {
+    return bucket_indices_;
+  }
+
+  // Installs a communication hook that intercepts the reduction of every
+  // dense bucket; pass nullptr to restore the plain allreduce. Buckets with
+  // sparse gradients always use the plain allreduce. Must be called between
+  // iterations.
+  void register_comm_hook(std::unique_ptr<CommHook> hook);
+
+  // Enables the pipelined sparse-to-dense gradient stage. Sparse gradients
+  // (e.g. embeddings with sparse=True) are materialized as dense tensors on
+  // an inter-op worker thread as soon as they become ready, overlapping the
+  // conversion with the allreduces of dense buckets already in flight, and
+  // are then allreduced as dense tensors at their usual position in the
+  // bucket order (so the collective call sequence stays identical across
+  // processes). The reduced dense tensor becomes the variable's `.grad`.
+  // This removes the end-of-backward conversion bubble and also makes
+  // sparse gradients work with backends that lack a sparse allreduce.
+  // Must be called between iterations.
+  void enable_sparse_to_dense_conversion();
+
  protected:
   // Forward declaration.
   struct Bucket;
@@ -91,6 +160,13 @@ class Reducer {
 
   void finalize_backward();
 
+  // The body of `initialize_buckets`; requires the caller to hold `mutex_`.
+  void assign_buckets(std::vector<std::vector<size_t>> bucket_indices);
+
+  // Computes a new bucket assignment from the statistics gathered while
+  // auto-tuning was active; requires the caller to hold `mutex_`.
+  std::vector<std::vector<size_t>> compute_tuned_bucket_assignment();
+
   // A bucket replica represents [1..N] gradients to be reduced,
   // with the same dtype, on the same device.
   //
@@ -140,9 +216,25 @@ class Reducer {
     // Keep work handle around when this set of buckets is being reduced.
     std::shared_ptr<c10d::ProcessGroup::Work> work;
 
+    // Time the allreduce for this bucket was kicked off; used by
+    // bucket-size auto-tuning to measure per-bucket allreduce latency.
+    int64_t allreduce_start_time = 0;
+
+    // The tensors handed to the allreduce when a communication hook is
+    // installed (e.g. the half-precision copy of `contents`). Empty when
+    // this bucket was reduced without a hook.
+    std::vector<at::Tensor> comm_tensors;
+
     // If this bucket should expect a single sparse gradient.
     // Implies: replicas[i].variables.size() == 1.
     bool expect_sparse_gradient = false;
+
+    // Futures for the asynchronous sparse-to-dense conversion of this
+    // bucket's gradient, one per replica. Only populated when
+    // `expect_sparse_gradient` is set and sparse-to-dense conversion is
+    // enabled; consumed by `mark_bucket_ready` when this bucket's turn in
+    // the reduction order comes.
+    std::vector<std::future<at::Tensor>> sparse_dense_futures;
   };
 
   std::vector<Bucket> buckets_;
@@ -166,6 +258,27 @@ class Reducer {
   // the point in time buckets were ready, or ideal bucket assignment/ordering.
   int64_t backward_stats_base_;
   std::vector<std::vector<int64_t>> backward_stats_;
+
+  // The bucket assignment currently in effect, in the `bucket_indices`
+  // constructor argument format.
+  std::vector<std::vector<size_t>> bucket_indices_;
+
+  // Bucket-size auto-tuning state. While `autotune_iterations_remaining_`
+  // is nonzero, `finalize_backward` accumulates per-variable gradient
+  // arrival times and (bytes, latency) samples for every bucket allreduce,
+  // and rebuilds the buckets once the last tuning iteration completes.
+  size_t autotune_iterations_remaining_;
+  size_t autotune_iterations_total_;
+  std::vector<double> arrival_time_sums_;
+  std::vector<double> comm_bytes_samples_;
+  std::vector<double> comm_time_samples_;
+
+  // Optional communication hook applied to dense buckets.
+  std::unique_ptr<CommHook> comm_hook_;
+
+  // Whether sparse gradients are asynchronously converted to dense tensors
+  // and reduced as such (see `enable_sparse_to_dense_conversion`).
+  bool convert_sparse_to_dense_ = false;
 };
 
 std::vector<std::vector<size_t>> compute_bucket_assignment_by_size(
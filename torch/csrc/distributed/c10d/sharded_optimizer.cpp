@@ -0,0 +1,96 @@
+#include <torch/csrc/distributed/c10d/sharded_optimizer.h>
+
+#include <ATen/core/grad_mode.h>
+
+namespace c10d {
+
+ShardedOptimizer::ShardedOptimizer(
+    std::vector<torch::autograd::Variable> parameters,
+    std::shared_ptr<c10d::ProcessGroup> process_group,
+    OptimizerFactory factory)
+    : parameters_(std::move(parameters)),
+      process_group_(std::move(process_group)) {
+  TORCH_CHECK(!parameters_.empty(), "Expected at least one parameter.");
+
+  const auto& first = parameters_[0];
+  int64_t total_numel = 0;
+  for (const auto& param : parameters_) {
+    TORCH_CHECK(param.defined(), "Expected all parameters to be defined.");
+    TORCH_CHECK(
+        param.layout() == at::kStrided,
+        "Sharded optimization only supports dense parameters.");
+    TORCH_CHECK(
+        param.device() == first.device() &&
+            param.scalar_type() == first.scalar_type(),
+        "Expected all parameters to share a device and dtype, ",
+        "since they are packed into a single flat buffer.");
+    total_numel += param.numel();
+  }
+
+  const auto world_size = process_group_->getSize();
+  const auto rank = process_group_->getRank();
+  shard_numel_ = (total_numel + world_size - 1) / world_size;
+
+  // The flat buffers and the shard views must not be entangled with
+  // autograd; the optimizer updates them in place.
+  at::AutoGradMode grad_mode(false);
+  flat_params_ = at::zeros({shard_numel_ * world_size}, first.options());
+  flat_grads_ = at::zeros({shard_numel_ * world_size}, first.options());
+
+  int64_t offset = 0;
+  for (const auto& param : parameters_) {
+    flat_params_.narrow(0, offset, param.numel())
+        .copy_(param.contiguous().view({-1}));
+    offset += param.numel();
+  }
+
+  shard_param_ = flat_params_.narrow(0, rank * shard_numel_, shard_numel_);
+  shard_param_.grad() = flat_grads_.narrow(0, rank * shard_numel_, shard_numel_);
+
+  local_optimizer_ = factory({shard_param_});
+  TORCH_CHECK(
+      local_optimizer_ != nullptr, "Optimizer factory returned nullptr.");
+}
+
+void ShardedOptimizer::step() {
+  at::AutoGradMode grad_mode(false);
+
+  // Fill the flat gradient buffer, so that this rank's gradient shard (the
+  // `.grad` of its parameter shard) is up to date. Parameters without a
+  // gradient contribute zero. The gradients are expected to already be
+  // averaged across processes.
+  int64_t offset = 0;
+  for (const auto& param : parameters_) {
+    auto region = flat_grads_.narrow(0, offset, param.numel());
+    if (param.grad().defined()) {
+      region.copy_(param.grad().contiguous().view({-1}));
+    } else {
+      region.zero_();
+    }
+    offset += param.numel();
+  }
+
+  local_optimizer_->step();
+
+  // Exchange the updated shards; a single allgather writes every rank's
+  // shard into its slice of the flat parameter buffer.
+  const auto world_size = process_group_->getSize();
+  std::vector<std::vector<at::Tensor>> outputs(1);
+  outputs[0].reserve(world_size);
+  for (int r = 0; r < world_size; ++r) {
+    outputs[0].push_back(
+        flat_params_.narrow(0, r * shard_numel_, shard_numel_));
+  }
+  std::vector<at::Tensor> input = {shard_param_};
+  process_group_->allgather(outputs, input)->wait();
+
+  // Unflatten the updated parameters back into the model.
+  offset = 0;
+  for (auto& param : parameters_) {
+    param.copy_(
+        flat_params_.narrow(0, offset, param.numel()).view(param.sizes()));
+    offset += param.numel();
+  }
+}
+
+} // namespace c10d
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <c10d/ProcessGroup.hpp>
+#include <torch/csrc/autograd/variable.h>
+#include <torch/optim/optimizer.h>
+
+namespace c10d {
+
+// Shards optimizer state across the processes of a process group
+// (ZeRO stage 1). The parameters are laid out in a flat buffer that is
+// split into equally sized contiguous shards, one per rank. Each rank
+// wraps only its own shard in a local optimizer, so per-parameter
+// optimizer state (e.g. the two Adam moments) is allocated for 1/world_size
+// of the parameters instead of all of them. After every local step the
+// shards are exchanged with a single allgather and copied back into the
+// model parameters, so all ranks observe identical updated parameters.
+//
+// Gradients are expected to be averaged across processes before `step` is
+// called, e.g. by the `Reducer`. The parameters must all be dense and live
+// on the same device with the same dtype, as they share one flat buffer.
+class ShardedOptimizer {
+ public:
+  // Constructs the local optimizer over the shard this rank owns. The
+  // factory receives a single-element parameter list (the contiguous
+  // shard) and returns the optimizer to run on it.
+  using OptimizerFactory = std::function<std::unique_ptr<torch::optim::Optimizer>(
+      std::vector<at::Tensor>)>;
+
+  ShardedOptimizer(
+      std::vector<torch::autograd::Variable> parameters,
+      std::shared_ptr<c10d::ProcessGroup> process_group,
+      OptimizerFactory factory);
+
+  // Copies the parameter gradients into this rank's gradient shard, runs
+  // the local optimizer on the shard, allgathers the updated shards, and
+  // copies the result back into the model parameters.
+  void step();
+
+  // The contiguous slice of the flat parameter space this rank owns.
+  const at::Tensor& shard() const {
+    return shard_param_;
+  }
+
+  // The optimizer running on this rank's shard, e.g. to adjust options
+  // or serialize this rank's slice of the optimizer state.
+  torch::optim::Optimizer& local_optimizer() {
+    return *local_optimizer_;
+  }
+
+ private:
+  std::vector<torch::autograd::Variable> parameters_;
+  std::shared_ptr<c10d::ProcessGroup> process_group_;
+
+  // Number of elements per shard; the flat buffers hold
+  // `shard_numel_ * world_size` elements, zero-padded at the tail.
+  int64_t shard_numel_;
+  at::Tensor flat_params_;
+  at::Tensor flat_grads_;
+
+  // Views into the flat buffers covering this rank's shard. The gradient
+  // shard is installed as `.grad` of the parameter shard so the local
+  // optimizer picks it up.
+  torch::autograd::Variable shard_param_;
+
+  std::unique_ptr<torch::optim::Optimizer> local_optimizer_;
+};
+
+} // namespace c10d
@@ -2,18 +2,214 @@
 
 #include <c10/util/C++17.h>
 #include <c10d/ProcessGroup.hpp>
+#include <libshm.h>
 #include <torch/csrc/distributed/rpc/request_callback_impl.h>
 
 #include <Python.h>
 
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <random>
+
 namespace torch {
 namespace distributed {
 namespace rpc {
 
 namespace {
 
-// Write the message into the given ostream
-std::string serialize(const Message& message) {
+// Note [Same-host fast path]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// When caller and callee live on the same host, serializing tensor data
+// into the wire payload is wasted work: the bytes are copied into the
+// payload, pushed through the ProcessGroup transport, and copied out again
+// on the other side. Instead, large CPU tensors destined for a same-host
+// peer are copied once into a libshm segment (the same managed shared
+// memory used by torch.multiprocessing), replaced by empty placeholders in
+// the serialized tensor table, and described in a small manifest that is
+// appended to the payload. The receiver attaches the segments by name and
+// wraps them in tensors without copying.
+//
+// The sender must keep its segments mapped until the receiver has attached
+// them, because the shared memory manager frees a segment once no process
+// holds it. The receiver therefore sends a one-byte acknowledgement (on a
+// dedicated channel tag, so it cannot be confused with regular traffic)
+// after attaching, and the sending thread blocks on it before releasing
+// its mappings.
+
+// Tensors smaller than this travel in the serialized payload even between
+// same-host peers; a shared memory segment costs a few syscalls and is not
+// worth it for small tensors.
+constexpr size_t kShmMinTensorBytes = 64 * 1024;
+
+// Note [Small message coalescing]
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Control-plane RPC traffic consists of large numbers of tiny messages,
+// and each one pays the full per-send overhead of the ProcessGroup
+// transport: a preamble send, a payload send, and a tag match on the
+// receiving side. Instead of sending small messages one by one, the agent
+// appends them to a per-destination batch buffer, and a dedicated thread
+// flushes each batch as a single wire transfer once the batch has either
+// grown past kCoalesceMaxBatchBytes or aged past kCoalesceFlushWindow,
+// whichever comes first. The flush window bounds the extra latency a
+// batched message can incur.
+//
+// On the wire, a batch is a preamble whose type field holds the reserved
+// value kCoalescedBatchWireType, followed by a payload made of frames;
+// each frame carries the message type, the length of the serialized
+// message, and its bytes. The listen loop splits the frames back into
+// individual RecvWork items, so nothing above this framing layer changes.
+// Messages larger than kCoalesceMaxMessageBytes gain little from batching
+// and keep the direct path, as do shutdown messages and messages carrying
+// a shared memory manifest (whose acknowledgement protocol requires a
+// dedicated transfer; see Note [Same-host fast path]).
+
+// Serialized messages up to this size are eligible for coalescing.
+constexpr size_t kCoalesceMaxMessageBytes = 16 * 1024;
+// A batch is flushed as soon as it grows past this size.
+constexpr size_t kCoalesceMaxBatchBytes = 64 * 1024;
+// A batch is flushed once its oldest message has waited this long.
+constexpr std::chrono::microseconds kCoalesceFlushWindow(200);
+
+// Wire-level type tag marking a coalesced batch. It is deliberately
+// outside the MessageType value range: a batch is a framing detail of
+// this agent, not a message the RPC layer ever sees.
+constexpr int64_t kCoalescedBatchWireType = -1;
+
+std::string newShmHandle() {
+  static std::random_device rd;
+  std::string handle = "/torch_rpc_";
+  handle += std::to_string(getpid());
+  handle += "_";
+  handle += std::to_string(rd());
+  return handle;
+}
+
+void appendInt64(std::string& out, int64_t value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(int64_t));
+}
+
+int64_t readInt64(const char*& ptr) {
+  int64_t value;
+  memcpy(&value, ptr, sizeof(int64_t));
+  ptr += sizeof(int64_t);
+  return value;
+}
+
+void appendShmString(std::string& out, const std::string& s) {
+  appendInt64(out, (int64_t)s.length());
+  out.append(s);
+}
+
+std::string readShmString(const char*& ptr) {
+  auto length = readInt64(ptr);
+  std::string s(ptr, length);
+  ptr += length;
+  return s;
+}
+
+// Moves eligible tensors of the message into libshm segments. Returns the
+// tensor table with the moved tensors replaced by empty placeholders,
+// appends a manifest entry per moved tensor to `manifest`, and stores the
+// segment mappings in `segments` so the caller can keep them alive until
+// the receiver has attached.
+std::vector<torch::Tensor> extractShmTensors(
+    const Message& message,
+    std::string& manifest,
+    std::vector<at::DataPtr>& segments) {
+  std::vector<torch::Tensor> tensors = message.tensors();
+  int64_t count = 0;
+  std::string entries;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    auto& tensor = tensors[i];
+    if (!tensor.device().is_cpu() || tensor.is_sparse() ||
+        tensor.is_quantized() || tensor.nbytes() < kShmMinTensorBytes) {
+      continue;
+    }
+    auto src = tensor.contiguous();
+    std::string handle = newShmHandle();
+    at::DataPtr segment = THManagedMapAllocator::makeDataPtr(
+        "",
+        handle.c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+        src.nbytes());
+    memcpy(segment.get(), src.data_ptr(), src.nbytes());
+    auto* ctx = THManagedMapAllocator::fromDataPtr(segment);
+    AT_ASSERT(ctx);
+
+    appendInt64(entries, (int64_t)i);
+    appendInt64(entries, (int64_t)src.scalar_type());
+    appendInt64(entries, (int64_t)src.nbytes());
+    appendInt64(entries, (int64_t)src.dim());
+    for (auto size : src.sizes()) {
+      appendInt64(entries, size);
+    }
+    appendShmString(entries, ctx->manager_handle());
+    appendShmString(entries, ctx->filename());
+
+    segments.emplace_back(std::move(segment));
+    tensor = torch::empty({0}, tensor.options());
+    ++count;
+  }
+  manifest.clear();
+  if (count > 0) {
+    appendInt64(manifest, count);
+    manifest.append(entries);
+  }
+  return tensors;
+}
+
+// Attaches the libshm segments described by a manifest and wraps each one
+// in a tensor that owns the mapping; the segment itself is freed by the
+// shared memory manager once every attached process has let go.
+std::vector<std::pair<int64_t, torch::Tensor>> attachShmTensors(
+    const char* buf,
+    size_t size) {
+  const char* ptr = buf;
+  auto count = readInt64(ptr);
+  std::vector<std::pair<int64_t, torch::Tensor>> result;
+  result.reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    auto index = readInt64(ptr);
+    auto scalarType = static_cast<at::ScalarType>(readInt64(ptr));
+    auto nbytes = readInt64(ptr);
+    std::vector<int64_t> sizes(readInt64(ptr));
+    for (auto& size : sizes) {
+      size = readInt64(ptr);
+    }
+    auto managerHandle = readShmString(ptr);
+    auto filename = readShmString(ptr);
+
+    at::DataPtr segment = THManagedMapAllocator::makeDataPtr(
+        managerHandle.c_str(),
+        filename.c_str(),
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+        nbytes);
+    // It's shared through a deleter because the tensor must keep the
+    // mapping alive for as long as it refers to the segment.
+    auto* mapping = new at::DataPtr(std::move(segment));
+    result.emplace_back(
+        index,
+        torch::from_blob(
+            mapping->get(),
+            sizes,
+            [mapping](void*) { delete mapping; },
+            torch::TensorOptions().dtype(scalarType)));
+  }
+  TORCH_CHECK(
+      ptr == buf + size, "Failed to parse shared memory tensor manifest.");
+  return result;
+}
+
+// Write the message into the given ostream. The tensor table is passed
+// separately because the same-host fast path serializes a table in which
+// shared memory tensors have been replaced by placeholders.
+std::string serialize(const Message& message, std::vector<torch::Tensor> tensors) {
   // We cast const void* to void* here because we need to create a tensor using
   // that memory space. If is fine as that tensor stays function-local, and will
   // not be modified during its lifetime.
@@ -21,8 +217,6 @@ std::string serialize(const Message& message) {
       static_cast<const void*>(message.payload().data()));
   auto payload_size = message.payload().size();
 
-  // getting tensor table from the message
-  std::vector<torch::Tensor> tensors = message.tensors();
   // append payload as a tensor
   tensors.push_back(torch::from_blob(payload, payload_size, {torch::kChar}));
   // append id and autograd metadata as a tensor
@@ -45,7 +239,15 @@ std::string serialize(const Message& message) {
   return out;
 }
 
-Message deserialize(MessageType type, const void* buf, size_t size) {
+std::string serialize(const Message& message) {
+  return serialize(message, message.tensors());
+}
+
+Message deserialize(
+    MessageType type,
+    const void* buf,
+    size_t size,
+    const std::vector<std::pair<int64_t, torch::Tensor>>& shmTensors = {}) {
   std::vector<torch::Tensor> tensors;
 
   torch::load(tensors, static_cast<const char*>(buf), size);
@@ -56,6 +258,15 @@ Message deserialize(MessageType type, const void* buf, size_t size) {
   auto payloadTensor = std::move(tensors.back());
   tensors.pop_back();
 
+  // Swap in the tensors that arrived through shared memory for their
+  // placeholders. See Note [Same-host fast path].
+  for (const auto& entry : shmTensors) {
+    TORCH_CHECK(
+        entry.first >= 0 && (size_t)entry.first < tensors.size(),
+        "Shared memory tensor index out of bounds.");
+    tensors[entry.first] = entry.second;
+  }
+
   TORCH_INTERNAL_ASSERT(1, idTensor.numel());
   int64_t id = idTensor.storage().data<int64_t>()[0];
 
@@ -115,6 +326,36 @@ void ProcessGroupAgent::collectNames() {
   }
 }
 
+void ProcessGroupAgent::collectHostnames() {
+  const auto worldSize = pg_->getSize();
+
+  // use c10d allgather to collect hostnames, so that every process knows
+  // which peers it shares a host with. See Note [Same-host fast path].
+  std::array<char, 256> hostname{};
+  TORCH_CHECK(
+      gethostname(hostname.data(), hostname.size() - 1) == 0,
+      "Failed to get hostname: ",
+      strerror(errno));
+
+  torch::Tensor hostTensor =
+      torch::zeros({(int64_t)hostname.size()}, torch::kChar);
+  memcpy(hostTensor.storage().data(), hostname.data(), hostname.size());
+  std::vector<torch::Tensor> inputHostname = {hostTensor};
+  std::vector<std::vector<torch::Tensor>> outputHostnames(1);
+  for (int i = 0; i < worldSize; ++i) {
+    outputHostnames[0].emplace_back(
+        torch::empty({(int64_t)hostname.size()}, {torch::kChar}));
+  }
+  pg_->allgather(outputHostnames, inputHostname)->wait();
+
+  sameHostPeers_.resize(worldSize);
+  for (int i = 0; i < worldSize; ++i) {
+    const char* peerHostname =
+        (const char*)outputHostnames[0][i].storage().data<signed char>();
+    sameHostPeers_[i] = strcmp(peerHostname, hostname.data()) == 0;
+  }
+}
+
 ProcessGroupAgent::ProcessGroupAgent(
     std::string workerName,
     std::shared_ptr<c10d::ProcessGroup> pg,
@@ -129,8 +370,11 @@ ProcessGroupAgent::ProcessGroupAgent(
       recvCounts_(pg_->getSize()),
       nextId_(0),
       sendMutexes_(pg_->getSize()),
+      pendingBatches_(pg_->getSize()),
+      stopCoalescer_(false),
       threadPool_(numSendRecvThreads) {
   collectNames();
+  collectHostnames();
   TORCH_CHECK(
       nameMap_.size() > 1,
       "ProcessGroupAgent requires world_size to "
@@ -193,6 +437,15 @@ void ProcessGroupAgent::join() {
       SendWork(allWorkerInfo_[dst], Message({}, {}, MessageType::SHUTDOWN)));
   threadPool_.waitWorkComplete();
   listenerThread_.join();
+  // All batches have been flushed by now (sync() does not return until all
+  // sent messages are processed); stopping the coalescer would flush any
+  // leftovers regardless.
+  {
+    std::lock_guard<std::mutex> guard(coalesceMutex_);
+    stopCoalescer_ = true;
+  }
+  coalesceCV_.notify_all();
+  coalescerThread_.join();
   PythonRpcHandler::getInstance().cleanup();
 }
 
@@ -260,6 +513,7 @@ void ProcessGroupAgent::sync() {
 
 void ProcessGroupAgent::start() {
   listenerThread_ = std::thread(&ProcessGroupAgent::listenLoop, this);
+  coalescerThread_ = std::thread(&ProcessGroupAgent::coalesceLoop, this);
 }
 
 std::shared_ptr<FutureMessage> ProcessGroupAgent::send(
@@ -335,18 +589,34 @@ void ProcessGroupAgent::enqueueSend(SendWork work) {
   // NB: this can be changed to use a native move capture when moved to C++14
   threadPool_.run(std::bind(
       [this](const SendWork& work) {
-        std::string serializedPayload = serialize(work.message_);
+        const auto dst = work.to_.id_;
+
+        // Same-host peers get their large CPU tensors through shared
+        // memory; only the manifest and the remaining payload go over the
+        // wire. See Note [Same-host fast path].
+        std::string serializedPayload;
+        std::string shmManifest;
+        std::vector<at::DataPtr> shmSegments;
+        if (sameHostPeers_[dst] && !work.message_.isShutdown()) {
+          serializedPayload = serialize(
+              work.message_,
+              extractShmTensors(work.message_, shmManifest, shmSegments));
+        } else {
+          serializedPayload = serialize(work.message_);
+        }
+        const int64_t payloadLength = serializedPayload.length();
+        serializedPayload += shmManifest;
 
         std::vector<torch::Tensor> preamble = {torch::tensor(
             {(int64_t)pg_->getRank(),
-             (int64_t)serializedPayload.length(),
-             (int64_t)work.message_.type()},
+             payloadLength,
+             (int64_t)work.message_.type(),
+             (int64_t)shmManifest.length()},
             {torch::kLong})};
 
         // ProcessGroup is not thread-safe when sending with the same tag, hence
         // the lock
         std::vector<std::shared_ptr<c10d::ProcessGroup::Work>> pendingSends;
-        const auto dst = work.to_.id_;
         if (work.message_.isShutdown()) {
           pendingSends.reserve(1);
           {
@@ -354,6 +624,33 @@ void ProcessGroupAgent::enqueueSend(SendWork work) {
             pendingSends.emplace_back(
                 pg_->send(preamble, dst, dst /* channelTag */));
           }
+        } else if (
+            shmManifest.empty() &&
+            serializedPayload.length() <= kCoalesceMaxMessageBytes) {
+          // Small messages are appended to a per-destination batch that the
+          // coalescing thread flushes as a single wire transfer. See Note
+          // [Small message coalescing]. The send counter is incremented
+          // here, before the batch is flushed, so that termination
+          // detection waits for messages still sitting in a batch.
+          sendCounts_.increment(dst);
+          bool wakeCoalescer = false;
+          {
+            std::lock_guard<std::mutex> guard(coalesceMutex_);
+            auto& batch = pendingBatches_[dst];
+            if (batch.buffer.empty()) {
+              batch.firstEnqueueTime = std::chrono::steady_clock::now();
+              wakeCoalescer = true;
+            }
+            appendInt64(batch.buffer, (int64_t)work.message_.type());
+            appendInt64(batch.buffer, (int64_t)serializedPayload.length());
+            batch.buffer.append(serializedPayload);
+            if (batch.buffer.length() >= kCoalesceMaxBatchBytes) {
+              wakeCoalescer = true;
+            }
+          }
+          if (wakeCoalescer) {
+            coalesceCV_.notify_one();
+          }
         } else {
           std::vector<torch::Tensor> payload = {torch::from_blob(
               (void*)serializedPayload.c_str(),
@@ -369,6 +666,20 @@ void ProcessGroupAgent::enqueueSend(SendWork work) {
                 pg_->send(preamble, dst, dst /* channelTag */));
             pendingSends.emplace_back(
                 pg_->send(payload, dst, dst /* channelTag */));
+            if (!shmSegments.empty()) {
+              // Block until the destination has attached the segments, as
+              // dropping our mappings earlier would let the shared memory
+              // manager free them. The recv must stay under the lock so
+              // that concurrent sends to the same destination cannot
+              // interleave their acknowledgements on the shared tag.
+              for (auto& pendingSend : pendingSends) {
+                pendingSend->wait();
+              }
+              pendingSends.clear();
+              std::vector<torch::Tensor> ack = {
+                  torch::zeros({1}, {torch::kChar})};
+              pg_->recv(ack, dst, pg_->getSize() + pg_->getRank())->wait();
+            }
           }
         }
         for (auto& pendingSend : pendingSends) {
@@ -382,8 +693,11 @@ void ProcessGroupAgent::enqueueRecv(RecvWork work) {
   threadPool_.run(std::bind(
       [&](RecvWork& work) {
         torch::Tensor& payload = work.payload_;
-        Message message =
-            deserialize(work.type_, payload.storage().data(), payload.numel());
+        Message message = deserialize(
+            work.type_,
+            payload.storage().data(),
+            payload.numel(),
+            work.shmTensors_);
         if (message.isRequest()) {
           send(work.from_, cb_->operator()(message));
         } else if (message.isResponse()) {
@@ -422,16 +736,118 @@ void ProcessGroupAgent::enqueueRecv(RecvWork work) {
       std::move(work)));
 }
 
+void ProcessGroupAgent::coalesceLoop() {
+  const auto worldSize = pg_->getSize();
+  auto anyPending = [this] {
+    for (const auto& batch : pendingBatches_) {
+      if (!batch.buffer.empty()) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::unique_lock<std::mutex> lock(coalesceMutex_);
+  while (true) {
+    if (!anyPending()) {
+      coalesceCV_.wait(lock, [&] { return stopCoalescer_ || anyPending(); });
+    } else {
+      // Let more messages accumulate behind the oldest batch, but never
+      // hold a message back for longer than the flush window.
+      auto deadline = std::chrono::steady_clock::time_point::max();
+      for (const auto& batch : pendingBatches_) {
+        if (!batch.buffer.empty()) {
+          deadline =
+              std::min(deadline, batch.firstEnqueueTime + kCoalesceFlushWindow);
+        }
+      }
+      coalesceCV_.wait_until(lock, deadline);
+    }
+    if (stopCoalescer_ && !anyPending()) {
+      return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    for (int dst = 0; dst < worldSize; ++dst) {
+      auto& batch = pendingBatches_[dst];
+      if (batch.buffer.empty()) {
+        continue;
+      }
+      if (!stopCoalescer_ && batch.buffer.length() < kCoalesceMaxBatchBytes &&
+          now - batch.firstEnqueueTime < kCoalesceFlushWindow) {
+        continue;
+      }
+      std::string buffer = std::move(batch.buffer);
+      batch.buffer.clear();
+      // Release the lock while sending so that send threads can keep
+      // appending to other batches (and to this one) in the meantime.
+      lock.unlock();
+      flushBatch(dst, std::move(buffer));
+      lock.lock();
+    }
+  }
+}
+
+void ProcessGroupAgent::flushBatch(int dst, std::string batch) {
+  std::vector<torch::Tensor> preamble = {torch::tensor(
+      {(int64_t)pg_->getRank(),
+       (int64_t)batch.length(),
+       kCoalescedBatchWireType,
+       (int64_t)0},
+      {torch::kLong})};
+  std::vector<torch::Tensor> payload = {torch::from_blob(
+      (void*)batch.c_str(), batch.length(), {torch::kChar})};
+  std::vector<std::shared_ptr<c10d::ProcessGroup::Work>> pendingSends;
+  pendingSends.reserve(2);
+  {
+    std::lock_guard<std::mutex> guard(sendMutexes_[dst]);
+    pendingSends.emplace_back(pg_->send(preamble, dst, dst /* channelTag */));
+    pendingSends.emplace_back(pg_->send(payload, dst, dst /* channelTag */));
+  }
+  for (auto& pendingSend : pendingSends) {
+    pendingSend->wait();
+  }
+}
+
 void ProcessGroupAgent::listenLoop() {
   while (true) {
-    // rank, tensor size, message type
-    std::vector<torch::Tensor> preamble = {torch::empty({3}, {torch::kInt64})};
+    // rank, tensor size, message type, shm manifest size
+    std::vector<torch::Tensor> preamble = {torch::empty({4}, {torch::kInt64})};
     pg_->recvAnysource(preamble, pg_->getRank())->wait();
     int64_t* preamble_items = preamble.front().storage().data<int64_t>();
 
     auto srcRank = preamble_items[0];
     auto size = preamble_items[1];
-    MessageType type = MessageType(preamble_items[2]);
+    auto wireType = preamble_items[2];
+    auto shmManifestSize = preamble_items[3];
+
+    if (wireType == kCoalescedBatchWireType) {
+      // A batch of small messages; split the frames back into individual
+      // RecvWork items. See Note [Small message coalescing].
+      std::vector<torch::Tensor> tensors = {
+          torch::empty({size}, {torch::kChar})};
+      pg_->recv(tensors, srcRank, pg_->getRank())->wait();
+
+      const char* data = static_cast<const char*>(tensors[0].storage().data());
+      const char* end = data + size;
+      const char* ptr = data;
+      while (ptr < end) {
+        MessageType frameType = MessageType(readInt64(ptr));
+        auto frameLength = readInt64(ptr);
+        // Deserialization reads from the base of the payload storage, so
+        // each frame gets its own tensor rather than a narrow() into the
+        // batch tensor.
+        auto frame = torch::empty({frameLength}, {torch::kChar});
+        memcpy(frame.storage().data(), ptr, frameLength);
+        ptr += frameLength;
+        enqueueRecv(
+            RecvWork(allWorkerInfo_[srcRank], frameType, std::move(frame)));
+      }
+      TORCH_CHECK(ptr == end, "Failed to parse a coalesced message batch.");
+      continue;
+    }
+
+    MessageType type = MessageType(wireType);
 
     if (type == MessageType::SHUTDOWN) {
       // FIXME: This LOG also prints warnings no InitGoogleLogging() was invoked
@@ -442,10 +858,26 @@ void ProcessGroupAgent::listenLoop() {
       return;
     }
 
-    std::vector<torch::Tensor> tensors = {torch::empty({size}, {torch::kChar})};
+    std::vector<torch::Tensor> tensors = {
+        torch::empty({size + shmManifestSize}, {torch::kChar})};
     pg_->recv(tensors, srcRank, pg_->getRank())->wait();
 
-    enqueueRecv(RecvWork(allWorkerInfo_[srcRank], type, std::move(tensors[0])));
+    torch::Tensor payload = std::move(tensors[0]);
+    std::vector<std::pair<int64_t, torch::Tensor>> shmTensors;
+    if (shmManifestSize > 0) {
+      const char* data = static_cast<const char*>(payload.storage().data());
+      shmTensors = attachShmTensors(data + size, shmManifestSize);
+      payload = payload.narrow(0, 0, size);
+      // Acknowledge only after attaching; the sender keeps its mappings
+      // alive until then. No send lock is needed here: the acknowledgement
+      // tag is never used by other send paths, and the listen loop is the
+      // only thread sending on it.
+      std::vector<torch::Tensor> ack = {torch::zeros({1}, {torch::kChar})};
+      pg_->send(ack, srcRank, pg_->getSize() + srcRank)->wait();
+    }
+
+    enqueueRecv(RecvWork(
+        allWorkerInfo_[srcRank], type, std::move(payload), std::move(shmTensors)));
   }
 }
 
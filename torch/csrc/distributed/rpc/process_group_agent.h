@@ -6,6 +6,8 @@
 #include <torch/csrc/distributed/rpc/python_rpc_handler.h>
 #include <torch/csrc/distributed/rpc/rpc_agent.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <thread>
 
 namespace torch {
@@ -25,12 +27,23 @@ struct SendWork {
 // SendWork wraps a Message and RecvWork wraps a Tensor. The difference here is
 // to allow us to run serialization/deserialization in the worker threads.
 struct RecvWork {
-  RecvWork(const WorkerInfo& from, MessageType type, torch::Tensor&& payload)
-      : from_(from), type_(type), payload_(payload) {}
+  RecvWork(
+      const WorkerInfo& from,
+      MessageType type,
+      torch::Tensor&& payload,
+      std::vector<std::pair<int64_t, torch::Tensor>> shmTensors = {})
+      : from_(from),
+        type_(type),
+        payload_(payload),
+        shmTensors_(std::move(shmTensors)) {}
 
   const WorkerInfo& from_;
   const MessageType type_;
   torch::Tensor payload_;
+  // Tensors that arrived through shared memory instead of the serialized
+  // payload, keyed by their index in the message tensor table. Only set
+  // when the sender lives on the same host. See Note [Same-host fast path].
+  std::vector<std::pair<int64_t, torch::Tensor>> shmTensors_;
 };
 
 class ProcessGroupAgent : public RpcAgent {
@@ -70,13 +83,30 @@ class ProcessGroupAgent : public RpcAgent {
     std::mutex mutex_;
   };
 
+  // An outbound buffer of small serialized messages bound for the same
+  // destination, flushed as one wire transfer. See Note [Small message
+  // coalescing].
+  struct OutboundBatch {
+    std::string buffer;
+    std::chrono::steady_clock::time_point firstEnqueueTime;
+  };
+
   void collectNames();
+  // allgather hostnames to detect peers co-located on this host; those
+  // peers are eligible for the shared-memory fast path.
+  void collectHostnames();
   // put SendWork into a queue and notify the worker thread
   void enqueueSend(SendWork work);
   // put RecvWork into a queue and notify the worker thread
   void enqueueRecv(RecvWork work);
   // receiving messages
   void listenLoop();
+  // entrypoint of the coalescing thread; flushes pending batches once they
+  // grow large enough or age past the flush window. See Note [Small
+  // message coalescing].
+  void coalesceLoop();
+  // sends an assembled batch to the destination as a single wire transfer.
+  void flushBatch(int dst, std::string batch);
 
   // Note [Termination Detection]
   // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -108,6 +138,10 @@ class ProcessGroupAgent : public RpcAgent {
   std::shared_ptr<c10d::ProcessGroup> pg_;
   // worker name -> rank
   std::unordered_map<std::string, int> nameMap_;
+  // sameHostPeers_[rank] is true iff the peer reported the same hostname as
+  // this process. Large CPU tensors sent to such peers travel through
+  // libshm segments instead of the serialized payload.
+  std::vector<bool> sameHostPeers_;
   std::vector<WorkerInfo> allWorkerInfo_;
   // record the number of messages sent to and received from each peer. The recv
   // counter is only marked after the message is processed. Join uses allgather
@@ -121,6 +155,14 @@ class ProcessGroupAgent : public RpcAgent {
   // when using the same tag.
   std::vector<std::mutex> sendMutexes_;
   std::thread listenerThread_;
+  // pendingBatches_[rank] accumulates small messages for that destination
+  // until the coalescing thread flushes them; all three fields below are
+  // guarded by coalesceMutex_. See Note [Small message coalescing].
+  std::vector<OutboundBatch> pendingBatches_;
+  bool stopCoalescer_;
+  std::mutex coalesceMutex_;
+  std::condition_variable coalesceCV_;
+  std::thread coalescerThread_;
   // A threadPool that processing both SendWork and RecvWork. There are two
   // motivations for adding a ThreadPool:
   // (1) RPC serialization/deserialization and processing can be expensive,
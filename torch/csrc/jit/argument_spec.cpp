@@ -1,9 +1,25 @@
 
 #include <torch/csrc/jit/argument_spec.h>
 
+#include <cstdlib>
+
 namespace torch {
 namespace jit {
 
+int64_t shapeBucketMultiple() {
+  // Resolved once per process: spec construction is on the hot path of
+  // every graph executor invocation.
+  static const int64_t multiple = []() -> int64_t {
+    const char* env = std::getenv("PYTORCH_JIT_SHAPE_BUCKET");
+    if (env == nullptr) {
+      return 1;
+    }
+    const int64_t parsed = std::atol(env);
+    return parsed > 1 ? parsed : 1;
+  }();
+  return multiple;
+}
+
 void ArgumentSpecCreator::scan(
     const TypePtr& typ,
     size_t depth,
@@ -198,6 +198,20 @@ struct TORCH_API ArgumentSpecCreator {
   std::vector<Inst> instructions_;
 };
 
+// Shape bucketing for spec keys. When PYTORCH_JIT_SHAPE_BUCKET is set to an
+// integer greater than 1, the extents recorded by CompleteArgumentSpec are
+// rounded up to the next multiple of that value (e.g. 32 maps sequence
+// lengths 33..64 to the same key), so inputs padded to varying lengths share
+// an entry in caches keyed on the spec instead of growing them without
+// bound. The default of 1 records exact shapes. Bucketing only affects the
+// key; the tensors themselves are untouched.
+TORCH_API int64_t shapeBucketMultiple();
+
+// Rounds a single extent up to the next multiple of bucket
+inline int64_t bucketShape(int64_t extent, int64_t bucket) {
+  return (extent + bucket - 1) / bucket * bucket;
+}
+
 // CompleteArgumentSpec represents one particular specialization.
 // It is designed so that it can be created, hashed, and compared quickly
 // since it is used along the hot-path of the JIT to check if the code
@@ -257,12 +271,31 @@ struct CompleteArgumentSpec {
           pod.requires_grad =
               with_grad && autograd::as_variable_ref(t).requires_grad();
           total_dims += t.ndimension();
+          const int64_t bucket = shapeBucketMultiple();
           auto sizes = t.sizes();
-          std::copy(sizes.begin(), sizes.end(), next_dim);
-          next_dim += sizes.size();
+          if (bucket > 1) {
+            for (const auto size : sizes) {
+              *next_dim++ = bucketShape(size, bucket);
+            }
+          } else {
+            std::copy(sizes.begin(), sizes.end(), next_dim);
+            next_dim += sizes.size();
+          }
           auto strides = t.strides();
-          std::copy(strides.begin(), strides.end(), next_dim);
-          next_dim += strides.size();
+          if (bucket > 1 && t.is_contiguous()) {
+            // Contiguous strides are derived from the bucketed sizes so
+            // they do not re-introduce the exact extents into the key.
+            int64_t stride = 1;
+            for (int64_t j = static_cast<int64_t>(sizes.size()) - 1; j >= 0;
+                 --j) {
+              next_dim[j] = stride;
+              stride *= bucketShape(sizes[j], bucket);
+            }
+            next_dim += strides.size();
+          } else {
+            std::copy(strides.begin(), strides.end(), next_dim);
+            next_dim += strides.size();
+          }
         }
       }
       // each POD has a running tally of all dimensions including its own
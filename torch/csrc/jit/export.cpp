@@ -542,8 +542,12 @@ class ScriptModuleSerializer {
   void serialize(
       const script::Module& module,
       const script::ExtraFilesMap& extra_files,
-      bool bytecode_format) {
+      bool bytecode_format,
+      int compression_level) {
     C10_LOG_API_USAGE_ONCE("torch.script.save");
+    if (compression_level != 0) {
+      writer_.setCompressionLevel(compression_level);
+    }
     writeExtraFiles(module, extra_files);
     // Serialize the model object
     writeArchive("data", module.module_object());
@@ -980,31 +984,34 @@ void ExportModule(
     const script::Module& module,
     std::ostream& out,
     const script::ExtraFilesMap& extra_files,
-    bool bytecode_format) {
+    bool bytecode_format,
+    int compression_level) {
   ScriptModuleSerializer serializer(
     [&](const void* buf, size_t nbytes) -> size_t {
       out.write(static_cast<const char *>(buf), nbytes);
       return !out ? 0 : nbytes;
     });
-  serializer.serialize(module, extra_files, bytecode_format);
+  serializer.serialize(module, extra_files, bytecode_format, compression_level);
 }
 
 void ExportModule(
     const script::Module& module,
     const std::string& filename,
     const script::ExtraFilesMap& extra_files,
-    bool bytecode_format) {
+    bool bytecode_format,
+    int compression_level) {
   ScriptModuleSerializer serializer(filename);
-  serializer.serialize(module, extra_files, bytecode_format);
+  serializer.serialize(module, extra_files, bytecode_format, compression_level);
 }
 
 void ExportModule(
     const script::Module& module,
     const std::function<size_t(const void*, size_t)>& writer_func,
     const script::ExtraFilesMap& extra_files,
-    bool bytecode_format) {
+    bool bytecode_format,
+    int compression_level) {
   ScriptModuleSerializer serializer(writer_func);
-  serializer.serialize(module, extra_files, bytecode_format);
+  serializer.serialize(module, extra_files, bytecode_format, compression_level);
 }
 
 } // namespace jit
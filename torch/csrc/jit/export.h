@@ -41,23 +41,29 @@ TORCH_API std::string pretty_print_onnx(
     bool google_printer = false,
     bool keep_initializers_as_inputs = true);
 
+// `compression_level` selects the zstd level used for record compression in
+// the produced archive; 0 writes records uncompressed. Non-zero levels
+// require a build with USE_ZSTD.
 TORCH_API void ExportModule(
     const script::Module& module,
     std::ostream& out,
     const script::ExtraFilesMap& metadata = script::ExtraFilesMap(),
-    bool bytecode_format = false);
+    bool bytecode_format = false,
+    int compression_level = 0);
 
 TORCH_API void ExportModule(
     const script::Module& module,
     const std::string& filename,
     const script::ExtraFilesMap& metadata = script::ExtraFilesMap(),
-    bool bytecode_format = false);
+    bool bytecode_format = false,
+    int compression_level = 0);
 
 TORCH_API void ExportModule(
     const script::Module& module,
     const std::function<size_t(const void*, size_t)>& writer_func,
     const script::ExtraFilesMap& metadata = script::ExtraFilesMap(),
-    bool bytecode_format = false);
+    bool bytecode_format = false,
+    int compression_level = 0);
 
 // Surrounding system can install an additional hook to produce extra files
 // with metadata based on environment every time a module is serialized.
@@ -29,6 +29,28 @@ size_t ${tensor}_dimIndex${d} = ${tensor}_linearIndex ${mod_sizes};
 ${tensor}_offset += ${tensor}_dimIndex${d} ${times_stride};
 )");
 
+// Epilogue for a fused sum output on CUDA: each thread has accumulated its
+// share of the grid-stride loop in a register; the block folds those
+// partial sums in shared memory and thread 0 adds the block total into the
+// (zero-initialized) output with atomicAdd. The buffer is sized for the
+// launcher's fixed block of 128 threads (see cuda/fused_kernel.h).
+static auto cuda_block_reduce = CodeTemplate(R"(
+{
+  __shared__ ${acc_type} t${formal}_sbuf[128];
+  t${formal}_sbuf[threadIdx.x] = t${formal}_acc;
+  __syncthreads();
+  for (int s = blockDim.x / 2; s > 0; s >>= 1) {
+    if (threadIdx.x < s) {
+      t${formal}_sbuf[threadIdx.x] += t${formal}_sbuf[threadIdx.x + s];
+    }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    atomicAdd(&t${formal}.data[0], t${formal}_sbuf[0]);
+  }
+}
+)");
+
 static std::string valueName(const Value* n) {
   return "n" + c10::to_string(n->unique());
 }
@@ -331,8 +353,44 @@ std::string generateKernel(
   std::vector<std::string> formals;
   std::vector<std::string> argument_loads;
 
+  // Mirrors of the kernel body and tensor accesses for the vectorized CUDA
+  // variant (see cuda::cuda_vectorized_unit_template), which moves four
+  // elements per thread through aligned vector loads and stores. It is only
+  // appended when every tensor formal collapses to a single contiguous
+  // dimension, so that consecutive linear indices address consecutive memory.
+  std::stringstream vec_body;
+  std::stringstream vec_loads;
+  std::stringstream vec_stores;
+  bool all_tensors_vectorizable = true;
+
+  // CPU mirror for the same fully contiguous case: the kernel hoists
+  // restrict-qualified raw data pointers out of the loop and indexes them
+  // with linearIndex directly, so the host compiler can prove the accesses
+  // independent and auto-vectorize (see cpu::cpu_compilation_unit_template).
+  std::stringstream cpu_pointer_decls;
+  std::stringstream cpu_contig_body;
+
+  // Reduction (prim::FusedSum) outputs accumulate into a register inside
+  // the map loop instead of storing per element; the accumulator
+  // declarations go before the loop and the combination step (a block
+  // reduction plus atomicAdd on CUDA, an OpenMP reduction on CPU) after it.
+  std::stringstream reduction_inits;
+  std::stringstream reduction_epilogue;
+  std::vector<std::string> reduction_accumulators;
+  bool has_reduction = false;
+  for (const auto& output : outputs) {
+    if (output.first->node()->kind() == prim::FusedSum) {
+      has_reduction = true;
+    }
+  }
+  // The vectorized and contiguous specializations have no epilogue hook,
+  // so reductions always take the general code path.
+  if (has_reduction) {
+    all_tensors_vectorizable = false;
+  }
+
   // Lambda for writing arguments
-  auto emitFormal = [&](const Value* n, const TensorDesc& desc) {
+  auto emitFormal = [&](const Value* n, const TensorDesc& desc, bool is_reduction) {
     env.d(
         "formal_index",
         formals.size() +
@@ -342,7 +400,14 @@ std::string generateKernel(
           c10::to_string(
               formals.size()); // can't be unique() because Param may be an output
       const auto nDim = desc.nDim();
-      emitIndexingFor(tensorOffsets, tensor, nDim, desc.lastIsContiguous());
+      if (nDim > 1 || !desc.lastIsContiguous()) {
+        all_tensors_vectorizable = false;
+      }
+      // Reduction outputs are written once after the loop, always at
+      // offset zero, so no per-element offset arithmetic is needed.
+      if (!is_reduction) {
+        emitIndexingFor(tensorOffsets, tensor, nDim, desc.lastIsContiguous());
+      }
       env.s("tensor", tensor);
       env.d("nDim", nDim);
       env.s("scalar_type", scalarTypeName(desc.scalar_type));
@@ -377,7 +442,7 @@ std::string generateKernel(
   // Writes input parameters
   for (const auto& input : inputs) {
     if (input.second.has_value()){
-      emitFormal(input.first, *input.second);
+      emitFormal(input.first, *input.second, /*is_reduction=*/false);
     } else {
       emitScalarFormal(input.first);
     }
@@ -385,7 +450,10 @@ std::string generateKernel(
 
   // Writes output parameters
   for (const auto& output : outputs) {
-    emitFormal(output.first, output.second);
+    emitFormal(
+        output.first,
+        output.second,
+        output.first->node()->kind() == prim::FusedSum);
   }
 
   // Acquires input values
@@ -418,13 +486,38 @@ std::string generateKernel(
         }
       } else {
         env.s("access", format("t${formal}.data[t${formal}_offset]", env));
+        env.s("scalar_type", scalarTypeName(input.second->scalar_type));
+        cpu_pointer_decls << format(
+            "const ${scalar_type}* RESTRICT const t${formal}_data = "
+            "t${formal}.data;\n",
+            env);
+        env.s("contig_access", format("t${formal}_data[linearIndex]", env));
       }
       env.s("lhs_type", calcScalarTypeName(input.second.value().scalar_type));
+      if (use_cuda) {
+        env.s("vec_scalar_type", scalarTypeName(input.second->scalar_type));
+        vec_loads << format(
+            "const Vec4<${vec_scalar_type}> t${formal}_vec = "
+            "*reinterpret_cast<const Vec4<${vec_scalar_type}>*>"
+            "(t${formal}.data + vecIndex * 4);\n",
+            env);
+        env.s(
+            "vec_access",
+            is_half ? format("__half2float(t${formal}_vec.v[vec_lane])", env)
+                    : format("t${formal}_vec.v[vec_lane]", env));
+      }
     } else {
       env.s("access", format("s${formal}", env));
+      env.s("vec_access", format("s${formal}", env));
+      env.s("contig_access", format("s${formal}", env));
       env.s("lhs_type", variableType(input.first->type()));
     }
     body << format("${lhs_type} ${node} = ${access};\n", env);
+    if (use_cuda) {
+      vec_body << format("${lhs_type} ${node} = ${vec_access};\n", env);
+    } else {
+      cpu_contig_body << format("${lhs_type} ${node} = ${contig_access};\n", env);
+    }
   }
 
   bool has_random = false;
@@ -438,6 +531,9 @@ std::string generateKernel(
     // kernel runs
     if (n->kind() == prim::FusedConcat)
       continue;
+    // Note: FusedSum nodes become accumulators; see the output loop below
+    if (n->kind() == prim::FusedSum)
+      continue;
     if (n->kind() == prim::ConstantChunk)
       continue;
     if (n->mustBeNone())
@@ -471,11 +567,34 @@ std::string generateKernel(
     }
 
     body << format("${lhs_type} ${node} = ${rhs};\n", env);
+    if (use_cuda) {
+      vec_body << format("${lhs_type} ${node} = ${rhs};\n", env);
+    } else {
+      cpu_contig_body << format("${lhs_type} ${node} = ${rhs};\n", env);
+    }
   }
 
   // Generates writes to output tensors
   for (const auto& output : outputs) {
     env.d("formal", formal_count++);
+
+    // Reductions accumulate inside the loop and combine after it instead
+    // of storing per element.
+    if (output.first->node()->kind() == prim::FusedSum) {
+      env.s("node", valueName(output.first->node()->input()));
+      env.s("acc_type", calcScalarTypeName(output.second.scalar_type));
+      reduction_inits << format("${acc_type} t${formal}_acc = 0;\n", env);
+      body << format("t${formal}_acc += ${node};\n", env);
+      if (use_cuda) {
+        reduction_epilogue << cuda_block_reduce.format(env);
+      } else {
+        reduction_epilogue << format(
+            "t${formal}.data[0] += t${formal}_acc;\n", env);
+        reduction_accumulators.push_back(format("t${formal}_acc", env));
+      }
+      continue;
+    }
+
     env.s("access", format("t${formal}.data[t${formal}_offset]", env));
     env.s("node", valueName(output.first));
 
@@ -489,6 +608,24 @@ std::string generateKernel(
     } else {
       body << format("${access} = ${node};\n", env);
     }
+    if (use_cuda) {
+      env.s("vec_scalar_type", scalarTypeName(output.second.scalar_type));
+      vec_loads << format("Vec4<${vec_scalar_type}> t${formal}_vec;\n", env);
+      vec_body << (is_half
+          ? format("t${formal}_vec.v[vec_lane] = __float2half(${node});\n", env)
+          : format("t${formal}_vec.v[vec_lane] = ${node};\n", env));
+      vec_stores << format(
+          "*reinterpret_cast<Vec4<${vec_scalar_type}>*>"
+          "(t${formal}.data + vecIndex * 4) = t${formal}_vec;\n",
+          env);
+    } else {
+      env.s("scalar_type", scalarTypeName(output.second.scalar_type));
+      cpu_pointer_decls << format(
+          "${scalar_type}* RESTRICT const t${formal}_data = t${formal}.data;\n",
+          env);
+      cpu_contig_body << format(
+          "t${formal}_data[linearIndex] = ${node};\n", env);
+    }
   }
 
   // Includes headers
@@ -512,14 +649,61 @@ std::string generateKernel(
   // Insantiates the CUDA or CPU-specific templates
   env.s("tensorOffsets", tensorOffsets.str());
   env.s("kernelBody", body.str());
+  env.s("reductionInits", reduction_inits.str());
+  env.s("reductionEpilogue", reduction_epilogue.str());
   env.v("formals", formals);
   env.v("argument_loads", argument_loads);
   std::string code_string;
   if (use_cuda) {
     env.s("type_declarations", cuda::type_declarations_template.format(env));
     code_string = cuda::cuda_compilation_unit_template.format(env);
+    // Appends the vectorized entry point when it is expressible: strided
+    // tensors cannot be loaded four-wide, and random generation is keyed to
+    // one Philox stream per thread. The launcher looks the "_vec" symbol up
+    // by name and falls back to the scalar kernel when it is absent (see
+    // cuda/fused_kernel.cpp).
+    if (all_tensors_vectorizable && !has_random) {
+      env.s("vecLoads", vec_loads.str());
+      env.s("vecBody", vec_body.str());
+      env.s("vecStores", vec_stores.str());
+      code_string += cuda::cuda_vectorized_unit_template.format(env);
+    }
   } else {
     env.s("type_declarations", cpu::type_declarations_template.format(env));
+    // Contiguity specialization: when every tensor formal collapses to a
+    // single contiguous dimension, the strided offset arithmetic is dropped
+    // in favor of restrict-qualified pointers indexed by linearIndex, and
+    // the loop carries an OpenMP simd hint (the plain parallel-for pragma is
+    // kept for MSVC, whose OpenMP support predates simd).
+    if (all_tensors_vectorizable) {
+      env.s("kernelPointers", cpu_pointer_decls.str());
+      env.s("kernelBody", cpu_contig_body.str());
+      env.s("tensorOffsets", "");
+      env.s(
+          "loopPragma",
+          "#ifndef _MSC_VER\n"
+          "#pragma omp parallel for simd if(totalElements > OMP_THRESHOLD)\n"
+          "#else\n"
+          "#pragma omp parallel for if(totalElements > OMP_THRESHOLD)\n"
+          "#endif");
+    } else {
+      // Each fused sum's accumulator joins the parallel-for as an OpenMP
+      // reduction variable; the per-thread partial sums are combined by the
+      // runtime and folded into the output after the loop.
+      std::string reduction_clause;
+      for (const auto& acc : reduction_accumulators) {
+        reduction_clause +=
+            (reduction_clause.empty() ? " reduction(+:" : ",") + acc;
+      }
+      if (!reduction_clause.empty()) {
+        reduction_clause += ")";
+      }
+      env.s("kernelPointers", "");
+      env.s(
+          "loopPragma",
+          "#pragma omp parallel for" + reduction_clause +
+              " if(totalElements > OMP_THRESHOLD)");
+    }
     code_string = cpu::cpu_compilation_unit_template.format(env);
   }
 
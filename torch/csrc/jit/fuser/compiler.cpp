@@ -249,9 +249,10 @@ std::shared_ptr<FusedKernel> compileKernel(
     }
   }
 
-  // Creates output, concat, and flattened output descriptions
+  // Creates output, concat, reduction, and flattened output descriptions
   std::vector<TensorDesc> output_desc;
   std::vector<PartitionDesc> concat_desc;
+  std::vector<bool> reduction_desc;
   std::vector<std::pair<const Value*, const TensorDesc>> flat_outputs;
   for (const Value* o : graph->outputs()) {
     // Creates output description
@@ -259,6 +260,13 @@ std::shared_ptr<FusedKernel> compileKernel(
     if (o->node()->kind() == prim::FusedConcat) {
       sizes.at(o->node()->i(attr::dim)) *= o->node()->inputs().size();
     }
+    // Reduction outputs are scalars; the kernel sees them as one-element
+    // contiguous buffers it accumulates into (the executor allocates them
+    // zero-dimensional and zero-filled, see launchFusion).
+    reduction_desc.push_back(o->node()->kind() == prim::FusedSum);
+    if (reduction_desc.back()) {
+      sizes = {1};
+    }
 
     auto scalar_type = o->type()->expect<TensorType>()->scalarType();
     TORCH_INTERNAL_ASSERT(scalar_type);
@@ -293,6 +301,7 @@ std::shared_ptr<FusedKernel> compileKernel(
       output_desc,
       chunk_desc,
       concat_desc,
+      reduction_desc,
       spec.hasRandom());
 }
 
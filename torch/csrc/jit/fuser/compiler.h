@@ -41,6 +41,7 @@ using FusedKernelConstructor = std::function<std::shared_ptr<FusedKernel>(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
+    std::vector<bool> reduction_desc,
     bool has_random)>;
 
 TORCH_API void registerFusionBackend(
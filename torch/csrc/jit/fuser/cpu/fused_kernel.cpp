@@ -281,6 +281,7 @@ FusedKernelCPU::FusedKernelCPU(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
+    std::vector<bool> reduction_desc,
     bool has_random)
     : FusedKernel(
           std::move(name),
@@ -289,6 +290,7 @@ FusedKernelCPU::FusedKernelCPU(
           std::move(output_desc),
           std::move(chunk_desc),
           std::move(concat_desc),
+          std::move(reduction_desc),
           has_random) {
   TempFile so_file(so_template, so_suffix_len);
   TempFile cpp_file(cpp_template, cpp_suffix_len);
@@ -316,6 +318,7 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
+    std::vector<bool> reduction_desc,
     bool has_random) {
   return std::make_shared<FusedKernelCPU>(
       std::move(name),
@@ -324,6 +327,7 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
       std::move(output_desc),
       std::move(chunk_desc),
       std::move(concat_desc),
+      std::move(reduction_desc),
       has_random);
 }
 
@@ -23,14 +23,19 @@ struct TORCH_API FusedKernelCPU : public ::torch::jit::fuser::FusedKernel {
       std::vector<TensorDesc> output_desc,
       std::vector<PartitionDesc> chunk_desc,
       std::vector<PartitionDesc> concat_desc,
+      std::vector<bool> reduction_desc,
       bool has_random);
 
   at::Backend backend() const override {
     return at::Backend::CPU;
   }
 
-  void launch_raw(const uint32_t numel, std::vector<void*>& arguments)
-      const override {
+  // Note: CPU kernels are not vectorized by the fuser, so the hint is
+  // ignored (the host compiler auto-vectorizes the contiguous case).
+  void launch_raw(
+      const uint32_t numel,
+      std::vector<void*>& arguments,
+      const bool /* vectorize */) const override {
     kernel(numel, arguments.data());
   }
 
@@ -30,6 +30,11 @@ struct TensorInfo<T, 0> {
 };
 )");
 
+/*the kernel is instantiated in one of two forms (see codegen.cpp): the
+general form walks each tensor with its strides via tensorOffsets, while
+fully contiguous fusions hoist RESTRICT-qualified data pointers into
+kernelPointers and index them with linearIndex directly, which gives the
+host compiler the aliasing guarantees it needs to vectorize the loop*/
 static auto cpu_compilation_unit_template = CodeTemplate(R"(
 #include <math.h>
 #include <cstddef>
@@ -76,9 +81,17 @@ using int_same_size_t = typename int_of_size<sizeof(T)>::type;
 #define ToIndexTypeLoop(x) x
 #endif
 
+#ifdef _MSC_VER
+#define RESTRICT __restrict
+#else
+#define RESTRICT __restrict__
+#endif
+
 #define OMP_THRESHOLD 100000
 static void ${kernelName}_kernel(IndexType totalElements, ${formals}) {
-  #pragma omp parallel for if(totalElements > OMP_THRESHOLD)
+  ${kernelPointers}
+  ${reductionInits}
+  ${loopPragma}
   for (IndexTypeLoop linearIndex = 0;
         linearIndex < ToIndexTypeLoop(totalElements);
         linearIndex += 1) {
@@ -87,6 +100,7 @@ static void ${kernelName}_kernel(IndexType totalElements, ${formals}) {
       // calculate the results
       ${kernelBody}
     }
+  ${reductionEpilogue}
 }
 
 #ifdef _WIN32
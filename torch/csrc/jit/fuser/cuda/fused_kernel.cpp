@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/fuser/cuda/fused_kernel.h>
 #include <torch/csrc/jit/fuser/compiler.h>
+#include <torch/csrc/jit/fuser/kernel_cache.h>
 
 #include <ATen/ATen.h>
 #include <ATen/cuda/CUDAContext.h>
@@ -73,6 +74,7 @@ FusedKernelCUDA::FusedKernelCUDA(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
+    std::vector<bool> reduction_desc,
     bool has_random)
     : FusedKernel(
           std::move(name),
@@ -81,6 +83,7 @@ FusedKernelCUDA::FusedKernelCUDA(
           std::move(output_desc),
           std::move(chunk_desc),
           std::move(concat_desc),
+          std::move(reduction_desc),
           has_random),
       device_(device) {
   // Initializes driver's API context (if necessary)
@@ -103,42 +106,77 @@ FusedKernelCUDA::FusedKernelCUDA(
   int major, minor;
   getMajorMinor(prop_, major, minor);
 
-  // Creates the NVRTC program
-  nvrtcProgram program;
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
-      &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
+  // Key for the on-disk kernel cache (see kernel_cache.h): identical source
+  // compiled by the same NVRTC for the same architecture yields the same
+  // PTX, so a process hitting a previously seen fusion spec skips NVRTC
+  // entirely. The payload is PTX rather than a cubin -- PTX is what NVRTC
+  // produces here, and the driver caches its own SASS JIT of it.
+  int nvrtc_major, nvrtc_minor;
+  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcVersion(&nvrtc_major, &nvrtc_minor));
+  std::stringstream cache_key;
+  cache_key << "fuser_" << std::hex << hashKernelSource(code_) << std::dec
+            << "_cc" << major << minor << "_cuda" << CUDA_VERSION << "_nvrtc"
+            << nvrtc_major << "." << nvrtc_minor << ".ptx";
+
+  // A truncated or stale cache entry must not break execution, so the
+  // cached PTX is handed to the driver tentatively and rejected entries
+  // fall through to a fresh compile (which overwrites them).
+  bool module_loaded = false;
+  const auto cached_ptx = loadKernelFromDiskCache(cache_key.str());
+  if (cached_ptx) {
+    ptx_.assign(cached_ptx->begin(), cached_ptx->end());
+    module_loaded =
+        nvrtc().cuModuleLoadData(&module_, ptx_.data()) == CUDA_SUCCESS;
+  }
+  if (!module_loaded) {
+    // Creates the NVRTC program
+    nvrtcProgram program;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcCreateProgram(
+        &program, code_.c_str(), nullptr, 0, nullptr, nullptr));
 
 #ifdef __HIP_PLATFORM_HCC__
-  std::vector<const char*> args = {};
+    std::vector<const char*> args = {};
 #else
-  const std::string compute = "--gpu-architecture=compute_" +
-      std::to_string(major) + std::to_string(minor);
-  const std::vector<const char*> args = {
-      "--std=c++11", compute.c_str(), "-default-device"};
+    const std::string compute = "--gpu-architecture=compute_" +
+        std::to_string(major) + std::to_string(minor);
+    const std::vector<const char*> args = {
+        "--std=c++11", compute.c_str(), "-default-device"};
 #endif
-  const auto result =
-      nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
-  if (result != NVRTC_SUCCESS) {
-    size_t logsize;
-    nvrtc().nvrtcGetProgramLogSize(program, &logsize);
-    std::vector<char> log(logsize);
-    nvrtc().nvrtcGetProgramLog(program, log.data());
-    std::stringstream cu;
-    cu << log.data();
-    throw std::runtime_error(cu.str());
+    const auto result =
+        nvrtc().nvrtcCompileProgram(program, args.size(), args.data());
+    if (result != NVRTC_SUCCESS) {
+      size_t logsize;
+      nvrtc().nvrtcGetProgramLogSize(program, &logsize);
+      std::vector<char> log(logsize);
+      nvrtc().nvrtcGetProgramLog(program, log.data());
+      std::stringstream cu;
+      cu << log.data();
+      throw std::runtime_error(cu.str());
+    }
+    ResourceGuard holdProgram(
+        [&] { AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
+    AT_CUDA_NVRTC_CHECK(result);
+    size_t ptx_size;
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
+    ptx_.resize(ptx_size);
+    AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
+
+    storeKernelToDiskCache(
+        cache_key.str(), std::string(ptx_.data(), ptx_.size()));
+
+    AT_CUDA_DRIVER_CHECK(nvrtc().cuModuleLoadData(&module_, ptx_.data()));
   }
-  ResourceGuard holdProgram(
-      [&] { AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcDestroyProgram(&program)); });
-  AT_CUDA_NVRTC_CHECK(result);
-  size_t ptx_size;
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTXSize(program, &ptx_size));
-  ptx_.resize(ptx_size);
-  AT_CUDA_NVRTC_CHECK(nvrtc().nvrtcGetPTX(program, ptx_.data()));
-
-  AT_CUDA_DRIVER_CHECK(nvrtc().cuModuleLoadData(&module_, ptx_.data()));
   AT_CUDA_DRIVER_CHECK(
       nvrtc().cuModuleGetFunction(&function_, module_, name_.c_str()));
 
+  // The codegen emits an additional "<name>_vec" entry point when every
+  // tensor in the fusion is fully contiguous (see codegen.cpp). Its absence
+  // is expected for strided fusions, so a failed lookup is not an error.
+  if (nvrtc().cuModuleGetFunction(
+          &vec_function_, module_, (name_ + "_vec").c_str()) != CUDA_SUCCESS) {
+    vec_function_ = nullptr;
+  }
+
   // Computes max blocks
 #ifdef __HIP_PLATFORM_HCC__
   // XXX HIP function signature is not compatible yet
@@ -162,13 +200,20 @@ static int ceilDiv(const int a, const int b) {
 
 void FusedKernelCUDA::launch_raw(
     const uint32_t numel,
-    std::vector<void*>& arguments) const {
+    std::vector<void*>& arguments,
+    const bool vectorize) const {
   at::cuda::CUDAGuard{device_};
   // Hacked at::DeviceGuard (see note above)
   const auto prior_device = at::cuda::current_device();
   at::cuda::set_device(device_);
 
-  const auto nBlocks = std::min(maxBlocks_, ceilDiv(numel, kBlockSize));
+  // Uses the vectorized entry point when the module has one and the
+  // executor's runtime checks passed; it covers four elements per thread,
+  // so a quarter of the threads are needed (numel is a multiple of four
+  // whenever vectorize is true).
+  const bool use_vec = vectorize && vec_function_ != nullptr;
+  const auto work_items = use_vec ? numel / 4 : numel;
+  const auto nBlocks = std::min(maxBlocks_, ceilDiv(work_items, kBlockSize));
 
   // Adds random state to arguments if necessary
   // Note: philox_engine_inputs defined here so its lifetime extends to the launch
@@ -189,7 +234,7 @@ void FusedKernelCUDA::launch_raw(
   // Launches kernel on current stream (device was set by executor)
   auto stream = at::cuda::getCurrentCUDAStream();
   AT_CUDA_DRIVER_CHECK(nvrtc().cuLaunchKernel(
-      function_,
+      use_vec ? vec_function_ : function_,
       nBlocks,
       1,
       1,
@@ -217,6 +262,7 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
     std::vector<TensorDesc> output_desc,
     std::vector<PartitionDesc> chunk_desc,
     std::vector<PartitionDesc> concat_desc,
+    std::vector<bool> reduction_desc,
     bool has_random) {
   return std::make_shared<FusedKernelCUDA>(
       device,
@@ -226,6 +272,7 @@ static std::shared_ptr<FusedKernel> createFusionKernel(
       std::move(output_desc),
       std::move(chunk_desc),
       std::move(concat_desc),
+      std::move(reduction_desc),
       has_random);
 }
 
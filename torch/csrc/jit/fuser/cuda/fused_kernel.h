@@ -28,12 +28,15 @@ struct TORCH_CUDA_API FusedKernelCUDA : public ::torch::jit::fuser::FusedKernel
       std::vector<TensorDesc> output_desc,
       std::vector<PartitionDesc> chunk_desc,
       std::vector<PartitionDesc> concat_desc,
+      std::vector<bool> reduction_desc,
       bool has_random);
 
   ~FusedKernelCUDA() override;
 
-  void launch_raw(const uint32_t numel, std::vector<void*>& arguments)
-      const override;
+  void launch_raw(
+      const uint32_t numel,
+      std::vector<void*>& arguments,
+      const bool vectorize) const override;
 
   at::Backend backend() const override {
     return at::Backend::CUDA;
@@ -50,6 +53,9 @@ struct TORCH_CUDA_API FusedKernelCUDA : public ::torch::jit::fuser::FusedKernel
   std::vector<char> ptx_;
   CUmodule module_;
   CUfunction function_;
+  // Optional "<name>_vec" entry point processing four elements per thread;
+  // nullptr when the codegen could not vectorize this fusion.
+  CUfunction vec_function_;
 };
 
 } // namespace cuda
@@ -12,6 +12,7 @@
 #include <torch/csrc/jit/fuser/tensor_info.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream> // TODO: remove, debugging only
 #include <map>
 #include <stdexcept>
@@ -245,12 +246,24 @@ void launchFusion(
   arguments.reserve(3 + scalar_inputs.size() + flat_inputs_size + flat_outputs_size);
   arguments.push_back(&numel);
 
+  // The compiled fusion may include a vectorized entry point that moves four
+  // elements per thread through aligned vector loads and stores (see
+  // codegen.cpp). Whether it may run depends on the runtime values: numel
+  // must be a multiple of four (there is no scalar tail loop) and every
+  // tensor pointer must be aligned for a four-element vector of its type,
+  // so check both here while laying out the TensorInfo structs.
+  bool can_vectorize = (numel % 4 == 0);
+
   auto addTensorInfoRaw = [&](const TensorDesc& desc,
                               void* data_ptr,
                               at::IntArrayRef sizes,
                               at::IntArrayRef strides) {
     const auto nDim = desc.nDim(); // NOTE: this is the compressed dim
     AT_ASSERT(nDim <= uncompressedDim); // We'd overflow the space otherwise
+    const size_t vec_bytes = 4 * elementSize(desc.scalar_type);
+    if (reinterpret_cast<uintptr_t>(data_ptr) % vec_bytes != 0) {
+      can_vectorize = false;
+    }
     auto ti = reinterpret_cast<TensorInfo*>(buffer_next);
     ti->data = data_ptr;
     compressContiguous(
@@ -292,7 +305,16 @@ void launchFusion(
   const auto& ref_options = inputs[0].options();
   for (size_t i = 0; i < fusion.outputDesc().size(); ++i) {
     const auto& c = fusion.concatDesc()[i];
-    if (c.isNoop()) {
+    if (fusion.reductionDesc()[i]) {
+      // Reduction outputs are zero-dimensional and must start at zero: the
+      // kernel accumulates partial sums into them (with atomicAdd on CUDA)
+      // rather than overwriting. The kernel itself addresses the output as a
+      // one-element contiguous buffer.
+      outputs.push_back(at::zeros(
+          {}, ref_options.dtype(fusion.outputDesc()[i].scalar_type)));
+      addTensorInfoRaw(
+          fusion.outputDesc()[i], outputs[i].data_ptr(), {1}, {1});
+    } else if (c.isNoop()) {
       outputs.push_back(at::empty(
           map_size, ref_options.dtype(fusion.outputDesc()[i].scalar_type)));
       addTensorInfo(fusion.outputDesc()[i], outputs[i]);
@@ -316,7 +338,7 @@ void launchFusion(
   // Skip launching the kernel for zero-element tensor inputs
   // launches are skipped, empty zero-sized output is returned
   if (numel > 0) {
-    fusion.launch_raw(numel, arguments);
+    fusion.launch_raw(numel, arguments, can_vectorize);
   }
 }
 
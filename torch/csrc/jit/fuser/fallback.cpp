@@ -23,23 +23,34 @@ c10::OperatorOptions aliasAnalysisIsSpecialCase() {
 
 // Registers fused operators so that fused graphs can properly generate fallback
 // code.
-RegisterOperators reg_fused_operators({Operator(
-    prim::FusedConcat,
-    [](const Node* node) -> Operation {
-      int64_t dim = node->i(attr::dim);
-      int64_t num_inputs = node->inputs().size();
-      return [dim, num_inputs](Stack& stack) {
-        auto result = at::cat(
-            fmap(
-                last(stack, num_inputs),
-                [](const IValue& i) { return i.toTensor(); }),
-            dim);
-        drop(stack, num_inputs);
-        pack(stack, std::move(result));
-        return 0;
-      };
-    },
-    aliasAnalysisIsSpecialCase())});
+RegisterOperators reg_fused_operators(
+    {Operator(
+         prim::FusedConcat,
+         [](const Node* node) -> Operation {
+           int64_t dim = node->i(attr::dim);
+           int64_t num_inputs = node->inputs().size();
+           return [dim, num_inputs](Stack& stack) {
+             auto result = at::cat(
+                 fmap(
+                     last(stack, num_inputs),
+                     [](const IValue& i) { return i.toTensor(); }),
+                 dim);
+             drop(stack, num_inputs);
+             pack(stack, std::move(result));
+             return 0;
+           };
+         },
+         aliasAnalysisIsSpecialCase()),
+     Operator(
+         prim::FusedSum,
+         [](const Node*) -> Operation {
+           return [](Stack& stack) {
+             auto result = at::sum(pop(stack).toTensor());
+             pack(stack, std::move(result));
+             return 0;
+           };
+         },
+         aliasAnalysisIsSpecialCase())});
 
 void runFallback(int64_t key, Stack& stack) {
   auto maybe_spec = retrieve(key);
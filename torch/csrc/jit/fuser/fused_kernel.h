@@ -23,6 +23,7 @@ struct FusedKernel {
       std::vector<TensorDesc> output_desc,
       std::vector<PartitionDesc> chunk_desc,
       std::vector<PartitionDesc> concat_desc,
+      std::vector<bool> reduction_desc,
       bool has_random)
       : name_(std::move(name)),
         code_(std::move(code)),
@@ -30,6 +31,7 @@ struct FusedKernel {
         output_desc_(std::move(output_desc)),
         chunk_desc_(std::move(chunk_desc)),
         concat_desc_(std::move(concat_desc)),
+        reduction_desc_(std::move(reduction_desc)),
         has_random_(has_random) {}
 
   virtual ~FusedKernel() = default;
@@ -44,8 +46,14 @@ struct FusedKernel {
   // launch_with_tensors handles packing at::Tensors into this arguments array.
   // CPU code uses the same convension so that launch_with_tensors can be
   // shared.
-  virtual void launch_raw(const uint32_t numel, std::vector<void*>& arguments)
-      const = 0;
+  // vectorize is true when the runtime checks in the executor passed (numel
+  // is a multiple of four and every tensor pointer is aligned for four-wide
+  // vector accesses); backends that compiled a vectorized entry point may
+  // then use it. It is a hint: backends without one ignore it.
+  virtual void launch_raw(
+      const uint32_t numel,
+      std::vector<void*>& arguments,
+      const bool vectorize) const = 0;
   virtual at::Backend backend() const = 0;
 
   // Getters
@@ -67,6 +75,9 @@ struct FusedKernel {
   const std::vector<PartitionDesc>& concatDesc() const {
     return concat_desc_;
   }
+  const std::vector<bool>& reductionDesc() const {
+    return reduction_desc_;
+  }
   bool hasRandom() const {
     return has_random_;
   }
@@ -87,6 +98,11 @@ struct FusedKernel {
   // many subtensors that the fusion group produces
   const std::vector<PartitionDesc> concat_desc_;
 
+  // same size as output_desc, true when the output is a
+  // scalar the kernel accumulates across the whole launch
+  // instead of a map-sized tensor it writes elementwise
+  const std::vector<bool> reduction_desc_;
+
   const bool has_random_;
 };
 
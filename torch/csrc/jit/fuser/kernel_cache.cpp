@@ -3,9 +3,22 @@
 #include <torch/csrc/jit/passes/shape_analysis.h>
 
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <mutex>
+#include <sstream>
 #include <unordered_map>
 
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
 namespace torch {
 namespace jit {
 namespace fuser {
@@ -75,6 +88,109 @@ at::optional<KernelSpec*> retrieve(const int64_t key) {
   return nolock_retrieve(cache, key);
 }
 
+// mkdir -p: creates each component of the path, tolerating existing ones.
+// Returns true iff the full path is a directory afterwards.
+static bool ensureCacheDirExists(const std::string& dir) {
+  std::string partial;
+  for (size_t i = 0; i < dir.size(); ++i) {
+    partial.push_back(dir[i]);
+    if ((dir[i] == '/' || i + 1 == dir.size()) && partial != "/") {
+#ifdef _WIN32
+      _mkdir(partial.c_str());
+#else
+      mkdir(partial.c_str(), 0700);
+#endif
+    }
+  }
+#ifdef _WIN32
+  struct _stat st;
+  return _stat(dir.c_str(), &st) == 0 && (st.st_mode & _S_IFDIR);
+#else
+  struct stat st;
+  return stat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+#endif
+}
+
+// Resolves the cache directory once per process (see the note in
+// kernel_cache.h for the resolution order). Empty means caching is disabled.
+static const std::string& diskCacheDir() {
+  static std::string dir = []() -> std::string {
+    const char* env = getenv("PYTORCH_KERNEL_CACHE_PATH");
+    if (env != nullptr) {
+      return std::string(env);
+    }
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    if (xdg != nullptr && *xdg != '\0') {
+      return std::string(xdg) + "/torch/kernels";
+    }
+    const char* home = getenv("HOME");
+    if (home != nullptr && *home != '\0') {
+      return std::string(home) + "/.cache/torch/kernels";
+    }
+    return std::string();
+  }();
+  return dir;
+}
+
+uint64_t hashKernelSource(const std::string& source) {
+  // FNV-1a, 64 bit
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (const char c : source) {
+    hash ^= static_cast<uint64_t>(static_cast<unsigned char>(c));
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+at::optional<std::string> loadKernelFromDiskCache(const std::string& key) {
+  const auto& dir = diskCacheDir();
+  if (dir.empty()) {
+    return at::nullopt;
+  }
+  std::ifstream in(dir + "/" + key, std::ios::binary);
+  if (!in) {
+    return at::nullopt;
+  }
+  std::ostringstream payload;
+  payload << in.rdbuf();
+  if (in.bad()) {
+    return at::nullopt;
+  }
+  return payload.str();
+}
+
+void storeKernelToDiskCache(const std::string& key, const std::string& payload) {
+  const auto& dir = diskCacheDir();
+  if (dir.empty() || !ensureCacheDirExists(dir)) {
+    return;
+  }
+  // Writes to a process-unique temporary and renames it into place, so
+  // concurrent processes racing on the same key never observe a partial
+  // entry (rename within a directory is atomic on POSIX).
+  const std::string path = dir + "/" + key;
+#ifdef _WIN32
+  const auto pid = _getpid();
+#else
+  const auto pid = getpid();
+#endif
+  const std::string tmp = path + ".tmp." + std::to_string(pid);
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      return;
+    }
+    out.write(payload.data(), payload.size());
+    if (!out.good()) {
+      out.close();
+      std::remove(tmp.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+  }
+}
+
 // precondition: graph has been normalized via normalizeGraphForCache
 at::optional<KernelSpec*> lookupGraph(std::shared_ptr<Graph> graph) {
   auto& cache = getKernelCache();
@@ -31,6 +31,31 @@ TORCH_API at::optional<KernelSpec*> retrieve(const int64_t key);
 // Only used for testing.
 TORCH_API int64_t debugNumCachedKernelSpecs();
 
+// On-disk compiled kernel cache.
+//
+// Backends may persist compiled kernel artifacts (e.g. NVRTC PTX) across
+// processes so warm starts skip compilation. Entries are opaque payloads
+// keyed by a string the backend derives from the kernel source and the
+// toolchain/device versions it compiled for. The cache directory is taken
+// from PYTORCH_KERNEL_CACHE_PATH (set it to the empty string to disable
+// caching), falling back to $XDG_CACHE_HOME/torch/kernels and then
+// $HOME/.cache/torch/kernels; when no directory can be resolved or created,
+// loads miss and stores are no-ops.
+
+// Stable 64-bit hash of kernel source, for building cache keys
+// (std::hash is not specified to be stable across processes)
+TORCH_API uint64_t hashKernelSource(const std::string& source);
+
+// Returns the cached payload for the given key (if it exists)
+TORCH_API at::optional<std::string> loadKernelFromDiskCache(
+    const std::string& key);
+
+// Persists the payload under the given key; failures are silently ignored
+// (the cache is strictly an optimization)
+TORCH_API void storeKernelToDiskCache(
+    const std::string& key,
+    const std::string& payload);
+
 } // namespace fuser
 } // namespace jit
 } // namespace torch
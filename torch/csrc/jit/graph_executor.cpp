@@ -42,7 +42,9 @@
 #include <torch/csrc/jit/script/logging.h>
 
 #include <cstdint>
+#include <cstdlib>
 #include <iterator>
+#include <list>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -482,6 +484,23 @@ void GraphExecutorImplBase::run(Stack& stack) {
   last_executed_optimized_graph = plan.graph;
 }
 
+// The plan cache is bounded so argument configurations that keep changing
+// (e.g. inputs whose dimensionality or requires_grad state varies per call)
+// cannot grow it without limit. PYTORCH_JIT_PLAN_CACHE_SIZE overrides the
+// bound; 0 means unbounded. See also PYTORCH_JIT_SHAPE_BUCKET in
+// argument_spec.h for coarsening the keys themselves.
+static size_t getPlanCacheCapacity() {
+  static const size_t capacity = []() -> size_t {
+    const char* env = std::getenv("PYTORCH_JIT_PLAN_CACHE_SIZE");
+    if (env == nullptr) {
+      return 512;
+    }
+    const int64_t parsed = std::atol(env);
+    return parsed > 0 ? static_cast<size_t>(parsed) : 0;
+  }();
+  return capacity;
+}
+
 // a Graph can be created via tracing, or via a language-based frontend
 // GraphExecutor runs it. It can run the same graph on many different sizes
 // and different requires_grad states, and handles specializations for each
@@ -506,7 +525,7 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
       state.fallback = fallback;
     }
     for (auto& entry : plan_cache) {
-      state.execution_plans.emplace(entry.first, entry.second);
+      state.execution_plans.emplace(entry.first, entry.second.plan);
     }
     return state;
   }
@@ -524,7 +543,10 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
     return fallback;
   }
 
-  const ExecutionPlan& getOrCompile(const Stack& stack) {
+  // Returns the plan by value: eviction may invalidate references into the
+  // cache once the lock is dropped, and a plan is just a graph and a Code
+  // handle.
+  ExecutionPlan getOrCompile(const Stack& stack) {
     // outside lock guard, to minimize the time holding the lock on the fast
     // path ArgumentSpec even computes its hashCode here.
     ArgumentSpec spec =
@@ -533,15 +555,25 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
       std::lock_guard<std::mutex> lock(compile_mutex);
       auto it = plan_cache.find(spec);
       if (it != plan_cache.end()) {
+        plan_cache_lru.splice(
+            plan_cache_lru.begin(), plan_cache_lru, it->second.lru_position);
         logging::getLogger()->addStatValue(
             logging::runtime_counters::EXECUTION_PLAN_CACHE_HIT, 1.0);
-        return it->second;
+        return it->second.plan;
       }
       auto plan = compileSpec(spec);
-      auto r = plan_cache.emplace(std::move(spec), std::move(plan));
+      const size_t capacity = getPlanCacheCapacity();
+      if (capacity != 0 && plan_cache.size() >= capacity) {
+        plan_cache.erase(plan_cache_lru.back());
+        plan_cache_lru.pop_back();
+      }
+      plan_cache_lru.push_front(spec);
+      auto r = plan_cache.emplace(
+          std::move(spec),
+          CachedPlan{std::move(plan), plan_cache_lru.begin()});
       logging::getLogger()->addStatValue(
           logging::runtime_counters::EXECUTION_PLAN_CACHE_MISS, 1.0);
-      return r.first->second;
+      return r.first->second.plan;
     }
   }
 
@@ -617,8 +649,15 @@ struct GraphExecutorImpl : public GraphExecutorImplBase {
   ExecutionPlan fallback;
 
   // Mapping from argument configurations to optimized versions of the graph
-  // that are specialized to the spec.
-  std::unordered_map<ArgumentSpec, ExecutionPlan> plan_cache;
+  // that are specialized to the spec. Holds at most getPlanCacheCapacity()
+  // entries; inserting past that evicts the least recently used plan.
+  // plan_cache_lru lists the cached specs from most to least recently used.
+  struct CachedPlan {
+    ExecutionPlan plan;
+    std::list<ArgumentSpec>::iterator lru_position;
+  };
+  std::list<ArgumentSpec> plan_cache_lru;
+  std::unordered_map<ArgumentSpec, CachedPlan> plan_cache;
 };
 
 GraphExecutor::GraphExecutor(std::shared_ptr<Graph> graph)
@@ -12,7 +12,6 @@
 #include <torch/csrc/jit/script/script_type_parser.h>
 #include <torch/csrc/jit/source_range_serialization.h>
 
-#include "caffe2/serialize/file_adapter.h"
 #include "caffe2/serialize/inline_container.h"
 #include "caffe2/serialize/istream_adapter.h"
 
@@ -26,7 +25,6 @@
 namespace torch {
 namespace jit {
 
-using caffe2::serialize::FileAdapter;
 using caffe2::serialize::IStreamAdapter;
 using caffe2::serialize::PyTorchStreamReader;
 using caffe2::serialize::ReadAdapterInterface;
@@ -241,9 +239,16 @@ script::Module load(
     const std::string& filename,
     c10::optional<at::Device> device,
     script::ExtraFilesMap& extra_files) {
-  std::unique_ptr<FileAdapter> rai = caffe2::make_unique<FileAdapter>(filename);
-  auto module = load(std::move(rai), device, extra_files);
-  return module;
+  // Construct the reader from the file name rather than through a
+  // FileAdapter: a file-backed reader returns tensor records as
+  // copy-on-write mappings of the archive, so tensor storages are thunks
+  // over the file whose pages are only materialized (read) when first
+  // accessed. Models whose weights are only partially used never pay the
+  // read or resident memory for the untouched records.
+  auto reader = torch::make_unique<PyTorchStreamReader>(filename);
+  auto cu = std::make_shared<script::CompilationUnit>();
+  ScriptModuleDeserializer deserializer(std::move(cu), std::move(reader));
+  return deserializer.deserialize(device, extra_files);
 }
 
 script::Module load(
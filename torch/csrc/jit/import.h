@@ -48,6 +48,12 @@ TORCH_API script::Module load(
 /// The file stored at the location given in `filename` must contain a
 /// serialized `script::Module`, exported either via `ScriptModule.save()` in
 /// Python or `torch::jit::ExportModule` in C++.
+///
+/// On platforms with mmap, tensors loaded to the CPU are lazily
+/// materialized: their storages are copy-on-write mappings of the archive,
+/// and the data of a given tensor is only read from disk when that tensor
+/// is first accessed. Models whose weights are only partially used thus
+/// start up faster and keep a smaller resident set than the file size.
 TORCH_API script::Module load(
     const std::string& filename,
     c10::optional<c10::Device> device = c10::nullopt,
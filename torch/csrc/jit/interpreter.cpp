@@ -4,6 +4,7 @@
 #include <ATen/core/ivalue.h>
 #include <c10/core/thread_pool.h>
 #include <c10/util/Exception.h>
+#include <c10/util/FlightRecorder.h>
 #include <torch/csrc/autograd/edge.h>
 #include <torch/csrc/autograd/grad_mode.h>
 #include <torch/csrc/autograd/variable.h>
@@ -17,6 +18,9 @@
 #include <torch/csrc/jit/script/compilation_unit.h>
 #include <torch/csrc/jit/script/jit_exception.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <exception>
 #include <iostream>
 #include <memory>
@@ -304,6 +308,18 @@ struct PreprocessGraph {
   std::unordered_map<Node*, bool> can_emit_inline;
 };
 
+// see setNodeCostRecordingEnabled(); checked with a relaxed load in the
+// dispatch loop's OP case.
+static std::atomic<bool> node_cost_recording_enabled{false};
+
+void setNodeCostRecordingEnabled(bool enabled) {
+  node_cost_recording_enabled.store(enabled);
+}
+
+bool nodeCostRecordingEnabled() {
+  return node_cost_recording_enabled.load(std::memory_order_relaxed);
+}
+
 // for keeping track of the current node
 struct WithCurrentNode {
   WithCurrentNode(Node** loc, Node* new_value) : loc_(loc), old_value_(*loc_) {
@@ -337,6 +353,17 @@ struct CodeImpl {
   // instruction to be emitted?
   std::vector<Node*> instructions_source_;
 
+  // Cumulative runtime per instruction (same length as instructions_),
+  // written by the OP case of the dispatch loop while node cost recording
+  // is enabled. Relaxed atomics because the same Code may run on several
+  // threads at once. Allocated once at the end of construction, when the
+  // instruction count is final.
+  struct InstructionCost {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> time_ns{0};
+  };
+  std::unique_ptr<InstructionCost[]> op_costs_;
+
   std::vector<IValue> constant_table_;
   std::vector<Operation> operator_table_;
   std::vector<Function*> function_table_;
@@ -346,6 +373,16 @@ struct CodeImpl {
   size_t n_inputs;
   TypePtr return_type_;
 
+  // Upper bound on how many stack slots this function's instructions can
+  // occupy beyond its base pointer, computed while emitting by simulating
+  // each instruction's stack effect (branch arms are simulated separately
+  // and joined with max). InterpreterState uses it to reserve the whole
+  // frame up front instead of growing the stack mid-run. Callees are not
+  // included -- they reserve their own depth when their frame is entered.
+  size_t max_stack_size_ = 0;
+  // stack depth at the current emission point (see trackStackEffect)
+  int64_t cur_stack_depth_ = 0;
+
   // We MUST hold onto graph here because some Operators stored in the
   // instruction lists have dependencies on meta-data stored in the graph
   // that would be dead otherwise.
@@ -388,6 +425,7 @@ struct CodeImpl {
     // we deferred the emission of bailout blocks so they appear at the end
     // emit them now and patch up the jumps
     insertBailoutBlocks();
+    op_costs_.reset(new InstructionCost[instructions_.size()]);
   }
 
   const std::vector<c10::IValue>& constant_table() const {
@@ -402,10 +440,48 @@ struct CodeImpl {
     return instructions_source_;
   }
 
+  // Applies a net stack effect at the current emission point and folds the
+  // running depth into max_stack_size_. The depth is clamped at zero: some
+  // effects (OP, LOOP) are applied by the emitters rather than per
+  // instruction, so out-of-order bookkeeping must not underflow.
+  void trackStackEffect(int64_t delta) {
+    cur_stack_depth_ += delta;
+    if (cur_stack_depth_ < 0) {
+      cur_stack_depth_ = 0;
+    }
+    max_stack_size_ =
+        std::max(max_stack_size_, static_cast<size_t>(cur_stack_depth_));
+  }
+
   void insertInstruction(OpCode op, int64_t X = 0, uint64_t N = 0) {
     instructions_.emplace_back(op, X, N);
     instructions_source_.emplace_back(current_node_);
 
+    // Instructions with a fixed stack effect are tracked here; OP's effect
+    // depends on the operator (see emitOperator) and LOOP's on which way
+    // the branch goes (see emitLoop).
+    switch (op) {
+      case LOAD:
+      case MOVE:
+      case LOADC:
+      case GUARD:
+        trackStackEffect(1);
+        break;
+      case STORE:
+      case DROP:
+      case JF:
+        trackStackEffect(-1);
+        break;
+      case STOREN:
+        trackStackEffect(-static_cast<int64_t>(N));
+        break;
+      case SET_ATTR:
+        trackStackEffect(-2);
+        break;
+      default:
+        break;
+    }
+
     // check that we didn't accidentally emit nodes out of topological order
     if (op == OP) {
       if (last_inserted_op_ != nullptr && current_node_ != last_inserted_op_ &&
@@ -489,6 +565,9 @@ struct CodeImpl {
     emitLoadInputs(node->inputs());
     insertInstruction(OP, operator_table_.size());
     operator_table_.emplace_back(getOperation(node));
+    trackStackEffect(
+        static_cast<int64_t>(node->outputs().size()) -
+        static_cast<int64_t>(node->inputs().size()));
   }
 
   void emitWait(Node* node) {
@@ -533,12 +612,18 @@ struct CodeImpl {
     emitLoadInputs(node->inputs());
     size_t start_if = instructions_.size();
     insertInstruction(JF, 0); // dummy offset to be filled in
+    // both arms start from the depth at the branch; the depth after the
+    // node is whichever arm goes deeper
+    const auto depth_at_branch = cur_stack_depth_;
     emitCodeForBlock(node->blocks().at(0));
+    const auto depth_after_then = cur_stack_depth_;
     insertInstruction(JMP, 0); // dummy offset
     size_t start_else = instructions_.size();
     instructions_[start_if].X = start_else - start_if;
+    cur_stack_depth_ = depth_at_branch;
     emitCodeForBlock(node->blocks().at(1));
     instructions_[start_else - 1].X = instructions_.size() - (start_else - 1);
+    cur_stack_depth_ = std::max(cur_stack_depth_, depth_after_then);
   }
 
   void emitLoop(Node* loop) {
@@ -549,6 +634,8 @@ struct CodeImpl {
     emitCodeForBlock(loop->blocks().at(0));
     insertInstruction(JMP, start - instructions_.size());
     instructions_[start].X = instructions_.size() - start;
+    // on exit LOOP pops iteration_count, max_iter, and cond
+    trackStackEffect(-3);
   }
 
   void emitCall(
@@ -736,6 +823,36 @@ struct CodeImpl {
   }
 };
 
+// Computed-goto ("threaded") dispatch for the instruction loop below. With
+// GCC/Clang labels-as-values, every handler ends by jumping directly to the
+// next instruction's handler, so the branch predictor keeps per-opcode
+// indirect-branch history instead of funnelling every instruction through
+// one shared switch branch. Each case is written as `case INST(NAME):`,
+// which in threaded mode expands to both the case label (used for the very
+// first dispatch) and the goto label the dispatch table points at; in the
+// fallback mode (MSVC, or with TORCH_JIT_NO_COMPUTED_GOTO defined) the same
+// bodies run under the plain switch loop.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(TORCH_JIT_NO_COMPUTED_GOTO)
+#define JIT_USE_COMPUTED_GOTO
+#endif
+
+#if defined(JIT_USE_COMPUTED_GOTO)
+#define INST(NAME) \
+  NAME:            \
+  label_##NAME
+#define INST_DISPATCH goto* dispatch_table[inst.op]
+#else
+#define INST(NAME) NAME
+#define INST_DISPATCH break
+#endif
+
+// af.pc always holds the index of the instruction currently in `inst`
+#define INST_FETCH(X) (af.instructions[af.pc += (X)])
+#define INST_NEXT       \
+  inst = INST_FETCH(1); \
+  INST_DISPATCH
+
 // InterpreterState state that and used to compute a Code
 struct InterpreterStateImpl : c10::intrusive_ptr_target {
   InterpreterStateImpl(const Code& code) {
@@ -786,6 +903,8 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
     Operation* operators;
     Function** functions;
     TypePtr* types;
+    CodeImpl::InstructionCost* op_costs;
+    Node** sources;
 
     ActiveFrame(const Frame& frame)
         : pc(frame.pc),
@@ -793,7 +912,9 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
           constants(frame.function->constant_table_.data()),
           operators(frame.function->operator_table_.data()),
           functions(frame.function->function_table_.data()),
-          types(frame.function->type_table_.data()) {}
+          types(frame.function->type_table_.data()),
+          op_costs(frame.function->op_costs_.get()),
+          sources(frame.function->instructions_source_.data()) {}
   };
 
   std::vector<Frame> frames;
@@ -821,6 +942,14 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
     return *(registers.end() - reg);
   }
 
+  // Reserves the frame's whole worst-case stack footprint (precomputed per
+  // CodeImpl at emission time) so the run never reallocates the stack
+  // mid-execution. Called when a frame starts running, not in enterFrame,
+  // because the constructor enters the first frame before any stack exists.
+  void reserveFrame(Stack& stack) {
+    stack.reserve(stack.size() + frames.back().function->max_stack_size_);
+  }
+
   void dump(std::ostream& out, const Stack& stack) const {
     out << "Stack:\n";
     for (const auto& val : stack) {
@@ -842,69 +971,96 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
       stack_start_ = 0;
     }
 
+    reserveFrame(stack);
+
     ActiveFrame af(frames.back());
     try {
+#if defined(JIT_USE_COMPUTED_GOTO)
+      // One label per opcode, in OpCode (i.e. FORALL_OPCODES) order, so
+      // opcodes index the table directly.
+      static const void* dispatch_table[] = {
+#define DISPATCH_TABLE_ENTRY(op, _) &&label_##op,
+          FORALL_OPCODES(DISPATCH_TABLE_ENTRY)
+#undef DISPATCH_TABLE_ENTRY
+      };
+#endif
+      Instruction inst = INST_FETCH(0);
       while (true) {
 //         std::cout << "RUNNING ";
 //         frames.back().function->dump(std::cout, af.pc);
-        Instruction inst = af.instructions[af.pc];
         switch (inst.op) {
-          case OP:
-            af.operators[inst.X](stack);
-            ++af.pc;
-            break;
-          case OPN:
+          case INST(OP):
+            if (C10_UNLIKELY(c10::FlightRecorderEnabled())) {
+              c10::FlightRecord(
+                  c10::FlightEventType::OP_BEGIN,
+                  af.sources[af.pc]->kind().toQualString());
+            }
+            if (C10_UNLIKELY(nodeCostRecordingEnabled())) {
+              const auto op_start = std::chrono::steady_clock::now();
+              af.operators[inst.X](stack);
+              const uint64_t elapsed_ns =
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - op_start)
+                      .count();
+              auto& cost = af.op_costs[af.pc];
+              cost.count.fetch_add(1, std::memory_order_relaxed);
+              cost.time_ns.fetch_add(elapsed_ns, std::memory_order_relaxed);
+            } else {
+              af.operators[inst.X](stack);
+            }
+            if (C10_UNLIKELY(c10::FlightRecorderEnabled())) {
+              c10::FlightRecord(c10::FlightEventType::OP_END, "");
+            }
+            INST_NEXT;
+          case INST(OPN):
             AT_ERROR("OPN is currently supported in mobile mode only.");
-            break;
-          case LOAD:
+            INST_NEXT;
+          case INST(LOAD):
             stack.emplace_back(reg(inst.X));
-            ++af.pc;
-            break;
-          case MOVE:
+            INST_NEXT;
+          case INST(MOVE):
             stack.emplace_back(std::move(reg(inst.X)));
-            ++af.pc;
-            break;
-          case STORE:
+            INST_NEXT;
+          case INST(STORE):
             reg(inst.X) = pop(stack);
-            ++af.pc;
-            break;
-          case STOREN:
+            INST_NEXT;
+          case INST(STOREN):
             for (size_t i = inst.N; i > 0; --i) {
               reg(inst.X + i - 1) = pop(stack);
             }
-            ++af.pc;
-            break;
-          case DROP:
+            INST_NEXT;
+          case INST(DROP):
             pop(stack);
-            ++af.pc;
-            break;
-          case DROPR:
+            INST_NEXT;
+          case INST(DROPR):
             reg(inst.X) = IValue();
-            ++af.pc;
-            break;
-          case LOADC:
+            INST_NEXT;
+          case INST(LOADC):
             stack.emplace_back(af.constants[inst.X]);
-            ++af.pc;
-            break;
-          case GET_ATTR: {
+            INST_NEXT;
+          case INST(GET_ATTR): {
             auto userObj = pop(stack).toObject();
             auto value = userObj->getSlot(inst.X);
             push(stack, std::move(value));
-            ++af.pc;
-          } break;
-          case SET_ATTR: {
+          }
+            INST_NEXT;
+          case INST(SET_ATTR): {
             auto v = pop(stack);
             auto userObj = pop(stack).toObject();
             userObj->setSlot(inst.X, std::move(v));
-            ++af.pc;
-          } break;
-          case JF:
-            af.pc += (pop(stack).toBool()) ? 1 : inst.X;
-            break;
-          case JMP:
-            af.pc += inst.X;
-            break;
-          case LOOP: {
+          }
+            INST_NEXT;
+          case INST(JF):
+            if (pop(stack).toBool()) {
+              INST_NEXT;
+            } else {
+              inst = INST_FETCH(inst.X);
+              INST_DISPATCH;
+            }
+          case INST(JMP):
+            inst = INST_FETCH(inst.X);
+            INST_DISPATCH;
+          case INST(LOOP): {
             // stack: iteration_count, max_iter, cond, loop_carried_deps...
             auto frame = stack.end() - (inst.N + 1);
             int64_t trip_count = frame[0].toInt();
@@ -913,24 +1069,28 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             if (trip_count < max_trip_count && cond) {
               frame[2] = trip_count;
               frame[0] = trip_count + 1;
-              ++af.pc;
+              INST_NEXT;
             } else {
               size_t n_loop_carried = inst.N - 2;
               for (size_t i = 0; i < n_loop_carried; ++i) {
                 frame[i] = std::move(frame[i + 3]);
               }
               drop(stack, 3); // iteration_count, max_iter, cond
-              af.pc += inst.X;
+              inst = INST_FETCH(inst.X);
+              INST_DISPATCH;
             }
-          } break;
-          case CALL: {
+          }
+          case INST(CALL): {
             const Code& code =
                 af.functions[inst.X]->get_executor().getPlanFor(stack).code;
             frames.back().pc = af.pc + 1;
             enterFrame(code, stack.size() - code.num_inputs());
+            reserveFrame(stack);
             af = ActiveFrame(frames.back());
-          } break;
-          case INTERFACE_CALL: {
+            inst = INST_FETCH(0);
+            INST_DISPATCH;
+          }
+          case INST(INTERFACE_CALL): {
             // note the hash table lookup to find the function
             // this can be more optimized if necessary, caching parts
             // of the hashing computation or storing the offset when
@@ -942,13 +1102,17 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             const Code& code = function->get_executor().getPlanFor(stack).code;
             frames.back().pc = af.pc + 1;
             enterFrame(code, stack.size() - inst.N);
+            reserveFrame(stack);
             af = ActiveFrame(frames.back());
-          } break;
-          case RET:
+            inst = INST_FETCH(0);
+            INST_DISPATCH;
+          }
+          case INST(RET):
             if (frames.size() > 1) {
               leaveFrame();
               af = ActiveFrame(frames.back());
-              break;
+              inst = INST_FETCH(0);
+              INST_DISPATCH;
             }
             if (future_) {
               auto num_outputs = frames.back().function->n_outputs;
@@ -960,7 +1124,7 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
               }
             }
             return false;
-          case WAIT: {
+          case INST(WAIT): {
             auto future = stack.back().toFuture();
             if (!future->completed()) {
               getOrCreateFuture();
@@ -973,10 +1137,20 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
                     Stack stack)
                     : state_(std::move(state)), stack_(std::move(stack)) {}
                 void operator()() {
-                  at::launch(InterpreterContinuation(
+                  // If the future completed on an inter-op worker, resume
+                  // the suspended interpreter right here instead of queueing
+                  // it: the completing thread steals the continuation,
+                  // saving a pool round-trip and picking up the value it
+                  // just produced while it is still cache-hot.
+                  InterpreterContinuation continuation(
                       state_,
                       std::move(stack_),
-                      autograd::GradMode::is_enabled()));
+                      autograd::GradMode::is_enabled());
+                  if (at::in_interop_thread_pool()) {
+                    continuation();
+                  } else {
+                    at::launch(std::move(continuation));
+                  }
                 }
 
                private:
@@ -1006,17 +1180,17 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             }
             stack.pop_back();
             stack.emplace_back(future->value());
-            ++af.pc;
-          } break;
-          case GUARD: {
+          }
+            INST_NEXT;
+          case INST(GUARD): {
             auto t = stack.back().toTensor();
             auto actual = t.defined() ? TensorType::create(t)
                                       : TensorType::get()->withUndefined();
             const TypePtr &expected = af.types[inst.X];
             push(stack, *expected == *actual);
-            ++af.pc;
-          } break;
-          case TAIL_CALL: {
+          }
+            INST_NEXT;
+          case INST(TAIL_CALL): {
             af.functions[inst.X]->ensure_defined();
             const Code &code =
                 af.functions[inst.X]->get_executor().getPlanFor(stack).code;
@@ -1031,8 +1205,11 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
             stack.resize(base_pointer + num_inputs);
             leaveFrame();
             enterFrame(code, base_pointer);
+            reserveFrame(stack);
             af = ActiveFrame(frames.back());
-          } break;
+            inst = INST_FETCH(0);
+            INST_DISPATCH;
+          }
         }
       }
     } catch (std::exception& e) {
@@ -1043,6 +1220,11 @@ struct InterpreterStateImpl : c10::intrusive_ptr_target {
     }
   }
 
+#undef INST
+#undef INST_DISPATCH
+#undef INST_FETCH
+#undef INST_NEXT
+
   void formatStackTrace(std::ostream& out) {
     for (size_t i = 0; i < frames.size(); ++i) {
       const Frame& frame = frames[frames.size() - 1 - i];
@@ -1140,6 +1322,60 @@ size_t Code::register_size() const {
   return pImpl->register_size_;
 }
 
+std::vector<std::pair<Node*, NodeCost>> Code::node_costs() const {
+  std::vector<std::pair<Node*, NodeCost>> result;
+  std::unordered_map<Node*, size_t> node_index;
+  for (size_t i = 0; i < pImpl->instructions_.size(); ++i) {
+    const auto& cost = pImpl->op_costs_[i];
+    const uint64_t count = cost.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+    const uint64_t time_ns = cost.time_ns.load(std::memory_order_relaxed);
+    Node* node = pImpl->instructions_source_[i];
+    auto it = node_index.find(node);
+    if (it == node_index.end()) {
+      node_index.emplace(node, result.size());
+      NodeCost node_cost;
+      node_cost.count = count;
+      node_cost.time_ns = time_ns;
+      result.emplace_back(node, node_cost);
+    } else {
+      result[it->second].second.count += count;
+      result[it->second].second.time_ns += time_ns;
+    }
+  }
+  std::sort(
+      result.begin(),
+      result.end(),
+      [](const std::pair<Node*, NodeCost>& a,
+         const std::pair<Node*, NodeCost>& b) {
+        return a.second.time_ns > b.second.time_ns;
+      });
+  return result;
+}
+
+void Code::dump_node_costs(std::ostream& out) const {
+  for (const auto& entry : node_costs()) {
+    Node* node = entry.first;
+    const NodeCost& cost = entry.second;
+    out << cost.time_ns / 1000 << " us over " << cost.count << " runs ("
+        << (cost.time_ns / cost.count) / 1000.0 << " us avg):\n";
+    out << *node;
+    if (node->sourceRange().source()) {
+      node->sourceRange().highlight(out);
+    }
+    out << "\n";
+  }
+}
+
+void Code::clear_node_costs() {
+  for (size_t i = 0; i < pImpl->instructions_.size(); ++i) {
+    pImpl->op_costs_[i].count.store(0, std::memory_order_relaxed);
+    pImpl->op_costs_[i].time_ns.store(0, std::memory_order_relaxed);
+  }
+}
+
 InterpreterState::InterpreterState(const Code& code)
     : pImpl(c10::make_intrusive<InterpreterStateImpl>(code)) {}
 InterpreterState::~InterpreterState() = default;
@@ -1,6 +1,9 @@
 #pragma once
 #include <c10/util/Optional.h>
+#include <cstdint>
+#include <iosfwd>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <ATen/core/ivalue.h>
@@ -31,6 +34,21 @@ struct Instruction;
 using Stack = std::vector<c10::IValue>;
 using c10::ivalue::Future;
 
+// Cumulative runtime cost attributed to one graph Node, collected by the
+// interpreter while node cost recording is enabled.
+struct NodeCost {
+  uint64_t count = 0;
+  uint64_t time_ns = 0;
+};
+
+// Globally enables execution attribution in the interpreter: every OP
+// instruction is timed and charged to the graph node it was emitted from.
+// Costs accumulate on the Code being run and can be queried with
+// Code::node_costs() or printed with Code::dump_node_costs(). Recording
+// adds two clock reads per executed op, so leave it off outside diagnosis.
+TORCH_API void setNodeCostRecordingEnabled(bool enabled);
+TORCH_API bool nodeCostRecordingEnabled();
+
 struct TORCH_API Code {
   Code() : pImpl(nullptr) {}
   explicit Code(const std::shared_ptr<Graph>& graph);
@@ -48,6 +66,15 @@ struct TORCH_API Code {
   const std::vector<Node*>& instructions_source() const;
   size_t register_size() const;
 
+  // Costs recorded while node cost recording was enabled, aggregated over
+  // all instructions emitted from the same node and sorted by total time,
+  // most expensive first.
+  std::vector<std::pair<Node*, NodeCost>> node_costs() const;
+  // Prints every node with recorded cost: total and average time,
+  // invocation count, the node itself and its source range.
+  void dump_node_costs(std::ostream& out) const;
+  void clear_node_costs();
+
  private:
   std::shared_ptr<CodeImpl> pImpl;
   friend struct InterpreterStateImpl;
@@ -3,6 +3,7 @@
 #include <torch/csrc/jit/script/compilation_unit.h>
 #include <torch/csrc/jit/unpickler.h>
 #include <caffe2/serialize/inline_container.h>
+#include <caffe2/serialize/mmap_adapter.h>
 #include <torch/csrc/jit/instruction.h>
 
 
@@ -36,69 +37,84 @@ namespace torch {
 namespace jit {
 using caffe2::serialize::PyTorchStreamReader;
 using caffe2::serialize::IStreamAdapter;
+using caffe2::serialize::MmapFileAdapter;
 using caffe2::serialize::ReadAdapterInterface;
 
 OpCode parseOpCode(const char *str);
 namespace {
-void parseMethods(const std::vector<IValue>& vals, std::shared_ptr<mobile::CompilationUnit> mcu) {
-  for (const auto& element : vals) {
-    const auto& m_tuple = element.toTuple()->elements();
+// Turns one method's bytecode table into a runnable Function. This is
+// where load time goes -- operator resolution against the dispatcher in
+// particular -- so it runs lazily, on the method's first lookup (see
+// parseMethods below).
+std::unique_ptr<mobile::Function> parseMethod(const c10::IValue& element) {
+  const auto& m_tuple = element.toTuple()->elements();
+
+  auto function = std::unique_ptr<mobile::Function>(new mobile::Function(
+      c10::QualifiedName(m_tuple[0].toString()->string())));
+  auto comps = m_tuple[1].toTuple()->elements();
+
+  // The sequence of the named tuple is 0: instructions, 1: operators,
+  // 2: constants, 3: register_size
+  auto named_ins = comps[0].toTuple()->elements();
+  auto ins_name = named_ins[0].toString()->string();
+  TORCH_CHECK(ins_name == "instructions",
+              "instruction is expected, but get", ins_name);
+  auto ins_list = named_ins[1].toTuple()->elements();
+
+  auto named_ops = comps[1].toTuple()->elements();
+  auto ops_name = named_ops[0].toString()->string();
+  TORCH_CHECK(ops_name == "operators",
+              "operator is expected, but get", ops_name);
+  auto ops_list = named_ops[1].toTuple()->elements();
+
+  for (const auto& ins : ins_list) {
+    auto ins_item = ins.toTuple()->elements();
+    TORCH_CHECK(ins_item.size() == 3,
+                "There should be three parts in an instruction.");
+    OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
+    int X = ins_item[1].toInt();
+    int N = ins_item[2].toInt();
+    function->append_instruction(op_code, X, N);
+  }
 
-    auto function = std::unique_ptr<mobile::Function>(new mobile::Function(
-        c10::QualifiedName(m_tuple[0].toString()->string())));
-    auto comps = m_tuple[1].toTuple()->elements();
-
-    // The sequence of the named tuple is 0: instructions, 1: operators,
-    // 2: constants, 3: register_size
-    auto named_ins = comps[0].toTuple()->elements();
-    auto ins_name = named_ins[0].toString()->string();
-    TORCH_CHECK(ins_name == "instructions",
-                "instruction is expected, but get", ins_name);
-    auto ins_list = named_ins[1].toTuple()->elements();
-
-    auto named_ops = comps[1].toTuple()->elements();
-    auto ops_name = named_ops[0].toString()->string();
-    TORCH_CHECK(ops_name == "operators",
-                "operator is expected, but get", ops_name);
-    auto ops_list = named_ops[1].toTuple()->elements();
-
-    for (const auto& ins : ins_list) {
-      auto ins_item = ins.toTuple()->elements();
-      TORCH_CHECK(ins_item.size() == 3,
-                  "There should be three parts in an instruction.");
-      OpCode op_code = parseOpCode(ins_item[0].toString()->string().c_str());
-      int X = ins_item[1].toInt();
-      int N = ins_item[2].toInt();
-      function->append_instruction(op_code, X, N);
-    }
+  for (const auto& op : ops_list) {
+    auto op_item = op.toTuple()->elements();
+    TORCH_CHECK(op_item.size() == 2,
+                "There should be two parts in an operator name.");
+    function->append_operator(op_item[0].toString()->string(),
+                         op_item[1].toString()->string());
+  }
 
-    for (const auto& op : ops_list) {
-      auto op_item = op.toTuple()->elements();
-      TORCH_CHECK(op_item.size() == 2,
-                  "There should be two parts in an operator name.");
-      function->append_operator(op_item[0].toString()->string(),
-                           op_item[1].toString()->string());
-    }
+  // vararg operators are stored in a separate table.
+  function->build_vararg_operator_table();
 
-    // vararg operators are stored in a separate table.
-    function->build_vararg_operator_table();
+  auto named_consts = comps[2].toTuple()->elements();
+  auto consts_name = named_consts[0].toString()->string();
+  TORCH_CHECK(consts_name == "constants",
+              "constant is expected, but get", consts_name);
+  auto consts_list = named_consts[1].toTuple()->elements();
+  for (const auto& constant : consts_list) {
+    function->append_constant(constant);
+  }
 
-    auto named_consts = comps[2].toTuple()->elements();
-    auto consts_name = named_consts[0].toString()->string();
-    TORCH_CHECK(consts_name == "constants",
-                "constant is expected, but get", consts_name);
-    auto consts_list = named_consts[1].toTuple()->elements();
-    for (const auto& constant : consts_list) {
-      function->append_constant(constant);
-    }
+  auto named_agg_size = comps[3].toTuple()->elements();
+  auto size_name = named_agg_size[0].toString()->string();
+  TORCH_CHECK(size_name == "register_size",
+              "register_size is expected, but get", ops_name);
+  function->set_register_size(named_agg_size[1].toInt());
 
-    auto named_agg_size = comps[3].toTuple()->elements();
-    auto size_name = named_agg_size[0].toString()->string();
-    TORCH_CHECK(size_name == "register_size",
-                "register_size is expected, but get", ops_name);
-    function->set_register_size(named_agg_size[1].toInt());
+  return function;
+}
 
-    mcu->register_function(std::move(function));
+void parseMethods(const std::vector<IValue>& vals, std::shared_ptr<mobile::CompilationUnit> mcu) {
+  // Only the method table is walked eagerly: each method is registered
+  // under its name with its bytecode table left as an unparsed IValue,
+  // and materialized by parseMethod on first call.
+  mcu->set_method_parser(parseMethod);
+  for (const auto& element : vals) {
+    const auto& m_tuple = element.toTuple()->elements();
+    c10::QualifiedName qn(m_tuple[0].toString()->string());
+    mcu->register_pending_function(qn.name(), element);
   }
 }
 
@@ -195,6 +211,14 @@ mobile::Module _load_for_mobile(
 mobile::Module _load_for_mobile(
     const std::string& filename,
     c10::optional<at::Device> device) {
+  // Prefer mapping the archive over reading it: pages are faulted in on
+  // demand and stay clean, so methods that are never parsed never touch
+  // their bytes.
+  if (MmapFileAdapter::is_supported()) {
+    std::unique_ptr<MmapFileAdapter> rai =
+        caffe2::make_unique<MmapFileAdapter>(filename);
+    return _load_for_mobile(std::move(rai), device);
+  }
   std::unique_ptr<FileAdapter> rai = caffe2::make_unique<FileAdapter>(filename);
   auto module = _load_for_mobile(std::move(rai), device);
   return module;
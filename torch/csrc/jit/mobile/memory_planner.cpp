@@ -0,0 +1,216 @@
+#include <torch/csrc/jit/mobile/memory_planner.h>
+
+#include <c10/core/CPUAllocator.h>
+#include <torch/csrc/utils/memory.h>
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+namespace {
+
+size_t align_size(size_t nbytes) {
+  return (nbytes + c10::gAlignment - 1) & ~(c10::gAlignment - 1);
+}
+
+constexpr size_t kNeverFreed = std::numeric_limits<size_t>::max();
+
+// Recording machinery. The state is a process-level static rather than a
+// planner member because the deleters of recorded DataPtrs can fire long
+// after calibration -- or after the planner itself -- is gone; they find
+// the map empty then and just release the underlying block.
+struct RecordingEvent {
+  size_t size;
+  size_t alloc_time;
+  size_t free_time;
+};
+
+struct RecordingState {
+  std::vector<RecordingEvent> events;
+  std::unordered_map<void*, size_t> live; // data ptr -> event index
+  size_t clock = 0;
+  at::Allocator* delegate = nullptr;
+  bool active = false;
+};
+
+RecordingState& recording_state() {
+  static RecordingState state;
+  return state;
+}
+
+struct RecordedBlock {
+  at::DataPtr inner;
+};
+
+void deleteRecordedBlock(void* ctx) {
+  RecordedBlock* block = static_cast<RecordedBlock*>(ctx);
+  RecordingState& state = recording_state();
+  auto it = state.live.find(block->inner.get());
+  if (it != state.live.end()) {
+    state.events[it->second].free_time = state.clock++;
+    state.live.erase(it);
+  }
+  delete block;
+}
+
+struct RecordingAllocator final : at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+    RecordingState& state = recording_state();
+    at::DataPtr inner = state.delegate->allocate(nbytes);
+    if (!state.active || nbytes == 0) {
+      return inner;
+    }
+    state.live[inner.get()] = state.events.size();
+    RecordingEvent event;
+    event.size = nbytes;
+    event.alloc_time = state.clock++;
+    event.free_time = kNeverFreed;
+    state.events.push_back(event);
+    void* data = inner.get();
+    RecordedBlock* block = new RecordedBlock;
+    block->inner = std::move(inner);
+    return at::DataPtr(
+        data, block, &deleteRecordedBlock, at::Device(at::DeviceType::CPU));
+  }
+};
+
+// The planner whose arena is currently installed as the CPU allocator.
+MemoryPlanner*& active_planner() {
+  static MemoryPlanner* planner = nullptr;
+  return planner;
+}
+
+} // namespace
+
+// Serves allocation k of a frame at its precomputed arena offset. Handing
+// out raw arena pointers with the no-op deleter is what makes the steady
+// state malloc-free; anything off-schedule goes to the regular allocator.
+struct MemoryPlanner::ArenaAllocator final : at::Allocator {
+  at::DataPtr allocate(size_t nbytes) const override {
+    MemoryPlanner* planner = active_planner();
+    TORCH_INTERNAL_ASSERT(planner != nullptr);
+    if (nbytes > 0 && planner->cursor_ < planner->schedule_.size()) {
+      const Slot& slot = planner->schedule_[planner->cursor_];
+      if (align_size(nbytes) <= slot.size) {
+        ++planner->cursor_;
+        void* data =
+            static_cast<char*>(planner->arena_.get()) + slot.offset;
+        return at::DataPtr(data, at::Device(at::DeviceType::CPU));
+      }
+    }
+    return planner->previous_allocator_->allocate(nbytes);
+  }
+};
+
+MemoryPlanner::MemoryPlanner() = default;
+
+MemoryPlanner::~MemoryPlanner() {
+  if (enabled_) {
+    disable();
+  }
+}
+
+void MemoryPlanner::calibrate(
+    Module& module,
+    std::vector<c10::IValue> inputs) {
+  TORCH_CHECK(!enabled_, "cannot calibrate while the planner is enabled");
+  RecordingState& state = recording_state();
+  TORCH_CHECK(!state.active, "another MemoryPlanner is calibrating");
+  state.events.clear();
+  state.live.clear();
+  state.clock = 0;
+  state.delegate = c10::GetAllocator(at::DeviceType::CPU);
+  static RecordingAllocator recorder;
+  c10::SetAllocator(at::DeviceType::CPU, &recorder);
+  state.active = true;
+  module.forward(inputs);
+  state.active = false;
+  c10::SetAllocator(at::DeviceType::CPU, state.delegate);
+  // Blocks still live (the outputs) keep kNeverFreed and thus conflict
+  // with every later allocation; their slots are simply never reused.
+  state.live.clear();
+
+  schedule_.clear();
+  schedule_.reserve(state.events.size());
+  for (const RecordingEvent& event : state.events) {
+    Slot slot;
+    slot.size = align_size(event.size);
+    slot.offset = 0;
+    schedule_.push_back(slot);
+  }
+  compute_offsets();
+  state.events.clear();
+}
+
+// Classic linear-scan planning: walk allocations in schedule order and
+// give each the lowest offset not occupied by an earlier allocation whose
+// recorded lifetime overlaps. The arena ends up sized to the peak of the
+// schedule, not its sum.
+void MemoryPlanner::compute_offsets() {
+  RecordingState& state = recording_state();
+  arena_size_ = 0;
+  for (size_t i = 0; i < schedule_.size(); ++i) {
+    const RecordingEvent& event = state.events[i];
+    // Offset ranges of live-overlapping predecessors, sorted by offset.
+    std::vector<std::pair<size_t, size_t>> taken;
+    for (size_t j = 0; j < i; ++j) {
+      const RecordingEvent& other = state.events[j];
+      if (other.alloc_time < event.free_time &&
+          event.alloc_time < other.free_time) {
+        taken.emplace_back(
+            schedule_[j].offset, schedule_[j].offset + schedule_[j].size);
+      }
+    }
+    std::sort(taken.begin(), taken.end());
+    size_t offset = 0;
+    for (size_t t = 0; t < taken.size(); ++t) {
+      if (offset + schedule_[i].size <= taken[t].first) {
+        break;
+      }
+      offset = std::max(offset, taken[t].second);
+    }
+    schedule_[i].offset = offset;
+    arena_size_ = std::max(arena_size_, offset + schedule_[i].size);
+  }
+}
+
+void MemoryPlanner::enable() {
+  TORCH_CHECK(is_calibrated(), "calibrate() must run before enable()");
+  if (enabled_) {
+    return;
+  }
+  previous_allocator_ = c10::GetAllocator(at::DeviceType::CPU);
+  if (arena_size_ > 0 && arena_.get() == nullptr) {
+    arena_ = previous_allocator_->allocate(arena_size_);
+  }
+  if (!allocator_) {
+    allocator_ = torch::make_unique<ArenaAllocator>();
+  }
+  active_planner() = this;
+  c10::SetAllocator(at::DeviceType::CPU, allocator_.get());
+  // Off-schedule until the first begin_frame().
+  cursor_ = schedule_.size();
+  enabled_ = true;
+}
+
+void MemoryPlanner::disable() {
+  if (!enabled_) {
+    return;
+  }
+  c10::SetAllocator(at::DeviceType::CPU, previous_allocator_);
+  active_planner() = nullptr;
+  enabled_ = false;
+}
+
+void MemoryPlanner::begin_frame() {
+  TORCH_CHECK(enabled_, "enable() must run before begin_frame()");
+  cursor_ = 0;
+}
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
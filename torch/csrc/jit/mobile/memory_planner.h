@@ -0,0 +1,83 @@
+#pragma once
+#include <torch/csrc/jit/mobile/module.h>
+#include <c10/core/Allocator.h>
+
+#include <memory>
+#include <vector>
+
+namespace torch {
+namespace jit {
+namespace mobile {
+
+// Inference memory planner for mobile modules. On-device, per-frame
+// allocator variance shows up as jank: every intermediate tensor of a
+// forward pass goes through malloc/free. Frames of a fixed model with
+// fixed input shapes replay the same allocation schedule, so the planner
+// records that schedule once during a calibration run, assigns each
+// allocation an offset in a single arena sized to the peak of the
+// schedule, and then serves steady-state frames from the arena with no
+// mallocs at all.
+//
+// Usage:
+//   MemoryPlanner planner;
+//   planner.calibrate(module, inputs);  // one forward pass, recorded
+//   planner.enable();
+//   for (;;) {
+//     planner.begin_frame();
+//     module.forward(inputs);           // zero-malloc
+//   }
+//
+// The planner redirects the process-wide CPU allocator while enabled, so
+// it assumes single-threaded inference (the usual mobile setup). Frames
+// that deviate from the recorded schedule -- an allocation that is larger
+// than its recorded slot, or more allocations than were recorded -- fall
+// back to the regular allocator for the excess, so shape drift degrades
+// to malloc instead of failing. Tensors handed out of an enabled frame
+// point into the arena; the planner must outlive them.
+class TORCH_API MemoryPlanner {
+ public:
+  MemoryPlanner();
+  ~MemoryPlanner();
+
+  // Runs module.forward(inputs) once with a recording allocator and
+  // computes the arena offsets from the observed allocation lifetimes.
+  void calibrate(Module& module, std::vector<c10::IValue> inputs);
+
+  // Preallocates the arena and installs it as the CPU allocator.
+  void enable();
+  // Restores the previous CPU allocator.
+  void disable();
+
+  // Resets the allocation cursor; call before each forward pass.
+  void begin_frame();
+
+  bool is_calibrated() const {
+    return !schedule_.empty();
+  }
+  size_t arena_size() const {
+    return arena_size_;
+  }
+
+ private:
+  struct Slot {
+    size_t size; // rounded up to the arena alignment
+    size_t offset;
+  };
+  struct ArenaAllocator;
+
+  void compute_offsets();
+
+  std::vector<Slot> schedule_;
+  size_t arena_size_ = 0;
+  c10::DataPtr arena_;
+  std::unique_ptr<ArenaAllocator> allocator_;
+  at::Allocator* previous_allocator_ = nullptr;
+  size_t cursor_ = 0;
+  bool enabled_ = false;
+
+  C10_DISABLE_COPY_AND_ASSIGN(MemoryPlanner);
+};
+
+} // namespace mobile
+} // namespace jit
+} // namespace torch
@@ -19,6 +19,34 @@ void CompilationUnit::register_function(std::unique_ptr<Function> fn) {
   methods_.emplace_back(std::move(fn));
 }
 
+void CompilationUnit::register_pending_function(
+    std::string name,
+    c10::IValue method_table) {
+  pending_methods_.emplace_back(std::move(name), std::move(method_table));
+}
+
+void CompilationUnit::set_method_parser(MethodParser parser) {
+  parser_ = std::move(parser);
+}
+
+Function* CompilationUnit::find_function(const std::string& basename) {
+  for (auto& fn : methods_) {
+    if (fn->name() == basename) {
+      return fn.get();
+    }
+  }
+  for (auto it = pending_methods_.begin(); it != pending_methods_.end(); ++it) {
+    if (it->first == basename) {
+      TORCH_CHECK(
+          parser_, "no method parser installed for pending method ", basename);
+      methods_.emplace_back(parser_(it->second));
+      pending_methods_.erase(it);
+      return methods_.back().get();
+    }
+  }
+  return nullptr;
+}
+
 c10::IValue Module::run_method(const std::string& method_name, Stack& stack) {
   auto m = find_method(method_name);
   stack.insert(stack.begin(), object_);
@@ -27,12 +55,7 @@ c10::IValue Module::run_method(const std::string& method_name, Stack& stack) {
 }
 
 Function* Module::find_method(const std::string& basename) const {
-  for (auto& fn : cu_->methods()) {
-    if (fn->name() == basename) {
-      return fn.get();
-    }
-  }
-  return nullptr;
+  return cu_->find_function(basename);
 }
 
 } // namespace mobile
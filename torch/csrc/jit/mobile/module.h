@@ -2,6 +2,8 @@
 //#include <ATen/core/function_schema.h>
 #include <torch/csrc/jit/mobile/function.h>
 
+#include <functional>
+
 namespace torch{
 namespace jit{
 namespace mobile {
@@ -10,10 +12,25 @@ using Stack = std::vector<c10::IValue>;
 
 class CompilationUnit {
  public:
+  // Turns a method's unparsed bytecode table into a Function; installed
+  // by the loader (see parseMethods in mobile/import.cpp).
+  using MethodParser =
+      std::function<std::unique_ptr<Function>(const c10::IValue&)>;
+
   void register_function(std::unique_ptr<Function> fn);
+  // Lazy registration: only the method name is needed up front, and the
+  // bytecode table stays an unparsed IValue until the first lookup.
+  // Parsing is where load time goes (operator resolution in particular),
+  // so methods that are never called never pay it.
+  void register_pending_function(std::string name, c10::IValue method_table);
+  void set_method_parser(MethodParser parser);
+  // Finds a method by name, materializing it first if it is still pending.
+  Function* find_function(const std::string& basename);
   std::vector<std::unique_ptr<Function>>& methods() {return methods_;}
  private:
   std::vector<std::unique_ptr<Function>> methods_;
+  std::vector<std::pair<std::string, c10::IValue>> pending_methods_;
+  MethodParser parser_;
 };
 
 class TORCH_API Module {
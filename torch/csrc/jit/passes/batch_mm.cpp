@@ -319,6 +319,26 @@ bool shape_is_fast_for_side(const at::Tensor& other_side_input) {
   return other_side_input.numel() <= 1024 * 2048;
 }
 
+// Transformer graphs express their projections with aten::matmul rather than
+// aten::mm. When both operands are statically known to be 2-D the two are
+// interchangeable, so such matmuls can take part in the batched rewrites
+// below (MMBatchSide computes plain mms).
+bool is_2d_matmul(const Node* node) {
+  if (!node->matches("aten::matmul(Tensor self, Tensor other) -> Tensor")) {
+    return false;
+  }
+  for (const Value* input : node->inputs()) {
+    const auto type = input->type()->cast<TensorType>();
+    if (!type || !type->dim() || *type->dim() != 2) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static const char* addmm_schema =
+    "aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta, Scalar alpha) -> Tensor";
+
 RegisterOperators mm_batch_side_reg({Operator(
     prim::MMBatchSide,
     [](const Node* node) -> Operation {
@@ -368,39 +388,88 @@ RegisterOperators mm_batch_side_reg({Operator(
     },
     aliasAnalysisIsSpecialCase())});
 
-std::pair<std::vector<Node*>, std::vector<Node*>> gatherIndependentMMUses(
-    Value* value,
+// Executes a batch of addmm projections that share their mat1: the result
+// is mat1 @ cat(mat2s, 1) + cat(biases), computed as one GEMM and chunked
+// into the per-projection outputs. Inputs are ordered as
+// (mat1, bias_0, ..., bias_{n-1}, mat2_0, ..., mat2_{n-1}); when the
+// runtime shapes do not line up it falls back to independent addmms.
+RegisterOperators addmm_batch_side_reg({Operator(
+    prim::AddMMBatchSide,
+    [](const Node* node) -> Operation {
+      size_t num_projections = node->outputs().size();
+      return [num_projections](Stack& stack) {
+        std::vector<at::Tensor> inputs;
+        inputs.reserve(2 * num_projections);
+        for (auto it = stack.end() - 2 * num_projections; it != stack.end();
+             ++it) {
+          inputs.push_back(std::move(*it).toTensor());
+        }
+        drop(stack, 2 * num_projections);
+        at::Tensor mat1;
+        pop(stack, mat1);
+
+        auto biases = at::TensorList(inputs).slice(0, num_projections);
+        auto mat2s = at::TensorList(inputs).slice(num_projections);
+        const bool one_dim_biases = std::all_of(
+            biases.begin(), biases.end(), [](const at::Tensor& bias) {
+              return bias.dim() == 1;
+            });
+        if (have_same_shape(mat2s) && have_same_shape(biases) &&
+            one_dim_biases && shape_is_fast_for_side(mat2s[0])) {
+          auto mm_out =
+              at::addmm(at::cat(biases, 0), mat1, at::cat(mat2s, /*dim=*/1));
+          auto outputs = at::chunk(mm_out, num_projections, /*dim=*/1);
+          stack.insert(
+              stack.end(),
+              std::make_move_iterator(outputs.begin()),
+              std::make_move_iterator(outputs.end()));
+        } else {
+          for (size_t i = 0; i < num_projections; ++i) {
+            stack.emplace_back(at::addmm(biases[i], mat1, mat2s[i]));
+          }
+        }
+
+        return 0;
+      };
+    },
+    aliasAnalysisIsSpecialCase())});
+
+// Drops nodes from mms that depend on an earlier entry, so the survivors can
+// all be moved next to each other. This algorithm might do very badly if
+// e.g. you have a lot of independent MMs, that depend on the first one, but
+// I doubt this will be a common scenario.
+std::vector<Node*> filterIndependent(
+    std::vector<Node*> mms,
     AliasDb& alias_db) {
-  const auto postprocess = [&](std::vector<Node*> mms) {
-    if (mms.size() == 0) {
-      return mms;
-    }
-    std::sort(mms.begin(), mms.end(), [](Node* n, Node* m) {
-      return n->isBefore(m);
-    });
-    // Filter out dependent MMs. This algorithm might do very badly if e.g. you
-    // have a lot of independent MMs, that depend on the first one, but I doubt
-    // this will be a common scenario.
-    for (size_t i = 0; i < mms.size(); ++i) {
-      if (mms[i] == nullptr)
+  if (mms.size() == 0) {
+    return mms;
+  }
+  std::sort(
+      mms.begin(), mms.end(), [](Node* n, Node* m) { return n->isBefore(m); });
+  for (size_t i = 0; i < mms.size(); ++i) {
+    if (mms[i] == nullptr)
+      continue;
+    for (size_t j = i + 1; j < mms.size(); ++j) {
+      if (mms[j] == nullptr)
         continue;
-      for (size_t j = i + 1; j < mms.size(); ++j) {
-        if (mms[j] == nullptr)
-          continue;
-        if (!alias_db.couldMoveBeforeTopologically(mms[j], mms[i])) {
-          mms[j] = nullptr;
-        }
+      if (!alias_db.couldMoveBeforeTopologically(mms[j], mms[i])) {
+        mms[j] = nullptr;
       }
     }
-    return c10::filter(mms, [](Node* n) { return n != nullptr; });
-  };
+  }
+  return c10::filter(mms, [](Node* n) { return n != nullptr; });
+}
 
+std::pair<std::vector<Node*>, std::vector<Node*>> gatherIndependentMMUses(
+    Value* value,
+    AliasDb& alias_db) {
   Block* block = value->node()->owningBlock();
   std::vector<Node*> lhses; // Will contain nodes where value is used as an lhs
   std::vector<Node*> rhses; // Like above, but rhs
   for (Use u : value->uses()) {
     if (u.user->owningBlock() == block &&
-        u.user->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+        (u.user->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor") ||
+         is_2d_matmul(u.user))) {
       if (u.offset == 0 && u.user->inputs()[1] != value) {
         lhses.push_back(u.user);
       } else if (u.offset == 1 && u.user->inputs()[0] != value) {
@@ -408,12 +477,41 @@ std::pair<std::vector<Node*>, std::vector<Node*>> gatherIndependentMMUses(
       }
     }
   }
-  return std::make_pair(postprocess(lhses), postprocess(rhses));
+  return std::make_pair(
+      filterIndependent(std::move(lhses), alias_db),
+      filterIndependent(std::move(rhses), alias_db));
+}
+
+// Collects the independent addmm users of value that have it as their mat1
+// operand and default beta/alpha. These are parallel linear projections of
+// the same activations -- the multi-head Q/K/V pattern -- and can be
+// computed as a single GEMM against the concatenated weights.
+std::vector<Node*> gatherIndependentAddMMUses(Value* value, AliasDb& alias_db) {
+  Block* block = value->node()->owningBlock();
+  std::vector<Node*> projections;
+  for (Use u : value->uses()) {
+    Node* user = u.user;
+    if (u.offset != 1 || user->owningBlock() != block ||
+        !user->matches(
+            addmm_schema, /*const_inputs=*/{attr::beta, attr::alpha})) {
+      continue;
+    }
+    if (user->get<at::Scalar>(attr::beta)->toDouble() != 1.0 ||
+        user->get<at::Scalar>(attr::alpha)->toDouble() != 1.0) {
+      continue;
+    }
+    projections.push_back(user);
+  }
+  return filterIndependent(std::move(projections), alias_db);
 }
 
 void BatchMMSide(Block* block, AliasDb& alias_db) {
   // NB: 8 is the current loop unrolling factor
   static constexpr size_t how_many_is_many = 8;
+  // The Q/K/V projections of one attention block give only three parallel
+  // branches, and batching them is already a win on the small per-head
+  // matrices found in transformers, so addmm batching kicks in earlier.
+  static constexpr size_t how_many_is_many_addmm = 3;
   const auto batch_side = [&](std::vector<Node*>& mms, Side side) {
     AT_ASSERT(!mms.empty());
     for (int64_t i = static_cast<int64_t>(mms.size()) - 2; i >= 0; --i) {
@@ -436,9 +534,35 @@ void BatchMMSide(Block* block, AliasDb& alias_db) {
     }
   };
 
+  const auto batch_addmm_side = [&](std::vector<Node*>& addmms) {
+    AT_ASSERT(!addmms.empty());
+    for (int64_t i = static_cast<int64_t>(addmms.size()) - 2; i >= 0; --i) {
+      bool move_ok =
+          alias_db.moveBeforeTopologicallyValid(addmms[i], addmms[i + 1]);
+      AT_ASSERT(move_ok);
+    }
+    WithInsertPoint insert_guard{addmms[0]};
+    Graph* graph = addmms[0]->owningGraph();
+    Node* batch_addmm = graph->create(
+        prim::AddMMBatchSide,
+        /*inputs=*/{},
+        /*num_outputs=*/addmms.size());
+    graph->insertNode(batch_addmm);
+    batch_addmm->addInput(addmms[0]->inputs().at(1)); // the shared mat1
+    for (Node* addmm : addmms) {
+      batch_addmm->addInput(addmm->inputs().at(0)); // biases
+    }
+    for (size_t i = 0; i < addmms.size(); ++i) {
+      batch_addmm->addInput(addmms[i]->inputs().at(2)); // weights
+      addmms[i]->output()->replaceAllUsesWith(batch_addmm->outputs().at(i));
+    }
+  };
+
   std::unordered_set<Value*> considered_values;
+  std::unordered_set<Value*> considered_projection_values;
   for (Node* node : block->nodes()) {
-    if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor")) {
+    if (node->matches("aten::mm(Tensor self, Tensor mat2) -> Tensor") ||
+        is_2d_matmul(node)) {
       for (Value* input : node->inputs()) {
         if (/*bool not_inserted = */ !considered_values.emplace(input).second) {
           continue;
@@ -451,6 +575,16 @@ void BatchMMSide(Block* block, AliasDb& alias_db) {
           batch_side(uses_with_many.second, Side::RHS);
         }
       }
+    } else if (node->matches(
+                   addmm_schema,
+                   /*const_inputs=*/{attr::beta, attr::alpha})) {
+      Value* mat1 = node->inputs().at(1);
+      if (considered_projection_values.emplace(mat1).second) {
+        auto projections = gatherIndependentAddMMUses(mat1, alias_db);
+        if (projections.size() >= how_many_is_many_addmm) {
+          batch_addmm_side(projections);
+        }
+      }
     } else {
       for (Block* subblock : node->blocks()) {
         BatchMMSide(subblock, alias_db);
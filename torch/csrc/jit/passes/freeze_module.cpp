@@ -0,0 +1,112 @@
+#include <torch/csrc/jit/passes/freeze_module.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/passes/constant_pooling.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/inliner.h>
+
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Collects the attribute names assigned anywhere in the graph. Folding is
+// skipped for these names: a prim::SetAttr must keep observing (and being
+// observed by) the matching prim::GetAttr accesses. Matching on name alone
+// is conservative when distinct submodules share an attribute name, which
+// only costs missed folding opportunities.
+void gatherMutatedAttrNames(
+    Block* block,
+    std::unordered_set<std::string>& mutated) {
+  for (Node* node : block->nodes()) {
+    if (node->kind() == prim::SetAttr) {
+      mutated.insert(node->s(attr::name));
+    }
+    for (Block* sub_block : node->blocks()) {
+      gatherMutatedAttrNames(sub_block, mutated);
+    }
+  }
+}
+
+} // namespace
+
+void FreezeModule(script::Module& module) {
+  Method forward = module.get_method("forward");
+  auto graph = forward.graph();
+
+  // Inline to expose the prim::GetAttr chains hidden in method calls
+  Inline(*graph);
+
+  std::unordered_set<std::string> mutated;
+  gatherMutatedAttrNames(graph->block(), mutated);
+
+  struct ToScan {
+    ModulePtr mod;
+    Node* n;
+  };
+  std::vector<ToScan> to_scan;
+  std::vector<Node*> to_clean; // submodule accesses that may be dead now
+
+  Value* self_value = graph->inputs().at(0);
+  for (Use use : self_value->uses()) {
+    to_scan.emplace_back(ToScan{module.module_object(), use.user});
+  }
+  while (to_scan.size() > 0) {
+    auto e = to_scan.back();
+    to_scan.pop_back();
+
+    // Anything other than attribute lookup (e.g. passing a module into a
+    // fork) keeps the module value alive and is left untouched.
+    if (e.n->kind() != prim::GetAttr) {
+      continue;
+    }
+    const std::string& name = e.n->s(attr::name);
+    if (mutated.count(name) != 0) {
+      continue;
+    }
+    size_t slot_idx = e.mod->type()->getAttributeSlot(name);
+    auto iv = e.mod->getSlot(slot_idx);
+    if (ClassTypePtr c = e.n->output()->type()->cast<ClassType>()) {
+      if (c->is_module()) {
+        for (Use use : e.n->output()->uses()) {
+          to_scan.emplace_back(ToScan{iv.toObject(), use.user});
+        }
+        to_clean.emplace_back(e.n);
+        continue;
+      }
+    }
+    if (iv.isTensor() && iv.toTensor().requires_grad()) {
+      // The frozen copy of a parameter is inference-only
+      iv = iv.toTensor().detach();
+    }
+    WithInsertPoint guard(e.n);
+    if (auto constant = tryInsertConstant(*graph, iv)) {
+      e.n->output()->replaceAllUsesWith(*constant);
+      e.n->destroy();
+    }
+  }
+
+  // Submodule lookups were discovered parent-first, so destroying in
+  // reverse removes inner accesses before the ones they depend on. A
+  // lookup with remaining uses fed a skipped attribute and must stay.
+  while (to_clean.size() > 0) {
+    Node* n = to_clean.back();
+    to_clean.pop_back();
+    if (!n->hasUses()) {
+      n->destroy();
+    }
+  }
+
+  // The embedded attributes are ordinary constants now; fold whatever
+  // computation they pin down and dedup repeated accesses.
+  ConstantPropagation(graph);
+  ConstantPooling(graph);
+  EliminateDeadCode(graph);
+}
+
+} // namespace jit
+} // namespace torch
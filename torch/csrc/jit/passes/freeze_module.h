@@ -0,0 +1,25 @@
+#pragma once
+
+#include <torch/csrc/jit/script/module.h>
+
+namespace torch {
+namespace jit {
+
+// Freezes the forward method of a module for inference. Method calls are
+// inlined and accesses to parameters, buffers, and other attributes
+// (reached through chains of prim::GetAttr on %self) are replaced with
+// constants embedded in the graph, so each forward no longer pays for
+// attribute resolution. Folding the attributes also exposes them to the
+// usual constant optimizations: constant propagation and pooling are run
+// as part of freezing, which folds config-driven branches and dedups
+// shared weights.
+//
+// Parameters are detached before they are embedded, so the frozen method
+// must not be used for training. Attributes that the module mutates via
+// prim::SetAttr are left as attribute accesses and keep working.
+//
+// The module is modified in place; its calling convention is unchanged.
+TORCH_API void FreezeModule(script::Module& module);
+
+} // namespace jit
+} // namespace torch
@@ -48,5 +48,33 @@ void FuseLinear(std::shared_ptr<Graph>& graph) {
       matmul_pattern, fused_linear_bias_none);
   matmul_to_linear.runOnGraph(graph);
 }
+
+void FuseLinearActivation(std::shared_ptr<Graph>& graph) {
+  // Rewrites aten::linear followed by a supported activation into the fused
+  // aten::linear_relu/linear_gelu/linear_sigmoid ops, whose CPU path applies
+  // bias and activation in a single pass over the output. Run FuseLinear
+  // first so addmm/matmul+add forms are already collapsed to aten::linear.
+  const std::vector<std::pair<std::string, std::string>> rewrites = {
+      {"aten::relu", "aten::linear_relu"},
+      {"aten::relu_", "aten::linear_relu"},
+      {"aten::gelu", "aten::linear_gelu"},
+      {"aten::sigmoid", "aten::linear_sigmoid"},
+      {"aten::sigmoid_", "aten::linear_sigmoid"},
+  };
+  for (const auto& rewrite : rewrites) {
+    std::string pattern = R"IR(
+    graph(%input, %weight, %bias):
+        %linear_res = aten::linear(%input, %weight, %bias)
+        %res = )IR" + rewrite.first + R"IR((%linear_res)
+        return (%res))IR";
+    std::string fused = R"IR(
+    graph(%input, %weight, %bias):
+        %res = )IR" + rewrite.second + R"IR((%input, %weight, %bias)
+        return (%res))IR";
+    SubgraphRewriter rewriter;
+    rewriter.RegisterRewritePattern(pattern, fused);
+    rewriter.runOnGraph(graph);
+  }
+}
 } // namespace jit
 } // namespace torch
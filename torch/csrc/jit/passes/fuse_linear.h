@@ -13,5 +13,12 @@ namespace jit {
  * This pass can be deleted once the JIT can emit the aten::linear in the future
  */
 TORCH_API void FuseLinear(std::shared_ptr<Graph>& graph);
+
+/** \brief Fuse at::linear followed by relu/gelu/sigmoid into the fused
+ * aten::linear_relu/linear_gelu/linear_sigmoid ops, which apply bias and
+ * activation in one pass over the output on CPU.
+ * Expects FuseLinear to have run first so the linear patterns are collapsed.
+ */
+TORCH_API void FuseLinearActivation(std::shared_ptr<Graph>& graph);
 } // namespace jit
 } // namespace torch
@@ -233,6 +233,29 @@ struct GraphFuser {
     return true;
   }
 
+  // A sum over all elements can terminate a fusion group: the kernel
+  // accumulates the fused expression into a register as it maps over the
+  // elements, so the intermediate it would otherwise reduce is never
+  // materialized. The sum is only ever an output of the group (nothing can
+  // consume a reduction result inside a pointwise kernel). Restricted to
+  // float inputs with the default dtype: the kernel accumulates in the
+  // input's own type, and the CUDA epilogue combines per-block partial sums
+  // with atomicAdd, which older devices only provide for float.
+  bool isFusableSumNode(Node* node) {
+    if (!node->matches(
+            "aten::sum(Tensor self, *, ScalarType? dtype=None) -> Tensor")) {
+      return false;
+    }
+    if (!node->namedInput(attr::dtype)->node()->mustBeNone()) {
+      return false;
+    }
+    auto self = node->namedInput(attr::self)->type()->cast<TensorType>();
+    if (!self || self->scalarType() != at::kFloat) {
+      return false;
+    }
+    return isFusableDevice(node->output());
+  }
+
   bool calculatesSize(Node* node) {
     return node->matches("aten::size(Tensor self) -> int[]");
   }
@@ -938,6 +961,11 @@ struct GraphFuser {
         // because it won't help us.
         continue;
       }
+      if (n->kind() == prim::FusedSum) {
+        // Reduction outputs are scalars; nothing downstream asks the fusion
+        // group for their shape.
+        continue;
+      }
       if (n->kind() == prim::Constant) {
         continue;
       }
@@ -1000,7 +1028,10 @@ struct GraphFuser {
     aliasDb_ = torch::make_unique<AliasDb>(graph_);
   }
 
-  bool canFuseWithConcat(Value* producer, Node* before_check) {
+  // Shared producer check for exit nodes (prim::FusedConcat and
+  // prim::FusedSum): both consume the fused values but produce something a
+  // pointwise kernel cannot feed back into itself.
+  bool canFuseWithExitNode(Value* producer, Node* before_check) {
     if (!isFusable(producer->node())) {
       return false;
     }
@@ -1018,12 +1049,13 @@ struct GraphFuser {
       return false;
     }
 
-    // Fusion groups can be merged with concat's group if and only if
-    // the value they produce isn't already coming from a concat
+    // Fusion groups can be merged with an exit node's group if and only if
+    // the value they produce isn't already coming from an exit node
     if (producer->node()->kind() == prim::FusionGroup) {
       auto subgraph = producer->node()->g(attr::Subgraph);
       auto* node = subgraph->outputs().at(producer->offset())->node();
-      return node->kind() != prim::FusedConcat;
+      return node->kind() != prim::FusedConcat &&
+          node->kind() != prim::FusedSum;
     }
     return true;
   }
@@ -1060,7 +1092,7 @@ struct GraphFuser {
       bool any_fused = false;
       while (input_idx < sorted_inputs.size()) {
         Value* input = sorted_inputs[input_idx++];
-        if (!canFuseWithConcat(input, fused_cat)) {
+        if (!canFuseWithExitNode(input, fused_cat)) {
           continue;
         }
         any_fused = true;
@@ -1084,6 +1116,56 @@ struct GraphFuser {
     }
   }
 
+  Node* createFusedSum(Node* node) {
+    AT_ASSERT(node->kind() == aten::sum);
+
+    Graph* graph = node->owningGraph();
+    Node* fused_sum =
+        graph->create(prim::FusedSum, {node->namedInput(attr::self)});
+    fused_sum->insertBefore(node);
+    fused_sum->output()->copyMetadata(node->output());
+
+    // NB: this deletes the fused_sum node from the original graph
+    return createSingletonFusionGroup(fused_sum);
+  }
+
+  void fuseSumReductions() {
+    for (auto it = block_->nodes().rbegin(); it != block_->nodes().rend();
+         ++it) {
+      Node* sum = *it;
+      if (!isFusableSumNode(sum)) {
+        continue;
+      }
+      Node* fused_sum = createFusedSum(sum);
+      Value* fused_sum_out = fused_sum->output();
+
+      auto sorted_inputs = sortReverseTopological(fused_sum->inputs());
+      size_t input_idx = 0;
+      bool any_fused = false;
+      while (input_idx < sorted_inputs.size()) {
+        Value* input = sorted_inputs[input_idx++];
+        if (!canFuseWithExitNode(input, fused_sum)) {
+          continue;
+        }
+        any_fused = true;
+        auto maybe_group = tryFuse(fused_sum, input);
+        AT_ASSERT(maybe_group && maybe_group == fused_sum);
+        // We could have destroyed multiple inputs when performing this fusion,
+        // so we have to recompute the list and iterate over it again.
+        sorted_inputs = sortReverseTopological(fused_sum->inputs());
+        input_idx = 0;
+      }
+
+      if (any_fused) {
+        sum->output()->replaceAllUsesWith(fused_sum_out);
+        it.destroyCurrent();
+      } else {
+        // A sum with no fused producers saves nothing; leave the aten op.
+        fused_sum->destroy();
+      }
+    }
+  }
+
   void optimizeFusedGraphs() {
     for (Node* node : block_->nodes()) {
       if (node->kind() != prim::FusionGroup) {
@@ -1127,6 +1209,8 @@ struct GraphFuser {
 
     fuseConcats();
 
+    fuseSumReductions();
+
     optimizeFusedGraphs();
 
     // The graph fuser can add intermediate prim::BroadcastingChunk nodes.
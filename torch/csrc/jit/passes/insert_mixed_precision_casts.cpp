@@ -0,0 +1,154 @@
+#include <torch/csrc/jit/passes/insert_mixed_precision_casts.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Ops that tensor cores accelerate and that are numerically safe in half
+// precision: their inputs are expected in a bounded range and the
+// backends accumulate matmul/conv products in fp32 internally.
+// conv2d/conv3d desugar into aten::_convolution during scripting, which
+// is why the list carries the internal entry point as well.
+const std::unordered_set<Symbol>& fp16SafeOps() {
+  static const std::unordered_set<Symbol> ops = {
+      aten::mm,
+      aten::bmm,
+      aten::matmul,
+      aten::addmm,
+      aten::addbmm,
+      aten::baddbmm,
+      aten::linear,
+      aten::conv1d,
+      aten::conv2d,
+      aten::conv3d,
+      aten::conv_transpose1d,
+      aten::_convolution,
+  };
+  return ops;
+}
+
+// Ops whose result degrades when inputs or accumulation drop to half
+// precision: exponentials and softmax (overflow / loss of resolution in
+// the normalizer), normalization statistics, large reductions, and loss
+// functions (their output feeds the gradient scale).
+const std::unordered_set<Symbol>& fp32RequiredOps() {
+  static const std::unordered_set<Symbol> ops = {
+      aten::softmax,
+      aten::log_softmax,
+      aten::batch_norm,
+      aten::layer_norm,
+      aten::group_norm,
+      aten::instance_norm,
+      aten::norm,
+      aten::sum,
+      aten::mean,
+      aten::prod,
+      aten::cumsum,
+      aten::exp,
+      aten::expm1,
+      aten::log,
+      aten::log1p,
+      aten::log2,
+      aten::log10,
+      aten::pow,
+      aten::erf,
+      aten::mse_loss,
+      aten::l1_loss,
+      aten::smooth_l1_loss,
+      aten::nll_loss,
+      aten::nll_loss2d,
+      aten::kl_div,
+      aten::binary_cross_entropy,
+      aten::binary_cross_entropy_with_logits,
+      aten::cosine_embedding_loss,
+  };
+  return ops;
+}
+
+class MixedPrecisionCastInserter {
+ public:
+  explicit MixedPrecisionCastInserter(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  void run() {
+    processBlock(graph_->block());
+  }
+
+ private:
+  void processBlock(Block* block) {
+    for (Node* node : block->nodes()) {
+      for (Block* sub_block : node->blocks()) {
+        processBlock(sub_block);
+      }
+      if (fp16SafeOps().count(node->kind())) {
+        castInputs(node, at::ScalarType::Half);
+      } else if (fp32RequiredOps().count(node->kind())) {
+        castInputs(node, at::ScalarType::Float);
+      }
+    }
+  }
+
+  void castInputs(Node* node, at::ScalarType dtype) {
+    for (size_t i = 0; i < node->inputs().size(); ++i) {
+      Value* input = node->input(i);
+      if (!isCastableTensor(input)) {
+        continue;
+      }
+      node->replaceInput(i, castTo(input, dtype, node));
+    }
+  }
+
+  // Only plain tensor inputs are rewritten; optional tensors (e.g. an
+  // absent conv bias) and non-tensor arguments pass through untouched.
+  // Tensors statically known to be integral (embedding indices, masks)
+  // are left alone; when the dtype is unknown the cast is inserted
+  // anyway, since aten::to returns its input unchanged if the dtype
+  // already matches.
+  static bool isCastableTensor(Value* value) {
+    auto tensor_type = value->type()->cast<TensorType>();
+    if (!tensor_type) {
+      return false;
+    }
+    auto scalar_type = tensor_type->scalarType();
+    return !scalar_type || at::isFloatingType(*scalar_type);
+  }
+
+  Value* castTo(Value* value, at::ScalarType dtype, Node* user) {
+    // Reuse an earlier cast of the same value when it dominates this
+    // user: nodes are visited in topological order, so a cached cast in
+    // the user's own block was inserted before the user.
+    Value*& cached = dtype == at::ScalarType::Half
+        ? cast_cache_[value].half
+        : cast_cache_[value].fp32;
+    if (cached != nullptr &&
+        cached->node()->owningBlock() == user->owningBlock()) {
+      return cached;
+    }
+    WithInsertPoint insert_guard(user);
+    Value* target_dtype =
+        graph_->insertConstant(static_cast<int64_t>(dtype));
+    cached = graph_->insert(aten::to, {value, target_dtype});
+    return cached;
+  }
+
+  struct CastedValue {
+    Value* half = nullptr;
+    Value* fp32 = nullptr;
+  };
+
+  std::shared_ptr<Graph> graph_;
+  std::unordered_map<Value*, CastedValue> cast_cache_;
+};
+
+} // namespace
+
+void InsertMixedPrecisionCasts(const std::shared_ptr<Graph>& graph) {
+  MixedPrecisionCastInserter(graph).run();
+}
+
+} // namespace jit
+} // namespace torch
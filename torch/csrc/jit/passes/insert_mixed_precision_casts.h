@@ -0,0 +1,24 @@
+#pragma once
+
+#include <torch/csrc/jit/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Rewrite a scripted graph for mixed-precision execution. Ops that are
+// fast and numerically safe in half precision (the matmul/convolution
+// family) get their floating-point tensor inputs cast to Half; ops whose
+// accumulation must stay in single precision (softmax, normalization
+// layers, reductions, losses) get theirs cast back to Float. Casts are
+// inserted as ordinary aten::to nodes, at most one per (value, dtype)
+// pair within a block, so runs of same-precision ops share a single cast
+// at the region boundary. aten::to is a no-op at runtime when the tensor
+// already has the requested dtype, so the pass is safe to apply to graphs
+// with unknown input dtypes.
+//
+// Gradient scaling is the caller's job; see torch::optim::LossScaler for
+// the matching training-loop utility.
+TORCH_API void InsertMixedPrecisionCasts(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
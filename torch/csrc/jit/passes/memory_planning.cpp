@@ -0,0 +1,158 @@
+#include <torch/csrc/jit/passes/memory_planning.h>
+#include <torch/csrc/jit/passes/liveness.h>
+
+#include <c10/core/ScalarType.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Matches the CPU allocator alignment (c10/core/CPUAllocator.cpp) so arena
+// slices are as aligned as individually allocated tensors
+constexpr size_t kArenaAlignment = 64;
+
+size_t alignUp(const size_t n) {
+  return (n + kArenaAlignment - 1) & ~(kArenaAlignment - 1);
+}
+
+// Returns the static byte size of v, or nullopt when its scalar type or
+// shape is not completely known
+c10::optional<size_t> byteSize(const Value* v) {
+  const auto type = v->type()->cast<TensorType>();
+  if (!type) {
+    return c10::nullopt;
+  }
+  const auto scalar_type = type->scalarType();
+  const auto sizes = type->sizes().concrete_sizes();
+  if (!scalar_type || !sizes) {
+    return c10::nullopt;
+  }
+  size_t numel = 1;
+  for (const auto size : *sizes) {
+    if (size < 0) {
+      return c10::nullopt;
+    }
+    numel *= static_cast<size_t>(size);
+  }
+  return numel * elementSize(*scalar_type);
+}
+
+struct Allocation {
+  const Value* value;
+  size_t size;
+  // Inclusive range of top-level node indices where the value is live
+  size_t first;
+  size_t last;
+  size_t offset;
+};
+
+bool lifetimesOverlap(const Allocation& a, const Allocation& b) {
+  return a.first <= b.last && b.first <= a.last;
+}
+
+} // namespace
+
+MemoryPlan PlanMemory(const std::shared_ptr<Graph>& graph) {
+  auto liveness = BuildLivenessSets(graph);
+
+  // Numbers the top-level nodes so liveness sets can be collapsed into
+  // intervals. Nodes in nested blocks are folded into their owning
+  // top-level node, which is conservative: a value live anywhere inside an
+  // if or loop is treated as live for the whole construct.
+  std::unordered_map<const Node*, size_t> node_index;
+  size_t index = 0;
+  for (const Node* node : graph->nodes()) {
+    node_index[node] = index++;
+  }
+
+  std::unordered_set<const Value*> excluded;
+  for (const Value* input : graph->inputs()) {
+    excluded.insert(input);
+  }
+  for (const Value* output : graph->outputs()) {
+    excluded.insert(output);
+  }
+
+  std::unordered_map<const Value*, Allocation> allocations;
+  for (const auto& entry : liveness) {
+    const Node* top = entry.first;
+    while (top->owningBlock() != graph->block()) {
+      top = top->owningBlock()->owningNode();
+    }
+    const auto it = node_index.find(top);
+    if (it == node_index.end()) {
+      continue;
+    }
+    const size_t at = it->second;
+    for (const Value* v : entry.second) {
+      if (excluded.count(v) != 0) {
+        continue;
+      }
+      const auto size = byteSize(v);
+      if (!size) {
+        continue;
+      }
+      auto inserted = allocations.emplace(v, Allocation{v, *size, at, at, 0});
+      if (!inserted.second) {
+        auto& allocation = inserted.first->second;
+        allocation.first = std::min(allocation.first, at);
+        allocation.last = std::max(allocation.last, at);
+      }
+    }
+  }
+
+  // First-fit decreasing: place large tensors first, each into the lowest
+  // aligned gap not claimed by an overlapping-lifetime neighbor. The order
+  // is made deterministic by breaking size ties on definition order.
+  std::vector<Allocation*> order;
+  order.reserve(allocations.size());
+  for (auto& entry : allocations) {
+    order.push_back(&entry.second);
+  }
+  std::sort(order.begin(), order.end(), [](Allocation* a, Allocation* b) {
+    if (a->size != b->size) {
+      return a->size > b->size;
+    }
+    if (a->first != b->first) {
+      return a->first < b->first;
+    }
+    return a->value->unique() < b->value->unique();
+  });
+
+  MemoryPlan plan;
+  for (size_t i = 0; i < order.size(); ++i) {
+    Allocation& allocation = *order[i];
+    // Occupied ranges that this allocation must avoid
+    std::vector<std::pair<size_t, size_t>> taken;
+    for (size_t j = 0; j < i; ++j) {
+      const Allocation& placed = *order[j];
+      if (lifetimesOverlap(allocation, placed)) {
+        taken.emplace_back(placed.offset, placed.offset + alignUp(placed.size));
+      }
+    }
+    std::sort(taken.begin(), taken.end());
+    size_t candidate = 0;
+    for (const auto& range : taken) {
+      if (candidate + allocation.size <= range.first) {
+        break;
+      }
+      candidate = std::max(candidate, range.second);
+    }
+    allocation.offset = candidate;
+    plan.arena_size =
+        std::max(plan.arena_size, candidate + alignUp(allocation.size));
+  }
+
+  for (const auto& entry : allocations) {
+    plan.offsets.emplace(entry.first, entry.second.offset);
+  }
+  return plan;
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/ir.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+
+// Ahead-of-time memory planning for intermediate tensors.
+//
+// PlanMemory computes, for every intermediate Value whose tensor type
+// carries a complete scalar type and shape (i.e. after shape propagation on
+// a shape-stable graph), a byte offset into a single arena such that values
+// whose lifetimes overlap never share bytes, while values with disjoint
+// lifetimes may. Lifetimes come from the liveness analysis in
+// passes/liveness.cpp; offsets are assigned greedily, largest tensor first,
+// into the lowest aligned gap that fits (first-fit decreasing).
+//
+// The plan is an analysis result, not a graph mutation: a runtime that
+// controls output allocation (e.g. one issuing out-variant ops against a
+// preallocated buffer) backs the planned values with slices of one arena
+// instead of going through the allocator for every intermediate. Graph
+// inputs and outputs are never planned -- their storage outlives a single
+// invocation -- and values without a static shape are simply left out of
+// the plan.
+struct MemoryPlan {
+  // Total bytes required for the arena
+  size_t arena_size = 0;
+  // Byte offsets into the arena, one entry per planned Value
+  std::unordered_map<const Value*, size_t> offsets;
+};
+
+TORCH_API MemoryPlan PlanMemory(const std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
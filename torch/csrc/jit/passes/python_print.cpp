@@ -1414,6 +1414,7 @@ bool printerHasSpecialCaseFor(Symbol sym) {
       prim::ChunkSizes, // optimization pass (fuser) adds it
       prim::Drop, // used in interpreter only
       prim::FusedConcat, // optimization pass adds it
+      prim::FusedSum, // optimization pass adds it
       prim::FusionGroup, // optimization pass adds it
       prim::Load, // used in interpreter only
       prim::MMTreeReduce, // used as an optimization
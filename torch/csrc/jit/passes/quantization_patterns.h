@@ -22,6 +22,31 @@ graph(%a_quant, %packed_params, %r_scale, %r_zero_point, %r_dtype, %stride, %pad
         %r_quant = quantized::conv2d(%a_quant, %packed_params, %stride, %padding, %dilation, %groups, %r_scale, %r_zero_point)
         return (%r_quant) )";
 
+  std::string conv2d_relu = R"(
+graph(%a_quant, %packed_params, %r_scale, %r_zero_point, %r_dtype, %stride, %padding, %dilation, %groups):
+        %a_dequant = aten::dequantize(%a_quant)
+        %w_quant : Tensor, %b : Tensor? = quantized::conv2d_unpack(%packed_params)
+        %w_dequant = aten::dequantize(%w_quant)
+        %conv_out = aten::conv2d(%a_dequant, %w_dequant, %b, %stride, %padding, %dilation, %groups)
+        %r = aten::relu(%conv_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string conv2d_inplace_relu = R"(
+graph(%a_quant, %packed_params, %r_scale, %r_zero_point, %r_dtype, %stride, %padding, %dilation, %groups):
+        %a_dequant = aten::dequantize(%a_quant)
+        %w_quant : Tensor, %b : Tensor? = quantized::conv2d_unpack(%packed_params)
+        %w_dequant = aten::dequantize(%w_quant)
+        %conv_out = aten::conv2d(%a_dequant, %w_dequant, %b, %stride, %padding, %dilation, %groups)
+        %r = aten::relu_(%conv_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_conv2d_relu = R"(
+graph(%a_quant, %packed_params, %r_scale, %r_zero_point, %r_dtype, %stride, %padding, %dilation, %groups):
+        %r_quant = quantized::conv2d_relu(%a_quant, %packed_params, %stride, %padding, %dilation, %groups, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
   std::string addmm = R"(
 graph(%packed_params, %a_quant, %r_scale, %r_zero_point, %r_dtype, %4):
         %a_dequant = aten::dequantize(%a_quant)
@@ -63,11 +88,123 @@ graph(%packed_params, %a_quant, %r_scale, %r_zero_point, %r_dtype):
         %r = quantized::linear(%a_quant, %packed_params, %r_scale, %r_zero_point)
         return (%r) )";
 
+  std::string addmm_relu = R"(
+graph(%packed_params, %a_quant, %r_scale, %r_zero_point, %r_dtype, %4):
+        %a_dequant = aten::dequantize(%a_quant)
+        %w_quant : Tensor, %b : Tensor? = quantized::linear_unpack(%packed_params)
+        %w_dequant = aten::dequantize(%w_quant)
+        %w_dequant_t = aten::t(%w_dequant)
+        %linear_out = aten::addmm(%b, %a_dequant, %w_dequant_t, %4, %4)
+        %r = aten::relu(%linear_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string addmm_inplace_relu = R"(
+graph(%packed_params, %a_quant, %r_scale, %r_zero_point, %r_dtype, %4):
+        %a_dequant = aten::dequantize(%a_quant)
+        %w_quant : Tensor, %b : Tensor? = quantized::linear_unpack(%packed_params)
+        %w_dequant = aten::dequantize(%w_quant)
+        %w_dequant_t = aten::t(%w_dequant)
+        %linear_out = aten::addmm(%b, %a_dequant, %w_dequant_t, %4, %4)
+        %r = aten::relu_(%linear_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_linear_relu = R"(
+graph(%packed_params, %a_quant, %r_scale, %r_zero_point, %r_dtype, %4):
+        %r = quantized::linear_relu(%a_quant, %packed_params, %r_scale, %r_zero_point)
+        return (%r) )";
+
+  // Like the addmm pattern above, the binary patterns assume the default
+  // alpha; QuantFusion only runs on graphs produced by the observer
+  // insertion pass, which does not emit non-unit alphas.
+  std::string add = R"(
+graph(%a_quant, %b_quant, %alpha, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %b_dequant = aten::dequantize(%b_quant)
+        %r = aten::add(%a_dequant, %b_dequant, %alpha)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string add_relu = R"(
+graph(%a_quant, %b_quant, %alpha, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %b_dequant = aten::dequantize(%b_quant)
+        %add_out = aten::add(%a_dequant, %b_dequant, %alpha)
+        %r = aten::relu(%add_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string add_inplace_relu = R"(
+graph(%a_quant, %b_quant, %alpha, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %b_dequant = aten::dequantize(%b_quant)
+        %add_out = aten::add(%a_dequant, %b_dequant, %alpha)
+        %r = aten::relu_(%add_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_add = R"(
+graph(%a_quant, %b_quant, %alpha, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::add(%a_quant, %b_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
+  std::string quantized_add_relu = R"(
+graph(%a_quant, %b_quant, %alpha, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::add_relu(%a_quant, %b_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
+  std::string mul = R"(
+graph(%a_quant, %b_quant, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %b_dequant = aten::dequantize(%b_quant)
+        %r = aten::mul(%a_dequant, %b_dequant)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string mul_relu = R"(
+graph(%a_quant, %b_quant, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %b_dequant = aten::dequantize(%b_quant)
+        %mul_out = aten::mul(%a_dequant, %b_dequant)
+        %r = aten::relu(%mul_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string mul_inplace_relu = R"(
+graph(%a_quant, %b_quant, %r_scale, %r_zero_point, %r_dtype):
+        %a_dequant = aten::dequantize(%a_quant)
+        %b_dequant = aten::dequantize(%b_quant)
+        %mul_out = aten::mul(%a_dequant, %b_dequant)
+        %r = aten::relu_(%mul_out)
+        %r_quant = aten::quantize_per_tensor(%r, %r_scale, %r_zero_point, %r_dtype)
+        return (%r_quant) )";
+
+  std::string quantized_mul = R"(
+graph(%a_quant, %b_quant, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::mul(%a_quant, %b_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
+  std::string quantized_mul_relu = R"(
+graph(%a_quant, %b_quant, %r_scale, %r_zero_point, %r_dtype):
+        %r_quant = quantized::mul_relu(%a_quant, %b_quant, %r_scale, %r_zero_point)
+        return (%r_quant) )";
+
   return {
     {conv2d, quantized_conv2d},
+    {conv2d_relu, quantized_conv2d_relu},
+    {conv2d_inplace_relu, quantized_conv2d_relu},
     {addmm, quantized_linear},
+    {addmm_relu, quantized_linear_relu},
+    {addmm_inplace_relu, quantized_linear_relu},
     {matmul_with_bias, quantized_linear},
-    {matmul_no_bias, quantized_linear_no_bias}
+    {matmul_no_bias, quantized_linear_no_bias},
+    {add, quantized_add},
+    {add_relu, quantized_add_relu},
+    {add_inplace_relu, quantized_add_relu},
+    {mul, quantized_mul},
+    {mul_relu, quantized_mul_relu},
+    {mul_inplace_relu, quantized_mul_relu}
   };
 
 }
@@ -685,6 +685,17 @@ class ShapePropagator {
       return PropagateCatShape(node);
     }
 
+    // Inserted by the graph fuser for reductions that terminate a fusion
+    // group; sums all elements of its input into a scalar.
+    if (node->kind() == prim::FusedSum) {
+      if (auto type = node->input()->type()->cast<TensorType>()) {
+        node->output()->setType(type->withDim(0));
+      } else {
+        setUnshapedType(node);
+      }
+      return;
+    }
+
     if (auto maybe_complete_types =
             gatherTensorTypes(node, /*complete=*/true)) {
       if (PropagateCompleteShapeOnNode(
@@ -837,7 +848,7 @@ class ShapePropagator {
             "aten::rrelu(Tensor self, Scalar lower, Scalar upper, bool training, Generator? generator) -> Tensor",
             "aten::rsqrt(Tensor self) -> Tensor",
             "aten::selu(Tensor self) -> Tensor",
-            "aten::gelu(Tensor self) -> Tensor",
+            "aten::gelu(Tensor self, bool approximate=False) -> Tensor",
             "aten::sigmoid(Tensor self) -> Tensor",
             "aten::sign(Tensor self) -> Tensor",
             "aten::sin(Tensor self) -> Tensor",
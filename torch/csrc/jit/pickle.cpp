@@ -13,8 +13,13 @@ uint16_t protocol_version = 1001;
 void pickle(
     std::function<void(const char* data_start, size_t data_len)> writer,
     const IValue& ivalue,
-    std::vector<at::Tensor>* tensor_table) {
-  Pickler pickler(std::move(writer), tensor_table);
+    std::vector<at::Tensor>* tensor_table,
+    bool use_shared_memory) {
+  Pickler pickler(
+      std::move(writer),
+      tensor_table,
+      /*memorized_class_types=*/nullptr,
+      use_shared_memory);
   pickler.protocol();
   pickler.pushIValue(ivalue);
   pickler.stop();
@@ -22,7 +27,8 @@ void pickle(
 
 std::vector<char> pickle(
     const IValue& ivalue,
-    std::vector<at::Tensor>* tensor_table) {
+    std::vector<at::Tensor>* tensor_table,
+    bool use_shared_memory) {
   std::vector<char> data;
 
   pickle(
@@ -30,7 +36,8 @@ std::vector<char> pickle(
         data.insert(data.end(), bytes, bytes + len);
       },
       ivalue,
-      tensor_table);
+      tensor_table,
+      use_shared_memory);
 
   return data;
 }
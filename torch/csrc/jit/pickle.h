@@ -13,11 +13,18 @@ namespace jit {
 /// `writer` is a function that takes in a pointer to a chunk of memory and its
 /// size and consumes it.
 ///
+/// If `use_shared_memory` is set, the storages of CPU tensors are moved into
+/// shared memory and pickled as handles instead of by value, so a consumer
+/// process on the same machine attaches to the data without copying it. Such
+/// a pickle is only loadable on the producing host; keep the default for
+/// anything that crosses a host boundary or outlives the producer.
+///
 /// See `jit::pickle` for more details.
 TORCH_API void pickle(
     std::function<void(const char* data_start, size_t data_len)> writer,
     const IValue& ivalue,
-    std::vector<at::Tensor>* tensor_table = nullptr);
+    std::vector<at::Tensor>* tensor_table = nullptr,
+    bool use_shared_memory = false);
 
 /// Save a `torch::IValue` in a format compatible with Python's `pickle` module
 ///
@@ -49,7 +56,8 @@ TORCH_API void pickle(
 /// \endrst
 TORCH_API std::vector<char> pickle(
     const IValue& ivalue,
-    std::vector<at::Tensor>* tensor_table = nullptr);
+    std::vector<at::Tensor>* tensor_table = nullptr,
+    bool use_shared_memory = false);
 
 
 TORCH_API std::vector<char> pickle_save(const IValue& ivalue);
@@ -1,8 +1,11 @@
 #include <ATen/ATen.h>
 #include <ATen/core/Dict.h>
+#include <TH/THAllocator.h>
 #include <torch/csrc/jit/function.h>
 #include <torch/csrc/jit/pickler.h>
 #include <aten/src/ATen/quantized/Quantizer.h>
+#include <atomic>
+#include <random>
 #include <string>
 
 namespace torch {
@@ -219,6 +222,56 @@ void Pickler::pushString(const std::string& string) {
   }
 }
 
+// Returns the shared-memory filename backing `storage`, moving the data
+// into a fresh refcounted shared-memory mapping if it is not already
+// there. The move swaps the storage's DataPtr in place, so the producer
+// and any views keep aliasing the now-shared data.
+static std::string getSharedMemoryHandle(const at::Storage& storage) {
+  const at::DataPtr& data_ptr = storage.unsafeGetStorageImpl()->data_ptr();
+  if (auto* alloc = THRefcountedMapAllocator::fromDataPtr(data_ptr)) {
+    return alloc->filename();
+  }
+  if (auto* alloc = THMapAllocator::fromDataPtr(data_ptr)) {
+    return alloc->filename();
+  }
+  // same naming scheme as torch.multiprocessing's storage sharing; the
+  // EXCLUSIVE flag turns the (unlikely) name collision into an error
+  static std::random_device rd;
+  static std::atomic<uint64_t> counter{0};
+  std::string handle = "/torch_shm_" + c10::to_string(rd()) + "_" +
+      c10::to_string(counter++);
+  int flags = TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE;
+  size_t nbytes = storage.size() * storage.elementSize();
+  at::DataPtr shm_ptr = THRefcountedMapAllocator::makeDataPtr(
+      handle.c_str(), flags, nbytes, /*actual_size_out=*/nullptr);
+  memcpy(shm_ptr.get(), storage.data(), nbytes);
+  storage.unsafeGetStorageImpl()->set_data_ptr(std::move(shm_ptr));
+  return handle;
+}
+
+// Pickles the storage as a ("storage_shm", dtype, filename, numel)
+// persistent id; the unpickler attaches to the mapping instead of copying
+// the data. Only meaningful for consumers on the same machine.
+void Pickler::pushStorageHandleOfTensor(const at::Tensor& tensor) {
+  const at::Storage& storage = tensor.storage();
+  std::string filename = getSharedMemoryHandle(storage);
+
+  // Tuple for persistent_load
+  push<PickleOpCode>(PickleOpCode::MARK);
+  // typename
+  pushString("storage_shm");
+  // data_type
+  std::string data_type =
+      std::string(toString(tensor.scalar_type())).append("Storage");
+  pushGlobal("torch", data_type);
+  // shared memory handle
+  pushString(filename);
+  // size
+  pushInt(tensor.storage().size());
+  push<PickleOpCode>(PickleOpCode::TUPLE);
+  push<PickleOpCode>(PickleOpCode::BINPERSID);
+}
+
 void Pickler::pushStorageOfTensor(const at::Tensor& tensor) {
   const at::Storage& storage = tensor.storage();
   void* addr = storage.unsafeGetStorageImpl();
@@ -228,6 +281,13 @@ void Pickler::pushStorageOfTensor(const at::Tensor& tensor) {
     return;
   }
 
+  if (use_shared_memory_ && tensor.device().is_cpu() &&
+      !tensor.is_quantized()) {
+    pushStorageHandleOfTensor(tensor);
+    memoized_storage_map_[addr] = pushNextBinPut();
+    return;
+  }
+
   // Tuple for persistent_load
   push<PickleOpCode>(PickleOpCode::MARK);
   // typename
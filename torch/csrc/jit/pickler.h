@@ -123,13 +123,22 @@ class Pickler {
   TH_DISALLOW_COPY_AND_ASSIGN(Pickler);
 
  public:
+  // If `use_shared_memory` is set, the storages of CPU tensors are moved
+  // into shared memory (unless they already live there) and pickled as a
+  // (filename, size) handle instead of by value, so a consumer on the same
+  // machine attaches to the data in O(metadata) instead of copying it.
+  // Such a pickle can only be loaded on the host that produced it and only
+  // while the producer keeps the mapping alive; leave the flag off for
+  // anything that crosses a host boundary or is written to durable storage.
   Pickler(
       std::function<void(const char*, size_t)> writer,
       std::vector<at::Tensor>* tensor_table,
-      std::vector<c10::ClassTypePtr>* memorized_class_types = nullptr)
+      std::vector<c10::ClassTypePtr>* memorized_class_types = nullptr,
+      bool use_shared_memory = false)
       : writer_(writer),
         tensor_table_(tensor_table),
-        memorized_class_types_(memorized_class_types) {}
+        memorized_class_types_(memorized_class_types),
+        use_shared_memory_(use_shared_memory) {}
   ~Pickler();
 
   // Push protocol onto the stack
@@ -162,6 +171,7 @@ class Pickler {
   void pushTensor(const IValue& ivalue);
   void pushTensorReference(const IValue& ivalue);
   void pushLiteralTensor(const IValue& ivalue);
+  void pushStorageHandleOfTensor(const at::Tensor& tensor);
   void pushTuple(const IValue& ivalue);
   void pushString(const std::string& string);
   // unmemoized version
@@ -253,6 +263,10 @@ class Pickler {
 
   std::unordered_map<std::string, uint32_t> memoized_globals_map_;
   std::unordered_map<std::string, uint32_t> memoized_strings_map_;
+
+  // Serialize CPU tensor storages as shared-memory handles instead of by
+  // value (see the constructor comment)
+  bool use_shared_memory_;
 };
 
 // returns a (tensor, record_size) for a tensor, converting it to a CPU tensor
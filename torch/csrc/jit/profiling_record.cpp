@@ -1,11 +1,30 @@
 #include <torch/csrc/jit/profiling_record.h>
 #include <torch/csrc/jit/passes/constant_propagation.h>
 
+#include <cstdlib>
+
 namespace torch {
 namespace jit {
 
+namespace {
+size_t initialNumProfiledRuns() {
+  if (const char* env = std::getenv("PYTORCH_JIT_NUM_PROFILED_RUNS")) {
+    const auto parsed = std::atol(env);
+    if (parsed > 0) {
+      return static_cast<size_t>(parsed);
+    }
+  }
+  return 1;
+}
+} // namespace
+
+std::atomic<size_t>& getNumProfiledRuns() {
+  static std::atomic<size_t> num_profiled_runs{initialNumProfiledRuns()};
+  return num_profiled_runs;
+}
+
 ProfilingRecord::ProfilingRecord(std::shared_ptr<Graph> g)
-    : profiled_graph_(std::move(g)), profiling_count_(1) {}
+    : profiled_graph_(std::move(g)), profiling_count_(getNumProfiledRuns()) {}
 
 ProfileOp* ProfilingRecord::createProfileNode(
     const std::function<void(Stack&)>& fp,
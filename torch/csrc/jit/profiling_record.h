@@ -7,6 +7,7 @@
 #include <ATen/core/stack.h>
 #include <torch/csrc/jit/ir.h>
 
+#include <atomic>
 #include <list>
 #include <vector>
 
@@ -15,6 +16,14 @@ namespace jit {
 
 using ::c10::TensorTypePtr;
 
+// The number of profiling runs the executor performs before it treats the
+// recorded shapes as stable and specializes. Observed types are merged
+// across runs, so extra runs turn shape dimensions that vary between
+// invocations into dynamic ones instead of guarding on the first value
+// seen. Defaults to 1; override with the PYTORCH_JIT_NUM_PROFILED_RUNS
+// environment variable or by assigning through the returned reference.
+TORCH_API std::atomic<size_t>& getNumProfiledRuns();
+
 struct ProfilingRecord {
   // N.B. ProfilingRecord's copy and move c-tor are disabled, so we won't
   // end up accidentally copying or moving ProfilingRecords whose addresses
@@ -82,6 +82,27 @@ c10::OperatorOptions aliasAnalysisSpecialCase() {
   return result;
 }
 
+// A forked subgraph below this size that contains no calls, nested forks,
+// or control flow runs inline on the forking thread instead of going to
+// the inter-op pool: for such tiny tasks the submission handshake costs
+// more than the work itself.
+constexpr size_t kSmallForkMaxNodes = 16;
+
+bool isSmallForkTask(const std::shared_ptr<Graph>& graph) {
+  size_t num_nodes = 0;
+  for (const Node* node : graph->nodes()) {
+    if (node->kind() == prim::fork || node->kind() == aten::wait ||
+        node->kind() == prim::CallFunction ||
+        node->kind() == prim::CallMethod || !node->blocks().empty()) {
+      return false;
+    }
+    if (++num_nodes > kSmallForkMaxNodes) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // using the rules from python_arg_parser FunctionParameter::check
 // tensor cannot have grad set, tensor must be 0 dim,
 // and if the dest is an int the source must be integral type
@@ -1280,6 +1301,7 @@ RegisterOperators reg(
          [](const Node* node) -> Operation {
            Code code(node->g(attr::Subgraph));
            int n_inputs = node->inputs().size();
+           bool run_inline = isSmallForkTask(node->g(attr::Subgraph));
            AT_ASSERT(node->blocks().size() == 0);
            AT_ASSERT(node->hasAttribute(attr::Subgraph));
            return [=](Stack& stack) {
@@ -1293,7 +1315,13 @@ RegisterOperators reg(
 
              push(stack, forked_interprester.getFuture());
 
-             at::launch(std::move(continuation));
+             if (run_inline) {
+               // Tiny task: the future completes before wait() can ever
+               // suspend on it.
+               continuation();
+             } else {
+               at::launch(std::move(continuation));
+             }
              return 0;
            };
          },
@@ -1,4 +1,5 @@
 #include <torch/csrc/jit/script/module.h>
+#include <ATen/core/grad_mode.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/autograd/generated/variable_factories.h>
 #include <torch/csrc/jit/export.h>
@@ -254,6 +255,23 @@ Module Module::clone_impl(
   return r;
 }
 
+void Module::warmup(std::vector<IValue> example_inputs, size_t iterations) {
+  std::vector<std::vector<IValue>> variants;
+  variants.push_back(std::move(example_inputs));
+  warmup(variants, iterations);
+}
+
+void Module::warmup(
+    const std::vector<std::vector<IValue>>& input_variants,
+    size_t iterations) {
+  at::NoGradGuard no_grad;
+  for (const auto& inputs : input_variants) {
+    for (size_t i = 0; i < iterations; ++i) {
+      forward(inputs);
+    }
+  }
+}
+
 void Module::train(bool on) {
   for (Module m : modules()) {
     if (auto slot = m.module_object()->type()->findAttributeSlot("training")) {
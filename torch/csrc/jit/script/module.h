@@ -168,6 +168,20 @@ struct TORCH_API Module {
     return get_method("forward")(std::move(inputs));
   }
 
+  /// Warms the module ahead of taking traffic: runs forward() on the
+  /// example inputs under a no-grad guard and discards the outputs, so
+  /// everything that otherwise happens lazily on the first request --
+  /// execution plan compilation in the graph executor, fuser
+  /// compilation, cudnn/mkldnn algorithm selection, allocator pool
+  /// growth -- happens now instead. Plans and backend algorithm caches
+  /// are shape-specialized, so pass every input-shape variant the
+  /// deployment will serve. `iterations` > 1 also exercises the cached
+  /// plan (profiled re-compilation, steady-state allocator sizing).
+  void warmup(std::vector<IValue> example_inputs, size_t iterations = 2);
+  void warmup(
+      const std::vector<std::vector<IValue>>& input_variants,
+      size_t iterations = 2);
+
   // In script modules, buffers are Tensors attribute that are _not_ registered
   // as parameters. This is different than in nn.Module where there is a special
   // register_buffer method. With this simplification, we only need to track
@@ -0,0 +1,126 @@
+#include <torch/csrc/jit/static_runtime.h>
+
+#include <torch/csrc/jit/constants.h>
+#include <torch/csrc/jit/graph_executor.h>
+#include <torch/csrc/jit/passes/inliner.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace jit {
+
+namespace {
+bool nodeIsSupported(const Node* node) {
+  if (node->kind() == prim::Constant) {
+    return true;
+  }
+  return node->blocks().empty() && findOperatorFor(node) != nullptr;
+}
+} // namespace
+
+bool StaticRuntime::canRun(const Graph& graph) {
+  for (const Node* node : graph.nodes()) {
+    if (!nodeIsSupported(node)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+StaticRuntime::StaticRuntime(std::shared_ptr<Graph> graph)
+    : graph_(graph->copy()) {
+  // The graph is expected to come out of GraphExecutor's optimization
+  // pipeline; inlining and the required passes are cheap and make the
+  // runtime usable on a freshly scripted function as well.
+  Inline(*graph_);
+  runRequiredPasses(graph_);
+
+  for (const Value* input : graph_->inputs()) {
+    input_registers_.push_back(registerFor(input));
+  }
+
+  size_t max_arity = 0;
+  for (Node* node : graph_->nodes()) {
+    TORCH_CHECK(
+        node->blocks().empty(),
+        "StaticRuntime does not support control flow; found ",
+        node->kind().toQualString());
+    if (node->kind() == prim::Constant) {
+      // Materialized once, below, after the register file is sized
+      registerFor(node->output());
+      continue;
+    }
+    OpEntry entry;
+    entry.node = node;
+    entry.operation = getOperation(node); // throws if there is no operator
+    for (const Value* input : node->inputs()) {
+      entry.inputs.push_back(registerFor(input));
+    }
+    for (const Value* output : node->outputs()) {
+      entry.outputs.push_back(registerFor(output));
+    }
+    max_arity =
+        std::max(max_arity, std::max(entry.inputs.size(), entry.outputs.size()));
+    ops_.push_back(std::move(entry));
+  }
+
+  for (const Value* output : graph_->outputs()) {
+    output_registers_.push_back(registerFor(output));
+  }
+
+  registers_.resize(value_to_register_.size());
+  stack_.reserve(max_arity);
+
+  // Constants live in their registers for the lifetime of the runtime
+  for (const Node* node : graph_->nodes()) {
+    if (node->kind() == prim::Constant) {
+      registers_[value_to_register_.at(node->output())] =
+          *toIValue(node->output());
+    }
+  }
+}
+
+size_t StaticRuntime::registerFor(const Value* v) {
+  auto it = value_to_register_.find(v);
+  if (it != value_to_register_.end()) {
+    return it->second;
+  }
+  const size_t reg = value_to_register_.size();
+  value_to_register_.emplace(v, reg);
+  return reg;
+}
+
+std::vector<IValue> StaticRuntime::run(const std::vector<IValue>& inputs) {
+  TORCH_CHECK(
+      inputs.size() == input_registers_.size(),
+      "expected ",
+      input_registers_.size(),
+      " inputs, but got ",
+      inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    registers_[input_registers_[i]] = inputs[i];
+  }
+
+  for (const OpEntry& op : ops_) {
+    stack_.clear();
+    for (const size_t reg : op.inputs) {
+      stack_.push_back(registers_[reg]);
+    }
+    op.operation(stack_);
+    AT_ASSERT(stack_.size() == op.outputs.size());
+    for (size_t i = op.outputs.size(); i > 0; --i) {
+      registers_[op.outputs[i - 1]] = std::move(stack_.back());
+      stack_.pop_back();
+    }
+  }
+
+  std::vector<IValue> outputs;
+  outputs.reserve(output_registers_.size());
+  for (const size_t reg : output_registers_) {
+    outputs.push_back(registers_[reg]);
+  }
+  return outputs;
+}
+
+} // namespace jit
+} // namespace torch
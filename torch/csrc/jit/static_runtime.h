@@ -0,0 +1,63 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/jit/ir.h>
+#include <torch/csrc/jit/operator.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// A minimal executor for frozen, shape-stable inference graphs.
+//
+// GraphExecutor answers "which specialization do I run?" on every call: it
+// computes an ArgumentSpec, takes the compile lock, and then interprets the
+// chosen plan instruction by instruction. For a server that always runs the
+// same graph none of that work changes between requests. StaticRuntime does
+// it once, at construction: every operator is resolved to its Operation up
+// front, every Value in the graph is assigned a slot in a preallocated
+// register file, constants are materialized into their slots, and run()
+// just walks a flat op list.
+//
+// Only straight-line graphs are supported: construction throws if the graph
+// contains control flow or a node without a registered operator (use
+// canRun() to check beforehand). Gradients are not computed; this is an
+// inference-only runtime. run() reuses the register file, so use one
+// StaticRuntime per serving thread or guard run() with a lock.
+struct TORCH_API StaticRuntime {
+  explicit StaticRuntime(std::shared_ptr<Graph> graph);
+
+  // Returns true if the graph only contains constructs run() can execute
+  static bool canRun(const Graph& graph);
+
+  std::vector<IValue> run(const std::vector<IValue>& inputs);
+
+ private:
+  // One entry per executable node, in topological order
+  struct OpEntry {
+    Node* node;
+    Operation operation;
+    std::vector<size_t> inputs; // register indices
+    std::vector<size_t> outputs; // register indices
+  };
+
+  // Returns the register holding v, assigning the next free one on first use
+  size_t registerFor(const Value* v);
+
+  std::shared_ptr<Graph> graph_;
+  std::vector<OpEntry> ops_;
+  // One slot per Value in the graph; constants are written once during
+  // construction and their slots are never overwritten
+  std::vector<IValue> registers_;
+  std::vector<size_t> input_registers_;
+  std::vector<size_t> output_registers_;
+  std::unordered_map<const Value*, size_t> value_to_register_;
+  // Scratch stack reused across ops and calls to avoid reallocation
+  Stack stack_;
+};
+
+} // namespace jit
+} // namespace torch
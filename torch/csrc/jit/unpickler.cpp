@@ -1,5 +1,6 @@
 #include <ATen/ATen.h>
 #include <ATen/core/Dict.h>
+#include <TH/THAllocator.h>
 #include <torch/csrc/jit/function.h>
 #include <torch/csrc/jit/pickler.h>
 #include "unpickler.h"
@@ -553,6 +554,28 @@ PickleOpCode Unpickler::readInstruction() {
     } break;
     case PickleOpCode::BINPERSID: {
       auto args = pop(stack_).toTuple()->elements();
+      if (args.at(0).toStringRef() == "storage_shm") {
+        // tensor pickled as a shared-memory handle (see
+        // Pickler::pushStorageHandleOfTensor); attach to the mapping
+        // instead of copying the data. Only valid on the producing host.
+        at::ScalarType type = args.at(1).toScalarType();
+        const std::string& filename = args.at(2).toStringRef();
+        int64_t numel = args.at(3).toInt();
+        int flags =
+            TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE;
+        size_t nbytes = numel * at::CPU(type).typeMeta().itemsize();
+        at::DataPtr storage_ptr = THRefcountedMapAllocator::makeDataPtr(
+            filename.c_str(), flags, nbytes, /*actual_size_out=*/nullptr);
+        at::Storage storage(
+            at::CPU(type).typeMeta(),
+            numel,
+            std::move(storage_ptr),
+            /*allocator=*/nullptr,
+            /*resizable=*/false);
+        auto tensor = at::empty({0}, at::CPU(type).options()).set_(storage);
+        stack_.push_back(std::move(tensor));
+        break;
+      }
       AT_ASSERT(
           args.at(0).toStringRef() == "storage",
           "unknown PERSID key ",
@@ -1,5 +1,7 @@
 #include <c10d/ProcessGroup.hpp>
 
+#include <algorithm>
+
 #include <c10/util/Logging.h>
 
 namespace c10d {
@@ -56,4 +58,53 @@ ProcessGroup::ProcessGroup(int rank, int size) : rank_(rank), size_(size) {
 
 ProcessGroup::~ProcessGroup() {}
 
+constexpr size_t ProcessGroup::CollectiveStats::kNumSizeBuckets;
+
+namespace {
+
+// Index of the histogram bucket for a payload of `bytes` bytes, i.e. the
+// position of its most significant bit, clamped to the bucket count.
+size_t sizeBucket(uint64_t bytes) {
+  size_t bucket = 0;
+  while (bytes >>= 1) {
+    bucket++;
+  }
+  return std::min(
+      bucket, ProcessGroup::CollectiveStats::kNumSizeBuckets - 1);
+}
+
+} // namespace
+
+std::vector<ProcessGroup::CollectiveStats> ProcessGroup::getCollectiveStats() {
+  flushPendingCollectives();
+  std::lock_guard<std::mutex> lock(collectiveStatsMutex_);
+  std::vector<CollectiveStats> stats;
+  stats.reserve(collectiveStats_.size());
+  for (const auto& entry : collectiveStats_) {
+    stats.push_back(entry.second);
+  }
+  return stats;
+}
+
+void ProcessGroup::resetCollectiveStats() {
+  flushPendingCollectives();
+  std::lock_guard<std::mutex> lock(collectiveStatsMutex_);
+  collectiveStats_.clear();
+}
+
+void ProcessGroup::recordCollective(
+    const std::string& opType,
+    uint64_t bytes,
+    double timeMs) {
+  std::lock_guard<std::mutex> lock(collectiveStatsMutex_);
+  auto& stats = collectiveStats_[opType];
+  if (stats.count == 0) {
+    stats.opType = opType;
+  }
+  stats.count++;
+  stats.totalBytes += bytes;
+  stats.totalTimeMs += timeMs;
+  stats.sizeHistogram[sizeBucket(bytes)]++;
+}
+
 } // namespace c10d
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -92,6 +93,22 @@ class ProcessGroup {
     std::exception_ptr exception_;
   };
 
+  // Aggregated per-operation timing statistics, collected while collective
+  // profiling is enabled. Achieved bandwidth for an operation follows from
+  // `totalBytes / totalTimeMs`. The histogram buckets message sizes by
+  // their binary magnitude: bucket `i` counts collectives whose payload
+  // was in `[2^i, 2^(i+1))` bytes (bucket 0 also counts empty payloads).
+  struct CollectiveStats {
+    static constexpr size_t kNumSizeBuckets = 48;
+
+    std::string opType;
+    uint64_t count = 0;
+    uint64_t totalBytes = 0;
+    double totalTimeMs = 0.0;
+    std::vector<uint64_t> sizeHistogram =
+        std::vector<uint64_t>(kNumSizeBuckets, 0);
+  };
+
   explicit ProcessGroup(int rank, int size);
   virtual ~ProcessGroup();
 
@@ -103,6 +120,22 @@ class ProcessGroup {
     return size_;
   }
 
+  // Enables or disables per-collective timing. Profiling is off by default;
+  // when off, collectives skip the instrumentation entirely.
+  void setCollectiveProfiling(bool enable) {
+    collectiveProfilingEnabled_ = enable;
+  }
+
+  bool collectiveProfilingEnabled() const {
+    return collectiveProfilingEnabled_;
+  }
+
+  // Returns a snapshot of the statistics collected so far, one entry per
+  // operation type.
+  std::vector<CollectiveStats> getCollectiveStats();
+
+  void resetCollectiveStats();
+
   virtual std::shared_ptr<ProcessGroup::Work> broadcast(
       std::vector<at::Tensor>& data,
       const BroadcastOptions& opts = BroadcastOptions()) = 0;
@@ -162,8 +195,21 @@ class ProcessGroup {
       const BarrierOptions& opts = BarrierOptions()) = 0;
 
  protected:
+  // Folds one completed collective into the statistics. Called by backends
+  // when a collective finishes; thread-safe.
+  void recordCollective(const std::string& opType, uint64_t bytes, double timeMs);
+
+  // Hook for backends whose timings only become available after the fact
+  // (e.g. CUDA events); called before a statistics snapshot is taken.
+  virtual void flushPendingCollectives() {}
+
   const int rank_;
   const int size_;
+
+ private:
+  std::atomic<bool> collectiveProfilingEnabled_{false};
+  std::mutex collectiveStatsMutex_;
+  std::unordered_map<std::string, CollectiveStats> collectiveStats_;
 };
 
 } // namespace c10d
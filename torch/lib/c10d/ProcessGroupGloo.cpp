@@ -5,6 +5,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <type_traits>
 
 #include <gloo/allgather.h>
@@ -390,7 +392,9 @@ void ProcessGroupGloo::RecvWork::wait() {
 }
 
 ProcessGroupGloo::Options::Options()
-    : timeout(std::chrono::milliseconds(10 * 1000)), threads(2) {}
+    : timeout(std::chrono::milliseconds(10 * 1000)),
+      threads(2),
+      hierarchicalAllreduce(false) {}
 
 namespace {
 
@@ -568,6 +572,10 @@ ProcessGroupGloo::ProcessGroupGloo(
     contexts_.push_back(std::move(context));
   }
 
+  if (options.hierarchicalAllreduce) {
+    initHierarchy(store, options);
+  }
+
   // Every worker thread stores the AsyncWork object it's currently
   // working on in the workInProgress_ vector. It must have size equal
   // to the number of workers such that they can simply index into it
@@ -598,6 +606,77 @@ ProcessGroupGloo::~ProcessGroupGloo() {
   }
 }
 
+void ProcessGroupGloo::initHierarchy(
+    const std::shared_ptr<Store>& store,
+    const Options& options) {
+  // Exchange hostnames through the store so that every rank derives the
+  // identical node grouping: nodes are numbered by order of first
+  // appearance, and ranks within a node by their global rank order.
+  std::array<char, 256> hostname;
+  SYSCHECK_ERR_RETURN_NEG1(
+      ::gethostname(hostname.data(), hostname.size() - 1));
+  hostname.back() = '\0';
+  {
+    std::string name(hostname.data());
+    store->set(
+        "hier/hostname/" + std::to_string(rank_),
+        std::vector<uint8_t>(name.begin(), name.end()));
+  }
+  std::vector<std::string> hostnames(size_);
+  for (int r = 0; r < size_; r++) {
+    auto value = store->get("hier/hostname/" + std::to_string(r));
+    hostnames[r] = std::string(value.begin(), value.end());
+  }
+
+  std::vector<std::string> nodes;
+  std::vector<int> nodeOfRank(size_);
+  for (int r = 0; r < size_; r++) {
+    auto it = std::find(nodes.begin(), nodes.end(), hostnames[r]);
+    if (it == nodes.end()) {
+      nodeOfRank[r] = nodes.size();
+      nodes.push_back(hostnames[r]);
+    } else {
+      nodeOfRank[r] = it - nodes.begin();
+    }
+  }
+  const int numNodes = nodes.size();
+  const int node = nodeOfRank[rank_];
+  int localRank = 0;
+  int localSize = 0;
+  for (int r = 0; r < size_; r++) {
+    if (nodeOfRank[r] == node) {
+      if (r == rank_) {
+        localRank = localSize;
+      }
+      localSize++;
+    }
+  }
+
+  // The hierarchy only pays off when there are both multiple nodes and
+  // multiple ranks per node; otherwise stay on the flat algorithms.
+  if (numNodes <= 1 || numNodes == size_) {
+    return;
+  }
+
+  {
+    auto context =
+        std::make_shared<::gloo::rendezvous::Context>(localRank, localSize);
+    auto prefixStore = ::gloo::rendezvous::PrefixStore(
+        "hier/intra/" + std::to_string(node), *store_);
+    context->setTimeout(options.timeout);
+    context->connectFullMesh(prefixStore, options.devices[0]);
+    intraNodeContext_ = std::move(context);
+  }
+  if (localRank == 0) {
+    auto context =
+        std::make_shared<::gloo::rendezvous::Context>(node, numNodes);
+    auto prefixStore = ::gloo::rendezvous::PrefixStore("hier/inter", *store_);
+    context->setTimeout(options.timeout);
+    context->connectFullMesh(prefixStore, options.devices[0]);
+    interNodeContext_ = std::move(context);
+  }
+}
+
 uint32_t ProcessGroupGloo::nextTag() {
   return collectiveCounter_++;
 }
@@ -640,6 +719,21 @@ void ProcessGroupGloo::enqueue(std::shared_ptr<AsyncWork> work) {
   workProduceCV_.notify_one();
 }
 
+void ProcessGroupGloo::enqueue(
+    std::shared_ptr<AsyncWork> work,
+    const char* opType,
+    uint64_t bytes) {
+  // The operation name also labels the autograd profiler range, so it is
+  // always set; the statistics owner is only set when profiling is
+  // enabled, which is what gates the bookkeeping.
+  work->statsOpType_ = opType;
+  work->statsBytes_ = bytes;
+  if (collectiveProfilingEnabled()) {
+    work->statsOwner_ = this;
+  }
+  enqueue(std::move(work));
+}
+
 namespace {
 
 class AsyncBroadcastWork : public ProcessGroupGloo::AsyncWork {
@@ -745,6 +839,19 @@ class AsyncBroadcastCUDAWork : public AsyncBroadcastWork {
 
 } // namespace
 
+namespace {
+
+// Local payload size of a collective, for profiling purposes.
+uint64_t tensorsBytes(const std::vector<at::Tensor>& tensors) {
+  uint64_t bytes = 0;
+  for (const auto& tensor : tensors) {
+    bytes += tensor.nbytes();
+  }
+  return bytes;
+}
+
+} // namespace
+
 std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::broadcast(
     std::vector<at::Tensor>& inputs,
     const BroadcastOptions& opts) {
@@ -783,7 +890,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::broadcast(
     throw std::runtime_error("Invalid backend");
   }
 
-  enqueue(work);
+  enqueue(work, "gloo:broadcast", tensorsBytes(inputs));
   return work;
 }
 
@@ -838,6 +945,74 @@ class AsyncAllreduceWork : public ProcessGroupGloo::AsyncWork {
   }
 };
 
+// Hierarchical allreduce: reduce to the node leader over the intra-node
+// context, allreduce among the node leaders only, then broadcast the result
+// back within the node. With K ranks per node the NIC carries 1/K-th of the
+// bytes of a flat allreduce. Intra-node traffic goes through the local
+// transport (loopback) rather than shared memory, which the gloo transports
+// in use here do not provide; those kernel copies are cheap relative to the
+// cross-host savings.
+class AsyncHierarchicalAllreduceWork : public AsyncAllreduceWork {
+ public:
+  AsyncHierarchicalAllreduceWork(
+      const std::shared_ptr<gloo::Context>& intraContext,
+      const std::shared_ptr<gloo::Context>& interContext,
+      std::vector<at::Tensor>& inputs,
+      ReduceOp reduceOp,
+      uint32_t tag)
+      : AsyncAllreduceWork(intraContext, inputs, reduceOp, tag),
+        interContext(interContext) {}
+
+  // Only set on the node leader (intra-node rank 0).
+  std::shared_ptr<gloo::Context> interContext;
+
+  void run() override {
+    const auto& scalarType = inputs[0].scalar_type();
+
+    // Phase 1: reduce to the node leader.
+    {
+      gloo::ReduceOptions opts(context);
+      opts.setRoot(0);
+      opts.setTag(tag);
+      opts.setReduceFunction(getReduceFunction(scalarType, reduceOp));
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, inputs[0]);
+      gloo::reduce(opts);
+    }
+
+    // Phase 2: allreduce among the node leaders.
+    if (interContext != nullptr) {
+      gloo::AllreduceOptions opts(interContext);
+      opts.setReduceFunction(getFunction(scalarType, reduceOp));
+      opts.setTag(tag);
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, inputs[0]);
+      gloo::allreduce(opts);
+    }
+
+    // Phase 3: broadcast the result back within the node.
+    {
+      gloo::BroadcastOptions opts(context);
+      opts.setRoot(0);
+      opts.setTag(tag);
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, inputs[0]);
+      gloo::broadcast(opts);
+    }
+  }
+
+ protected:
+  template <typename T>
+  void getReduceFunction(gloo::ReduceOptions::Func& fn, const ReduceOp op) {
+    fn = toFunction<T>(op);
+  }
+
+  gloo::ReduceOptions::Func getReduceFunction(
+      const at::ScalarType& dtype,
+      const ReduceOp op) {
+    gloo::ReduceOptions::Func fn;
+    GENERATE_ALL_TYPES(dtype, getReduceFunction, fn, op);
+    return fn;
+  }
+};
+
 class AsyncAllreduceCoalescedWork : public AsyncAllreduceWork {
  public:
   AsyncAllreduceCoalescedWork(
@@ -1296,8 +1471,15 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   auto context = getContext(tag);
   if (device.type() == at::kCPU) {
     if (layout == c10::kStrided) {
-      work = std::make_shared<AsyncAllreduceWork>(
-          std::move(context), inputs, opts.reduceOp, tag);
+      // Use the hierarchical path when it was set up at construction; the
+      // multi-input (local reduction) variant stays on the flat algorithm.
+      if (intraNodeContext_ != nullptr && inputs.size() == 1) {
+        work = std::make_shared<AsyncHierarchicalAllreduceWork>(
+            intraNodeContext_, interNodeContext_, inputs, opts.reduceOp, tag);
+      } else {
+        work = std::make_shared<AsyncAllreduceWork>(
+            std::move(context), inputs, opts.reduceOp, tag);
+      }
     } else if (layout == c10::kSparse) {
       work = std::make_shared<AsyncSparseAllreduceWork>(
           std::move(context), inputs, tag);
@@ -1320,7 +1502,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
     throw std::runtime_error("Invalid backend");
   }
 
-  enqueue(work);
+  enqueue(work, "gloo:all_reduce", tensorsBytes(inputs));
   return work;
 }
 
@@ -1380,7 +1562,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce_coalesced(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "gloo:all_reduce_coalesced", tensorsBytes(tensors));
   return work;
 }
 
@@ -1546,7 +1728,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::reduce(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "gloo:reduce", tensorsBytes(inputs));
   return work;
 }
 
@@ -1743,7 +1925,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allgather(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "gloo:all_gather", tensorsBytes(inputs));
   return work;
 }
 
@@ -1809,6 +1991,158 @@ class AsyncAllgatherCoalescedWork : public ProcessGroupGloo::AsyncWork {
   }
 };
 
+// Variable-length sparse allgather. Dense allgather_coalesced can flatten
+// its inputs into one fixed-size buffer because every rank contributes
+// identical shapes; sparse gradients differ in nnz per rank, so this work
+// first exchanges per-tensor metadata (shapes and nnz) with a single
+// allgather and then moves the index and value blocks of the whole input
+// list with one allgatherv each. Three collectives total regardless of how
+// many tensors are batched, where a per-tensor loop would pay the latency
+// floor once per embedding table.
+class AsyncSparseAllgatherWork : public ProcessGroupGloo::AsyncWork {
+ public:
+  using SparseTensorMetadata = AsyncSparseAllreduceWork::SparseTensorMetadata;
+
+  AsyncSparseAllgatherWork(
+      const std::shared_ptr<gloo::Context>& context,
+      std::vector<std::vector<at::Tensor>>& output_lists,
+      std::vector<at::Tensor>& input_list,
+      uint32_t tag)
+      : context(context),
+        output_lists(output_lists),
+        input_list(input_list),
+        tag(tag) {}
+
+  std::shared_ptr<gloo::Context> context;
+  std::vector<std::vector<at::Tensor>> output_lists;
+  std::vector<at::Tensor> input_list;
+  const uint32_t tag;
+
+  void allgather_sparse() {
+    // See the TODO in AsyncSparseAllreduceWork::allreduce about the
+    // Variable/Tensor confusion inside this function body.
+    at::AutoNonVariableTypeMode _no_grad(true);
+    const auto worldSize = context->size;
+    const auto ntensors = input_list.size();
+    const int64_t mdim = SparseTensorMetadata::dim;
+
+    // Need to coalesce before we can access indices and values.
+    std::vector<at::Tensor> inputs;
+    inputs.reserve(ntensors);
+    for (const auto& tensor : input_list) {
+      inputs.push_back(tensor.coalesce());
+    }
+
+    // Single allgather for the metadata of every tensor in the list.
+    auto buffer =
+        at::zeros({worldSize, static_cast<int64_t>(ntensors), mdim}, at::kLong);
+    for (size_t i = 0; i < ntensors; i++) {
+      SparseTensorMetadata md(buffer[context->rank][i]);
+      md.populate_from_sparse_tensor(inputs[i]);
+    }
+    {
+      gloo::AllgatherOptions opts(context);
+      opts.setOutput(buffer.data_ptr<int64_t>(), buffer.numel());
+      opts.setTag(tag);
+      gloo::allgather(opts);
+    }
+
+    // Sanity check dimensionality across ranks.
+    for (size_t i = 0; i < ntensors; i++) {
+      const auto expected =
+          SparseTensorMetadata(buffer[context->rank][i]).sizes();
+      for (auto rank = 0; rank < worldSize; rank++) {
+        const auto actual = SparseTensorMetadata(buffer[rank][i]).sizes();
+        AT_CHECK(actual == expected, "Sparse dimensions do not match");
+      }
+    }
+
+    // One allgatherv moves the packed indices of every tensor.
+    std::vector<size_t> counts(worldSize);
+    int64_t totalSize = 0;
+    for (auto rank = 0; rank < worldSize; rank++) {
+      counts[rank] = 0;
+      for (size_t i = 0; i < ntensors; i++) {
+        counts[rank] += SparseTensorMetadata(buffer[rank][i]).nnz() *
+            inputs[i].sparse_dim();
+      }
+      totalSize += counts[rank];
+    }
+    auto indicesOutput = at::empty({totalSize}, at::kLong);
+    std::vector<at::Tensor> indexParts;
+    indexParts.reserve(ntensors);
+    for (size_t i = 0; i < ntensors; i++) {
+      indexParts.push_back(inputs[i].indices().contiguous().reshape({-1}));
+    }
+    auto indicesInput = ntensors == 1 ? indexParts[0] : at::cat(indexParts);
+    {
+      gloo::AllgathervOptions opts(context);
+      opts.setInput(indicesInput.data_ptr<int64_t>(), indicesInput.numel());
+      opts.setOutput(indicesOutput.data_ptr<int64_t>(), counts);
+      opts.setTag(tag);
+      gloo::allgatherv(opts);
+    }
+
+    // And one allgatherv for the packed values.
+    const auto scalarType = inputs[0].scalar_type();
+    std::vector<int64_t> denseNumel(ntensors);
+    totalSize = 0;
+    for (auto rank = 0; rank < worldSize; rank++) {
+      counts[rank] = 0;
+      for (size_t i = 0; i < ntensors; i++) {
+        denseNumel[i] = 1;
+        for (auto dim : inputs[i].sizes().slice(inputs[i].sparse_dim())) {
+          denseNumel[i] *= dim;
+        }
+        counts[rank] +=
+            SparseTensorMetadata(buffer[rank][i]).nnz() * denseNumel[i];
+      }
+      totalSize += counts[rank];
+    }
+    auto valuesOutput = at::empty({totalSize}, scalarType);
+    std::vector<at::Tensor> valueParts;
+    valueParts.reserve(ntensors);
+    for (size_t i = 0; i < ntensors; i++) {
+      valueParts.push_back(inputs[i].values().contiguous().reshape({-1}));
+    }
+    auto valuesInput = ntensors == 1 ? valueParts[0] : at::cat(valueParts);
+    {
+      gloo::AllgathervOptions opts(context);
+      GENERATE_ALL_TYPES(scalarType, setInput, opts, valuesInput);
+      GENERATE_ALL_TYPES(scalarType, setOutput, opts, valuesOutput, counts);
+      opts.setTag(tag);
+      gloo::allgatherv(opts);
+    }
+
+    // Compile per-rank sparse tensors out of the packed blocks.
+    int64_t indexOffset = 0;
+    int64_t valueOffset = 0;
+    for (auto rank = 0; rank < worldSize; rank++) {
+      for (size_t i = 0; i < ntensors; i++) {
+        const auto nnz = SparseTensorMetadata(buffer[rank][i]).nnz();
+        const auto sparseDim = inputs[i].sparse_dim();
+        auto indices = indicesOutput.narrow(0, indexOffset, nnz * sparseDim)
+                           .reshape({sparseDim, nnz});
+        indexOffset += nnz * sparseDim;
+
+        const auto valueShape = inputs[i].sizes().slice(sparseDim);
+        std::vector<int64_t> shape({nnz});
+        shape.insert(shape.end(), valueShape.begin(), valueShape.end());
+        auto values = valuesOutput.narrow(0, valueOffset, nnz * denseNumel[i])
+                          .reshape(shape);
+        valueOffset += nnz * denseNumel[i];
+
+        output_lists[rank][i].copy_(at::sparse_coo_tensor(
+            indices, values, inputs[i].sizes(), inputs[i].options()));
+      }
+    }
+  }
+
+  void run() override {
+    allgather_sparse();
+  }
+};
+
 } // namespace
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allgather_coalesced(
@@ -1857,13 +2191,31 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allgather_coalesced(
     }
   }
 
-  assertDense(invalidArgument, input_list);
-
   auto tag = nextTag();
   auto context = getContext(tag);
-  auto work = std::make_shared<AsyncAllgatherCoalescedWork>(
-      std::move(context), output_lists, input_list, tag);
-  enqueue(work);
+  std::shared_ptr<AsyncWork> work;
+  if (input_list[0].layout() == c10::kSparse) {
+    // Sparse gradients take the batched variable-length path: per-rank nnz
+    // may differ, so the preallocated outputs are matched on shape and
+    // dtype above and overwritten with the gathered sparse tensors.
+    assertLayoutMatch(invalidArgument, input_list);
+    if (input_list[0].device().type() != at::kCPU) {
+      invalidArgument("unsupported device type for sparse tensors (CPU only)");
+    }
+    const auto scalarType = input_list[0].scalar_type();
+    for (const auto& tensor : input_list) {
+      if (tensor.scalar_type() != scalarType) {
+        invalidArgument("sparse tensors must share a single scalar type");
+      }
+    }
+    work = std::make_shared<AsyncSparseAllgatherWork>(
+        std::move(context), output_lists, input_list, tag);
+  } else {
+    assertDense(invalidArgument, input_list);
+    work = std::make_shared<AsyncAllgatherCoalescedWork>(
+        std::move(context), output_lists, input_list, tag);
+  }
+  enqueue(work, "gloo:all_gather_coalesced", tensorsBytes(input_list));
   return work;
 }
 
@@ -2067,7 +2419,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::gather(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "gloo:gather", tensorsBytes(inputs));
   return work;
 }
 
@@ -2253,7 +2605,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::scatter(
   } else {
     throw std::runtime_error("Invalid backend");
   }
-  enqueue(work);
+  enqueue(work, "gloo:scatter", tensorsBytes(outputs));
   return work;
 }
 
@@ -2400,7 +2752,7 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::barrier(
   auto context = getContext(tag);
   auto work = std::make_shared<AsyncBarrierWork>(
       std::move(context), std::move(priorWork), tag);
-  enqueue(work);
+  enqueue(work, "gloo:barrier", 0);
   return work;
 }
 
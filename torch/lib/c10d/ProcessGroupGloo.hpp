@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
@@ -13,6 +14,7 @@
 #include <gloo/rendezvous/store.h>
 #include <gloo/transport/device.h>
 
+#include <torch/csrc/autograd/record_function.h>
 #include <torch/csrc/utils/hash.h>
 
 #ifdef USE_CUDA
@@ -69,18 +71,38 @@ class ProcessGroupGloo : public ProcessGroup {
   class AsyncWork : public ProcessGroup::Work {
    public:
     static void execute(std::shared_ptr<AsyncWork> work) {
+      // When the autograd profiler is active, the collective shows up in
+      // its trace under the c10d operation name; the RecordFunction is a
+      // cheap no-op otherwise.
+      torch::autograd::profiler::RecordFunction record;
+      if (work->statsOpType_ != nullptr) {
+        record.before(work->statsOpType_);
+      }
+      const auto startTime = std::chrono::steady_clock::now();
       std::exception_ptr eptr;
       try {
         work->run();
       } catch (...) {
         eptr = std::current_exception();
       }
+      if (eptr == nullptr && work->statsOwner_ != nullptr) {
+        const auto elapsed =
+            std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - startTime);
+        work->statsOwner_->recordCollective(
+            work->statsOpType_, work->statsBytes_, elapsed.count());
+      }
       work->finish(eptr);
     }
 
     virtual void run() = 0;
 
    protected:
+    // Set through `initWorkProfiling` when collective profiling is enabled.
+    ProcessGroupGloo* statsOwner_ = nullptr;
+    const char* statsOpType_ = nullptr;
+    uint64_t statsBytes_ = 0;
+
     friend class ProcessGroupGloo;
   };
 
@@ -125,6 +147,13 @@ class ProcessGroupGloo : public ProcessGroup {
     std::vector<std::shared_ptr<::gloo::transport::Device>> devices;
     std::chrono::milliseconds timeout;
     int threads;
+
+    // If enabled, dense CPU allreduces run hierarchically: a reduce to a
+    // per-node leader, an allreduce among the leaders only, and a broadcast
+    // back within the node. Only the leaders talk across hosts, which cuts
+    // cross-host bytes by the number of ranks per node. Ranks are grouped
+    // into nodes by hostname during construction.
+    bool hierarchicalAllreduce;
   };
 
   // Helper functions to create a new device object.
@@ -215,6 +244,17 @@ class ProcessGroupGloo : public ProcessGroup {
  protected:
   std::unique_ptr<::gloo::rendezvous::Store> store_;
 
+  // Groups ranks into nodes by hostname and connects the intra-node and
+  // (on node leaders) inter-node contexts used by hierarchical allreduce.
+  // Leaves the contexts unset when the topology has nothing to gain from
+  // the hierarchy (a single node, or one rank per node).
+  void initHierarchy(const std::shared_ptr<Store>& store, const Options& options);
+
+  // Contexts for hierarchical allreduce; see Options::hierarchicalAllreduce.
+  // The inter-node context is only set on node leaders (local rank 0).
+  std::shared_ptr<::gloo::Context> intraNodeContext_;
+  std::shared_ptr<::gloo::Context> interNodeContext_;
+
   // Every Gloo context represents a set of connections to its peers.
   // In order to use more than one device (or allow for parallelism on
   // a single device), you need multiple contexts.
@@ -242,6 +282,14 @@ class ProcessGroupGloo : public ProcessGroup {
   // Queue work to run on worker thread.
   void enqueue(std::shared_ptr<AsyncWork> work);
 
+  // Like `enqueue`, but first tags the work item for collective profiling
+  // (a no-op when profiling is disabled). `opType` must have static storage
+  // duration; `bytes` is the local payload size of the collective.
+  void enqueue(
+      std::shared_ptr<AsyncWork> work,
+      const char* opType,
+      uint64_t bytes);
+
   // Keep both a queue of pending work, and a vector with in progress work.
   // Both of these can only be mutated when holding the queue lock.
   // We keep both around instead of just the queue, so we can grab a weak_ptr
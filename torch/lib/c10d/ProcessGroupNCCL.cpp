@@ -1,5 +1,6 @@
 #include <c10d/ProcessGroupNCCL.hpp>
 
+#include <algorithm>
 #include <map>
 #include <tuple>
 #include <unordered_set>
@@ -461,6 +462,29 @@ void check_gpu_tensors(const std::vector<at::Tensor>& tensors) {
   }
 }
 
+// Check that all `tensors' are dense, live on the same GPU, and have the
+// same type. Unlike `check_gpu_tensors', the tensors are coalesced into a
+// single flat buffer, so they may have arbitrary (and distinct) shapes.
+void check_gpu_tensors_coalesced(const std::vector<at::Tensor>& tensors) {
+  if (tensors.size() == 0) {
+    throw std::runtime_error("Tensor list must be nonempty");
+  }
+
+  const auto& first = tensors.front();
+
+  for (const auto& t : tensors) {
+    if (!t.is_cuda() || t.is_sparse()) {
+      throw std::runtime_error("Tensors must be CUDA and dense");
+    }
+    if (t.scalar_type() != first.scalar_type()) {
+      throw std::runtime_error("Tensors must have identical type");
+    }
+    if (t.get_device() != first.get_device()) {
+      throw std::runtime_error("Tensors must be on the same GPU device");
+    }
+  }
+}
+
 // Flatten each list in `tensor_lists' for a gather or scatter operation, and
 // ensure compatibility with the corresponding tensor in `other'.
 std::vector<at::Tensor> flatten_for_scatter_gather(
@@ -516,7 +540,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     std::vector<at::Tensor>& outputs,
     Fn fn,
     PreProcess pre,
-    PostProcess post) {
+    PostProcess post,
+    const char* opType) {
   const auto devices = getDeviceList(inputs);
   const auto key = getKeyFromDevices(devices);
   auto& ncclComms = getNCCLComm(key, devices);
@@ -529,6 +554,26 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
 
   at::cuda::OptionalCUDAGuard gpuGuard;
 
+  // When profiling, bracket the NCCL kernels with timing-capable events so
+  // that the device-side duration of the collective can be measured. The
+  // events are resolved into statistics by flushPendingCollectives() once
+  // they have fired.
+  const bool profilingEnabled = collectiveProfilingEnabled();
+  PendingCollectiveTiming timing;
+  if (profilingEnabled) {
+    timing.opType = opType;
+    timing.bytes = 0;
+    for (const auto& tensor : inputs) {
+      timing.bytes += tensor.nbytes();
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      gpuGuard.set_index(devices[i].index());
+      timing.startEvents.emplace_back(cudaEventDefault);
+      timing.endEvents.emplace_back(cudaEventDefault);
+      timing.startEvents[i].record(ncclStreams_[key][i]);
+    }
+  }
+
   pre(ncclStreams_[key]);
 
   for (size_t i = 0; i < inputs.size(); ++i) {
@@ -559,6 +604,15 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
 
   post(ncclStreams_[key]);
 
+  if (profilingEnabled) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      gpuGuard.set_index(devices[i].index());
+      timing.endEvents[i].record(ncclStreams_[key][i]);
+    }
+    std::lock_guard<std::mutex> lock(pendingTimingsMutex_);
+    pendingTimings_.push_back(std::move(timing));
+  }
+
   // Event should only be recorded after the ncclGroupEnd()
   for (size_t i = 0; i < inputs.size(); ++i) {
     at::cuda::CUDAStream& ncclStream = ncclStreams_[key][i];
@@ -575,13 +629,41 @@ template <typename Fn>
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::collective(
     std::vector<at::Tensor>& inputs,
     std::vector<at::Tensor>& outputs,
-    Fn fn) {
+    Fn fn,
+    const char* opType) {
   return collective(
       inputs,
       outputs,
       fn,
       [](std::vector<at::cuda::CUDAStream>&) {},
-      [](std::vector<at::cuda::CUDAStream>&) {});
+      [](std::vector<at::cuda::CUDAStream>&) {},
+      opType);
+}
+
+void ProcessGroupNCCL::flushPendingCollectives() {
+  std::lock_guard<std::mutex> lock(pendingTimingsMutex_);
+  for (auto it = pendingTimings_.begin(); it != pendingTimings_.end();) {
+    bool finished = true;
+    for (const auto& event : it->endEvents) {
+      if (!event.query()) {
+        finished = false;
+        break;
+      }
+    }
+    if (!finished) {
+      ++it;
+      continue;
+    }
+    // With one NCCL stream per device, the collective is as slow as its
+    // slowest participating device.
+    float timeMs = 0.0;
+    for (size_t i = 0; i < it->endEvents.size(); ++i) {
+      timeMs =
+          std::max(timeMs, it->startEvents[i].elapsed_time(it->endEvents[i]));
+    }
+    recordCollective(it->opType, it->bytes, timeMs);
+    it = pendingTimings_.erase(it);
+  }
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
@@ -604,14 +686,55 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce(
             ncclOp[opts.reduceOp],
             comm,
             stream.stream());
-      });
+      },
+      "nccl:all_reduce");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allreduce_coalesced(
     std::vector<at::Tensor>& tensors,
     const AllreduceCoalescedOptions& opts) {
-  throw std::runtime_error(
-      "allreduce_coalesced is currently not supported with NCCL");
+  check_gpu_tensors_coalesced(tensors);
+
+  // Coalesce the tensors into a single flat buffer so that the reduction
+  // runs as one NCCL kernel instead of one per tensor; many small tensors
+  // otherwise reach only a fraction of the available bandwidth.
+  std::vector<at::Tensor> flattened = {flattenDenseTensors(tensors)};
+
+  return collective(
+      flattened,
+      flattened,
+      [&](at::Tensor& input,
+          at::Tensor& output,
+          ncclComm_t comm,
+          at::cuda::CUDAStream& stream) {
+        return ncclAllReduce(
+            input.data_ptr(),
+            output.data_ptr(),
+            input.numel(),
+            getNcclDataType(input.scalar_type()),
+            ncclOp[opts.reduceOp],
+            comm,
+            stream.stream());
+      },
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {
+        // Scatter the reduced flat buffer back into the input tensors.
+        at::cuda::CUDAStreamGuard guard(ncclStreams[0]);
+        size_t offset = 0;
+        for (at::Tensor& tensor : tensors) {
+          // See [Sync Streams].
+          c10::cuda::CUDACachingAllocator::recordStream(
+              tensor.storage().data(), ncclStreams[0]);
+
+          tensor.copy_(
+              flattened[0]
+                  .narrow(0, offset, tensor.numel())
+                  .view(tensor.sizes()),
+              true);
+          offset += tensor.numel();
+        }
+      },
+      "nccl:all_reduce_coalesced");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
@@ -634,7 +757,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::broadcast(
             root,
             comm,
             stream.stream());
-      });
+      },
+      "nccl:broadcast");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce(
@@ -659,7 +783,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce(
             root,
             comm,
             stream.stream());
-      });
+      },
+      "nccl:reduce");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather(
@@ -702,15 +827,20 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather(
             outputTensors[i][j].copy_(outputFlattened[i][j], true);
           }
         }
-      });
+      },
+      "nccl:all_gather");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::allgather_coalesced(
     std::vector<std::vector<at::Tensor>>& /* unused */,
     std::vector<at::Tensor>& /* unused */,
     const AllgatherOptions& /* unused */) {
+  // NCCL has no variable-length collective, so neither the flattened dense
+  // path nor the batched sparse path (see ProcessGroupGloo) can be
+  // expressed here without padding every rank to the maximum size.
   throw std::runtime_error(
-      "ProcessGroupNCCL does not support allgather_coalesced");
+      "ProcessGroupNCCL does not support allgather_coalesced; "
+      "use the gloo backend for batched (including sparse) allgather");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce_scatter(
@@ -754,7 +884,8 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::reduce_scatter(
           }
         }
       },
-      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {});
+      [&](std::vector<at::cuda::CUDAStream>& ncclStreams) {},
+      "nccl:reduce_scatter");
 }
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupNCCL::barrier(
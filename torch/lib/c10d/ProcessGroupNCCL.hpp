@@ -241,18 +241,35 @@ class ProcessGroupNCCL : public ProcessGroup {
   //    ncclResult_t fn(at::Tensor& input, at::Tensor& output,
   //                    ncclComm_t, at::cuda::CUDAStream&);
   //    void {pre,post}(std::vector<at::cuda::CUDAStream&>);
+  // `opType` names the collective for the profiling statistics; it must
+  // have static storage duration.
   template <typename Fn>
   std::shared_ptr<ProcessGroup::Work> collective(
       std::vector<at::Tensor>& input,
       std::vector<at::Tensor>& output,
-      Fn fn);
+      Fn fn,
+      const char* opType);
   template <typename Fn, typename PreProcess, typename PostProcess>
   std::shared_ptr<ProcessGroup::Work> collective(
       std::vector<at::Tensor>& input,
       std::vector<at::Tensor>& output,
       Fn fn,
       PreProcess pre,
-      PostProcess post);
+      PostProcess post,
+      const char* opType);
+
+  // Timing information for a collective whose CUDA events have been
+  // recorded but may not have completed on the GPU yet. Entries are
+  // resolved into statistics once their end events have fired.
+  struct PendingCollectiveTiming {
+    std::string opType;
+    uint64_t bytes;
+    std::vector<at::cuda::CUDAEvent> startEvents;
+    std::vector<at::cuda::CUDAEvent> endEvents;
+  };
+
+  // Resolves all pending timings whose GPU execution has finished.
+  void flushPendingCollectives() override;
 
   // Checks for NCCL errors on each of the communicators and returns an
   // appropriate exception_ptr (nullptr if no errors).
@@ -354,6 +371,12 @@ class ProcessGroupNCCL : public ProcessGroup {
 
   // Timeout for operations. This is only used when blockingWait_ is enabled.
   std::chrono::milliseconds opTimeout_;
+
+  // Collectives whose profiling events have not completed yet; guarded by
+  // pendingTimingsMutex_. Only populated while collective profiling is
+  // enabled.
+  std::mutex pendingTimingsMutex_;
+  std::vector<PendingCollectiveTiming> pendingTimings_;
 };
 
 } // namespace c10d
@@ -1,16 +1,21 @@
 #include <c10d/TCPStore.hpp>
 
 #include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+#include <sys/ioctl.h>
 
 #include <unistd.h>
 #include <algorithm>
+#include <array>
 #include <system_error>
 
 namespace c10d {
 
 namespace {
 
-enum class QueryType : uint8_t { SET, GET, ADD, CHECK, WAIT };
+enum class QueryType : uint8_t { SET, GET, ADD, CHECK, WAIT, MULTI_SET, MULTI_GET };
 
 enum class CheckResponseType : uint8_t { READY, NOT_READY };
 
@@ -54,6 +59,68 @@ void TCPStoreDaemon::join() {
   daemonThread_.join();
 }
 
+#ifdef __linux__
+
+// The daemon event loop is built on epoll: a wakeup only reports the sockets
+// that are actually ready, instead of rescanning one pollfd per worker, so
+// rendezvous with hundreds of workers doesn't degrade quadratically.
+void TCPStoreDaemon::run() {
+  int epollFd;
+  SYSCHECK_ERR_RETURN_NEG1(epollFd = ::epoll_create1(0));
+  auto addFd = [epollFd](int fd, uint32_t events) {
+    struct epoll_event event = {};
+    event.events = events;
+    event.data.fd = fd;
+    SYSCHECK_ERR_RETURN_NEG1(::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event));
+  };
+  addFd(storeListenSocket_, EPOLLIN);
+  // The read end of the pipe signals the stopping of the daemon run; its
+  // hangup is reported whether or not it was requested.
+  addFd(controlPipeFd_[0], 0);
+
+  std::array<struct epoll_event, 64> events;
+  bool finished = false;
+  while (!finished) {
+    int numReady;
+    SYSCHECK_ERR_RETURN_NEG1(
+        numReady = ::epoll_wait(epollFd, events.data(), events.size(), -1));
+    for (int i = 0; i < numReady; i++) {
+      const int fd = events[i].data.fd;
+      if (fd == controlPipeFd_[0]) {
+        // Will be EPOLLHUP when the write end of the pipe is closed
+        finished = true;
+        break;
+      } else if (fd == storeListenSocket_) {
+        // The listening socket should now be able to accept new connections.
+        int sockFd = std::get<0>(tcputil::accept(storeListenSocket_));
+        sockets_.push_back(sockFd);
+        addFd(sockFd, EPOLLIN);
+      } else {
+        try {
+          queryPipelined(fd);
+        } catch (...) {
+          // There was an error when processing query. Probably an exception
+          // occurred in recv/send what would indicate that socket on the
+          // other side has been closed. If the closing was due to normal
+          // exit, then the store should continue executing. Otherwise, if it
+          // was different exception, other connections will get an exception
+          // once they try to use the store. We will go ahead and close this
+          // connection whenever we hit an exception here.
+          ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+          ::close(fd);
+          removeClientState(fd);
+          sockets_.erase(
+              std::remove(sockets_.begin(), sockets_.end(), fd),
+              sockets_.end());
+        }
+      }
+    }
+  }
+  ::close(epollFd);
+}
+
+#else
+
 void TCPStoreDaemon::run() {
   std::vector<struct pollfd> fds;
   fds.push_back({.fd = storeListenSocket_, .events = POLLIN});
@@ -106,7 +173,7 @@ void TCPStoreDaemon::run() {
 
       // Now query the socket that has the event
       try {
-        query(fds[fdIdx].fd);
+        queryPipelined(fds[fdIdx].fd);
       } catch (...) {
         // There was an error when processing query. Probably an exception
         // occurred in recv/send what would indicate that socket on the other
@@ -116,29 +183,7 @@ void TCPStoreDaemon::run() {
         // use the store. We will go ahead and close this connection whenever
         // we hit an exception here.
         ::close(fds[fdIdx].fd);
-
-        // Remove all the tracking state of the close FD
-        for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
-          for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
-            if (*vecIt == fds[fdIdx].fd) {
-              vecIt = it->second.erase(vecIt);
-            } else {
-              ++vecIt;
-            }
-          }
-          if (it->second.size() == 0) {
-            it = waitingSockets_.erase(it);
-          } else {
-            ++it;
-          }
-        }
-        for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
-          if (it->first == fds[fdIdx].fd) {
-            it = keysAwaited_.erase(it);
-          } else {
-            ++it;
-          }
-        }
+        removeClientState(fds[fdIdx].fd);
         fds.erase(fds.begin() + fdIdx);
         sockets_.erase(sockets_.begin() + fdIdx - 2);
         --fdIdx;
@@ -148,6 +193,46 @@ void TCPStoreDaemon::run() {
   }
 }
 
+#endif
+
+void TCPStoreDaemon::removeClientState(int socket) {
+  for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
+    for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
+      if (*vecIt == socket) {
+        vecIt = it->second.erase(vecIt);
+      } else {
+        ++vecIt;
+      }
+    }
+    if (it->second.size() == 0) {
+      it = waitingSockets_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
+    if (it->first == socket) {
+      it = keysAwaited_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void TCPStoreDaemon::queryPipelined(int socket) {
+  // Serve the request that triggered the wakeup, then keep going while more
+  // request bytes are already buffered on the socket. A request whose tail
+  // has not arrived yet still blocks on its remainder, as before; this only
+  // collapses the wakeups for clients that pipeline complete requests.
+  do {
+    query(socket);
+  } while ([socket] {
+    int available = 0;
+    SYSCHECK_ERR_RETURN_NEG1(::ioctl(socket, FIONREAD, &available));
+    return available > 0;
+  }());
+}
+
 void TCPStoreDaemon::stop() {
   if (controlPipeFd_[1] != -1) {
     // close the write end of the pipe
@@ -180,6 +265,12 @@ void TCPStoreDaemon::query(int socket) {
   } else if (qt == QueryType::WAIT) {
     waitHandler(socket);
 
+  } else if (qt == QueryType::MULTI_SET) {
+    multiSetHandler(socket);
+
+  } else if (qt == QueryType::MULTI_GET) {
+    multiGetHandler(socket);
+
   } else {
     throw std::runtime_error("Unexpected query type");
   }
@@ -205,6 +296,16 @@ void TCPStoreDaemon::setHandler(int socket) {
   wakeupWaitingClients(key);
 }
 
+void TCPStoreDaemon::multiSetHandler(int socket) {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  for (size_t i = 0; i < nargs; i++) {
+    std::string key = tcputil::recvString(socket);
+    tcpStore_[key] = tcputil::recvVector<uint8_t>(socket);
+    wakeupWaitingClients(key);
+  }
+}
+
 void TCPStoreDaemon::addHandler(int socket) {
   std::string key = tcputil::recvString(socket);
   int64_t addVal = tcputil::recvValue<int64_t>(socket);
@@ -228,6 +329,19 @@ void TCPStoreDaemon::getHandler(int socket) const {
   tcputil::sendVector<uint8_t>(socket, data);
 }
 
+void TCPStoreDaemon::multiGetHandler(int socket) const {
+  SizeType nargs;
+  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
+  std::vector<std::string> keys(nargs);
+  for (size_t i = 0; i < nargs; i++) {
+    keys[i] = tcputil::recvString(socket);
+  }
+  for (size_t i = 0; i < nargs; i++) {
+    tcputil::sendVector<uint8_t>(
+        socket, tcpStore_.at(keys[i]), (i != (nargs - 1)));
+  }
+}
+
 void TCPStoreDaemon::checkHandler(int socket) const {
   SizeType nargs;
   tcputil::recvBytes<SizeType>(socket, &nargs, 1);
@@ -349,6 +463,45 @@ std::vector<uint8_t> TCPStore::getHelper_(const std::string& key) {
   return tcputil::recvVector<uint8_t>(storeSocket_);
 }
 
+std::vector<std::vector<uint8_t>> TCPStore::multiGet(
+    const std::vector<std::string>& keys) {
+  std::vector<std::string> regKeys(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    regKeys[i] = regularPrefix_ + keys[i];
+  }
+  // One wait round trip for all keys, then one batched get.
+  waitHelper_(regKeys, timeout_);
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_GET);
+  SizeType nkeys = regKeys.size();
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    tcputil::sendString(storeSocket_, regKeys[i], (i != (nkeys - 1)));
+  }
+  std::vector<std::vector<uint8_t>> result;
+  result.reserve(nkeys);
+  for (size_t i = 0; i < nkeys; i++) {
+    result.push_back(tcputil::recvVector<uint8_t>(storeSocket_));
+  }
+  return result;
+}
+
+void TCPStore::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  if (keys.size() != values.size()) {
+    throw std::runtime_error(
+        "multiSet expects one value for every key");
+  }
+  tcputil::sendValue<QueryType>(storeSocket_, QueryType::MULTI_SET);
+  SizeType nkeys = keys.size();
+  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
+  for (size_t i = 0; i < nkeys; i++) {
+    std::string regKey = regularPrefix_ + keys[i];
+    tcputil::sendString(storeSocket_, regKey, true);
+    tcputil::sendVector<uint8_t>(storeSocket_, values[i], (i != (nkeys - 1)));
+  }
+}
+
 int64_t TCPStore::add(const std::string& key, int64_t value) {
   std::string regKey = regularPrefix_ + key;
   return addHelper_(regKey, value);
@@ -22,9 +22,19 @@ class TCPStoreDaemon {
 
   void query(int socket);
 
+  // Handles the request that woke us up, plus any further requests that are
+  // already buffered on the socket, so a client that pipelines several
+  // requests is served in a single wakeup.
+  void queryPipelined(int socket);
+
+  // Drops the wait-notification state held for a disconnected client.
+  void removeClientState(int socket);
+
   void setHandler(int socket);
+  void multiSetHandler(int socket);
   void addHandler(int socket);
   void getHandler(int socket) const;
+  void multiGetHandler(int socket) const;
   void checkHandler(int socket) const;
   void waitHandler(int socket);
 
@@ -68,6 +78,15 @@ class TCPStore : public Store {
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout) override;
 
+  // Batched variants that fetch or publish several keys in one round trip
+  // to the store daemon, instead of one request/response pair per key.
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys);
+
+  void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values);
+
  protected:
   int64_t addHelper_(const std::string& key, int64_t value);
   std::vector<uint8_t> getHelper_(const std::string& key);
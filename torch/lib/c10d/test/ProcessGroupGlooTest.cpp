@@ -243,6 +243,48 @@ void testBroadcast(const std::string& path, const at::DeviceType b) {
   }
 }
 
+void testCollectiveStats(const std::string& path) {
+  const auto size = 2;
+  auto tests = CollectiveTest::initialize(path, size);
+
+  for (auto i = 0; i < size; i++) {
+    tests[i].getProcessGroup().setCollectiveProfiling(true);
+  }
+
+  // Generate inputs
+  std::vector<std::vector<at::Tensor>> inputs(size);
+  for (auto i = 0; i < size; i++) {
+    auto tensor = at::ones({16, 16}) * i;
+    inputs[i] = std::vector<at::Tensor>({tensor});
+  }
+
+  // Kick off work
+  std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+  for (auto i = 0; i < size; i++) {
+    work[i] = tests[i].getProcessGroup().allreduce(inputs[i]);
+  }
+
+  // Wait for work to complete
+  for (auto i = 0; i < size; i++) {
+    work[i]->wait();
+  }
+
+  // Every process should have recorded exactly one allreduce of
+  // 16 * 16 * sizeof(float) = 1024 bytes (size bucket 10).
+  for (auto i = 0; i < size; i++) {
+    auto stats = tests[i].getProcessGroup().getCollectiveStats();
+    if (stats.size() != 1) {
+      throw std::runtime_error("BOOM!");
+    }
+    const auto& entry = stats[0];
+    if (entry.opType != "gloo:all_reduce" || entry.count != 1 ||
+        entry.totalBytes != 1024 || entry.totalTimeMs < 0.0 ||
+        entry.sizeHistogram[10] != 1) {
+      throw std::runtime_error("BOOM!");
+    }
+  }
+}
+
 void testBarrier(const std::string& path) {
   const auto size = 2;
   auto tests = CollectiveTest::initialize(path, size);
@@ -309,6 +351,11 @@ int main(int argc, char** argv) {
     testBarrier(file.path);
   }
 
+  {
+    TemporaryFile file;
+    testCollectiveStats(file.path);
+  }
+
   std::cout << "Test successful" << std::endl;
   return 0;
 }
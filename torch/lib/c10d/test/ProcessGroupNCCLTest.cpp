@@ -164,6 +164,44 @@ class AllreduceNCCLTest : public NCCLTest {
   }
 };
 
+class AllreduceCoalescedNCCLTest : public NCCLTest {
+ public:
+  AllreduceCoalescedNCCLTest(const std::string& path, int worldSize)
+      : NCCLTest(path, worldSize) {}
+
+  std::shared_ptr<c10d::ProcessGroup::Work> run() {
+    // For the duration of this function, make THC use our streams
+    at::cuda::CUDAMultiStreamGuard guard(streams_);
+
+    // Coalesced tensors may have arbitrary shapes, but must share a device
+    // and type. Use device 0 only; the coalesced variant takes a list of
+    // tensors on a single device rather than one tensor per device.
+    at::cuda::OptionalCUDAGuard deviceGuard;
+    deviceGuard.set_index(0);
+    coalescedTensors_ = {
+        at::empty({3, 3}, at::kCUDA).fill_(pg_->getRank()),
+        at::empty({5}, at::kCUDA).fill_(pg_->getRank()),
+        at::empty({2, 4}, at::kCUDA).fill_(pg_->getRank())};
+
+    return pg_->allreduce_coalesced(coalescedTensors_);
+  }
+
+  std::vector<at::Tensor> getCoalescedTensors() {
+    // For the duration of this function, make THC use our streams
+    at::cuda::CUDAMultiStreamGuard guard(streams_);
+
+    std::vector<at::Tensor> outputs;
+    cudaStreamSynchronize(streams_[0].stream());
+    for (auto& tensor : coalescedTensors_) {
+      outputs.push_back(tensor.cpu());
+    }
+    return outputs;
+  }
+
+ private:
+  std::vector<at::Tensor> coalescedTensors_;
+};
+
 class BroadcastNCCLTest : public NCCLTest {
  public:
   BroadcastNCCLTest(const std::string& path, int worldSize)
@@ -299,6 +337,28 @@ void testAllreduce(const std::string& path, int rank, int size) {
   std::cout << "Allreduce test successful" << std::endl;
 }
 
+void testAllreduceCoalesced(const std::string& path, int rank, int size) {
+  auto test = AllreduceCoalescedNCCLTest(path, size);
+  test.initialize(rank, size);
+  auto work = test.run();
+  // Wait for work to finish
+  test.wait(work);
+
+  // Validation
+  const auto expected = (size * (size - 1)) / 2;
+  auto tensors = test.getCoalescedTensors();
+  for (size_t j = 0; j < tensors.size(); j++) {
+    auto& tensor = tensors[j];
+    auto data = tensor.data_ptr<float>();
+    for (auto k = 0; k < tensor.numel(); k++) {
+      if (data[k] != expected) {
+        throw std::runtime_error("BOOM!");
+      }
+    }
+  }
+  std::cout << "AllreduceCoalesced test successful" << std::endl;
+}
+
 void testBroadcast(const std::string& path, int rank, int size) {
   auto test = BroadcastNCCLTest(path, size);
   test.initialize(rank, size);
@@ -436,6 +496,7 @@ int main(int argc, char** argv) {
   TemporaryFile file;
 
   testAllreduce(file.path, rank, size);
+  testAllreduceCoalesced(file.path, rank, size);
   testBroadcast(file.path, rank, size);
   testReduce(file.path, rank, size);
   testAllgather(file.path, rank, size);
@@ -22,6 +22,19 @@ void testHelper(const std::string& prefix = "") {
   c10d::test::check(serverStore, "key1", "value1");
   c10d::test::check(serverStore, "key2", "value2");
 
+  // Batched multi-key set/get (TCPStore specific)
+  std::vector<std::string> multiKeys = {"mkey0", "mkey1", "mkey2"};
+  std::vector<std::vector<uint8_t>> multiValues;
+  for (const auto& key : multiKeys) {
+    std::string value = "value_for_" + key;
+    multiValues.push_back(std::vector<uint8_t>(value.begin(), value.end()));
+  }
+  serverTCPStore.multiSet(multiKeys, multiValues);
+  auto multiResult = serverTCPStore.multiGet(multiKeys);
+  if (multiResult != multiValues) {
+    throw std::runtime_error("multiGet returned unexpected values");
+  }
+
   // Hammer on TCPStore
   std::vector<std::thread> threads;
   const auto numIterations = 1000;
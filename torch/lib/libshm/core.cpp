@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <cstring>
 #include <string>
 #include <unordered_map>
@@ -10,6 +11,12 @@
 std::unordered_map<std::string, ClientSocket> managers;
 std::string manager_executable_path;
 
+// See the comment on libshm_set_managerless in libshm.h. The sentinel
+// stands in for a manager socket address in segments that have no
+// manager; it contains no '/' so it can never collide with one.
+static bool managerless = false;
+static const std::string managerless_handle = "no_manager";
+
 AllocInfo get_alloc_info(const char* filename) {
   AllocInfo info = {0};
   info.pid = getpid();
@@ -76,10 +83,31 @@ ClientSocket& get_manager_socket(const std::string& manager_handle) {
 
 void libshm_init(const char *manager_exec_path) {
   manager_executable_path = std::string(manager_exec_path);
+  const char* env = getenv("TORCH_SHM_MANAGERLESS");
+  if (env && strcmp(env, "0") != 0) {
+    managerless = true;
+  }
+}
+
+void libshm_set_managerless(bool enabled) {
+  managerless = enabled;
+}
+
+bool libshm_managerless() {
+  return managerless;
 }
 
 THManagedMapAllocatorInit::THManagedMapAllocatorInit(const char* manager_handle, const char* filename)
   : manager_handle_(manager_handle ? manager_handle : "") {
+  // In manager-less mode the refcount header in the segment tracks its
+  // lifetime and there is no daemon to register with. Attachments to a
+  // segment created without a manager skip the daemon too, regardless of
+  // this process' own mode.
+  if (manager_handle_ == managerless_handle ||
+      (manager_handle_.empty() && managerless)) {
+    manager_handle_ = managerless_handle;
+    return;
+  }
   // TODO: unlock GIL when contacting the manager
   try {
     ClientSocket *socket;
@@ -105,6 +133,12 @@ THManagedMapAllocator::THManagedMapAllocator(const char *manager_handle, const c
 
 void THManagedMapAllocator::close() {
   if (closed_) return;
+  if (manager_handle_ == managerless_handle) {
+    // The last process to close unlinks the segment; there is no
+    // deallocation to report.
+    THRefcountedMapAllocator::close();
+    return;
+  }
   AllocInfo info = get_alloc_info(filename());
   info.free = true;
   ClientSocket &socket = get_manager_socket(manager_handle_);
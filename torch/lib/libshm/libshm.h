@@ -6,6 +6,18 @@
 
 void libshm_init(const char *manager_exec_path);
 
+// Manager-less mode: rely solely on the refcount header that
+// THRefcountedMapAllocator keeps at the start of every segment (the last
+// process to drop its reference unlinks the file) and never talk to the
+// manager daemon. This removes the daemon round trip from every
+// allocation, but gives up crash robustness: segments whose holders die
+// without closing them are leaked until reboot. Enabled through this
+// call or the TORCH_SHM_MANAGERLESS environment variable. Segments
+// created in this mode carry a sentinel manager handle, so processes
+// attaching to them skip the daemon as well, whatever their own mode.
+void libshm_set_managerless(bool enabled);
+bool libshm_managerless();
+
 // Superclass to run a constructor before THRefcountedMapAllocator
 class THManagedMapAllocatorInit {
 protected:
@@ -0,0 +1,178 @@
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+
+#include <TH/TH.h>
+#include <libshm/ring_queue.h>
+
+namespace {
+
+constexpr int64_t kRingQueueMagic = 0x51524d4853524f54; // "TORSHMRQ"
+constexpr int64_t kRingQueueVersion = 1;
+
+size_t align_up(size_t size) {
+  constexpr size_t alignment = THShmRingQueue::kSlotAlignment;
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+struct THShmRingQueue::Header {
+  int64_t magic;
+  int64_t version;
+  uint64_t slot_count;
+  uint64_t slot_size;
+  // The cursors sit on separate cache lines so the producer and consumer
+  // processes do not false-share. Each slot's payload is preceded by its
+  // published size; the size is covered by the release store on `head`, so
+  // no separate synchronization is needed for it.
+  alignas(kSlotAlignment) std::atomic<uint64_t> head; // next slot to publish
+  alignas(kSlotAlignment) std::atomic<uint64_t> tail; // next slot to consume
+};
+
+THShmRingQueue::THShmRingQueue(
+    const char* name,
+    size_t slot_count,
+    size_t slot_size)
+    : name_(name), owner_(true) {
+  if (name_.empty() || name_[0] != '/') {
+    AT_ERROR("shared memory queue name must begin with '/', got: ", name_);
+  }
+  if (slot_count == 0 || slot_size == 0) {
+    AT_ERROR("shared memory queue needs at least one slot of non-zero size");
+  }
+  slot_stride_ = kSlotAlignment + align_up(slot_size);
+  size_t total_size = align_up(sizeof(Header)) + slot_count * slot_stride_;
+  data_ptr_ = THMapAllocator::makeDataPtr(
+      name,
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+      total_size,
+      /*actual_size_out=*/nullptr);
+  Header* hdr = new (data_ptr_.get()) Header();
+  hdr->magic = kRingQueueMagic;
+  hdr->version = kRingQueueVersion;
+  hdr->slot_count = slot_count;
+  hdr->slot_size = slot_size;
+  hdr->head.store(0, std::memory_order_relaxed);
+  hdr->tail.store(0, std::memory_order_relaxed);
+  AT_ASSERTM(
+      hdr->head.is_lock_free(),
+      "shared memory queue cursors are not lock-free on this platform");
+}
+
+THShmRingQueue::THShmRingQueue(const char* name) : name_(name), owner_(false) {
+  if (name_.empty() || name_[0] != '/') {
+    AT_ERROR("shared memory queue name must begin with '/', got: ", name_);
+  }
+  // Map just the header to learn the slot geometry, then remap the whole
+  // segment.
+  size_t geometry[2];
+  {
+    at::DataPtr header_ptr = THMapAllocator::makeDataPtr(
+        name,
+        TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+        align_up(sizeof(Header)),
+        /*actual_size_out=*/nullptr);
+    auto* hdr = static_cast<Header*>(header_ptr.get());
+    if (hdr->magic != kRingQueueMagic) {
+      AT_ERROR(name_, " is not a shared memory queue");
+    }
+    if (hdr->version != kRingQueueVersion) {
+      AT_ERROR(
+          "shared memory queue ",
+          name_,
+          " has unsupported version ",
+          hdr->version);
+    }
+    geometry[0] = hdr->slot_count;
+    geometry[1] = hdr->slot_size;
+  }
+  slot_stride_ = kSlotAlignment + align_up(geometry[1]);
+  size_t total_size = align_up(sizeof(Header)) + geometry[0] * slot_stride_;
+  data_ptr_ = THMapAllocator::makeDataPtr(
+      name,
+      TH_ALLOCATOR_MAPPED_SHAREDMEM | TH_ALLOCATOR_MAPPED_NOCREATE,
+      total_size,
+      /*actual_size_out=*/nullptr);
+}
+
+THShmRingQueue::~THShmRingQueue() {
+  data_ptr_.clear();
+  if (owner_) {
+    // Attached processes that still hold a mapping keep their pages; only
+    // the name goes away.
+    shm_unlink(name_.c_str());
+  }
+}
+
+THShmRingQueue::Header* THShmRingQueue::header() const {
+  return static_cast<Header*>(data_ptr_.get());
+}
+
+char* THShmRingQueue::slot(uint64_t cursor) const {
+  Header* hdr = header();
+  return static_cast<char*>(data_ptr_.get()) + align_up(sizeof(Header)) +
+      (cursor % hdr->slot_count) * slot_stride_;
+}
+
+size_t THShmRingQueue::slot_count() const {
+  return header()->slot_count;
+}
+
+size_t THShmRingQueue::slot_size() const {
+  return header()->slot_size;
+}
+
+void* THShmRingQueue::reserve() {
+  Header* hdr = header();
+  uint64_t head = hdr->head.load(std::memory_order_relaxed);
+  if (head - hdr->tail.load(std::memory_order_acquire) >= hdr->slot_count) {
+    return nullptr; // full
+  }
+  return slot(head) + kSlotAlignment;
+}
+
+void THShmRingQueue::publish(size_t size) {
+  Header* hdr = header();
+  if (size > hdr->slot_size) {
+    AT_ERROR(
+        "published payload of ",
+        size,
+        " bytes exceeds the queue's slot size of ",
+        hdr->slot_size);
+  }
+  uint64_t head = hdr->head.load(std::memory_order_relaxed);
+  AT_ASSERTM(
+      head - hdr->tail.load(std::memory_order_acquire) < hdr->slot_count,
+      "publish() without a successful reserve()");
+  uint64_t payload_size = size;
+  std::memcpy(slot(head), &payload_size, sizeof(payload_size));
+  // Makes the payload and its size visible to the consumer.
+  hdr->head.store(head + 1, std::memory_order_release);
+}
+
+const void* THShmRingQueue::peek(size_t* size) {
+  Header* hdr = header();
+  uint64_t tail = hdr->tail.load(std::memory_order_relaxed);
+  if (hdr->head.load(std::memory_order_acquire) == tail) {
+    return nullptr; // empty
+  }
+  char* entry = slot(tail);
+  uint64_t payload_size;
+  std::memcpy(&payload_size, entry, sizeof(payload_size));
+  if (size != nullptr) {
+    *size = payload_size;
+  }
+  return entry + kSlotAlignment;
+}
+
+void THShmRingQueue::release() {
+  Header* hdr = header();
+  uint64_t tail = hdr->tail.load(std::memory_order_relaxed);
+  AT_ASSERTM(
+      hdr->head.load(std::memory_order_acquire) != tail,
+      "release() without a successful peek()");
+  // Hands the slot back to the producer.
+  hdr->tail.store(tail + 1, std::memory_order_release);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <TH/TH.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef __cplusplus
+
+// A fixed-capacity single-producer/single-consumer queue living in a POSIX
+// shared memory segment, for handing batches between processes without
+// copies or pickling.
+//
+// The segment holds a header with the slot geometry and two monotonically
+// increasing cursors (head: next slot to publish, tail: next slot to
+// consume), each on its own cache line, followed by `slot_count` slots of
+// `slot_size` payload bytes. The cursors are lock-free atomics, so a
+// producer process and a consumer process synchronize purely through
+// acquire/release loads and stores; no lock and no system call is involved
+// in the hot path. Payloads are written and read in place:
+//
+//   producer:  void* slot = queue.reserve();     // nullptr when full
+//              <serialize tensor data into slot>
+//              queue.publish(nbytes);
+//
+//   consumer:  size_t nbytes;
+//              const void* slot = queue.peek(&nbytes); // nullptr when empty
+//              <wrap slot in a tensor, or copy out>
+//              queue.release();
+//
+// Exactly one producer and one consumer may use a queue at a time; within
+// each process the respective end must be externally serialized. Attach only
+// after the creating constructor has returned (the queue name is typically
+// announced over an existing control channel). The process that constructs
+// the queue owns the segment name and unlinks it on destruction; attached
+// queues only drop their mapping.
+class THShmRingQueue {
+ public:
+  // Payload slots are aligned generously enough for any tensor data.
+  static constexpr size_t kSlotAlignment = 64;
+
+  // Creates a new queue in a shared memory segment named `name` (must begin
+  // with '/', as for shm_open) with `slot_count` slots of `slot_size`
+  // payload bytes each. Fails if the segment already exists.
+  THShmRingQueue(const char* name, size_t slot_count, size_t slot_size);
+
+  // Attaches to an existing queue created by another process.
+  explicit THShmRingQueue(const char* name);
+
+  THShmRingQueue(const THShmRingQueue&) = delete;
+  THShmRingQueue& operator=(const THShmRingQueue&) = delete;
+
+  ~THShmRingQueue();
+
+  size_t slot_count() const;
+  size_t slot_size() const;
+
+  // Producer side. reserve() returns a pointer to the payload area of the
+  // next free slot, or nullptr when the queue is full; the same slot is
+  // returned until publish() is called with the number of payload bytes
+  // actually written (at most slot_size()).
+  void* reserve();
+  void publish(size_t size);
+
+  // Consumer side. peek() returns the payload of the oldest published slot
+  // and its size, or nullptr when the queue is empty; the slot stays valid
+  // until release() hands it back to the producer.
+  const void* peek(size_t* size);
+  void release();
+
+ private:
+  struct Header;
+
+  Header* header() const;
+  char* slot(uint64_t cursor) const;
+
+  std::string name_;
+  bool owner_;
+  size_t slot_stride_ = 0;
+  at::DataPtr data_ptr_;
+};
+
+#endif
@@ -1113,17 +1113,20 @@ Applies element-wise :math:`\text{LogSigmoid}(x_i) = \log \left(\frac{1}{1 + \ex
 See :class:`~torch.nn.LogSigmoid` for more details.
 """)
 
-def gelu(input):
-    r"""gelu(input) -> Tensor
+def gelu(input, approximate=False):
+    r"""gelu(input, approximate=False) -> Tensor
 
     Applies element-wise the function
     :math:`\text{GELU}(x) = x * \Phi(x)`
 
     where :math:`\Phi(x)` is the Cumulative Distribution Function for Gaussian Distribution.
 
+    When ``approximate`` is ``True``, GELU is estimated with the tanh
+    approximation :math:`0.5 x (1 + \tanh(\sqrt{2 / \pi} (x + 0.044715 x^3)))`.
+
     See `Gaussian Error Linear Units (GELUs) <https://arxiv.org/abs/1606.08415>`_.
     """
-    return torch._C._nn.gelu(input)
+    return torch._C._nn.gelu(input, approximate)
 
 
 def hardshrink(input, lambd=0.5):
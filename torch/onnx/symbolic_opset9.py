@@ -2023,7 +2023,16 @@ def remainder(g, input, other):
     quo = g.op("Mul", div, other)
     return g.op("Sub", input, quo)
 
-def gelu(g, self):
+@parse_args('v', 'i')
+def gelu(g, self, approximate=0):
+    if approximate:
+        _beta = 0.7978845608028654  # sqrt(2 / pi)
+        _kappa = 0.044715
+        cube = mul(g, self, mul(g, self, self))
+        inner = mul(g, g.op('Constant', value_t=torch.tensor(_beta, dtype=torch.float)),
+                    add(g, self, mul(g, cube, g.op('Constant', value_t=torch.tensor(_kappa, dtype=torch.float)))))
+        tanh_plusone = add(g, g.op('Tanh', inner), g.op('Constant', value_t=torch.tensor(1, dtype=torch.float)))
+        return mul(g, mul(g, self, tanh_plusone), g.op('Constant', value_t=torch.tensor(0.5, dtype=torch.float)))
     _sqrt2 = 1.4142135623730951
     erf = g.op('Erf', div(g, self, torch.tensor(_sqrt2)))
     erf_plusone = add(g, erf, g.op('Constant', value_t=torch.tensor(1, dtype=torch.float)))